@@ -47,6 +47,11 @@ c_autodoc_compilation_args = [
     "-DZ_FEATURE_MATCHING=1",
     "-DZ_FEATURE_SCOUTING=1",
     "-DZ_FEATURE_ADMIN_SPACE=1",
+    "-DZ_FEATURE_ALLOCATOR=1",
+    "-DZ_FEATURE_RX_DISPATCH=1",
+    "-DZ_FEATURE_PEER_ROUTING=1",
+    "-DZ_FEATURE_MULTICAST_RELIABILITY=1",
+    "-DZ_FEATURE_AUTO_BATCHING=1",
 ]
 
 # -- Options for HTML output -------------------------------------------------
@@ -42,12 +42,50 @@ _Z_SORTEDMAP_DEFINE(_z_uint32, _z_sample, uint32_t, _z_sample_t)
 
 _Z_SORTEDMAP_DEFINE(_z_timestamp, _z_sample, _z_timestamp_t, _z_sample_t)
 
+#define _ZP_STATIC_DEQUE_TEMPLATE_ELEM_TYPE _z_sample_t *
+#define _ZP_STATIC_DEQUE_TEMPLATE_NAME _ze_advanced_subscriber_reorder_deque
+#define _ZP_STATIC_DEQUE_TEMPLATE_SIZE Z_ADVANCED_SUBSCRIBER_REORDER_WINDOW_SIZE
+#define _ZP_STATIC_DEQUE_TEMPLATE_ELEM_DESTROY_FN(x) _z_sample_elem_free((void **)(x))
+#include "zenoh-pico/collections/static_deque_template.h"
+
+/**
+ * Samples of a source waiting for the ones before them, in sequence number order.
+ *
+ * The window holds the sample of sequence number _first_sn + i at index i, NULL for the missing ones, and never starts
+ * or ends with a missing one. Samples too far ahead for the window wait in the overflow map until it gets to them.
+ */
+typedef struct {
+    _ze_advanced_subscriber_reorder_deque_t _window;
+    uint32_t _first_sn;
+    size_t _window_len;
+    _z_uint32__z_sample_sortedmap_t _overflow;
+} _ze_advanced_subscriber_reorder_window_t;
+
+void _ze_advanced_subscriber_reorder_window_init(_ze_advanced_subscriber_reorder_window_t *w);
+void _ze_advanced_subscriber_reorder_window_clear(_ze_advanced_subscriber_reorder_window_t *w);
+// Takes ownership of the sample on success, replacing the one with the same sequence number if any
+z_result_t _ze_advanced_subscriber_reorder_window_insert(_ze_advanced_subscriber_reorder_window_t *w, uint32_t sn,
+                                                         _z_sample_t *sample);
+// Removes the sample with the lowest sequence number and hands it over to the caller, NULL if there is none
+_z_sample_t *_ze_advanced_subscriber_reorder_window_pop_first(_ze_advanced_subscriber_reorder_window_t *w,
+                                                              uint32_t *sn);
+
+static inline size_t _ze_advanced_subscriber_reorder_window_len(const _ze_advanced_subscriber_reorder_window_t *w) {
+    return w->_window_len + _z_uint32__z_sample_sortedmap_len((_z_uint32__z_sample_sortedmap_t *)&w->_overflow);
+}
+// Lowest sequence number waiting, false if there is none
+static inline bool _ze_advanced_subscriber_reorder_window_first(const _ze_advanced_subscriber_reorder_window_t *w,
+                                                                uint32_t *sn) {
+    *sn = w->_first_sn;
+    return w->_window_len != 0;
+}
+
 typedef struct {
     _z_session_weak_t _zn;
     bool _has_last_delivered;
     uint32_t _last_delivered;
     uint64_t _pending_queries;
-    _z_uint32__z_sample_sortedmap_t _pending_samples;
+    _ze_advanced_subscriber_reorder_window_t _pending_samples;
     _z_fut_handle_t _periodic_query_handle;
     z_owned_keyexpr_t _query_keyexpr;
 } _ze_advanced_subscriber_sequenced_state_t;
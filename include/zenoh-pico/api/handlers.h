@@ -30,8 +30,9 @@ extern "C" {
 // -- Channel
 #define _Z_CHANNEL_DEFINE_IMPL(handler_type, handler_name, handler_new_f_name, callback_type, callback_new_f,        \
                                collection_type, collection_new_f, collection_clear_f, collection_push_f,             \
-                               collection_pull_f, collection_try_pull_f, collection_close_f, elem_owned_type,        \
-                               elem_loaned_type, elem_take_f, elem_move_f, elem_drop_f, elem_null_f)                 \
+                               collection_pull_f, collection_try_pull_f, collection_try_pull_many_f,                 \
+                               collection_close_f, elem_owned_type, elem_loaned_type, elem_take_f, elem_move_f,      \
+                               elem_drop_f, elem_null_f)                                                             \
     typedef struct {                                                                                                 \
         collection_type collection;                                                                                  \
     } handler_type;                                                                                                  \
@@ -131,6 +132,26 @@ extern "C" {
             return ret;                                                                                              \
         }                                                                                                            \
         return _Z_RES_OK;                                                                                            \
+    }                                                                                                                \
+    static inline z_result_t z_##handler_name##_try_recv_many(const z_loaned_##handler_name##_t *handler,            \
+                                                              elem_owned_type *elems, size_t len,                    \
+                                                              size_t *received) {                                    \
+        for (size_t i = 0; i < len; i++) {                                                                           \
+            elem_null_f(&elems[i]);                                                                                  \
+        }                                                                                                            \
+        z_result_t ret = collection_try_pull_many_f(elems, sizeof(elem_owned_type), len, received,                   \
+                                                    (collection_type *)(&_Z_RC_IN_VAL(handler)->collection),         \
+                                                    _z_##handler_name##_elem_move);                                  \
+        if (ret == _Z_RES_CHANNEL_CLOSED) {                                                                          \
+            return Z_CHANNEL_DISCONNECTED;                                                                           \
+        } else if (ret == _Z_RES_CHANNEL_NODATA) {                                                                   \
+            return Z_CHANNEL_NODATA;                                                                                 \
+        }                                                                                                            \
+        if (ret != _Z_RES_OK) {                                                                                      \
+            _Z_ERROR("%s failed: %i", #collection_try_pull_many_f, ret);                                             \
+            return ret;                                                                                              \
+        }                                                                                                            \
+        return _Z_RES_OK;                                                                                            \
     }
 
 #define _Z_CHANNEL_DEFINE(item_name, kind_name)                                                             \
@@ -145,6 +166,7 @@ extern "C" {
                            /* collection_push_f               */ _z_##kind_name##_mt_push,                  \
                            /* collection_pull_f               */ _z_##kind_name##_mt_pull,                  \
                            /* collection_try_pull_f           */ _z_##kind_name##_mt_try_pull,              \
+                           /* collection_try_pull_many_f      */ _z_##kind_name##_mt_try_pull_many,         \
                            /* collection_close_f              */ _z_##kind_name##_mt_close,                 \
                            /* elem_owned_type                 */ z_owned_##item_name##_t,                   \
                            /* elem_loaned_type                */ z_loaned_##item_name##_t,                  \
@@ -172,6 +194,15 @@ extern "C" {
         _ZP_UNUSED(e);                                                                                          \
         return Z_CHANNEL_DISCONNECTED;                                                                          \
     }                                                                                                           \
+    static inline z_result_t z_##handler_name##_try_recv_many(const z_loaned_##handler_name##_t *handler,       \
+                                                              z_owned_##item_name##_t *e, size_t len,           \
+                                                              size_t *received) {                               \
+        _ZP_UNUSED(handler);                                                                                    \
+        _ZP_UNUSED(e);                                                                                          \
+        _ZP_UNUSED(len);                                                                                        \
+        *received = 0;                                                                                          \
+        return Z_CHANNEL_DISCONNECTED;                                                                          \
+    }                                                                                                           \
     static inline z_result_t z_##handler_name##_recv(const z_loaned_##handler_name##_t *handler,                \
                                                      z_owned_##item_name##_t *e) {                              \
         _ZP_UNUSED(handler);                                                                                    \
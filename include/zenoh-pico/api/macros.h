@@ -212,6 +212,7 @@
                   z_owned_ring_handler_sample_t : z_ring_handler_sample_loan,          \
                   z_owned_reply_err_t : z_reply_err_loan,                              \
                   z_owned_closure_sample_t : z_closure_sample_loan,                    \
+                  z_owned_closure_sample_batch_t : z_closure_sample_batch_loan,        \
                   z_owned_closure_reply_t : z_closure_reply_loan,                      \
                   z_owned_closure_query_t : z_closure_query_loan,                      \
                   z_owned_closure_hello_t : z_closure_hello_loan,                      \
@@ -286,6 +287,7 @@
                   z_moved_slice_t* : z_slice_drop,                                     \
                   z_moved_bytes_t* : z_bytes_drop,                                     \
                   z_moved_closure_sample_t* : z_closure_sample_drop,                   \
+                  z_moved_closure_sample_batch_t* : z_closure_sample_batch_drop,       \
                   z_moved_closure_query_t* : z_closure_query_drop,                     \
                   z_moved_closure_reply_t* : z_closure_reply_drop,                     \
                   z_moved_closure_hello_t* : z_closure_hello_drop,                     \
@@ -337,6 +339,7 @@
                   z_owned_string_t : z_internal_string_check,                                    \
                   z_owned_string_array_t : z_internal_string_array_check,                        \
                   z_owned_closure_sample_t : z_internal_closure_sample_check,                    \
+                  z_owned_closure_sample_batch_t : z_internal_closure_sample_batch_check,        \
                   z_owned_closure_query_t : z_internal_closure_query_check,                      \
                   z_owned_closure_reply_t : z_internal_closure_reply_check,                      \
                   z_owned_closure_hello_t : z_internal_closure_hello_check,                      \
@@ -362,6 +365,7 @@
  */
 #define z_call(x, ...) \
     _Generic((x), z_loaned_closure_sample_t : z_closure_sample_call,                   \
+                  z_loaned_closure_sample_batch_t : z_closure_sample_batch_call,       \
                   z_loaned_closure_query_t : z_closure_query_call,                     \
                   z_loaned_closure_reply_t : z_closure_reply_call,                     \
                   z_loaned_closure_hello_t : z_closure_hello_call,                     \
@@ -381,6 +385,16 @@
         const z_loaned_ring_handler_sample_t* : z_ring_handler_sample_try_recv \
     )(x, __VA_ARGS__)
 
+#define z_try_recv_many(x, ...) \
+    _Generic((x), \
+        const z_loaned_fifo_handler_query_t* : z_fifo_handler_query_try_recv_many, \
+        const z_loaned_fifo_handler_reply_t* : z_fifo_handler_reply_try_recv_many, \
+        const z_loaned_fifo_handler_sample_t* : z_fifo_handler_sample_try_recv_many, \
+        const z_loaned_ring_handler_query_t* : z_ring_handler_query_try_recv_many, \
+        const z_loaned_ring_handler_reply_t* : z_ring_handler_reply_try_recv_many, \
+        const z_loaned_ring_handler_sample_t* : z_ring_handler_sample_try_recv_many \
+    )(x, __VA_ARGS__)
+
 #define z_recv(x, ...) \
     _Generic((x), \
         const z_loaned_fifo_handler_query_t* : z_fifo_handler_query_recv, \
@@ -418,6 +432,7 @@
                   z_owned_string_t : z_string_move,                                     \
                   z_owned_string_array_t : z_string_array_move,                         \
                   z_owned_closure_sample_t : z_closure_sample_move,                     \
+                  z_owned_closure_sample_batch_t : z_closure_sample_batch_move,         \
                   z_owned_closure_query_t : z_closure_query_move,                       \
                   z_owned_closure_reply_t : z_closure_reply_move,                       \
                   z_owned_closure_hello_t : z_closure_hello_move,                       \
@@ -462,6 +477,7 @@
         z_owned_closure_query_t *: z_closure_query_take,                       \
         z_owned_closure_reply_t *: z_closure_reply_take,                       \
         z_owned_closure_sample_t *: z_closure_sample_take,                     \
+        z_owned_closure_sample_batch_t *: z_closure_sample_batch_take,         \
         z_owned_closure_zid_t * : z_closure_zid_take,                          \
         z_owned_closure_matching_status_t * : z_closure_matching_status_take,  \
         ze_owned_closure_miss_t * : ze_closure_miss_take,                      \
@@ -582,6 +598,7 @@
                   z_owned_slice_t  *: z_internal_slice_null,                                      \
                   z_owned_bytes_t  *: z_internal_bytes_null,                                      \
                   z_owned_closure_sample_t * : z_internal_closure_sample_null,                    \
+                  z_owned_closure_sample_batch_t * : z_internal_closure_sample_batch_null,        \
                   z_owned_closure_query_t * : z_internal_closure_query_null,                      \
                   z_owned_closure_reply_t * : z_internal_closure_reply_null,                      \
                   z_owned_closure_hello_t * : z_internal_closure_hello_null,                      \
@@ -653,6 +670,9 @@ inline const z_loaned_mutex_t* z_loan(const z_owned_mutex_t& x) { return z_mutex
 inline const z_loaned_condvar_t* z_loan(const z_owned_condvar_t& x) { return z_condvar_loan(&x); }
 inline const z_loaned_reply_err_t* z_loan(const z_owned_reply_err_t& x) { return z_reply_err_loan(&x); }
 inline const z_loaned_closure_sample_t* z_loan(const z_owned_closure_sample_t& x) { return z_closure_sample_loan(&x); }
+inline const z_loaned_closure_sample_batch_t* z_loan(const z_owned_closure_sample_batch_t& x) {
+    return z_closure_sample_batch_loan(&x);
+}
 inline const z_loaned_closure_reply_t* z_loan(const z_owned_closure_reply_t& x) { return z_closure_reply_loan(&x); }
 inline const z_loaned_closure_query_t* z_loan(const z_owned_closure_query_t& x) { return z_closure_query_loan(&x); }
 inline const z_loaned_closure_hello_t* z_loan(const z_owned_closure_hello_t& x) { return z_closure_hello_loan(&x); }
@@ -748,6 +768,7 @@ inline void z_drop(z_moved_mutex_t* v) { z_mutex_drop(v); }
 inline void z_drop(z_moved_condvar_t* v) { z_condvar_drop(v); }
 inline void z_drop(z_moved_reply_err_t* v) { z_reply_err_drop(v); }
 inline void z_drop(z_moved_closure_sample_t* v) { z_closure_sample_drop(v); }
+inline void z_drop(z_moved_closure_sample_batch_t* v) { z_closure_sample_batch_drop(v); }
 inline void z_drop(z_moved_closure_query_t* v) { z_closure_query_drop(v); }
 inline void z_drop(z_moved_closure_reply_t* v) { z_closure_reply_drop(v); }
 inline void z_drop(z_moved_closure_hello_t* v) { z_closure_hello_drop(v); }
@@ -798,6 +819,7 @@ inline void z_internal_null(z_owned_bytes_t* v) { z_internal_bytes_null(v); }
 inline void z_internal_null(z_owned_encoding_t* v) { z_internal_encoding_null(v); }
 inline void z_internal_null(z_owned_reply_err_t* v) { z_internal_reply_err_null(v); }
 inline void z_internal_null(z_owned_closure_sample_t* v) { z_internal_closure_sample_null(v); }
+inline void z_internal_null(z_owned_closure_sample_batch_t* v) { z_internal_closure_sample_batch_null(v); }
 inline void z_internal_null(z_owned_closure_query_t* v) { z_internal_closure_query_null(v); }
 inline void z_internal_null(z_owned_closure_reply_t* v) { z_internal_closure_reply_null(v); }
 inline void z_internal_null(z_owned_closure_hello_t* v) { z_internal_closure_hello_null(v); }
@@ -872,6 +894,8 @@ inline bool z_internal_check(const z_owned_closure_link_event_t& v) { return z_i
 // z_call definition
 inline void z_call(const z_loaned_closure_sample_t &closure, z_loaned_sample_t *sample) 
     { z_closure_sample_call(&closure, sample); }
+inline void z_call(const z_loaned_closure_sample_batch_t &closure, z_loaned_sample_t *samples, size_t len)
+    { z_closure_sample_batch_call(&closure, samples, len); }
 inline void z_call(const z_loaned_closure_query_t &closure, z_loaned_query_t *query)
     { z_closure_query_call(&closure, query); }
 inline void z_call(const z_loaned_closure_reply_t &closure, z_loaned_reply_t *reply)
@@ -931,6 +955,15 @@ inline void z_closure(
     closure->_val.drop = drop;
     closure->_val.call = call;
 }
+inline void z_closure(
+    z_owned_closure_sample_batch_t* closure,
+    void (*call)(z_loaned_sample_t*, size_t, void*),
+    void (*drop)(void*),
+    void *context) {
+    closure->_val.context = context;
+    closure->_val.drop = drop;
+    closure->_val.call = call;
+}
 inline void z_closure(
     z_owned_closure_zid_t* closure,
     void (*call)(const z_id_t*, void*),
@@ -1015,6 +1048,30 @@ inline z_result_t z_try_recv(const z_loaned_ring_handler_reply_t* this_, z_owned
 inline z_result_t z_try_recv(const z_loaned_ring_handler_sample_t* this_, z_owned_sample_t* sample) {
     return z_ring_handler_sample_try_recv(this_, sample);
 }
+inline z_result_t z_try_recv_many(const z_loaned_fifo_handler_query_t* this_, z_owned_query_t* querys, size_t len,
+                                  size_t* received) {
+    return z_fifo_handler_query_try_recv_many(this_, querys, len, received);
+}
+inline z_result_t z_try_recv_many(const z_loaned_fifo_handler_reply_t* this_, z_owned_reply_t* replys, size_t len,
+                                  size_t* received) {
+    return z_fifo_handler_reply_try_recv_many(this_, replys, len, received);
+}
+inline z_result_t z_try_recv_many(const z_loaned_fifo_handler_sample_t* this_, z_owned_sample_t* samples, size_t len,
+                                  size_t* received) {
+    return z_fifo_handler_sample_try_recv_many(this_, samples, len, received);
+}
+inline z_result_t z_try_recv_many(const z_loaned_ring_handler_query_t* this_, z_owned_query_t* querys, size_t len,
+                                  size_t* received) {
+    return z_ring_handler_query_try_recv_many(this_, querys, len, received);
+}
+inline z_result_t z_try_recv_many(const z_loaned_ring_handler_reply_t* this_, z_owned_reply_t* replys, size_t len,
+                                  size_t* received) {
+    return z_ring_handler_reply_try_recv_many(this_, replys, len, received);
+}
+inline z_result_t z_try_recv_many(const z_loaned_ring_handler_sample_t* this_, z_owned_sample_t* samples, size_t len,
+                                  size_t* received) {
+    return z_ring_handler_sample_try_recv_many(this_, samples, len, received);
+}
 
 
 inline z_result_t z_recv(const z_loaned_fifo_handler_query_t* this_, z_owned_query_t* query) {
@@ -1043,6 +1100,9 @@ inline z_moved_closure_hello_t* z_move(z_owned_closure_hello_t& closure) { retur
 inline z_moved_closure_query_t* z_move(z_owned_closure_query_t& closure) { return z_closure_query_move(&closure); }
 inline z_moved_closure_reply_t* z_move(z_owned_closure_reply_t& closure) { return z_closure_reply_move(&closure); }
 inline z_moved_closure_sample_t* z_move(z_owned_closure_sample_t& closure) { return z_closure_sample_move(&closure); }
+inline z_moved_closure_sample_batch_t* z_move(z_owned_closure_sample_batch_t& closure) {
+    return z_closure_sample_batch_move(&closure);
+}
 inline z_moved_closure_zid_t* z_move(z_owned_closure_zid_t& closure) { return z_closure_zid_move(&closure); }
 inline z_moved_closure_matching_status_t* z_move(z_owned_closure_matching_status_t& closure) {
     return z_closure_matching_status_move(&closure);
@@ -1143,6 +1203,9 @@ inline void z_take(z_owned_mutex_t* this_, z_moved_mutex_t* v) { z_mutex_take(th
 inline void z_take(z_owned_condvar_t* this_, z_moved_condvar_t* v) { z_condvar_take(this_, v); }
 inline void z_take(z_owned_reply_err_t* this_, z_moved_reply_err_t* v) { z_reply_err_take(this_, v); }
 inline void z_take(z_owned_closure_sample_t* this_, z_moved_closure_sample_t* v) { z_closure_sample_take(this_, v); }
+inline void z_take(z_owned_closure_sample_batch_t* this_, z_moved_closure_sample_batch_t* v) {
+    z_closure_sample_batch_take(this_, v);
+}
 inline void z_take(z_owned_closure_query_t* this_, z_moved_closure_query_t* v) { z_closure_query_take(this_, v); }
 inline void z_take(z_owned_closure_reply_t* this_, z_moved_closure_reply_t* v) { z_closure_reply_take(this_, v); }
 inline void z_take(z_owned_closure_hello_t* this_, z_moved_closure_hello_t* v) { z_closure_hello_take(this_, v); }
@@ -1481,6 +1544,14 @@ struct z_loaned_to_owned_type_t<z_loaned_closure_sample_t> {
     typedef z_owned_closure_sample_t type;
 };
 template <>
+struct z_owned_to_loaned_type_t<z_owned_closure_sample_batch_t> {
+    typedef z_loaned_closure_sample_batch_t type;
+};
+template <>
+struct z_loaned_to_owned_type_t<z_loaned_closure_sample_batch_t> {
+    typedef z_owned_closure_sample_batch_t type;
+};
+template <>
 struct z_owned_to_loaned_type_t<z_owned_closure_reply_t> {
     typedef z_loaned_closure_reply_t type;
 };
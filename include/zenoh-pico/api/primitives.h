@@ -1192,6 +1192,33 @@ z_result_t z_closure_sample(z_owned_closure_sample_t *closure, z_closure_sample_
  */
 void z_closure_sample_call(const z_loaned_closure_sample_t *closure, z_loaned_sample_t *sample);
 
+/**
+ * Builds a new sample batch closure.
+ * It consists of a structure that contains all the elements for stateful, memory-leak-free callbacks.
+ *
+ * Parameters:
+ *   closure: Pointer to an uninitialized :c:type:`z_owned_closure_sample_batch_t`.
+ *   call: Pointer to the callback function. ``context`` will be passed as its last argument.
+ *   drop: Pointer to the function that will free the callback state. ``context`` will be passed as its last argument.
+ *   context: Pointer to an arbitrary state.
+ *
+ * Return:
+ *   ``0`` in case of success, negative error code otherwise
+ */
+z_result_t z_closure_sample_batch(z_owned_closure_sample_batch_t *closure, z_closure_sample_batch_callback_t call,
+                                  z_closure_drop_callback_t drop, void *context);
+
+/**
+ * Calls a sample batch closure.
+ *
+ * Parameters:
+ *   closure: Pointer to the :c:type:`z_loaned_closure_sample_batch_t` to call.
+ *   samples: Array of the :c:type:`z_loaned_sample_t` to pass to the closure.
+ *   len: Number of samples in the array.
+ */
+void z_closure_sample_batch_call(const z_loaned_closure_sample_batch_t *closure, z_loaned_sample_t *samples,
+                                 size_t len);
+
 /**
  * Builds a new query closure.
  * It consists of a structure that contains all the elements for stateful, memory-leak-free callbacks.
@@ -1489,6 +1516,7 @@ _Z_OWNED_FUNCTIONS_NO_COPY_NO_MOVE_DEF(link_events_listener)
 #endif
 
 _Z_OWNED_FUNCTIONS_CLOSURE_DEF(closure_sample)
+_Z_OWNED_FUNCTIONS_CLOSURE_DEF(closure_sample_batch)
 _Z_OWNED_FUNCTIONS_CLOSURE_DEF(closure_query)
 _Z_OWNED_FUNCTIONS_CLOSURE_DEF(closure_reply)
 _Z_OWNED_FUNCTIONS_CLOSURE_DEF(closure_hello)
@@ -3101,6 +3129,48 @@ z_result_t z_undeclare_subscriber(z_moved_subscriber_t *pub);
 z_result_t z_declare_background_subscriber(const z_loaned_session_t *zs, const z_loaned_keyexpr_t *keyexpr,
                                            z_moved_closure_sample_t *callback, const z_subscriber_options_t *options);
 
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+/**
+ * Declares a subscriber for a given keyexpr, whose callback receives the samples by batches rather than one at a time.
+ * The callback is called once ``batch_max_samples`` samples are waiting, or once the batch they were received in is
+ * processed, as they borrow its buffer rather than being copied. The samples published by the session itself are
+ * delivered before the publication returns. The samples the callback is given are only valid during the call, they
+ * must be cloned to be kept.
+ * Note that dropping subscriber drops its callback, after it received the samples still waiting.
+ *
+ * Parameters:
+ *   zs: Pointer to a :c:type:`z_loaned_session_t` to declare the subscriber through.
+ *   sub: Pointer to a :c:type:`z_owned_subscriber_t` to contain the subscriber.
+ *   keyexpr: Pointer to a :c:type:`z_loaned_keyexpr_t` to bind the subscriber with.
+ *   callback: Pointer to a`z_owned_closure_sample_batch_t` callback.
+ *   options: Pointer to a :c:type:`z_subscriber_options_t` to configure the operation
+ *
+ * Return:
+ *   ``0`` if declare is successful, ``negative value`` otherwise.
+ */
+z_result_t z_declare_batched_subscriber(const z_loaned_session_t *zs, z_owned_subscriber_t *sub,
+                                        const z_loaned_keyexpr_t *keyexpr, z_moved_closure_sample_batch_t *callback,
+                                        const z_subscriber_options_t *options);
+
+/**
+ * Declares a background subscriber for a given keyexpr, whose callback receives the samples by batches as with
+ * :c:func:`z_declare_batched_subscriber`. Subscriber callback will be called to process the messages, until the
+ * corresponding session is closed or dropped.
+ *
+ * Parameters:
+ *   zs: Pointer to a :c:type:`z_loaned_session_t` to declare the subscriber through.
+ *   keyexpr: Pointer to a :c:type:`z_loaned_keyexpr_t` to bind the subscriber with.
+ *   callback: Pointer to a`z_owned_closure_sample_batch_t` callback.
+ *   options: Pointer to a :c:type:`z_subscriber_options_t` to configure the operation
+ *
+ * Return:
+ *   ``0`` if declare is successful, ``negative value`` otherwise.
+ */
+z_result_t z_declare_background_batched_subscriber(const z_loaned_session_t *zs, const z_loaned_keyexpr_t *keyexpr,
+                                                   z_moved_closure_sample_batch_t *callback,
+                                                   const z_subscriber_options_t *options);
+#endif
+
 /**
  * Gets the keyexpr from a subscriber.
  *
@@ -3265,6 +3335,85 @@ z_result_t zp_stop_lease_task(z_loaned_session_t *zs);
  */
 bool zp_lease_task_is_running(const z_loaned_session_t *zs);
 #endif
+#if Z_FEATURE_RX_DISPATCH == 1 || defined(SPHINX_DOCS)
+/**
+ * Gets the number of workers running the subscriber callbacks of the samples received by a session, as set with
+ * ``Z_CONFIG_RX_DISPATCH_WORKERS_KEY``. The callbacks run on the read task when there are none.
+ *
+ * Note: only if Z_FEATURE_RX_DISPATCH is enabled.
+ *
+ * Parameters:
+ *   zs: Pointer to a :c:type:`z_loaned_session_t` to get the workers of.
+ *
+ * Return:
+ *   The number of workers.
+ */
+size_t zp_rx_dispatch_workers(const z_loaned_session_t *zs);
+
+/**
+ * Gets the queue metrics of a worker running the subscriber callbacks of the samples received by a session.
+ *
+ * Note: only if Z_FEATURE_RX_DISPATCH is enabled.
+ *
+ * Parameters:
+ *   zs: Pointer to a :c:type:`z_loaned_session_t` to get the metrics from.
+ *   worker: Index of the worker, lower than :c:func:`zp_rx_dispatch_workers`.
+ *   stats: Pointer to the :c:type:`zp_rx_dispatch_worker_stats_t` to fill.
+ *
+ * Return:
+ *   ``0`` if the metrics are read, ``negative value`` if there is no such worker.
+ */
+z_result_t zp_rx_dispatch_worker_stats(const z_loaned_session_t *zs, size_t worker,
+                                       zp_rx_dispatch_worker_stats_t *stats);
+#endif
+#if Z_FEATURE_PEER_ROUTING == 1 || defined(SPHINX_DOCS)
+/**
+ * Gets the counters of the publications and queries a peer mode session routed to the peers with a matching
+ * declaration.
+ *
+ * Note: only if Z_FEATURE_PEER_ROUTING is enabled.
+ *
+ * Parameters:
+ *   zs: Pointer to a :c:type:`z_loaned_session_t` to get the counters from.
+ *   stats: Pointer to the :c:type:`zp_peer_routing_stats_t` to fill.
+ *
+ * Return:
+ *   ``0`` if the counters are read, ``negative value`` if the session has no unicast transport.
+ */
+z_result_t zp_peer_routing_stats(const z_loaned_session_t *zs, zp_peer_routing_stats_t *stats);
+#endif
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1 || defined(SPHINX_DOCS)
+/**
+ * Gets the counters of the reliable messages a session retransmitted on its multicast transport when its peers
+ * reported them lost.
+ *
+ * Note: only if Z_FEATURE_MULTICAST_RELIABILITY is enabled.
+ *
+ * Parameters:
+ *   zs: Pointer to a :c:type:`z_loaned_session_t` to get the counters from.
+ *   stats: Pointer to the :c:type:`zp_multicast_repair_stats_t` to fill.
+ *
+ * Return:
+ *   ``0`` if the counters are read, ``negative value`` if the session has no multicast transport.
+ */
+z_result_t zp_multicast_repair_stats(const z_loaned_session_t *zs, zp_multicast_repair_stats_t *stats);
+
+/**
+ * Gets the counters of the reliable messages a session lost and repaired from a peer of its multicast transport.
+ *
+ * Note: only if Z_FEATURE_MULTICAST_RELIABILITY is enabled.
+ *
+ * Parameters:
+ *   zs: Pointer to a :c:type:`z_loaned_session_t` to get the counters from.
+ *   zid: Pointer to the :c:type:`z_id_t` of the peer.
+ *   stats: Pointer to the :c:type:`zp_multicast_peer_repair_stats_t` to fill.
+ *
+ * Return:
+ *   ``0`` if the counters are read, ``negative value`` if the session has no multicast transport or no such peer.
+ */
+z_result_t zp_multicast_peer_repair_stats(const z_loaned_session_t *zs, const z_id_t *zid,
+                                          zp_multicast_peer_repair_stats_t *stats);
+#endif
 #if Z_FEATURE_MULTI_THREAD == 0 || defined(SPHINX_DOCS)
 /************* Single Thread helpers **************/
 /**
@@ -163,6 +163,12 @@ typedef _z_matching_status_t z_matching_status_t;
 
 /**
  * Represents the configuration used to configure a subscriber upon declaration :c:func:`z_declare_subscriber`.
+ *
+ * Members:
+ *   z_locality_t allowed_origin: The origin of the samples the subscriber receives (only when
+ * Z_FEATURE_LOCAL_SUBSCRIBER is enabled).
+ *   size_t batch_max_samples: The number of samples a batched subscriber accumulates before its callback is called
+ * (only when Z_FEATURE_SUBSCRIBER_BATCHING is enabled, see :c:func:`z_declare_batched_subscriber`).
  */
 typedef struct {
 #if Z_FEATURE_LOCAL_SUBSCRIBER == 1
@@ -170,6 +176,9 @@ typedef struct {
 #else
     uint8_t __dummy;  // keep struct non-empty when locality is disabled
 #endif
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    size_t batch_max_samples;
+#endif
 } z_subscriber_options_t;
 
 /**
@@ -515,6 +524,95 @@ typedef struct {
     z_task_attr_t *task_attributes;
 } zp_task_lease_options_t;
 #endif
+#if Z_FEATURE_RX_DISPATCH == 1 || defined(SPHINX_DOCS)
+/**
+ * Queue metrics of a worker running the subscriber callbacks of received samples, see
+ * :c:func:`zp_rx_dispatch_worker_stats`.
+ *
+ * Note: only if Z_FEATURE_RX_DISPATCH is enabled.
+ *
+ * Members:
+ *   depth: Samples waiting in the queue of the worker.
+ *   max_depth: Most samples that waited in the queue at once.
+ *   capacity: Samples the queue holds, ``Z_RX_DISPATCH_QUEUE_SIZE``.
+ *   dispatched: Samples the worker ran the callbacks of.
+ *   stalls: Samples the read task had to wait for room in the queue to hand over.
+ */
+typedef struct {
+    size_t depth;
+    size_t max_depth;
+    size_t capacity;
+    size_t dispatched;
+    size_t stalls;
+} zp_rx_dispatch_worker_stats_t;
+#endif
+#if Z_FEATURE_PEER_ROUTING == 1 || defined(SPHINX_DOCS)
+/**
+ * Counters of the publications and queries a peer mode session routed to the peers with a matching declaration, see
+ * :c:func:`zp_peer_routing_stats`.
+ *
+ * Note: only if Z_FEATURE_PEER_ROUTING is enabled.
+ *
+ * Members:
+ *   routed: Messages sent to the peers with a matching declaration only.
+ *   unmatched: Messages no peer declared a match for, that were not sent.
+ *   peer_sends: Batches and fragments sent to a peer.
+ *   peer_skips: Batches and fragments a peer was left out of.
+ *   route_hits: Messages routed with the peers found for a previous message on the same key expression.
+ *   route_misses: Messages the remote declarations were searched for.
+ */
+typedef struct {
+    size_t routed;
+    size_t unmatched;
+    size_t peer_sends;
+    size_t peer_skips;
+    size_t route_hits;
+    size_t route_misses;
+} zp_peer_routing_stats_t;
+#endif
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1 || defined(SPHINX_DOCS)
+/**
+ * Counters of the reliable messages a session retransmitted on its multicast transport, see
+ * :c:func:`zp_multicast_repair_stats`.
+ *
+ * Note: only if Z_FEATURE_MULTICAST_RELIABILITY is enabled.
+ *
+ * Members:
+ *   nacks: NACKs received from the peers that lost reliable messages of the session.
+ *   retransmitted: Datagrams sent again.
+ *   unrecoverable: Reliable messages asked for that were no longer held to be sent again.
+ */
+typedef struct {
+    size_t nacks;
+    size_t retransmitted;
+    size_t unrecoverable;
+} zp_multicast_repair_stats_t;
+
+/**
+ * Counters of the reliable messages a session lost and repaired from a multicast peer, see
+ * :c:func:`zp_multicast_peer_repair_stats`.
+ *
+ * Note: only if Z_FEATURE_MULTICAST_RELIABILITY is enabled.
+ *
+ * Members:
+ *   active: Whether the peer retransmits its reliable messages, only their order is ensured otherwise.
+ *   gaps: Gaps found in the reliable messages of the peer.
+ *   repaired: Reliable messages received after being reported lost.
+ *   lost: Reliable messages skipped as they could not be repaired.
+ *   nacks_sent: NACKs sent to the peer.
+ *   nacks_suppressed: NACKs put off as another peer, or the peer itself, already dealt with the gap.
+ *   out_of_order: Reliable messages dropped because they followed a gap, they are received again with it.
+ */
+typedef struct {
+    bool active;
+    size_t gaps;
+    size_t repaired;
+    size_t lost;
+    size_t nacks_sent;
+    size_t nacks_suppressed;
+    size_t out_of_order;
+} zp_multicast_peer_repair_stats_t;
+#endif
 #if Z_FEATURE_MULTI_THREAD == 0 || defined(SPHINX_DOCS)
 /**
  * Represents the configuration used to configure a read operation started via :c:func:`zp_read`.
@@ -727,6 +825,19 @@ typedef struct {
  */
 _Z_OWNED_TYPE_VALUE(_z_closure_sample_t, closure_sample)
 
+typedef _z_closure_sample_batch_callback_t z_closure_sample_batch_callback_t;
+
+typedef struct {
+    void *context;
+    z_closure_sample_batch_callback_t call;
+    z_closure_drop_callback_t drop;
+} _z_closure_sample_batch_t;
+
+/**
+ * Represents the sample batch closure.
+ */
+_Z_OWNED_TYPE_VALUE(_z_closure_sample_batch_t, closure_sample_batch)
+
 typedef _z_closure_query_callback_t z_closure_query_callback_t;
 
 typedef struct {
@@ -19,7 +19,7 @@
 
 #include "zenoh-pico/api/liveliness.h"
 #include "zenoh-pico/api/types.h"
-#include "zenoh-pico/collections/ring.h"
+#include "zenoh-pico/utils/time_range.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,12 +47,50 @@ typedef struct {
 } ze_advanced_publisher_cache_options_t;
 
 typedef struct {
-    _z_sample_ring_t _cache;
-    _z_sample_t *_outbox;
+    int64_t start;
+    int64_t end;
+} _ze_advanced_cache_range_t;
+
+/**
+ * A sample kept in the history store. A sample dropped from the history while a reply still holds it is only freed
+ * once the reply releases it.
+ */
+typedef struct _ze_advanced_cache_entry_t {
+    _z_sample_t _sample;
+    size_t _refs;
+    // Whether the sequence number and the timestamp follow the ones of the previous entry
+    bool _sn_in_order;
+    bool _ts_in_order;
+    struct _ze_advanced_cache_entry_t *_next_free;
+} _ze_advanced_cache_entry_t;
+
+/**
+ * History of the last samples, oldest first, over a preallocated slab of entries. Sequence numbers and timestamps
+ * are searched by position as long as they increase through the whole history, which is the case for a single
+ * publisher, every entry is checked otherwise.
+ */
+typedef struct {
+    // Twice the capacity, so that a full history can be replaced while a reply holds the previous one
+    _ze_advanced_cache_entry_t *_slab;
+    _ze_advanced_cache_entry_t *_free;
+    _ze_advanced_cache_entry_t **_ring;
+    size_t _capacity;
+    size_t _start;
+    size_t _len;
+    // Entries past the first one that break the order of sequence numbers or timestamps
+    size_t _sn_breaks;
+    size_t _ts_breaks;
+} _ze_advanced_cache_store_t;
+
+typedef struct {
+    _ze_advanced_cache_store_t _store;
+    _ze_advanced_cache_entry_t **_outbox;
     size_t _outbox_cap;
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_t _mutex;
     _z_mutex_t _outbox_mutex;
+    // Entries of the outbox still held by a reply that failed to release them, released by the next one
+    size_t _outbox_held;
 #endif
     z_owned_queryable_t _queryable;
     z_owned_liveliness_token_t _liveliness;
@@ -63,6 +101,18 @@ typedef struct {
 
 #if Z_FEATURE_ADVANCED_PUBLICATION == 1
 
+z_result_t _ze_advanced_cache_store_init(_ze_advanced_cache_store_t *store, size_t capacity);
+void _ze_advanced_cache_store_clear(_ze_advanced_cache_store_t *store);
+static inline size_t _ze_advanced_cache_store_len(const _ze_advanced_cache_store_t *store) { return store->_len; }
+// Move the sample into the history, the oldest one is moved into dropped when full, to be cleared out of the lock
+z_result_t _ze_advanced_cache_store_push(_ze_advanced_cache_store_t *store, _z_sample_t *sample, _z_sample_t *dropped);
+// Take up to max entries matching the ranges, newest first, they stay valid until released
+size_t _ze_advanced_cache_store_select(_ze_advanced_cache_store_t *store, const _ze_advanced_cache_range_t *range,
+                                       const _z_time_range_t *time, _z_ntp64_t now, size_t max,
+                                       _ze_advanced_cache_entry_t **entries);
+void _ze_advanced_cache_store_release(_ze_advanced_cache_store_t *store, _ze_advanced_cache_entry_t **entries,
+                                      size_t len);
+
 _ze_advanced_cache_t *_ze_advanced_cache_new(const z_loaned_session_t *zs, const z_loaned_keyexpr_t *keyexpr,
                                              const z_loaned_keyexpr_t *suffix,
                                              const ze_advanced_publisher_cache_options_t options);
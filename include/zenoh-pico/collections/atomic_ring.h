@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+#ifndef ZENOH_PICO_COLLECTIONS_ATOMIC_RING_H
+#define ZENOH_PICO_COLLECTIONS_ATOMIC_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "zenoh-pico/collections/atomic.h"
+#include "zenoh-pico/collections/element.h"
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if Z_FEATURE_MULTI_THREAD == 1
+/*-------- Lock-free bounded ring --------*/
+typedef struct {
+    // Position the cell is ready for: pushed at pos when equal to pos, pulled when equal to pos + 1
+    _z_atomic_size_t _seq;
+    void *_elem;
+} _z_atomic_ring_cell_t;
+
+/**
+ * Bounded ring of element pointers. Pushes and pulls never take a lock, the mutex and condition variables only park
+ * the threads blocked on an empty or full ring.
+ *
+ * In SPSC mode, only one thread may push and one thread may pull at a time. Otherwise any number of threads may do
+ * both, which is also what dropping the oldest element from the producer side needs.
+ */
+typedef struct {
+    _z_atomic_ring_cell_t *_cells;
+    size_t _mask;
+    size_t _capacity;
+    bool _spsc;
+    // Next positions to pull and to push
+    _z_atomic_size_t _head;
+    _z_atomic_size_t _tail;
+    _z_atomic_bool_t _closed;
+    // Set by the threads parked on an empty or a full ring, cleared by the change that wakes them up
+    _z_atomic_bool_t _pull_parked;
+    _z_atomic_bool_t _push_parked;
+    _z_mutex_t _mutex;
+    _z_condvar_t _cv_not_empty;
+    _z_condvar_t _cv_not_full;
+} _z_atomic_ring_t;
+
+z_result_t _z_atomic_ring_init(_z_atomic_ring_t *ring, size_t capacity, bool spsc);
+void _z_atomic_ring_clear(_z_atomic_ring_t *ring, z_element_free_f free_f);
+
+size_t _z_atomic_ring_capacity(const _z_atomic_ring_t *ring);
+size_t _z_atomic_ring_len(_z_atomic_ring_t *ring);
+bool _z_atomic_ring_is_closed(_z_atomic_ring_t *ring);
+// Wake up all the parked threads, pulls report _Z_RES_CHANNEL_CLOSED once the ring is drained
+z_result_t _z_atomic_ring_close(_z_atomic_ring_t *ring);
+
+// Non-blocking, return false or NULL on a full or empty ring
+bool _z_atomic_ring_try_push(_z_atomic_ring_t *ring, void *elem);
+void *_z_atomic_ring_try_pull(_z_atomic_ring_t *ring);
+// Pull up to len elements at once, returns how many were pulled
+size_t _z_atomic_ring_try_pull_many(_z_atomic_ring_t *ring, void **elems, size_t len);
+
+// Park until there is room for the element, returns _Z_RES_CHANNEL_CLOSED and leaves it to the caller on a closed ring
+z_result_t _z_atomic_ring_push(_z_atomic_ring_t *ring, void *elem);
+// Drop the oldest elements until there is room for the new one, not available in SPSC mode
+z_result_t _z_atomic_ring_push_force_drop(_z_atomic_ring_t *ring, void *elem, z_element_free_f free_f);
+// Park until an element is available or the ring is closed
+z_result_t _z_atomic_ring_pull(_z_atomic_ring_t *ring, void **elem);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ZENOH_PICO_COLLECTIONS_ATOMIC_RING_H
@@ -16,6 +16,7 @@
 
 #include <stdint.h>
 
+#include "zenoh-pico/collections/atomic_ring.h"
 #include "zenoh-pico/collections/element.h"
 #include "zenoh-pico/collections/fifo.h"
 #include "zenoh-pico/system/platform.h"
@@ -26,12 +27,12 @@ extern "C" {
 
 /*-------- Fifo Buffer Multithreaded --------*/
 typedef struct {
+#if Z_FEATURE_MULTI_THREAD == 1
+    // Pushes park while the fifo is full
+    _z_atomic_ring_t _ring;
+#else
     _z_fifo_t _fifo;
     bool is_closed;
-#if Z_FEATURE_MULTI_THREAD == 1
-    _z_mutex_t _mutex;
-    _z_condvar_t _cv_not_full;
-    _z_condvar_t _cv_not_empty;
 #endif
 } _z_fifo_mt_t;
 
@@ -46,6 +47,10 @@ z_result_t _z_fifo_mt_push(const void *src, void *context, z_element_free_f elem
 
 z_result_t _z_fifo_mt_pull(void *dst, void *context, z_element_move_f element_move);
 z_result_t _z_fifo_mt_try_pull(void *dst, void *context, z_element_move_f element_move);
+// Move up to len elements into the dst array, elements being elem_size apart. Returns _Z_RES_CHANNEL_NODATA or
+// _Z_RES_CHANNEL_CLOSED when none was available.
+z_result_t _z_fifo_mt_try_pull_many(void *dst, size_t elem_size, size_t len, size_t *pulled, void *context,
+                                    z_element_move_f element_move);
 
 #ifdef __cplusplus
 }
@@ -19,6 +19,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "zenoh-pico/collections/atomic.h"
+#include "zenoh-pico/config.h"
 #include "zenoh-pico/utils/result.h"
 
 #ifdef __cplusplus
@@ -36,7 +38,8 @@ static inline _z_delete_context_t _z_delete_context_null(void) { return (_z_dele
 static inline _z_delete_context_t _z_delete_context_create(void (*deleter)(void *context, void *data), void *context) {
     _z_delete_context_t ret;
     ret.deleter = deleter;
-    ret.context = context;
+    // A context without deleter is never used, keep it null so it can't be mistaken for a shared buffer
+    ret.context = (deleter != NULL) ? context : NULL;
     return ret;
 }
 static inline bool _z_delete_context_is_null(const _z_delete_context_t *c) { return c->deleter == NULL; }
@@ -104,6 +107,46 @@ bool _z_slice_eq(const _z_slice_t *left, const _z_slice_t *right);
 void _z_slice_free(_z_slice_t **bs);
 bool _z_slice_is_alloced(const _z_slice_t *s);
 
+#if Z_FEATURE_RX_ZERO_COPY == 1
+/*-------- Shared Buffer --------*/
+/**
+ * A reference counted heap buffer. Slices pointing into it can be retained by taking a reference instead of copying.
+ *
+ * Members:
+ *   _z_atomic_size_t _rc: The number of references to the buffer.
+ *   void (*_recycle_f)(struct _z_shared_buf_t *): Called once the last reference is dropped.
+ *   void *_owner: The pool the buffer belongs to.
+ *   size_t _capacity: The size of the data array.
+ *   uint8_t *_data: A pointer to the data array.
+ */
+typedef struct _z_shared_buf_t {
+    _z_atomic_size_t _rc;
+    void (*_recycle_f)(struct _z_shared_buf_t *buf);
+    void *_owner;
+    size_t _capacity;
+    uint8_t *_data;
+} _z_shared_buf_t;
+
+static inline void _z_shared_buf_acquire(_z_shared_buf_t *buf) {
+    _z_atomic_size_fetch_add(&buf->_rc, 1, _z_memory_order_relaxed);
+}
+static inline bool _z_shared_buf_is_unique(_z_shared_buf_t *buf) {
+    return _z_atomic_size_load(&buf->_rc, _z_memory_order_acquire) == 1;
+}
+void _z_shared_buf_release(_z_shared_buf_t *buf);
+
+// Non-owning slice into a shared buffer: it is cleared and moved like any alias, only _z_slice_share looks at buf.
+static inline _z_slice_t _z_slice_alias_shared(const uint8_t *p, size_t len, _z_shared_buf_t *buf) {
+    _z_delete_context_t dc = _z_delete_context_null();
+    dc.context = buf;
+    return _z_slice_from_buf_custom_deleter(p, len, dc);
+}
+// Returns the shared buffer the slice points into, NULL if none
+_z_shared_buf_t *_z_slice_get_shared_buf(const _z_slice_t *s);
+// Makes dst an owning slice over the bytes of src if they live in a shared buffer, returns false otherwise
+bool _z_slice_share(_z_slice_t *dst, const _z_slice_t *src);
+#endif
+
 /*-------- View Slice --------*/
 /**
  * A non-owning view of an array of bytes.
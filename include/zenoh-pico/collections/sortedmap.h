@@ -39,25 +39,42 @@ typedef struct {
     void *_val;
 } _z_sortedmap_entry_t;
 
+// Levels of the skip list, enough for 4^12 entries
+#define _Z_SORTEDMAP_MAX_LEVEL 12
+
 /**
- * A sorted map.
+ * A skip list node. The entry comes first so that an entry popped out of the map is freed with its node.
+ */
+typedef struct _z_sortedmap_node_t {
+    _z_sortedmap_entry_t _entry;
+    struct _z_sortedmap_node_t *_next[];
+} _z_sortedmap_node_t;
+
+/**
+ * A sorted map, stored in a skip list.
  *
  * Members:
- *   _z_list_t *_vals: a linked list containing the values
+ *   _z_sortedmap_node_t *_head: the first node of each level
+ *   size_t _len: the number of entries
+ *   uint8_t _level: the number of levels in use
+ *   uint32_t _seed: the state of the generator drawing node levels
  *   z_element_cmp_f _f_cmp: the function used to compare keys
  */
 typedef struct {
-    _z_list_t *_vals;
+    _z_sortedmap_node_t *_head[_Z_SORTEDMAP_MAX_LEVEL];
+    size_t _len;
+    uint8_t _level;
+    uint32_t _seed;
     z_element_cmp_f _f_cmp;
 } _z_sortedmap_t;
 
 /**
- * Iterator for a generic key-value hashmap.
+ * Iterator for a sorted map.
  */
 typedef struct {
     _z_sortedmap_entry_t *_entry;
     const _z_sortedmap_t *_map;
-    _z_list_t *_list_ptr;
+    _z_sortedmap_node_t *_node;
     bool _initialized;
 } _z_sortedmap_iterator_t;
 
@@ -66,6 +83,8 @@ _z_sortedmap_t _z_sortedmap_make(z_element_cmp_f f_cmp);
 
 void *_z_sortedmap_insert(_z_sortedmap_t *map, void *key, void *val, z_element_free_f f, bool replace);
 void *_z_sortedmap_get(const _z_sortedmap_t *map, const void *key);
+// Returns the first entry without removing it, NULL if the map is empty
+const _z_sortedmap_entry_t *_z_sortedmap_first(const _z_sortedmap_t *map);
 _z_sortedmap_entry_t *_z_sortedmap_pop_first(_z_sortedmap_t *map);
 void _z_sortedmap_remove(_z_sortedmap_t *map, const void *key, z_element_free_f f);
 
@@ -129,6 +148,10 @@ void *_z_sortedmap_iterator_value(const _z_sortedmap_iterator_t *iter);
     static inline val_type *map_name##_sortedmap_get(const map_name##_sortedmap_t *m, const key_type *k) {         \
         return (val_type *)_z_sortedmap_get(m, k);                                                                 \
     }                                                                                                              \
+    static inline key_type *map_name##_sortedmap_first_key(const map_name##_sortedmap_t *m) {                      \
+        const map_name##_sortedmap_entry_t *entry = _z_sortedmap_first(m);                                        \
+        return (entry != NULL) ? (key_type *)entry->_key : NULL;                                                   \
+    }                                                                                                              \
     static inline map_name##_sortedmap_entry_t *map_name##_sortedmap_pop_first(map_name##_sortedmap_t *m) {        \
         return (map_name##_sortedmap_entry_t *)_z_sortedmap_pop_first(m);                                          \
     }                                                                                                              \
@@ -185,6 +185,20 @@ static inline _ZP_STATIC_DEQUE_TEMPLATE_ELEM_TYPE *_ZP_CAT(_ZP_STATIC_DEQUE_TEMP
     return &deque->_buffer[deque->_start];
 }
 
+// Returns a pointer to the element at position @p index counted from the front of the deque,
+// or NULL if the deque holds no more than @p index elements.
+static inline _ZP_STATIC_DEQUE_TEMPLATE_ELEM_TYPE *_ZP_CAT(_ZP_STATIC_DEQUE_TEMPLATE_NAME,
+                                                           get)(_ZP_STATIC_DEQUE_TEMPLATE_TYPE *deque, size_t index) {
+    if (index >= deque->_size) {
+        return NULL;
+    }
+    size_t idx = deque->_start + index;
+    if (idx >= _ZP_STATIC_DEQUE_TEMPLATE_SIZE) {
+        idx -= _ZP_STATIC_DEQUE_TEMPLATE_SIZE;
+    }
+    return &deque->_buffer[idx];
+}
+
 #undef _ZP_STATIC_DEQUE_TEMPLATE_TYPE
 #undef _ZP_STATIC_DEQUE_TEMPLATE_ELEM_TYPE
 #undef _ZP_STATIC_DEQUE_TEMPLATE_NAME
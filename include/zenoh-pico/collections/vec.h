@@ -105,6 +105,15 @@ static inline _z_svec_t _z_svec_alias_element(void *element) {
     ret._aliased = true;
     return ret;
 }
+// An empty vector over storage it doesn't own, such as a stack array, until it outgrows it
+static inline _z_svec_t _z_svec_alias_storage(void *storage, size_t capacity) {
+    _z_svec_t ret;
+    ret._capacity = capacity;
+    ret._len = 0;
+    ret._val = storage;
+    ret._aliased = true;
+    return ret;
+}
 static inline size_t _z_svec_len(const _z_svec_t *v) { return v->_len; }
 static inline bool _z_svec_is_empty(const _z_svec_t *v) { return v->_len == 0; }
 static inline void *_z_svec_get(const _z_svec_t *v, size_t i, size_t element_size) {
@@ -165,6 +174,9 @@ void _z_svec_release(_z_svec_t *v);
         return ret;                                                                                                 \
     }                                                                                                               \
     static inline name##_svec_t name##_svec_alias_element(type *e) { return _z_svec_alias_element((void *)e); }     \
+    static inline name##_svec_t name##_svec_alias_storage(type *storage, size_t capacity) {                         \
+        return _z_svec_alias_storage((void *)storage, capacity);                                                    \
+    }                                                                                                               \
     static inline z_result_t name##_svec_move(name##_svec_t *dst, name##_svec_t *src) {                             \
         _z_svec_move(dst, src);                                                                                     \
         return _Z_RES_OK;                                                                                           \
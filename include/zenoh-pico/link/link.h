@@ -19,6 +19,7 @@
 #include "zenoh-pico/link/endpoint.h"
 #include "zenoh-pico/link/transport/bt.h"
 #include "zenoh-pico/link/transport/raweth.h"
+#include "zenoh-pico/link/transport/socket.h"
 #include "zenoh-pico/link/transport/tcp.h"
 #include "zenoh-pico/link/transport/udp_unicast.h"
 #include "zenoh-pico/link/transport/ws.h"
@@ -90,13 +91,18 @@ typedef void (*_z_f_link_close)(struct _z_link_t *self);
 typedef size_t (*_z_f_link_write)(const struct _z_link_t *self, const uint8_t *ptr, size_t len,
                                   _z_sys_net_socket_t *socket);
 typedef size_t (*_z_f_link_write_all)(const struct _z_link_t *self, const uint8_t *ptr, size_t len);
+typedef z_result_t (*_z_f_link_write_vec)(const struct _z_link_t *self, const _z_socket_msg_t *msgs, size_t count,
+                                          _z_sys_net_socket_t *socket);
 typedef size_t (*_z_f_link_read)(const struct _z_link_t *self, uint8_t *ptr, size_t len, _z_slice_t *addr);
 typedef size_t (*_z_f_link_read_exact)(const struct _z_link_t *self, uint8_t *ptr, size_t len, _z_slice_t *addr,
                                        _z_sys_net_socket_t *socket);
-typedef size_t (*_z_f_link_read_socket)(const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len);
+typedef size_t (*_z_f_link_read_socket)(const struct _z_link_t *self, const _z_sys_net_socket_t socket, uint8_t *ptr,
+                                        size_t len);
 typedef void (*_z_f_link_free)(struct _z_link_t *self);
 
-static inline size_t _z_noop_link_read_socket(const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len) {
+static inline size_t _z_noop_link_read_socket(const struct _z_link_t *self, const _z_sys_net_socket_t socket,
+                                              uint8_t *ptr, size_t len) {
+    _ZP_UNUSED(self);
     _ZP_UNUSED(socket);
     _ZP_UNUSED(ptr);
     _ZP_UNUSED(len);
@@ -146,6 +152,8 @@ typedef struct _z_link_t {
     _z_f_link_close _close_f;
     _z_f_link_write _write_f;
     _z_f_link_write_all _write_all_f;
+    // Optional scatter/gather write, NULL if the link doesn't support it
+    _z_f_link_write_vec _write_vec_f;
     _z_f_link_read _read_f;
     _z_f_link_read_exact _read_exact_f;
     _z_f_link_read_socket _read_socket_f;
@@ -162,12 +170,21 @@ z_result_t _z_open_link(_z_link_t *zl, const _z_string_t *locator, const _z_conf
 z_result_t _z_listen_link(_z_link_t *zl, const _z_string_t *locator, const _z_config_t *session_cfg);
 
 z_result_t _z_link_send_wbuf(const _z_link_t *zl, const _z_wbuf_t *wbf, _z_sys_net_socket_t *socket);
+z_result_t _z_link_send_msgs(const _z_link_t *zl, const _z_socket_msg_t *msgs, size_t count,
+                             _z_sys_net_socket_t *socket);
+static inline bool _z_link_has_write_vec(const _z_link_t *zl) { return zl->_write_vec_f != NULL; }
 size_t _z_link_recv_zbuf(const _z_link_t *zl, _z_zbuf_t *zbf, _z_slice_t *addr);
 size_t _z_link_recv_exact_zbuf(const _z_link_t *zl, _z_zbuf_t *zbf, size_t len, _z_slice_t *addr,
                                _z_sys_net_socket_t *socket);
 size_t _z_link_socket_recv_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, const _z_sys_net_socket_t socket);
 const _z_sys_net_socket_t *_z_link_get_socket(const _z_link_t *link);
 
+#if defined(Z_TEST_HOOKS)
+// Returns true to discard a datagram received on the link, as if it was lost
+typedef bool (*_z_link_recv_drop_override_fn)(const _z_link_t *link, const uint8_t *buf, size_t len);
+void _z_link_set_recv_drop_override(_z_link_recv_drop_override_fn fn);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
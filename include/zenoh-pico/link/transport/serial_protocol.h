@@ -33,18 +33,44 @@ extern "C" {
 #define _Z_SERIAL_MAX_COBS_BUF_SIZE \
     1516  // Max On-the-wire length for an MFS/MTU of 1510/1500 (MFS + Overhead Byte (OHB) + End of packet (EOP))
 
+// Drivers whose reads return the bytes available instead of waiting for the whole length are read in bulk
+#if defined(ZENOH_LINUX) || defined(ZENOH_MACOS) || defined(ZENOH_BSD) || defined(ZENOH_MBED) || \
+    defined(ZENOH_THREADX_STM32)
+#define _Z_SERIAL_RX_CHUNK_SIZE _Z_SERIAL_MAX_COBS_BUF_SIZE
+#else
+#define _Z_SERIAL_RX_CHUNK_SIZE 1
+#endif
+#define _Z_SERIAL_RX_BUF_SIZE (_Z_SERIAL_MAX_COBS_BUF_SIZE + _Z_SERIAL_RX_CHUNK_SIZE)
+
+/**
+ * Buffers of a serial socket, allocated when opening it. Received frames are delimited and decoded in place, the
+ * bytes past the last complete frame are kept for the next read.
+ */
+typedef struct {
+    uint8_t _rx[_Z_SERIAL_RX_BUF_SIZE];
+    size_t _rx_start;
+    size_t _rx_end;
+    // Bytes up to there are known not to be a frame delimiter
+    size_t _rx_scan;
+    // Decoding needs as much room as the encoded frame
+    uint8_t _rx_tmp[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+    uint8_t _tx[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+    uint8_t _tx_tmp[_Z_SERIAL_MFS_SIZE];
+} _z_serial_buffers_t;
+
 typedef struct {
     _z_sys_net_socket_t _sock;
+    _z_serial_buffers_t *_bufs;
 } _z_serial_socket_t;
 
 z_result_t _z_serial_endpoint_valid(const _z_endpoint_t *endpoint);
 z_result_t _z_serial_protocol_open(_z_serial_socket_t *sock, const _z_endpoint_t *endpoint);
 z_result_t _z_serial_protocol_listen(_z_serial_socket_t *sock, const _z_endpoint_t *endpoint);
 void _z_serial_protocol_close(_z_serial_socket_t *sock);
-z_result_t _z_connect_serial(const _z_sys_net_socket_t sock);
-size_t _z_read_serial(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
-size_t _z_send_serial(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t len);
-size_t _z_read_exact_serial(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
+z_result_t _z_connect_serial(const _z_serial_socket_t *sock);
+size_t _z_read_serial(const _z_serial_socket_t *sock, uint8_t *ptr, size_t len);
+size_t _z_send_serial(const _z_serial_socket_t *sock, const uint8_t *ptr, size_t len);
+size_t _z_read_exact_serial(const _z_serial_socket_t *sock, uint8_t *ptr, size_t len);
 
 #endif
 
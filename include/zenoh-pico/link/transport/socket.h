@@ -48,8 +48,56 @@ static inline void _z_socket_wait_iter_set_ready(_z_socket_wait_iter_t *iter, bo
     iter->_set_ready(iter, ready);
 }
 
+// Scatter/gather buffer, converted to the platform iovec when sending
+typedef struct {
+    const uint8_t *_buf;
+    size_t _len;
+} _z_socket_iovec_t;
+
+// A link message made of several buffers sent back to back: a datagram or a chunk of a stream
+typedef struct {
+    const _z_socket_iovec_t *_iov;
+    size_t _iov_len;
+} _z_socket_msg_t;
+
 z_result_t _z_socket_wait_readable(_z_socket_wait_iter_t *iter, uint32_t timeout_ms);
 
+#if defined(ZP_PLATFORM_SOCKET_EPOLL) && \
+    (Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_UDP_MULTICAST == 1 || Z_FEATURE_LINK_UDP_UNICAST == 1)
+#define _Z_SOCKET_WAIT_SET_ENABLED 1
+#define _Z_SOCKET_WAIT_SET_READY_MAX 64
+
+// Sockets registered once and waited on without walking them, wakeups are edge-triggered: a ready socket must be
+// read until it would block before the next wakeup is guaranteed.
+typedef struct {
+    int _epfd;
+    // Registered iterator entries, indexed by file descriptor
+    void **_entries;
+    size_t _entries_len;
+    // File descriptors reported by the last wait
+    int _ready[_Z_SOCKET_WAIT_SET_READY_MAX];
+    size_t _ready_len;
+} _z_socket_wait_set_t;
+
+z_result_t _z_socket_wait_set_init(_z_socket_wait_set_t *set);
+void _z_socket_wait_set_clear(_z_socket_wait_set_t *set);
+z_result_t _z_socket_wait_set_add(_z_socket_wait_set_t *set, const _z_sys_net_socket_t *sock, void *entry);
+void _z_socket_wait_set_remove(_z_socket_wait_set_t *set, const _z_sys_net_socket_t *sock);
+// Returns _Z_NO_DATA_PROCESSED if no socket became ready before the timeout
+z_result_t _z_socket_wait_set_wait(_z_socket_wait_set_t *set, uint32_t timeout_ms);
+// Flag the entries of the last wait as ready through the iterator, entries removed since then are skipped
+void _z_socket_wait_set_mark_ready(_z_socket_wait_set_t *set, _z_socket_wait_iter_t *iter);
+#endif
+
+#if defined(ZP_PLATFORM_SOCKET_POSIX) && \
+    (Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_UDP_MULTICAST == 1 || Z_FEATURE_LINK_UDP_UNICAST == 1)
+// Write all the messages on a stream socket, with as few system calls as possible
+z_result_t _z_socket_write_vec(const _z_sys_net_socket_t *sock, const _z_socket_msg_t *msgs, size_t count);
+// Send each message as one datagram, to rep if not NULL
+z_result_t _z_socket_send_msgs(const _z_sys_net_socket_t *sock, const _z_socket_msg_t *msgs, size_t count,
+                               const _z_sys_net_endpoint_t *rep);
+#endif
+
 z_result_t _z_socket_set_blocking(const _z_sys_net_socket_t *sock, bool blocking);
 z_result_t _z_ip_port_to_endpoint(const uint8_t *address, size_t address_len, uint16_t port, char *dst, size_t dst_len);
 z_result_t _z_socket_get_endpoints(const _z_sys_net_socket_t *sock, char *local, size_t local_len, char *remote,
@@ -25,17 +25,6 @@
 extern "C" {
 #endif
 
-typedef struct {
-    uintptr_t peer;
-    uint32_t decl_id;
-} _z_filter_target_t;
-
-typedef z_element_eq_f _z_filter_target_eq_f;
-typedef z_element_eq_f _z_filter_target_predicate_f;
-#define _z_filter_target_elem_copy _z_noop_copy
-#define _z_filter_target_elem_clear _z_noop_clear
-_Z_SLIST_DEFINE(_z_filter_target, _z_filter_target_t, false)
-
 typedef enum {
     WRITE_FILTER_ACTIVE = 0,
     WRITE_FILTER_OFF = 1,
@@ -53,18 +42,24 @@ typedef struct {
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_t mutex;
 #endif
-    _z_filter_target_slist_t *targets;
 #if Z_FEATURE_MATCHING == 1
     _z_closure_matching_status_intmap_t callbacks;
+    // Last status given to the callbacks, protected by the mutex
+    bool notified_matching;
+    // Whether the filter waits in the session pending list, protected by the session mutex
+    bool pending;
 #endif
     _z_keyexpr_t key;
+    uint32_t interest_id;
     uint8_t state;
     bool is_complete;
     bool is_aggregate;
     bool allow_local;
     bool allow_remote;
     _z_write_filter_target_type_t target_type;
+    // Matching entities, counted under the session mutex
     size_t local_targets;
+    size_t remote_targets;
     struct _z_write_filter_registration_t *registration;
 } _z_write_filter_ctx_t;
 
@@ -89,6 +84,30 @@ void _z_write_filter_notify_subscriber(struct _z_session_t *session, const _z_ke
 void _z_write_filter_notify_queryable(struct _z_session_t *session, const _z_keyexpr_t *key,
                                       z_locality_t allowed_origin, bool is_complete, bool add);
 
+#if Z_FEATURE_INTEREST == 1
+/**
+ * Count a remote declaration in the write filters it matches, or stop counting it. A declaration answering an
+ * interest only matches the write filter that expressed it.
+ *
+ * These functions are unsafe because they operate in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling them:
+ *  - session->_mutex_inner
+ * The matching status changes are notified by _z_write_filter_notify_pending once the mutex is released.
+ */
+void _z_write_filter_unsafe_add_remote(struct _z_session_t *session, const _z_declare_data_t *decl);
+void _z_write_filter_unsafe_remove_remote(struct _z_session_t *session, const _z_declare_data_t *decl);
+
+/**
+ * Notify the matching listeners of the write filters whose status changed, once for all the changes made since the
+ * last call.
+ */
+void _z_write_filter_notify_pending(struct _z_session_t *session);
+/**
+ * Forget the pending notifications, when the session is closed.
+ */
+void _z_write_filter_drop_pending(struct _z_session_t *session);
+#endif
+
 #if Z_FEATURE_MATCHING
 z_result_t _z_write_filter_ctx_add_callback(_z_write_filter_ctx_t *filter, size_t id, _z_closure_matching_status_t *v);
 void _z_write_filter_ctx_remove_callback(_z_write_filter_ctx_t *filter, size_t id);
@@ -151,6 +151,28 @@ z_result_t _z_write(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, cons
                     z_priority_t priority, bool is_express, const _z_timestamp_t *timestamp,
                     const _z_bytes_t *attachment, z_reliability_t reliability, const _z_source_info_t *source_info,
                     z_locality_t allowed_destination);
+
+/**
+ * Write data for the key expression of a publisher, as :c:func:`_z_write` does with the publisher options. The
+ * header of the message is the one encoded when the publisher was declared.
+ *
+ * Parameters:
+ *     zn: The zenoh-net session. The caller keeps its ownership.
+ *     pub: The publisher to write from.
+ *     payload: The value to write.
+ *     encoding: The encoding of the payload. The caller keeps its ownership.
+ *     kind: The kind of value.
+ *     timestamp: The timestamp of this write. The API level timestamp (e.g. of the data when it was created).
+ *     attachment: An optional attachment to this write.
+ *     reliability: The message reliability.
+ *     source_info: The message source info.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+z_result_t _z_publisher_write(_z_session_t *zn, const _z_publisher_t *pub, const _z_bytes_t *payload,
+                              const _z_encoding_t *encoding, z_sample_kind_t kind, const _z_timestamp_t *timestamp,
+                              const _z_bytes_t *attachment, z_reliability_t reliability,
+                              const _z_source_info_t *source_info);
 #endif
 
 #if Z_FEATURE_SUBSCRIPTION == 1
@@ -177,6 +199,35 @@ z_result_t _z_register_subscriber(uint32_t *out_sub_id, const _z_session_rc_t *z
                                   _z_closure_sample_callback_t callback, _z_drop_handler_t dropper, void *arg,
                                   z_locality_t allowed_origin, const _z_sync_group_t *opt_callback_drop_sync_group);
 
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+/**
+ * Declare a :c:type:`_z_subscriber_t` whose callback receives the samples by batches.
+ *
+ * Parameters:
+ *     subscriber: The subscriber to initialize.
+ *     zn: The zenoh-net session. The caller keeps its ownership.
+ *     keyexpr: The resource key to subscribe.
+ *     callback: The callback function that will be called with the samples received, once **max_samples** of them
+ * are waiting or once the batch they were received in is processed.
+ *     dropper: A function that will be called once subscriber is undeclared.
+ *     arg: A pointer that will be passed to the **callback** on each call.
+ *     max_samples: The maximum number of samples passed to a call of the **callback**.
+ *
+ * Returns:
+ *    0 in case of success, negative error code otherwise.
+ */
+z_result_t _z_declare_batched_subscriber(_z_subscriber_t *subscriber, const _z_session_rc_t *zn,
+                                         const _z_declared_keyexpr_t *keyexpr,
+                                         _z_closure_sample_batch_callback_t callback, _z_drop_handler_t dropper,
+                                         void *arg, z_locality_t allowed_origin, size_t max_samples);
+
+z_result_t _z_register_batched_subscriber(uint32_t *out_sub_id, const _z_session_rc_t *zn,
+                                          const _z_declared_keyexpr_t *keyexpr,
+                                          _z_closure_sample_batch_callback_t callback, _z_drop_handler_t dropper,
+                                          void *arg, z_locality_t allowed_origin, size_t max_samples,
+                                          const _z_sync_group_t *opt_callback_drop_sync_group);
+#endif
+
 /**
  * Undeclare a :c:type:`_z_subscriber_t`.
  *
@@ -336,8 +387,12 @@ z_result_t _z_query(const _z_session_rc_t *session, _z_optional_id_t querier_id,
 #endif
 
 #if Z_FEATURE_INTEREST == 1
-uint32_t _z_add_interest(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, _z_interest_handler_t callback,
-                         uint8_t flags, _z_void_rc_t *arg);
+/**
+ * Declare an interest and send it when needed. The id is given by the caller, so that the declarations answering
+ * the interest can be told apart as soon as it is sent. The known declarations are replayed to the callback, if any.
+ */
+z_result_t _z_add_interest(_z_session_t *zn, uint32_t id, const _z_declared_keyexpr_t *keyexpr,
+                           _z_interest_handler_t callback, uint8_t flags, _z_void_rc_t *arg);
 z_result_t _z_remove_interest(_z_session_t *zn, uint32_t interest_id);
 #endif
 
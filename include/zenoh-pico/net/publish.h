@@ -38,6 +38,8 @@ typedef struct _z_publisher_t {
     bool _is_express;
     z_locality_t _allowed_destination;
     _z_write_filter_t _filter;
+    // Header, key and extensions of the push messages, encoded at declaration
+    _z_slice_t _push_prefix;
 } _z_publisher_t;
 
 #if Z_FEATURE_PUBLICATION == 1
@@ -24,9 +24,12 @@
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/network.h"
 #include "zenoh-pico/runtime/runtime.h"
+#include "zenoh-pico/session/keyexpr_trie.h"
 #include "zenoh-pico/session/liveliness.h"
 #include "zenoh-pico/session/matching.h"
+#include "zenoh-pico/session/peer_routing.h"
 #include "zenoh-pico/session/queryable.h"
+#include "zenoh-pico/session/rx_dispatch.h"
 #include "zenoh-pico/session/session.h"
 #include "zenoh-pico/session/subscription.h"
 #include "zenoh-pico/utils/config.h"
@@ -159,7 +162,7 @@ typedef struct _z_session_t {
 #endif
 
     // Session declarations
-    _z_resource_slist_t *_local_resources;
+    _z_resource_table_t *_local_resources;
 
     // Information for session restoring and asynchronous peer connection
     _z_config_t _config;
@@ -168,6 +171,21 @@ typedef struct _z_session_t {
 #if Z_FEATURE_SUBSCRIPTION == 1
     _z_subscription_rc_slist_t *_subscriptions;
     _z_subscription_rc_slist_t *_liveliness_subscriptions;
+    // Key expression indexes over the subscription lists, used for dispatch
+    _z_keyexpr_trie_t _subscriptions_index;
+    _z_keyexpr_trie_t _liveliness_subscriptions_index;
+#if Z_FEATURE_RX_CACHE == 1
+    _z_subscription_cache_lru_cache_t _subscription_cache;
+    _z_subscription_cache_stats_t _subscription_cache_stats;
+#endif
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    // Batched subscriptions holding samples, the count lets the read tasks skip the lock when there are none
+    _z_subscription_rc_svec_t _subscription_batches_pending;
+    _z_atomic_size_t _subscription_batches_pending_count;
+#endif
+#if Z_FEATURE_RX_DISPATCH == 1
+    _z_rx_dispatch_t _rx_dispatch;
+#endif
 #endif
 
 #if Z_FEATURE_LIVELINESS == 1
@@ -185,14 +203,34 @@ typedef struct _z_session_t {
     _z_rid_to_count_hmap_t _received_queries_id_to_count;
 #endif
 #if Z_FEATURE_QUERY == 1
-    _z_pending_query_slist_t *_pending_queries;
+    _z_pending_query_hmap_t _pending_queries;
+    // Soonest deadlines of the pending queries. The ones from the horizon on may be missing when it does not hold them
+    // all, the queue is then sorted again from the pending queries once the horizon is reached.
+    _z_pending_query_deadline_pqueue_t _pending_query_deadlines;
+    uint64_t _pending_query_deadlines_horizon;
+    z_clock_t _pending_query_epoch;
+    // Wake up time of the timeout timer, UINT64_MAX when none is running. A timer is spawned for an earlier deadline,
+    // the ones of older generations exit when they wake up, unless they are the only ones left.
+    uint64_t _pending_query_timer_ms;
+    size_t _pending_query_timer_gen;
+    bool _pending_query_timer_rearm;
 #endif
 
     // Session interests
 #if Z_FEATURE_INTEREST == 1
     _z_session_interest_rc_slist_t *_local_interests;
-    _z_declare_data_slist_t *_remote_declares;
-    struct _z_write_filter_registration_t *_write_filters;
+    // Key expression index over the local interest list, used to match the remote declarations
+    _z_keyexpr_trie_t _local_interests_index;
+    _z_declare_data_hmap_t _remote_declares;
+    // Write filters of the publishers and queriers, indexed by key expression to match the declarations against
+    _z_keyexpr_trie_t _write_filters;
+#if Z_FEATURE_MATCHING == 1
+    // Write filters whose matching status changed, notified once the session mutex is released
+    _z_list_t *_write_filters_pending;
+#endif
+#if Z_FEATURE_PEER_ROUTING == 1
+    _z_peer_route_table_t _peer_routes;
+#endif
 #endif
 
 #if Z_FEATURE_ADMIN_SPACE == 1
@@ -48,6 +48,8 @@ z_result_t _z_uint16_encode(_z_wbuf_t *buf, uint16_t v);
 z_result_t _z_uint16_decode(uint16_t *u16, _z_zbuf_t *buf);
 
 uint8_t _z_zint_len(uint64_t v);
+// Encoded length of a buffer of len bytes prefixed by its length
+static inline size_t _z_buf_prefixed_len(size_t len) { return _z_zint_len(len) + len; }
 uint8_t _z_zint64_encode_buf(uint8_t *buf, uint64_t v);
 static inline uint8_t _z_zsize_encode_buf(uint8_t *buf, _z_zint_t v) { return _z_zint64_encode_buf(buf, (uint64_t)v); }
 
@@ -85,7 +87,8 @@ static inline z_result_t _z_slice_decode(_z_slice_view_t *bs, _z_zbuf_t *zbf) {
         _Z_WARN("Not enough bytes to read");
         _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
     }
-    *bs = _z_slice_view_make(_z_zbuf_get_rptr(zbf), len);
+    _z_slice_t s = _z_zbuf_alias_slice(zbf, len);
+    *bs = _z_slice_view_from_slice(&s);
     _z_zbuf_set_rpos(zbf, _z_zbuf_get_rpos(zbf) + len);
     return _Z_RES_OK;
 }
@@ -110,17 +113,23 @@ z_result_t _z_encoding_decode(_z_encoding_view_t *en, _z_zbuf_t *zbf);
 z_result_t _z_value_encode(_z_wbuf_t *wbf, const _z_value_t *en);
 z_result_t _z_value_encode_ext(_z_wbuf_t *wbf, const _z_value_t *en);
 z_result_t _z_value_decode(_z_value_view_t *en, _z_zbuf_t *zbf);
+size_t _z_value_ext_encoded_len(const _z_value_t *en);
 
 z_result_t _z_wireexpr_encode(_z_wbuf_t *buf, bool has_suffix, const _z_wireexpr_t *ke);
 z_result_t _z_wireexpr_decode(_z_wireexpr_t *ke, _z_zbuf_t *buf, bool has_suffix, bool remote_mapping);
+size_t _z_wireexpr_encoded_len(bool has_suffix, const _z_wireexpr_t *ke);
 
 z_result_t _z_timestamp_encode(_z_wbuf_t *buf, const _z_timestamp_t *ts);
 z_result_t _z_timestamp_encode_ext(_z_wbuf_t *buf, const _z_timestamp_t *ts);
 z_result_t _z_timestamp_decode(_z_timestamp_t *ts, _z_zbuf_t *buf);
+size_t _z_timestamp_encoded_len(const _z_timestamp_t *ts);
+size_t _z_timestamp_ext_encoded_len(const _z_timestamp_t *ts);
 
 z_result_t _z_source_info_encode(_z_wbuf_t *wbf, const _z_source_info_t *info);
 z_result_t _z_source_info_encode_ext(_z_wbuf_t *wbf, const _z_source_info_t *info);
 z_result_t _z_source_info_decode(_z_source_info_t *info, _z_zbuf_t *zbf);
+size_t _z_source_info_encoded_len(const _z_source_info_t *info);
+size_t _z_source_info_ext_encoded_len(const _z_source_info_t *info);
 
 #ifdef __cplusplus
 }
@@ -54,6 +54,7 @@ z_result_t _z_undecl_token_decode(_z_undecl_token_t *decl, _z_zbuf_t *zbf, uint8
 
 z_result_t _z_declaration_encode(_z_wbuf_t *wbf, const _z_declaration_t *decl);
 z_result_t _z_declaration_decode(_z_declaration_t *decl, _z_zbuf_t *zbf);
+size_t _z_declaration_encoded_len(const _z_declaration_t *decl);
 
 #ifdef __cplusplus
 }
@@ -24,6 +24,7 @@ extern "C" {
 
 z_result_t _z_interest_encode(_z_wbuf_t *wbf, const _z_interest_t *interest, bool is_final);
 z_result_t _z_interest_decode(_z_interest_t *decl, _z_zbuf_t *zbf, bool is_final, bool has_ext);
+size_t _z_interest_encoded_len(const _z_interest_t *interest, bool is_final);
 
 #ifdef __cplusplus
 }
@@ -24,20 +24,26 @@ extern "C" {
 
 z_result_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb);
 z_result_t _z_push_body_decode(_z_push_body_t *body, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_push_body_encoded_len(const _z_push_body_t *pshb);
 
 z_result_t _z_query_encode(_z_wbuf_t *wbf, const _z_msg_query_t *query);
 z_result_t _z_query_decode(_z_msg_query_t *query, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_query_encoded_len(const _z_msg_query_t *query);
 z_result_t _z_reply_encode(_z_wbuf_t *wbf, const _z_msg_reply_t *reply);
 z_result_t _z_reply_decode(_z_msg_reply_t *reply, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_reply_encoded_len(const _z_msg_reply_t *reply);
 
 z_result_t _z_err_encode(_z_wbuf_t *wbf, const _z_msg_err_t *err);
 z_result_t _z_err_decode(_z_msg_err_t *err, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_err_encoded_len(const _z_msg_err_t *err);
 
 z_result_t _z_put_encode(_z_wbuf_t *wbf, const _z_msg_put_t *put);
 z_result_t _z_put_decode(_z_msg_put_t *put, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_put_encoded_len(const _z_msg_put_t *put);
 
 z_result_t _z_del_encode(_z_wbuf_t *wbf, const _z_msg_del_t *del);
 z_result_t _z_del_decode(_z_msg_del_t *del, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_del_encoded_len(const _z_msg_del_t *del);
 
 #ifdef __cplusplus
 }
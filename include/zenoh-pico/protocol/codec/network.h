@@ -26,21 +26,31 @@ extern "C" {
 
 z_result_t _z_push_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg);
 z_result_t _z_push_decode(_z_n_msg_push_t *msg, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_push_encoded_len(const _z_n_msg_push_t *msg);
+// Encode the part of the push messages on the key that comes before their body, once for all of them
+z_result_t _z_push_prefix_encode(_z_slice_t *prefix, const _z_wireexpr_t *key, _z_n_qos_t qos);
 z_result_t _z_request_encode(_z_wbuf_t *wbf, const _z_n_msg_request_t *msg);
 z_result_t _z_request_decode(_z_n_msg_request_t *msg, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_request_encoded_len(const _z_n_msg_request_t *msg);
 z_result_t _z_response_encode(_z_wbuf_t *wbf, const _z_n_msg_response_t *msg);
 z_result_t _z_response_decode(_z_n_msg_response_t *msg, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_response_encoded_len(const _z_n_msg_response_t *msg);
 z_result_t _z_response_final_encode(_z_wbuf_t *wbf, const _z_n_msg_response_final_t *msg);
 z_result_t _z_response_final_decode(_z_n_msg_response_final_t *msg, _z_zbuf_t *zbf, uint8_t header);
 z_result_t _z_declare_encode(_z_wbuf_t *wbf, const _z_n_msg_declare_t *decl);
 z_result_t _z_declare_decode(_z_n_msg_declare_t *decl, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_declare_encoded_len(const _z_n_msg_declare_t *decl);
 z_result_t _z_n_interest_encode(_z_wbuf_t *wbf, const _z_n_msg_interest_t *interest);
 z_result_t _z_n_interest_decode(_z_n_msg_interest_t *interest, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_n_interest_encoded_len(const _z_n_msg_interest_t *interest);
 z_result_t _z_oam_encode(_z_wbuf_t *wbf, const _z_n_msg_oam_t *oam);
 z_result_t _z_oam_decode(_z_n_msg_oam_t *oam, _z_zbuf_t *zbf, uint8_t header);
+size_t _z_oam_encoded_len(const _z_n_msg_oam_t *oam);
 
 z_result_t _z_network_message_encode(_z_wbuf_t *wbf, const _z_network_message_t *msg);
 z_result_t _z_network_message_decode(_z_network_message_t *msg, _z_zbuf_t *zbf);
+// Exact number of bytes _z_network_message_encode writes for the message, computed without encoding it
+size_t _z_network_message_encoded_len(const _z_network_message_t *msg);
 
 #ifdef __cplusplus
 }
@@ -43,6 +43,9 @@ z_result_t _z_close_decode(_z_t_msg_close_t *msg, _z_zbuf_t *zbf, uint8_t header
 z_result_t _z_keep_alive_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_keep_alive_t *msg);
 z_result_t _z_keep_alive_decode(_z_t_msg_keep_alive_t *msg, _z_zbuf_t *zbf, uint8_t header);
 
+z_result_t _z_t_oam_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_oam_t *msg);
+z_result_t _z_t_oam_decode(_z_t_msg_oam_t *msg, _z_zbuf_t *zbf, uint8_t header);
+
 z_result_t _z_frame_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_frame_t *msg);
 z_result_t _z_frame_decode(_z_t_msg_frame_t *msg, _z_zbuf_t *zbf, uint8_t header);
 
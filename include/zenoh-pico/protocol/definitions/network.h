@@ -203,6 +203,8 @@ typedef struct {
     _z_wireexpr_t _key;
     _z_timestamp_t _timestamp;
     _z_n_qos_t _qos;
+    // Header, key and extensions as encoded by _z_push_prefix_encode, written as is in place of the fields above
+    const _z_slice_t *_prefix;
     _z_push_body_t _body;
 } _z_n_msg_push_t;
 
@@ -226,6 +226,9 @@ void _z_s_msg_hello_clear(_z_s_msg_hello_t *msg);
 // (***) if Q==1 then 8 sequence numbers are present: one for each priority.
 //       if Q==0 then only one sequence number is present.
 //
+// The repair extension (unit, zenoh-pico specific) tells that the sender retransmits the reliable messages reported
+// lost by a NACK.
+//
 typedef struct {
     _z_zint_t _reliable;
     _z_zint_t _best_effort;
@@ -249,6 +252,9 @@ typedef struct {
 #if Z_FEATURE_FRAGMENTATION == 1
     uint8_t _patch;
 #endif
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    bool _repair;
+#endif
 } _z_t_msg_join_t;
 /*------------------ Init Message ------------------*/
 // # Init message
@@ -492,8 +498,66 @@ typedef struct {
     bool drop;
 } _z_t_msg_fragment_t;
 
+/*------------------ OAM Message ------------------*/
+// Operations, Administration and Maintenance of the transport. The ids below are specific to zenoh-pico, the nodes
+// not knowing an id skip its message.
+//
+// Flags:
+// - E |: Encoding     The encoding of the body
+// - E/
+// - Z: Extensions     If Z==1 then zenoh extensions will follow.
+//
+//  7 6 5 4 3 2 1 0
+// +-+-+-+-+-+-+-+-+
+// |Z|ENC|   OAM   |
+// +-+-+-+---------+
+// ~    id:z16     ~
+// +---------------+
+// ~   [OamExts]   ~ if Flag(Z)==1
+// +---------------+
+// %    length     % if ENC == Z64 || ENC == ZBuf
+// +---------------+
+// ~     [u8]      ~ if ENC == ZBuf
+// +---------------+
+//
+// NACK, ZBuf body. Sent on a multicast transport by a receiver that lost reliable messages of a peer, which
+// retransmits the ones it still holds from the given SN on.
+// +---------------+
+// |zid_len|X|X|X|X|
+// +-------+-------+
+// ~      [u8]     ~ -- ZenohID of the peer asked to retransmit
+// +---------------+
+// %    seq num    % -- First reliable SN missing
+// +---------------+
+//
+// ACKNACK, ZBuf body. Sent on a multicast transport by the peer answering a NACK, to all the receivers.
+// +---------------+
+// %   first sn    % -- Oldest reliable SN the peer can retransmit, the ones before it are lost
+// +---------------+
+// %    next sn    % -- SN of the next reliable message of the peer
+// +---------------+
+//
+#define _Z_T_OAM_ID_NACK 0x0101
+#define _Z_T_OAM_ID_ACKNACK 0x0102
+typedef struct {
+    _z_id_t _zid;
+    _z_zint_t _sn;
+} _z_t_msg_oam_nack_t;
+typedef struct {
+    _z_zint_t _first_sn;
+    _z_zint_t _next_sn;
+} _z_t_msg_oam_acknack_t;
+typedef struct {
+    union {
+        _z_t_msg_oam_nack_t _nack;
+        _z_t_msg_oam_acknack_t _acknack;
+    } _body;
+    uint16_t _id;
+} _z_t_msg_oam_t;
+
 /*------------------ Transport Message ------------------*/
 typedef union {
+    _z_t_msg_oam_t _oam;
     _z_t_msg_join_t _join;
     _z_t_msg_init_t _init;
     _z_t_msg_open_t _open;
@@ -525,6 +589,8 @@ _z_transport_message_t _z_t_msg_make_fragment_header(_z_zint_t sn, z_reliability
                                                      bool first, bool drop);
 _z_transport_message_t _z_t_msg_make_fragment(_z_zint_t sn, const _z_slice_t *messages, z_reliability_t reliability,
                                               bool is_last, bool first, bool drop);
+_z_transport_message_t _z_t_msg_make_nack(_z_id_t zid, _z_zint_t sn);
+_z_transport_message_t _z_t_msg_make_acknack(_z_zint_t first_sn, _z_zint_t next_sn);
 
 typedef union {
     _z_s_msg_scout_t _scout;
@@ -107,12 +107,34 @@ _Z_ELEM_DEFINE(_z_iosli, _z_iosli_t, _z_iosli_size, _z_iosli_clear, _z_iosli_cop
 _Z_SVEC_DEFINE(_z_iosli, _z_iosli_t)
 
 /*------------------ ZBuf ------------------*/
+#if Z_FEATURE_RX_ZERO_COPY == 1
+typedef struct _z_zbuf_pool_t _z_zbuf_pool_t;
+#endif
+
 typedef struct {
     _z_iosli_t _ios;
+#if Z_FEATURE_RX_ZERO_COPY == 1
+    // Shared buffer _ios points into, NULL for plain buffers
+    _z_shared_buf_t *_shared;
+    // Set if the zbuf holds a reference on _shared, fresh buffers are taken from it when that one is retained
+    _z_zbuf_pool_t *_pool;
+#endif
 } _z_zbuf_t;
 
 static inline _z_zbuf_t _z_zbuf_null(void) { return (_z_zbuf_t){0}; }
-static inline void _z_zbuf_reset(_z_zbuf_t *zbf) { _z_iosli_reset(&zbf->_ios); }
+#if Z_FEATURE_RX_ZERO_COPY == 1
+// Move the unread bytes at the start of a fresh buffer of the pool, returns false if none could be allocated
+bool _z_zbuf_unshare(_z_zbuf_t *zbf);
+#endif
+static inline void _z_zbuf_reset(_z_zbuf_t *zbf) {
+#if Z_FEATURE_RX_ZERO_COPY == 1
+    // Don't overwrite bytes that retained slices still point to
+    if ((zbf->_pool != NULL) && !_z_shared_buf_is_unique(zbf->_shared) && !_z_zbuf_unshare(zbf)) {
+        return;
+    }
+#endif
+    _z_iosli_reset(&zbf->_ios);
+}
 
 static inline size_t _z_zbuf_capacity(const _z_zbuf_t *zbf) { return zbf->_ios._capacity; }
 static inline size_t _z_zbuf_writable_space_left(const _z_zbuf_t *zbf) { return _z_iosli_writable(&zbf->_ios); }
@@ -134,9 +156,21 @@ static inline void _z_zbuf_set_wpos(_z_zbuf_t *zbf, size_t w_pos) {
 }
 static inline uint8_t *_z_zbuf_get_rptr(const _z_zbuf_t *zbf) { return zbf->_ios._buf + zbf->_ios._r_pos; }
 static inline uint8_t *_z_zbuf_get_wptr(const _z_zbuf_t *zbf) { return zbf->_ios._buf + zbf->_ios._w_pos; }
+// Non-owning slice of len bytes from the read position
+static inline _z_slice_t _z_zbuf_alias_slice(const _z_zbuf_t *zbf, size_t len) {
+#if Z_FEATURE_RX_ZERO_COPY == 1
+    return _z_slice_alias_shared(_z_zbuf_get_rptr(zbf), len, zbf->_shared);
+#else
+    return _z_slice_alias_buf(_z_zbuf_get_rptr(zbf), len);
+#endif
+}
 
 // Constructs a _borrowing_ reader on `slice`
 z_result_t _z_zbuf_init(_z_zbuf_t *zbf, size_t capacity);
+#if Z_FEATURE_RX_ZERO_COPY == 1
+// Allocates from a pool of reference counted buffers, so slices of the zbuf can be retained without a copy
+z_result_t _z_zbuf_init_shared(_z_zbuf_t *zbf, size_t capacity);
+#endif
 _z_zbuf_t _z_zbuf_view(_z_zbuf_t *zbf, size_t length);
 _z_zbuf_t _z_slice_as_zbuf(const _z_slice_t *slice);
 
@@ -181,6 +215,8 @@ z_result_t _z_wbuf_siphon(_z_wbuf_t *dst, _z_wbuf_t *src, size_t length);
 
 void _z_wbuf_copy(_z_wbuf_t *dst, const _z_wbuf_t *src);
 void _z_wbuf_reset(_z_wbuf_t *wbf);
+// Reset the buffer to the slice it was initialized with, for an expandable buffer to be reused between messages
+void _z_wbuf_reset_initial(_z_wbuf_t *wbf);
 void _z_wbuf_clear(_z_wbuf_t *wbf);
 void _z_wbuf_free(_z_wbuf_t **wbf);
 
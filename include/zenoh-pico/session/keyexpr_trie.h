@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef INCLUDE_ZENOH_PICO_SESSION_KEYEXPR_TRIE_H
+#define INCLUDE_ZENOH_PICO_SESSION_KEYEXPR_TRIE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/hash.h"
+#include "zenoh-pico/utils/result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Chunk-based key expression index.
+//
+// Every key expression is split on '/' and stored as a path of chunks. Verbatim chunks are stored in a hashmap
+// per node, while wildcard chunks go to two dedicated branches: `**` has its own child and every other chunk
+// containing a wildcard (`*`, `$*`) shares a single-chunk wildcard child. Values are opaque pointers owned by the
+// caller.
+//
+// Matching walks the trie chunk by chunk, so its cost depends on the depth of the key rather than on the number of
+// stored entries. Wildcard branches are traversed optimistically, so the set of visited values is a superset of the
+// values whose key intersects the queried one: callers are expected to confirm each candidate with
+// _z_keyexpr_intersects. A value inserted once is reported at most once per match.
+
+typedef struct _z_keyexpr_trie_node_t _z_keyexpr_trie_node_t;
+
+static inline size_t _z_keyexpr_trie_chunk_hash(const _z_string_t *chunk) {
+    return _z_hash_bytes((const uint8_t *)_z_string_data(chunk), _z_string_len(chunk));
+}
+
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_keyexpr_trie_children_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE _z_string_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_keyexpr_trie_node_t *
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN _z_keyexpr_trie_chunk_hash
+#define _ZP_HASHMAP_TEMPLATE_KEY_EQ_FN(left, right) _z_string_equals(left, right)
+#define _ZP_HASHMAP_TEMPLATE_KEY_DESTROY_FN _z_string_clear
+#define _ZP_HASHMAP_TEMPLATE_INITIAL_CAPACITY 4
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#include "zenoh-pico/collections/hashmap_template.h"
+
+#define _ZP_VECTOR_TEMPLATE_ELEM_TYPE void *
+#define _ZP_VECTOR_TEMPLATE_NAME _z_keyexpr_trie_value_vec
+#define _ZP_VECTOR_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_VECTOR_TEMPLATE_FREE_FN z_free
+#include "zenoh-pico/collections/vector_template.h"
+
+struct _z_keyexpr_trie_node_t {
+    _z_keyexpr_trie_children_hmap_t _children;
+    _z_keyexpr_trie_node_t *_star;
+    _z_keyexpr_trie_node_t *_double_star;
+    _z_keyexpr_trie_value_vec_t _values;
+    size_t _epoch;
+};
+
+typedef struct {
+    _z_keyexpr_trie_node_t _root;
+    size_t _epoch;
+    size_t _len;
+} _z_keyexpr_trie_t;
+
+/**
+ * The callback invoked for every candidate value visited by _z_keyexpr_trie_match.
+ * Returning an error stops the traversal and propagates the error to the caller.
+ */
+typedef z_result_t (*_z_keyexpr_trie_match_fn_t)(void *value, void *arg);
+
+void _z_keyexpr_trie_init(_z_keyexpr_trie_t *trie);
+void _z_keyexpr_trie_clear(_z_keyexpr_trie_t *trie);
+static inline size_t _z_keyexpr_trie_len(const _z_keyexpr_trie_t *trie) { return trie->_len; }
+
+/**
+ * Index a value under a key expression. The same value can be inserted under different keys.
+ */
+z_result_t _z_keyexpr_trie_insert(_z_keyexpr_trie_t *trie, const _z_keyexpr_t *key, void *value);
+
+/**
+ * Remove a value previously inserted under the given key expression. Branches left empty are freed.
+ * Returns true if the value was found.
+ */
+bool _z_keyexpr_trie_remove(_z_keyexpr_trie_t *trie, const _z_keyexpr_t *key, const void *value);
+
+/**
+ * Visit every value whose key expression may intersect the given one.
+ */
+z_result_t _z_keyexpr_trie_match(_z_keyexpr_trie_t *trie, const _z_keyexpr_t *key, _z_keyexpr_trie_match_fn_t f,
+                                 void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INCLUDE_ZENOH_PICO_SESSION_KEYEXPR_TRIE_H */
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_SESSION_PEER_ROUTING_H
+#define ZENOH_PICO_SESSION_PEER_ROUTING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/transport/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Forward declaration to avoid cyclical include
+typedef struct _z_session_t _z_session_t;
+
+#if Z_FEATURE_PEER_ROUTING == 1
+typedef struct {
+    _z_string_t _key;
+    // Peers that declared a matching entity, as of the generation of the table the entry was looked up at
+    _z_peer_route_t _route;
+    size_t _generation;
+    uint8_t _type;
+} _z_peer_route_entry_t;
+
+/**
+ * Peers that declared a subscriber or a queryable matching the key expressions recently sent to, derived from the
+ * remote declarations of a session. Key expressions hash to a slot each, and the entries are looked up again once the
+ * remote declarations change.
+ */
+typedef struct {
+    _z_peer_route_entry_t _entries[Z_PEER_ROUTE_TABLE_SIZE];
+    size_t _generation;
+    size_t _hits;
+    size_t _misses;
+} _z_peer_route_table_t;
+
+void _z_peer_route_table_init(_z_peer_route_table_t *table);
+void _z_peer_route_table_clear(_z_peer_route_table_t *table);
+// To be called with the session mutex locked, whenever a remote declaration is added or removed
+static inline void _z_peer_route_table_invalidate(_z_peer_route_table_t *table) { table->_generation++; }
+
+/**
+ * Set route to the peers that declared a subscriber matching a push, or a queryable matching a query, and to the
+ * routers. Other messages, and the ones that can't be routed, go to all the peers.
+ *
+ * Must not be called with the session mutex locked.
+ */
+void _z_peer_route_table_lookup(_z_session_t *zn, const _z_network_message_t *n_msg, _z_peer_route_t *route);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_SESSION_PEER_ROUTING_H */
@@ -24,11 +24,18 @@ extern "C" {
 #endif
 
 void _z_pending_query_process_timeout(_z_session_t *zn);
-_z_fut_fn_result_t _z_pending_query_process_timeout_task_fn(void *session_arg, _z_executor_t *executor);
 
 #if Z_FEATURE_QUERY == 1
+// Drop the queries past their deadline, returns the next deadline or UINT64_MAX when there is none
+uint64_t _z_unsafe_pending_query_expire(_z_session_t *zn);
+// Rebuild the deadline queue from the soonest deadlines of the pending queries
+void _z_unsafe_pending_query_sort_deadlines(_z_session_t *zn);
+// Spawn a timer for the deadline of the queries registered since the last call, if they need an earlier one
+void _z_pending_query_arm_timer(_z_session_t *zn);
+
 /*------------------ Query ------------------*/
-_z_pending_query_t *_z_unsafe_register_pending_query(_z_session_t *zn);
+_z_pending_query_t *_z_unsafe_register_pending_query(_z_session_t *zn, uint64_t timeout_ms);
+_z_pending_query_t *_z_unsafe_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id);
 z_result_t _z_trigger_query_reply_partial(_z_session_t *zn, _z_zint_t id, const _z_keyexpr_t *keyexpr,
                                           const _z_msg_reply_t *msg, const _z_entity_global_id_t *replier_id,
                                           _z_n_qos_t qos, _z_transport_peer_common_t *peer);
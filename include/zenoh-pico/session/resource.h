@@ -30,6 +30,7 @@ uint32_t _z_get_entity_id(_z_session_t *zn);
 
 /*------------------ Resource ------------------*/
 uint16_t _z_get_resource_id(_z_session_t *zn);
+void _z_resource_table_free(_z_resource_table_t **table);
 // Return a keyexpr view from a wireexpr. With the lifetime bound to the wireexpr itself, if it has no prefix, or to
 // that of out_buf, if it has a prefix. The out_buf must be large enough to hold the keyexpr string representation.
 z_result_t _z_get_keyexpr_view_from_wireexpr(_z_session_t *zn, _z_keyexpr_view_t *out, const _z_wireexpr_t *expr,
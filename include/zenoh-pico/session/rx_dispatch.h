@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_SESSION_RX_DISPATCH_H
+#define ZENOH_PICO_SESSION_RX_DISPATCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "zenoh-pico/collections/atomic.h"
+#include "zenoh-pico/collections/atomic_ring.h"
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/net/sample.h"
+#include "zenoh-pico/runtime/background_executor.h"
+#include "zenoh-pico/session/session.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Forward declaration to avoid cyclical include
+typedef struct _z_session_t _z_session_t;
+
+#if Z_FEATURE_RX_DISPATCH == 1
+// A sample waiting for the callback of a subscription
+typedef struct {
+    _z_sample_t _sample;
+    _z_subscription_rc_t _sub;
+} _z_rx_dispatch_slot_t;
+
+typedef struct {
+    // Slots waiting for their callbacks, and the ones free to be filled
+    _z_atomic_ring_t _queue;
+    _z_atomic_ring_t _free;
+    // As many as the queue holds, the slot whose callback runs included
+    _z_rx_dispatch_slot_t *_slots;
+    // Runs the single future pulling from the queue, on a thread of its own
+    _z_background_executor_t _executor;
+    _z_session_t *_zn;
+    _z_atomic_size_t _dispatched;
+    _z_atomic_size_t _max_depth;
+    // Samples the read task waited for a free slot to queue
+    _z_atomic_size_t _stalls;
+} _z_rx_dispatch_worker_t;
+
+/**
+ * Pool of workers running the subscriber callbacks of the samples received by a session, so that the read task only
+ * reads and decodes them. Each sample is copied in a slot of the worker of each matching subscription, picked by
+ * subscription id: the callback of a subscription, even a wildcard one, only runs on a single thread and gets its
+ * samples in order.
+ */
+typedef struct {
+    _z_rx_dispatch_worker_t *_workers;
+    size_t _num_workers;
+} _z_rx_dispatch_t;
+
+static inline void _z_rx_dispatch_null(_z_rx_dispatch_t *dispatch) {
+    dispatch->_workers = NULL;
+    dispatch->_num_workers = 0;
+}
+static inline bool _z_rx_dispatch_is_active(const _z_rx_dispatch_t *dispatch) { return dispatch->_num_workers > 0; }
+
+// Spawns the worker threads, no worker leaves the callbacks to the read task
+z_result_t _z_rx_dispatch_start(_z_rx_dispatch_t *dispatch, _z_session_t *zn, size_t num_workers);
+// Queues a copy of the sample for the subscription, parks while the worker of the subscription has no free slot
+z_result_t _z_rx_dispatch_push(_z_rx_dispatch_t *dispatch, const _z_subscription_rc_t *sub,
+                               const _z_sample_t *sample);
+// Joins the worker threads once their running callbacks return, must not be called from one of them. The samples still
+// queued are dropped at the clear.
+z_result_t _z_rx_dispatch_stop(_z_rx_dispatch_t *dispatch);
+void _z_rx_dispatch_clear(_z_rx_dispatch_t *dispatch);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_SESSION_RX_DISPATCH_H */
@@ -28,6 +28,7 @@
 #include "zenoh-pico/session/cancellation.h"
 #include "zenoh-pico/session/keyexpr.h"
 #include "zenoh-pico/transport/manager.h"
+#include "zenoh-pico/utils/hash.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -65,6 +66,45 @@ _Z_ELEM_DEFINE(_z_resource, _z_resource_t, _z_resource_size, _z_resource_clear,
                _z_resource_eq, _z_noop_cmp, _z_noop_hash)
 _Z_SLIST_DEFINE(_z_resource, _z_resource_t, true)
 
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_resource_id_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE uint16_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_resource_t
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN(id) ((size_t)*(id))
+#define _ZP_HASHMAP_TEMPLATE_VAL_DESTROY_FN _z_resource_clear
+#define _ZP_HASHMAP_TEMPLATE_INITIAL_CAPACITY 8
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#include "zenoh-pico/collections/hashmap_template.h"
+
+static inline size_t _z_resource_key_hash(const _z_keyexpr_t *key) {
+    return _z_hash_bytes((const uint8_t *)_z_string_data(&key->_keyexpr), _z_string_len(&key->_keyexpr));
+}
+
+// The resources declared with a key, of which the most recent one is found by key
+typedef struct {
+    uint16_t _id;
+    size_t _count;
+} _z_resource_key_entry_t;
+
+// Keys alias the key expression owned by one of the resources stored in the id map
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_resource_key_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE _z_keyexpr_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_resource_key_entry_t
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN _z_resource_key_hash
+#define _ZP_HASHMAP_TEMPLATE_KEY_EQ_FN(left, right) _z_keyexpr_equals(left, right)
+#define _ZP_HASHMAP_TEMPLATE_INITIAL_CAPACITY 8
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#include "zenoh-pico/collections/hashmap_template.h"
+
+/**
+ * A table of declared resources, indexed both by id and by key expression.
+ */
+struct _z_resource_table_t {
+    _z_resource_id_hmap_t _by_id;
+    _z_resource_key_hmap_t _by_key;
+};
+
 _Z_ELEM_DEFINE(_z_keyexpr, _z_keyexpr_t, _z_keyexpr_size, _z_keyexpr_clear, _z_keyexpr_copy, _z_keyexpr_move,
                _z_noop_eq, _z_noop_cmp, _z_noop_hash)
 _Z_INT_MAP_DEFINE(_z_keyexpr, _z_keyexpr_t)
@@ -81,6 +121,16 @@ typedef struct _z_sample_t _z_sample_t;
  */
 typedef void (*_z_closure_sample_callback_t)(_z_sample_t *sample, void *arg);
 
+/**
+ * The callback signature of the functions handling data messages by batches.
+ */
+typedef void (*_z_closure_sample_batch_callback_t)(_z_sample_t *samples, size_t len, void *arg);
+
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+// Samples waiting for the batch callback of a subscription, defined in subscription.c
+typedef struct _z_subscription_batch_t _z_subscription_batch_t;
+#endif
+
 typedef struct {
     _z_declared_keyexpr_t _key;
     uint32_t _id;
@@ -88,6 +138,10 @@ typedef struct {
     _z_closure_sample_callback_t _callback;
     _z_drop_handler_t _dropper;
     void *_arg;
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    // Takes over from _callback when not NULL
+    _z_subscription_batch_t *_batch;
+#endif
     _z_sync_group_notifier_t _session_callback_drop_notifier;
     _z_sync_group_notifier_t _subscriber_callback_drop_notifier;
 } _z_subscription_t;
@@ -190,8 +244,8 @@ struct _z_pending_query_t {
     _z_closure_reply_callback_t _callback;
     _z_drop_handler_t _dropper;
     z_locality_t _allowed_destination;
-    z_clock_t _start_time;
-    uint64_t _timeout;
+    // Milliseconds since the session pending query epoch
+    uint64_t _deadline_ms;
     void *_arg;
     uint32_t _remaining_finals;
     _z_pending_reply_slist_t *_pending_replies;
@@ -208,7 +262,36 @@ void _z_pending_query_clear(_z_pending_query_t *res);
 
 _Z_ELEM_DEFINE(_z_pending_query, _z_pending_query_t, _z_noop_size, _z_pending_query_clear, _z_noop_copy, _z_noop_move,
                _z_pending_query_eq, _z_noop_cmp, _z_noop_hash)
-_Z_SLIST_DEFINE(_z_pending_query, _z_pending_query_t, false)
+
+// Pending queries by id. They are allocated one by one, so that pointers to them survive the map growing.
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_pending_query_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE _z_zint_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_pending_query_t *
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN(id) ((size_t)*(id))
+#define _ZP_HASHMAP_TEMPLATE_VAL_DESTROY_FN(pq) _z_pending_query_elem_free((void **)(pq))
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#include "zenoh-pico/collections/hashmap_template.h"
+
+// Entries outlive the queries that are done before their deadline, they are skipped when they come up
+typedef struct {
+    uint64_t _deadline_ms;
+    _z_zint_t _id;
+} _z_pending_query_deadline_t;
+
+static inline int _z_pending_query_deadline_cmp(const _z_pending_query_deadline_t *a,
+                                                const _z_pending_query_deadline_t *b) {
+    if (a->_deadline_ms != b->_deadline_ms) {
+        return (a->_deadline_ms < b->_deadline_ms) ? -1 : 1;
+    }
+    return (a->_id < b->_id) ? -1 : ((a->_id > b->_id) ? 1 : 0);
+}
+
+#define _ZP_STATIC_PQUEUE_TEMPLATE_ELEM_TYPE _z_pending_query_deadline_t
+#define _ZP_STATIC_PQUEUE_TEMPLATE_NAME _z_pending_query_deadline_pqueue
+#define _ZP_STATIC_PQUEUE_TEMPLATE_ELEM_CMP_FN _z_pending_query_deadline_cmp
+#define _ZP_STATIC_PQUEUE_TEMPLATE_SIZE Z_QUERY_DEADLINE_QUEUE_SIZE
+#include "zenoh-pico/collections/static_pqueue_template.h"
 
 struct __z_hello_handler_wrapper_t;  // Forward declaration to be used in _z_closure_hello_callback_t
 /**
@@ -274,6 +357,8 @@ typedef struct {
     _z_keyexpr_t _key;
     _z_transport_peer_common_t *_peer;
     uint32_t _id;
+    // Id of the interest the declaration answers, 0 when it is meant for all of them
+    uint32_t _interest_id;
     uint8_t _type;
     bool _complete;
 } _z_declare_data_t;
@@ -285,6 +370,36 @@ _Z_ELEM_DEFINE(_z_declare_data, _z_declare_data_t, _z_declare_data_size, _z_decl
                _z_noop_move, _z_noop_eq, _z_noop_cmp, _z_noop_hash)
 _Z_SLIST_DEFINE(_z_declare_data, _z_declare_data_t, true)
 
+// Entity ids are only unique per peer and kind of declaration
+typedef struct {
+    _z_transport_peer_common_t *_peer;
+    uint32_t _id;
+    uint8_t _type;
+} _z_declare_id_t;
+
+static inline size_t _z_declare_id_hash(const _z_declare_id_t *id) {
+    return ((size_t)(uintptr_t)id->_peer >> 4) ^ (((size_t)id->_id << 2) | (size_t)id->_type);
+}
+
+static inline bool _z_declare_id_eq(const _z_declare_id_t *left, const _z_declare_id_t *right) {
+    return (left->_id == right->_id) && (left->_type == right->_type) && (left->_peer == right->_peer);
+}
+
+static inline _z_declare_id_t _z_declare_data_id(const _z_declare_data_t *data) {
+    _z_declare_id_t id = {._peer = data->_peer, ._id = data->_id, ._type = data->_type};
+    return id;
+}
+
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_declare_data_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE _z_declare_id_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_declare_data_t
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN _z_declare_id_hash
+#define _ZP_HASHMAP_TEMPLATE_KEY_EQ_FN(left, right) _z_declare_id_eq(left, right)
+#define _ZP_HASHMAP_TEMPLATE_VAL_DESTROY_FN _z_declare_data_clear
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#include "zenoh-pico/collections/hashmap_template.h"
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,6 +15,7 @@
 #ifndef INCLUDE_ZENOH_PICO_SESSION_SUBSCRIPTION_H
 #define INCLUDE_ZENOH_PICO_SESSION_SUBSCRIPTION_H
 
+#include "zenoh-pico/collections/lru_cache.h"
 #include "zenoh-pico/net/encoding.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/session/resource.h"
@@ -29,6 +30,30 @@ typedef struct _z_session_t _z_session_t;
 
 _Z_SVEC_DEFINE(_z_subscription_rc, _z_subscription_rc_t)
 
+#if Z_FEATURE_RX_CACHE == 1
+/**
+ * An entry of the RX cache, holding the subscriptions matched by a resolved key expression.
+ */
+typedef struct {
+    _z_keyexpr_t _key;
+    _z_subscriber_kind_t _kind;
+    bool _is_remote;
+    _z_subscription_rc_svec_t _infos;
+} _z_subscription_cache_data_t;
+
+typedef struct {
+    size_t _hits;
+    size_t _misses;
+} _z_subscription_cache_stats_t;
+
+int _z_subscription_cache_data_compare(const void *first, const void *second);
+void _z_subscription_cache_data_clear(_z_subscription_cache_data_t *val);
+
+_Z_ELEM_DEFINE(_z_subscription_cache, _z_subscription_cache_data_t, _z_noop_size, _z_subscription_cache_data_clear,
+               _z_noop_copy, _z_noop_move, _z_noop_eq, _z_noop_cmp, _z_noop_hash)
+_Z_LRU_CACHE_DEFINE(_z_subscription_cache, _z_subscription_cache_data_t, _z_subscription_cache_data_compare)
+#endif
+
 /*------------------ Subscription ------------------*/
 z_result_t _z_trigger_liveliness_subscriptions_declare(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
                                                        const _z_timestamp_t *timestamp,
@@ -46,8 +71,20 @@ z_result_t _z_trigger_subscriptions_impl(_z_session_t *zn, _z_subscriber_kind_t
                                          const _z_zint_t sample_kind, const _z_timestamp_t *opt_timestamp,
                                          _z_n_qos_t qos, const _z_bytes_t *opt_attachment, z_reliability_t reliability,
                                          const _z_source_info_t *opt_source_info, _z_transport_peer_common_t *peer);
+// Runs the callback of the subscription on the sample, or adds the sample to its batch
+void _z_subscription_deliver(_z_session_t *zn, _z_subscription_rc_t *sub, _z_sample_t *sample);
 void _z_unregister_subscription(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_rc_t *sub);
 void _z_flush_subscriptions(_z_session_t *zn);
+#if Z_FEATURE_RX_CACHE == 1
+_z_subscription_cache_stats_t _z_get_subscription_cache_stats(_z_session_t *zn);
+#endif
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+/**
+ * Create the batch of a subscription, whose callback gets the samples once max_samples of them are received, at the
+ * next call to _z_flush_subscription_batches, or before the trigger of a sample published by the session returns.
+ */
+_z_subscription_batch_t *_z_subscription_batch_new(_z_closure_sample_batch_callback_t callback, size_t max_samples);
+#endif
 
 static inline z_result_t _z_trigger_subscriptions_put(_z_session_t *zn, const _z_wireexpr_t *wireexpr,
                                                       const _z_bytes_t *payload, const _z_encoding_t *encoding,
@@ -111,6 +148,14 @@ static inline z_result_t _z_trigger_subscriptions_del(_z_session_t *zn, const _z
 }
 #endif  // Z_FEATURE_SUBSCRIPTION == 1
 
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+// Hand the samples of the batched subscriptions to their callback and wait for it to return, called by the read tasks
+// before the received batch the samples borrow from is released, and while idle.
+void _z_flush_subscription_batches(_z_session_t *zn);
+#else
+static inline void _z_flush_subscription_batches(_z_session_t *zn) { _ZP_UNUSED(zn); }
+#endif
+
 #ifdef __cplusplus
 }
 #endif
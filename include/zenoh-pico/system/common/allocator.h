@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_SYSTEM_COMMON_ALLOCATOR_H
+#define ZENOH_PICO_SYSTEM_COMMON_ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/collections/atomic.h"
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/utils/result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if Z_FEATURE_ALLOCATOR == 1
+// The platforms implement these, z_malloc, z_realloc and z_free call them when no allocator is set
+#define _Z_PLATFORM_MALLOC _z_platform_malloc
+#define _Z_PLATFORM_REALLOC _z_platform_realloc
+#define _Z_PLATFORM_FREE _z_platform_free
+
+void *_z_platform_malloc(size_t size);
+void *_z_platform_realloc(void *ptr, size_t size);
+void _z_platform_free(void *ptr);
+
+/**
+ * Memory functions that :c:func:`z_malloc`, :c:func:`z_realloc` and :c:func:`z_free` call instead of the platform
+ * ones, for every allocation of the library and of the application through them.
+ *
+ * Members:
+ *   allocate: Allocates ``size`` bytes, as :c:func:`z_malloc`.
+ *   reallocate: Resizes the block at ``ptr``, as :c:func:`z_realloc`.
+ *   deallocate: Frees the block at ``ptr``, as :c:func:`z_free`.
+ *   context: Passed to each of them.
+ */
+typedef struct {
+    void *(*allocate)(size_t size, void *context);
+    void *(*reallocate)(void *ptr, size_t size, void *context);
+    void (*deallocate)(void *ptr, void *context);
+    void *context;
+} zp_allocator_t;
+
+/**
+ * Sets the allocator of the process. It must be set before any allocation and not changed while memory it allocated
+ * is in use, as each block must be freed by the allocator that allocated it.
+ *
+ * Parameters:
+ *   allocator: Pointer to the :c:type:`zp_allocator_t` to use, or ``NULL`` to go back to the platform allocator.
+ *
+ * Return:
+ *   ``0`` if the allocator is set, ``negative value`` if any of its functions is missing.
+ */
+z_result_t zp_set_allocator(const zp_allocator_t *allocator);
+
+#define _Z_ALLOC_POOL_MIN_BLOCK_SIZE 16
+// Classes of 16, 32, 64... bytes, up to a quarter of a page
+#define _Z_ALLOC_POOL_MAX_CLASSES 16
+
+/**
+ * Allocation counters of a :c:type:`zp_alloc_pool_t`.
+ *
+ * Members:
+ *   allocs: Blocks handed out by the pool.
+ *   frees: Blocks given back to the pool.
+ *   fallbacks: Allocations the pool passed on to the platform, too large or past the end of the arena.
+ *   pages: Pages of the arena carved into blocks, out of ``max_pages``.
+ *   max_pages: Pages of the arena.
+ */
+typedef struct {
+    size_t allocs;
+    size_t frees;
+    size_t fallbacks;
+    size_t pages;
+    size_t max_pages;
+} zp_alloc_pool_stats_t;
+
+/**
+ * Size-class allocator over an arena provided by the application. Pages of ``Z_ALLOC_POOL_PAGE_SIZE`` bytes are carved
+ * into blocks of a single size class when first needed, and freed blocks go back to the free list of their class, so
+ * the arena never fragments. Allocations larger than the largest class, or made once the arena is used up, go to the
+ * platform allocator. With ``Z_FEATURE_MULTI_THREAD``, the free lists are lock-free.
+ */
+typedef struct {
+    uint8_t *_start;
+    // Class of each page, in front of the pages
+    uint8_t *_page_class;
+    size_t _max_pages;
+    size_t _num_classes;
+    _z_atomic_size_t _next_page;
+    // Head of each free list, the index of its first block tagged with a change count against ABA
+    _z_atomic_size_t _free[_Z_ALLOC_POOL_MAX_CLASSES];
+    _z_atomic_size_t _allocs;
+    _z_atomic_size_t _frees;
+    _z_atomic_size_t _fallbacks;
+} zp_alloc_pool_t;
+
+/**
+ * Initializes a pool over an arena. The arena must outlive every block the pool hands out.
+ *
+ * Parameters:
+ *   pool: Pointer to an uninitialized :c:type:`zp_alloc_pool_t`.
+ *   arena: The memory the pool hands out blocks of.
+ *   len: Length of the arena in bytes. Arenas too large for the block indexes are only used up to that limit.
+ *
+ * Return:
+ *   ``0`` if the pool is initialized, ``negative value`` if the arena can't hold a single page.
+ */
+z_result_t zp_alloc_pool_init(zp_alloc_pool_t *pool, void *arena, size_t len);
+
+/**
+ * Builds the allocator of a pool, to be set with :c:func:`zp_set_allocator`.
+ *
+ * Parameters:
+ *   pool: Pointer to an initialized :c:type:`zp_alloc_pool_t`.
+ *   allocator: Pointer to the :c:type:`zp_allocator_t` to fill.
+ */
+void zp_alloc_pool_allocator(zp_alloc_pool_t *pool, zp_allocator_t *allocator);
+
+void *zp_alloc_pool_malloc(zp_alloc_pool_t *pool, size_t size);
+void *zp_alloc_pool_realloc(zp_alloc_pool_t *pool, void *ptr, size_t size);
+void zp_alloc_pool_free(zp_alloc_pool_t *pool, void *ptr);
+
+/**
+ * Reads the allocation counters of a pool.
+ *
+ * Parameters:
+ *   pool: Pointer to an initialized :c:type:`zp_alloc_pool_t`.
+ *   stats: Pointer to the :c:type:`zp_alloc_pool_stats_t` to fill.
+ */
+void zp_alloc_pool_stats(zp_alloc_pool_t *pool, zp_alloc_pool_stats_t *stats);
+
+#else
+#define _Z_PLATFORM_MALLOC z_malloc
+#define _Z_PLATFORM_REALLOC z_realloc
+#define _Z_PLATFORM_FREE z_free
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_SYSTEM_COMMON_ALLOCATOR_H */
@@ -23,6 +23,7 @@
 
 #include "zenoh-pico/api/olv_macros.h"
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/system/common/allocator.h"
 #include "zenoh-pico/utils/result.h"
 
 /* Centralized built-in socket markers for TCP/UDP/WS/TLS transports that use
@@ -31,6 +32,11 @@
 #define ZP_PLATFORM_SOCKET_POSIX 1
 #endif
 
+/* Persistent epoll registration for the peer-mode read loop, on top of the posix socket layer. */
+#if !defined(ZP_PLATFORM_SOCKET_EPOLL) && defined(ZP_PLATFORM_SOCKET_POSIX) && defined(ZENOH_LINUX)
+#define ZP_PLATFORM_SOCKET_EPOLL 1
+#endif
+
 #if !defined(ZP_PLATFORM_SOCKET_WINDOWS) && defined(ZENOH_WINDOWS)
 #define ZP_PLATFORM_SOCKET_WINDOWS 1
 #endif
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_TRANSPORT_DEFRAG_H
+#define ZENOH_PICO_TRANSPORT_DEFRAG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if Z_FEATURE_FRAGMENTATION == 1
+// Size classes of the defragmentation buffers: Z_FRAG_SLAB_SIZE times a power of two, capped at Z_FRAG_MAX_SIZE
+#define _Z_DEFRAG_CLASS_MAX 24
+
+typedef struct {
+    // Messages dropped because reassembling them would exceed Z_FRAG_BUDGET
+    size_t _budget_drops;
+    // Messages dropped because of a gap in the fragment serial numbers
+    size_t _sn_gap_drops;
+} _z_defrag_stats_t;
+
+/**
+ * Defragmentation buffers of a transport, shared by all its peers. Buffers are kept for reuse once their message is
+ * decoded, the bytes held by the pool, idle or not, never exceed Z_FRAG_BUDGET.
+ */
+typedef struct {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_t _mutex;
+#endif
+    size_t _held;
+    size_t _class_num;
+    // Idle buffers of each size class, linked through their first bytes
+    uint8_t *_idle[_Z_DEFRAG_CLASS_MAX];
+    _z_defrag_stats_t _stats;
+} _z_defrag_pool_t;
+
+// A message being reassembled, its buffer is taken from the pool on the first write
+typedef struct {
+    _z_defrag_pool_t *_pool;
+    uint8_t *_buf;
+    size_t _len;
+    uint8_t _class;
+} _z_defrag_buf_t;
+
+z_result_t _z_defrag_pool_init(_z_defrag_pool_t *pool);
+void _z_defrag_pool_clear(_z_defrag_pool_t *pool);
+_z_defrag_stats_t _z_defrag_pool_get_stats(_z_defrag_pool_t *pool);
+void _z_defrag_pool_count_sn_gap(_z_defrag_pool_t *pool);
+
+static inline _z_defrag_buf_t _z_defrag_buf_null(void) { return (_z_defrag_buf_t){0}; }
+static inline size_t _z_defrag_buf_len(const _z_defrag_buf_t *dbuf) { return dbuf->_len; }
+// Keep the buffer for the next message
+static inline void _z_defrag_buf_reset(_z_defrag_buf_t *dbuf) { dbuf->_len = 0; }
+// Non-owning reader on the reassembled message
+static inline _z_zbuf_t _z_defrag_buf_as_zbuf(const _z_defrag_buf_t *dbuf) {
+    _z_slice_t s = _z_slice_alias_buf(dbuf->_buf, dbuf->_len);
+    return _z_slice_as_zbuf(&s);
+}
+// Append bytes, moving to a larger buffer of the pool when needed. Fails with _Z_ERR_TRANSPORT_NO_SPACE and counts a
+// budget drop if the pool can't provide it.
+z_result_t _z_defrag_buf_write(_z_defrag_buf_t *dbuf, _z_defrag_pool_t *pool, const uint8_t *bs, size_t len);
+// Give the buffer back to its pool
+void _z_defrag_buf_clear(_z_defrag_buf_t *dbuf);
+z_result_t _z_defrag_buf_copy(_z_defrag_buf_t *dst, const _z_defrag_buf_t *src);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_TRANSPORT_DEFRAG_H */
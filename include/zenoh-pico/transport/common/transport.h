@@ -21,6 +21,11 @@
 extern "C" {
 #endif
 
+#if Z_FEATURE_MULTI_THREAD == 1
+// Initialize the mutexes of a transport, and the condition variables of its tx priority queues
+z_result_t _z_transport_common_mutex_init(_z_transport_common_t *ztc);
+void _z_transport_common_mutex_drop(_z_transport_common_t *ztc);
+#endif
 void _z_transport_common_clear(_z_transport_common_t *ztc);
 
 #ifdef __cplusplus
@@ -17,6 +17,7 @@
 
 #include "zenoh-pico/link/link.h"
 #include "zenoh-pico/net/session.h"
+#include "zenoh-pico/runtime/runtime.h"
 #include "zenoh-pico/transport/transport.h"
 
 #ifdef __cplusplus
@@ -39,6 +40,10 @@ z_result_t _z_link_send_t_msg(const _z_link_t *zl, const _z_transport_message_t
 z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg, z_reliability_t reliability,
                          z_congestion_control_t cong_ctrl, void *peer);
 z_result_t _z_send_n_batch(_z_session_t *zn, z_congestion_control_t cong_ctrl);
+#if Z_FEATURE_AUTO_BATCHING == 1
+// Sends the pending batch of the transport every period of its automatic batching, the argument is the transport
+_z_fut_fn_result_t _zp_auto_batching_task_fn(void *ztc_arg, _z_executor_t *executor);
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_MULTICAST_REPAIR_H
+#define ZENOH_PICO_MULTICAST_REPAIR_H
+
+#include "zenoh-pico/link/link.h"
+#include "zenoh-pico/protocol/definitions/transport.h"
+#include "zenoh-pico/runtime/runtime.h"
+#include "zenoh-pico/transport/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+z_result_t _z_multicast_repair_init(_z_multicast_repair_t *repair, _z_zint_t next_sn);
+void _z_multicast_repair_clear(_z_multicast_repair_t *repair);
+
+/**
+ * Keep a datagram about to be sent if it carries a reliable frame or fragment. The datagrams of the other transports
+ * are ignored.
+ *
+ * These functions are unsafe because they operate in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling them:
+ *  - ztc->_mutex_tx
+ */
+void _z_multicast_repair_store_wbuf(_z_transport_common_t *ztc, const _z_wbuf_t *wbf);
+void _z_multicast_repair_store_msgs(_z_transport_common_t *ztc, const _z_socket_msg_t *msgs, size_t count);
+
+/**
+ * Check the SN of a reliable message received from a peer that retransmits them. A message following a gap is dropped
+ * to be received again with the missing ones, duplicates are ignored. Returns whether the message is delivered.
+ *
+ * These functions are unsafe because they operate in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling them:
+ *  - ztm->_common._mutex_peer
+ */
+bool _z_multicast_repair_accept(_z_transport_peer_multicast_t *entry, _z_zint_t sn);
+// Update the SNs of a known peer from its JOIN, which also reveals the reliable messages lost last
+void _z_multicast_repair_handle_join(_z_transport_peer_multicast_t *entry, const _z_t_msg_join_t *msg);
+z_result_t _z_multicast_repair_handle_oam(_z_transport_multicast_t *ztm, const _z_t_msg_oam_t *msg,
+                                          _z_transport_peer_multicast_t *entry);
+
+_z_fut_fn_result_t _zp_multicast_repair_task_fn(void *ztm_arg, _z_executor_t *executor);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_MULTICAST_REPAIR_H */
@@ -18,6 +18,7 @@
 #include <assert.h>
 #include <stdint.h>
 
+#include "zenoh-pico/collections/atomic.h"
 #include "zenoh-pico/collections/element.h"
 #include "zenoh-pico/collections/refcount.h"
 #include "zenoh-pico/collections/slice.h"
@@ -27,6 +28,7 @@
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/transport.h"
 #include "zenoh-pico/runtime/runtime.h"
+#include "zenoh-pico/transport/common/defrag.h"
 #include "zenoh-pico/session/weak_session.h"
 
 #ifdef __cplusplus
@@ -44,14 +46,125 @@ enum _z_batching_state_e {
     _Z_BATCHING_ACTIVE = 1,
 };
 
+#if Z_FEATURE_AUTO_BATCHING == 1
+/**
+ * Automatic batching of the network messages sent on a transport. Messages wait in the batch until it reaches the
+ * length bound, or until the executor task sends it, every delay.
+ */
+typedef struct {
+    // Longest a message waits in a batch, no automatic batching when 0
+    uint32_t _max_delay_us;
+    // Batch length that gets it sent, only full batches are when 0
+    size_t _max_bytes;
+    // Set while the link takes longer than the delay to take a batch, batches are then filled up
+    bool _backpressured;
+} _z_auto_batching_t;
+
+static inline _z_auto_batching_t _z_auto_batching_null(void) { return (_z_auto_batching_t){0}; }
+static inline bool _z_auto_batching_is_active(const _z_auto_batching_t *ab) { return ab->_max_delay_us > 0; }
+// Period of the executor task, the delay rounded up to the millisecond
+static inline unsigned long _z_auto_batching_period_ms(const _z_auto_batching_t *ab) {
+    return ((unsigned long)ab->_max_delay_us + 999) / 1000;
+}
+#endif
+
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+// A reliable datagram sent on a multicast transport, stored at _offset in the repair buffer
+typedef struct {
+    _z_zint_t _sn;
+    size_t _offset;
+    size_t _len;
+    // Last retransmission, the datagram is not sent again for the other receivers asking for it within the NACK delay
+    z_clock_t _resent_at;
+    bool _resent;
+} _z_multicast_repair_record_t;
+
+typedef struct {
+    // NACKs received for the reliable messages of the transport
+    size_t _nacks;
+    // Datagrams sent again
+    size_t _retransmitted;
+    // Reliable messages asked for that were no longer held
+    size_t _unrecoverable;
+} _z_multicast_repair_stats_t;
+
+/**
+ * Reliable datagrams sent on a multicast transport, kept in a bounded ring to be retransmitted when a receiver reports
+ * them lost. The oldest ones are dropped to make room for the new ones.
+ */
+typedef struct {
+    // Z_MULTICAST_REPAIR_BUF_SIZE bytes, NULL when the transport does not retransmit
+    uint8_t *_buf;
+    size_t _wpos;
+    // Ring of the stored datagrams, oldest first
+    _z_multicast_repair_record_t *_records;
+    size_t _first;
+    size_t _len;
+    // SN following the last reliable datagram sent
+    _z_zint_t _next_sn;
+    _z_multicast_repair_stats_t _stats;
+} _z_multicast_repair_t;
+
+typedef struct {
+    // Gaps found in the reliable messages of the peer
+    size_t _gaps;
+    // Reliable messages received after being reported lost
+    size_t _repaired;
+    // Reliable messages skipped as they could not be repaired
+    size_t _lost;
+    size_t _nacks_sent;
+    // NACKs put off as another receiver, or the peer, already dealt with the gap
+    size_t _nacks_suppressed;
+    // Reliable messages dropped because they followed a gap, they are retransmitted with it
+    size_t _out_of_order;
+} _z_multicast_peer_repair_stats_t;
+
+// Repair of the reliable messages received from a multicast peer
+typedef struct {
+    // The peer retransmits, as advertised by its JOIN, its reliable messages are only delivered in order
+    bool _active;
+    // Set while the reliable messages following the last one received, up to _gap_last, are missing
+    bool _gap;
+    uint8_t _attempts;
+    _z_zint_t _gap_last;
+    // When the next NACK is due
+    z_clock_t _nack_at;
+    _z_multicast_peer_repair_stats_t _stats;
+} _z_multicast_peer_repair_t;
+
+static inline _z_multicast_repair_t _z_multicast_repair_null(void) { return (_z_multicast_repair_t){0}; }
+static inline bool _z_multicast_repair_is_active(const _z_multicast_repair_t *repair) { return repair->_buf != NULL; }
+static inline _z_multicast_peer_repair_t _z_multicast_peer_repair_null(void) {
+    return (_z_multicast_peer_repair_t){0};
+}
+#endif
+
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+// One queue per z_priority_t value, _Z_PRIORITY_CONTROL included
+#define _Z_TX_QUEUE_NUM 8
+
+typedef struct {
+    // Encoded network messages, the frame header is written when the queue is drained
+    _z_wbuf_t _wbuf;
+    z_reliability_t _reliability;
+    size_t _count;
+    // Queued responses, a response final is only queued once they are sent
+    size_t _responses;
+    // An express message is queued, the queue and the more urgent ones are sent without waiting for the batch
+    bool _express;
+    // Frames the queue may still send in the current round of the scheduler
+    uint8_t _credits;
+} _z_transport_tx_queue_t;
+#endif
+
 // Forward declaration to avoid cyclical include
-typedef _z_slist_t _z_resource_slist_t;
+typedef struct _z_resource_table_t _z_resource_table_t;
 
 typedef struct {
     _z_id_t _remote_zid;
     z_whatami_t _remote_whatami;
     volatile bool _received;
-    _z_resource_slist_t *_remote_resources;
+    _z_resource_table_t *_remote_resources;
 #if Z_FEATURE_CONNECTIVITY == 1
     _z_string_t _link_src;
     _z_string_t _link_dst;
@@ -60,13 +173,55 @@ typedef struct {
     // Defragmentation buffers
     uint8_t _state_reliable;
     uint8_t _state_best_effort;
-    _z_wbuf_t _dbuf_reliable;
-    _z_wbuf_t _dbuf_best_effort;
+    _z_defrag_buf_t _dbuf_reliable;
+    _z_defrag_buf_t _dbuf_best_effort;
     // Patch
     uint8_t _patch;
 #endif
 } _z_transport_peer_common_t;
 
+#if Z_FEATURE_PEER_ROUTING == 1
+/**
+ * Peers of a unicast transport that a message is sent to. Peers are listed by address, sorted, and the ones that left
+ * the transport are simply not found when sending.
+ */
+typedef struct {
+    const _z_transport_peer_common_t **_peers;
+    size_t _len;
+    size_t _capacity;
+    // Only the listed peers get the message when set, all of them otherwise
+    bool _selective;
+    // The routers also get it, as they forward it to the subscribers and queryables behind them
+    bool _routers;
+} _z_peer_route_t;
+
+typedef struct {
+    // Messages sent to the peers with a matching declaration only
+    size_t _routed;
+    // Routed messages no peer declared a match for, which were not sent
+    size_t _unmatched;
+    // Batches and fragments written to a peer socket
+    size_t _peer_sends;
+    // Batches and fragments not written to a peer left out of their route
+    size_t _peer_skips;
+} _z_peer_route_stats_t;
+
+static inline _z_peer_route_t _z_peer_route_null(void) { return (_z_peer_route_t){0}; }
+static inline void _z_peer_route_reset(_z_peer_route_t *route, bool selective, bool routers) {
+    route->_len = 0;
+    route->_selective = selective;
+    route->_routers = routers;
+}
+void _z_peer_route_clear(_z_peer_route_t *route);
+z_result_t _z_peer_route_add(_z_peer_route_t *route, const _z_transport_peer_common_t *peer);
+// Reuses the storage of dst
+z_result_t _z_peer_route_copy(_z_peer_route_t *dst, const _z_peer_route_t *src);
+// Widen dst to the peers of src as well, unless one of them addresses its peers only. Returns whether it did.
+bool _z_peer_route_merge(_z_peer_route_t *dst, const _z_peer_route_t *src);
+bool _z_peer_route_eq(const _z_peer_route_t *left, const _z_peer_route_t *right);
+bool _z_peer_route_includes(const _z_peer_route_t *route, const _z_transport_peer_common_t *peer);
+#endif
+
 #if Z_FEATURE_CONNECTIVITY == 1
 typedef struct {
     _z_id_t _remote_zid;
@@ -95,6 +250,9 @@ typedef struct {
     // SN numbers
     _z_zint_t _sn_res;
     volatile _z_zint_t _lease;
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    _z_multicast_peer_repair_t _repair;
+#endif
 } _z_transport_peer_multicast_t;
 
 size_t _z_transport_peer_multicast_size(const _z_transport_peer_multicast_t *src);
@@ -154,9 +312,11 @@ typedef enum _z_transport_state_t {
 #define _Z_TRANSPORT_TASK_KEEP_ALIVE 0
 #define _Z_TRANSPORT_TASK_LEASE 1
 #define _Z_TRANSPORT_TASK_READ 2
-#define _Z_TRANSPORT_TASK_SEND_JOIN 3  // multicast / raweth only
-#define _Z_TRANSPORT_TASK_ADD_PEERS 4  // unicast only
-#define _Z_TRANSPORT_TASK_COUNT 5
+#define _Z_TRANSPORT_TASK_SEND_JOIN 3      // multicast / raweth only
+#define _Z_TRANSPORT_TASK_ADD_PEERS 4      // unicast only
+#define _Z_TRANSPORT_TASK_AUTO_BATCHING 5  // unicast / multicast only
+#define _Z_TRANSPORT_TASK_REPAIR 6         // multicast only
+#define _Z_TRANSPORT_TASK_COUNT 7
 #if Z_FEATURE_AUTO_RECONNECT == 1
 typedef struct _z_transport_tasks_t {
     _z_fut_handle_t _task_handles[_Z_TRANSPORT_TASK_COUNT];
@@ -169,6 +329,13 @@ typedef struct {
     // TX and RX buffers
     _z_wbuf_t _wbuf;
     _z_zbuf_t _zbuf;
+#if Z_FEATURE_FRAGMENTATION == 1
+    // Defragmentation buffers of all the peers
+    _z_defrag_pool_t _defrag_pool;
+    // Encoded message and fragment headers of the message being fragmented, kept between messages
+    _z_wbuf_t _frag_buff;
+    _z_wbuf_t _frag_hdr_buff;
+#endif
     // SN numbers
     _z_zint_t _sn_res;
     _z_zint_t _sn_tx_reliable;
@@ -183,6 +350,26 @@ typedef struct {
 #if Z_FEATURE_BATCHING == 1
     uint8_t _batch_state;
     size_t _batch_count;
+#endif
+#if Z_FEATURE_AUTO_BATCHING == 1
+    _z_auto_batching_t _auto_batching;
+#endif
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+    _z_transport_tx_queue_t _tx_queues[_Z_TX_QUEUE_NUM];
+#if Z_FEATURE_MULTI_THREAD == 1
+    // Protects _tx_queues and _batch_count. Senders queue messages under it alone, the holder of _mutex_tx sends them.
+    _z_mutex_t _mutex_tx_queues;
+#endif
+#endif
+#if Z_FEATURE_PEER_ROUTING == 1
+    // Peers the pending batch goes to, and the ones of the message being sent. Only used in peer mode.
+    _z_peer_route_t _tx_route;
+    _z_peer_route_t _tx_next_route;
+    _z_peer_route_stats_t _route_stats;
+#endif
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    // Reliable datagrams kept for retransmission, multicast only
+    _z_multicast_repair_t _repair;
 #endif
     // Here we assume the value is set only by the session _z_open
     // and after it only read by the transport tasks, so we don't need to make it atomic or protect it with mutexes.
@@ -229,6 +416,12 @@ typedef struct {
     // Known valid peers
     _z_transport_peer_unicast_slist_t *_peers;
     _z_pending_peers_t _pending_peers;
+#if Z_FEATURE_UNICAST_PEER == 1 && defined(_Z_SOCKET_WAIT_SET_ENABLED)
+    // Peer sockets, registered as long as the peer is in the list
+    _z_socket_wait_set_t _wait_set;
+    // Peers left with data to read by the last read round
+    bool _peers_pending;
+#endif
 } _z_transport_unicast_t;
 
 #define _Z_MULTICAST_ADDR_BUFF_SIZE 32  // Arbitrary size that must be able to contain any link address.
@@ -288,6 +481,9 @@ z_result_t _z_transport_peer_unicast_add(_z_transport_unicast_t *ztu, _z_transpo
                                          _z_transport_peer_unicast_t **output_peer);
 _z_transport_common_t *_z_transport_get_common(_z_transport_t *zt);
 size_t _z_transport_get_peers_count(_z_transport_t *zt);
+#if Z_FEATURE_FRAGMENTATION == 1
+_z_defrag_stats_t _z_transport_get_defrag_stats(_z_transport_t *zt);
+#endif
 z_result_t _z_transport_close(_z_transport_t *zt, uint8_t reason);
 void _z_transport_clear(_z_transport_t *zt);
 void _z_transport_free(_z_transport_t **zt);
@@ -323,6 +519,9 @@ static inline bool _z_transport_batch_hold_peer_mutex(void) {
 #if Z_FEATURE_BATCHING == 1
 z_result_t _z_transport_start_batching(_z_transport_t *zt);
 z_result_t _z_transport_stop_batching(_z_transport_t *zt);
+#if Z_FEATURE_AUTO_BATCHING == 1
+z_result_t _z_auto_batching_from_config(_z_auto_batching_t *ab, const _z_config_t *config);
+#endif
 
 #endif  // Z_FEATURE_BATCHING == 1
 
@@ -339,6 +538,9 @@ static inline void _z_transport_tx_mutex_unlock(_z_transport_common_t *ztc) { _z
 static inline void _z_transport_peer_mutex_lock(_z_transport_common_t *ztc) {
     (void)_z_mutex_rec_lock(&ztc->_mutex_peer);
 }
+static inline z_result_t _z_transport_peer_mutex_try_lock(_z_transport_common_t *ztc) {
+    return _z_mutex_rec_try_lock(&ztc->_mutex_peer);
+}
 static inline void _z_transport_peer_mutex_unlock(_z_transport_common_t *ztc) {
     (void)_z_mutex_rec_unlock(&ztc->_mutex_peer);
 }
@@ -350,6 +552,10 @@ static inline z_result_t _z_transport_tx_mutex_lock(_z_transport_common_t *ztc,
 }
 static inline void _z_transport_tx_mutex_unlock(_z_transport_common_t *ztc) { _ZP_UNUSED(ztc); }
 static inline void _z_transport_peer_mutex_lock(_z_transport_common_t *ztc) { _ZP_UNUSED(ztc); }
+static inline z_result_t _z_transport_peer_mutex_try_lock(_z_transport_common_t *ztc) {
+    _ZP_UNUSED(ztc);
+    return _Z_RES_OK;
+}
 static inline void _z_transport_peer_mutex_unlock(_z_transport_common_t *ztc) { _ZP_UNUSED(ztc); }
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
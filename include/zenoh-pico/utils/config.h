@@ -78,7 +78,7 @@ z_result_t _z_config_get_all(const _z_config_t *ps, _z_string_svec_t *locators,
  *   default_val: The default value to use if the property is not present.
  *   out: A pointer to store the parsed result.
  */
-z_result_t _z_config_get_i32_default(_z_config_t *config, uint8_t key, const char *default_val, int32_t *out);
+z_result_t _z_config_get_i32_default(const _z_config_t *config, uint8_t key, const char *default_val, int32_t *out);
 
 /**
  * Retrieve a boolean property from the configuration.
@@ -15,6 +15,7 @@
 #ifndef ZENOH_PICO_UTILS_HASH_H
 #define ZENOH_PICO_UTILS_HASH_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -38,6 +39,16 @@ static inline size_t _z_hash_combine(size_t h1, size_t h2) {
     return h1;
 }
 
+// FNV1a hash of a byte buffer
+static inline size_t _z_hash_bytes(const uint8_t *data, size_t len) {
+    size_t hash = (size_t)_Z_FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= _Z_FNV_PRIME;
+    }
+    return hash;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -87,6 +87,131 @@ _Z_OWNED_FUNCTIONS_VALUE_NO_COPY_NO_MOVE_IMPL_PREFIX(ze, _ze_sample_miss_listene
                                                      _ze_sample_miss_listener_check, _ze_sample_miss_listener_null,
                                                      _ze_sample_miss_listener_drop)
 
+/*-------- Reorder window --------*/
+void _ze_advanced_subscriber_reorder_window_init(_ze_advanced_subscriber_reorder_window_t *w) {
+    w->_window = _ze_advanced_subscriber_reorder_deque_new();
+    w->_first_sn = 0;
+    w->_window_len = 0;
+    _z_uint32__z_sample_sortedmap_init(&w->_overflow);
+}
+
+void _ze_advanced_subscriber_reorder_window_clear(_ze_advanced_subscriber_reorder_window_t *w) {
+    _ze_advanced_subscriber_reorder_deque_destroy(&w->_window);
+    w->_window_len = 0;
+    _z_uint32__z_sample_sortedmap_clear(&w->_overflow);
+}
+
+static z_result_t _ze_advanced_subscriber_reorder_window_overflow(_ze_advanced_subscriber_reorder_window_t *w,
+                                                                  uint32_t sn, _z_sample_t *sample) {
+    uint32_t *key = z_malloc(sizeof(uint32_t));
+    if (key == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    *key = sn;
+    if (_z_uint32__z_sample_sortedmap_insert(&w->_overflow, key, sample) == NULL) {
+        z_free(key);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
+}
+
+static void _ze_advanced_subscriber_reorder_window_place(_ze_advanced_subscriber_reorder_window_t *w, size_t index,
+                                                         _z_sample_t *sample) {
+    _z_sample_t *missing = NULL;
+    while (_ze_advanced_subscriber_reorder_deque_size(&w->_window) <= index) {
+        _ze_advanced_subscriber_reorder_deque_push_back(&w->_window, &missing);
+    }
+    _z_sample_t **slot = _ze_advanced_subscriber_reorder_deque_get(&w->_window, index);
+    if (*slot == NULL) {
+        w->_window_len++;
+    } else {
+        _z_sample_elem_free((void **)slot);
+    }
+    *slot = sample;
+}
+
+// Move the samples the window got to out of the overflow map
+static void _ze_advanced_subscriber_reorder_window_refill(_ze_advanced_subscriber_reorder_window_t *w) {
+    uint32_t *sn = _z_uint32__z_sample_sortedmap_first_key(&w->_overflow);
+    while (sn != NULL) {
+        if (w->_window_len == 0) {
+            w->_first_sn = *sn;
+        } else if (_z_seqnumber_diff(*sn, w->_first_sn) >= Z_ADVANCED_SUBSCRIBER_REORDER_WINDOW_SIZE) {
+            break;
+        }
+        _z_uint32__z_sample_sortedmap_entry_t *entry = _z_uint32__z_sample_sortedmap_pop_first(&w->_overflow);
+        _ze_advanced_subscriber_reorder_window_place(w, (size_t)_z_seqnumber_diff(*sn, w->_first_sn),
+                                                     _z_uint32__z_sample_sortedmap_entry_val(entry));
+        entry->_val = NULL;
+        _z_uint32__z_sample_sortedmap_entry_free(&entry);
+        sn = _z_uint32__z_sample_sortedmap_first_key(&w->_overflow);
+    }
+}
+
+z_result_t _ze_advanced_subscriber_reorder_window_insert(_ze_advanced_subscriber_reorder_window_t *w, uint32_t sn,
+                                                         _z_sample_t *sample) {
+    int64_t index = _z_seqnumber_diff(sn, w->_first_sn);
+    if (w->_window_len != 0 && index >= Z_ADVANCED_SUBSCRIBER_REORDER_WINDOW_SIZE) {
+        return _ze_advanced_subscriber_reorder_window_overflow(w, sn, sample);
+    }
+    if (w->_window_len != 0 && index < 0) {
+        // Make room at the front by moving the last samples to the overflow map, they stay ahead of the window
+        size_t shift = (size_t)(-index);
+        while (w->_window_len != 0 && _ze_advanced_subscriber_reorder_deque_size(&w->_window) + shift >
+                                          Z_ADVANCED_SUBSCRIBER_REORDER_WINDOW_SIZE) {
+            _z_sample_t *last = NULL;
+            _ze_advanced_subscriber_reorder_deque_pop_back(&w->_window, &last);
+            w->_window_len--;
+            uint32_t last_sn = w->_first_sn + (uint32_t)_ze_advanced_subscriber_reorder_deque_size(&w->_window);
+            if (_ze_advanced_subscriber_reorder_window_overflow(w, last_sn, last) != _Z_RES_OK) {
+                _Z_ERROR("Dropping sample %u waiting for reordering", (unsigned)last_sn);
+                _z_sample_elem_free((void **)&last);
+            }
+            _z_sample_t **back = _ze_advanced_subscriber_reorder_deque_back(&w->_window);
+            while (back != NULL && *back == NULL) {
+                _ze_advanced_subscriber_reorder_deque_pop_back(&w->_window, NULL);
+                back = _ze_advanced_subscriber_reorder_deque_back(&w->_window);
+            }
+        }
+        if (w->_window_len != 0) {
+            _z_sample_t *missing = NULL;
+            for (size_t i = 1; i < shift; i++) {
+                _ze_advanced_subscriber_reorder_deque_push_front(&w->_window, &missing);
+            }
+            _ze_advanced_subscriber_reorder_deque_push_front(&w->_window, &sample);
+            w->_first_sn = sn;
+            w->_window_len++;
+            return _Z_RES_OK;
+        }
+    }
+    if (w->_window_len == 0) {
+        // The overflow map only holds samples ahead of the window, they are at least a window away
+        w->_first_sn = sn;
+        index = 0;
+    }
+    _ze_advanced_subscriber_reorder_window_place(w, (size_t)index, sample);
+    return _Z_RES_OK;
+}
+
+_z_sample_t *_ze_advanced_subscriber_reorder_window_pop_first(_ze_advanced_subscriber_reorder_window_t *w,
+                                                              uint32_t *sn) {
+    _z_sample_t *sample = NULL;
+    if (!_ze_advanced_subscriber_reorder_deque_pop_front(&w->_window, &sample)) {
+        return NULL;
+    }
+    *sn = w->_first_sn;
+    w->_window_len--;
+    w->_first_sn = _z_seqnumber_next(w->_first_sn);
+    _z_sample_t **front = _ze_advanced_subscriber_reorder_deque_front(&w->_window);
+    while (front != NULL && *front == NULL) {
+        _ze_advanced_subscriber_reorder_deque_pop_front(&w->_window, NULL);
+        w->_first_sn = _z_seqnumber_next(w->_first_sn);
+        front = _ze_advanced_subscriber_reorder_deque_front(&w->_window);
+    }
+    _ze_advanced_subscriber_reorder_window_refill(w);
+    return sample;
+}
+
 static z_result_t _ze_advanced_subscriber_sequenced_state_init(_ze_advanced_subscriber_sequenced_state_t *state,
                                                                const _z_session_weak_t *zn,
                                                                const z_loaned_keyexpr_t *keyexpr,
@@ -97,7 +222,7 @@ static z_result_t _ze_advanced_subscriber_sequenced_state_init(_ze_advanced_subs
     state->_last_delivered = 0;
     state->_pending_queries = 0;
     state->_periodic_query_handle = _z_fut_handle_null();
-    _z_uint32__z_sample_sortedmap_init(&state->_pending_samples);
+    _ze_advanced_subscriber_reorder_window_init(&state->_pending_samples);
 
     z_id_t zid = z_entity_global_id_zid(id);
     z_owned_string_t zid_str;
@@ -144,7 +269,7 @@ void _ze_advanced_subscriber_sequenced_state_clear(_ze_advanced_subscriber_seque
     }
     _z_session_weak_drop(&state->_zn);
     state->_zn = _z_session_weak_null();
-    _z_uint32__z_sample_sortedmap_clear(&state->_pending_samples);
+    _ze_advanced_subscriber_reorder_window_clear(&state->_pending_samples);
     z_keyexpr_drop(z_keyexpr_move(&state->_query_keyexpr));
 }
 
@@ -431,15 +556,22 @@ static inline void __unsafe_ze_advanced_subscriber_deliver_and_flush(_z_sample_t
     state->_has_last_delivered = true;
 
     uint32_t next_sn = _z_seqnumber_next(source_sn);
-    _z_sample_t *next_sample = _z_uint32__z_sample_sortedmap_get(&state->_pending_samples, &next_sn);
-    while (next_sample != NULL) {
-        if (callback != NULL) {
-            callback(next_sample, ctx);
+    uint32_t first_sn;
+    while (_ze_advanced_subscriber_reorder_window_first(&state->_pending_samples, &first_sn)) {
+        int64_t diff = _z_seqnumber_diff(first_sn, next_sn);
+        if (diff > 0) {
+            break;
         }
-        _z_uint32__z_sample_sortedmap_remove(&state->_pending_samples, &next_sn);
-        state->_last_delivered = next_sn;
-        next_sn = _z_seqnumber_next(next_sn);
-        next_sample = _z_uint32__z_sample_sortedmap_get(&state->_pending_samples, &next_sn);
+        _z_sample_t *next_sample =
+            _ze_advanced_subscriber_reorder_window_pop_first(&state->_pending_samples, &first_sn);
+        if (diff == 0) {
+            if (callback != NULL) {
+                callback(next_sample, ctx);
+            }
+            state->_last_delivered = next_sn;
+            next_sn = _z_seqnumber_next(next_sn);
+        }  // else older or duplicate sample
+        _z_sample_elem_free((void **)&next_sample);
     }
 }
 
@@ -448,37 +580,36 @@ static inline void __unsafe_ze_advanced_subscriber_deliver_and_flush(_z_sample_t
 static inline void __unsafe_ze_advanced_subscriber_flush_sequenced_source(
     _ze_advanced_subscriber_sequenced_state_t *state, _z_closure_sample_callback_t callback, void *ctx,
     const _z_entity_global_id_t *source_id, _ze_closure_miss_intmap_t *miss_handlers) {
-    if (state->_pending_queries != 0 || _z_uint32__z_sample_sortedmap_is_empty(&state->_pending_samples)) {
+    if (state->_pending_queries != 0 || _ze_advanced_subscriber_reorder_window_len(&state->_pending_samples) == 0) {
         return;  // Pending queries or no samples to deliver
     }
 
-    _z_uint32__z_sample_sortedmap_iterator_t it = _z_uint32__z_sample_sortedmap_iterator_make(&state->_pending_samples);
-    while (_z_uint32__z_sample_sortedmap_iterator_next(&it)) {
-        const uint32_t *source_sn = _z_uint32__z_sample_sortedmap_iterator_key(&it);
-        _z_sample_t *sample = _z_uint32__z_sample_sortedmap_iterator_value(&it);
-
+    uint32_t source_sn;
+    _z_sample_t *sample = _ze_advanced_subscriber_reorder_window_pop_first(&state->_pending_samples, &source_sn);
+    while (sample != NULL) {
         if (!state->_has_last_delivered) {
-            state->_last_delivered = *source_sn;
+            state->_last_delivered = source_sn;
             state->_has_last_delivered = true;
             if (callback != NULL) {
                 callback(sample, ctx);
             }
         } else {
             uint32_t next_sn = _z_seqnumber_next(state->_last_delivered);
-            int64_t diff = _z_seqnumber_diff(*source_sn, next_sn);
+            int64_t diff = _z_seqnumber_diff(source_sn, next_sn);
             if (diff >= 0) {
                 if (diff > 0) {
                     __unsafe_ze_advanced_subscriber_trigger_miss_handler_callbacks(miss_handlers, source_id,
                                                                                    (uint32_t)diff);
                 }
-                state->_last_delivered = *source_sn;
+                state->_last_delivered = source_sn;
                 if (callback != NULL) {
                     callback(sample, ctx);
                 }
             }  // else older or duplicate sample
         }
+        _z_sample_elem_free((void **)&sample);
+        sample = _ze_advanced_subscriber_reorder_window_pop_first(&state->_pending_samples, &source_sn);
     }
-    _z_uint32__z_sample_sortedmap_clear(&state->_pending_samples);
 }
 
 // SAFETY: Must be called with _ze_advanced_subscriber_state_t mutex locked
@@ -561,41 +692,31 @@ static z_result_t __unsafe_ze_advanced_subscriber_handle_sample(_ze_advanced_sub
                     states->_callback(sample, states->_ctx);
                 }
             } else {
-                uint32_t *new_source_sn = z_malloc(sizeof(uint32_t));
-                if (new_source_sn == NULL) {
-                    _Z_ERROR("Failed to allocate memory for new source_sn");
-                    _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                }
-                *new_source_sn = source_sn;
-
                 _z_sample_t *new_sample = z_malloc(sizeof(_z_sample_t));
                 if (new_sample == NULL) {
                     _Z_ERROR("Failed to allocate memory for new sample");
-                    z_free(new_source_sn);
                     _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
                 }
-                _Z_CLEAN_RETURN_IF_ERR(_z_sample_copy(new_sample, sample), z_free(new_source_sn); z_free(new_sample));
+                _Z_CLEAN_RETURN_IF_ERR(_z_sample_copy(new_sample, sample), z_free(new_sample));
 
-                _z_sample_t *entry =
-                    _z_uint32__z_sample_sortedmap_insert(&state->_pending_samples, new_source_sn, new_sample);
-                if (entry == NULL) {
+                z_result_t ret =
+                    _ze_advanced_subscriber_reorder_window_insert(&state->_pending_samples, source_sn, new_sample);
+                if (ret != _Z_RES_OK) {
                     _Z_ERROR("Failed to insert sample into sequenced state");
-                    z_free(new_source_sn);
-                    z_free(new_sample);
-                    _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+                    _z_sample_elem_free((void **)&new_sample);
+                    return ret;
                 }
 
                 // _history_depth = 0 = wait for all global queries to complete
                 if (states->_history_depth > 0 &&
-                    _z_uint32__z_sample_sortedmap_len(&state->_pending_samples) >= states->_history_depth) {
-                    _z_uint32__z_sample_sortedmap_entry_t *first_entry =
-                        _z_uint32__z_sample_sortedmap_pop_first(&state->_pending_samples);
-                    if (first_entry != NULL) {
-                        uint32_t *first_source_sn = _z_uint32__z_sample_sortedmap_entry_key(first_entry);
-                        _z_sample_t *first_sample = _z_uint32__z_sample_sortedmap_entry_val(first_entry);
-                        __unsafe_ze_advanced_subscriber_deliver_and_flush(first_sample, *first_source_sn,
+                    _ze_advanced_subscriber_reorder_window_len(&state->_pending_samples) >= states->_history_depth) {
+                    uint32_t first_source_sn;
+                    _z_sample_t *first_sample =
+                        _ze_advanced_subscriber_reorder_window_pop_first(&state->_pending_samples, &first_source_sn);
+                    if (first_sample != NULL) {
+                        __unsafe_ze_advanced_subscriber_deliver_and_flush(first_sample, first_source_sn,
                                                                           states->_callback, states->_ctx, state);
-                        _z_uint32__z_sample_sortedmap_entry_free(&first_entry);
+                        _z_sample_elem_free((void **)&first_sample);
                     }
                 }
             }
@@ -606,29 +727,19 @@ static z_result_t __unsafe_ze_advanced_subscriber_handle_sample(_ze_advanced_sub
                                                                   state);
             } else if (_z_seqnumber_diff(source_sn, next_sn) > 0) {
                 if (states->_retransmission) {
-                    uint32_t *new_source_sn = z_malloc(sizeof(uint32_t));
-                    if (new_source_sn == NULL) {
-                        _Z_ERROR("Failed to allocate memory for new source_sn");
-                        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                    }
-                    *new_source_sn = source_sn;
-
                     _z_sample_t *new_sample = z_malloc(sizeof(_z_sample_t));
                     if (new_sample == NULL) {
                         _Z_ERROR("Failed to allocate memory for new sample");
-                        z_free(new_source_sn);
                         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
                     }
-                    _Z_CLEAN_RETURN_IF_ERR(_z_sample_copy(new_sample, sample), z_free(new_source_sn);
-                                           z_free(new_sample));
+                    _Z_CLEAN_RETURN_IF_ERR(_z_sample_copy(new_sample, sample), z_free(new_sample));
 
-                    _z_sample_t *entry =
-                        _z_uint32__z_sample_sortedmap_insert(&state->_pending_samples, new_source_sn, new_sample);
-                    if (entry == NULL) {
+                    z_result_t ret =
+                        _ze_advanced_subscriber_reorder_window_insert(&state->_pending_samples, source_sn, new_sample);
+                    if (ret != _Z_RES_OK) {
                         _Z_ERROR("Failed to insert sample into sequenced state");
-                        z_free(new_source_sn);
-                        z_free(new_sample);
-                        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+                        _z_sample_elem_free((void **)&new_sample);
+                        return ret;
                     }
                 } else {
                     uint32_t nb = (uint32_t)_z_seqnumber_diff(source_sn, next_sn);
@@ -1164,7 +1275,7 @@ void _ze_advanced_subscriber_subscriber_callback(z_loaned_sample_t *sample, void
         __unsafe_ze_advanced_subscriber_spawn_periodic_query(state, rc_states, &source_id);
     }
     if (state != NULL && states->_retransmission && state->_pending_queries == 0 &&
-        !_z_uint32__z_sample_sortedmap_is_empty(&state->_pending_samples)) {
+        _ze_advanced_subscriber_reorder_window_len(&state->_pending_samples) != 0) {
         char params[ZE_ADVANCED_SUBSCRIBER_QUERY_PARAM_BUF_SIZE];
         _z_query_param_range_t range = {
             ._has_start = state->_has_last_delivered,
@@ -534,6 +534,13 @@ void z_closure_sample_call(const z_loaned_closure_sample_t *closure, z_loaned_sa
     }
 }
 
+void z_closure_sample_batch_call(const z_loaned_closure_sample_batch_t *closure, z_loaned_sample_t *samples,
+                                 size_t len) {
+    if (closure->call != NULL) {
+        (closure->call)(samples, len, closure->context);
+    }
+}
+
 void z_closure_query_call(const z_loaned_closure_query_t *closure, z_loaned_query_t *query) {
     if (closure->call != NULL) {
         (closure->call)(query, closure->context);
@@ -753,6 +760,7 @@ _Z_OWNED_FUNCTIONS_VALUE_IMPL(_z_info_link_event_t, link_event, _z_info_link_eve
 #endif
 
 _Z_OWNED_FUNCTIONS_CLOSURE_IMPL(closure_sample, _z_closure_sample_callback_t, z_closure_drop_callback_t)
+_Z_OWNED_FUNCTIONS_CLOSURE_IMPL(closure_sample_batch, _z_closure_sample_batch_callback_t, z_closure_drop_callback_t)
 _Z_OWNED_FUNCTIONS_CLOSURE_IMPL(closure_query, _z_closure_query_callback_t, z_closure_drop_callback_t)
 _Z_OWNED_FUNCTIONS_CLOSURE_IMPL(closure_reply, _z_closure_reply_callback_t, z_closure_drop_callback_t)
 _Z_OWNED_FUNCTIONS_CLOSURE_IMPL(closure_hello, z_closure_hello_callback_t, z_closure_drop_callback_t)
@@ -955,6 +963,19 @@ z_result_t z_open(z_owned_session_t *zs, z_moved_config_t *config, const z_open_
     _Z_OWNED_RC_IN_VAL(zs)->_config = config->_this._val;
     z_internal_config_null(&config->_this);
 
+#if Z_FEATURE_RX_DISPATCH == 1
+    if (ret == _Z_RES_OK) {
+        _z_session_t *zn = _Z_RC_IN_VAL(&zs->_rc);
+        int32_t workers = 0;
+        ret = _z_config_get_i32_default(&zn->_config, Z_CONFIG_RX_DISPATCH_WORKERS_KEY,
+                                        Z_CONFIG_RX_DISPATCH_WORKERS_DEFAULT, &workers);
+        if (ret == _Z_RES_OK && workers < 0) {
+            _Z_ERROR("Invalid number of rx dispatch workers: %d", (int)workers);
+            ret = _Z_ERR_CONFIG_INVALID_VALUE;
+        }
+        _Z_SET_IF_OK(ret, _z_rx_dispatch_start(&zn->_rx_dispatch, zn, (size_t)workers));
+    }
+#endif
     _Z_SET_IF_OK(ret, _zp_start_transport_tasks(_Z_RC_IN_VAL(&zs->_rc)));
     if (ret != _Z_RES_OK) {
         z_session_drop(z_session_move(zs));
@@ -1550,9 +1571,8 @@ z_result_t _z_publisher_put_impl(const z_loaned_publisher_t *pub, z_moved_bytes_
 #endif
             !_z_write_filter_active(&pub->_filter)) {
             // Write value
-            ret = _z_write(session, &pub->_key, payload_bytes, encoding, Z_SAMPLE_KIND_PUT, pub->_congestion_control,
-                           pub->_priority, pub->_is_express, opt.timestamp, attachment_bytes, reliability, source_info,
-                           pub->_allowed_destination);
+            ret = _z_publisher_write(session, pub, payload_bytes, encoding, Z_SAMPLE_KIND_PUT, opt.timestamp,
+                                     attachment_bytes, reliability, source_info);
         }
     } else {
         _Z_ERROR_LOG(_Z_ERR_SESSION_CLOSED);
@@ -1616,8 +1636,8 @@ z_result_t _z_publisher_delete_impl(const z_loaned_publisher_t *pub, const z_pub
         session->_tp._type == _Z_TRANSPORT_MULTICAST_TYPE ||
 #endif
         !_z_write_filter_active(&pub->_filter)) {
-        ret = _z_write(session, &pub->_key, NULL, NULL, Z_SAMPLE_KIND_DELETE, pub->_congestion_control, pub->_priority,
-                       pub->_is_express, opt.timestamp, NULL, reliability, source_info, pub->_allowed_destination);
+        ret = _z_publisher_write(session, pub, NULL, NULL, Z_SAMPLE_KIND_DELETE, opt.timestamp, NULL, reliability,
+                                 source_info);
     }
 #if Z_FEATURE_ADVANCED_PUBLICATION == 1
     if (cache != NULL) {
@@ -2345,6 +2365,9 @@ void z_subscriber_options_default(z_subscriber_options_t *options) {
 #else
     options->__dummy = 0;
 #endif
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    options->batch_max_samples = Z_SUBSCRIBER_BATCH_SIZE;
+#endif
 }
 
 z_result_t z_declare_background_subscriber(const z_loaned_session_t *zs, const z_loaned_keyexpr_t *keyexpr,
@@ -2379,6 +2402,47 @@ z_result_t z_declare_subscriber(const z_loaned_session_t *zs, z_owned_subscriber
     }
 }
 
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+z_result_t z_declare_background_batched_subscriber(const z_loaned_session_t *zs, const z_loaned_keyexpr_t *keyexpr,
+                                                   z_moved_closure_sample_batch_t *callback,
+                                                   const z_subscriber_options_t *options) {
+    return z_declare_batched_subscriber(zs, NULL, keyexpr, callback, options);
+}
+
+z_result_t z_declare_batched_subscriber(const z_loaned_session_t *zs, z_owned_subscriber_t *sub,
+                                        const z_loaned_keyexpr_t *keyexpr, z_moved_closure_sample_batch_t *callback,
+                                        const z_subscriber_options_t *options) {
+    _z_closure_sample_batch_t closure = callback->_this._val;
+    z_internal_closure_sample_batch_null(&callback->_this);
+
+    z_subscriber_options_t opt;
+    z_subscriber_options_default(&opt);
+    if (options != NULL) {
+        opt = *options;
+    }
+    if (opt.batch_max_samples == 0) {
+        if (closure.drop != NULL) {
+            closure.drop(closure.context);
+        }
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+
+    z_locality_t allowed_origin = z_locality_default();
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+    allowed_origin = opt.allowed_origin;
+#endif
+    if (sub != NULL) {
+        sub->_val = _z_subscriber_null();
+        return _z_declare_batched_subscriber(&sub->_val, zs, keyexpr, closure.call, closure.drop, closure.context,
+                                             allowed_origin, opt.batch_max_samples);
+    } else {
+        uint32_t _sub_id;
+        return _z_register_batched_subscriber(&_sub_id, zs, keyexpr, closure.call, closure.drop, closure.context,
+                                              allowed_origin, opt.batch_max_samples, NULL);
+    }
+}
+#endif
+
 z_result_t z_undeclare_subscriber(z_moved_subscriber_t *sub) {
     z_result_t ret = _z_undeclare_subscriber(&sub->_this._val);
     _z_subscriber_clear(&sub->_this._val);
@@ -2528,6 +2592,25 @@ z_result_t zp_stop_lease_task(z_loaned_session_t *zs) {
 bool zp_lease_task_is_running(const z_loaned_session_t *zs) {
     return _z_background_executor_is_running(&_Z_RC_IN_VAL(zs)->_runtime);
 }
+
+#if Z_FEATURE_RX_DISPATCH == 1
+size_t zp_rx_dispatch_workers(const z_loaned_session_t *zs) { return _Z_RC_IN_VAL(zs)->_rx_dispatch._num_workers; }
+
+z_result_t zp_rx_dispatch_worker_stats(const z_loaned_session_t *zs, size_t worker,
+                                       zp_rx_dispatch_worker_stats_t *stats) {
+    _z_rx_dispatch_t *dispatch = &_Z_RC_IN_VAL(zs)->_rx_dispatch;
+    if (worker >= dispatch->_num_workers) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    _z_rx_dispatch_worker_t *w = &dispatch->_workers[worker];
+    stats->depth = _z_atomic_ring_len(&w->_queue);
+    stats->max_depth = _z_atomic_size_load(&w->_max_depth, _z_memory_order_relaxed);
+    stats->capacity = _z_atomic_ring_capacity(&w->_queue);
+    stats->dispatched = _z_atomic_size_load(&w->_dispatched, _z_memory_order_relaxed);
+    stats->stalls = _z_atomic_size_load(&w->_stalls, _z_memory_order_relaxed);
+    return _Z_RES_OK;
+}
+#endif
 #else
 void zp_read_options_default(zp_read_options_t *options) { options->single_read = false; }
 
@@ -2563,6 +2646,72 @@ bool zp_spin_once(const z_loaned_session_t *zs) {
 }
 #endif
 
+#if Z_FEATURE_PEER_ROUTING == 1
+z_result_t zp_peer_routing_stats(const z_loaned_session_t *zs, zp_peer_routing_stats_t *stats) {
+    _z_session_t *zn = _Z_RC_IN_VAL(zs);
+    if (zn->_tp._type != _Z_TRANSPORT_UNICAST_TYPE) {
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
+    }
+    _z_transport_common_t *ztc = &zn->_tp._transport._unicast._common;
+    _z_transport_peer_mutex_lock(ztc);
+    stats->routed = ztc->_route_stats._routed;
+    stats->unmatched = ztc->_route_stats._unmatched;
+    stats->peer_sends = ztc->_route_stats._peer_sends;
+    stats->peer_skips = ztc->_route_stats._peer_skips;
+    _z_transport_peer_mutex_unlock(ztc);
+    _z_session_mutex_lock(zn);
+    stats->route_hits = zn->_peer_routes._hits;
+    stats->route_misses = zn->_peer_routes._misses;
+    _z_session_mutex_unlock(zn);
+    return _Z_RES_OK;
+}
+#endif
+
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+z_result_t zp_multicast_repair_stats(const z_loaned_session_t *zs, zp_multicast_repair_stats_t *stats) {
+    _z_session_t *zn = _Z_RC_IN_VAL(zs);
+    if (zn->_tp._type != _Z_TRANSPORT_MULTICAST_TYPE) {
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
+    }
+    _z_transport_common_t *ztc = &zn->_tp._transport._multicast._common;
+    _Z_RETURN_IF_ERR(_z_transport_tx_mutex_lock(ztc, true));
+    stats->nacks = ztc->_repair._stats._nacks;
+    stats->retransmitted = ztc->_repair._stats._retransmitted;
+    stats->unrecoverable = ztc->_repair._stats._unrecoverable;
+    _z_transport_tx_mutex_unlock(ztc);
+    return _Z_RES_OK;
+}
+
+z_result_t zp_multicast_peer_repair_stats(const z_loaned_session_t *zs, const z_id_t *zid,
+                                          zp_multicast_peer_repair_stats_t *stats) {
+    _z_session_t *zn = _Z_RC_IN_VAL(zs);
+    if (zn->_tp._type != _Z_TRANSPORT_MULTICAST_TYPE) {
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
+    }
+    _z_transport_multicast_t *ztm = &zn->_tp._transport._multicast;
+    z_result_t ret = _Z_ERR_INVALID;
+    _z_transport_peer_mutex_lock(&ztm->_common);
+    for (_z_transport_peer_multicast_slist_t *it = ztm->_peers; it != NULL;
+         it = _z_transport_peer_multicast_slist_next(it)) {
+        _z_transport_peer_multicast_t *peer = _z_transport_peer_multicast_slist_value(it);
+        if (_z_id_eq(&peer->common._remote_zid, zid)) {
+            const _z_multicast_peer_repair_stats_t *src = &peer->_repair._stats;
+            stats->active = peer->_repair._active;
+            stats->gaps = src->_gaps;
+            stats->repaired = src->_repaired;
+            stats->lost = src->_lost;
+            stats->nacks_sent = src->_nacks_sent;
+            stats->nacks_suppressed = src->_nacks_suppressed;
+            stats->out_of_order = src->_out_of_order;
+            ret = _Z_RES_OK;
+            break;
+        }
+    }
+    _z_transport_peer_mutex_unlock(&ztm->_common);
+    return ret;
+}
+#endif
+
 #ifdef Z_FEATURE_UNSTABLE_API
 z_reliability_t z_reliability_default(void) { return Z_RELIABILITY_DEFAULT; }
 #endif
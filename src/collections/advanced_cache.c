@@ -30,11 +30,6 @@
 
 #if Z_FEATURE_ADVANCED_PUBLICATION == 1
 
-typedef struct {
-    int64_t start;
-    int64_t end;
-} _ze_advanced_cache_range_t;
-
 typedef struct {
     _ze_advanced_cache_range_t range;
     size_t max;
@@ -114,11 +109,214 @@ static void _ze_advanced_cache_query_parse_parameters(_ze_advanced_cache_query_p
     }
 }
 
+/*------------------ History store ------------------*/
+z_result_t _ze_advanced_cache_store_init(_ze_advanced_cache_store_t *store, size_t capacity) {
+    *store = (_ze_advanced_cache_store_t){0};
+    if (capacity == 0 || capacity > SIZE_MAX / (2 * sizeof(_ze_advanced_cache_entry_t))) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    store->_slab = (_ze_advanced_cache_entry_t *)z_malloc(2 * capacity * sizeof(_ze_advanced_cache_entry_t));
+    store->_ring = (_ze_advanced_cache_entry_t **)z_malloc(capacity * sizeof(_ze_advanced_cache_entry_t *));
+    if (store->_slab == NULL || store->_ring == NULL) {
+        z_free(store->_slab);
+        z_free(store->_ring);
+        *store = (_ze_advanced_cache_store_t){0};
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    for (size_t i = 2 * capacity; i > 0; i--) {
+        _ze_advanced_cache_entry_t *e = &store->_slab[i - 1];
+        e->_sample = _z_sample_null();
+        e->_refs = 0;
+        e->_next_free = store->_free;
+        store->_free = e;
+    }
+    store->_capacity = capacity;
+    return _Z_RES_OK;
+}
+
+void _ze_advanced_cache_store_clear(_ze_advanced_cache_store_t *store) {
+    if (store->_slab != NULL) {
+        for (size_t i = 0; i < 2 * store->_capacity; i++) {
+            _z_sample_clear(&store->_slab[i]._sample);
+        }
+    }
+    z_free(store->_slab);
+    z_free(store->_ring);
+    *store = (_ze_advanced_cache_store_t){0};
+}
+
+static inline _ze_advanced_cache_entry_t *_ze_advanced_cache_store_at(const _ze_advanced_cache_store_t *store,
+                                                                      size_t i) {
+    return store->_ring[(store->_start + i) % store->_capacity];
+}
+
+static inline const _z_sample_owned_t *_ze_advanced_cache_store_sample_at(const _ze_advanced_cache_store_t *store,
+                                                                          size_t i) {
+    return _z_sample_get_ref(&_ze_advanced_cache_store_at(store, i)->_sample);
+}
+
+static void _ze_advanced_cache_store_unref(_ze_advanced_cache_store_t *store, _ze_advanced_cache_entry_t *e,
+                                           _z_sample_t *dropped) {
+    e->_refs--;
+    if (e->_refs == 0) {
+        *dropped = e->_sample;
+        e->_sample = _z_sample_null();
+        e->_next_free = store->_free;
+        store->_free = e;
+    }
+}
+
+z_result_t _ze_advanced_cache_store_push(_ze_advanced_cache_store_t *store, _z_sample_t *sample, _z_sample_t *dropped) {
+    *dropped = _z_sample_null();
+    if (store->_len == store->_capacity) {
+        _ze_advanced_cache_entry_t *oldest = store->_ring[store->_start];
+        store->_start = (store->_start + 1) % store->_capacity;
+        store->_len--;
+        // The next one becomes the first, whose order is not counted
+        if (store->_len > 0) {
+            _ze_advanced_cache_entry_t *first = store->_ring[store->_start];
+            store->_sn_breaks -= first->_sn_in_order ? 0 : 1;
+            store->_ts_breaks -= first->_ts_in_order ? 0 : 1;
+        }
+        _ze_advanced_cache_store_unref(store, oldest, dropped);
+    }
+    _ze_advanced_cache_entry_t *e = store->_free;
+    if (e == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    store->_free = e->_next_free;
+    e->_next_free = NULL;
+    e->_sample = *sample;
+    *sample = _z_sample_null();
+    e->_refs = 1;
+
+    const _z_sample_owned_t *ref = _z_sample_get_ref(&e->_sample);
+    e->_sn_in_order = _z_source_info_check(&ref->source_info);
+    e->_ts_in_order = _z_timestamp_check(&ref->timestamp);
+    if (store->_len > 0) {
+        const _z_sample_owned_t *last = _ze_advanced_cache_store_sample_at(store, store->_len - 1);
+        e->_sn_in_order = e->_sn_in_order && _z_source_info_check(&last->source_info) &&
+                          last->source_info._source_sn < ref->source_info._source_sn;
+        e->_ts_in_order =
+            e->_ts_in_order && _z_timestamp_check(&last->timestamp) && last->timestamp.time <= ref->timestamp.time;
+        store->_sn_breaks += e->_sn_in_order ? 0 : 1;
+        store->_ts_breaks += e->_ts_in_order ? 0 : 1;
+    }
+    store->_ring[(store->_start + store->_len) % store->_capacity] = e;
+    store->_len++;
+    return _Z_RES_OK;
+}
+
+// Whether the sequence number at i is before the given one, or not past it when inclusive
+static inline bool _ze_advanced_cache_store_sn_before(const _ze_advanced_cache_store_t *store, size_t i, int64_t sn,
+                                                      bool inclusive) {
+    int64_t at = (int64_t)_ze_advanced_cache_store_sample_at(store, i)->source_info._source_sn;
+    return inclusive ? (at <= sn) : (at < sn);
+}
+
+// First position in [lo, hi) whose sequence number is not before the given one. Sequence numbers usually follow
+// each other, so the position is guessed from the first one before searching for it.
+static size_t _ze_advanced_cache_store_sn_partition(const _ze_advanced_cache_store_t *store, size_t lo, size_t hi,
+                                                    int64_t sn, bool inclusive) {
+    int64_t guess = sn - (int64_t)_ze_advanced_cache_store_sample_at(store, 0)->source_info._source_sn;
+    guess += inclusive ? 1 : 0;
+    size_t g = (guess < (int64_t)lo) ? lo : ((guess > (int64_t)hi) ? hi : (size_t)guess);
+    if ((g == lo || _ze_advanced_cache_store_sn_before(store, g - 1, sn, inclusive)) &&
+        (g == hi || !_ze_advanced_cache_store_sn_before(store, g, sn, inclusive))) {
+        return g;
+    }
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (_ze_advanced_cache_store_sn_before(store, mid, sn, inclusive)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// First position in [lo, hi) whose timestamp is within the range, the range being open on one side
+static size_t _ze_advanced_cache_store_ts_partition(const _ze_advanced_cache_store_t *store, size_t lo, size_t hi,
+                                                    const _z_time_range_t *half, _z_ntp64_t now, bool start) {
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        _z_ntp64_t ts = _ze_advanced_cache_store_sample_at(store, mid)->timestamp.time;
+        bool within = _z_time_range_contains_at_time(half, ts, now);
+        // Before the start bound is outside the range, before the end bound is inside it
+        if (within != start) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
 static bool _ze_advanced_cache_range_contains(const _ze_advanced_cache_range_t *range, uint32_t sn) {
     return ((range->start == _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED || range->start <= sn) &&
             (range->end == _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED || sn <= range->end));
 }
 
+size_t _ze_advanced_cache_store_select(_ze_advanced_cache_store_t *store, const _ze_advanced_cache_range_t *range,
+                                       const _z_time_range_t *time, _z_ntp64_t now, size_t max,
+                                       _ze_advanced_cache_entry_t **entries) {
+    const bool range_filter = (range->start != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED) ||
+                              (range->end != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED);
+    const bool time_filter =
+        (time->start.bound != _Z_TIME_BOUND_UNBOUNDED) || (time->end.bound != _Z_TIME_BOUND_UNBOUNDED);
+
+    size_t lo = 0;
+    size_t hi = store->_len;
+    if (range_filter && hi > 0 && store->_sn_breaks == 0 && _ze_advanced_cache_store_at(store, 0)->_sn_in_order) {
+        if (range->end != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED) {
+            hi = _ze_advanced_cache_store_sn_partition(store, lo, hi, range->end, true);
+        }
+        if (range->start != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED) {
+            lo = _ze_advanced_cache_store_sn_partition(store, lo, hi, range->start, false);
+        }
+    }
+    if (time_filter && hi > lo && store->_ts_breaks == 0 && _ze_advanced_cache_store_at(store, 0)->_ts_in_order) {
+        _z_time_range_t half = *time;
+        if (time->end.bound != _Z_TIME_BOUND_UNBOUNDED) {
+            half.start.bound = _Z_TIME_BOUND_UNBOUNDED;
+            hi = _ze_advanced_cache_store_ts_partition(store, lo, hi, &half, now, false);
+        }
+        if (time->start.bound != _Z_TIME_BOUND_UNBOUNDED) {
+            half = *time;
+            half.end.bound = _Z_TIME_BOUND_UNBOUNDED;
+            lo = _ze_advanced_cache_store_ts_partition(store, lo, hi, &half, now, true);
+        }
+    }
+
+    size_t len = 0;
+    for (size_t i = hi; i > lo && len < max; i--) {
+        _ze_advanced_cache_entry_t *e = _ze_advanced_cache_store_at(store, i - 1);
+        const _z_sample_owned_t *ref = _z_sample_get_ref(&e->_sample);
+        if (range_filter && (!_z_source_info_check(&ref->source_info) ||
+                             !_ze_advanced_cache_range_contains(range, ref->source_info._source_sn))) {
+            continue;
+        }
+        if (time_filter &&
+            (!_z_timestamp_check(&ref->timestamp) || !_z_time_range_contains_at_time(time, ref->timestamp.time, now))) {
+            continue;
+        }
+        e->_refs++;
+        entries[len++] = e;
+    }
+    return len;
+}
+
+void _ze_advanced_cache_store_release(_ze_advanced_cache_store_t *store, _ze_advanced_cache_entry_t **entries,
+                                      size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        _z_sample_t dropped = _z_sample_null();
+        _ze_advanced_cache_store_unref(store, entries[i], &dropped);
+        _z_sample_clear(&dropped);
+    }
+}
+
+/*------------------ Queryable ------------------*/
 static void _ze_advanced_cache_query_handler(z_loaned_query_t *query, void *ctx) {
     _ze_advanced_cache_t *cache = (_ze_advanced_cache_t *)ctx;
 
@@ -148,40 +346,12 @@ static void _ze_advanced_cache_query_handler(z_loaned_query_t *query, void *ctx)
         _z_mutex_unlock(&cache->_outbox_mutex);
         return;
     }
+    _ze_advanced_cache_store_release(&cache->_store, cache->_outbox, cache->_outbox_held);
+    cache->_outbox_held = 0;
 #endif
-    size_t cap = _z_sample_ring_capacity(&cache->_cache);
-    size_t max = (params.max != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_MAX_UNBOUNDED) ? params.max : cap;
-    if (max > cap) max = cap;
-    if (max > cache->_outbox_cap) max = cache->_outbox_cap;
-
-    const bool range_filter = (params.range.start != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED) ||
-                              (params.range.end != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED);
-    const bool time_filter =
-        (params.time.start.bound != _Z_TIME_BOUND_UNBOUNDED) || (params.time.end.bound != _Z_TIME_BOUND_UNBOUNDED);
-
-    _z_sample_ring_reverse_iterator_t iter = _z_sample_ring_reverse_iterator_make(&cache->_cache);
-
-    size_t to_send = 0;
-    while (max > 0 && _z_sample_ring_reverse_iterator_next(&iter)) {
-        _z_sample_t *sample = _z_sample_ring_reverse_iterator_value(&iter);
-        const _z_sample_owned_t *ref = _z_sample_get_ref(sample);
-        if (range_filter && (!_z_source_info_check(&ref->source_info) ||
-                             !_ze_advanced_cache_range_contains(&params.range, ref->source_info._source_sn))) {
-            continue;
-        }
-        if (time_filter && (!_z_timestamp_check(&ref->timestamp) ||
-                            !_z_time_range_contains_at_time(&params.time, ref->timestamp.time, now_ntp64))) {
-            continue;
-        }
-
-        res = _z_sample_copy(&cache->_outbox[to_send], sample);
-        if (res != _Z_RES_OK) {
-            _Z_ERROR("Sample dropped from advanced cache query reply - failed to copy sample: %i", res);
-        } else {
-            to_send++;
-            max--;
-        }
-    }
+    size_t max = (params.max < cache->_outbox_cap) ? params.max : cache->_outbox_cap;
+    size_t to_send =
+        _ze_advanced_cache_store_select(&cache->_store, &params.range, &params.time, now_ntp64, max, cache->_outbox);
 
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_unlock(&cache->_mutex);
@@ -193,17 +363,29 @@ static void _ze_advanced_cache_query_handler(z_loaned_query_t *query, void *ctx)
     opt.priority = cache->_priority;
     opt.is_express = cache->_is_express;
 
-    // Send samples in order
-    while (to_send > 0) {
-        to_send--;
-        _z_sample_t *sample = &cache->_outbox[to_send];
-        res = _z_query_reply_sample(query, sample, &opt);
-        _z_sample_clear(sample);
+    // Send samples in order, straight from the history
+    for (size_t i = to_send; i > 0; i--) {
+        res = _z_query_reply_sample(query, &cache->_outbox[i - 1]->_sample, &opt);
         if (res != _Z_RES_OK) {
             _Z_ERROR("Sample dropped from advanced cache query reply - failed to send sample: %i", res);
         }
     }
 
+#if Z_FEATURE_MULTI_THREAD == 1
+    // Samples dropped from the history while being sent are freed with their last reference
+    if (_z_mutex_lock(&cache->_mutex) != _Z_RES_OK) {
+        _Z_ERROR("Failed to release advanced cache query reply samples - failed to lock mutex");
+        // Left in the outbox for the next query to release
+        cache->_outbox_held = to_send;
+        _z_mutex_unlock(&cache->_outbox_mutex);
+        return;
+    }
+#endif
+    _ze_advanced_cache_store_release(&cache->_store, cache->_outbox, to_send);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&cache->_mutex);
+#endif
+
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_unlock(&cache->_outbox_mutex);
 #endif
@@ -216,14 +398,14 @@ static z_result_t _ze_advanced_cache_init(_ze_advanced_cache_t *cache, const z_l
         _Z_ERROR_RETURN(_Z_ERR_INVALID);
     }
 
-    _Z_RETURN_IF_ERR(_z_sample_ring_init(&cache->_cache, options.max_samples));
+    _Z_RETURN_IF_ERR(_ze_advanced_cache_store_init(&cache->_store, options.max_samples));
     cache->_outbox_cap = options.max_samples;
-    cache->_outbox = (_z_sample_t *)z_malloc(sizeof(_z_sample_t) * cache->_outbox_cap);
+    cache->_outbox =
+        (_ze_advanced_cache_entry_t **)z_malloc(sizeof(_ze_advanced_cache_entry_t *) * cache->_outbox_cap);
     if (cache->_outbox == NULL) {
-        _z_sample_ring_clear(&cache->_cache);
+        _ze_advanced_cache_store_clear(&cache->_store);
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
-    memset(cache->_outbox, 0, sizeof(_z_sample_t) * cache->_outbox_cap);
 
     cache->_congestion_control = options.congestion_control;
     cache->_priority = options.priority;
@@ -232,19 +414,21 @@ static z_result_t _ze_advanced_cache_init(_ze_advanced_cache_t *cache, const z_l
     z_owned_keyexpr_t ke;
     z_internal_keyexpr_null(&ke);
     if (suffix != NULL) {
-        _Z_CLEAN_RETURN_IF_ERR(z_keyexpr_join(&ke, keyexpr, suffix), _z_sample_ring_clear(&cache->_cache);
+        _Z_CLEAN_RETURN_IF_ERR(z_keyexpr_join(&ke, keyexpr, suffix), _ze_advanced_cache_store_clear(&cache->_store);
                                z_free(cache->_outbox); cache->_outbox = NULL);
     } else {
-        _Z_CLEAN_RETURN_IF_ERR(z_keyexpr_clone(&ke, keyexpr), _z_sample_ring_clear(&cache->_cache);
+        _Z_CLEAN_RETURN_IF_ERR(z_keyexpr_clone(&ke, keyexpr), _ze_advanced_cache_store_clear(&cache->_store);
                                z_free(cache->_outbox); cache->_outbox = NULL);
     }
 
 #if Z_FEATURE_MULTI_THREAD == 1
     _Z_CLEAN_RETURN_IF_ERR(_z_mutex_init(&cache->_mutex), z_keyexpr_drop(z_keyexpr_move(&ke));
-                           _z_sample_ring_clear(&cache->_cache); z_free(cache->_outbox); cache->_outbox = NULL);
+                           _ze_advanced_cache_store_clear(&cache->_store); z_free(cache->_outbox);
+                           cache->_outbox = NULL);
     _Z_CLEAN_RETURN_IF_ERR(_z_mutex_init(&cache->_outbox_mutex), z_keyexpr_drop(z_keyexpr_move(&ke));
-                           _z_sample_ring_clear(&cache->_cache); z_free(cache->_outbox); cache->_outbox = NULL;
-                           _z_mutex_drop(&cache->_mutex));
+                           _ze_advanced_cache_store_clear(&cache->_store); z_free(cache->_outbox);
+                           cache->_outbox = NULL; _z_mutex_drop(&cache->_mutex));
+    cache->_outbox_held = 0;
 #endif
 
     z_result_t res = _Z_RES_OK;
@@ -253,7 +437,7 @@ static z_result_t _ze_advanced_cache_init(_ze_advanced_cache_t *cache, const z_l
         res = z_liveliness_declare_token(zs, &cache->_liveliness, z_keyexpr_loan(&ke), NULL);
         if (res != _Z_RES_OK) {
             z_keyexpr_drop(z_keyexpr_move(&ke));
-            _z_sample_ring_clear(&cache->_cache);
+            _ze_advanced_cache_store_clear(&cache->_store);
             z_free(cache->_outbox);
             cache->_outbox = NULL;
 #if Z_FEATURE_MULTI_THREAD == 1
@@ -270,7 +454,7 @@ static z_result_t _ze_advanced_cache_init(_ze_advanced_cache_t *cache, const z_l
     if (res != _Z_RES_OK) {
         z_keyexpr_drop(z_keyexpr_move(&ke));
         z_liveliness_token_drop(z_liveliness_token_move(&cache->_liveliness));
-        _z_sample_ring_clear(&cache->_cache);
+        _ze_advanced_cache_store_clear(&cache->_store);
         z_free(cache->_outbox);
         cache->_outbox = NULL;
 #if Z_FEATURE_MULTI_THREAD == 1
@@ -284,7 +468,7 @@ static z_result_t _ze_advanced_cache_init(_ze_advanced_cache_t *cache, const z_l
         z_keyexpr_drop(z_keyexpr_move(&ke));
         z_liveliness_token_drop(z_liveliness_token_move(&cache->_liveliness));
         z_closure_query_drop(z_closure_query_move(&callback));
-        _z_sample_ring_clear(&cache->_cache);
+        _ze_advanced_cache_store_clear(&cache->_store);
         z_free(cache->_outbox);
         cache->_outbox = NULL;
 #if Z_FEATURE_MULTI_THREAD == 1
@@ -320,21 +504,21 @@ z_result_t _ze_advanced_cache_add(_ze_advanced_cache_t *cache, _z_sample_t *samp
     if (cache == NULL || sample == NULL) {
         _Z_ERROR_RETURN(_Z_ERR_INVALID);
     }
-    _z_sample_t *s = (_z_sample_t *)z_malloc(sizeof(_z_sample_t));
-    if (s == NULL) {
-        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-    }
-    _Z_CLEAN_RETURN_IF_ERR(_z_sample_move_or_copy(s, sample), z_free((void *)s));
+    _z_sample_t s;
+    _Z_RETURN_IF_ERR(_z_sample_move_or_copy(&s, sample));
 
+    _z_sample_t dropped;
 #if Z_FEATURE_MULTI_THREAD == 1
-    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_lock(&cache->_mutex), z_free((void *)s));
+    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_lock(&cache->_mutex), _z_sample_clear(&s));
 #endif
-    _z_sample_ring_push_force_drop(&cache->_cache, s);
+    z_result_t ret = _ze_advanced_cache_store_push(&cache->_store, &s, &dropped);
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_unlock(&cache->_mutex);
 #endif
-
-    return _Z_RES_OK;
+    // Freed out of the lock, the sample is left to us on failure
+    _z_sample_clear(&dropped);
+    _z_sample_clear(&s);
+    return ret;
 }
 
 void _ze_advanced_cache_free(_ze_advanced_cache_t **pcache) {
@@ -347,7 +531,7 @@ void _ze_advanced_cache_free(_ze_advanced_cache_t **pcache) {
         _z_mutex_lock(&cache->_outbox_mutex);
         _z_mutex_lock(&cache->_mutex);
 #endif
-        _z_sample_ring_clear(&cache->_cache);
+        _ze_advanced_cache_store_clear(&cache->_store);
         z_free(cache->_outbox);
 
 #if Z_FEATURE_MULTI_THREAD == 1
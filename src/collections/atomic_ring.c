@@ -0,0 +1,303 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/collections/atomic_ring.h"
+
+#include <stdint.h>
+
+#include "zenoh-pico/utils/logging.h"
+
+#if Z_FEATURE_MULTI_THREAD == 1
+
+// Positions wrap around, compare them through their difference
+static inline intptr_t _z_atomic_ring_diff(size_t a, size_t b) { return (intptr_t)(a - b); }
+
+z_result_t _z_atomic_ring_init(_z_atomic_ring_t *ring, size_t capacity, bool spsc) {
+    if (capacity == 0) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    // Cells are indexed with a mask, the capacity itself is enforced against the head
+    size_t cell_num = 1;
+    while (cell_num < capacity) {
+        cell_num <<= 1;
+    }
+    ring->_cells = (_z_atomic_ring_cell_t *)z_malloc(cell_num * sizeof(_z_atomic_ring_cell_t));
+    if (ring->_cells == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    for (size_t i = 0; i < cell_num; i++) {
+        _z_atomic_size_init(&ring->_cells[i]._seq, i);
+        ring->_cells[i]._elem = NULL;
+    }
+    ring->_mask = cell_num - 1;
+    ring->_capacity = capacity;
+    ring->_spsc = spsc;
+    _z_atomic_size_init(&ring->_head, 0);
+    _z_atomic_size_init(&ring->_tail, 0);
+    _z_atomic_bool_init(&ring->_closed, false);
+    _z_atomic_bool_init(&ring->_pull_parked, false);
+    _z_atomic_bool_init(&ring->_push_parked, false);
+
+    z_result_t ret = _z_mutex_init(&ring->_mutex);
+    if (ret == _Z_RES_OK) {
+        ret = _z_condvar_init(&ring->_cv_not_empty);
+        if (ret == _Z_RES_OK) {
+            ret = _z_condvar_init(&ring->_cv_not_full);
+            if (ret != _Z_RES_OK) {
+                _z_condvar_drop(&ring->_cv_not_empty);
+            }
+        }
+        if (ret != _Z_RES_OK) {
+            _z_mutex_drop(&ring->_mutex);
+        }
+    }
+    if (ret != _Z_RES_OK) {
+        z_free(ring->_cells);
+        ring->_cells = NULL;
+    }
+    return ret;
+}
+
+void _z_atomic_ring_clear(_z_atomic_ring_t *ring, z_element_free_f free_f) {
+    if (ring->_cells == NULL) {
+        return;
+    }
+    void *elem = _z_atomic_ring_try_pull(ring);
+    while (elem != NULL) {
+        free_f(&elem);
+        elem = _z_atomic_ring_try_pull(ring);
+    }
+    _z_mutex_drop(&ring->_mutex);
+    _z_condvar_drop(&ring->_cv_not_empty);
+    _z_condvar_drop(&ring->_cv_not_full);
+    z_free(ring->_cells);
+    ring->_cells = NULL;
+}
+
+size_t _z_atomic_ring_capacity(const _z_atomic_ring_t *ring) { return ring->_capacity; }
+
+size_t _z_atomic_ring_len(_z_atomic_ring_t *ring) {
+    size_t head = _z_atomic_size_load(&ring->_head, _z_memory_order_acquire);
+    size_t tail = _z_atomic_size_load(&ring->_tail, _z_memory_order_acquire);
+    intptr_t len = _z_atomic_ring_diff(tail, head);
+    return (len > 0) ? (size_t)len : 0;
+}
+
+bool _z_atomic_ring_is_closed(_z_atomic_ring_t *ring) {
+    return _z_atomic_bool_load(&ring->_closed, _z_memory_order_acquire);
+}
+
+// Wake up the parked threads, if any. The fence pairs with the one of the parking threads: either they see the ring
+// change, or this sees them parked. Only the first change after they parked takes the mutex.
+static void _z_atomic_ring_notify(_z_atomic_ring_t *ring, _z_atomic_bool_t *parked, _z_condvar_t *cv) {
+    _z_atomic_thread_fence(_z_memory_order_seq_cst);
+    if (!_z_atomic_bool_load(parked, _z_memory_order_relaxed)) {
+        return;
+    }
+    bool expected = true;
+    if (_z_atomic_bool_compare_exchange_strong(parked, &expected, false, _z_memory_order_acq_rel,
+                                               _z_memory_order_relaxed) &&
+        (_z_mutex_lock(&ring->_mutex) == _Z_RES_OK)) {
+        _z_condvar_signal_all(cv);
+        _z_mutex_unlock(&ring->_mutex);
+    }
+}
+
+z_result_t _z_atomic_ring_close(_z_atomic_ring_t *ring) {
+    _z_atomic_bool_store(&ring->_closed, true, _z_memory_order_seq_cst);
+    _Z_RETURN_IF_ERR(_z_mutex_lock(&ring->_mutex));
+    _Z_RETURN_IF_ERR(_z_condvar_signal_all(&ring->_cv_not_empty));
+    _Z_RETURN_IF_ERR(_z_condvar_signal_all(&ring->_cv_not_full));
+    return _z_mutex_unlock(&ring->_mutex);
+}
+
+static bool _z_atomic_ring_try_push_inner(_z_atomic_ring_t *ring, void *elem) {
+    size_t pos = _z_atomic_size_load(&ring->_tail, _z_memory_order_relaxed);
+    if (ring->_spsc) {
+        if (pos - _z_atomic_size_load(&ring->_head, _z_memory_order_acquire) >= ring->_capacity) {
+            return false;
+        }
+        ring->_cells[pos & ring->_mask]._elem = elem;
+        _z_atomic_size_store(&ring->_tail, pos + 1, _z_memory_order_release);
+        return true;
+    }
+    _z_atomic_ring_cell_t *cell;
+    for (;;) {
+        // Positions claimed by pulls still count until they are done, so the capacity may be reached early
+        intptr_t used = _z_atomic_ring_diff(pos, _z_atomic_size_load(&ring->_head, _z_memory_order_acquire));
+        if (used >= (intptr_t)ring->_capacity) {
+            return false;
+        } else if (used < 0) {
+            // Other threads pushed and pulled since the tail was read
+            pos = _z_atomic_size_load(&ring->_tail, _z_memory_order_relaxed);
+            continue;
+        }
+        cell = &ring->_cells[pos & ring->_mask];
+        intptr_t diff = _z_atomic_ring_diff(_z_atomic_size_load(&cell->_seq, _z_memory_order_acquire), pos);
+        if (diff == 0) {
+            if (_z_atomic_size_compare_exchange_weak(&ring->_tail, &pos, pos + 1, _z_memory_order_relaxed,
+                                                     _z_memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The previous element of the cell is still being pulled
+            return false;
+        } else {
+            pos = _z_atomic_size_load(&ring->_tail, _z_memory_order_relaxed);
+        }
+    }
+    cell->_elem = elem;
+    _z_atomic_size_store(&cell->_seq, pos + 1, _z_memory_order_release);
+    return true;
+}
+
+static size_t _z_atomic_ring_try_pull_inner(_z_atomic_ring_t *ring, void **elems, size_t len) {
+    size_t pos = _z_atomic_size_load(&ring->_head, _z_memory_order_relaxed);
+    if (ring->_spsc) {
+        size_t num = _z_atomic_size_load(&ring->_tail, _z_memory_order_acquire) - pos;
+        num = (num < len) ? num : len;
+        for (size_t i = 0; i < num; i++) {
+            elems[i] = ring->_cells[(pos + i) & ring->_mask]._elem;
+        }
+        if (num > 0) {
+            _z_atomic_size_store(&ring->_head, pos + num, _z_memory_order_release);
+        }
+        return num;
+    }
+    size_t num;
+    for (;;) {
+        // Claim the run of ready cells from the head with a single exchange
+        num = 0;
+        while (num < len) {
+            _z_atomic_ring_cell_t *cell = &ring->_cells[(pos + num) & ring->_mask];
+            size_t seq = _z_atomic_size_load(&cell->_seq, _z_memory_order_acquire);
+            if (seq != pos + num + 1) {
+                break;
+            }
+            num++;
+        }
+        if (num == 0) {
+            size_t head = _z_atomic_size_load(&ring->_head, _z_memory_order_relaxed);
+            if (head == pos) {
+                return 0;
+            }
+            pos = head;
+        } else if (_z_atomic_size_compare_exchange_weak(&ring->_head, &pos, pos + num, _z_memory_order_relaxed,
+                                                        _z_memory_order_relaxed)) {
+            break;
+        }
+    }
+    for (size_t i = 0; i < num; i++) {
+        _z_atomic_ring_cell_t *cell = &ring->_cells[(pos + i) & ring->_mask];
+        elems[i] = cell->_elem;
+        // Ready for the push one lap later
+        _z_atomic_size_store(&cell->_seq, pos + i + ring->_mask + 1, _z_memory_order_release);
+    }
+    return num;
+}
+
+bool _z_atomic_ring_try_push(_z_atomic_ring_t *ring, void *elem) {
+    if (!_z_atomic_ring_try_push_inner(ring, elem)) {
+        return false;
+    }
+    _z_atomic_ring_notify(ring, &ring->_pull_parked, &ring->_cv_not_empty);
+    return true;
+}
+
+void *_z_atomic_ring_try_pull(_z_atomic_ring_t *ring) {
+    void *elem = NULL;
+    if (_z_atomic_ring_try_pull_inner(ring, &elem, 1) == 0) {
+        return NULL;
+    }
+    _z_atomic_ring_notify(ring, &ring->_push_parked, &ring->_cv_not_full);
+    return elem;
+}
+
+size_t _z_atomic_ring_try_pull_many(_z_atomic_ring_t *ring, void **elems, size_t len) {
+    size_t num = _z_atomic_ring_try_pull_inner(ring, elems, len);
+    if (num > 0) {
+        _z_atomic_ring_notify(ring, &ring->_push_parked, &ring->_cv_not_full);
+    }
+    return num;
+}
+
+z_result_t _z_atomic_ring_push(_z_atomic_ring_t *ring, void *elem) {
+    while (!_z_atomic_ring_try_push(ring, elem)) {
+        _Z_RETURN_IF_ERR(_z_mutex_lock(&ring->_mutex));
+        _z_atomic_bool_store(&ring->_push_parked, true, _z_memory_order_seq_cst);
+        _z_atomic_thread_fence(_z_memory_order_seq_cst);
+        // Check again now that pulls see this thread waiting
+        bool pushed = _z_atomic_ring_try_push_inner(ring, elem);
+        z_result_t ret = _Z_RES_OK;
+        if (!pushed && !_z_atomic_ring_is_closed(ring)) {
+            ret = _z_condvar_wait(&ring->_cv_not_full, &ring->_mutex);
+        }
+        _Z_RETURN_IF_ERR(_z_mutex_unlock(&ring->_mutex));
+        _Z_RETURN_IF_ERR(ret);
+        if (pushed) {
+            _z_atomic_ring_notify(ring, &ring->_pull_parked, &ring->_cv_not_empty);
+            break;
+        }
+        if (_z_atomic_ring_is_closed(ring)) {
+            // Nobody will pull the element anymore, it stays with the caller
+            return _Z_RES_CHANNEL_CLOSED;
+        }
+    }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_atomic_ring_push_force_drop(_z_atomic_ring_t *ring, void *elem, z_element_free_f free_f) {
+    if (ring->_spsc) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    while (!_z_atomic_ring_try_push(ring, elem)) {
+        void *oldest = _z_atomic_ring_try_pull(ring);
+        if (oldest != NULL) {
+            free_f(&oldest);
+        }
+    }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_atomic_ring_pull(_z_atomic_ring_t *ring, void **elem) {
+    *elem = _z_atomic_ring_try_pull(ring);
+    while (*elem == NULL) {
+        if (_z_atomic_ring_is_closed(ring)) {
+            // Pushes done before the close are still delivered
+            *elem = _z_atomic_ring_try_pull(ring);
+            return (*elem != NULL) ? _Z_RES_OK : _Z_RES_CHANNEL_CLOSED;
+        }
+        _Z_RETURN_IF_ERR(_z_mutex_lock(&ring->_mutex));
+        _z_atomic_bool_store(&ring->_pull_parked, true, _z_memory_order_seq_cst);
+        _z_atomic_thread_fence(_z_memory_order_seq_cst);
+        // Check again now that pushes see this thread waiting
+        void *pulled = NULL;
+        size_t num = _z_atomic_ring_try_pull_inner(ring, &pulled, 1);
+        z_result_t ret = _Z_RES_OK;
+        if (num == 0 && !_z_atomic_ring_is_closed(ring)) {
+            ret = _z_condvar_wait(&ring->_cv_not_empty, &ring->_mutex);
+        }
+        _Z_RETURN_IF_ERR(_z_mutex_unlock(&ring->_mutex));
+        _Z_RETURN_IF_ERR(ret);
+        if (num > 0) {
+            _z_atomic_ring_notify(ring, &ring->_push_parked, &ring->_cv_not_full);
+            *elem = pulled;
+        } else {
+            *elem = _z_atomic_ring_try_pull(ring);
+        }
+    }
+    return _Z_RES_OK;
+}
+
+#endif  // Z_FEATURE_MULTI_THREAD == 1
@@ -35,7 +35,14 @@ z_result_t _z_bytes_copy(_z_bytes_t *dst, const _z_bytes_t *src) {
     }
     for (size_t i = 0; i < num_slices; ++i) {
         _z_slice_t s = _z_slice_null();
-        _Z_CLEAN_RETURN_IF_ERR(_z_slice_copy(&s, _z_bytes_get_slice(src, i)), _z_bytes_clear(dst));
+        const _z_slice_t *src_slice = _z_bytes_get_slice(src, i);
+#if Z_FEATURE_RX_ZERO_COPY == 1
+        // Slices of a shared rx buffer are retained by reference
+        if (!_z_slice_share(&s, src_slice))
+#endif
+        {
+            _Z_CLEAN_RETURN_IF_ERR(_z_slice_copy(&s, src_slice), _z_bytes_clear(dst));
+        }
         _Z_CLEAN_RETURN_IF_ERR(_z_bytes_append_slice(dst, &s), _z_bytes_clear(dst));
     }
     return _Z_RES_OK;
@@ -17,17 +17,20 @@
 #include "zenoh-pico/protocol/codec/core.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/result.h"
 
+// Elements moved out of the fifo per batch in _z_fifo_mt_try_pull_many
+#define _Z_FIFO_MT_PULL_BATCH 16
+
 /*-------- Fifo Buffer Multithreaded --------*/
 z_result_t _z_fifo_mt_init(_z_fifo_mt_t *fifo, size_t capacity) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    // Channel callbacks may run on several threads at once
+    _Z_RETURN_IF_ERR(_z_atomic_ring_init(&fifo->_ring, capacity, false))
+#else
     _Z_RETURN_IF_ERR(_z_fifo_init(&fifo->_fifo, capacity))
     fifo->is_closed = false;
-
-#if Z_FEATURE_MULTI_THREAD == 1
-    _Z_RETURN_IF_ERR(_z_mutex_init(&fifo->_mutex))
-    _Z_RETURN_IF_ERR(_z_condvar_init(&fifo->_cv_not_full))
-    _Z_RETURN_IF_ERR(_z_condvar_init(&fifo->_cv_not_empty))
 #endif
 
     return _Z_RES_OK;
@@ -52,12 +55,10 @@ _z_fifo_mt_t *_z_fifo_mt_new(size_t capacity) {
 
 void _z_fifo_mt_clear(_z_fifo_mt_t *fifo, z_element_free_f free_f) {
 #if Z_FEATURE_MULTI_THREAD == 1
-    _z_mutex_drop(&fifo->_mutex);
-    _z_condvar_drop(&fifo->_cv_not_full);
-    _z_condvar_drop(&fifo->_cv_not_empty);
-#endif
-
+    _z_atomic_ring_clear(&fifo->_ring, free_f);
+#else
     _z_fifo_clear(&fifo->_fifo, free_f);
+#endif
 }
 
 void _z_fifo_mt_free(_z_fifo_mt_t *fifo, z_element_free_f free_f) {
@@ -66,7 +67,6 @@ void _z_fifo_mt_free(_z_fifo_mt_t *fifo, z_element_free_f free_f) {
 }
 
 z_result_t _z_fifo_mt_push(const void *elem, void *context, z_element_free_f element_free) {
-    _ZP_UNUSED(element_free);
     if (elem == NULL || context == NULL) {
         _Z_ERROR_RETURN(_Z_ERR_GENERIC);
     }
@@ -74,16 +74,13 @@ z_result_t _z_fifo_mt_push(const void *elem, void *context, z_element_free_f ele
     _z_fifo_mt_t *f = (_z_fifo_mt_t *)context;
 
 #if Z_FEATURE_MULTI_THREAD == 1
-    _Z_RETURN_IF_ERR(_z_mutex_lock(&f->_mutex))
-    while (elem != NULL) {
-        elem = _z_fifo_push(&f->_fifo, (void *)elem);
-        if (elem != NULL) {
-            _Z_RETURN_IF_ERR(_z_condvar_wait(&f->_cv_not_full, &f->_mutex))
-        } else {
-            _Z_RETURN_IF_ERR(_z_condvar_signal(&f->_cv_not_empty))
-        }
+    z_result_t ret = _z_atomic_ring_push(&f->_ring, (void *)elem);
+    if (ret == _Z_RES_CHANNEL_CLOSED) {
+        void *e = (void *)elem;
+        element_free(&e);
+        ret = _Z_RES_OK;
     }
-    _Z_RETURN_IF_ERR(_z_mutex_unlock(&f->_mutex))
+    _Z_RETURN_IF_ERR(ret)
 #else   // Z_FEATURE_MULTI_THREAD == 1
     _z_fifo_push_drop(&f->_fifo, (void *)elem, element_free);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
@@ -93,10 +90,7 @@ z_result_t _z_fifo_mt_push(const void *elem, void *context, z_element_free_f ele
 
 z_result_t _z_fifo_mt_close(_z_fifo_mt_t *fifo) {
 #if Z_FEATURE_MULTI_THREAD == 1
-    _Z_RETURN_IF_ERR(_z_mutex_lock(&fifo->_mutex))
-    fifo->is_closed = true;
-    _Z_RETURN_IF_ERR(_z_condvar_signal_all(&fifo->_cv_not_empty))
-    _Z_RETURN_IF_ERR(_z_mutex_unlock(&fifo->_mutex))
+    _Z_RETURN_IF_ERR(_z_atomic_ring_close(&fifo->_ring))
 #else
     fifo->is_closed = true;
 #endif
@@ -108,18 +102,7 @@ z_result_t _z_fifo_mt_pull(void *dst, void *context, z_element_move_f element_mo
 
 #if Z_FEATURE_MULTI_THREAD == 1
     void *src = NULL;
-    _Z_RETURN_IF_ERR(_z_mutex_lock(&f->_mutex))
-    while (src == NULL) {
-        src = _z_fifo_pull(&f->_fifo);
-        if (src == NULL) {
-            if (f->is_closed) break;
-            _Z_RETURN_IF_ERR(_z_condvar_wait(&f->_cv_not_empty, &f->_mutex))
-        } else {
-            _Z_RETURN_IF_ERR(_z_condvar_signal(&f->_cv_not_full))
-        }
-    }
-    _Z_RETURN_IF_ERR(_z_mutex_unlock(&f->_mutex))
-    if (f->is_closed && src == NULL) return _Z_RES_CHANNEL_CLOSED;
+    _Z_RETURN_IF_ERR(_z_atomic_ring_pull(&f->_ring, &src))
     element_move(dst, src);
 #else   // Z_FEATURE_MULTI_THREAD == 1
     void *src = _z_fifo_pull(&f->_fifo);
@@ -134,27 +117,42 @@ z_result_t _z_fifo_mt_pull(void *dst, void *context, z_element_move_f element_mo
 }
 
 z_result_t _z_fifo_mt_try_pull(void *dst, void *context, z_element_move_f element_move) {
-    _z_fifo_mt_t *f = (_z_fifo_mt_t *)context;
+    size_t pulled;
+    return _z_fifo_mt_try_pull_many(dst, 0, 1, &pulled, context, element_move);
+}
 
+z_result_t _z_fifo_mt_try_pull_many(void *dst, size_t elem_size, size_t len, size_t *pulled, void *context,
+                                    z_element_move_f element_move) {
+    _z_fifo_mt_t *f = (_z_fifo_mt_t *)context;
+    // Read first, elements pushed before the close are still pulled below
 #if Z_FEATURE_MULTI_THREAD == 1
-    void *src = NULL;
-    _Z_RETURN_IF_ERR(_z_mutex_lock(&f->_mutex))
-    src = _z_fifo_pull(&f->_fifo);
-    if (src != NULL) {
-        _Z_RETURN_IF_ERR(_z_condvar_signal(&f->_cv_not_full))
+    bool is_closed = _z_atomic_ring_is_closed(&f->_ring);
+#else
+    bool is_closed = f->is_closed;
+#endif
+    void *srcs[_Z_FIFO_MT_PULL_BATCH];
+    *pulled = 0;
+    while (*pulled < len) {
+        size_t batch = (len - *pulled < _Z_FIFO_MT_PULL_BATCH) ? len - *pulled : _Z_FIFO_MT_PULL_BATCH;
+#if Z_FEATURE_MULTI_THREAD == 1
+        size_t num = _z_atomic_ring_try_pull_many(&f->_ring, srcs, batch);
+#else
+        size_t num = 0;
+        while (num < batch && (srcs[num] = _z_fifo_pull(&f->_fifo)) != NULL) {
+            num++;
+        }
+#endif
+        for (size_t i = 0; i < num; i++) {
+            element_move(_z_ptr_u8_offset((uint8_t *)dst, (ptrdiff_t)((*pulled + i) * elem_size)), srcs[i]);
+        }
+        *pulled += num;
+        if (num < batch) {
+            break;
+        }
     }
-    _Z_RETURN_IF_ERR(_z_mutex_unlock(&f->_mutex))
-#else   // Z_FEATURE_MULTI_THREAD == 1
-    void *src = _z_fifo_pull(&f->_fifo);
-#endif  // Z_FEATURE_MULTI_THREAD == 1
 
-    if (src != NULL) {
-        element_move(dst, src);
-    } else if (f->is_closed) {
-        return _Z_RES_CHANNEL_CLOSED;
-    } else {
-        return _Z_RES_CHANNEL_NODATA;
+    if (*pulled > 0) {
+        return _Z_RES_OK;
     }
-
-    return _Z_RES_OK;
+    return is_closed ? _Z_RES_CHANNEL_CLOSED : _Z_RES_CHANNEL_NODATA;
 }
@@ -17,16 +17,22 @@
 #include "zenoh-pico/protocol/codec/core.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
+#include "zenoh-pico/utils/result.h"
+
+// Elements moved out of the ring per batch in _z_ring_mt_try_pull_many
+#define _Z_RING_MT_PULL_BATCH 16
 
 /*-------- Ring Buffer Multithreaded --------*/
 z_result_t _z_ring_mt_init(_z_ring_mt_t *ring, size_t capacity) {
-    _Z_RETURN_IF_ERR(_z_ring_init(&ring->_ring, capacity))
-
 #if Z_FEATURE_MULTI_THREAD == 1
-    _Z_RETURN_IF_ERR(_z_mutex_init(&ring->_mutex))
-    _Z_RETURN_IF_ERR(_z_condvar_init(&ring->_cv_not_empty))
-#endif
+    // Pushes pull the oldest element when full, so the ring can't be SPSC
+    _Z_RETURN_IF_ERR(_z_atomic_ring_init(&ring->_ring, capacity, false))
+#else
+    _Z_RETURN_IF_ERR(_z_ring_init(&ring->_ring, capacity))
     ring->is_closed = false;
+#endif
+
     return _Z_RES_OK;
 }
 
@@ -40,6 +46,7 @@ _z_ring_mt_t *_z_ring_mt_new(size_t capacity) {
     z_result_t ret = _z_ring_mt_init(ring, capacity);
     if (ret != _Z_RES_OK) {
         _Z_ERROR("_z_ring_mt_init failed: %i", ret);
+        z_free(ring);
         return NULL;
     }
 
@@ -48,16 +55,14 @@ _z_ring_mt_t *_z_ring_mt_new(size_t capacity) {
 
 void _z_ring_mt_clear(_z_ring_mt_t *ring, z_element_free_f free_f) {
 #if Z_FEATURE_MULTI_THREAD == 1
-    _z_mutex_drop(&ring->_mutex);
-    _z_condvar_drop(&ring->_cv_not_empty);
-#endif
-
+    _z_atomic_ring_clear(&ring->_ring, free_f);
+#else
     _z_ring_clear(&ring->_ring, free_f);
+#endif
 }
 
 void _z_ring_mt_free(_z_ring_mt_t *ring, z_element_free_f free_f) {
     _z_ring_mt_clear(ring, free_f);
-
     z_free(ring);
 }
 
@@ -69,24 +74,17 @@ z_result_t _z_ring_mt_push(const void *elem, void *context, z_element_free_f ele
     _z_ring_mt_t *r = (_z_ring_mt_t *)context;
 
 #if Z_FEATURE_MULTI_THREAD == 1
-    _Z_RETURN_IF_ERR(_z_mutex_lock(&r->_mutex))
-#endif
-
+    _Z_RETURN_IF_ERR(_z_atomic_ring_push_force_drop(&r->_ring, (void *)elem, element_free))
+#else   // Z_FEATURE_MULTI_THREAD == 1
     _z_ring_push_force_drop(&r->_ring, (void *)elem, element_free);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
 
-#if Z_FEATURE_MULTI_THREAD == 1
-    _Z_RETURN_IF_ERR(_z_condvar_signal(&r->_cv_not_empty))
-    _Z_RETURN_IF_ERR(_z_mutex_unlock(&r->_mutex))
-#endif
     return _Z_RES_OK;
 }
 
 z_result_t _z_ring_mt_close(_z_ring_mt_t *ring) {
 #if Z_FEATURE_MULTI_THREAD == 1
-    _Z_RETURN_IF_ERR(_z_mutex_lock(&ring->_mutex))
-    ring->is_closed = true;
-    _Z_RETURN_IF_ERR(_z_condvar_signal_all(&ring->_cv_not_empty))
-    _Z_RETURN_IF_ERR(_z_mutex_unlock(&ring->_mutex))
+    _Z_RETURN_IF_ERR(_z_atomic_ring_close(&ring->_ring))
 #else
     ring->is_closed = true;
 #endif
@@ -98,49 +96,57 @@ z_result_t _z_ring_mt_pull(void *dst, void *context, z_element_move_f element_mo
 
 #if Z_FEATURE_MULTI_THREAD == 1
     void *src = NULL;
-    _Z_RETURN_IF_ERR(_z_mutex_lock(&r->_mutex))
-    while (src == NULL) {
-        src = _z_ring_pull(&r->_ring);
-        if (src == NULL) {
-            if (r->is_closed) break;
-            _Z_RETURN_IF_ERR(_z_condvar_wait(&r->_cv_not_empty, &r->_mutex))
-        }
-    }
-    _Z_RETURN_IF_ERR(_z_mutex_unlock(&r->_mutex))
+    _Z_RETURN_IF_ERR(_z_atomic_ring_pull(&r->_ring, &src))
+    element_move(dst, src);
 #else   // Z_FEATURE_MULTI_THREAD == 1
     void *src = _z_ring_pull(&r->_ring);
-#endif  // Z_FEATURE_MULTI_THREAD == 1
-
-    if (r->is_closed && src == NULL) {
-        return _Z_RES_CHANNEL_CLOSED;
-    }
-
     if (src != NULL) {
         element_move(dst, src);
+    } else if (r->is_closed) {
+        return _Z_RES_CHANNEL_CLOSED;
     }
+#endif  // Z_FEATURE_MULTI_THREAD == 1
 
     return _Z_RES_OK;
 }
 
 z_result_t _z_ring_mt_try_pull(void *dst, void *context, z_element_move_f element_move) {
-    _z_ring_mt_t *r = (_z_ring_mt_t *)context;
+    size_t pulled;
+    return _z_ring_mt_try_pull_many(dst, 0, 1, &pulled, context, element_move);
+}
 
+z_result_t _z_ring_mt_try_pull_many(void *dst, size_t elem_size, size_t len, size_t *pulled, void *context,
+                                    z_element_move_f element_move) {
+    _z_ring_mt_t *r = (_z_ring_mt_t *)context;
+    // Read first, elements pushed before the close are still pulled below
 #if Z_FEATURE_MULTI_THREAD == 1
-    _Z_RETURN_IF_ERR(_z_mutex_lock(&r->_mutex))
+    bool is_closed = _z_atomic_ring_is_closed(&r->_ring);
+#else
+    bool is_closed = r->is_closed;
 #endif
-
-    void *src = _z_ring_pull(&r->_ring);
-
+    void *srcs[_Z_RING_MT_PULL_BATCH];
+    *pulled = 0;
+    while (*pulled < len) {
+        size_t batch = (len - *pulled < _Z_RING_MT_PULL_BATCH) ? len - *pulled : _Z_RING_MT_PULL_BATCH;
 #if Z_FEATURE_MULTI_THREAD == 1
-    _Z_RETURN_IF_ERR(_z_mutex_unlock(&r->_mutex))
+        size_t num = _z_atomic_ring_try_pull_many(&r->_ring, srcs, batch);
+#else
+        size_t num = 0;
+        while (num < batch && (srcs[num] = _z_ring_pull(&r->_ring)) != NULL) {
+            num++;
+        }
 #endif
+        for (size_t i = 0; i < num; i++) {
+            element_move(_z_ptr_u8_offset((uint8_t *)dst, (ptrdiff_t)((*pulled + i) * elem_size)), srcs[i]);
+        }
+        *pulled += num;
+        if (num < batch) {
+            break;
+        }
+    }
 
-    if (src != NULL) {
-        element_move(dst, src);
-    } else if (r->is_closed) {
-        return _Z_RES_CHANNEL_CLOSED;
-    } else {
-        return _Z_RES_CHANNEL_NODATA;
+    if (*pulled > 0) {
+        return _Z_RES_OK;
     }
-    return _Z_RES_OK;
+    return is_closed ? _Z_RES_CHANNEL_CLOSED : _Z_RES_CHANNEL_NODATA;
 }
@@ -147,3 +147,35 @@ bool _z_slice_eq(const _z_slice_t *left, const _z_slice_t *right) {
 }
 
 bool _z_slice_is_alloced(const _z_slice_t *s) { return !_z_delete_context_is_null(&s->_delete_context); }
+
+#if Z_FEATURE_RX_ZERO_COPY == 1
+/*-------- Shared Buffer --------*/
+static void _z_shared_buf_deleter(void *data, void *context) {
+    _ZP_UNUSED(data);
+    _z_shared_buf_release((_z_shared_buf_t *)context);
+}
+
+void _z_shared_buf_release(_z_shared_buf_t *buf) {
+    if (_z_atomic_size_fetch_sub(&buf->_rc, 1, _z_memory_order_acq_rel) == 1) {
+        buf->_recycle_f(buf);
+    }
+}
+
+_z_shared_buf_t *_z_slice_get_shared_buf(const _z_slice_t *s) {
+    if ((s->_delete_context.deleter == NULL) || (s->_delete_context.deleter == _z_shared_buf_deleter)) {
+        return (_z_shared_buf_t *)s->_delete_context.context;
+    }
+    return NULL;
+}
+
+bool _z_slice_share(_z_slice_t *dst, const _z_slice_t *src) {
+    _z_shared_buf_t *buf = _z_slice_get_shared_buf(src);
+    if ((buf == NULL) || (src->len == 0)) {
+        return false;
+    }
+    _z_shared_buf_acquire(buf);
+    *dst = _z_slice_from_buf_custom_deleter(src->start, src->len,
+                                            _z_delete_context_create(_z_shared_buf_deleter, (void *)buf));
+    return true;
+}
+#endif
@@ -21,8 +21,14 @@
 #include "zenoh-pico/utils/logging.h"
 
 /*-------- sortedmap --------*/
+// Any non zero value, the node levels only need to be spread, not unpredictable
+#define _Z_SORTEDMAP_SEED 0x9e3779b9u
+
 void _z_sortedmap_init(_z_sortedmap_t *map, z_element_cmp_f f_cmp) {
-    map->_vals = NULL;
+    memset(map->_head, 0, sizeof(map->_head));
+    map->_len = 0;
+    map->_level = 0;
+    map->_seed = _Z_SORTEDMAP_SEED;
     map->_f_cmp = f_cmp;
 }
 
@@ -32,27 +38,115 @@ _z_sortedmap_t _z_sortedmap_make(z_element_cmp_f f_cmp) {
     return map;
 }
 
-size_t _z_sortedmap_len(const _z_sortedmap_t *map) { return _z_list_len(map->_vals); }
+size_t _z_sortedmap_len(const _z_sortedmap_t *map) { return map->_len; }
+
+bool _z_sortedmap_is_empty(const _z_sortedmap_t *map) { return map->_len == (size_t)0; }
+
+// Next node at the given level after prev, prev being NULL for the head
+static inline _z_sortedmap_node_t *_z_sortedmap_next(const _z_sortedmap_t *map, _z_sortedmap_node_t *prev,
+                                                     size_t level) {
+    return (prev == NULL) ? map->_head[level] : prev->_next[level];
+}
+
+static inline void _z_sortedmap_set_next(_z_sortedmap_t *map, _z_sortedmap_node_t *prev, size_t level,
+                                         _z_sortedmap_node_t *node) {
+    if (prev == NULL) {
+        map->_head[level] = node;
+    } else {
+        prev->_next[level] = node;
+    }
+}
+
+// Each level holds a quarter of the nodes of the level below
+static uint8_t _z_sortedmap_random_level(_z_sortedmap_t *map) {
+    uint32_t x = map->_seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    map->_seed = x;
+    uint8_t level = 1;
+    while ((level < _Z_SORTEDMAP_MAX_LEVEL) && ((x & 0x3u) == 0)) {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+// Fill prevs with the last node before the key at each level in use, returns the node holding the key if any
+static _z_sortedmap_node_t *_z_sortedmap_find(const _z_sortedmap_t *map, const void *k,
+                                              _z_sortedmap_node_t *prevs[_Z_SORTEDMAP_MAX_LEVEL]) {
+    _z_sortedmap_node_t *prev = NULL;
+    _z_sortedmap_node_t *next = NULL;
+    for (size_t i = map->_level; i-- > 0;) {
+        next = _z_sortedmap_next(map, prev, i);
+        while ((next != NULL) && (map->_f_cmp(next->_entry._key, k) < 0)) {
+            prev = next;
+            next = next->_next[i];
+        }
+        if (prevs != NULL) {
+            prevs[i] = prev;
+        }
+    }
+    return ((next != NULL) && (map->_f_cmp(next->_entry._key, k) == 0)) ? next : NULL;
+}
 
-bool _z_sortedmap_is_empty(const _z_sortedmap_t *map) { return _z_sortedmap_len(map) == (size_t)0; }
+static void _z_sortedmap_unlink(_z_sortedmap_t *map, _z_sortedmap_node_t *node,
+                                _z_sortedmap_node_t *prevs[_Z_SORTEDMAP_MAX_LEVEL]) {
+    for (size_t i = 0; i < map->_level; i++) {
+        if (_z_sortedmap_next(map, prevs[i], i) != node) {
+            break;
+        }
+        _z_sortedmap_set_next(map, prevs[i], i, node->_next[i]);
+    }
+    while ((map->_level > 0) && (map->_head[map->_level - 1] == NULL)) {
+        map->_level--;
+    }
+    map->_len--;
+}
+
+// The entry being the first member of its node, freeing the entry frees the node
+static inline void _z_sortedmap_node_free(_z_sortedmap_node_t *node, z_element_free_f f) {
+    void *entry = &node->_entry;
+    f(&entry);
+}
+
+static _z_sortedmap_node_t *_z_sortedmap_node_new(_z_sortedmap_t *map, uint8_t *level) {
+    *level = _z_sortedmap_random_level(map);
+    size_t size = sizeof(_z_sortedmap_node_t) + (size_t)*level * sizeof(_z_sortedmap_node_t *);
+    return (_z_sortedmap_node_t *)z_malloc(size);
+}
 
 z_result_t _z_sortedmap_copy(_z_sortedmap_t *dst, const _z_sortedmap_t *src, z_element_clone_f f_c) {
     assert((dst != NULL) && (src != NULL));
-    if (src->_vals != NULL) {
-        dst->_vals = _z_list_clone(src->_vals, f_c);
-        if (dst->_vals == NULL) {
+    _z_sortedmap_init(dst, src->_f_cmp);
+    // Entries come in order, so each node is appended after the last node of its levels
+    _z_sortedmap_node_t *tails[_Z_SORTEDMAP_MAX_LEVEL] = {0};
+    for (_z_sortedmap_node_t *node = src->_head[0]; node != NULL; node = node->_next[0]) {
+        uint8_t level;
+        _z_sortedmap_node_t *copy = _z_sortedmap_node_new(dst, &level);
+        if (copy == NULL) {
             _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
         }
+        _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)f_c(&node->_entry);
+        if (entry == NULL) {
+            z_free(copy);
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+        copy->_entry = *entry;
+        z_free(entry);
+        for (size_t i = 0; i < level; i++) {
+            copy->_next[i] = NULL;
+            _z_sortedmap_set_next(dst, tails[i], i, copy);
+            tails[i] = copy;
+        }
+        dst->_level = (level > dst->_level) ? level : dst->_level;
+        dst->_len++;
     }
-    dst->_f_cmp = src->_f_cmp;
     return _Z_RES_OK;
 }
 
 _z_sortedmap_t _z_sortedmap_clone(const _z_sortedmap_t *src, z_element_clone_f f_c, z_element_free_f f_f) {
-    _z_sortedmap_t dst = {._vals = NULL, ._f_cmp = src->_f_cmp};
-    if (src->_vals == NULL) {
-        return dst;
-    }
+    _z_sortedmap_t dst = _z_sortedmap_make(src->_f_cmp);
     if (_z_sortedmap_copy(&dst, src, f_c) != _Z_RES_OK) {
         // Free the map
         _z_sortedmap_clear(&dst, f_f);
@@ -65,116 +159,83 @@ void *_z_sortedmap_insert(_z_sortedmap_t *map, void *k, void *v, z_element_free_
         return NULL;
     }
 
-    _z_list_t *prev = NULL;
-    _z_list_t *curr = map->_vals;
-
-    while (curr != NULL) {
-        _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)_z_list_value(curr);
-        int cmp = map->_f_cmp(k, entry->_key);
-
-        if (cmp == 0) {
-            if (!replace) {
-                return NULL;
-            }
-            map->_vals = _z_list_drop_element(map->_vals, prev, f_f);
-            break;
-        } else if (cmp < 0) {
-            break;  // Found insertion point
+    _z_sortedmap_node_t *prevs[_Z_SORTEDMAP_MAX_LEVEL];
+    _z_sortedmap_node_t *node = _z_sortedmap_find(map, k, prevs);
+    if (node != NULL) {
+        if (!replace) {
+            return NULL;
         }
-
-        prev = curr;
-        curr = _z_list_next(curr);
+        // The nodes before the replaced one stay the same
+        _z_sortedmap_unlink(map, node, prevs);
+        _z_sortedmap_node_free(node, f_f);
     }
 
-    _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)z_malloc(sizeof(_z_sortedmap_entry_t));
-    if (entry == NULL) {
+    uint8_t level;
+    node = _z_sortedmap_node_new(map, &level);
+    if (node == NULL) {
         return NULL;
     }
-    entry->_key = k;
-    entry->_val = v;
-
-    if (prev == NULL) {
-        map->_vals = _z_list_push(map->_vals, entry);
-        if (map->_vals == NULL) {
-            z_free(entry);
-            return NULL;
-        }
-    } else {
-        _z_list_t *list = _z_list_push_after(prev, entry);
-        if (list == NULL) {
-            z_free(entry);
-            return NULL;
-        }
+    node->_entry._key = k;
+    node->_entry._val = v;
+    for (size_t i = map->_level; i < level; i++) {
+        prevs[i] = NULL;
     }
+    map->_level = (level > map->_level) ? level : map->_level;
+    for (size_t i = 0; i < level; i++) {
+        node->_next[i] = _z_sortedmap_next(map, prevs[i], i);
+        _z_sortedmap_set_next(map, prevs[i], i, node);
+    }
+    map->_len++;
 
     return v;
 }
 
 void *_z_sortedmap_get(const _z_sortedmap_t *map, const void *k) {
-    void *ret = NULL;
-
-    if (map->_vals != NULL) {
-        _z_list_t *l = map->_vals;
-        while (l != NULL) {
-            // Check if the key matches
-            _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)_z_list_value(l);
-            if (map->_f_cmp(k, entry->_key) == 0) {
-                ret = entry->_val;
-                break;
-            }
-            l = _z_list_next(l);
-        }
-    }
-    return ret;
+    _z_sortedmap_node_t *node = _z_sortedmap_find(map, k, NULL);
+    return (node != NULL) ? node->_entry._val : NULL;
 }
 
-_z_sortedmap_entry_t *_z_sortedmap_pop_first(_z_sortedmap_t *map) {
-    _z_sortedmap_entry_t *ret = NULL;
+const _z_sortedmap_entry_t *_z_sortedmap_first(const _z_sortedmap_t *map) {
+    return (map->_head[0] != NULL) ? &map->_head[0]->_entry : NULL;
+}
 
-    if (map->_vals != NULL) {
-        _z_list_t *l = map->_vals;
-        if (l != NULL) {
-            ret = (_z_sortedmap_entry_t *)_z_list_value(l);
-            map->_vals = _z_list_drop_element(map->_vals, NULL, _z_noop_free);
-        }
+_z_sortedmap_entry_t *_z_sortedmap_pop_first(_z_sortedmap_t *map) {
+    _z_sortedmap_node_t *node = map->_head[0];
+    if (node == NULL) {
+        return NULL;
     }
-    return ret;
+    _z_sortedmap_node_t *prevs[_Z_SORTEDMAP_MAX_LEVEL] = {0};
+    _z_sortedmap_unlink(map, node, prevs);
+    // Freed by the caller along with its node
+    return &node->_entry;
 }
 
 void _z_sortedmap_remove(_z_sortedmap_t *map, const void *k, z_element_free_f f) {
-    if (map->_vals != NULL) {
-        _z_list_t *prev = NULL;
-        _z_list_t *curr = map->_vals;
-
-        while (curr != NULL) {
-            _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)_z_list_value(curr);
-            if (map->_f_cmp(k, entry->_key) == 0) {
-                map->_vals = _z_list_drop_element(map->_vals, prev, f);
-                break;
-            }
-            prev = curr;
-            curr = _z_list_next(curr);
-        }
+    _z_sortedmap_node_t *prevs[_Z_SORTEDMAP_MAX_LEVEL];
+    _z_sortedmap_node_t *node = _z_sortedmap_find(map, k, prevs);
+    if (node != NULL) {
+        _z_sortedmap_unlink(map, node, prevs);
+        _z_sortedmap_node_free(node, f);
     }
 }
 
 _z_sortedmap_iterator_t _z_sortedmap_iterator_make(const _z_sortedmap_t *map) {
     _z_sortedmap_iterator_t iter = {0};
     iter._map = map;
-    iter._list_ptr = map->_vals;
+    iter._node = map->_head[0];
     return iter;
 }
 
 bool _z_sortedmap_iterator_next(_z_sortedmap_iterator_t *iter) {
     if (!iter->_initialized) {
-        iter->_list_ptr = iter->_map->_vals;
+        iter->_node = iter->_map->_head[0];
         iter->_initialized = true;
-    } else if (iter->_list_ptr != NULL) {
-        iter->_list_ptr = _z_list_next(iter->_list_ptr);
+    } else if (iter->_node != NULL) {
+        iter->_node = iter->_node->_next[0];
     }
 
-    if (iter->_list_ptr != NULL) {
-        iter->_entry = (_z_sortedmap_entry_t *)_z_list_value(iter->_list_ptr);
+    if (iter->_node != NULL) {
+        iter->_entry = &iter->_node->_entry;
         return true;
     }
 
@@ -186,10 +247,13 @@ void *_z_sortedmap_iterator_key(const _z_sortedmap_iterator_t *iter) { return it
 void *_z_sortedmap_iterator_value(const _z_sortedmap_iterator_t *iter) { return iter->_entry->_val; }
 
 void _z_sortedmap_clear(_z_sortedmap_t *map, z_element_free_f f_f) {
-    if (map->_vals != NULL) {
-        _z_list_free(&map->_vals, f_f);
-        map->_vals = NULL;
+    _z_sortedmap_node_t *node = map->_head[0];
+    while (node != NULL) {
+        _z_sortedmap_node_t *next = node->_next[0];
+        _z_sortedmap_node_free(node, f_f);
+        node = next;
     }
+    _z_sortedmap_init(map, map->_f_cmp);
 }
 
 void _z_sortedmap_free(_z_sortedmap_t **map, z_element_free_f f) {
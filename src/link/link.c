@@ -177,8 +177,20 @@ void _z_link_free(_z_link_t **l) {
     }
 }
 
+#if defined(Z_TEST_HOOKS)
+static _z_link_recv_drop_override_fn _z_link_recv_drop_override = NULL;
+
+void _z_link_set_recv_drop_override(_z_link_recv_drop_override_fn fn) { _z_link_recv_drop_override = fn; }
+#endif
+
 size_t _z_link_recv_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, _z_slice_t *addr) {
     size_t rb = link->_read_f(link, _z_zbuf_get_wptr(zbf), _z_zbuf_writable_space_left(zbf), addr);
+#if defined(Z_TEST_HOOKS)
+    while ((rb != SIZE_MAX) && (_z_link_recv_drop_override != NULL) && (link->_cap._flow == Z_LINK_CAP_FLOW_DATAGRAM) &&
+           _z_link_recv_drop_override(link, _z_zbuf_get_wptr(zbf), rb)) {
+        rb = link->_read_f(link, _z_zbuf_get_wptr(zbf), _z_zbuf_writable_space_left(zbf), addr);
+    }
+#endif
     if (rb != SIZE_MAX) {
         _z_zbuf_set_wpos(zbf, _z_zbuf_get_wpos(zbf) + rb);
     }
@@ -195,40 +207,74 @@ size_t _z_link_recv_exact_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, size_t len
 }
 
 size_t _z_link_socket_recv_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, const _z_sys_net_socket_t socket) {
-    size_t rb = link->_read_socket_f(socket, _z_zbuf_get_wptr(zbf), _z_zbuf_writable_space_left(zbf));
+    size_t rb = link->_read_socket_f(link, socket, _z_zbuf_get_wptr(zbf), _z_zbuf_writable_space_left(zbf));
     if (rb != SIZE_MAX) {
         _z_zbuf_set_wpos(zbf, _z_zbuf_get_wpos(zbf) + rb);
     }
     return rb;
 }
 
+// Number of wbuf slices sent with a single scatter/gather write
+#define _Z_LINK_SEND_IOV_MAX 16
+
+static z_result_t _z_link_send_buf(const _z_link_t *link, const uint8_t *buf, size_t len, _z_sys_net_socket_t *socket) {
+    bool link_is_streamed = link->_cap._flow == Z_LINK_CAP_FLOW_STREAM;
+    size_t n = len;
+    do {
+        size_t wb = link->_write_f(link, buf, n, socket);
+        if ((wb == SIZE_MAX) || (wb > n)) {
+            _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+        }
+        if (link_is_streamed && wb != n) {
+            _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+        }
+        n = n - wb;
+        buf = buf + (len - n);
+    } while (n > (size_t)0);
+    return _Z_RES_OK;
+}
+
 z_result_t _z_link_send_wbuf(const _z_link_t *link, const _z_wbuf_t *wbf, _z_sys_net_socket_t *socket) {
     z_result_t ret = _Z_RES_OK;
-    bool link_is_streamed = link->_cap._flow == Z_LINK_CAP_FLOW_STREAM;
+    size_t iosli_num = _z_wbuf_len_iosli(wbf);
 
-    for (size_t i = 0; (i < _z_wbuf_len_iosli(wbf)) && (ret == _Z_RES_OK); i++) {
+    // Send all the slices at once, wrapped payloads are sent from where they are
+    if (_z_link_has_write_vec(link) && (iosli_num > 1) && (iosli_num <= _Z_LINK_SEND_IOV_MAX)) {
+        _z_socket_iovec_t iov[_Z_LINK_SEND_IOV_MAX];
+        for (size_t i = 0; i < iosli_num; i++) {
+            _z_slice_t bs = _z_iosli_to_bytes(_z_wbuf_get_iosli(wbf, i));
+            iov[i] = (_z_socket_iovec_t){._buf = bs.start, ._len = bs.len};
+        }
+        _z_socket_msg_t msg = {._iov = iov, ._iov_len = iosli_num};
+        return link->_write_vec_f(link, &msg, 1, socket);
+    }
+    for (size_t i = 0; (i < iosli_num) && (ret == _Z_RES_OK); i++) {
         _z_slice_t bs = _z_iosli_to_bytes(_z_wbuf_get_iosli(wbf, i));
-        size_t n = bs.len;
-        do {
-            size_t wb = link->_write_f(link, bs.start, n, socket);
-            if ((wb == SIZE_MAX) || (wb > n)) {
-                _Z_ERROR_LOG(_Z_ERR_TRANSPORT_TX_FAILED);
-                ret = _Z_ERR_TRANSPORT_TX_FAILED;
-                break;
-            }
-            if (link_is_streamed && wb != n) {
-                _Z_ERROR_LOG(_Z_ERR_TRANSPORT_TX_FAILED);
-                ret = _Z_ERR_TRANSPORT_TX_FAILED;
-                break;
-            }
-            n = n - wb;
-            bs.start = bs.start + (bs.len - n);
-        } while (n > (size_t)0);
+        ret = _z_link_send_buf(link, bs.start, bs.len, socket);
     }
-
     return ret;
 }
 
+/**
+ * Send several link messages. Links without scatter/gather support send the buffers one by one, so their datagram
+ * messages must be made of a single buffer.
+ */
+z_result_t _z_link_send_msgs(const _z_link_t *link, const _z_socket_msg_t *msgs, size_t count,
+                             _z_sys_net_socket_t *socket) {
+    if (_z_link_has_write_vec(link)) {
+        return link->_write_vec_f(link, msgs, count, socket);
+    }
+    for (size_t i = 0; i < count; i++) {
+        if ((link->_cap._flow == Z_LINK_CAP_FLOW_DATAGRAM) && (msgs[i]._iov_len > 1)) {
+            _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+        }
+        for (size_t j = 0; j < msgs[i]._iov_len; j++) {
+            _Z_RETURN_IF_ERR(_z_link_send_buf(link, msgs[i]._iov[j]._buf, msgs[i]._iov[j]._len, socket));
+        }
+    }
+    return _Z_RES_OK;
+}
+
 const _z_sys_net_socket_t *_z_link_get_socket(const _z_link_t *link) {
     switch (link->_type) {
 #if Z_FEATURE_LINK_TCP == 1
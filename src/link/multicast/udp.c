@@ -87,6 +87,14 @@ size_t _z_f_link_write_udp_multicast(const _z_link_t *self, const uint8_t *ptr,
     return _z_udp_multicast_write(self->_socket._udp._msock, ptr, len, self->_socket._udp._rep);
 }
 
+#if defined(ZP_PLATFORM_SOCKET_POSIX)
+static z_result_t _z_f_link_write_vec_udp_multicast(const _z_link_t *self, const _z_socket_msg_t *msgs, size_t count,
+                                                    _z_sys_net_socket_t *socket) {
+    _ZP_UNUSED(socket);
+    return _z_socket_send_msgs(&self->_socket._udp._msock, msgs, count, &self->_socket._udp._rep);
+}
+#endif
+
 size_t _z_f_link_write_all_udp_multicast(const _z_link_t *self, const uint8_t *ptr, size_t len) {
     return _z_udp_multicast_write(self->_socket._udp._msock, ptr, len, self->_socket._udp._rep);
 }
@@ -125,6 +133,9 @@ z_result_t _z_new_link_udp_multicast(_z_link_t *zl, _z_endpoint_t endpoint) {
 
     zl->_write_f = _z_f_link_write_udp_multicast;
     zl->_write_all_f = _z_f_link_write_all_udp_multicast;
+#if defined(ZP_PLATFORM_SOCKET_POSIX)
+    zl->_write_vec_f = _z_f_link_write_vec_udp_multicast;
+#endif
     zl->_read_f = _z_f_link_read_udp_multicast;
     zl->_read_exact_f = _z_f_link_read_exact_udp_multicast;
     zl->_read_socket_f = _z_noop_link_read_socket;
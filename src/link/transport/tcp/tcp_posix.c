@@ -21,6 +21,7 @@
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -292,11 +293,35 @@ static size_t _z_tcp_posix_read_exact(_z_sys_net_socket_t sock, uint8_t *ptr, si
 }
 
 static size_t _z_tcp_posix_write(_z_sys_net_socket_t sock, const uint8_t *ptr, size_t len) {
+    size_t n = 0;
+    // Peer sockets are non-blocking, wait for room instead of cutting a message in the middle of the stream
+    while (n < len) {
 #if defined(ZENOH_LINUX)
-    return (size_t)send(sock._fd, ptr, len, MSG_NOSIGNAL);
+        ssize_t wb = send(sock._fd, _z_cptr_u8_offset(ptr, (ptrdiff_t)n), len - n, MSG_NOSIGNAL);
 #else
-    return (size_t)send(sock._fd, ptr, len, 0);
+        ssize_t wb = send(sock._fd, _z_cptr_u8_offset(ptr, (ptrdiff_t)n), len - n, 0);
 #endif
+        if (wb >= (ssize_t)0) {
+            n += (size_t)wb;
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        bool failed = (errno != EAGAIN) && (errno != EWOULDBLOCK);
+        if (failed) {
+            _Z_DEBUG("Errno: %d\n", errno);
+        }
+        struct pollfd pfd = {.fd = sock._fd, .events = POLLOUT, .revents = 0};
+        if (failed || (poll(&pfd, 1, Z_CONFIG_SOCKET_TIMEOUT) <= 0)) {
+            if (n > 0) {
+                // The peer holds part of a message, nothing sent after it could be framed: close the stream
+                shutdown(sock._fd, SHUT_RDWR);
+            }
+            return SIZE_MAX;
+        }
+    }
+    return n;
 }
 
 z_result_t _z_tcp_endpoint_init(_z_sys_net_endpoint_t *ep, const char *address, const char *port) {
@@ -142,61 +142,56 @@ static size_t _z_serial_write_all(_z_sys_net_socket_t sock, const uint8_t *ptr,
     return total;
 }
 
-static size_t _z_read_serial_internal(const _z_sys_net_socket_t sock, uint8_t *header, uint8_t *ptr, size_t len) {
-    uint8_t *raw_buf = (uint8_t *)z_malloc(_Z_SERIAL_MAX_COBS_BUF_SIZE);
-    if (raw_buf == NULL) {
-        _Z_ERROR("Failed to allocate serial COBS buffer");
-        return SIZE_MAX;
-    }
+static size_t _z_read_serial_internal(const _z_serial_socket_t *sock, uint8_t *header, uint8_t *ptr, size_t len) {
+    _z_serial_buffers_t *bufs = sock->_bufs;
+    while (true) {
+        uint8_t *start = &bufs->_rx[bufs->_rx_start];
+        uint8_t *eop = (uint8_t *)memchr(&bufs->_rx[bufs->_rx_scan], 0x00, bufs->_rx_end - bufs->_rx_scan);
+        if (eop != NULL) {
+            size_t frame_len = _z_ptr_u8_diff(eop, start) + 1;
+            bufs->_rx_start += frame_len;
+            bufs->_rx_scan = bufs->_rx_start;
+            return _z_serial_msg_deserialize(start, frame_len, ptr, len, header, bufs->_rx_tmp,
+                                             _Z_SERIAL_MAX_COBS_BUF_SIZE);
+        }
 
-    size_t rb = 0;
-    while (rb < _Z_SERIAL_MAX_COBS_BUF_SIZE) {
-        size_t chunk = _z_serial_read(sock, &raw_buf[rb], 1);
-        if (chunk != 1) {
-            z_free(raw_buf);
+        size_t pending = bufs->_rx_end - bufs->_rx_start;
+        if (pending >= _Z_SERIAL_MAX_COBS_BUF_SIZE) {
+            // Longer than any frame, drop it and resynchronize on the next delimiter
+            bufs->_rx_start = 0;
+            bufs->_rx_end = 0;
+            bufs->_rx_scan = 0;
+            _Z_ERROR("Dropped serial frame longer than %u bytes", (unsigned)_Z_SERIAL_MAX_COBS_BUF_SIZE);
             return SIZE_MAX;
         }
-
-        rb++;
-        if (raw_buf[rb - 1] == (uint8_t)0x00) {
-            break;
+        // Move the start of the next frame to the front to read the rest after it
+        if (bufs->_rx_start > 0) {
+            memmove(bufs->_rx, start, pending);
+            bufs->_rx_start = 0;
+            bufs->_rx_end = pending;
         }
-    }
+        bufs->_rx_scan = bufs->_rx_end;
 
-    uint8_t *tmp_buf = (uint8_t *)z_malloc(_Z_SERIAL_MFS_SIZE);
-    if (tmp_buf == NULL) {
-        z_free(raw_buf);
-        _Z_ERROR("Failed to allocate serial MFS buffer");
-        return SIZE_MAX;
+        size_t chunk = _Z_SERIAL_RX_BUF_SIZE - bufs->_rx_end;
+        chunk = (chunk < _Z_SERIAL_RX_CHUNK_SIZE) ? chunk : _Z_SERIAL_RX_CHUNK_SIZE;
+        size_t rb = _z_serial_read(sock->_sock, &bufs->_rx[bufs->_rx_end], chunk);
+        if (rb == SIZE_MAX || rb == 0) {
+            return SIZE_MAX;
+        }
+        bufs->_rx_end += rb;
     }
-
-    size_t ret = _z_serial_msg_deserialize(raw_buf, rb, ptr, len, header, tmp_buf, _Z_SERIAL_MFS_SIZE);
-    z_free(raw_buf);
-    z_free(tmp_buf);
-    return ret;
 }
 
-static size_t _z_send_serial_internal(const _z_sys_net_socket_t sock, uint8_t header, const uint8_t *ptr, size_t len) {
-    uint8_t *tmp_buf = (uint8_t *)z_malloc(_Z_SERIAL_MFS_SIZE);
-    uint8_t *raw_buf = (uint8_t *)z_malloc(_Z_SERIAL_MAX_COBS_BUF_SIZE);
-    if ((raw_buf == NULL) || (tmp_buf == NULL)) {
-        z_free(raw_buf);
-        z_free(tmp_buf);
-        _Z_ERROR("Failed to allocate serial COBS and/or MFS buffer");
-        return SIZE_MAX;
-    }
-
-    size_t raw_len =
-        _z_serial_msg_serialize(raw_buf, _Z_SERIAL_MAX_COBS_BUF_SIZE, ptr, len, header, tmp_buf, _Z_SERIAL_MFS_SIZE);
+static size_t _z_send_serial_internal(const _z_serial_socket_t *sock, uint8_t header, const uint8_t *ptr,
+                                      size_t len) {
+    _z_serial_buffers_t *bufs = sock->_bufs;
+    size_t raw_len = _z_serial_msg_serialize(bufs->_tx, _Z_SERIAL_MAX_COBS_BUF_SIZE, ptr, len, header, bufs->_tx_tmp,
+                                             _Z_SERIAL_MFS_SIZE);
     if (raw_len == SIZE_MAX) {
-        z_free(raw_buf);
-        z_free(tmp_buf);
         return SIZE_MAX;
     }
 
-    size_t written = _z_serial_write_all(sock, raw_buf, raw_len);
-    z_free(raw_buf);
-    z_free(tmp_buf);
+    size_t written = _z_serial_write_all(sock->_sock, bufs->_tx, raw_len);
     return (written == raw_len) ? len : SIZE_MAX;
 }
 
@@ -220,6 +215,16 @@ static z_result_t _z_serial_open_impl(_z_serial_socket_t *sock, const _z_endpoin
         return ret;
     }
 
+    sock->_bufs = (_z_serial_buffers_t *)z_malloc(sizeof(_z_serial_buffers_t));
+    if (sock->_bufs == NULL) {
+        _z_serial_endpoint_cfg_clear(&cfg);
+        _Z_ERROR("Failed to allocate serial buffers");
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    sock->_bufs->_rx_start = 0;
+    sock->_bufs->_rx_end = 0;
+    sock->_bufs->_rx_scan = 0;
+
     if (cfg._from_pins) {
         ret = connect ? _z_serial_open_from_pins(&sock->_sock, cfg._txpin, cfg._rxpin, cfg._baudrate)
                       : _z_serial_listen_from_pins(&sock->_sock, cfg._txpin, cfg._rxpin, cfg._baudrate);
@@ -228,14 +233,18 @@ static z_result_t _z_serial_open_impl(_z_serial_socket_t *sock, const _z_endpoin
                       : _z_serial_listen_from_dev(&sock->_sock, cfg._dev, cfg._baudrate);
     }
 
+    if (ret != _Z_RES_OK) {
+        z_free(sock->_bufs);
+        sock->_bufs = NULL;
+    }
     if (ret != _Z_RES_OK || !connect) {
         _z_serial_endpoint_cfg_clear(&cfg);
         return ret;
     }
 
-    ret = _z_connect_serial(sock->_sock);
+    ret = _z_connect_serial(sock);
     if (ret != _Z_RES_OK) {
-        _z_serial_close(&sock->_sock);
+        _z_serial_protocol_close(sock);
     }
 
     _z_serial_endpoint_cfg_clear(&cfg);
@@ -250,9 +259,13 @@ z_result_t _z_serial_protocol_listen(_z_serial_socket_t *sock, const _z_endpoint
     return _z_serial_open_impl(sock, endpoint, false);
 }
 
-void _z_serial_protocol_close(_z_serial_socket_t *sock) { _z_serial_close(&sock->_sock); }
+void _z_serial_protocol_close(_z_serial_socket_t *sock) {
+    _z_serial_close(&sock->_sock);
+    z_free(sock->_bufs);
+    sock->_bufs = NULL;
+}
 
-z_result_t _z_connect_serial(const _z_sys_net_socket_t sock) {
+z_result_t _z_connect_serial(const _z_serial_socket_t *sock) {
     while (true) {
         uint8_t header = _Z_FLAG_SERIAL_INIT;
 
@@ -279,16 +292,16 @@ z_result_t _z_connect_serial(const _z_sys_net_socket_t sock) {
     return _Z_RES_OK;
 }
 
-size_t _z_read_serial(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
+size_t _z_read_serial(const _z_serial_socket_t *sock, uint8_t *ptr, size_t len) {
     uint8_t header;
     return _z_read_serial_internal(sock, &header, ptr, len);
 }
 
-size_t _z_send_serial(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t len) {
+size_t _z_send_serial(const _z_serial_socket_t *sock, const uint8_t *ptr, size_t len) {
     return _z_send_serial_internal(sock, 0, ptr, len);
 }
 
-size_t _z_read_exact_serial(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
+size_t _z_read_exact_serial(const _z_serial_socket_t *sock, uint8_t *ptr, size_t len) {
     size_t n = 0;
 
     do {
@@ -60,6 +60,17 @@ size_t _z_f_link_write_tcp(const _z_link_t *zl, const uint8_t *ptr, size_t len,
     }
 }
 
+#if defined(ZP_PLATFORM_SOCKET_POSIX)
+static z_result_t _z_f_link_write_vec_tcp(const _z_link_t *zl, const _z_socket_msg_t *msgs, size_t count,
+                                          _z_sys_net_socket_t *socket) {
+    if (socket != NULL) {
+        return _z_socket_write_vec(socket, msgs, count);
+    } else {
+        return _z_socket_write_vec(&zl->_socket._tcp._sock, msgs, count);
+    }
+}
+#endif
+
 size_t _z_f_link_write_all_tcp(const _z_link_t *zl, const uint8_t *ptr, size_t len) {
     return _z_tcp_write(zl->_socket._tcp._sock, ptr, len);
 }
@@ -79,7 +90,8 @@ size_t _z_f_link_read_exact_tcp(const _z_link_t *zl, uint8_t *ptr, size_t len, _
     }
 }
 
-size_t _z_f_link_tcp_read_socket(const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len) {
+size_t _z_f_link_tcp_read_socket(const _z_link_t *self, const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len) {
+    _ZP_UNUSED(self);
     return _z_tcp_read(socket, ptr, len);
 }
 
@@ -120,6 +132,9 @@ z_result_t _z_new_link_tcp(_z_link_t *zl, _z_endpoint_t *endpoint) {
 
     zl->_write_f = _z_f_link_write_tcp;
     zl->_write_all_f = _z_f_link_write_all_tcp;
+#if defined(ZP_PLATFORM_SOCKET_POSIX)
+    zl->_write_vec_f = _z_f_link_write_vec_tcp;
+#endif
     zl->_read_f = _z_f_link_read_tcp;
     zl->_read_exact_f = _z_f_link_read_exact_tcp;
     zl->_read_socket_f = _z_f_link_tcp_read_socket;
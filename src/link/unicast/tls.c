@@ -178,7 +178,9 @@ static size_t _z_f_link_read_exact_tls(const _z_link_t *self, uint8_t *ptr, size
     return n;
 }
 
-static size_t _z_f_link_tls_read_socket(const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len) {
+static size_t _z_f_link_tls_read_socket(const _z_link_t *self, const _z_sys_net_socket_t socket, uint8_t *ptr,
+                                        size_t len) {
+    _ZP_UNUSED(self);
     if (socket._tls_sock == NULL) {
         _Z_ERROR("TLS context not found in socket");
         return SIZE_MAX;
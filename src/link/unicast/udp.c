@@ -69,6 +69,17 @@ size_t _z_f_link_write_udp_unicast(const _z_link_t *self, const uint8_t *ptr, si
     }
 }
 
+#if defined(ZP_PLATFORM_SOCKET_POSIX)
+static z_result_t _z_f_link_write_vec_udp_unicast(const _z_link_t *self, const _z_socket_msg_t *msgs, size_t count,
+                                                  _z_sys_net_socket_t *socket) {
+    if (socket != NULL) {
+        return _z_socket_send_msgs(socket, msgs, count, &self->_socket._udp._rep);
+    } else {
+        return _z_socket_send_msgs(&self->_socket._udp._sock, msgs, count, &self->_socket._udp._rep);
+    }
+}
+#endif
+
 size_t _z_f_link_write_all_udp_unicast(const _z_link_t *self, const uint8_t *ptr, size_t len) {
     return _z_udp_unicast_write(self->_socket._udp._sock, ptr, len, self->_socket._udp._rep);
 }
@@ -88,7 +99,8 @@ size_t _z_f_link_read_exact_udp_unicast(const _z_link_t *self, uint8_t *ptr, siz
     }
 }
 
-size_t _z_f_link_udp_read_socket(const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len) {
+size_t _z_f_link_udp_read_socket(const _z_link_t *self, const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len) {
+    _ZP_UNUSED(self);
     return _z_udp_unicast_read(socket, ptr, len);
 }
 
@@ -115,6 +127,9 @@ z_result_t _z_new_link_udp_unicast(_z_link_t *zl, _z_endpoint_t endpoint) {
 
     zl->_write_f = _z_f_link_write_udp_unicast;
     zl->_write_all_f = _z_f_link_write_all_udp_unicast;
+#if defined(ZP_PLATFORM_SOCKET_POSIX)
+    zl->_write_vec_f = _z_f_link_write_vec_udp_unicast;
+#endif
     zl->_read_f = _z_f_link_read_udp_unicast;
     zl->_read_exact_f = _z_f_link_read_exact_udp_unicast;
     zl->_read_socket_f = _z_f_link_udp_read_socket;
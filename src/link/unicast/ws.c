@@ -77,7 +77,8 @@ size_t _z_f_link_read_exact_ws(const _z_link_t *zl, uint8_t *ptr, size_t len, _z
     return _z_ws_transport_read_exact(&zl->_socket._ws, ptr, len);
 }
 
-size_t _z_f_link_ws_read_socket(const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len) {
+size_t _z_f_link_ws_read_socket(const _z_link_t *self, const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len) {
+    _ZP_UNUSED(self);
     return _z_ws_transport_read_socket(socket, ptr, len);
 }
 
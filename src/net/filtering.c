@@ -28,23 +28,11 @@
 
 #if Z_FEATURE_INTEREST == 1
 
+// Entry of the session index of write filters, holding a reference to the filter
 typedef struct _z_write_filter_registration_t {
     _z_write_filter_ctx_rc_t ctx_rc;
-    struct _z_write_filter_registration_t *next;
 } _z_write_filter_registration_t;
 
-static bool _z_filter_target_peer_eq(const void *left, const void *right) {
-    const _z_filter_target_t *left_val = (const _z_filter_target_t *)left;
-    const _z_filter_target_t *right_val = (const _z_filter_target_t *)right;
-    return left_val->peer == right_val->peer;
-}
-
-static bool _z_filter_target_eq(const void *left, const void *right) {
-    const _z_filter_target_t *left_val = (const _z_filter_target_t *)left;
-    const _z_filter_target_t *right_val = (const _z_filter_target_t *)right;
-    return (left_val->peer == right_val->peer) && (left_val->decl_id == right_val->decl_id);
-}
-
 #if Z_FEATURE_MULTI_THREAD == 1
 static void _z_write_filter_mutex_lock(_z_write_filter_ctx_t *ctx) { _z_mutex_lock(&ctx->mutex); }
 static void _z_write_filter_mutex_unlock(_z_write_filter_ctx_t *ctx) { _z_mutex_unlock(&ctx->mutex); }
@@ -53,54 +41,224 @@ static void _z_write_filter_mutex_lock(_z_write_filter_ctx_t *ctx) { _ZP_UNUSED(
 static void _z_write_filter_mutex_unlock(_z_write_filter_ctx_t *ctx) { _ZP_UNUSED(ctx); }
 #endif
 
-static bool _z_write_filter_push_target(_z_write_filter_ctx_t *ctx, _z_transport_peer_common_t *peer, uint32_t id) {
-    _z_filter_target_t target = {.peer = (uintptr_t)peer, .decl_id = id};
-    ctx->targets = _z_filter_target_slist_push(ctx->targets, &target);
-    if (ctx->targets == NULL) {  // Allocation can fail
+static bool _z_write_filter_matches_remote(const _z_write_filter_ctx_t *ctx, const _z_declare_data_t *decl) {
+    uint8_t type =
+        ctx->target_type == _Z_WRITE_FILTER_QUERYABLE ? _Z_DECLARE_TYPE_QUERYABLE : _Z_DECLARE_TYPE_SUBSCRIBER;
+    // Whichever interest it answered, an entity is known once per peer: its declarations answering other interests
+    // replace it rather than being counted again
+    if (!ctx->allow_remote || decl->_type != type) {
         return false;
     }
-    return true;
+    // Aggregated interests are answered with declarations of their own key
+    bool intersects = ctx->is_aggregate ? _z_keyexpr_equals(&ctx->key, &decl->_key)
+                                        : _z_keyexpr_intersects(&ctx->key, &decl->_key);
+    return intersects && (!ctx->is_complete ||
+                          (decl->_complete && (ctx->is_aggregate || _z_keyexpr_includes(&decl->_key, &ctx->key))));
 }
 
-static inline bool _z_write_filter_peer_allowed(const _z_write_filter_ctx_t *ctx, _z_transport_peer_common_t *peer) {
-    return ((peer == NULL) && ctx->allow_local) || ((peer != NULL) && ctx->allow_remote);
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1 || Z_FEATURE_LOCAL_QUERYABLE == 1
+static bool _z_write_filter_matches_local(const _z_write_filter_ctx_t *ctx, const _z_keyexpr_t *key, bool is_complete,
+                                          _z_write_filter_target_type_t type) {
+    return ctx->allow_local && ctx->target_type == type &&
+           (ctx->is_complete ? (is_complete && _z_keyexpr_includes(key, &ctx->key))
+                             : _z_keyexpr_intersects(&ctx->key, key));
 }
+#endif
 
-static void _z_write_filter_ctx_update_state(_z_write_filter_ctx_t *ctx) {
-    uint8_t prev_state = ctx->state;
-    ctx->state = (ctx->targets == NULL && ctx->local_targets == 0) ? WRITE_FILTER_ACTIVE : WRITE_FILTER_OFF;
-    if (prev_state != ctx->state) {
-        _Z_DEBUG("Updated write filter state: %d", ctx->state);
-#if Z_FEATURE_MATCHING
+static inline uint8_t _z_write_filter_ctx_state(const _z_write_filter_ctx_t *ctx) {
+    return (ctx->remote_targets == 0 && ctx->local_targets == 0) ? WRITE_FILTER_ACTIVE : WRITE_FILTER_OFF;
+}
+
+#if Z_FEATURE_MATCHING == 1
+static void _z_write_filter_pending_free(void **value) {
+    if (value == NULL || *value == NULL) {
+        return;
+    }
+    _z_write_filter_ctx_rc_t *ctx = (_z_write_filter_ctx_rc_t *)(*value);
+    _z_write_filter_ctx_rc_drop(ctx);
+    z_free(ctx);
+    *value = NULL;
+}
+#endif
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - session->_mutex_inner
+ */
+static void _z_write_filter_unsafe_update_state(_z_session_t *session, _z_write_filter_registration_t *registration) {
+    _z_write_filter_ctx_t *ctx = _Z_RC_IN_VAL(&registration->ctx_rc);
+    uint8_t state = _z_write_filter_ctx_state(ctx);
+    if (state == ctx->state) {
+        return;
+    }
+    ctx->state = state;
+    _Z_DEBUG("Updated write filter state: %d", ctx->state);
+#if Z_FEATURE_MATCHING == 1
+    // The listeners are notified once for all the changes, without the session mutex held
+    if (ctx->pending) {
+        return;
+    }
+    _z_write_filter_ctx_rc_t *pending = (_z_write_filter_ctx_rc_t *)z_malloc(sizeof(_z_write_filter_ctx_rc_t));
+    if (pending == NULL) {
+        _Z_ERROR("Failed to allocate a matching status notification");
+        return;
+    }
+    *pending = _z_write_filter_ctx_rc_clone(&registration->ctx_rc);
+    _z_list_t *head = _z_list_push(session->_write_filters_pending, pending);
+    if (head == session->_write_filters_pending) {
+        _Z_ERROR("Failed to allocate a matching status notification");
+        _z_write_filter_ctx_rc_drop(pending);
+        z_free(pending);
+        return;
+    }
+    session->_write_filters_pending = head;
+    ctx->pending = true;
+#else
+    _ZP_UNUSED(session);
+#endif
+}
+
+typedef struct {
+    _z_session_t *session;
+    const _z_declare_data_t *decl;
+    const _z_keyexpr_t *key;
+    _z_write_filter_target_type_t type;
+    bool is_complete;
+    bool add;
+} _z_write_filter_match_t;
+
+static void _z_write_filter_unsafe_count(_z_write_filter_match_t *match, _z_write_filter_registration_t *registration,
+                                         size_t *count) {
+    if (match->add) {
+        (*count)++;
+    } else if (*count > 0) {
+        (*count)--;
+    }
+    _z_write_filter_unsafe_update_state(match->session, registration);
+}
+
+static z_result_t _z_write_filter_remote_candidate(void *value, void *arg) {
+    _z_write_filter_registration_t *registration = (_z_write_filter_registration_t *)value;
+    _z_write_filter_match_t *match = (_z_write_filter_match_t *)arg;
+    _z_write_filter_ctx_t *ctx = _Z_RC_IN_VAL(&registration->ctx_rc);
+    if (_z_write_filter_matches_remote(ctx, match->decl)) {
+        _z_write_filter_unsafe_count(match, registration, &ctx->remote_targets);
+    }
+    return _Z_RES_OK;
+}
+
+static void _z_write_filter_unsafe_match_remote(_z_session_t *session, const _z_declare_data_t *decl, bool add) {
+    if (decl->_type == _Z_DECLARE_TYPE_TOKEN || _z_keyexpr_trie_len(&session->_write_filters) == 0) {
+        return;
+    }
+    _z_write_filter_match_t match = {.session = session, .decl = decl, .add = add};
+    _z_keyexpr_trie_match(&session->_write_filters, &decl->_key, _z_write_filter_remote_candidate, &match);
+}
+
+void _z_write_filter_unsafe_add_remote(_z_session_t *session, const _z_declare_data_t *decl) {
+    _z_write_filter_unsafe_match_remote(session, decl, true);
+}
+
+void _z_write_filter_unsafe_remove_remote(_z_session_t *session, const _z_declare_data_t *decl) {
+    _z_write_filter_unsafe_match_remote(session, decl, false);
+}
+
+#if Z_FEATURE_MATCHING == 1
+static void _z_write_filter_ctx_notify(_z_write_filter_ctx_t *ctx) {
+    _z_write_filter_mutex_lock(ctx);
+    bool matching = ctx->state != WRITE_FILTER_ACTIVE;
+    if (matching != ctx->notified_matching) {
+        ctx->notified_matching = matching;
         _z_closure_matching_status_intmap_iterator_t it =
             _z_closure_matching_status_intmap_iterator_make(&ctx->callbacks);
-        _z_matching_status_t s = {.matching = ctx->state != WRITE_FILTER_ACTIVE};
+        _z_matching_status_t s = {.matching = matching};
         while (_z_closure_matching_status_intmap_iterator_next(&it)) {
             _z_closure_matching_status_t *c = _z_closure_matching_status_intmap_iterator_value(&it);
             c->call(&s, c->context);
         }
-#endif
     }
-}
-
-#if Z_FEATURE_LOCAL_SUBSCRIBER == 1 || Z_FEATURE_LOCAL_QUERYABLE == 1
-static void _z_write_filter_ctx_add_local_match(_z_write_filter_ctx_t *ctx) {
-    _z_write_filter_mutex_lock(ctx);
-    ctx->local_targets++;
-    _z_write_filter_ctx_update_state(ctx);
     _z_write_filter_mutex_unlock(ctx);
 }
 
-static void _z_write_filter_ctx_remove_local_match(_z_write_filter_ctx_t *ctx) {
-    _z_write_filter_mutex_lock(ctx);
-    if (ctx->local_targets > 0) {
-        ctx->local_targets--;
+void _z_write_filter_notify_pending(_z_session_t *session) {
+    if (_z_session_mutex_lock_if_open(session) != _Z_RES_OK) {
+        return;
     }
-    _z_write_filter_ctx_update_state(ctx);
-    _z_write_filter_mutex_unlock(ctx);
+    _z_list_t *pending = session->_write_filters_pending;
+    session->_write_filters_pending = NULL;
+    for (_z_list_t *it = pending; it != NULL; it = _z_list_next(it)) {
+        _Z_RC_IN_VAL((_z_write_filter_ctx_rc_t *)_z_list_value(it))->pending = false;
+    }
+    _z_session_mutex_unlock(session);
+
+    for (_z_list_t *it = pending; it != NULL; it = _z_list_next(it)) {
+        _z_write_filter_ctx_notify(_Z_RC_IN_VAL((_z_write_filter_ctx_rc_t *)_z_list_value(it)));
+    }
+    _z_list_free(&pending, _z_write_filter_pending_free);
+}
+
+void _z_write_filter_drop_pending(_z_session_t *session) {
+    _z_session_mutex_lock(session);
+    _z_list_t *pending = session->_write_filters_pending;
+    session->_write_filters_pending = NULL;
+    _z_session_mutex_unlock(session);
+    _z_list_free(&pending, _z_write_filter_pending_free);
 }
+#else
+void _z_write_filter_notify_pending(_z_session_t *session) { _ZP_UNUSED(session); }
+void _z_write_filter_drop_pending(_z_session_t *session) { _ZP_UNUSED(session); }
 #endif
 
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - session->_mutex_inner
+ */
+static void _z_write_filter_unsafe_count_known(_z_session_t *session, _z_write_filter_ctx_t *ctx) {
+    if (ctx->allow_remote) {
+        _z_declare_data_hmap_t *decls = &session->_remote_declares;
+        for (_z_declare_data_hmap_iter_t it = _z_declare_data_hmap_begin(decls); it != _z_declare_data_hmap_end(decls);
+             it = _z_declare_data_hmap_iter_next(decls, it)) {
+            if (_z_write_filter_matches_remote(ctx, &_z_declare_data_hmap_at(decls, it)->val)) {
+                ctx->remote_targets++;
+            }
+        }
+    }
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+    if (ctx->allow_local && ctx->target_type == _Z_WRITE_FILTER_SUBSCRIBER) {
+        _z_subscription_rc_slist_t *node = session->_subscriptions;
+        while (node != NULL) {
+            _z_subscription_t *sub = _Z_RC_IN_VAL(_z_subscription_rc_slist_value(node));
+            if (_z_locality_allows_local(sub->_allowed_origin) &&
+                _z_write_filter_matches_local(ctx, &sub->_key._inner, true, _Z_WRITE_FILTER_SUBSCRIBER)) {
+                ctx->local_targets++;
+            }
+            node = _z_subscription_rc_slist_next(node);
+        }
+    }
+#endif
+#if Z_FEATURE_LOCAL_QUERYABLE == 1
+    if (ctx->allow_local && ctx->target_type == _Z_WRITE_FILTER_QUERYABLE) {
+        _z_session_queryable_rc_slist_t *node = session->_local_queryable;
+        while (node != NULL) {
+            _z_session_queryable_t *queryable = _Z_RC_IN_VAL(_z_session_queryable_rc_slist_value(node));
+            if (_z_locality_allows_local(queryable->_allowed_origin) &&
+                _z_write_filter_matches_local(ctx, &queryable->_key._inner, queryable->_complete,
+                                              _Z_WRITE_FILTER_QUERYABLE)) {
+                ctx->local_targets++;
+            }
+            node = _z_session_queryable_rc_slist_next(node);
+        }
+    }
+#endif
+    ctx->state = _z_write_filter_ctx_state(ctx);
+#if Z_FEATURE_MATCHING == 1
+    // The filter has no listener yet, they learn about its status when added
+    ctx->notified_matching = ctx->state != WRITE_FILTER_ACTIVE;
+#endif
+}
+
 static z_result_t _z_write_filter_session_register(_z_session_t *session, _z_write_filter_ctx_t *ctx,
                                                    _z_write_filter_ctx_rc_t *ctx_rc) {
     _z_write_filter_registration_t *registration =
@@ -120,45 +278,16 @@ static z_result_t _z_write_filter_session_register(_z_session_t *session, _z_wri
         z_free(registration);
         return _Z_ERR_SESSION_CLOSED;
     }
-    registration->next = session->_write_filters;
-    session->_write_filters = registration;
-
-#if (Z_FEATURE_LOCAL_SUBSCRIBER == 1) || (Z_FEATURE_LOCAL_QUERYABLE == 1)
-    if (ctx->allow_local) {
-#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
-        if (ctx->target_type == _Z_WRITE_FILTER_SUBSCRIBER) {
-            _z_subscription_rc_slist_t *node = session->_subscriptions;
-            while (node != NULL) {
-                _z_subscription_t *sub = _Z_RC_IN_VAL(_z_subscription_rc_slist_value(node));
-                if (_z_locality_allows_local(sub->_allowed_origin) &&
-                    _z_keyexpr_intersects(&ctx->key, &sub->_key._inner)) {
-                    _z_write_filter_ctx_add_local_match(ctx);
-                }
-                node = _z_subscription_rc_slist_next(node);
-            }
-        }
-#endif
-#if Z_FEATURE_LOCAL_QUERYABLE == 1
-        if (ctx->target_type == _Z_WRITE_FILTER_QUERYABLE) {
-            _z_session_queryable_rc_slist_t *node = session->_local_queryable;
-            while (node != NULL) {
-                _z_session_queryable_t *queryable = _Z_RC_IN_VAL(_z_session_queryable_rc_slist_value(node));
-                if (_z_locality_allows_local(queryable->_allowed_origin)) {
-                    if (ctx->is_complete
-                            ? (queryable->_complete && _z_keyexpr_includes(&queryable->_key._inner, &ctx->key))
-                            : _z_keyexpr_intersects(&ctx->key, &queryable->_key._inner)) {
-                        _z_write_filter_ctx_add_local_match(ctx);
-                    }
-                }
-                node = _z_session_queryable_rc_slist_next(node);
-            }
-        }
-#endif
+    if (_z_keyexpr_trie_insert(&session->_write_filters, &ctx->key, registration) != _Z_RES_OK) {
+        _z_session_mutex_unlock(session);
+        _z_write_filter_ctx_rc_drop(&registration->ctx_rc);
+        z_free(registration);
+        return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
     }
-#endif
-    _z_session_mutex_unlock(session);
-
+    // The entities declared from now on are counted as they come
+    _z_write_filter_unsafe_count_known(session, ctx);
     ctx->registration = registration;
+    _z_session_mutex_unlock(session);
     return _Z_RES_OK;
 }
 
@@ -170,61 +299,17 @@ static void _z_write_filter_session_unregister(_z_write_filter_ctx_t *ctx) {
     ctx->registration = NULL;
 
     _z_session_rc_t session_rc = _z_session_weak_upgrade_if_open(&_Z_RC_IN_VAL(&registration->ctx_rc)->zn);
-    if (_Z_RC_IS_NULL(&session_rc)) {
-        _z_write_filter_ctx_rc_drop(&registration->ctx_rc);
-        z_free(registration);
-        return;
+    if (!_Z_RC_IS_NULL(&session_rc)) {
+        _z_session_t *session = _Z_RC_IN_VAL(&session_rc);
+        _z_session_mutex_lock(session);
+        _z_keyexpr_trie_remove(&session->_write_filters, &ctx->key, registration);
+        _z_session_mutex_unlock(session);
+        _z_session_rc_drop(&session_rc);
     }
-    _z_session_t *session = _Z_RC_IN_VAL(&session_rc);
-    _z_session_mutex_lock(session);
-    _z_write_filter_registration_t **iter = &session->_write_filters;
-    while (*iter != NULL && *iter != registration) {
-        iter = &((*iter)->next);
-    }
-    if (*iter != NULL) {
-        *iter = registration->next;
-    }
-    _z_session_mutex_unlock(session);
-    _z_session_rc_drop(&session_rc);
-
     _z_write_filter_ctx_rc_drop(&registration->ctx_rc);
     z_free(registration);
 }
 
-static void _z_write_filter_callback(const _z_interest_msg_t *msg, _z_transport_peer_common_t *peer, void *arg) {
-    _z_write_filter_ctx_t *ctx = (_z_write_filter_ctx_t *)arg;
-    // Process message
-    _z_write_filter_mutex_lock(ctx);
-    switch (msg->type) {
-        case _Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER:
-        case _Z_INTEREST_MSG_TYPE_DECL_QUERYABLE: {
-            // the message might be a redeclare - so we need to remove the previous one first
-            _z_filter_target_t target = {.decl_id = msg->id, .peer = (uintptr_t)peer};
-            ctx->targets = _z_filter_target_slist_drop_first_filter(ctx->targets, _z_filter_target_eq, &target);
-            bool peer_allowed = _z_write_filter_peer_allowed(ctx, peer);
-            if (peer_allowed &&
-                (!ctx->is_complete ||
-                 (msg->is_complete && (ctx->is_aggregate || _z_keyexpr_includes(msg->key, &ctx->key))))) {
-                _z_write_filter_push_target(ctx, peer, msg->id);
-            }
-            break;
-        }
-        case _Z_INTEREST_MSG_TYPE_UNDECL_SUBSCRIBER:
-        case _Z_INTEREST_MSG_TYPE_UNDECL_QUERYABLE: {
-            _z_filter_target_t target = {.decl_id = msg->id, .peer = (uintptr_t)peer};
-            ctx->targets = _z_filter_target_slist_drop_first_filter(ctx->targets, _z_filter_target_eq, &target);
-        } break;
-        case _Z_INTEREST_MSG_TYPE_CONNECTION_DROPPED: {
-            _z_filter_target_t target = {.decl_id = 0, .peer = (uintptr_t)peer};
-            ctx->targets = _z_filter_target_slist_drop_all_filter(ctx->targets, _z_filter_target_peer_eq, &target);
-        } break;
-        default:
-            break;
-    }
-    _z_write_filter_ctx_update_state(ctx);
-    _z_write_filter_mutex_unlock(ctx);
-}
-
 z_result_t _z_write_filter_create(const _z_session_rc_t *zn, _z_write_filter_t *filter,
                                   const _z_declared_keyexpr_t *keyexpr, uint8_t interest_flag, bool complete,
                                   z_locality_t locality) {
@@ -249,9 +334,13 @@ z_result_t _z_write_filter_create(const _z_session_rc_t *zn, _z_write_filter_t *
     _Z_CLEAN_RETURN_IF_ERR(_z_mutex_init(&ctx->mutex), _z_keyexpr_clear(&ke); z_free(ctx));
 #endif
     ctx->state = WRITE_FILTER_ACTIVE;
-    ctx->targets = _z_filter_target_slist_new();
+    ctx->local_targets = 0;
+    ctx->remote_targets = 0;
+    ctx->registration = NULL;
 #if Z_FEATURE_MATCHING
     _z_closure_matching_status_intmap_init(&ctx->callbacks);
+    ctx->notified_matching = false;
+    ctx->pending = false;
 #endif
     bool expects_queryable = _Z_HAS_FLAG(flags, _Z_INTEREST_FLAG_QUERYABLES);
     assert(expects_queryable != _Z_HAS_FLAG(flags, _Z_INTEREST_FLAG_SUBSCRIBERS) &&
@@ -262,14 +351,14 @@ z_result_t _z_write_filter_create(const _z_session_rc_t *zn, _z_write_filter_t *
     ctx->allow_remote = _z_locality_allows_remote(locality);
     ctx->target_type = expects_queryable ? _Z_WRITE_FILTER_QUERYABLE : _Z_WRITE_FILTER_SUBSCRIBER;
     ctx->key = ke;
+    // Known before the interest is sent, for the declarations answering it to be recognized
+    ctx->interest_id = _z_get_entity_id(_Z_RC_IN_VAL(zn));
     ctx->zn = _z_session_rc_clone_as_weak(zn);
     if (_Z_RC_IS_NULL(&ctx->zn)) {
         _z_write_filter_ctx_clear(ctx);
         z_free(ctx);
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
-    ctx->local_targets = 0;
-    ctx->registration = NULL;
     filter->ctx = _z_write_filter_ctx_rc_new(ctx);
 
     if (_Z_RC_IS_NULL(&filter->ctx)) {
@@ -277,18 +366,16 @@ z_result_t _z_write_filter_create(const _z_session_rc_t *zn, _z_write_filter_t *
         z_free(ctx);
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
-    _z_write_filter_ctx_rc_t filter_ctx_clone = _z_write_filter_ctx_rc_clone(&filter->ctx);
-    _z_void_rc_t ctx_void = _z_write_filter_ctx_rc_to_void(&filter_ctx_clone);
-    filter->_interest_id = _z_add_interest(_Z_RC_IN_VAL(zn), keyexpr, _z_write_filter_callback, flags, &ctx_void);
-    if (filter->_interest_id == 0) {
-        _z_write_filter_ctx_rc_drop(&filter->ctx);
-        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
-    }
+    filter->_interest_id = ctx->interest_id;
 
+    // The filter is indexed before its interest is sent, the session counts the declarations matching it. The
+    // interest has no callback of its own.
     _Z_CLEAN_RETURN_IF_ERR(_z_write_filter_session_register(_Z_RC_IN_VAL(zn), ctx, &filter->ctx),
-                           _z_remove_interest(_Z_RC_IN_VAL(zn), filter->_interest_id);
                            _z_write_filter_ctx_rc_drop(&filter->ctx));
-
+    _z_void_rc_t arg = _z_void_rc_null();
+    _Z_CLEAN_RETURN_IF_ERR(_z_add_interest(_Z_RC_IN_VAL(zn), ctx->interest_id, keyexpr, NULL, flags, &arg),
+                           _z_write_filter_session_unregister(ctx);
+                           _z_write_filter_ctx_rc_drop(&filter->ctx));
     return _Z_RES_OK;
 }
 
@@ -296,7 +383,6 @@ z_result_t _z_write_filter_ctx_clear(_z_write_filter_ctx_t *ctx) {
     z_result_t res = _Z_RES_OK;
     _z_write_filter_session_unregister(ctx);
     _z_write_filter_mutex_lock(ctx);
-    _z_filter_target_slist_free(&ctx->targets);
 #if Z_FEATURE_MATCHING
     _z_closure_matching_status_intmap_clear(&ctx->callbacks);
 #endif
@@ -349,7 +435,7 @@ z_result_t _z_write_filter_ctx_add_callback(_z_write_filter_ctx_t *ctx, size_t i
     *ptr = *v;
     *v = (_z_closure_matching_status_t){NULL, NULL, NULL};
     _z_write_filter_mutex_lock(ctx);
-    if (!_z_write_filter_ctx_active(ctx)) {
+    if (ctx->notified_matching) {
         _z_matching_status_t s = (_z_matching_status_t){.matching = true};
         ptr->call(&s, ptr->context);
     }
@@ -360,14 +446,14 @@ z_result_t _z_write_filter_ctx_add_callback(_z_write_filter_ctx_t *ctx, size_t i
 #endif
 
 #if Z_FEATURE_LOCAL_SUBSCRIBER == 1 || Z_FEATURE_LOCAL_QUERYABLE == 1
-static void _z_write_filter_match_free(void **value) {
-    if (value == NULL || *value == NULL) {
-        return;
+static z_result_t _z_write_filter_local_candidate(void *value, void *arg) {
+    _z_write_filter_registration_t *registration = (_z_write_filter_registration_t *)value;
+    _z_write_filter_match_t *match = (_z_write_filter_match_t *)arg;
+    _z_write_filter_ctx_t *ctx = _Z_RC_IN_VAL(&registration->ctx_rc);
+    if (_z_write_filter_matches_local(ctx, match->key, match->is_complete, match->type)) {
+        _z_write_filter_unsafe_count(match, registration, &ctx->local_targets);
     }
-    _z_write_filter_ctx_rc_t *ctx = (_z_write_filter_ctx_rc_t *)(*value);
-    _z_write_filter_ctx_rc_drop(ctx);
-    z_free(ctx);
-    *value = NULL;
+    return _Z_RES_OK;
 }
 
 static void _z_write_filter_notify_local_entity(_z_session_t *session, const _z_keyexpr_t *key,
@@ -380,45 +466,11 @@ static void _z_write_filter_notify_local_entity(_z_session_t *session, const _z_
     if (_z_session_mutex_lock_if_open(session) != _Z_RES_OK) {
         return;
     }
-
-    _z_list_t *matches = NULL;
-    for (_z_write_filter_registration_t *registration = session->_write_filters; registration != NULL;
-         registration = registration->next) {
-        _z_write_filter_ctx_t *registration_ctx = _Z_RC_IN_VAL(&registration->ctx_rc);
-        if (!(registration_ctx->allow_local &&
-              (registration_ctx->is_complete ? (is_complete && _z_keyexpr_includes(key, &registration_ctx->key))
-                                             : _z_keyexpr_intersects(&registration_ctx->key, key)))) {
-            continue;
-        }
-        if (registration_ctx->target_type != source_type) {
-            continue;
-        }
-        _z_write_filter_ctx_rc_t *ctx_clone = (_z_write_filter_ctx_rc_t *)z_malloc(sizeof(_z_write_filter_ctx_rc_t));
-        if (ctx_clone == NULL) {
-            _z_list_free(&matches, _z_write_filter_match_free);
-            _z_session_mutex_unlock(session);
-            return;
-        }
-        *ctx_clone = _z_write_filter_ctx_rc_clone(&registration->ctx_rc);
-        _z_list_t *new_head = _z_list_push(matches, ctx_clone);
-        assert(new_head != matches && "Failed to allocate write-filter match node");
-        matches = new_head;
-    }
-
+    _z_write_filter_match_t match = {
+        .session = session, .key = key, .type = source_type, .is_complete = is_complete, .add = add};
+    _z_keyexpr_trie_match(&session->_write_filters, key, _z_write_filter_local_candidate, &match);
     _z_session_mutex_unlock(session);
-
-    _z_list_t *it = matches;
-    while (it != NULL) {
-        _z_write_filter_ctx_rc_t *ctx_clone = (_z_write_filter_ctx_rc_t *)_z_list_value(it);
-        _z_write_filter_ctx_t *matched_ctx = _Z_RC_IN_VAL(ctx_clone);
-        if (add) {
-            _z_write_filter_ctx_add_local_match(matched_ctx);
-        } else {
-            _z_write_filter_ctx_remove_local_match(matched_ctx);
-        }
-        it = _z_list_next(it);
-    }
-    _z_list_free(&matches, _z_write_filter_match_free);
+    _z_write_filter_notify_pending(session);
 }
 
 void _z_write_filter_notify_subscriber(_z_session_t *session, const _z_keyexpr_t *key, z_locality_t allowed_origin,
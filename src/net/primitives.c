@@ -26,6 +26,7 @@
 #include "zenoh-pico/net/matching.h"
 #include "zenoh-pico/net/sample.h"
 #include "zenoh-pico/net/session.h"
+#include "zenoh-pico/protocol/codec/network.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/declarations.h"
 #include "zenoh-pico/protocol/definitions/interest.h"
@@ -131,6 +132,11 @@ z_result_t _z_declare_publisher(_z_publisher_t *publisher, const _z_session_rc_t
     publisher->_filter = (_z_write_filter_t){0};
     _Z_CLEAN_RETURN_IF_ERR(_z_declared_keyexpr_declare(zn, &publisher->_key, keyexpr),
                            _z_undeclare_publisher(publisher));
+    // The messages of the publisher only differ by their body
+    _z_wireexpr_t wireexpr = _z_declared_keyexpr_alias_to_wire(&publisher->_key, _Z_RC_IN_VAL(zn));
+    _z_n_qos_t qos = _z_n_qos_make(is_express, congestion_control == Z_CONGESTION_CONTROL_BLOCK, priority);
+    _Z_CLEAN_RETURN_IF_ERR(_z_push_prefix_encode(&publisher->_push_prefix, &wireexpr, qos),
+                           _z_undeclare_publisher(publisher));
     return _Z_RES_OK;
 }
 
@@ -142,20 +148,21 @@ z_result_t _z_undeclare_publisher(_z_publisher_t *pub) {
     _z_declared_keyexpr_clear(&pub->_key);
     _z_session_weak_drop(&pub->_zn);
     _z_encoding_clear(&pub->_encoding);
+    _z_slice_clear(&pub->_push_prefix);
     *pub = _z_publisher_null();
     return _Z_RES_OK;
 }
 
 /*------------------ Write ------------------*/
-z_result_t _z_write(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, const _z_bytes_t *payload,
-                    const _z_encoding_t *encoding, z_sample_kind_t kind, z_congestion_control_t cong_ctrl,
-                    z_priority_t priority, bool is_express, const _z_timestamp_t *timestamp,
-                    const _z_bytes_t *attachment, z_reliability_t reliability, const _z_source_info_t *source_info,
-                    z_locality_t allowed_destination) {
+static z_result_t __z_write(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, const _z_slice_t *push_prefix,
+                            const _z_bytes_t *payload, const _z_encoding_t *encoding, z_sample_kind_t kind,
+                            z_congestion_control_t cong_ctrl, z_priority_t priority, bool is_express,
+                            const _z_timestamp_t *timestamp, const _z_bytes_t *attachment, z_reliability_t reliability,
+                            const _z_source_info_t *source_info, z_locality_t allowed_destination) {
     z_result_t ret = _Z_RES_OK;
     _z_qos_t qos = _z_n_qos_make(is_express, cong_ctrl == Z_CONGESTION_CONTROL_BLOCK, priority);
-    _z_wireexpr_t wireexpr = _z_declared_keyexpr_alias_to_wire(keyexpr, zn);
     if (_z_locality_allows_remote(allowed_destination)) {
+        _z_wireexpr_t wireexpr = _z_declared_keyexpr_alias_to_wire(keyexpr, zn);
         _z_network_message_t msg;
         switch (kind) {
             case Z_SAMPLE_KIND_PUT:
@@ -168,6 +175,7 @@ z_result_t _z_write(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, cons
             default:
                 _Z_ERROR_RETURN(_Z_ERR_GENERIC);
         }
+        msg._body._push._prefix = push_prefix;
         if (_z_send_n_msg(zn, &msg, reliability, cong_ctrl, NULL) != _Z_RES_OK) {
             _Z_ERROR_LOG(_Z_ERR_TRANSPORT_TX_FAILED);
             ret = _Z_ERR_TRANSPORT_TX_FAILED;
@@ -182,38 +190,54 @@ z_result_t _z_write(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, cons
 #endif
     return ret;
 }
+
+z_result_t _z_write(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, const _z_bytes_t *payload,
+                    const _z_encoding_t *encoding, z_sample_kind_t kind, z_congestion_control_t cong_ctrl,
+                    z_priority_t priority, bool is_express, const _z_timestamp_t *timestamp,
+                    const _z_bytes_t *attachment, z_reliability_t reliability, const _z_source_info_t *source_info,
+                    z_locality_t allowed_destination) {
+    return __z_write(zn, keyexpr, NULL, payload, encoding, kind, cong_ctrl, priority, is_express, timestamp,
+                     attachment, reliability, source_info, allowed_destination);
+}
+
+z_result_t _z_publisher_write(_z_session_t *zn, const _z_publisher_t *pub, const _z_bytes_t *payload,
+                              const _z_encoding_t *encoding, z_sample_kind_t kind, const _z_timestamp_t *timestamp,
+                              const _z_bytes_t *attachment, z_reliability_t reliability,
+                              const _z_source_info_t *source_info) {
+    const _z_slice_t *push_prefix = _z_slice_check(&pub->_push_prefix) ? &pub->_push_prefix : NULL;
+    return __z_write(zn, &pub->_key, push_prefix, payload, encoding, kind, pub->_congestion_control, pub->_priority,
+                     pub->_is_express, timestamp, attachment, reliability, source_info, pub->_allowed_destination);
+}
 #endif
 
 #if Z_FEATURE_SUBSCRIPTION == 1
 /*------------------ Subscriber Declaration ------------------*/
-z_result_t _z_register_subscriber(uint32_t *sub_id, const _z_session_rc_t *zn, const _z_declared_keyexpr_t *keyexpr,
-                                  _z_closure_sample_callback_t callback, _z_drop_handler_t dropper, void *arg,
-                                  z_locality_t allowed_origin, const _z_sync_group_t *callback_drop_sync_group) {
-    _z_subscription_t s = {0};
-    s._id = _z_get_entity_id(_Z_RC_IN_VAL(zn));
-    s._callback = callback;
-    s._dropper = dropper;
-    s._arg = arg;
-    s._allowed_origin = allowed_origin;
-    _Z_CLEAN_RETURN_IF_ERR(_z_declared_keyexpr_declare_non_wild_prefix(zn, &s._key, keyexpr),
-                           _z_subscription_clear(&s));
+// Register the subscription s, whose callback is set, and declare it. s is cleared on failure.
+static z_result_t __z_register_subscriber(uint32_t *sub_id, const _z_session_rc_t *zn,
+                                          const _z_declared_keyexpr_t *keyexpr, _z_subscription_t *s,
+                                          const _z_sync_group_t *callback_drop_sync_group) {
+    s->_id = _z_get_entity_id(_Z_RC_IN_VAL(zn));
+    _Z_CLEAN_RETURN_IF_ERR(_z_declared_keyexpr_declare_non_wild_prefix(zn, &s->_key, keyexpr),
+                           _z_subscription_clear(s));
     _Z_CLEAN_RETURN_IF_ERR(
-        _z_sync_group_create_notifier(&_Z_RC_IN_VAL(zn)->_callback_drop_sync_group, &s._session_callback_drop_notifier),
-        _z_subscription_clear(&s));
+        _z_sync_group_create_notifier(&_Z_RC_IN_VAL(zn)->_callback_drop_sync_group, &s->_session_callback_drop_notifier),
+        _z_subscription_clear(s));
     if (callback_drop_sync_group != NULL) {
         _Z_CLEAN_RETURN_IF_ERR(
-            _z_sync_group_create_notifier(callback_drop_sync_group, &s._subscriber_callback_drop_notifier),
-            _z_subscription_clear(&s));
+            _z_sync_group_create_notifier(callback_drop_sync_group, &s->_subscriber_callback_drop_notifier),
+            _z_subscription_clear(s));
     }
 
-    _z_subscription_rc_t sp_s = _z_register_subscription(_Z_RC_IN_VAL(zn), _Z_SUBSCRIBER_KIND_SUBSCRIBER, &s);
+    uint32_t id = s->_id;
+    z_locality_t allowed_origin = s->_allowed_origin;
+    _z_subscription_rc_t sp_s = _z_register_subscription(_Z_RC_IN_VAL(zn), _Z_SUBSCRIBER_KIND_SUBSCRIBER, s);
     if (_Z_RC_IS_NULL(&sp_s)) {
-        _z_subscription_clear(&s);
+        _z_subscription_clear(s);
         return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
     }
     if (_z_locality_allows_remote(allowed_origin)) {
         _z_wireexpr_t wire_expr = _z_declared_keyexpr_alias_to_wire(keyexpr, _Z_RC_IN_VAL(zn));
-        _z_declaration_t declaration = _z_make_decl_subscriber(&wire_expr, s._id);
+        _z_declaration_t declaration = _z_make_decl_subscriber(&wire_expr, id);
         _z_network_message_t n_msg;
         _z_n_msg_make_declare(&n_msg, declaration, _z_optional_id_make_none());
         z_result_t res = _z_send_declare(_Z_RC_IN_VAL(zn), &n_msg);
@@ -222,12 +246,23 @@ z_result_t _z_register_subscriber(uint32_t *sub_id, const _z_session_rc_t *zn, c
             return res;
         }
     }
-    *sub_id = s._id;
+    *sub_id = id;
     _z_subscription_rc_drop(&sp_s);  // we do not keep this data for the time being inside subscriber, and rc copy is
                                      // still stored inside the session
     return _Z_RES_OK;
 }
 
+z_result_t _z_register_subscriber(uint32_t *sub_id, const _z_session_rc_t *zn, const _z_declared_keyexpr_t *keyexpr,
+                                  _z_closure_sample_callback_t callback, _z_drop_handler_t dropper, void *arg,
+                                  z_locality_t allowed_origin, const _z_sync_group_t *callback_drop_sync_group) {
+    _z_subscription_t s = {0};
+    s._callback = callback;
+    s._dropper = dropper;
+    s._arg = arg;
+    s._allowed_origin = allowed_origin;
+    return __z_register_subscriber(sub_id, zn, keyexpr, &s, callback_drop_sync_group);
+}
+
 z_result_t _z_declare_subscriber(_z_subscriber_t *subscriber, const _z_session_rc_t *zn,
                                  const _z_declared_keyexpr_t *keyexpr, _z_closure_sample_callback_t callback,
                                  _z_drop_handler_t dropper, void *arg, z_locality_t allowed_origin) {
@@ -240,6 +275,39 @@ z_result_t _z_declare_subscriber(_z_subscriber_t *subscriber, const _z_session_r
     return _Z_RES_OK;
 }
 
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+z_result_t _z_register_batched_subscriber(uint32_t *sub_id, const _z_session_rc_t *zn,
+                                          const _z_declared_keyexpr_t *keyexpr,
+                                          _z_closure_sample_batch_callback_t callback, _z_drop_handler_t dropper,
+                                          void *arg, z_locality_t allowed_origin, size_t max_samples,
+                                          const _z_sync_group_t *callback_drop_sync_group) {
+    _z_subscription_t s = {0};
+    s._dropper = dropper;
+    s._arg = arg;
+    s._allowed_origin = allowed_origin;
+    s._batch = _z_subscription_batch_new(callback, max_samples);
+    if (s._batch == NULL) {
+        _z_subscription_clear(&s);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return __z_register_subscriber(sub_id, zn, keyexpr, &s, callback_drop_sync_group);
+}
+
+z_result_t _z_declare_batched_subscriber(_z_subscriber_t *subscriber, const _z_session_rc_t *zn,
+                                         const _z_declared_keyexpr_t *keyexpr,
+                                         _z_closure_sample_batch_callback_t callback, _z_drop_handler_t dropper,
+                                         void *arg, z_locality_t allowed_origin, size_t max_samples) {
+    *subscriber = _z_subscriber_null();
+    subscriber->_zn = _z_session_rc_clone_as_weak(zn);
+    z_result_t ret = _z_sync_group_create(&subscriber->_callback_drop_sync_group);
+    _Z_SET_IF_OK(ret, _z_register_batched_subscriber(&subscriber->_entity_id, zn, keyexpr, callback, dropper, arg,
+                                                     allowed_origin, max_samples,
+                                                     &subscriber->_callback_drop_sync_group));
+    _Z_CLEAN_RETURN_IF_ERR(ret, _z_subscriber_clear(subscriber));
+    return _Z_RES_OK;
+}
+#endif
+
 z_result_t _z_undeclare_subscriber(_z_subscriber_t *sub) {
     if (sub == NULL || _Z_RC_IS_NULL(&sub->_zn)) {
         _Z_ERROR_RETURN(_Z_ERR_ENTITY_UNKNOWN);
@@ -562,7 +630,7 @@ z_result_t _z_query(const _z_session_rc_t *session, _z_optional_id_t querier_id,
     z_result_t ret = _Z_RES_OK;
     _Z_CLEAN_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn), _z_keyexpr_clear(&ke_query);
                            _z_drop_handler_execute(dropper, arg));
-    _z_pending_query_t *pq = _z_unsafe_register_pending_query(zn);
+    _z_pending_query_t *pq = _z_unsafe_register_pending_query(zn, timeout_ms);
     if (pq == NULL) {
         _z_session_mutex_unlock(zn);
         _z_keyexpr_clear(&ke_query);
@@ -581,8 +649,6 @@ z_result_t _z_query(const _z_session_rc_t *session, _z_optional_id_t querier_id,
     pq->_pending_replies = NULL;
     pq->_allowed_destination = allowed_destination;
     pq->_arg = arg;
-    pq->_timeout = timeout_ms;
-    pq->_start_time = z_clock_now();
     pq->_remaining_finals = (uint32_t)remaining_finals;
 #ifdef Z_FEATURE_UNSTABLE_API
     ret = _z_pending_query_register_cancellation(pq, opt_cancellation_token, session);
@@ -590,6 +656,7 @@ z_result_t _z_query(const _z_session_rc_t *session, _z_optional_id_t querier_id,
     _ZP_UNUSED(opt_cancellation_token);
 #endif
     _z_session_mutex_unlock(zn);
+    _z_pending_query_arm_timer(zn);
     // Send query message
     _z_slice_view_t params =
         (parameters == NULL) ? _z_slice_view_null() : _z_slice_view_make((const uint8_t *)parameters, parameters_len);
@@ -614,17 +681,17 @@ z_result_t _z_query(const _z_session_rc_t *session, _z_optional_id_t querier_id,
 
 #if Z_FEATURE_INTEREST == 1
 /*------------------ Interest Declaration ------------------*/
-uint32_t _z_add_interest(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, _z_interest_handler_t callback,
-                         uint8_t flags, _z_void_rc_t *arg) {
+z_result_t _z_add_interest(_z_session_t *zn, uint32_t id, const _z_declared_keyexpr_t *keyexpr,
+                           _z_interest_handler_t callback, uint8_t flags, _z_void_rc_t *arg) {
     _z_session_interest_t intr;
-    intr._id = _z_get_entity_id(zn);
+    intr._id = id;
     intr._flags = flags;
     intr._callback = callback;
     intr._arg = *arg;
     *arg = _z_void_rc_null();
     if (_z_keyexpr_copy(&intr._key, &keyexpr->_inner) != _Z_RES_OK) {
         _z_void_rc_drop(&intr._arg);
-        return 0;
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
 
     // Create interest entry, stored at session-level, do not drop it by the end of this function.
@@ -632,7 +699,7 @@ uint32_t _z_add_interest(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr,
     if (sintr == NULL) {
         _z_void_rc_drop(&intr._arg);
         _z_keyexpr_clear(&intr._key);
-        return 0;
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
     // Build the interest message to send on the wire (only needed in client mode or multicast transport or when
     // connected to a router in peer mode)
@@ -647,12 +714,14 @@ uint32_t _z_add_interest(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr,
         _z_n_msg_make_interest(&n_msg, interest);
         if (_z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) != _Z_RES_OK) {
             _z_unregister_interest(zn, sintr);
-            return 0;
+            _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
         }
     }
     // Replay declares
-    _z_interest_replay_declare(zn, &intr);
-    return intr._id;
+    if (callback != NULL) {
+        _z_interest_replay_declare(zn, &intr);
+    }
+    return _Z_RES_OK;
 }
 
 z_result_t _z_remove_interest(_z_session_t *zn, uint32_t interest_id) {
@@ -34,6 +34,7 @@
 #include "zenoh-pico/transport/multicast.h"
 #include "zenoh-pico/transport/multicast/lease.h"
 #include "zenoh-pico/transport/multicast/read.h"
+#include "zenoh-pico/transport/multicast/repair.h"
 #include "zenoh-pico/transport/raweth/read.h"
 #include "zenoh-pico/transport/transport.h"
 #include "zenoh-pico/transport/unicast.h"
@@ -662,7 +663,11 @@ _z_config_t *_z_info(const _z_session_t *zn) {
     return ps;
 }
 
-z_result_t _zp_read(_z_session_t *zn, bool single_read) { return _z_read(&zn->_tp, single_read); }
+z_result_t _zp_read(_z_session_t *zn, bool single_read) {
+    z_result_t ret = _z_read(&zn->_tp, single_read);
+    _z_flush_subscription_batches(zn);
+    return ret;
+}
 
 z_result_t _zp_send_keep_alive(_z_session_t *zn) { return _z_send_keep_alive(&zn->_tp); }
 
@@ -681,6 +686,11 @@ z_result_t _zp_start_transport_tasks(_z_session_t *zn) {
 #if Z_FEATURE_UNICAST_PEER == 1
             tasks[_Z_TRANSPORT_TASK_ADD_PEERS] = _zp_add_peers_task_fn;
 #endif
+#if Z_FEATURE_AUTO_BATCHING == 1
+            if (_z_auto_batching_is_active(&tc->_auto_batching)) {
+                tasks[_Z_TRANSPORT_TASK_AUTO_BATCHING] = _zp_auto_batching_task_fn;
+            }
+#endif
 
             for (size_t i = 0; i < _ZP_ARRAY_SIZE(tasks); i++) {
                 if (tasks[i] == NULL) continue;
@@ -707,6 +717,14 @@ z_result_t _zp_start_transport_tasks(_z_session_t *zn) {
             tasks[_Z_TRANSPORT_TASK_LEASE] = _zp_multicast_lease_task_fn;
             tasks[_Z_TRANSPORT_TASK_READ] = _zp_multicast_read_task_fn;
             tasks[_Z_TRANSPORT_TASK_SEND_JOIN] = _zp_multicast_send_join_task_fn;
+#if Z_FEATURE_AUTO_BATCHING == 1
+            if (_z_auto_batching_is_active(&tc->_auto_batching)) {
+                tasks[_Z_TRANSPORT_TASK_AUTO_BATCHING] = _zp_auto_batching_task_fn;
+            }
+#endif
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+            tasks[_Z_TRANSPORT_TASK_REPAIR] = _zp_multicast_repair_task_fn;
+#endif
 
             for (size_t i = 0; i < _ZP_ARRAY_SIZE(tasks); i++) {
                 if (tasks[i] == NULL) continue;
@@ -350,11 +350,15 @@ z_result_t _z_value_encode_ext(_z_wbuf_t *wbf, const _z_value_t *value) {
     return _z_value_encode(wbf, value);
 }
 
+size_t _z_value_ext_encoded_len(const _z_value_t *value) {
+    return _z_buf_prefixed_len(_z_encoding_len(&value->encoding) + _z_bytes_len(&value->payload));
+}
+
 z_result_t _z_value_decode(_z_value_view_t *value, _z_zbuf_t *zbf) {
     *value = _z_value_view_null();
     _z_encoding_view_t view_encoding;
     _Z_RETURN_IF_ERR(_z_encoding_decode(&view_encoding, zbf));
-    _z_slice_t view_slice = _z_slice_alias_buf(_z_zbuf_get_rptr(zbf), _z_zbuf_readable_len(zbf));
+    _z_slice_t view_slice = _z_zbuf_alias_slice(zbf, _z_zbuf_readable_len(zbf));
     _z_bytes_view_t view_payload = _z_bytes_view_from_slice(&view_slice);
     _z_value_view_create_from_data(value, _z_bytes_view_deref(&view_payload), _z_encoding_view_deref(&view_encoding));
     return _Z_RES_OK;
@@ -175,6 +175,61 @@ z_result_t _z_declaration_encode(_z_wbuf_t *wbf, const _z_declaration_t *decl) {
     }
     return ret;
 }
+static size_t _z_decl_ext_keyexpr_encoded_len(const _z_wireexpr_t *ke) {
+    size_t kelen = _z_wireexpr_has_suffix(ke) ? _z_string_view_len(&ke->_suffix) : 0;
+    return 1 + _z_buf_prefixed_len(1 + kelen + _z_zint_len(ke->_id));
+}
+static size_t _z_decl_commons_encoded_len(uint32_t id, const _z_wireexpr_t *keyexpr) {
+    return 1 + _z_zint_len(id) + _z_wireexpr_encoded_len(_z_wireexpr_has_suffix(keyexpr), keyexpr);
+}
+static size_t _z_undecl_encoded_len(_z_zint_t decl_id, const _z_wireexpr_t *ke) {
+    size_t len = 1 + _z_zint_len(decl_id);
+    if (_z_wireexpr_check(ke)) {
+        len += _z_decl_ext_keyexpr_encoded_len(ke);
+    }
+    return len;
+}
+static size_t _z_decl_queryable_encoded_len(const _z_decl_queryable_t *decl) {
+    size_t len = _z_decl_commons_encoded_len(decl->_id, &decl->_keyexpr);
+    if (decl->_ext_queryable_info._complete || (decl->_ext_queryable_info._distance != 0)) {
+        uint64_t value = (uint64_t)(decl->_ext_queryable_info._complete ? 0x01 : 0) |
+                         (uint64_t)decl->_ext_queryable_info._distance << 8;
+        len += 1 + _z_zint_len(value);
+    }
+    return len;
+}
+
+size_t _z_declaration_encoded_len(const _z_declaration_t *decl) {
+    switch (decl->_tag) {
+        case _Z_DECL_KEXPR: {
+            const _z_decl_kexpr_t *kexpr = &decl->_body._decl_kexpr;
+            return 1 + _z_zint_len(kexpr->_id) +
+                   _z_wireexpr_encoded_len(_z_wireexpr_has_suffix(&kexpr->_keyexpr), &kexpr->_keyexpr);
+        }
+        case _Z_UNDECL_KEXPR:
+            return 1 + _z_zint_len(decl->_body._undecl_kexpr._id);
+        case _Z_DECL_SUBSCRIBER:
+            return _z_decl_commons_encoded_len(decl->_body._decl_subscriber._id,
+                                               &decl->_body._decl_subscriber._keyexpr);
+        case _Z_UNDECL_SUBSCRIBER:
+            return _z_undecl_encoded_len(decl->_body._undecl_subscriber._id,
+                                         &decl->_body._undecl_subscriber._ext_keyexpr);
+        case _Z_DECL_QUERYABLE:
+            return _z_decl_queryable_encoded_len(&decl->_body._decl_queryable);
+        case _Z_UNDECL_QUERYABLE:
+            return _z_undecl_encoded_len(decl->_body._undecl_queryable._id,
+                                         &decl->_body._undecl_queryable._ext_keyexpr);
+        case _Z_DECL_TOKEN:
+            return _z_decl_commons_encoded_len(decl->_body._decl_token._id, &decl->_body._decl_token._keyexpr);
+        case _Z_UNDECL_TOKEN:
+            return _z_undecl_encoded_len(decl->_body._undecl_token._id, &decl->_body._undecl_token._ext_keyexpr);
+        case _Z_DECL_FINAL:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
 z_result_t _z_decl_kexpr_decode(_z_decl_kexpr_t *decl, _z_zbuf_t *zbf, uint8_t header) {
     *decl = _z_decl_kexpr_null();
     _Z_RETURN_IF_ERR(_z_zint16_decode(&decl->_id, zbf));
@@ -68,6 +68,19 @@ z_result_t _z_interest_encode(_z_wbuf_t *wbf, const _z_interest_t *interest, boo
     return _Z_RES_OK;
 }
 
+size_t _z_interest_encoded_len(const _z_interest_t *interest, bool is_final) {
+    size_t len = _z_zint_len(interest->_id);
+    if (is_final) {
+        return len;
+    }
+    // Flags
+    len += 1;
+    if (_Z_HAS_FLAG(interest->flags, _Z_INTEREST_FLAG_RESTRICTED)) {
+        len += _z_wireexpr_encoded_len(_z_wireexpr_has_suffix(&interest->_keyexpr), &interest->_keyexpr);
+    }
+    return len;
+}
+
 z_result_t _z_interest_decode(_z_interest_t *interest, _z_zbuf_t *zbf, bool is_final, bool has_ext) {
     // Decode id
     _Z_RETURN_IF_ERR(_z_zint32_decode(&interest->_id, zbf));
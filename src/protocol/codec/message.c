@@ -70,8 +70,11 @@ z_result_t _z_id_encode_as_slice(_z_wbuf_t *wbf, const _z_id_t *id) {
 z_result_t _z_id_decode_as_slice(_z_id_t *id, _z_zbuf_t *zbf) {
     z_result_t ret = _Z_RES_OK;
     uint8_t len = _z_zbuf_read(zbf);
+    if ((len > sizeof(id->id)) || (_z_zbuf_readable_len(zbf) < len)) {
+        _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+    }
     _z_zbuf_read_bytes(zbf, id->id, 0, len);
-    memset(id->id + len, 0, 16 - len);
+    memset(id->id + len, 0, sizeof(id->id) - len);
     return ret;
 }
 
@@ -87,11 +90,17 @@ z_result_t _z_timestamp_encode(_z_wbuf_t *wbf, const _z_timestamp_t *ts) {
 }
 z_result_t _z_timestamp_encode_ext(_z_wbuf_t *wbf, const _z_timestamp_t *ts) {
     // Encode extension size then timestamp
-    size_t ext_size = (size_t)(_z_zint_len(ts->time) + 1 + _z_id_len(ts->id));
-    _Z_RETURN_IF_ERR(_z_zsize_encode(wbf, ext_size));
+    _Z_RETURN_IF_ERR(_z_zsize_encode(wbf, _z_timestamp_encoded_len(ts)));
     return _z_timestamp_encode(wbf, ts);
 }
 
+size_t _z_timestamp_encoded_len(const _z_timestamp_t *ts) {
+    return _z_zint_len(ts->time) + _z_buf_prefixed_len(_z_id_len(ts->id));
+}
+size_t _z_timestamp_ext_encoded_len(const _z_timestamp_t *ts) {
+    return _z_buf_prefixed_len(_z_timestamp_encoded_len(ts));
+}
+
 z_result_t _z_timestamp_decode(_z_timestamp_t *ts, _z_zbuf_t *zbf) {
     _Z_DEBUG("Decoding _TIMESTAMP");
     z_result_t ret = _Z_RES_OK;
@@ -117,6 +126,14 @@ z_result_t _z_wireexpr_encode(_z_wbuf_t *wbf, bool has_suffix, const _z_wireexpr
     return ret;
 }
 
+size_t _z_wireexpr_encoded_len(bool has_suffix, const _z_wireexpr_t *fld) {
+    size_t len = _z_zint_len(fld->_id);
+    if (has_suffix) {
+        len += _z_buf_prefixed_len(_z_string_view_len(&fld->_suffix));
+    }
+    return len;
+}
+
 z_result_t _z_wireexpr_decode(_z_wireexpr_t *ke, _z_zbuf_t *zbf, bool has_suffix, bool remote_mapping) {
     _Z_DEBUG("Decoding _RESKEY");
     z_result_t ret = _Z_RES_OK;
@@ -221,11 +238,15 @@ z_result_t _z_source_info_encode(_z_wbuf_t *wbf, const _z_source_info_t *info) {
     return _z_zsize_encode(wbf, info->_source_sn);
 }
 z_result_t _z_source_info_encode_ext(_z_wbuf_t *wbf, const _z_source_info_t *info) {
-    uint8_t zidlen = _z_id_len(info->_source_id.zid);
-    size_t ext_size = 1u + zidlen + _z_zint_len(info->_source_id.eid) + _z_zint_len(info->_source_sn);
-    _Z_RETURN_IF_ERR(_z_zsize_encode(wbf, ext_size));
+    _Z_RETURN_IF_ERR(_z_zsize_encode(wbf, _z_source_info_encoded_len(info)));
     return _z_source_info_encode(wbf, info);
 }
+size_t _z_source_info_encoded_len(const _z_source_info_t *info) {
+    return 1u + _z_id_len(info->_source_id.zid) + _z_zint_len(info->_source_id.eid) + _z_zint_len(info->_source_sn);
+}
+size_t _z_source_info_ext_encoded_len(const _z_source_info_t *info) {
+    return _z_buf_prefixed_len(_z_source_info_encoded_len(info));
+}
 
 /*------------------ Push Body Field ------------------*/
 z_result_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb) {
@@ -276,6 +297,28 @@ z_result_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb) {
 
     return _Z_RES_OK;
 }
+size_t _z_push_body_encoded_len(const _z_push_body_t *pshb) {
+    // Header
+    size_t len = 1;
+    if (_z_timestamp_check(&pshb->_body._put._commons._timestamp)) {
+        len += _z_timestamp_encoded_len(&pshb->_body._put._commons._timestamp);
+    }
+    if (pshb->_is_put && _z_encoding_view_check(&pshb->_body._put._encoding)) {
+        len += _z_encoding_len(_z_encoding_view_deref(&pshb->_body._put._encoding));
+    }
+    const _z_source_info_t *info = &pshb->_body._put._commons._source_info;
+    if (_z_id_check(info->_source_id.zid) || info->_source_sn != 0 || info->_source_id.eid != 0) {
+        len += 1 + _z_source_info_ext_encoded_len(info);
+    }
+    if (pshb->_is_put && _z_bytes_view_check(&pshb->_body._put._attachment)) {
+        len += 1 + _z_buf_prefixed_len(_z_bytes_len(_z_bytes_view_deref(&pshb->_body._put._attachment)));
+    }
+    if (pshb->_is_put) {
+        len += _z_buf_prefixed_len(_z_bytes_len(_z_bytes_view_deref(&pshb->_body._put._payload)));
+    }
+    return len;
+}
+
 z_result_t _z_push_body_decode_extensions(_z_msg_ext_t *extension, void *ctx) {
     _z_push_body_t *pshb = (_z_push_body_t *)ctx;
     z_result_t ret = _Z_RES_OK;
@@ -348,6 +391,10 @@ z_result_t _z_put_encode(_z_wbuf_t *wbf, const _z_msg_put_t *put) {
     _z_push_body_t body = {._is_put = true, ._body = {._put = *put}};
     return _z_push_body_encode(wbf, &body);
 }
+size_t _z_put_encoded_len(const _z_msg_put_t *put) {
+    _z_push_body_t body = {._is_put = true, ._body = {._put = *put}};
+    return _z_push_body_encoded_len(&body);
+}
 z_result_t _z_put_decode(_z_msg_put_t *put, _z_zbuf_t *zbf, uint8_t header) {
     assert(_Z_MID(header) == _Z_MID_Z_PUT);
     _z_push_body_t body = {._is_put = true, ._body = {._put = *put}};
@@ -360,6 +407,10 @@ z_result_t _z_del_encode(_z_wbuf_t *wbf, const _z_msg_del_t *del) {
     _z_push_body_t body = {._is_put = false, ._body = {._del = *del}};
     return _z_push_body_encode(wbf, &body);
 }
+size_t _z_del_encoded_len(const _z_msg_del_t *del) {
+    _z_push_body_t body = {._is_put = false, ._body = {._del = *del}};
+    return _z_push_body_encoded_len(&body);
+}
 z_result_t _z_del_decode(_z_msg_del_t *del, _z_zbuf_t *zbf, uint8_t header) {
     assert(_Z_MID(header) == _Z_MID_Z_DEL);
     _z_push_body_t body = {._is_put = false, ._body = {._del = *del}};
@@ -429,6 +480,35 @@ z_result_t _z_query_encode(_z_wbuf_t *wbf, const _z_msg_query_t *msg) {
     return ret;
 }
 
+size_t _z_query_encoded_len(const _z_msg_query_t *msg) {
+    // Header
+    size_t len = 1;
+    if (msg->_consolidation != Z_CONSOLIDATION_MODE_DEFAULT) {
+        len += 1;
+    }
+    const _z_slice_t *params = _z_slice_view_deref(&msg->_parameters);
+    size_t params_len = (_z_slice_check(params) && params->len > 0) ? params->len : 0;
+    if (msg->_implicit_anyke) {
+        if (params_len > 0) {
+            params_len += _Z_QUERY_PARAMS_LIST_SEPARATOR_LEN;
+        }
+        len += _z_buf_prefixed_len(params_len + _Z_QUERY_PARAMS_KEY_ANYKE_LEN);
+    } else if (params_len > 0) {
+        len += _z_buf_prefixed_len(params_len);
+    }
+    _z_msg_query_reqexts_t required_exts = _z_msg_query_required_extensions(msg);
+    if (required_exts.body) {
+        len += 1 + _z_value_ext_encoded_len(_z_value_view_deref(&msg->_ext_value));
+    }
+    if (required_exts.info) {
+        len += 1 + _z_source_info_ext_encoded_len(&msg->_ext_info);
+    }
+    if (required_exts.attachment) {
+        len += 1 + _z_buf_prefixed_len(_z_bytes_len(_z_bytes_view_deref(&msg->_ext_attachment)));
+    }
+    return len;
+}
+
 z_result_t _z_query_decode_extensions(_z_msg_ext_t *extension, void *ctx) {
     _z_msg_query_t *msg = (_z_msg_query_t *)ctx;
     z_result_t ret = _Z_RES_OK;
@@ -490,6 +570,10 @@ z_result_t _z_reply_encode(_z_wbuf_t *wbf, const _z_msg_reply_t *reply) {
     _Z_RETURN_IF_ERR(_z_push_body_encode(wbf, &reply->_body));
     return _Z_RES_OK;
 }
+size_t _z_reply_encoded_len(const _z_msg_reply_t *reply) {
+    size_t len = (reply->_consolidation != Z_CONSOLIDATION_MODE_DEFAULT) ? 2 : 1;
+    return len + _z_push_body_encoded_len(&reply->_body);
+}
 z_result_t _z_reply_decode_extension(_z_msg_ext_t *extension, void *ctx) {
     _ZP_UNUSED(ctx);
     z_result_t ret = _Z_RES_OK;
@@ -544,6 +628,18 @@ z_result_t _z_err_encode(_z_wbuf_t *wbf, const _z_msg_err_t *err) {
     _Z_RETURN_IF_ERR(_z_bytes_encode(wbf, _z_bytes_view_deref(&err->_payload)));
     return ret;
 }
+size_t _z_err_encoded_len(const _z_msg_err_t *err) {
+    // Header
+    size_t len = 1;
+    if (_z_encoding_view_check(&err->_encoding)) {
+        len += _z_encoding_len(_z_encoding_view_deref(&err->_encoding));
+    }
+    if (_z_id_check(err->_ext_source_info._source_id.zid) || err->_ext_source_info._source_id.eid != 0 ||
+        err->_ext_source_info._source_sn != 0) {
+        len += 1 + _z_source_info_ext_encoded_len(&err->_ext_source_info);
+    }
+    return len + _z_buf_prefixed_len(_z_bytes_len(_z_bytes_view_deref(&err->_payload)));
+}
 z_result_t _z_err_decode_extension(_z_msg_ext_t *extension, void *ctx) {
     z_result_t ret = _Z_RES_OK;
     _z_msg_err_t *reply = (_z_msg_err_t *)ctx;
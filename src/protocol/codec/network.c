@@ -38,7 +38,7 @@
 
 /*------------------ Push Message ------------------*/
 
-z_result_t _z_push_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg) {
+static z_result_t _z_push_header_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg) {
     uint8_t header = _Z_MID_N_PUSH | (_z_wireexpr_is_local(&msg->_key) ? _Z_FLAG_N_REQUEST_M : 0);
     bool has_suffix = _z_wireexpr_has_suffix(&msg->_key);
     bool has_qos_ext = msg->_qos._val != _Z_N_QOS_DEFAULT._val;
@@ -61,12 +61,53 @@ z_result_t _z_push_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg) {
         _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZBUF | 0x02));
         _Z_RETURN_IF_ERR(_z_timestamp_encode_ext(wbf, &msg->_timestamp));
     }
+    return _Z_RES_OK;
+}
+
+static size_t _z_push_header_encoded_len(const _z_n_msg_push_t *msg) {
+    size_t len = 1 + _z_wireexpr_encoded_len(_z_wireexpr_has_suffix(&msg->_key), &msg->_key);
+    if (msg->_qos._val != _Z_N_QOS_DEFAULT._val) {
+        len += 2;
+    }
+    if (_z_timestamp_check(&msg->_timestamp)) {
+        len += 1 + _z_timestamp_ext_encoded_len(&msg->_timestamp);
+    }
+    return len;
+}
 
+z_result_t _z_push_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg) {
+    if (msg->_prefix != NULL) {
+        _Z_RETURN_IF_ERR(_z_wbuf_write_bytes(wbf, msg->_prefix->start, 0, msg->_prefix->len));
+    } else {
+        _Z_RETURN_IF_ERR(_z_push_header_encode(wbf, msg));
+    }
     _Z_RETURN_IF_ERR(_z_push_body_encode(wbf, &msg->_body));
 
     return _Z_RES_OK;
 }
 
+size_t _z_push_encoded_len(const _z_n_msg_push_t *msg) {
+    size_t len = msg->_prefix != NULL ? msg->_prefix->len : _z_push_header_encoded_len(msg);
+    return len + _z_push_body_encoded_len(&msg->_body);
+}
+
+z_result_t _z_push_prefix_encode(_z_slice_t *prefix, const _z_wireexpr_t *key, _z_n_qos_t qos) {
+    _z_n_msg_push_t msg = {._key = *key, ._qos = qos, ._timestamp = _z_timestamp_null()};
+    size_t len = _z_push_header_encoded_len(&msg);
+    _z_wbuf_t wbf;
+    _Z_RETURN_IF_ERR(_z_wbuf_init(&wbf, len, false));
+    z_result_t ret = _z_push_header_encode(&wbf, &msg);
+    if (ret == _Z_RES_OK) {
+        *prefix = _z_slice_copy_from_buf(_z_wbuf_get_iosli(&wbf, 0)->_buf, len);
+        if (!_z_slice_check(prefix)) {
+            _Z_ERROR_LOG(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        }
+    }
+    _z_wbuf_clear(&wbf);
+    return ret;
+}
+
 z_result_t _z_push_decode_ext_cb(_z_msg_ext_t *extension, void *ctx) {
     z_result_t ret = _Z_RES_OK;
     _z_n_msg_push_t *msg = (_z_n_msg_push_t *)ctx;
@@ -166,6 +207,35 @@ z_result_t _z_request_encode(_z_wbuf_t *wbf, const _z_n_msg_request_t *msg) {
     }
     return ret;
 }
+size_t _z_request_encoded_len(const _z_n_msg_request_t *msg) {
+    size_t len = 1 + _z_zint_len(msg->_rid) + _z_wireexpr_encoded_len(_z_wireexpr_has_suffix(&msg->_key), &msg->_key);
+    _z_n_msg_request_exts_t exts = _z_n_msg_request_needed_exts(msg);
+    if (exts.ext_qos) {
+        len += 1 + _z_zint_len(msg->_ext_qos._val);
+    }
+    if (exts.ext_tstamp) {
+        len += 1 + _z_timestamp_ext_encoded_len(&msg->_ext_timestamp);
+    }
+    if (exts.ext_target) {
+        len += 1 + _z_zint_len(msg->_ext_target);
+    }
+    if (exts.ext_budget) {
+        len += 1 + _z_zint_len(msg->_ext_budget);
+    }
+    if (exts.ext_timeout_ms) {
+        len += 1 + _z_zint_len(msg->_ext_timeout_ms);
+    }
+    switch (msg->_tag) {
+        case _Z_REQUEST_QUERY:
+            return len + _z_query_encoded_len(&msg->_body._query);
+        case _Z_REQUEST_PUT:
+            return len + _z_put_encoded_len(&msg->_body._put);
+        case _Z_REQUEST_DEL:
+            return len + _z_del_encoded_len(&msg->_body._del);
+        default:
+            return len;
+    }
+}
 z_result_t _z_request_decode_extensions(_z_msg_ext_t *extension, void *ctx) {
     _z_n_msg_request_t *msg = (_z_n_msg_request_t *)ctx;
     switch (_Z_EXT_FULL_ID(extension->_header)) {
@@ -301,6 +371,29 @@ z_result_t _z_response_encode(_z_wbuf_t *wbf, const _z_n_msg_response_t *msg) {
     return ret;
 }
 
+size_t _z_response_encoded_len(const _z_n_msg_response_t *msg) {
+    size_t len = 1 + _z_zint_len(msg->_request_id) +
+                 _z_wireexpr_encoded_len(_z_wireexpr_has_suffix(&msg->_key), &msg->_key);
+    if (msg->_ext_qos._val != _Z_N_QOS_DEFAULT._val) {
+        len += 1 + _z_zint_len(msg->_ext_qos._val);
+    }
+    if (_z_timestamp_check(&msg->_ext_timestamp)) {
+        len += 1 + _z_timestamp_ext_encoded_len(&msg->_ext_timestamp);
+    }
+    if (_z_id_check(msg->_ext_responder._zid) || msg->_ext_responder._eid != 0) {
+        size_t zidlen = _z_id_len(msg->_ext_responder._zid);
+        len += 1 + _z_buf_prefixed_len(zidlen + 1 + _z_zint_len(msg->_ext_responder._eid));
+    }
+    switch (msg->_tag) {
+        case _Z_RESPONSE_BODY_REPLY:
+            return len + _z_reply_encoded_len(&msg->_body._reply);
+        case _Z_RESPONSE_BODY_ERR:
+            return len + _z_err_encoded_len(&msg->_body._err);
+        default:
+            return len;
+    }
+}
+
 z_result_t _z_response_decode_extension(_z_msg_ext_t *extension, void *ctx) {
     z_result_t ret = _Z_RES_OK;
     _z_n_msg_response_t *msg = (_z_n_msg_response_t *)ctx;
@@ -413,6 +506,19 @@ z_result_t _z_declare_encode(_z_wbuf_t *wbf, const _z_n_msg_declare_t *decl) {
     // Encode declaration
     return _z_declaration_encode(wbf, &decl->_decl);
 }
+size_t _z_declare_encoded_len(const _z_n_msg_declare_t *decl) {
+    size_t len = 1;
+    if (decl->_interest_id.has_value) {
+        len += _z_zint_len(decl->_interest_id.value);
+    }
+    if (decl->_ext_qos._val != _Z_N_QOS_DEFAULT._val) {
+        len += 1 + _z_zint_len(decl->_ext_qos._val);
+    }
+    if (_z_timestamp_check(&decl->_ext_timestamp)) {
+        len += 1 + _z_timestamp_ext_encoded_len(&decl->_ext_timestamp);
+    }
+    return len + _z_declaration_encoded_len(&decl->_decl);
+}
 z_result_t _z_declare_decode_extensions(_z_msg_ext_t *extension, void *ctx) {
     _z_n_msg_declare_t *decl = (_z_n_msg_declare_t *)ctx;
     switch (_Z_EXT_FULL_ID(extension->_header)) {
@@ -462,6 +568,12 @@ z_result_t _z_n_interest_encode(_z_wbuf_t *wbf, const _z_n_msg_interest_t *inter
     return _z_interest_encode(wbf, &interest->_interest, is_final);
 }
 
+size_t _z_n_interest_encoded_len(const _z_n_msg_interest_t *interest) {
+    bool is_final = !_Z_HAS_FLAG(interest->_interest.flags, _Z_INTEREST_FLAG_CURRENT) &&
+                    !_Z_HAS_FLAG(interest->_interest.flags, _Z_INTEREST_FLAG_FUTURE);
+    return 1 + _z_interest_encoded_len(&interest->_interest, is_final);
+}
+
 z_result_t _z_n_interest_decode(_z_n_msg_interest_t *interest, _z_zbuf_t *zbf, uint8_t header) {
     interest->_interest = _z_interest_null();
     bool is_final = true;
@@ -534,6 +646,24 @@ z_result_t _z_oam_encode(_z_wbuf_t *wbf, const _z_n_msg_oam_t *oam) {
     return _Z_RES_OK;
 }
 
+size_t _z_oam_encoded_len(const _z_n_msg_oam_t *oam) {
+    size_t len = 1 + _z_zint_len(oam->_id);
+    if (oam->_ext_qos._val != _Z_N_QOS_DEFAULT._val) {
+        len += 2;
+    }
+    if (_z_timestamp_check(&oam->_ext_timestamp)) {
+        len += 1 + _z_timestamp_ext_encoded_len(&oam->_ext_timestamp);
+    }
+    switch (oam->_enc) {
+        case _Z_OAM_BODY_ZINT:
+            return len + _z_zint_len(oam->_body._zint._val);
+        case _Z_OAM_BODY_ZBUF:
+            return len + _z_buf_prefixed_len(_z_slice_view_deref(&oam->_body._zbuf._val)->len);
+        default:
+            return len;
+    }
+}
+
 z_result_t _z_oam_decode_extensions(_z_msg_ext_t *extension, void *ctx) {
     _z_n_msg_oam_t *oam = (_z_n_msg_oam_t *)ctx;
     switch (_Z_EXT_FULL_ID(extension->_header)) {
@@ -624,6 +754,26 @@ z_result_t _z_network_message_encode(_z_wbuf_t *wbf, const _z_network_message_t
             _Z_ERROR_RETURN(_Z_ERR_GENERIC);
     }
 }
+size_t _z_network_message_encoded_len(const _z_network_message_t *msg) {
+    switch (msg->_tag) {
+        case _Z_N_DECLARE:
+            return _z_declare_encoded_len(&msg->_body._declare);
+        case _Z_N_PUSH:
+            return _z_push_encoded_len(&msg->_body._push);
+        case _Z_N_REQUEST:
+            return _z_request_encoded_len(&msg->_body._request);
+        case _Z_N_RESPONSE:
+            return _z_response_encoded_len(&msg->_body._response);
+        case _Z_N_RESPONSE_FINAL:
+            return 1 + _z_zint_len(msg->_body._response_final._request_id);
+        case _Z_N_INTEREST:
+            return _z_n_interest_encoded_len(&msg->_body._interest);
+        case _Z_N_OAM:
+            return _z_oam_encoded_len(&msg->_body._oam);
+        default:
+            return 0;
+    }
+}
 z_result_t _z_network_message_decode(_z_network_message_t *msg, _z_zbuf_t *zbf) {
     uint8_t header = 0;
     *msg = (_z_network_message_t){0};
@@ -67,10 +67,16 @@ z_result_t _z_join_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_join_t
     bool has_patch = msg->_patch != _Z_NO_PATCH;
 #else
     bool has_patch = false;
+#endif
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    bool has_repair = msg->_repair;
+#else
+    bool has_repair = false;
 #endif
     if (msg->_next_sn._is_qos) {
         if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
-            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_QOS | _Z_MSG_EXT_MORE(has_patch)));
+            _Z_RETURN_IF_ERR(
+                _z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_QOS | _Z_MSG_EXT_MORE(has_patch || has_repair)));
             size_t len = 0;
             for (uint8_t i = 0; (i < Z_PRIORITIES_NUM) && (ret == _Z_RES_OK); i++) {
                 len += _z_zint_len(msg->_next_sn._val._qos[i]._reliable) +
@@ -89,7 +95,7 @@ z_result_t _z_join_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_join_t
 #if Z_FEATURE_FRAGMENTATION == 1
     if (has_patch) {
         if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
-            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_PATCH));
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_PATCH | _Z_MSG_EXT_MORE(has_repair)));
             _Z_RETURN_IF_ERR(_z_zint64_encode(wbf, msg->_patch));
         } else {
             _Z_DEBUG("Attempted to serialize Patch extension, but the header extension flag was unset");
@@ -97,6 +103,14 @@ z_result_t _z_join_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_join_t
         }
     }
 #endif
+    if (has_repair) {
+        if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_REPAIR));
+        } else {
+            _Z_DEBUG("Attempted to serialize Repair extension, but the header extension flag was unset");
+            ret |= _Z_ERR_MESSAGE_SERIALIZATION_FAILED;
+        }
+    }
 
     return ret;
 }
@@ -114,6 +128,10 @@ z_result_t _z_join_decode_ext(_z_msg_ext_t *extension, void *ctx) {
 #if Z_FEATURE_FRAGMENTATION == 1
     } else if (_Z_EXT_FULL_ID(extension->_header) == _Z_MSG_EXT_ID_JOIN_PATCH) {
         msg->_patch = (uint8_t)extension->_body._zint._val;
+#endif
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    } else if (_Z_EXT_FULL_ID(extension->_header) == _Z_MSG_EXT_ID_JOIN_REPAIR) {
+        msg->_repair = true;
 #endif
     } else if (_Z_MSG_EXT_IS_MANDATORY(extension->_header)) {
         _Z_ERROR_LOG(_Z_ERR_MESSAGE_EXTENSION_MANDATORY_AND_UNKNOWN);
@@ -401,7 +419,8 @@ z_result_t _z_frame_decode(_z_t_msg_frame_t *msg, _z_zbuf_t *zbf, uint8_t header
     if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
         _Z_RETURN_IF_ERR(_z_msg_ext_skip_non_mandatories(zbf, 0x04));
     }
-    msg->_payload = _z_slice_view_make(_z_zbuf_get_rptr(zbf), _z_zbuf_readable_len(zbf));
+    _z_slice_t payload = _z_zbuf_alias_slice(zbf, _z_zbuf_readable_len(zbf));
+    msg->_payload = _z_slice_view_from_slice(&payload);
     _z_zbuf_set_rpos(zbf, _z_zbuf_get_wpos(zbf));  // the remainder will be consumed by network message decoder
     return _Z_RES_OK;
 }
@@ -461,12 +480,98 @@ z_result_t _z_fragment_decode(_z_t_msg_fragment_t *msg, _z_zbuf_t *zbf, uint8_t
     if ((ret == _Z_RES_OK) && (_Z_HAS_FLAG(header, _Z_FLAG_T_Z) == true)) {
         ret |= _z_msg_ext_decode_iter(zbf, _z_fragment_decode_ext, msg);
     }
-    msg->_payload = _z_slice_view_make(_z_zbuf_get_rptr(zbf), _z_zbuf_readable_len(zbf));
+    _z_slice_t payload = _z_zbuf_alias_slice(zbf, _z_zbuf_readable_len(zbf));
+    msg->_payload = _z_slice_view_from_slice(&payload);
     _z_zbuf_set_rpos(zbf, _z_zbuf_get_wpos(zbf));  // the remainder will be consumed by network message decoder
 
     return ret;
 }
 
+/*------------------ OAM Message ------------------*/
+z_result_t _z_t_oam_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_oam_t *msg) {
+    _Z_DEBUG("Encoding _Z_MID_T_OAM");
+    if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z) || (_Z_EXT_ENC(header) != _Z_MSG_EXT_ENC_ZBUF)) {
+        _Z_ERROR_RETURN(_Z_ERR_MESSAGE_SERIALIZATION_FAILED);
+    }
+    _Z_RETURN_IF_ERR(_z_zint16_encode(wbf, msg->_id));
+    switch (msg->_id) {
+        case _Z_T_OAM_ID_NACK: {
+            const _z_t_msg_oam_nack_t *nack = &msg->_body._nack;
+            uint8_t zidlen = _z_id_len(nack->_zid);
+            _Z_RETURN_IF_ERR(_z_zsize_encode(wbf, (_z_zint_t)1 + zidlen + _z_zint_len(nack->_sn)));
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, (uint8_t)(((zidlen - 1) & 0x0F) << 4)));
+            _Z_RETURN_IF_ERR(_z_wbuf_write_bytes(wbf, nack->_zid.id, 0, zidlen));
+            return _z_zsize_encode(wbf, nack->_sn);
+        } break;
+        case _Z_T_OAM_ID_ACKNACK: {
+            const _z_t_msg_oam_acknack_t *acknack = &msg->_body._acknack;
+            _Z_RETURN_IF_ERR(
+                _z_zsize_encode(wbf, (_z_zint_t)_z_zint_len(acknack->_first_sn) + _z_zint_len(acknack->_next_sn)));
+            _Z_RETURN_IF_ERR(_z_zsize_encode(wbf, acknack->_first_sn));
+            return _z_zsize_encode(wbf, acknack->_next_sn);
+        } break;
+        default: {
+            _Z_ERROR_RETURN(_Z_ERR_MESSAGE_SERIALIZATION_FAILED);
+        } break;
+    }
+}
+
+static z_result_t _z_t_oam_decode_body(_z_t_msg_oam_t *msg, _z_zbuf_t *zbf) {
+    switch (msg->_id) {
+        case _Z_T_OAM_ID_NACK: {
+            _z_t_msg_oam_nack_t *nack = &msg->_body._nack;
+            uint8_t cbyte = 0;
+            _Z_RETURN_IF_ERR(_z_uint8_decode(&cbyte, zbf));
+            uint8_t zidlen = ((cbyte & 0xF0) >> 4) + (uint8_t)1;
+            if (_z_zbuf_readable_len(zbf) < zidlen) {
+                _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+            }
+            nack->_zid = _z_id_empty();
+            _z_zbuf_read_bytes(zbf, nack->_zid.id, 0, zidlen);
+            return _z_zsize_decode(&nack->_sn, zbf);
+        } break;
+        case _Z_T_OAM_ID_ACKNACK: {
+            _Z_RETURN_IF_ERR(_z_zsize_decode(&msg->_body._acknack._first_sn, zbf));
+            return _z_zsize_decode(&msg->_body._acknack._next_sn, zbf);
+        } break;
+        default: {
+            // Left to the nodes knowing the id
+            return _Z_RES_OK;
+        } break;
+    }
+}
+
+z_result_t _z_t_oam_decode(_z_t_msg_oam_t *msg, _z_zbuf_t *zbf, uint8_t header) {
+    _Z_DEBUG("Decoding _Z_MID_T_OAM");
+    *msg = (_z_t_msg_oam_t){0};
+    _Z_RETURN_IF_ERR(_z_zint16_decode(&msg->_id, zbf));
+    if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
+        _Z_RETURN_IF_ERR(_z_msg_ext_skip_non_mandatories(zbf, 0x00));
+    }
+    switch (_Z_EXT_ENC(header)) {
+        case _Z_MSG_EXT_ENC_UNIT: {
+            return _Z_RES_OK;
+        } break;
+        case _Z_MSG_EXT_ENC_ZINT: {
+            uint64_t val = 0;
+            return _z_zint64_decode(&val, zbf);
+        } break;
+        case _Z_MSG_EXT_ENC_ZBUF: {
+            _z_zint_t len = 0;
+            _Z_RETURN_IF_ERR(_z_zsize_decode(&len, zbf));
+            if (_z_zbuf_readable_len(zbf) < len) {
+                _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+            }
+            _z_zbuf_t body = _z_zbuf_view(zbf, len);
+            _z_zbuf_set_rpos(zbf, _z_zbuf_get_rpos(zbf) + len);
+            return _z_t_oam_decode_body(msg, &body);
+        } break;
+        default: {
+            _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+        } break;
+    }
+}
+
 #if defined Z_TEST_HOOKS
 static _z_transport_message_encode_override_fn _z_transport_message_encode_override = NULL;
 
@@ -511,6 +616,9 @@ z_result_t _z_transport_message_encode(_z_wbuf_t *wbf, const _z_transport_messag
         case _Z_MID_T_CLOSE: {
             return _z_close_encode(wbf, msg->_header, &msg->_body._close);
         } break;
+        case _Z_MID_T_OAM: {
+            return _z_t_oam_encode(wbf, msg->_header, &msg->_body._oam);
+        } break;
         default: {
             _Z_INFO("WARNING: Trying to encode session message with unknown ID(%d)", _Z_MID(msg->_header));
             _Z_ERROR_RETURN(_Z_ERR_MESSAGE_TRANSPORT_UNKNOWN);
@@ -543,6 +651,9 @@ z_result_t _z_transport_message_decode(_z_transport_message_t *msg, _z_zbuf_t *z
         case _Z_MID_T_CLOSE: {
             return _z_close_decode(&msg->_body._close, zbf, msg->_header);
         } break;
+        case _Z_MID_T_OAM: {
+            return _z_t_oam_decode(&msg->_body._oam, zbf, msg->_header);
+        } break;
         default: {
             _Z_INFO("WARNING: Trying to decode session message with unknown ID(0x%x) (header=0x%x)", mid, msg->_header);
             _Z_ERROR_RETURN(_Z_ERR_MESSAGE_TRANSPORT_UNKNOWN);
@@ -112,6 +112,7 @@ void _z_n_msg_make_push_put(_z_network_message_t *dst, const _z_wireexpr_t *key,
     dst->_body._push._key = *key;
     dst->_body._push._qos = qos;
     dst->_body._push._timestamp = _z_timestamp_null();
+    dst->_body._push._prefix = NULL;
     dst->_body._push._body._is_put = true;
     _z_msg_put_fill(&dst->_body._push._body._body._put, timestamp, source_info, payload, encoding, attachment);
 }
@@ -131,6 +132,7 @@ void _z_n_msg_make_push_del(_z_network_message_t *dst, const _z_wireexpr_t *key,
     dst->_body._push._key = *key;
     dst->_body._push._qos = qos;
     dst->_body._push._timestamp = _z_timestamp_null();
+    dst->_body._push._prefix = NULL;
     dst->_body._push._body._is_put = false;
     _z_msg_del_fill(&dst->_body._push._body._body._del, timestamp, source_info, NULL);
 }
@@ -51,6 +51,9 @@ _z_transport_message_t _z_t_msg_make_join(z_whatami_t whatami, _z_zint_t lease,
 #if Z_FEATURE_FRAGMENTATION == 1
     msg._body._join._patch = _Z_CURRENT_PATCH;
 #endif
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    msg._body._join._repair = false;
+#endif
 
     if ((lease % 1000) == 0) {
         _Z_SET_FLAG(msg._header, _Z_FLAG_T_JOIN_T);
@@ -239,6 +242,27 @@ _z_transport_message_t _z_t_msg_make_fragment(_z_zint_t sn, const _z_slice_t *pa
     return msg;
 }
 
+/*------------------ OAM Message ------------------*/
+_z_transport_message_t _z_t_msg_make_nack(_z_id_t zid, _z_zint_t sn) {
+    _z_transport_message_t msg;
+    msg._header = _Z_MID_T_OAM | _Z_MSG_EXT_ENC_ZBUF;
+
+    msg._body._oam._id = _Z_T_OAM_ID_NACK;
+    msg._body._oam._body._nack._zid = zid;
+    msg._body._oam._body._nack._sn = sn;
+    return msg;
+}
+
+_z_transport_message_t _z_t_msg_make_acknack(_z_zint_t first_sn, _z_zint_t next_sn) {
+    _z_transport_message_t msg;
+    msg._header = _Z_MID_T_OAM | _Z_MSG_EXT_ENC_ZBUF;
+
+    msg._body._oam._id = _Z_T_OAM_ID_ACKNACK;
+    msg._body._oam._body._acknack._first_sn = first_sn;
+    msg._body._oam._body._acknack._next_sn = next_sn;
+    return msg;
+}
+
 /*------------------ Transport Message ------------------*/
 
 void _z_s_msg_clear(_z_scouting_message_t *msg) {
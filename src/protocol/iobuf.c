@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/system/platform.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/result.h"
@@ -115,19 +116,174 @@ z_result_t _z_zbuf_init(_z_zbuf_t *zbf, size_t capacity) {
     return _Z_RES_OK;
 }
 
+#if Z_FEATURE_RX_ZERO_COPY == 1
+/*------------------ ZBuf Pool ------------------*/
+// Idle buffers are kept for reuse, buffers still retained by slices keep the pool alive after its zbuf is cleared.
+struct _z_zbuf_pool_t {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_t _mutex;
+#endif
+    // One for the zbuf plus one per allocated buffer
+    size_t _refs;
+    size_t _capacity;
+    bool _closed;
+    size_t _idle_len;
+    _z_shared_buf_t *_idle[Z_RX_ZERO_COPY_POOL_SIZE];
+};
+
+static inline void _z_zbuf_pool_lock(_z_zbuf_pool_t *pool) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_lock(&pool->_mutex);
+#else
+    _ZP_UNUSED(pool);
+#endif
+}
+
+static inline void _z_zbuf_pool_unlock(_z_zbuf_pool_t *pool) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&pool->_mutex);
+#else
+    _ZP_UNUSED(pool);
+#endif
+}
+
+static void _z_zbuf_pool_free(_z_zbuf_pool_t *pool) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_drop(&pool->_mutex);
+#endif
+    z_free(pool);
+}
+
+static _z_zbuf_pool_t *_z_zbuf_pool_new(size_t capacity) {
+    _z_zbuf_pool_t *pool = (_z_zbuf_pool_t *)z_malloc(sizeof(_z_zbuf_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+#if Z_FEATURE_MULTI_THREAD == 1
+    if (_z_mutex_init(&pool->_mutex) != _Z_RES_OK) {
+        z_free(pool);
+        return NULL;
+    }
+#endif
+    pool->_refs = 1;
+    pool->_capacity = capacity;
+    pool->_closed = false;
+    pool->_idle_len = 0;
+    return pool;
+}
+
+// Called by the last release of a buffer
+static void _z_zbuf_pool_recycle(_z_shared_buf_t *buf) {
+    _z_zbuf_pool_t *pool = (_z_zbuf_pool_t *)buf->_owner;
+    _z_zbuf_pool_lock(pool);
+    bool keep = !pool->_closed && (pool->_idle_len < Z_RX_ZERO_COPY_POOL_SIZE);
+    if (keep) {
+        pool->_idle[pool->_idle_len++] = buf;
+    } else {
+        pool->_refs--;
+    }
+    bool is_last = (pool->_refs == 0);
+    _z_zbuf_pool_unlock(pool);
+    if (!keep) {
+        z_free(buf);
+    }
+    if (is_last) {
+        _z_zbuf_pool_free(pool);
+    }
+}
+
+static _z_shared_buf_t *_z_zbuf_pool_take(_z_zbuf_pool_t *pool) {
+    _z_shared_buf_t *buf = NULL;
+    _z_zbuf_pool_lock(pool);
+    if (pool->_idle_len > 0) {
+        buf = pool->_idle[--pool->_idle_len];
+    }
+    _z_zbuf_pool_unlock(pool);
+    if (buf == NULL) {
+        // Header and data in a single allocation
+        buf = (_z_shared_buf_t *)z_malloc(sizeof(_z_shared_buf_t) + pool->_capacity);
+        if (buf == NULL) {
+            return NULL;
+        }
+        buf->_recycle_f = _z_zbuf_pool_recycle;
+        buf->_owner = pool;
+        buf->_capacity = pool->_capacity;
+        buf->_data = (uint8_t *)(buf + 1);
+        _z_zbuf_pool_lock(pool);
+        pool->_refs++;
+        _z_zbuf_pool_unlock(pool);
+    }
+    _z_atomic_size_init(&buf->_rc, 1);
+    return buf;
+}
+
+static void _z_zbuf_pool_close(_z_zbuf_pool_t *pool) {
+    _z_zbuf_pool_lock(pool);
+    pool->_closed = true;
+    for (size_t i = 0; i < pool->_idle_len; i++) {
+        z_free(pool->_idle[i]);
+    }
+    pool->_refs -= pool->_idle_len + 1;
+    pool->_idle_len = 0;
+    bool is_last = (pool->_refs == 0);
+    _z_zbuf_pool_unlock(pool);
+    if (is_last) {
+        _z_zbuf_pool_free(pool);
+    }
+}
+
+z_result_t _z_zbuf_init_shared(_z_zbuf_t *zbf, size_t capacity) {
+    *zbf = _z_zbuf_null();
+    _z_zbuf_pool_t *pool = _z_zbuf_pool_new(capacity);
+    if (pool == NULL) {
+        return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    }
+    _z_shared_buf_t *buf = _z_zbuf_pool_take(pool);
+    if (buf == NULL) {
+        _z_zbuf_pool_close(pool);
+        return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    }
+    zbf->_ios = _z_iosli_wrap(buf->_data, buf->_capacity, 0, 0);
+    zbf->_shared = buf;
+    zbf->_pool = pool;
+    return _Z_RES_OK;
+}
+
+bool _z_zbuf_unshare(_z_zbuf_t *zbf) {
+    _z_shared_buf_t *buf = _z_zbuf_pool_take(zbf->_pool);
+    if (buf == NULL) {
+        _Z_ERROR("Not enough memory to replace a retained rx buffer");
+        return false;
+    }
+    size_t len = _z_iosli_readable(&zbf->_ios);
+    (void)memcpy(buf->_data, _z_zbuf_get_rptr(zbf), len);
+    _z_shared_buf_release(zbf->_shared);
+    zbf->_ios = _z_iosli_wrap(buf->_data, buf->_capacity, 0, len);
+    zbf->_shared = buf;
+    return true;
+}
+#endif
+
 _z_zbuf_t _z_zbuf_view(_z_zbuf_t *zbf, size_t length) {
     assert(_z_iosli_readable(&zbf->_ios) >= length);
-    _z_zbuf_t v;
+    _z_zbuf_t v = _z_zbuf_null();
     v._ios = _z_iosli_wrap(_z_zbuf_get_rptr(zbf), length, 0, length);
+#if Z_FEATURE_RX_ZERO_COPY == 1
+    v._shared = zbf->_shared;
+#endif
     return v;
 }
 
 _z_zbuf_t _z_slice_as_zbuf(const _z_slice_t *slice) {
-    return (_z_zbuf_t){._ios = {._buf = (uint8_t *)slice->start,  // Safety: `_z_zbuf_t` is an immutable buffer
-                                ._is_alloc = false,
-                                ._capacity = slice->len,
-                                ._r_pos = 0,
-                                ._w_pos = slice->len}};
+    _z_zbuf_t zbf = {._ios = {._buf = (uint8_t *)slice->start,  // Safety: `_z_zbuf_t` is an immutable buffer
+                              ._is_alloc = false,
+                              ._capacity = slice->len,
+                              ._r_pos = 0,
+                              ._w_pos = slice->len}};
+#if Z_FEATURE_RX_ZERO_COPY == 1
+    zbf._shared = _z_slice_get_shared_buf(slice);
+#endif
+    return zbf;
 }
 
 void _z_zbuf_copy_bytes(_z_zbuf_t *dst, const _z_zbuf_t *src) { _z_iosli_copy_bytes(&dst->_ios, &src->_ios); }
@@ -136,9 +292,26 @@ void _z_zbuf_read_bytes(_z_zbuf_t *zbf, uint8_t *dest, size_t offset, size_t len
     _z_iosli_read_bytes(&zbf->_ios, dest, offset, length);
 }
 
-void _z_zbuf_clear(_z_zbuf_t *zbf) { _z_iosli_clear(&zbf->_ios); }
+void _z_zbuf_clear(_z_zbuf_t *zbf) {
+#if Z_FEATURE_RX_ZERO_COPY == 1
+    if (zbf->_pool != NULL) {
+        _z_shared_buf_release(zbf->_shared);
+        _z_zbuf_pool_close(zbf->_pool);
+        *zbf = _z_zbuf_null();
+        return;
+    }
+#endif
+    _z_iosli_clear(&zbf->_ios);
+}
 
 void _z_zbuf_compact(_z_zbuf_t *zbf) {
+#if Z_FEATURE_RX_ZERO_COPY == 1
+    // Retained slices still point to the buffer, compact into a fresh one instead
+    if ((zbf->_pool != NULL) && !_z_shared_buf_is_unique(zbf->_shared)) {
+        (void)_z_zbuf_unshare(zbf);
+        return;
+    }
+#endif
     if ((zbf->_ios._r_pos != 0) || (zbf->_ios._w_pos != 0)) {
         size_t len = _z_iosli_readable(&zbf->_ios);
         (void)memmove(zbf->_ios._buf, _z_zbuf_get_rptr(zbf), len);
@@ -495,6 +668,23 @@ void _z_wbuf_reset(_z_wbuf_t *wbf) {
     }
 }
 
+void _z_wbuf_reset_initial(_z_wbuf_t *wbf) {
+    wbf->_r_idx = 0;
+    wbf->_w_idx = 0;
+    // Expansions and wrapped data are dropped, from the end as they may share the room of the slices before them
+    while (_z_iosli_svec_len(&wbf->_ioss) > 1) {
+        _z_iosli_svec_remove(&wbf->_ioss, _z_iosli_svec_len(&wbf->_ioss) - 1, false);
+    }
+    if (_z_iosli_svec_len(&wbf->_ioss) == 1) {
+        _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, 0);
+        // The room lent to wrapped data is given back, an expandable buffer starts with a slice of its step
+        if (wbf->_expansion_step != 0) {
+            ios->_capacity = wbf->_expansion_step;
+        }
+        _z_iosli_reset(ios);
+    }
+}
+
 void _z_wbuf_clear(_z_wbuf_t *wbf) {
     _z_iosli_svec_clear(&wbf->_ioss);
     *wbf = _z_wbuf_null();
@@ -18,6 +18,7 @@
 
 #include "zenoh-pico/api/types.h"
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/net/filtering.h"
 #include "zenoh-pico/net/query.h"
 #include "zenoh-pico/protocol/codec/core.h"
 #include "zenoh-pico/protocol/core.h"
@@ -35,7 +36,14 @@
 static z_result_t _z_interest_send_decl_resource(_z_session_t *zn, _z_optional_id_t interest_id, void *peer,
                                                  const _z_keyexpr_t *restr_key) {
     _Z_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn));
-    _z_resource_slist_t *res_list = _z_resource_slist_clone(zn->_local_resources);
+    _z_resource_slist_t *res_list = _z_resource_slist_new();
+    if (zn->_local_resources != NULL) {
+        _z_resource_id_hmap_t *by_id = &zn->_local_resources->_by_id;
+        for (_z_resource_id_hmap_iter_t it = _z_resource_id_hmap_begin(by_id); it != _z_resource_id_hmap_end(by_id);
+             it = _z_resource_id_hmap_iter_next(by_id, it)) {
+            res_list = _z_resource_slist_push(res_list, &_z_resource_id_hmap_at(by_id, it)->val);
+        }
+    }
     _z_session_mutex_unlock(zn);
     _z_resource_slist_t *xs = res_list;
     while (xs != NULL) {
@@ -290,11 +298,14 @@ void _z_declare_data_copy(_z_declare_data_t *dst, const _z_declare_data_t *src)
     dst->_id = src->_id;
     dst->_type = src->_type;
     dst->_peer = src->_peer;
+    dst->_interest_id = src->_interest_id;
+    dst->_complete = src->_complete;
     _z_keyexpr_copy(&dst->_key, &src->_key);
 }
 
 bool _z_declare_data_eq(const _z_declare_data_t *left, const _z_declare_data_t *right) {
-    return ((left->_id == right->_id) && (left->_type == right->_type));
+    // Entity ids are only unique per peer
+    return ((left->_id == right->_id) && (left->_type == right->_type) && (left->_peer == right->_peer));
 }
 
 bool _z_session_interest_eq(const _z_session_interest_t *one, const _z_session_interest_t *two) {
@@ -321,35 +332,36 @@ static _z_session_interest_rc_t *__z_get_interest_by_id(_z_session_interest_rc_s
     return ret;
 }
 
-static _z_session_interest_rc_slist_t *__z_get_interest_by_key_and_flags(_z_session_interest_rc_slist_t *intrs,
-                                                                         uint8_t flags, const _z_keyexpr_t *key,
-                                                                         _z_optional_id_t interest_id) {
-    _z_session_interest_rc_slist_t *ret = NULL;
-    _z_session_interest_rc_slist_t *xs = intrs;
-    while (xs != NULL) {
-        _z_session_interest_rc_t *intr = _z_session_interest_rc_slist_value(xs);
-        if ((_Z_RC_IN_VAL(intr)->_flags & flags) == 0) {
-            xs = _z_session_interest_rc_slist_next(xs);
-            continue;
-        }
-        // consider only interests with matching id if specified (which corresponds to CURRENT interest response)
-        // ignore 0 id, since it is the one initially used by peers for declarations propagation
-        if (interest_id.has_value && interest_id.value != 0 && interest_id.value != _Z_RC_IN_VAL(intr)->_id) {
-            xs = _z_session_interest_rc_slist_next(xs);
-            continue;
-        }
-        bool is_matching = _z_session_interest_is_aggregate(_Z_RC_IN_VAL(intr))
-                               ? _z_keyexpr_equals(&_Z_RC_IN_VAL(intr)->_key, key)
-                               : _z_keyexpr_intersects(&_Z_RC_IN_VAL(intr)->_key, key);
-
-        if (is_matching) {
-            ret = _z_session_interest_rc_slist_push_empty(ret);
-            _z_session_interest_rc_t *new_intr = _z_session_interest_rc_slist_value(ret);
-            *new_intr = _z_session_interest_rc_clone(intr);
-        }
-        xs = _z_session_interest_rc_slist_next(xs);
+static bool __z_interest_matches_key(const _z_session_interest_t *intr, const _z_keyexpr_t *key) {
+    return _z_session_interest_is_aggregate(intr) ? _z_keyexpr_equals(&intr->_key, key)
+                                                  : _z_keyexpr_intersects(&intr->_key, key);
+}
+
+typedef struct {
+    _z_session_interest_rc_slist_t *_intrs;
+    const _z_keyexpr_t *_key;
+    _z_optional_id_t _interest_id;
+    uint8_t _flags;
+} __z_interest_match_ctx_t;
+
+static z_result_t __z_interest_match_candidate(void *value, void *arg) {
+    __z_interest_match_ctx_t *ctx = (__z_interest_match_ctx_t *)arg;
+    _z_session_interest_rc_t *intr = (_z_session_interest_rc_t *)value;
+    if ((_Z_RC_IN_VAL(intr)->_flags & ctx->_flags) == 0) {
+        return _Z_RES_OK;
     }
-    return ret;
+    // consider only interests with matching id if specified (which corresponds to CURRENT interest response)
+    // ignore 0 id, since it is the one initially used by peers for declarations propagation
+    if (ctx->_interest_id.has_value && ctx->_interest_id.value != 0 &&
+        ctx->_interest_id.value != _Z_RC_IN_VAL(intr)->_id) {
+        return _Z_RES_OK;
+    }
+    if (__z_interest_matches_key(_Z_RC_IN_VAL(intr), ctx->_key)) {
+        ctx->_intrs = _z_session_interest_rc_slist_push_empty(ctx->_intrs);
+        _z_session_interest_rc_t *new_intr = _z_session_interest_rc_slist_value(ctx->_intrs);
+        *new_intr = _z_session_interest_rc_clone(intr);
+    }
+    return _Z_RES_OK;
 }
 
 /**
@@ -370,8 +382,22 @@ static _z_session_interest_rc_t *__unsafe_z_get_interest_by_id(_z_session_t *zn,
 static _z_session_interest_rc_slist_t *__unsafe_z_get_interest_by_key_and_flags(_z_session_t *zn, uint8_t flags,
                                                                                 const _z_keyexpr_t *key,
                                                                                 _z_optional_id_t interest_id) {
-    _z_session_interest_rc_slist_t *intrs = zn->_local_interests;
-    return __z_get_interest_by_key_and_flags(intrs, flags, key, interest_id);
+    __z_interest_match_ctx_t ctx = {._intrs = NULL, ._key = key, ._interest_id = interest_id, ._flags = flags};
+    _z_keyexpr_trie_match(&zn->_local_interests_index, key, __z_interest_match_candidate, &ctx);
+    return ctx._intrs;
+}
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static void __unsafe_z_drop_interest(_z_session_t *zn, _z_session_interest_rc_t *entry) {
+    _z_session_interest_rc_t intr = *entry;
+    _z_keyexpr_trie_remove(&zn->_local_interests_index, &_Z_RC_IN_VAL(&intr)->_key, entry);
+    // entry points into the list node, so compare against a copy of the handle
+    zn->_local_interests =
+        _z_session_interest_rc_slist_drop_first_filter(zn->_local_interests, _z_session_interest_rc_eq, &intr);
 }
 
 _z_session_interest_rc_t *_z_get_interest_by_id(_z_session_t *zn, const _z_zint_t id) {
@@ -394,38 +420,62 @@ _z_session_interest_rc_t *_z_register_interest(_z_session_t *zn, _z_session_inte
     zn->_local_interests = _z_session_interest_rc_slist_push_empty(zn->_local_interests);
     ret = _z_session_interest_rc_slist_value(zn->_local_interests);
     *ret = _z_session_interest_rc_new_from_val(intr);
+    // the index refers to the list entry, which stays in place until the interest is unregistered. Interests without
+    // a callback, as the ones of the write filters, are only kept to be resent and finalized.
+    if (_Z_RC_IN_VAL(ret)->_callback != NULL &&
+        _z_keyexpr_trie_insert(&zn->_local_interests_index, &_Z_RC_IN_VAL(ret)->_key, ret) != _Z_RES_OK) {
+        // the caller keeps the ownership of the interest on failure
+        *intr = *_Z_RC_IN_VAL(ret);
+        _Z_RC_IN_VAL(ret)->_key = _z_keyexpr_null();
+        _Z_RC_IN_VAL(ret)->_arg = _z_void_rc_null();
+        __unsafe_z_drop_interest(zn, ret);
+        ret = NULL;
+    }
     _z_session_mutex_unlock(zn);
     return ret;
 }
 
 static z_result_t _unsafe_z_register_declare(_z_session_t *zn, const _z_keyexpr_t *key, uint32_t id, uint8_t type,
-                                             bool complete, _z_transport_peer_common_t *peer) {
-    zn->_remote_declares = _z_declare_data_slist_push_empty(zn->_remote_declares);
-    _z_declare_data_t *decl = _z_declare_data_slist_value(zn->_remote_declares);
-    _z_keyexpr_copy(&decl->_key, key);
-    decl->_id = id;
-    decl->_type = type;
-    decl->_complete = complete;
-    decl->_peer = peer;
+                                             bool complete, uint32_t interest_id, _z_transport_peer_common_t *peer) {
+    _z_declare_data_t decl = {._key = _z_keyexpr_null(),
+                              ._peer = peer,
+                              ._id = id,
+                              ._interest_id = interest_id,
+                              ._type = type,
+                              ._complete = complete};
+    _Z_RETURN_IF_ERR(_z_keyexpr_copy(&decl._key, key));
+    _z_declare_id_t decl_id = _z_declare_data_id(&decl);
+    _z_declare_data_hmap_iter_t it = _z_declare_data_hmap_insert(&zn->_remote_declares, &decl_id, &decl);
+    if (it == _z_declare_data_hmap_end(&zn->_remote_declares)) {
+        _z_declare_data_clear(&decl);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    _z_write_filter_unsafe_add_remote(zn, &_z_declare_data_hmap_at(&zn->_remote_declares, it)->val);
+#if Z_FEATURE_PEER_ROUTING == 1
+    _z_peer_route_table_invalidate(&zn->_peer_routes);
+#endif
     return _Z_RES_OK;
 }
 
-static _z_declare_data_t *_unsafe_z_get_declare(_z_session_t *zn, uint32_t id, uint8_t type) {
-    _z_declare_data_slist_t *xs = zn->_remote_declares;
-    _z_declare_data_t comp = {._key = _z_keyexpr_null(), ._id = id, ._type = type, ._complete = false};
-    while (xs != NULL) {
-        _z_declare_data_t *decl = _z_declare_data_slist_value(xs);
-        if (_z_declare_data_eq(&comp, decl)) {
-            return decl;
-        }
-        xs = _z_declare_data_slist_next(xs);
-    }
-    return NULL;
+// The declaration is valid until the next declaration is registered or unregistered
+static _z_declare_data_t *_unsafe_z_get_declare(_z_session_t *zn, uint32_t id, uint8_t type,
+                                                _z_transport_peer_common_t *peer) {
+    _z_declare_id_t decl_id = {._peer = peer, ._id = id, ._type = type};
+    return _z_declare_data_hmap_get(&zn->_remote_declares, &decl_id);
 }
 
-static z_result_t _unsafe_z_unregister_declare(_z_session_t *zn, uint32_t id, uint8_t type) {
-    _z_declare_data_t decl = {._key = _z_keyexpr_null(), ._id = id, ._type = type, ._complete = false};
-    zn->_remote_declares = _z_declare_data_slist_drop_first_filter(zn->_remote_declares, _z_declare_data_eq, &decl);
+static z_result_t _unsafe_z_unregister_declare(_z_session_t *zn, uint32_t id, uint8_t type,
+                                               _z_transport_peer_common_t *peer) {
+    _z_declare_id_t decl_id = {._peer = peer, ._id = id, ._type = type};
+    _z_declare_data_t *decl = _z_declare_data_hmap_get(&zn->_remote_declares, &decl_id);
+    if (decl == NULL) {
+        return _Z_RES_OK;
+    }
+    _z_write_filter_unsafe_remove_remote(zn, decl);
+    _z_declare_data_hmap_remove(&zn->_remote_declares, &decl_id, NULL);
+#if Z_FEATURE_PEER_ROUTING == 1
+    _z_peer_route_table_invalidate(&zn->_peer_routes);
+#endif
     return _Z_RES_OK;
 }
 
@@ -470,18 +520,32 @@ z_result_t _z_interest_process_declares(_z_session_t *zn, const _z_n_msg_declare
 
     _Z_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn));
     msg.key = _z_keyexpr_view_deref(&key);
+    // ignore 0 id, since it is the one initially used by peers for declarations propagation
+    uint32_t interest_id = decl->_interest_id.has_value ? decl->_interest_id.value : 0;
     // NOTE: it is possible that it is a redeclare of an existing entity - so we might need to update it
-    _z_declare_data_t *prev_decl = _unsafe_z_get_declare(zn, msg.id, decl_type);
+    _z_declare_data_t *prev_decl = _unsafe_z_get_declare(zn, msg.id, decl_type, peer);
     if (prev_decl != NULL) {  // possible change in queryable completness
+        _z_write_filter_unsafe_remove_remote(zn, prev_decl);
         prev_decl->_complete = msg.is_complete;
+        // a declaration already meant for all the interests stays so
+        if (prev_decl->_interest_id != interest_id) {
+            prev_decl->_interest_id = 0;
+        }
+        _z_write_filter_unsafe_add_remote(zn, prev_decl);
     } else {
         // register new declare
-        _unsafe_z_register_declare(zn, _z_keyexpr_view_deref(&key), msg.id, decl_type, msg.is_complete, peer);
+        z_result_t ret = _unsafe_z_register_declare(zn, _z_keyexpr_view_deref(&key), msg.id, decl_type,
+                                                    msg.is_complete, interest_id, peer);
+        if (ret != _Z_RES_OK) {
+            _z_session_mutex_unlock(zn);
+            return ret;
+        }
     }
     // Retrieve interests
     _z_session_interest_rc_slist_t *intrs =
         __unsafe_z_get_interest_by_key_and_flags(zn, flags, _z_keyexpr_view_deref(&key), decl->_interest_id);
     _z_session_mutex_unlock(zn);
+    _z_write_filter_notify_pending(zn);
     // update interests with new value
     _z_session_interest_rc_slist_t *xs = intrs;
     while (xs != NULL) {
@@ -525,7 +589,7 @@ z_result_t _z_interest_process_undeclares(_z_session_t *zn, const _z_declaration
     }
     _Z_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn));
     // Retrieve declare data
-    _z_declare_data_t *prev_decl = _unsafe_z_get_declare(zn, msg.id, decl_type);
+    _z_declare_data_t *prev_decl = _unsafe_z_get_declare(zn, msg.id, decl_type, peer);
     if (prev_decl == NULL) {
         _z_session_mutex_unlock(zn);
         _Z_ERROR_RETURN(_Z_ERR_MESSAGE_ZENOH_DECLARATION_UNKNOWN);
@@ -533,8 +597,9 @@ z_result_t _z_interest_process_undeclares(_z_session_t *zn, const _z_declaration
     _z_session_interest_rc_slist_t *intrs =
         __unsafe_z_get_interest_by_key_and_flags(zn, flags, &prev_decl->_key, _z_optional_id_make_none());
     // Remove declare
-    _unsafe_z_unregister_declare(zn, msg.id, decl_type);
+    _unsafe_z_unregister_declare(zn, msg.id, decl_type, peer);
     _z_session_mutex_unlock(zn);
+    _z_write_filter_notify_pending(zn);
 
     // Parse session_interest list
     _z_session_interest_rc_slist_t *xs = intrs;
@@ -552,23 +617,41 @@ z_result_t _z_interest_process_undeclares(_z_session_t *zn, const _z_declaration
 
 void _z_unregister_interest(_z_session_t *zn, _z_session_interest_rc_t *intr) {
     _z_session_mutex_lock(zn);
-    zn->_local_interests =
-        _z_session_interest_rc_slist_drop_first_filter(zn->_local_interests, _z_session_interest_rc_eq, intr);
+    // The index refers to the list entry
+    _z_session_interest_rc_t *entry = __unsafe_z_get_interest_by_id(zn, _Z_RC_IN_VAL(intr)->_id);
+    if (entry != NULL) {
+        __unsafe_z_drop_interest(zn, entry);
+    }
     _z_session_mutex_unlock(zn);
 }
 
 void _z_interest_init(_z_session_t *zn) {
     _z_session_mutex_lock(zn);
     zn->_local_interests = NULL;
-    zn->_remote_declares = NULL;
+    _z_keyexpr_trie_init(&zn->_local_interests_index);
+    _z_declare_data_hmap_init(&zn->_remote_declares);
+    _z_keyexpr_trie_init(&zn->_write_filters);
+#if Z_FEATURE_MATCHING == 1
+    zn->_write_filters_pending = NULL;
+#endif
+#if Z_FEATURE_PEER_ROUTING == 1
+    _z_peer_route_table_init(&zn->_peer_routes);
+#endif
     _z_session_mutex_unlock(zn);
 }
 
 void _z_flush_interest(_z_session_t *zn) {
     _z_session_mutex_lock(zn);
+    _z_keyexpr_trie_clear(&zn->_local_interests_index);
     _z_session_interest_rc_slist_free(&zn->_local_interests);
-    _z_declare_data_slist_free(&zn->_remote_declares);
+    _z_declare_data_hmap_destroy(&zn->_remote_declares);
+    // The write filters are owned by their publishers and queriers
+    _z_keyexpr_trie_clear(&zn->_write_filters);
+#if Z_FEATURE_PEER_ROUTING == 1
+    _z_peer_route_table_clear(&zn->_peer_routes);
+#endif
     _z_session_mutex_unlock(zn);
+    _z_write_filter_drop_pending(zn);
 }
 
 z_result_t _z_interest_process_declare_final(_z_session_t *zn, uint32_t id, _z_transport_peer_common_t *peer) {
@@ -647,7 +730,22 @@ void _z_interest_peer_disconnected(_z_session_t *zn, _z_transport_peer_common_t
         return;
     }
     _z_session_interest_rc_slist_t *intrs = _z_session_interest_rc_slist_clone(zn->_local_interests);
+    // Forget the declarations of the peer, its address may be reused by the next one
+    _z_declare_data_hmap_iter_t it = _z_declare_data_hmap_begin(&zn->_remote_declares);
+    while (it != _z_declare_data_hmap_end(&zn->_remote_declares)) {
+        _z_declare_data_hmap_elem_t *entry = _z_declare_data_hmap_at(&zn->_remote_declares, it);
+        if (entry->key._peer == peer) {
+            _z_write_filter_unsafe_remove_remote(zn, &entry->val);
+            _z_declare_data_hmap_remove_at(&zn->_remote_declares, it, NULL, &it);
+        } else {
+            it = _z_declare_data_hmap_iter_next(&zn->_remote_declares, it);
+        }
+    }
+#if Z_FEATURE_PEER_ROUTING == 1
+    _z_peer_route_table_invalidate(&zn->_peer_routes);
+#endif
     _z_session_mutex_unlock(zn);
+    _z_write_filter_notify_pending(zn);
 
     // Parse session_interest list
     _z_interest_msg_t msg = {.id = 0, .type = _Z_INTEREST_MSG_TYPE_CONNECTION_DROPPED};
@@ -667,35 +765,40 @@ void _z_interest_replay_declare(_z_session_t *zn, _z_session_interest_t *interes
     if (_z_session_mutex_lock_if_open(zn) != _Z_RES_OK) {
         return;
     }
-    _z_declare_data_slist_t *res_list = _z_declare_data_slist_clone(zn->_remote_declares);
+    // Only the matching declarations are copied, for the callbacks to run without the lock
+    _z_declare_data_slist_t *res_list = NULL;
+    _z_declare_data_hmap_iter_t it = _z_declare_data_hmap_begin(&zn->_remote_declares);
+    for (; it != _z_declare_data_hmap_end(&zn->_remote_declares);
+         it = _z_declare_data_hmap_iter_next(&zn->_remote_declares, it)) {
+        const _z_declare_data_t *res = &_z_declare_data_hmap_at(&zn->_remote_declares, it)->val;
+        if (__z_interest_matches_key(interest, &res->_key)) {
+            res_list = _z_declare_data_slist_push_empty(res_list);
+            _z_declare_data_copy(_z_declare_data_slist_value(res_list), res);
+        }
+    }
     _z_session_mutex_unlock(zn);
 
     _z_declare_data_slist_t *xs = res_list;
     while (xs != NULL) {
         _z_declare_data_t *res = _z_declare_data_slist_value(xs);
-        bool is_matching = _z_session_interest_is_aggregate(interest)
-                               ? _z_keyexpr_equals(&interest->_key, &res->_key)
-                               : _z_keyexpr_intersects(&interest->_key, &res->_key);
-        if (is_matching) {
-            _z_interest_msg_t msg = {0};
-            msg.key = &res->_key;
-            msg.is_complete = res->_complete;
-            msg.id = res->_id;
-            switch (res->_type) {
-                default:
-                    break;
-                case _Z_DECLARE_TYPE_QUERYABLE:
-                    msg.type = _Z_INTEREST_MSG_TYPE_DECL_QUERYABLE;
-                    break;
-                case _Z_DECLARE_TYPE_SUBSCRIBER:
-                    msg.type = _Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER;
-                    break;
-                case _Z_DECLARE_TYPE_TOKEN:
-                    msg.type = _Z_INTEREST_MSG_TYPE_DECL_TOKEN;
-                    break;
-            }
-            interest->_callback(&msg, res->_peer, _Z_RC_IN_VAL(&interest->_arg));
+        _z_interest_msg_t msg = {0};
+        msg.key = &res->_key;
+        msg.is_complete = res->_complete;
+        msg.id = res->_id;
+        switch (res->_type) {
+            default:
+                break;
+            case _Z_DECLARE_TYPE_QUERYABLE:
+                msg.type = _Z_INTEREST_MSG_TYPE_DECL_QUERYABLE;
+                break;
+            case _Z_DECLARE_TYPE_SUBSCRIBER:
+                msg.type = _Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER;
+                break;
+            case _Z_DECLARE_TYPE_TOKEN:
+                msg.type = _Z_INTEREST_MSG_TYPE_DECL_TOKEN;
+                break;
         }
+        interest->_callback(&msg, res->_peer, _Z_RC_IN_VAL(&interest->_arg));
         xs = _z_declare_data_slist_next(xs);
     }
     _z_declare_data_slist_free(&res_list);
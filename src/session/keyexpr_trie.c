@@ -0,0 +1,312 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/session/keyexpr_trie.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "zenoh-pico/utils/logging.h"
+
+/*------------------ Chunk helpers ------------------*/
+static inline const char *_z_keyexpr_trie_chunk_end(const char *begin, const char *end) {
+    const char *sep = (const char *)memchr(begin, '/', (size_t)(end - begin));
+    return sep != NULL ? sep : end;
+}
+
+static inline const char *_z_keyexpr_trie_next_chunk(const char *chunk_end, const char *end) {
+    return chunk_end == end ? end : chunk_end + 1;
+}
+
+static inline bool _z_keyexpr_trie_chunk_is_double_star(const char *begin, const char *end) {
+    return (end - begin) == 2 && begin[0] == '*' && begin[1] == '*';
+}
+
+static inline bool _z_keyexpr_trie_chunk_is_wild(const char *begin, const char *end) {
+    return memchr(begin, '*', (size_t)(end - begin)) != NULL;
+}
+
+/*------------------ Node ------------------*/
+static void _z_keyexpr_trie_node_init(_z_keyexpr_trie_node_t *node) {
+    _z_keyexpr_trie_children_hmap_init(&node->_children);
+    node->_star = NULL;
+    node->_double_star = NULL;
+    _z_keyexpr_trie_value_vec_init(&node->_values);
+    node->_epoch = 0;
+}
+
+static _z_keyexpr_trie_node_t *_z_keyexpr_trie_node_new(void) {
+    _z_keyexpr_trie_node_t *node = (_z_keyexpr_trie_node_t *)z_malloc(sizeof(_z_keyexpr_trie_node_t));
+    if (node != NULL) {
+        _z_keyexpr_trie_node_init(node);
+    }
+    return node;
+}
+
+static void _z_keyexpr_trie_node_free(_z_keyexpr_trie_node_t **node);
+
+static void _z_keyexpr_trie_node_clear(_z_keyexpr_trie_node_t *node) {
+    for (_z_keyexpr_trie_children_hmap_iter_t it = _z_keyexpr_trie_children_hmap_begin(&node->_children);
+         it != _z_keyexpr_trie_children_hmap_end(&node->_children);
+         it = _z_keyexpr_trie_children_hmap_iter_next(&node->_children, it)) {
+        _z_keyexpr_trie_node_free(&_z_keyexpr_trie_children_hmap_at(&node->_children, it)->val);
+    }
+    _z_keyexpr_trie_children_hmap_destroy(&node->_children);
+    _z_keyexpr_trie_node_free(&node->_star);
+    _z_keyexpr_trie_node_free(&node->_double_star);
+    _z_keyexpr_trie_value_vec_destroy(&node->_values);
+    node->_epoch = 0;
+}
+
+static void _z_keyexpr_trie_node_free(_z_keyexpr_trie_node_t **node) {
+    if (*node != NULL) {
+        _z_keyexpr_trie_node_clear(*node);
+        z_free(*node);
+        *node = NULL;
+    }
+}
+
+static bool _z_keyexpr_trie_node_is_empty(const _z_keyexpr_trie_node_t *node) {
+    return _z_keyexpr_trie_value_vec_is_empty(&node->_values) && node->_star == NULL && node->_double_star == NULL &&
+           _z_keyexpr_trie_children_hmap_is_empty(&node->_children);
+}
+
+static void _z_keyexpr_trie_node_reset_epoch(_z_keyexpr_trie_node_t *node) {
+    node->_epoch = 0;
+    for (_z_keyexpr_trie_children_hmap_iter_t it = _z_keyexpr_trie_children_hmap_begin(&node->_children);
+         it != _z_keyexpr_trie_children_hmap_end(&node->_children);
+         it = _z_keyexpr_trie_children_hmap_iter_next(&node->_children, it)) {
+        _z_keyexpr_trie_node_reset_epoch(_z_keyexpr_trie_children_hmap_at(&node->_children, it)->val);
+    }
+    if (node->_star != NULL) {
+        _z_keyexpr_trie_node_reset_epoch(node->_star);
+    }
+    if (node->_double_star != NULL) {
+        _z_keyexpr_trie_node_reset_epoch(node->_double_star);
+    }
+}
+
+static _z_keyexpr_trie_node_t *_z_keyexpr_trie_node_get_or_create_child(_z_keyexpr_trie_node_t *node,
+                                                                        const char *begin, const char *end) {
+    if (_z_keyexpr_trie_chunk_is_double_star(begin, end)) {
+        if (node->_double_star == NULL) {
+            node->_double_star = _z_keyexpr_trie_node_new();
+        }
+        return node->_double_star;
+    }
+    if (_z_keyexpr_trie_chunk_is_wild(begin, end)) {
+        if (node->_star == NULL) {
+            node->_star = _z_keyexpr_trie_node_new();
+        }
+        return node->_star;
+    }
+    size_t len = (size_t)(end - begin);
+    _z_string_t chunk = _z_string_alias_substr(begin, len);
+    _z_keyexpr_trie_node_t **child = _z_keyexpr_trie_children_hmap_get(&node->_children, &chunk);
+    if (child != NULL) {
+        return *child;
+    }
+    _z_keyexpr_trie_node_t *new_child = _z_keyexpr_trie_node_new();
+    if (new_child == NULL) {
+        return NULL;
+    }
+    _z_string_t key = _z_string_copy_from_substr(begin, len);
+    if (len > 0 && !_z_string_check(&key)) {
+        z_free(new_child);
+        return NULL;
+    }
+    if (_z_keyexpr_trie_children_hmap_insert(&node->_children, &key, &new_child) ==
+        _z_keyexpr_trie_children_hmap_end(&node->_children)) {
+        _z_string_clear(&key);
+        z_free(new_child);
+        return NULL;
+    }
+    return new_child;
+}
+
+static bool _z_keyexpr_trie_node_remove(_z_keyexpr_trie_node_t *node, const char *it, const char *end,
+                                        const void *value) {
+    if (it >= end) {
+        for (size_t i = 0; i < _z_keyexpr_trie_value_vec_size(&node->_values); i++) {
+            if (*_z_keyexpr_trie_value_vec_get(&node->_values, i) == value) {
+                _z_keyexpr_trie_value_vec_swap_remove(&node->_values, i, NULL);
+                return true;
+            }
+        }
+        return false;
+    }
+    const char *chunk_end = _z_keyexpr_trie_chunk_end(it, end);
+    const char *next = _z_keyexpr_trie_next_chunk(chunk_end, end);
+    _z_keyexpr_trie_node_t **slot = NULL;
+    _z_keyexpr_trie_children_hmap_iter_t child_it = _z_keyexpr_trie_children_hmap_end(&node->_children);
+    if (_z_keyexpr_trie_chunk_is_double_star(it, chunk_end)) {
+        slot = &node->_double_star;
+    } else if (_z_keyexpr_trie_chunk_is_wild(it, chunk_end)) {
+        slot = &node->_star;
+    } else {
+        _z_string_t chunk = _z_string_alias_substr(it, (size_t)(chunk_end - it));
+        child_it = _z_keyexpr_trie_children_hmap_get_iter(&node->_children, &chunk);
+        if (child_it == _z_keyexpr_trie_children_hmap_end(&node->_children)) {
+            return false;
+        }
+        slot = &_z_keyexpr_trie_children_hmap_at(&node->_children, child_it)->val;
+    }
+    if (*slot == NULL || !_z_keyexpr_trie_node_remove(*slot, next, end, value)) {
+        return false;
+    }
+    // Prune the branch once it no longer leads to any value
+    if (_z_keyexpr_trie_node_is_empty(*slot)) {
+        _z_keyexpr_trie_node_free(slot);
+        if (child_it != _z_keyexpr_trie_children_hmap_end(&node->_children)) {
+            _z_keyexpr_trie_children_hmap_remove_at(&node->_children, child_it, NULL, NULL);
+        }
+    }
+    return true;
+}
+
+static z_result_t _z_keyexpr_trie_node_emit(_z_keyexpr_trie_node_t *node, size_t epoch, _z_keyexpr_trie_match_fn_t f,
+                                            void *arg) {
+    if (node->_epoch == epoch) {
+        return _Z_RES_OK;
+    }
+    node->_epoch = epoch;
+    for (size_t i = 0; i < _z_keyexpr_trie_value_vec_size(&node->_values); i++) {
+        _Z_RETURN_IF_ERR(f(*_z_keyexpr_trie_value_vec_get(&node->_values, i), arg));
+    }
+    return _Z_RES_OK;
+}
+
+static z_result_t _z_keyexpr_trie_node_visit_all(_z_keyexpr_trie_node_t *node, size_t epoch,
+                                                 _z_keyexpr_trie_match_fn_t f, void *arg) {
+    _Z_RETURN_IF_ERR(_z_keyexpr_trie_node_emit(node, epoch, f, arg));
+    for (_z_keyexpr_trie_children_hmap_iter_t it = _z_keyexpr_trie_children_hmap_begin(&node->_children);
+         it != _z_keyexpr_trie_children_hmap_end(&node->_children);
+         it = _z_keyexpr_trie_children_hmap_iter_next(&node->_children, it)) {
+        _Z_RETURN_IF_ERR(
+            _z_keyexpr_trie_node_visit_all(_z_keyexpr_trie_children_hmap_at(&node->_children, it)->val, epoch, f, arg));
+    }
+    if (node->_star != NULL) {
+        _Z_RETURN_IF_ERR(_z_keyexpr_trie_node_visit_all(node->_star, epoch, f, arg));
+    }
+    if (node->_double_star != NULL) {
+        _Z_RETURN_IF_ERR(_z_keyexpr_trie_node_visit_all(node->_double_star, epoch, f, arg));
+    }
+    return _Z_RES_OK;
+}
+
+static z_result_t _z_keyexpr_trie_node_match(_z_keyexpr_trie_node_t *node, const char *it, const char *end,
+                                             size_t epoch, _z_keyexpr_trie_match_fn_t f, void *arg) {
+    if (it >= end) {
+        _Z_RETURN_IF_ERR(_z_keyexpr_trie_node_emit(node, epoch, f, arg));
+        // A trailing `**` also matches an empty suffix
+        if (node->_double_star != NULL) {
+            _Z_RETURN_IF_ERR(_z_keyexpr_trie_node_match(node->_double_star, end, end, epoch, f, arg));
+        }
+        return _Z_RES_OK;
+    }
+    const char *chunk_end = _z_keyexpr_trie_chunk_end(it, end);
+    const char *next = _z_keyexpr_trie_next_chunk(chunk_end, end);
+    if (_z_keyexpr_trie_chunk_is_double_star(it, chunk_end)) {
+        // A `**` in the matched key spans any number of chunks: everything below this node is a candidate
+        return _z_keyexpr_trie_node_visit_all(node, epoch, f, arg);
+    }
+    if (_z_keyexpr_trie_chunk_is_wild(it, chunk_end)) {
+        for (_z_keyexpr_trie_children_hmap_iter_t child_it = _z_keyexpr_trie_children_hmap_begin(&node->_children);
+             child_it != _z_keyexpr_trie_children_hmap_end(&node->_children);
+             child_it = _z_keyexpr_trie_children_hmap_iter_next(&node->_children, child_it)) {
+            _Z_RETURN_IF_ERR(_z_keyexpr_trie_node_match(
+                _z_keyexpr_trie_children_hmap_at(&node->_children, child_it)->val, next, end, epoch, f, arg));
+        }
+    } else {
+        _z_string_t chunk = _z_string_alias_substr(it, (size_t)(chunk_end - it));
+        _z_keyexpr_trie_node_t **child = _z_keyexpr_trie_children_hmap_get(&node->_children, &chunk);
+        if (child != NULL) {
+            _Z_RETURN_IF_ERR(_z_keyexpr_trie_node_match(*child, next, end, epoch, f, arg));
+        }
+    }
+    if (node->_star != NULL) {
+        _Z_RETURN_IF_ERR(_z_keyexpr_trie_node_match(node->_star, next, end, epoch, f, arg));
+    }
+    if (node->_double_star != NULL) {
+        // `**` absorbs any number of chunks, including none
+        const char *suffix = it;
+        while (true) {
+            _Z_RETURN_IF_ERR(_z_keyexpr_trie_node_match(node->_double_star, suffix, end, epoch, f, arg));
+            if (suffix >= end) {
+                break;
+            }
+            suffix = _z_keyexpr_trie_next_chunk(_z_keyexpr_trie_chunk_end(suffix, end), end);
+        }
+    }
+    return _Z_RES_OK;
+}
+
+/*------------------ Trie ------------------*/
+void _z_keyexpr_trie_init(_z_keyexpr_trie_t *trie) {
+    _z_keyexpr_trie_node_init(&trie->_root);
+    trie->_epoch = 0;
+    trie->_len = 0;
+}
+
+void _z_keyexpr_trie_clear(_z_keyexpr_trie_t *trie) {
+    _z_keyexpr_trie_node_clear(&trie->_root);
+    trie->_epoch = 0;
+    trie->_len = 0;
+}
+
+z_result_t _z_keyexpr_trie_insert(_z_keyexpr_trie_t *trie, const _z_keyexpr_t *key, void *value) {
+    const char *it = _z_string_data(&key->_keyexpr);
+    const char *end = it + _z_string_len(&key->_keyexpr);
+    _z_keyexpr_trie_node_t *node = &trie->_root;
+    while (it < end) {
+        const char *chunk_end = _z_keyexpr_trie_chunk_end(it, end);
+        node = _z_keyexpr_trie_node_get_or_create_child(node, it, chunk_end);
+        if (node == NULL) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+        it = _z_keyexpr_trie_next_chunk(chunk_end, end);
+    }
+    if (!_z_keyexpr_trie_value_vec_push_back(&node->_values, &value)) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    trie->_len++;
+    return _Z_RES_OK;
+}
+
+bool _z_keyexpr_trie_remove(_z_keyexpr_trie_t *trie, const _z_keyexpr_t *key, const void *value) {
+    const char *it = _z_string_data(&key->_keyexpr);
+    const char *end = it + _z_string_len(&key->_keyexpr);
+    if (!_z_keyexpr_trie_node_remove(&trie->_root, it, end, value)) {
+        return false;
+    }
+    trie->_len--;
+    return true;
+}
+
+z_result_t _z_keyexpr_trie_match(_z_keyexpr_trie_t *trie, const _z_keyexpr_t *key, _z_keyexpr_trie_match_fn_t f,
+                                 void *arg) {
+    if (trie->_len == 0) {
+        return _Z_RES_OK;
+    }
+    // Nodes remember the epoch of the last match that reported them, so that a node reachable through several
+    // wildcard paths is only reported once. Epoch 0 is reserved for nodes that have never been reported.
+    trie->_epoch++;
+    if (trie->_epoch == 0) {
+        _z_keyexpr_trie_node_reset_epoch(&trie->_root);
+        trie->_epoch = 1;
+    }
+    const char *it = _z_string_data(&key->_keyexpr);
+    const char *end = it + _z_string_len(&key->_keyexpr);
+    return _z_keyexpr_trie_node_match(&trie->_root, it, end, trie->_epoch, f, arg);
+}
@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/session/peer_routing.h"
+
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/utils/hash.h"
+
+#if Z_FEATURE_PEER_ROUTING == 1
+void _z_peer_route_table_init(_z_peer_route_table_t *table) {
+    for (size_t i = 0; i < Z_PEER_ROUTE_TABLE_SIZE; i++) {
+        table->_entries[i]._key = _z_string_null();
+        table->_entries[i]._route = _z_peer_route_null();
+        table->_entries[i]._generation = 0;
+        table->_entries[i]._type = 0;
+    }
+    // Entries of generation 0 are never valid
+    table->_generation = 1;
+    table->_hits = 0;
+    table->_misses = 0;
+}
+
+void _z_peer_route_table_clear(_z_peer_route_table_t *table) {
+    for (size_t i = 0; i < Z_PEER_ROUTE_TABLE_SIZE; i++) {
+        _z_string_clear(&table->_entries[i]._key);
+        _z_peer_route_clear(&table->_entries[i]._route);
+    }
+    _z_peer_route_table_init(table);
+}
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static z_result_t _z_peer_route_entry_fill(_z_session_t *zn, _z_peer_route_entry_t *entry, const _z_keyexpr_t *key,
+                                           uint8_t type) {
+    entry->_generation = 0;
+    _z_string_clear(&entry->_key);
+    _z_peer_route_reset(&entry->_route, true, true);
+    _z_declare_data_hmap_iter_t it = _z_declare_data_hmap_begin(&zn->_remote_declares);
+    for (; it != _z_declare_data_hmap_end(&zn->_remote_declares);
+         it = _z_declare_data_hmap_iter_next(&zn->_remote_declares, it)) {
+        const _z_declare_data_t *decl = &_z_declare_data_hmap_at(&zn->_remote_declares, it)->val;
+        if ((decl->_type == type) && (decl->_peer != NULL) && _z_keyexpr_intersects(&decl->_key, key)) {
+            _Z_RETURN_IF_ERR(_z_peer_route_add(&entry->_route, decl->_peer));
+        }
+    }
+    entry->_key = _z_string_copy_from_substr(_z_string_data(&key->_keyexpr), _z_string_len(&key->_keyexpr));
+    if (!_z_string_check(&entry->_key)) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    entry->_type = type;
+    entry->_generation = zn->_peer_routes._generation;
+    return _Z_RES_OK;
+}
+
+void _z_peer_route_table_lookup(_z_session_t *zn, const _z_network_message_t *n_msg, _z_peer_route_t *route) {
+    _z_peer_route_reset(route, false, false);
+    const _z_wireexpr_t *wireexpr = NULL;
+    uint8_t type = 0;
+    if (n_msg->_tag == _Z_N_PUSH) {
+        wireexpr = &n_msg->_body._push._key;
+        type = _Z_DECLARE_TYPE_SUBSCRIBER;
+    } else if ((n_msg->_tag == _Z_N_REQUEST) && (n_msg->_body._request._tag == _Z_REQUEST_QUERY)) {
+        wireexpr = &n_msg->_body._request._key;
+        type = _Z_DECLARE_TYPE_QUERYABLE;
+    } else {
+        return;
+    }
+    _z_keyexpr_view_t key_view;
+    char buf[Z_MAX_KEYEXPR_LENGTH];
+    if (_z_get_keyexpr_view_from_wireexpr(zn, &key_view, wireexpr, NULL, buf, Z_MAX_KEYEXPR_LENGTH) != _Z_RES_OK) {
+        return;
+    }
+    const _z_keyexpr_t *key = _z_keyexpr_view_deref(&key_view);
+    size_t hash =
+        _z_hash_bytes((const uint8_t *)_z_string_data(&key->_keyexpr), _z_string_len(&key->_keyexpr)) + type;
+
+    if (_z_session_mutex_lock_if_open(zn) != _Z_RES_OK) {
+        return;
+    }
+    _z_peer_route_table_t *table = &zn->_peer_routes;
+    _z_peer_route_entry_t *entry = &table->_entries[hash % Z_PEER_ROUTE_TABLE_SIZE];
+    z_result_t ret = _Z_RES_OK;
+    if ((entry->_generation == table->_generation) && (entry->_type == type) &&
+        _z_string_equals(&entry->_key, &key->_keyexpr)) {
+        table->_hits++;
+    } else {
+        table->_misses++;
+        ret = _z_peer_route_entry_fill(zn, entry, key, type);
+    }
+    if ((ret != _Z_RES_OK) || (_z_peer_route_copy(route, &entry->_route) != _Z_RES_OK)) {
+        // Out of memory, all the peers get the message
+        _z_peer_route_reset(route, false, false);
+    }
+    _z_session_mutex_unlock(zn);
+}
+#endif
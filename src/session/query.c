@@ -15,6 +15,8 @@
 #include "zenoh-pico/session/query.h"
 
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/net/reply.h"
@@ -45,27 +47,149 @@ bool _z_pending_query_querier_eq(const _z_pending_query_t *one, const _z_pending
     return one->_querier_id.has_value == two->_querier_id.has_value && one->_querier_id.value == two->_querier_id.value;
 }
 
-static bool _z_pending_query_timeout(const _z_pending_query_t *foo, const _z_pending_query_t *pq) {
-    _ZP_UNUSED(foo);
-    bool result = z_clock_elapsed_ms((z_clock_t *)&pq->_start_time) >= pq->_timeout;
-    if (result) {
-        _Z_INFO("Dropping query because of timeout");
+// Largest deadline on top, to pick the soonest ones when they do not all fit in the queue
+static inline int _z_pending_query_deadline_rev_cmp(const _z_pending_query_deadline_t *a,
+                                                    const _z_pending_query_deadline_t *b) {
+    return _z_pending_query_deadline_cmp(b, a);
+}
+
+#define _ZP_STATIC_PQUEUE_TEMPLATE_ELEM_TYPE _z_pending_query_deadline_t
+#define _ZP_STATIC_PQUEUE_TEMPLATE_NAME _z_pending_query_deadline_rev_pqueue
+#define _ZP_STATIC_PQUEUE_TEMPLATE_ELEM_CMP_FN _z_pending_query_deadline_rev_cmp
+#define _ZP_STATIC_PQUEUE_TEMPLATE_SIZE Z_QUERY_DEADLINE_QUEUE_SIZE
+#include "zenoh-pico/collections/static_pqueue_template.h"
+
+void _z_unsafe_pending_query_sort_deadlines(_z_session_t *zn) {
+    _z_pending_query_deadline_rev_pqueue_t soonest = _z_pending_query_deadline_rev_pqueue_new();
+    uint64_t horizon_ms = UINT64_MAX;
+    for (_z_pending_query_hmap_iter_t it = _z_pending_query_hmap_begin(&zn->_pending_queries);
+         it != _z_pending_query_hmap_end(&zn->_pending_queries);
+         it = _z_pending_query_hmap_iter_next(&zn->_pending_queries, it)) {
+        const _z_pending_query_t *pq = _z_pending_query_hmap_at(&zn->_pending_queries, it)->val;
+        _z_pending_query_deadline_t deadline = {._deadline_ms = pq->_deadline_ms, ._id = pq->_id};
+        if (_z_pending_query_deadline_rev_pqueue_push(&soonest, &deadline)) {
+            continue;
+        }
+        // Full, keep the soonest of the latest one and this one
+        _z_pending_query_deadline_t *latest = _z_pending_query_deadline_rev_pqueue_peek(&soonest);
+        if (_z_pending_query_deadline_cmp(&deadline, latest) < 0) {
+            _z_pending_query_deadline_t left;
+            _z_pending_query_deadline_rev_pqueue_pop(&soonest, &left);
+            _z_pending_query_deadline_rev_pqueue_push(&soonest, &deadline);
+            deadline = left;
+        }
+        horizon_ms = (deadline._deadline_ms < horizon_ms) ? deadline._deadline_ms : horizon_ms;
+    }
+    _z_pending_query_deadline_pqueue_destroy(&zn->_pending_query_deadlines);
+    _z_pending_query_deadline_t deadline;
+    while (_z_pending_query_deadline_rev_pqueue_pop(&soonest, &deadline)) {
+        _z_pending_query_deadline_pqueue_push(&zn->_pending_query_deadlines, &deadline);
+    }
+    zn->_pending_query_deadlines_horizon = horizon_ms;
+}
+
+// Drop the expired queries, some of them being left out of the deadline queue, and sort the deadlines again
+static void _z_unsafe_pending_query_expire_all(_z_session_t *zn, uint64_t now_ms) {
+    _z_pending_query_hmap_iter_t it = _z_pending_query_hmap_begin(&zn->_pending_queries);
+    while (it != _z_pending_query_hmap_end(&zn->_pending_queries)) {
+        if (_z_pending_query_hmap_at(&zn->_pending_queries, it)->val->_deadline_ms <= now_ms) {
+            _Z_INFO("Dropping query because of timeout");
+            _z_pending_query_hmap_remove_at(&zn->_pending_queries, it, NULL, &it);
+        } else {
+            it = _z_pending_query_hmap_iter_next(&zn->_pending_queries, it);
+        }
+    }
+    _z_unsafe_pending_query_sort_deadlines(zn);
+}
+
+uint64_t _z_unsafe_pending_query_expire(_z_session_t *zn) {
+    uint64_t now_ms = (uint64_t)z_clock_elapsed_ms(&zn->_pending_query_epoch);
+    for (;;) {
+        _z_pending_query_deadline_t *top = _z_pending_query_deadline_pqueue_peek(&zn->_pending_query_deadlines);
+        if (top == NULL || top->_deadline_ms >= zn->_pending_query_deadlines_horizon) {
+            if (zn->_pending_query_deadlines_horizon > now_ms) {
+                return zn->_pending_query_deadlines_horizon;
+            }
+            _z_unsafe_pending_query_expire_all(zn, now_ms);
+            continue;
+        }
+        _z_pending_query_deadline_t deadline = *top;
+        // Queries done before their deadline left their entry behind
+        bool pending = _z_pending_query_hmap_contains(&zn->_pending_queries, &deadline._id);
+        if (pending && deadline._deadline_ms > now_ms) {
+            return deadline._deadline_ms;
+        }
+        _z_pending_query_deadline_pqueue_pop(&zn->_pending_query_deadlines, &deadline);
+        if (pending) {
+            _Z_INFO("Dropping query because of timeout");
+            _z_pending_query_hmap_remove(&zn->_pending_queries, &deadline._id, NULL);
+        }
     }
-    return result;
 }
 
 void _z_pending_query_process_timeout(_z_session_t *zn) {
     _z_session_mutex_lock(zn);
-    // Extract all queries with timeout elapsed
-    zn->_pending_queries = _z_pending_query_slist_drop_all_filter(zn->_pending_queries, _z_pending_query_timeout, NULL);
+    _z_unsafe_pending_query_expire(zn);
     _z_session_mutex_unlock(zn);
 }
 
-_z_fut_fn_result_t _z_pending_query_process_timeout_task_fn(void *session_arg, _z_executor_t *executor) {
+typedef struct {
+    _z_session_t *_zn;
+    size_t _gen;
+} _z_pending_query_timer_t;
+
+static _z_fut_fn_result_t _z_pending_query_process_timeout_task_fn(void *timer_arg, _z_executor_t *executor) {
     _ZP_UNUSED(executor);
-    _z_session_t *zn = (_z_session_t *)session_arg;
-    _z_pending_query_process_timeout(zn);
-    return _z_fut_fn_result_wake_up_after(1000);
+    _z_pending_query_timer_t *timer = (_z_pending_query_timer_t *)timer_arg;
+    _z_session_t *zn = timer->_zn;
+    _z_session_mutex_lock(zn);
+    uint64_t next_ms = _z_unsafe_pending_query_expire(zn);
+    if (timer->_gen != zn->_pending_query_timer_gen) {
+        if (zn->_pending_query_timer_ms != UINT64_MAX) {
+            // A timer spawned for an earlier deadline took over
+            _z_session_mutex_unlock(zn);
+            return _z_fut_fn_result_ready();
+        }
+        // The one that should have taken over could not be spawned
+        timer->_gen = ++zn->_pending_query_timer_gen;
+    }
+    zn->_pending_query_timer_ms = next_ms;
+    _z_session_mutex_unlock(zn);
+    if (next_ms == UINT64_MAX) {
+        // The next registered query spawns a new timer
+        return _z_fut_fn_result_ready();
+    }
+    uint64_t now_ms = (uint64_t)z_clock_elapsed_ms(&zn->_pending_query_epoch);
+    return _z_fut_fn_result_wake_up_after((unsigned long)((next_ms > now_ms) ? next_ms - now_ms : 0));
+}
+
+void _z_pending_query_arm_timer(_z_session_t *zn) {
+    _z_session_mutex_lock(zn);
+    if (!zn->_pending_query_timer_rearm) {
+        _z_session_mutex_unlock(zn);
+        return;
+    }
+    zn->_pending_query_timer_rearm = false;
+    size_t gen = ++zn->_pending_query_timer_gen;
+    _z_session_mutex_unlock(zn);
+
+    _z_pending_query_timer_t *timer = (_z_pending_query_timer_t *)z_malloc(sizeof(_z_pending_query_timer_t));
+    bool spawned = false;
+    if (timer != NULL) {
+        timer->_zn = zn;
+        timer->_gen = gen;
+        _z_fut_t fut = _z_fut_new(timer, _z_pending_query_process_timeout_task_fn, z_free);
+        spawned = !_z_fut_handle_is_null(_z_runtime_spawn(&zn->_runtime, &fut));
+    }
+    if (!spawned) {
+        _Z_ERROR("Failed to spawn the query timeout timer");
+        _z_session_mutex_lock(zn);
+        if (zn->_pending_query_timer_gen == gen) {
+            // Let the timers of older generations, if any, keep going
+            zn->_pending_query_timer_ms = UINT64_MAX;
+        }
+        _z_session_mutex_unlock(zn);
+    }
 }
 
 /*------------------ Query ------------------*/
@@ -75,31 +199,43 @@ _z_fut_fn_result_t _z_pending_query_process_timeout_task_fn(void *session_arg, _
  *  - zn->_mutex_inner
  */
 _z_pending_query_t *_z_unsafe_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id) {
-    _z_pending_query_t *ret = NULL;
-
-    _z_pending_query_slist_t *xs = zn->_pending_queries;
-    while (xs != NULL) {
-        _z_pending_query_t *pql = _z_pending_query_slist_value(xs);
-        if (pql->_id == id) {
-            ret = pql;
-            break;
-        }
-
-        xs = _z_pending_query_slist_next(xs);
-    }
-    return ret;
+    _z_pending_query_t **pq = _z_pending_query_hmap_get(&zn->_pending_queries, &id);
+    return (pq != NULL) ? *pq : NULL;
 }
 
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
  *  - zn->_mutex_inner
+ *
+ * A timer may have to be spawned for the query deadline, call _z_pending_query_arm_timer once the mutex is released.
  */
-_z_pending_query_t *_z_unsafe_register_pending_query(_z_session_t *zn) {
-    _z_zint_t qid = zn->_query_id++;
-    zn->_pending_queries = _z_pending_query_slist_push_empty(zn->_pending_queries);
-    _z_pending_query_t *pq = _z_pending_query_slist_value(zn->_pending_queries);
-    pq->_id = qid;
+_z_pending_query_t *_z_unsafe_register_pending_query(_z_session_t *zn, uint64_t timeout_ms) {
+    _z_pending_query_t *pq = (_z_pending_query_t *)z_malloc(sizeof(_z_pending_query_t));
+    if (pq == NULL) {
+        return NULL;
+    }
+    memset(pq, 0, sizeof(_z_pending_query_t));
+    pq->_id = zn->_query_id++;
+    pq->_deadline_ms = (uint64_t)z_clock_elapsed_ms(&zn->_pending_query_epoch) + timeout_ms;
+    _z_zint_t qid = pq->_id;
+    if (_z_pending_query_hmap_insert(&zn->_pending_queries, &qid, &pq) ==
+        _z_pending_query_hmap_end(&zn->_pending_queries)) {
+        z_free(pq);
+        return NULL;
+    }
+    // Later deadlines are found when the queue is sorted again
+    if (pq->_deadline_ms < zn->_pending_query_deadlines_horizon) {
+        _z_pending_query_deadline_t deadline = {._deadline_ms = pq->_deadline_ms, ._id = qid};
+        if (!_z_pending_query_deadline_pqueue_push(&zn->_pending_query_deadlines, &deadline)) {
+            // Make room by dropping the entries of the queries already done
+            _z_unsafe_pending_query_sort_deadlines(zn);
+        }
+    }
+    if (pq->_deadline_ms < zn->_pending_query_timer_ms) {
+        zn->_pending_query_timer_ms = pq->_deadline_ms;
+        zn->_pending_query_timer_rearm = true;
+    }
     return pq;
 }
 
@@ -261,16 +397,14 @@ z_result_t _z_trigger_query_reply_final(_z_session_t *zn, _z_zint_t id) {
     }
     // Finalize query if requested: drop pending query and trigger dropper callback,
     // which is equivalent to a reply with FINAL.
-    zn->_pending_queries = _z_pending_query_slist_drop_first_filter(zn->_pending_queries, _z_pending_query_eq, pen_qry);
+    _z_pending_query_hmap_remove(&zn->_pending_queries, &id, NULL);
     _z_session_mutex_unlock(zn);
     return _Z_RES_OK;
 }
 
 void _z_unregister_pending_query(_z_session_t *zn, _z_zint_t qid) {
-    _z_pending_query_t target = {0};
-    target._id = qid;
     _z_session_mutex_lock(zn);
-    zn->_pending_queries = _z_pending_query_slist_drop_first_filter(zn->_pending_queries, _z_pending_query_eq, &target);
+    _z_pending_query_hmap_remove(&zn->_pending_queries, &qid, NULL);
     _z_session_mutex_unlock(zn);
 }
 
@@ -278,17 +412,25 @@ void _z_unregister_pending_queries_from_querier(_z_session_t *zn, uint32_t queri
     _z_pending_query_t target = {0};
     target._querier_id = _z_optional_id_make_some(querier_id);
     _z_session_mutex_lock(zn);
-    zn->_pending_queries =
-        _z_pending_query_slist_drop_all_filter(zn->_pending_queries, _z_pending_query_querier_eq, &target);
+    _z_pending_query_hmap_iter_t it = _z_pending_query_hmap_begin(&zn->_pending_queries);
+    while (it != _z_pending_query_hmap_end(&zn->_pending_queries)) {
+        if (_z_pending_query_querier_eq(_z_pending_query_hmap_at(&zn->_pending_queries, it)->val, &target)) {
+            _z_pending_query_hmap_remove_at(&zn->_pending_queries, it, NULL, &it);
+        } else {
+            it = _z_pending_query_hmap_iter_next(&zn->_pending_queries, it);
+        }
+    }
     _z_session_mutex_unlock(zn);
 }
 
 void _z_flush_pending_queries(_z_session_t *zn) {
     _z_session_mutex_lock(zn);
-    _z_pending_query_slist_t *queries = zn->_pending_queries;
-    zn->_pending_queries = _z_pending_query_slist_new();
+    _z_pending_query_hmap_t queries = zn->_pending_queries;
+    _z_pending_query_hmap_init(&zn->_pending_queries);
+    _z_pending_query_deadline_pqueue_destroy(&zn->_pending_query_deadlines);
+    zn->_pending_query_deadlines_horizon = UINT64_MAX;
     _z_session_mutex_unlock(zn);
-    _z_pending_query_slist_free(&queries);
+    _z_pending_query_hmap_destroy(&queries);
 }
 #ifdef Z_FEATURE_UNSTABLE_API
 
@@ -58,43 +58,109 @@ uint32_t _z_get_entity_id(_z_session_t *zn) { return zn->_entity_id++; }
 
 uint16_t _z_get_resource_id(_z_session_t *zn) { return zn->_resource_id++; }
 
-/*------------------ Resource ------------------*/
-_z_resource_t *_z_get_resource_by_id_inner(_z_resource_slist_t *rl, const _z_zint_t id) {
-    _z_resource_t *ret = NULL;
-
-    _z_resource_slist_t *xs = rl;
-    while (xs != NULL) {
-        _z_resource_t *r = _z_resource_slist_value(xs);
-        if (r->_id == id) {
-            ret = r;
-            break;
-        }
-
-        xs = _z_resource_slist_next(xs);
+/*------------------ Resource table ------------------*/
+static _z_resource_table_t *_z_resource_table_new(void) {
+    _z_resource_table_t *table = (_z_resource_table_t *)z_malloc(sizeof(_z_resource_table_t));
+    if (table != NULL) {
+        _z_resource_id_hmap_init(&table->_by_id);
+        _z_resource_key_hmap_init(&table->_by_key);
     }
+    return table;
+}
 
-    return ret;
+void _z_resource_table_free(_z_resource_table_t **table) {
+    _z_resource_table_t *ptr = *table;
+    if (ptr != NULL) {
+        // The key index aliases the resources keys, drop it first
+        _z_resource_key_hmap_destroy(&ptr->_by_key);
+        _z_resource_id_hmap_destroy(&ptr->_by_id);
+        z_free(ptr);
+        *table = NULL;
+    }
 }
 
-_z_resource_t *_z_get_resource_by_key_inner(_z_resource_slist_t *rl, const _z_keyexpr_t *keyexpr) {
-    _z_resource_t *ret = NULL;
-    _z_resource_slist_t *xs = rl;
-    while (xs != NULL) {
-        _z_resource_t *r = _z_resource_slist_value(xs);
-        if (_z_keyexpr_equals(&r->_key, keyexpr)) {
-            ret = r;
-            break;
+static void _z_resource_table_remove(_z_resource_table_t *table, _z_resource_id_hmap_iter_t it) {
+    _z_resource_t *res = &_z_resource_id_hmap_at(&table->_by_id, it)->val;
+    _z_resource_key_hmap_iter_t key_it = _z_resource_key_hmap_get_iter(&table->_by_key, &res->_key);
+    if (key_it != _z_resource_key_hmap_end(&table->_by_key)) {
+        _z_resource_key_hmap_elem_t *node = _z_resource_key_hmap_at(&table->_by_key, key_it);
+        node->val._count--;
+        bool is_indexed = node->val._id == res->_id;
+        bool is_aliased = _z_string_data(&node->key._keyexpr) == _z_string_data(&res->_key._keyexpr);
+        if ((node->val._count == 0) || is_indexed || is_aliased) {
+            // Index the key with a remaining declaration, preferably the indexed one
+            _z_resource_key_entry_t entry = node->val;
+            _z_resource_t *other = NULL;
+            for (_z_resource_id_hmap_iter_t i = _z_resource_id_hmap_begin(&table->_by_id);
+                 (entry._count > 0) && (i != _z_resource_id_hmap_end(&table->_by_id));
+                 i = _z_resource_id_hmap_iter_next(&table->_by_id, i)) {
+                _z_resource_t *candidate = &_z_resource_id_hmap_at(&table->_by_id, i)->val;
+                if ((i != it) && _z_keyexpr_equals(&candidate->_key, &res->_key) &&
+                    ((other == NULL) || (candidate->_id == entry._id))) {
+                    other = candidate;
+                }
+            }
+            _z_resource_key_hmap_remove_at(&table->_by_key, key_it, NULL, NULL);
+            if (other != NULL) {
+                entry._id = is_indexed ? other->_id : entry._id;
+                _z_keyexpr_t key_alias = {._keyexpr = _z_string_alias(other->_key._keyexpr)};
+                // Can't fail, the map has just shrunk
+                (void)_z_resource_key_hmap_insert(&table->_by_key, &key_alias, &entry);
+            }
         }
+    }
+    _z_resource_id_hmap_remove_at(&table->_by_id, it, NULL, NULL);
+}
 
-        xs = _z_resource_slist_next(xs);
+// Takes ownership of the resource key. A resource previously stored under the same id is replaced.
+static z_result_t _z_resource_table_insert(_z_resource_table_t *table, _z_resource_t *res) {
+    _z_resource_id_hmap_iter_t it = _z_resource_id_hmap_get_iter(&table->_by_id, &res->_id);
+    if (it != _z_resource_id_hmap_end(&table->_by_id)) {
+        _z_resource_table_remove(table, it);
+    }
+    uint16_t id = res->_id;
+    it = _z_resource_id_hmap_insert(&table->_by_id, &id, res);
+    if (it == _z_resource_id_hmap_end(&table->_by_id)) {
+        _z_resource_clear(res);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
+    // Index the key of the most recent declaration, the string storage is owned by an id map entry
+    _z_resource_t *stored = &_z_resource_id_hmap_at(&table->_by_id, it)->val;
+    _z_resource_key_entry_t *entry = _z_resource_key_hmap_get(&table->_by_key, &stored->_key);
+    if (entry != NULL) {
+        entry->_id = id;
+        entry->_count++;
+        return _Z_RES_OK;
+    }
+    _z_keyexpr_t key_alias = {._keyexpr = _z_string_alias(stored->_key._keyexpr)};
+    _z_resource_key_entry_t first = {._id = id, ._count = 1};
+    if (_z_resource_key_hmap_insert(&table->_by_key, &key_alias, &first) ==
+        _z_resource_key_hmap_end(&table->_by_key)) {
+        _z_resource_id_hmap_remove_at(&table->_by_id, it, NULL, NULL);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
+}
 
-    return ret;
+/*------------------ Resource ------------------*/
+_z_resource_t *_z_get_resource_by_id_inner(_z_resource_table_t *table, uint16_t id) {
+    if (table == NULL) {
+        return NULL;
+    }
+    return _z_resource_id_hmap_get(&table->_by_id, &id);
 }
 
-static z_result_t _z_get_keyexpr_from_wireexpr_inner(_z_resource_slist_t *xs, const _z_wireexpr_t *expr, char **buf,
-                                                     size_t *buf_len) {
-    _z_zint_t id = expr->_id;
+_z_resource_t *_z_get_resource_by_key_inner(_z_resource_table_t *table, const _z_keyexpr_t *keyexpr) {
+    if (table == NULL) {
+        return NULL;
+    }
+    _z_resource_key_entry_t *entry = _z_resource_key_hmap_get(&table->_by_key, keyexpr);
+    return entry == NULL ? NULL : _z_resource_id_hmap_get(&table->_by_id, &entry->_id);
+}
+
+static z_result_t _z_get_keyexpr_from_wireexpr_inner(_z_resource_table_t *table, const _z_wireexpr_t *expr,
+                                                     char **buf, size_t *buf_len) {
+    uint16_t id = expr->_id;
     size_t prefix_len = 0;
     size_t suffix_len = 0;
     const _z_string_t *suffix = NULL;
@@ -106,7 +172,7 @@ static z_result_t _z_get_keyexpr_from_wireexpr_inner(_z_resource_slist_t *xs, co
     }
 
     if (id != Z_RESOURCE_ID_NONE) {
-        _z_resource_t *res = _z_get_resource_by_id_inner(xs, id);
+        _z_resource_t *res = _z_get_resource_by_id_inner(table, id);
         if (res == NULL) {
             return _Z_ERR_KEYEXPR_UNKNOWN;
         }
@@ -145,7 +211,7 @@ z_result_t _z_get_keyexpr_view_from_wireexpr(_z_session_t *zn, _z_keyexpr_view_t
             return _Z_RES_OK;
         }
         _z_session_mutex_lock(zn);
-        _z_resource_slist_t *decls =
+        _z_resource_table_t *decls =
             (_z_wireexpr_is_local(expr) || (peer == NULL)) ? zn->_local_resources : peer->_remote_resources;
         ret = _z_get_keyexpr_from_wireexpr_inner(decls, expr, &out_buf, &out_buf_len);
         _z_session_mutex_unlock(zn);
@@ -163,7 +229,7 @@ z_result_t _z_get_keyexpr_from_wireexpr(_z_session_t *zn, _z_keyexpr_t *out, con
     z_result_t ret = _Z_ERR_NULL;
     if (expr != NULL && _z_wireexpr_check(expr)) {
         _z_session_mutex_lock(zn);
-        _z_resource_slist_t *decls =
+        _z_resource_table_t *decls =
             (_z_wireexpr_is_local(expr) || (peer == NULL)) ? zn->_local_resources : peer->_remote_resources;
         char *buf = NULL;
         size_t buf_len = 0;
@@ -179,8 +245,8 @@ z_result_t _z_get_keyexpr_from_wireexpr(_z_session_t *zn, _z_keyexpr_t *out, con
 
 z_result_t _z_register_resource_inner(_z_session_t *zn, const _z_wireexpr_t *expr, uint16_t id,
                                       _z_transport_peer_common_t *peer, uint16_t *out_id) {
-    _z_resource_slist_t **resources = (peer == NULL) ? &zn->_local_resources : &peer->_remote_resources;
-    _z_resource_slist_t *parent_resources =
+    _z_resource_table_t **resources = (peer == NULL) ? &zn->_local_resources : &peer->_remote_resources;
+    _z_resource_table_t *parent_resources =
         (expr->_mapping == _Z_KEYEXPR_MAPPING_LOCAL) ? zn->_local_resources : peer->_remote_resources;
 
     _z_keyexpr_t new_key = _z_keyexpr_null();
@@ -224,13 +290,19 @@ z_result_t _z_register_resource_inner(_z_session_t *zn, const _z_wireexpr_t *exp
         _Z_RETURN_IF_ERR(_z_keyexpr_copy(&ke, _z_keyexpr_view_deref(&ke_view)));
     }
 
-    *resources = _z_resource_slist_push_empty(*resources);
-    _z_resource_t *res = _z_resource_slist_value(*resources);
-    res->_refcount = 1;
-    res->_key = ke;
-    res->_id = id == Z_RESOURCE_ID_NONE ? _z_get_resource_id(zn) : id;
-    *out_id = res->_id;
-    return _Z_RES_OK;
+    if (*resources == NULL) {
+        *resources = _z_resource_table_new();
+        if (*resources == NULL) {
+            _z_keyexpr_clear(&ke);
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+    }
+    _z_resource_t res;
+    res._refcount = 1;
+    res._key = ke;
+    res._id = id == Z_RESOURCE_ID_NONE ? _z_get_resource_id(zn) : id;
+    *out_id = res._id;
+    return _z_resource_table_insert(*resources, &res);
 }
 
 z_result_t _z_register_resource(_z_session_t *zn, const _z_wireexpr_t *expr, uint16_t id,
@@ -246,18 +318,16 @@ z_result_t _z_unregister_resource(_z_session_t *zn, uint16_t id, _z_transport_pe
     bool is_local = (peer == NULL);
     _Z_DEBUG("unregistering: id %d, mapping: %s", id, is_local ? "local" : "remote");
     _z_session_mutex_lock(zn);
-    _z_resource_slist_t **resources = is_local ? &zn->_local_resources : &peer->_remote_resources;
-    _z_resource_t res = {0};
-    res._id = id;
-    _z_resource_slist_t *res_ptr = _z_resource_slist_find(*resources, _z_resource_eq, &res);
+    _z_resource_table_t *resources = is_local ? zn->_local_resources : peer->_remote_resources;
+    _z_resource_t *res = _z_get_resource_by_id_inner(resources, id);
     z_result_t ret = _Z_RESOURCE_POSITIVE_REF_COUNT;
-    if (res_ptr == NULL) {
+    if (res == NULL) {
         ret = _Z_ERR_KEYEXPR_UNKNOWN;
     } else {
-        _z_resource_slist_value(res_ptr)->_refcount--;
-        if (_z_resource_slist_value(res_ptr)->_refcount == 0) {
+        res->_refcount--;
+        if (res->_refcount == 0) {
             ret = _Z_RES_OK;
-            *resources = _z_resource_slist_drop_first_filter(*resources, _z_resource_eq, &res);
+            _z_resource_table_remove(resources, _z_resource_id_hmap_get_iter(&resources->_by_id, &id));
         }
     }
     _z_session_mutex_unlock(zn);
@@ -266,6 +336,6 @@ z_result_t _z_unregister_resource(_z_session_t *zn, uint16_t id, _z_transport_pe
 
 void _z_flush_local_resources(_z_session_t *zn) {
     _z_session_mutex_lock(zn);
-    _z_resource_slist_free(&zn->_local_resources);
+    _z_resource_table_free(&zn->_local_resources);
     _z_session_mutex_unlock(zn);
 }
@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/session/rx_dispatch.h"
+
+#include "zenoh-pico/session/subscription.h"
+#include "zenoh-pico/utils/logging.h"
+
+#if Z_FEATURE_RX_DISPATCH == 1
+static void _z_rx_dispatch_slot_clear(_z_rx_dispatch_slot_t *slot) {
+    _z_sample_clear(&slot->_sample);
+    _z_subscription_rc_drop(&slot->_sub);
+}
+
+// Frees the content of a slot left in the queue, the slots themselves belong to the worker
+static void _z_rx_dispatch_slot_elem_clear(void **elem) { _z_rx_dispatch_slot_clear((_z_rx_dispatch_slot_t *)*elem); }
+
+static _z_fut_fn_result_t _z_rx_dispatch_worker_fn(void *arg, _z_executor_t *executor) {
+    _ZP_UNUSED(executor);
+    _z_rx_dispatch_worker_t *worker = (_z_rx_dispatch_worker_t *)arg;
+    void *elem = NULL;
+    if (_z_atomic_ring_pull(&worker->_queue, &elem) != _Z_RES_OK) {
+        // Closed and drained
+        return _z_fut_fn_result_ready();
+    }
+    _z_rx_dispatch_slot_t *slot = (_z_rx_dispatch_slot_t *)elem;
+    _z_subscription_deliver(worker->_zn, &slot->_sub, &slot->_sample);
+    _z_rx_dispatch_slot_clear(slot);
+    // There is room for all the slots
+    _z_atomic_ring_try_push(&worker->_free, slot);
+    _z_atomic_size_fetch_add(&worker->_dispatched, 1, _z_memory_order_relaxed);
+    // Back to the executor between samples, for it to see a stop request
+    return _z_fut_fn_result_continue();
+}
+
+static void _z_rx_dispatch_worker_clear(_z_rx_dispatch_worker_t *worker) {
+    _z_background_executor_destroy(&worker->_executor);
+    _z_atomic_ring_clear(&worker->_queue, _z_rx_dispatch_slot_elem_clear);
+    _z_atomic_ring_clear(&worker->_free, _z_noop_free);
+    z_free(worker->_slots);
+    worker->_slots = NULL;
+}
+
+static z_result_t _z_rx_dispatch_worker_init(_z_rx_dispatch_worker_t *worker, _z_session_t *zn) {
+    worker->_zn = zn;
+    _z_atomic_size_init(&worker->_dispatched, 0);
+    _z_atomic_size_init(&worker->_max_depth, 0);
+    _z_atomic_size_init(&worker->_stalls, 0);
+    worker->_slots = (_z_rx_dispatch_slot_t *)z_malloc(Z_RX_DISPATCH_QUEUE_SIZE * sizeof(_z_rx_dispatch_slot_t));
+    if (worker->_slots == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    z_result_t ret = _z_atomic_ring_init(&worker->_queue, Z_RX_DISPATCH_QUEUE_SIZE, false);
+    if (ret != _Z_RES_OK) {
+        z_free(worker->_slots);
+        worker->_slots = NULL;
+        return ret;
+    }
+    ret = _z_atomic_ring_init(&worker->_free, Z_RX_DISPATCH_QUEUE_SIZE, false);
+    if (ret != _Z_RES_OK) {
+        _z_atomic_ring_clear(&worker->_queue, _z_noop_free);
+        z_free(worker->_slots);
+        worker->_slots = NULL;
+        return ret;
+    }
+    for (size_t i = 0; i < Z_RX_DISPATCH_QUEUE_SIZE; i++) {
+        _z_atomic_ring_try_push(&worker->_free, &worker->_slots[i]);
+    }
+    ret = _z_background_executor_init_deferred(&worker->_executor);
+    if (ret == _Z_RES_OK) {
+        _z_fut_t fut = _z_fut_new(worker, _z_rx_dispatch_worker_fn, NULL);
+        ret = _z_background_executor_spawn(&worker->_executor, &fut, NULL);
+    }
+    _Z_SET_IF_OK(ret, _z_background_executor_start(&worker->_executor, NULL));
+    if (ret != _Z_RES_OK) {
+        _z_rx_dispatch_worker_clear(worker);
+    }
+    return ret;
+}
+
+static z_result_t _z_rx_dispatch_worker_stop(_z_rx_dispatch_worker_t *worker) {
+    // Wakes the future up if it waits for a sample, the executor thread then sees the stop request. The read task
+    // waiting for a free slot is woken up as well.
+    _Z_RETURN_IF_ERR(_z_atomic_ring_close(&worker->_queue));
+    _Z_RETURN_IF_ERR(_z_atomic_ring_close(&worker->_free));
+    return _z_background_executor_stop(&worker->_executor);
+}
+
+z_result_t _z_rx_dispatch_start(_z_rx_dispatch_t *dispatch, _z_session_t *zn, size_t num_workers) {
+    _z_rx_dispatch_null(dispatch);
+    if (num_workers == 0) {
+        return _Z_RES_OK;
+    }
+    dispatch->_workers = (_z_rx_dispatch_worker_t *)z_malloc(num_workers * sizeof(_z_rx_dispatch_worker_t));
+    if (dispatch->_workers == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    // Only the workers started so far are counted, for the clear to handle a failure
+    for (size_t i = 0; i < num_workers; i++) {
+        z_result_t ret = _z_rx_dispatch_worker_init(&dispatch->_workers[i], zn);
+        if (ret != _Z_RES_OK) {
+            _z_rx_dispatch_clear(dispatch);
+            _Z_ERROR_RETURN(ret);
+        }
+        dispatch->_num_workers++;
+    }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_rx_dispatch_push(_z_rx_dispatch_t *dispatch, const _z_subscription_rc_t *sub,
+                               const _z_sample_t *sample) {
+    _z_rx_dispatch_worker_t *worker = &dispatch->_workers[_Z_RC_IN_VAL(sub)->_id % dispatch->_num_workers];
+
+    _z_rx_dispatch_slot_t *slot = (_z_rx_dispatch_slot_t *)_z_atomic_ring_try_pull(&worker->_free);
+    if (slot == NULL) {
+        // The worker fell behind, hold the read task back until it catches up
+        _z_atomic_size_fetch_add(&worker->_stalls, 1, _z_memory_order_relaxed);
+        void *elem = NULL;
+        _Z_RETURN_IF_ERR(_z_atomic_ring_pull(&worker->_free, &elem));
+        slot = (_z_rx_dispatch_slot_t *)elem;
+    }
+    z_result_t ret = _z_sample_copy(&slot->_sample, sample);
+    if (ret != _Z_RES_OK) {
+        _z_atomic_ring_try_push(&worker->_free, slot);
+        _Z_ERROR_RETURN(ret);
+    }
+    slot->_sub = _z_subscription_rc_clone(sub);
+    // The queue has room for all the slots
+    if (!_z_atomic_ring_try_push(&worker->_queue, slot)) {
+        // Closed
+        _z_rx_dispatch_slot_clear(slot);
+        _z_atomic_ring_try_push(&worker->_free, slot);
+        return _Z_RES_CHANNEL_CLOSED;
+    }
+    size_t depth = _z_atomic_ring_len(&worker->_queue);
+    size_t max_depth = _z_atomic_size_load(&worker->_max_depth, _z_memory_order_relaxed);
+    while (depth > max_depth && !_z_atomic_size_compare_exchange_weak(&worker->_max_depth, &max_depth, depth,
+                                                                      _z_memory_order_relaxed,
+                                                                      _z_memory_order_relaxed)) {
+    }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_rx_dispatch_stop(_z_rx_dispatch_t *dispatch) {
+    z_result_t ret = _Z_RES_OK;
+    for (size_t i = 0; i < dispatch->_num_workers; i++) {
+        _Z_SET_IF_OK(ret, _z_rx_dispatch_worker_stop(&dispatch->_workers[i]));
+    }
+    return ret;
+}
+
+void _z_rx_dispatch_clear(_z_rx_dispatch_t *dispatch) {
+    _z_rx_dispatch_stop(dispatch);
+    for (size_t i = 0; i < dispatch->_num_workers; i++) {
+        _z_rx_dispatch_worker_clear(&dispatch->_workers[i]);
+    }
+    z_free(dispatch->_workers);
+    _z_rx_dispatch_null(dispatch);
+}
+#endif  // Z_FEATURE_RX_DISPATCH == 1
@@ -16,6 +16,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "zenoh-pico/api/constants.h"
 #include "zenoh-pico/api/types.h"
@@ -26,20 +27,211 @@
 #include "zenoh-pico/protocol/definitions/network.h"
 #include "zenoh-pico/session/keyexpr.h"
 #include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/session/rx_dispatch.h"
 #include "zenoh-pico/session/session.h"
 #include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/system/platform.h"
 #include "zenoh-pico/utils/locality.h"
 #include "zenoh-pico/utils/logging.h"
 
 #if Z_FEATURE_SUBSCRIPTION == 1
 
-#define _Z_SUBINFOS_VEC_SIZE 4  // Arbitrary initial size
+#define _Z_SUBINFOS_VEC_SIZE 4  // Arbitrary, matching subscriptions held on the stack
 
 bool _z_subscription_eq(const _z_subscription_t *other, const _z_subscription_t *this_) {
     return this_->_id == other->_id;
 }
 
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+#define _Z_SUBSCRIPTION_BATCH_KEY_SIZE 32  // Arbitrary, room per sample for the key expressions of a batch
+
+typedef struct {
+    _z_sample_t *_samples;
+    // Copies of the key expressions of the samples, which their trigger keeps on its stack
+    char *_keys;
+    size_t _len;
+    size_t _keys_len;
+    size_t _keys_capacity;
+} _z_subscription_batch_array_t;
+
+struct _z_subscription_batch_t {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_t _mutex;
+    // Signaled when the callback takes an array and when it returns
+    _z_condvar_t _cv;
+    _z_task_id_t _delivering_task;
+#endif
+    _z_closure_sample_batch_callback_t _callback;
+    // Samples are pushed into one array while the other one is with the callback
+    _z_subscription_batch_array_t _filling;
+    _z_subscription_batch_array_t _spare;
+    size_t _capacity;
+    // Samples pushed and handed to the callback since the creation of the batch, for the pushers to wait for theirs
+    uint64_t _pushed;
+    uint64_t _delivered;
+    // Listed in the pending batches of the session
+    bool _pending;
+    bool _delivering;
+};
+
+static inline void __z_subscription_batch_lock(_z_subscription_batch_t *batch) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_lock(&batch->_mutex);
+#else
+    _ZP_UNUSED(batch);
+#endif
+}
+
+static inline void __z_subscription_batch_unlock(_z_subscription_batch_t *batch) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&batch->_mutex);
+#else
+    _ZP_UNUSED(batch);
+#endif
+}
+
+// Whether the callback is being delivered a batch on the calling thread, which then can't wait for it to return
+static inline bool __z_subscription_batch_in_callback(const _z_subscription_batch_t *batch) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_task_id_t current = _z_task_current_id();
+    return batch->_delivering && _z_task_id_equal(&current, &batch->_delivering_task);
+#else
+    return batch->_delivering;
+#endif
+}
+
+static inline bool __z_subscription_batch_array_has_room(const _z_subscription_batch_t *batch, size_t key_len) {
+    const _z_subscription_batch_array_t *array = &batch->_filling;
+    return (array->_len < batch->_capacity) && (array->_keys_capacity - array->_keys_len >= key_len);
+}
+
+_z_subscription_batch_t *_z_subscription_batch_new(_z_closure_sample_batch_callback_t callback, size_t max_samples) {
+    if (callback == NULL || max_samples == 0) {
+        return NULL;
+    }
+    _z_subscription_batch_t *batch = (_z_subscription_batch_t *)z_malloc(sizeof(_z_subscription_batch_t));
+    if (batch == NULL) {
+        return NULL;
+    }
+    *batch = (_z_subscription_batch_t){._callback = callback, ._capacity = max_samples};
+    // Both arrays are allocated at once, with the room for their keys
+    size_t keys_capacity = max_samples * _Z_SUBSCRIPTION_BATCH_KEY_SIZE;
+    _z_sample_t *samples = (_z_sample_t *)z_malloc(2 * max_samples * sizeof(_z_sample_t));
+    char *filling_keys = (char *)z_malloc(keys_capacity);
+    char *spare_keys = (char *)z_malloc(keys_capacity);
+    if (samples == NULL || filling_keys == NULL || spare_keys == NULL) {
+        z_free(samples);
+        z_free(filling_keys);
+        z_free(spare_keys);
+        z_free(batch);
+        return NULL;
+    }
+    batch->_filling = (_z_subscription_batch_array_t){
+        ._samples = samples, ._keys = filling_keys, ._keys_capacity = keys_capacity};
+    batch->_spare = (_z_subscription_batch_array_t){
+        ._samples = &samples[max_samples], ._keys = spare_keys, ._keys_capacity = keys_capacity};
+#if Z_FEATURE_MULTI_THREAD == 1
+    if (_z_mutex_init(&batch->_mutex) != _Z_RES_OK) {
+        z_free(samples);
+        z_free(filling_keys);
+        z_free(spare_keys);
+        z_free(batch);
+        return NULL;
+    }
+    if (_z_condvar_init(&batch->_cv) != _Z_RES_OK) {
+        _z_mutex_drop(&batch->_mutex);
+        z_free(samples);
+        z_free(filling_keys);
+        z_free(spare_keys);
+        z_free(batch);
+        return NULL;
+    }
+#endif
+    return batch;
+}
+
+/**
+ * Hand the samples of the batch to its callback, along with the ones pushed meanwhile. Does nothing if another thread
+ * is already at it, the samples it leaves are then delivered by that thread.
+ */
+static void __z_subscription_batch_deliver(_z_subscription_batch_t *batch, void *arg) {
+    __z_subscription_batch_lock(batch);
+    if (batch->_delivering) {
+        __z_subscription_batch_unlock(batch);
+        return;
+    }
+    batch->_delivering = true;
+#if Z_FEATURE_MULTI_THREAD == 1
+    batch->_delivering_task = _z_task_current_id();
+#endif
+    while (batch->_filling._len > 0) {
+        _z_subscription_batch_array_t full = batch->_filling;
+        batch->_filling = batch->_spare;
+        batch->_spare = full;
+#if Z_FEATURE_MULTI_THREAD == 1
+        _z_condvar_signal_all(&batch->_cv);
+#endif
+        __z_subscription_batch_unlock(batch);
+        batch->_callback(full._samples, full._len, arg);
+        // Only the samples moved in from another thread are owned
+        for (size_t i = 0; i < full._len; i++) {
+            _z_sample_clear(&full._samples[i]);
+        }
+        __z_subscription_batch_lock(batch);
+        batch->_spare._len = 0;
+        batch->_spare._keys_len = 0;
+        batch->_delivered += full._len;
+#if Z_FEATURE_MULTI_THREAD == 1
+        _z_condvar_signal_all(&batch->_cv);
+#endif
+    }
+    batch->_delivering = false;
+    __z_subscription_batch_unlock(batch);
+}
+
+/**
+ * Deliver the samples pushed so far and wait for the callback to return from them, as the samples borrowed from the
+ * caller are only valid until then.
+ */
+static void __z_subscription_batch_flush(_z_subscription_batch_t *batch, void *arg) {
+    __z_subscription_batch_lock(batch);
+    uint64_t pushed = batch->_pushed;
+    __z_subscription_batch_unlock(batch);
+    __z_subscription_batch_deliver(batch, arg);
+#if Z_FEATURE_MULTI_THREAD == 1
+    __z_subscription_batch_lock(batch);
+    // Being delivered by another thread, which also hands over the samples pushed meanwhile
+    while (batch->_delivered < pushed && !__z_subscription_batch_in_callback(batch)) {
+        _z_condvar_wait(&batch->_cv, &batch->_mutex);
+    }
+    __z_subscription_batch_unlock(batch);
+#endif
+}
+
+static void __z_subscription_batch_free(_z_subscription_batch_t **batch, void *arg) {
+    _z_subscription_batch_t *ptr = *batch;
+    if (ptr == NULL) {
+        return;
+    }
+    // The samples still waiting go out before the callback state is dropped
+    __z_subscription_batch_deliver(ptr, arg);
+    // Both sample arrays were allocated at once, in either order after swaps
+    z_free(ptr->_filling._samples < ptr->_spare._samples ? ptr->_filling._samples : ptr->_spare._samples);
+    z_free(ptr->_filling._keys);
+    z_free(ptr->_spare._keys);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_condvar_drop(&ptr->_cv);
+    _z_mutex_drop(&ptr->_mutex);
+#endif
+    z_free(ptr);
+    *batch = NULL;
+}
+#endif
+
 void _z_subscription_clear(_z_subscription_t *sub) {
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    __z_subscription_batch_free(&sub->_batch, sub->_arg);
+#endif
     if (sub->_dropper != NULL) {
         sub->_dropper(sub->_arg);
         sub->_dropper = NULL;
@@ -49,6 +241,97 @@ void _z_subscription_clear(_z_subscription_t *sub) {
     _z_sync_group_notifier_drop(&sub->_subscriber_callback_drop_notifier);
 }
 
+#if Z_FEATURE_RX_CACHE == 1
+int _z_subscription_cache_data_compare(const void *first, const void *second) {
+    const _z_subscription_cache_data_t *first_data = (const _z_subscription_cache_data_t *)first;
+    const _z_subscription_cache_data_t *second_data = (const _z_subscription_cache_data_t *)second;
+    if (first_data->_kind != second_data->_kind) {
+        return first_data->_kind < second_data->_kind ? -1 : 1;
+    }
+    if (first_data->_is_remote != second_data->_is_remote) {
+        return first_data->_is_remote ? 1 : -1;
+    }
+    return _z_keyexpr_compare(&first_data->_key, &second_data->_key);
+}
+
+void _z_subscription_cache_data_clear(_z_subscription_cache_data_t *val) {
+    _z_subscription_rc_svec_clear(&val->_infos);
+    _z_keyexpr_clear(&val->_key);
+}
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static z_result_t __unsafe_z_subscription_cache_get(_z_session_t *zn, _z_subscriber_kind_t kind,
+                                                    const _z_keyexpr_t *key, bool is_remote,
+                                                    _z_subscription_rc_svec_t *sub_infos, bool *found) {
+    // The lookup value aliases the key, it is never stored
+    _z_subscription_cache_data_t probe = {._key = *key, ._kind = kind, ._is_remote = is_remote};
+    _z_subscription_cache_data_t *cache_entry = _z_subscription_cache_lru_cache_get(&zn->_subscription_cache, &probe);
+    *found = (cache_entry != NULL);
+    if (cache_entry == NULL) {
+        zn->_subscription_cache_stats._misses++;
+        return _Z_RES_OK;
+    }
+    zn->_subscription_cache_stats._hits++;
+    for (size_t i = 0; i < _z_subscription_rc_svec_len(&cache_entry->_infos); i++) {
+        _z_subscription_rc_t sub_clone = _z_subscription_rc_clone(_z_subscription_rc_svec_get(&cache_entry->_infos, i));
+        _Z_CLEAN_RETURN_IF_ERR(_z_subscription_rc_svec_append(sub_infos, &sub_clone, false),
+                               _z_subscription_rc_drop(&sub_clone));
+    }
+    return _Z_RES_OK;
+}
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static void __unsafe_z_subscription_cache_insert(_z_session_t *zn, _z_subscriber_kind_t kind, const _z_keyexpr_t *key,
+                                                 bool is_remote, const _z_subscription_rc_svec_t *sub_infos) {
+    _z_subscription_cache_data_t cache_entry = {._kind = kind, ._is_remote = is_remote};
+    if (_z_keyexpr_copy(&cache_entry._key, key) != _Z_RES_OK) {
+        return;
+    }
+    if (_z_subscription_rc_svec_copy(&cache_entry._infos, sub_infos, true) != _Z_RES_OK) {
+        _z_keyexpr_clear(&cache_entry._key);
+        return;
+    }
+    // A failed insertion only costs a cache miss on the next sample
+    if (_z_subscription_cache_lru_cache_insert(&zn->_subscription_cache, &cache_entry) != _Z_RES_OK) {
+        _z_subscription_cache_data_clear(&cache_entry);
+    }
+}
+
+_z_subscription_cache_stats_t _z_get_subscription_cache_stats(_z_session_t *zn) {
+    _z_session_mutex_lock(zn);
+    _z_subscription_cache_stats_t stats = zn->_subscription_cache_stats;
+    _z_session_mutex_unlock(zn);
+    return stats;
+}
+#endif
+
+/**
+ * Drop every cached match, to be called whenever the set of subscriptions changes.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static inline void __unsafe_z_subscription_cache_invalidate(_z_session_t *zn) {
+#if Z_FEATURE_RX_CACHE == 1
+    _z_subscription_cache_lru_cache_clear(&zn->_subscription_cache);
+#else
+    _ZP_UNUSED(zn);
+#endif
+}
+
+static inline _z_keyexpr_trie_t *__z_get_subscriptions_index(_z_session_t *zn, _z_subscriber_kind_t kind) {
+    return (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) ? &zn->_subscriptions_index : &zn->_liveliness_subscriptions_index;
+}
+
 _z_subscription_rc_t *__z_get_subscription_by_id(_z_subscription_rc_slist_t *subs, const _z_zint_t id) {
     _z_subscription_rc_t *ret = NULL;
 
@@ -82,31 +365,69 @@ _z_subscription_rc_t *__unsafe_z_get_subscription_by_id(_z_session_t *zn, _z_sub
  * Make sure that the following mutexes are locked before calling this function:
  *  - zn->_mutex_inner
  */
-static z_result_t __unsafe_z_get_subscriptions_by_key(_z_session_t *zn, _z_subscriber_kind_t kind,
-                                                      const _z_keyexpr_t *key, bool is_remote,
-                                                      _z_subscription_rc_svec_t *sub_infos) {
-    _z_subscription_rc_slist_t *subs =
-        (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) ? zn->_subscriptions : zn->_liveliness_subscriptions;
+static void __unsafe_z_drop_subscription(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_rc_t *entry) {
+    _z_subscription_rc_t sub = *entry;
+    __unsafe_z_subscription_cache_invalidate(zn);
+    _z_keyexpr_trie_remove(__z_get_subscriptions_index(zn, kind), &_Z_RC_IN_VAL(&sub)->_key._inner, entry);
+    // entry points into the list node, so compare against a copy of the handle
+    if (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) {
+        zn->_subscriptions =
+            _z_subscription_rc_slist_drop_first_filter(zn->_subscriptions, _z_subscription_rc_eq, &sub);
+    } else {
+        zn->_liveliness_subscriptions =
+            _z_subscription_rc_slist_drop_first_filter(zn->_liveliness_subscriptions, _z_subscription_rc_eq, &sub);
+    }
+}
 
-    *sub_infos = _z_subscription_rc_svec_make(_Z_SUBINFOS_VEC_SIZE);
-    _Z_RETURN_ERR_OOM_IF_TRUE(sub_infos->_val == NULL);
-    _z_subscription_rc_slist_t *xs = subs;
-    while (xs != NULL) {
-        // Parse subscription list
-        _z_subscription_rc_t *sub = _z_subscription_rc_slist_value(xs);
-        const _z_subscription_t *sub_val = _Z_RC_IN_VAL(sub);
-        bool origin_allowed = is_remote ? _z_locality_allows_remote(sub_val->_allowed_origin)
-                                        : _z_locality_allows_local(sub_val->_allowed_origin);
-        if (origin_allowed && _z_keyexpr_intersects(&sub_val->_key._inner, key)) {
-            _z_subscription_rc_t sub_clone = _z_subscription_rc_clone(sub);
-            _Z_CLEAN_RETURN_IF_ERR(_z_subscription_rc_svec_append(sub_infos, &sub_clone, false),
-                                   _z_subscription_rc_svec_clear(sub_infos));
+typedef struct {
+    _z_subscription_rc_svec_t *_sub_infos;
+    const _z_keyexpr_t *_key;
+    bool _is_remote;
+} __z_subscription_match_ctx_t;
+
+static z_result_t __z_subscription_match_candidate(void *value, void *arg) {
+    __z_subscription_match_ctx_t *ctx = (__z_subscription_match_ctx_t *)arg;
+    _z_subscription_rc_t *sub = (_z_subscription_rc_t *)value;
+    const _z_subscription_t *sub_val = _Z_RC_IN_VAL(sub);
+    bool origin_allowed = ctx->_is_remote ? _z_locality_allows_remote(sub_val->_allowed_origin)
+                                          : _z_locality_allows_local(sub_val->_allowed_origin);
+    if (!origin_allowed || !_z_keyexpr_intersects(&sub_val->_key._inner, ctx->_key)) {
+        return _Z_RES_OK;
+    }
+    _z_subscription_rc_t sub_clone = _z_subscription_rc_clone(sub);
+    _Z_RETURN_IF_ERR(_z_subscription_rc_svec_append(ctx->_sub_infos, &sub_clone, false));
+    // Keep the dispatch order of the subscription list, where the most recently declared subscription comes first
+    size_t last = _z_subscription_rc_svec_len(ctx->_sub_infos) - 1;
+    size_t lo = 0;
+    size_t hi = last;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (_Z_RC_IN_VAL(_z_subscription_rc_svec_get(ctx->_sub_infos, mid))->_id > sub_val->_id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
-        xs = _z_subscription_rc_slist_next(xs);
+    }
+    if (lo < last) {
+        _z_subscription_rc_t *pos = _z_subscription_rc_svec_get_mut(ctx->_sub_infos, lo);
+        memmove(pos + 1, pos, (last - lo) * sizeof(_z_subscription_rc_t));
+        *pos = sub_clone;
     }
     return _Z_RES_OK;
 }
 
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static z_result_t __unsafe_z_get_subscriptions_by_key(_z_session_t *zn, _z_subscriber_kind_t kind,
+                                                      const _z_keyexpr_t *key, bool is_remote,
+                                                      _z_subscription_rc_svec_t *sub_infos) {
+    __z_subscription_match_ctx_t ctx = {._sub_infos = sub_infos, ._key = key, ._is_remote = is_remote};
+    return _z_keyexpr_trie_match(__z_get_subscriptions_index(zn, kind), key, __z_subscription_match_candidate, &ctx);
+}
+
 _z_subscription_rc_t _z_get_subscription_by_id(_z_session_t *zn, _z_subscriber_kind_t kind, const _z_zint_t id) {
     _z_subscription_rc_t out = _z_subscription_rc_null();
     _z_session_mutex_lock(zn);
@@ -146,6 +467,14 @@ _z_subscription_rc_t _z_register_subscription(_z_session_t *zn, _z_subscriber_ki
     } else {
         // immediately increase reference count to prevent eventual drop by concurrent session close
         *ret = _z_subscription_rc_clone(&out);
+        // the index refers to the list entry, which stays in place until the subscription is unregistered
+        if (_z_keyexpr_trie_insert(__z_get_subscriptions_index(zn, kind), &_Z_RC_IN_VAL(ret)->_key._inner, ret) !=
+            _Z_RES_OK) {
+            __unsafe_z_drop_subscription(zn, kind, ret);
+            _z_subscription_rc_drop(&out);
+        } else {
+            __unsafe_z_subscription_cache_invalidate(zn);
+        }
     }
     _z_session_mutex_unlock(zn);
 
@@ -176,17 +505,176 @@ z_result_t _z_trigger_liveliness_subscriptions_undeclare(_z_session_t *zn, const
                                          Z_RELIABILITY_RELIABLE, NULL, NULL);
 }
 
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static _z_subscription_rc_t __unsafe_z_subscription_batches_take(_z_session_t *zn, size_t pos) {
+    _z_subscription_rc_svec_t *pending = &zn->_subscription_batches_pending;
+    _z_subscription_rc_t *entry = _z_subscription_rc_svec_get_mut(pending, pos);
+    _z_subscription_rc_t sub = *entry;
+    // The order of the pending batches doesn't matter, the last one takes the place of the one taken
+    *entry = *_z_subscription_rc_svec_get(pending, pending->_len - 1);
+    pending->_len--;
+    _z_atomic_size_fetch_sub(&zn->_subscription_batches_pending_count, 1, _z_memory_order_release);
+    return sub;
+}
+
+/**
+ * Take a subscription off the pending batches of the session if it has no sample waiting, a sample pushed afterwards
+ * lists it again.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static void __unsafe_z_subscription_batches_remove_if_empty(_z_session_t *zn, const _z_subscription_rc_t *sub) {
+    for (size_t i = 0; i < _z_subscription_rc_svec_len(&zn->_subscription_batches_pending); i++) {
+        if (_z_subscription_rc_eq(_z_subscription_rc_svec_get(&zn->_subscription_batches_pending, i), sub)) {
+            _z_subscription_batch_t *batch = _Z_RC_IN_VAL(sub)->_batch;
+            __z_subscription_batch_lock(batch);
+            bool empty = batch->_filling._len == 0;
+            batch->_pending = !empty;
+            __z_subscription_batch_unlock(batch);
+            if (empty) {
+                _z_subscription_rc_t taken = __unsafe_z_subscription_batches_take(zn, i);
+                _z_subscription_rc_drop(&taken);
+            }
+            return;
+        }
+    }
+}
+
+static void __z_subscription_batch_push(_z_session_t *zn, _z_subscription_rc_t *sub, _z_sample_t *sample) {
+    _z_subscription_t *sub_info = _Z_RC_IN_VAL(sub);
+    _z_subscription_batch_t *batch = sub_info->_batch;
+    // Samples from the dispatch workers are owned and moved in, received ones borrow their trigger's key expression
+    bool view = _z_sample_is_view(sample);
+    const _z_string_t *key = &_z_sample_get_ref(sample)->keyexpr._inner._keyexpr;
+    size_t key_len = view ? _z_string_len(key) : 0;
+    __z_subscription_batch_lock(batch);
+    // Pushed from the callback itself, which can't wait for its own return, or a key longer than a whole array
+    bool alone = __z_subscription_batch_in_callback(batch) || (key_len > batch->_filling._keys_capacity);
+    while (!alone && !__z_subscription_batch_array_has_room(batch, key_len)) {
+        if (!batch->_delivering) {
+            // Not taken by the callback yet, by the thread that filled it or by this one
+            __z_subscription_batch_unlock(batch);
+            __z_subscription_batch_deliver(batch, sub_info->_arg);
+            __z_subscription_batch_lock(batch);
+        } else {
+#if Z_FEATURE_MULTI_THREAD == 1
+            // The previous batch is still with the callback, wait for it to take this one
+            _z_condvar_wait(&batch->_cv, &batch->_mutex);
+#endif
+        }
+    }
+    if (alone) {
+        __z_subscription_batch_unlock(batch);
+        batch->_callback(sample, 1, sub_info->_arg);
+        return;
+    }
+    _z_subscription_batch_array_t *array = &batch->_filling;
+    _z_sample_t *dst = &array->_samples[array->_len];
+    if (view) {
+        char *key_copy = &array->_keys[array->_keys_len];
+        memcpy(key_copy, _z_string_data(key), key_len);
+        array->_keys_len += key_len;
+        *dst = *sample;
+        _z_sample_get_view(dst)->_target.keyexpr._inner._keyexpr = _z_string_alias_substr(key_copy, key_len);
+    } else {
+        // Moving an owned sample doesn't fail
+        _z_sample_move_or_copy(dst, sample);
+    }
+    array->_len++;
+    batch->_pushed++;
+    bool full = array->_len == batch->_capacity;
+    bool list = !full && !batch->_pending;
+    batch->_pending = batch->_pending || list;
+    __z_subscription_batch_unlock(batch);
+
+    if (list) {
+        _z_session_mutex_lock(zn);
+        _z_subscription_rc_t clone = _z_subscription_rc_clone(sub);
+        if (_z_subscription_rc_svec_append(&zn->_subscription_batches_pending, &clone, false) == _Z_RES_OK) {
+            _z_atomic_size_fetch_add(&zn->_subscription_batches_pending_count, 1, _z_memory_order_release);
+            list = false;
+        } else {
+            _z_subscription_rc_drop(&clone);
+        }
+        _z_session_mutex_unlock(zn);
+        if (list) {
+            // Nothing would flush the batch
+            __z_subscription_batch_lock(batch);
+            batch->_pending = false;
+            __z_subscription_batch_unlock(batch);
+            full = true;
+        }
+    }
+    if (full) {
+        __z_subscription_batch_deliver(batch, sub_info->_arg);
+    }
+}
+
+void _z_flush_subscription_batches(_z_session_t *zn) {
+    if (_z_atomic_size_load(&zn->_subscription_batches_pending_count, _z_memory_order_acquire) == 0) {
+        return;
+    }
+    _z_session_mutex_lock(zn);
+    // Taken off the list before the delivery, the samples pushed meanwhile list the batch again
+    while (_z_subscription_rc_svec_len(&zn->_subscription_batches_pending) > 0) {
+        _z_subscription_t *sub_info = _Z_RC_IN_VAL(_z_subscription_rc_svec_get(&zn->_subscription_batches_pending, 0));
+        _z_subscription_batch_t *batch = sub_info->_batch;
+        __z_subscription_batch_lock(batch);
+        batch->_pending = false;
+        __z_subscription_batch_unlock(batch);
+        _z_subscription_rc_t sub = __unsafe_z_subscription_batches_take(zn, 0);
+        _z_session_mutex_unlock(zn);
+        __z_subscription_batch_flush(batch, sub_info->_arg);
+        _z_subscription_rc_drop(&sub);
+        _z_session_mutex_lock(zn);
+    }
+    _z_session_mutex_unlock(zn);
+}
+#endif
+
+void _z_subscription_deliver(_z_session_t *zn, _z_subscription_rc_t *sub, _z_sample_t *sample) {
+    _z_subscription_t *sub_info = _Z_RC_IN_VAL(sub);
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    if (sub_info->_batch != NULL) {
+        __z_subscription_batch_push(zn, sub, sample);
+        return;
+    }
+#else
+    _ZP_UNUSED(zn);
+#endif
+    sub_info->_callback(sample, sub_info->_arg);
+}
+
 z_result_t _z_trigger_subscriptions_impl(_z_session_t *zn, _z_subscriber_kind_t sub_kind, const _z_keyexpr_t *keyexpr,
                                          const _z_bytes_t *payload, const _z_encoding_t *encoding,
                                          const _z_zint_t sample_kind, const _z_timestamp_t *timestamp, _z_n_qos_t qos,
                                          const _z_bytes_t *attachment, z_reliability_t reliability,
                                          const _z_source_info_t *source_info, _z_transport_peer_common_t *peer) {
-    _z_subscription_rc_svec_t subs = _z_subscription_rc_svec_null();
+    // The matching subscriptions are gathered on the stack, the heap is only used past _Z_SUBINFOS_VEC_SIZE of them
+    _z_subscription_rc_t subs_storage[_Z_SUBINFOS_VEC_SIZE];
+    _z_subscription_rc_svec_t subs = _z_subscription_rc_svec_alias_storage(subs_storage, _Z_SUBINFOS_VEC_SIZE);
     _Z_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn));
-    _Z_CLEAN_RETURN_IF_ERR(__unsafe_z_get_subscriptions_by_key(zn, sub_kind, keyexpr, peer != NULL, &subs),
-                           _z_session_mutex_unlock(zn));
-    // TODO: reintroduce lru cache
+#if Z_FEATURE_RX_CACHE == 1
+    bool cached = false;
+    z_result_t ret = __unsafe_z_subscription_cache_get(zn, sub_kind, keyexpr, peer != NULL, &subs, &cached);
+    if (ret == _Z_RES_OK && !cached) {
+        ret = __unsafe_z_get_subscriptions_by_key(zn, sub_kind, keyexpr, peer != NULL, &subs);
+        if (ret == _Z_RES_OK) {
+            __unsafe_z_subscription_cache_insert(zn, sub_kind, keyexpr, peer != NULL, &subs);
+        }
+    }
+#else
+    z_result_t ret = __unsafe_z_get_subscriptions_by_key(zn, sub_kind, keyexpr, peer != NULL, &subs);
+#endif
     _z_session_mutex_unlock(zn);
+    _Z_CLEAN_RETURN_IF_ERR(ret, _z_subscription_rc_svec_clear(&subs));
 
     size_t sub_nb = _z_subscription_rc_svec_len(&subs);
     _Z_DEBUG("Triggering %ju subs for key %.*s", (uintmax_t)sub_nb, (int)_z_string_len(&keyexpr->_keyexpr),
@@ -195,13 +683,33 @@ z_result_t _z_trigger_subscriptions_impl(_z_session_t *zn, _z_subscriber_kind_t
     _z_sample_t sample;
     _z_sample_create_view_from_data(&sample, keyexpr, payload, timestamp, encoding, sample_kind, qos, attachment,
                                     source_info, reliability);
+#if Z_FEATURE_RX_DISPATCH == 1
+    // Received samples go to the workers, the local ones stay on the thread that published them
+    bool dispatch =
+        (peer != NULL) && (sub_kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) && _z_rx_dispatch_is_active(&zn->_rx_dispatch);
+#endif
 
-    for (size_t i = 0; i < sub_nb; i++) {
+    for (size_t i = 0; (i < sub_nb) && (ret == _Z_RES_OK); i++) {
+        _z_subscription_rc_t *sub = _z_subscription_rc_svec_get(&subs, i);
+#if Z_FEATURE_RX_DISPATCH == 1
+        if (dispatch) {
+            ret = _z_rx_dispatch_push(&zn->_rx_dispatch, sub, &sample);
+            continue;
+        }
+#endif
+        _z_subscription_deliver(zn, sub, &sample);
+    }
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    // Published by the session, the samples only live until it returns, received ones until their batch is processed
+    for (size_t i = 0; (i < sub_nb) && (peer == NULL); i++) {
         _z_subscription_t *sub_info = _Z_RC_IN_VAL(_z_subscription_rc_svec_get(&subs, i));
-        sub_info->_callback(&sample, sub_info->_arg);
+        if (sub_info->_batch != NULL) {
+            __z_subscription_batch_flush(sub_info->_batch, sub_info->_arg);
+        }
     }
+#endif
     _z_subscription_rc_svec_clear(&subs);
-    return _Z_RES_OK;
+    return ret;
 }
 
 void _z_unregister_subscription(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_rc_t *sub) {
@@ -212,26 +720,51 @@ void _z_unregister_subscription(_z_session_t *zn, _z_subscriber_kind_t kind, _z_
     }
 #endif
     _z_session_mutex_lock(zn);
-    if (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) {
-        zn->_subscriptions = _z_subscription_rc_slist_drop_first_filter(zn->_subscriptions, _z_subscription_rc_eq, sub);
-    } else {
-        zn->_liveliness_subscriptions =
-            _z_subscription_rc_slist_drop_first_filter(zn->_liveliness_subscriptions, _z_subscription_rc_eq, sub);
+    _z_subscription_rc_t *entry = __unsafe_z_get_subscription_by_id(zn, kind, _Z_RC_IN_VAL(sub)->_id);
+    if (entry != NULL) {
+        __unsafe_z_drop_subscription(zn, kind, entry);
     }
     _z_session_mutex_unlock(zn);
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    _z_subscription_t *sub_val = _Z_RC_IN_VAL(sub);
+    if (sub_val->_batch != NULL) {
+        // The samples still waiting are delivered before the subscription is dropped
+        __z_subscription_batch_flush(sub_val->_batch, sub_val->_arg);
+        _z_session_mutex_lock(zn);
+        __unsafe_z_subscription_batches_remove_if_empty(zn, sub);
+        _z_session_mutex_unlock(zn);
+    }
+#endif
     _z_subscription_rc_drop(sub);
 }
 
 void _z_flush_subscriptions(_z_session_t *zn) {
     _z_subscription_rc_slist_t *subscriptions, *liveliness_subscriptions;
     _z_session_mutex_lock(zn);
+#if Z_FEATURE_RX_CACHE == 1
+    _z_subscription_cache_lru_cache_t cache = zn->_subscription_cache;
+    zn->_subscription_cache = _z_subscription_cache_lru_cache_init(Z_RX_CACHE_SIZE);
+#endif
     subscriptions = zn->_subscriptions;
     liveliness_subscriptions = zn->_liveliness_subscriptions;
     zn->_subscriptions = _z_subscription_rc_slist_new();
     zn->_liveliness_subscriptions = _z_subscription_rc_slist_new();
+    _z_keyexpr_trie_clear(&zn->_subscriptions_index);
+    _z_keyexpr_trie_clear(&zn->_liveliness_subscriptions_index);
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    _z_subscription_rc_svec_t batches = zn->_subscription_batches_pending;
+    zn->_subscription_batches_pending = _z_subscription_rc_svec_null();
+    _z_atomic_size_store(&zn->_subscription_batches_pending_count, 0, _z_memory_order_release);
+#endif
     _z_session_mutex_unlock(zn);
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    _z_subscription_rc_svec_clear(&batches);
+#endif
     _z_subscription_rc_slist_free(&subscriptions);
     _z_subscription_rc_slist_free(&liveliness_subscriptions);
+#if Z_FEATURE_RX_CACHE == 1
+    _z_subscription_cache_lru_cache_delete(&cache);
+#endif
 }
 #else   // Z_FEATURE_SUBSCRIPTION == 0
 z_result_t _z_trigger_liveliness_subscriptions_declare(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
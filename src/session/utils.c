@@ -15,6 +15,7 @@
 #include "zenoh-pico/session/utils.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/core.h"
@@ -96,23 +97,38 @@ z_result_t _z_session_init(_z_session_t *zn, const _z_id_t *zid) {
 #if Z_FEATURE_SUBSCRIPTION == 1
     zn->_subscriptions = NULL;
     zn->_liveliness_subscriptions = NULL;
+    _z_keyexpr_trie_init(&zn->_subscriptions_index);
+    _z_keyexpr_trie_init(&zn->_liveliness_subscriptions_index);
+#if Z_FEATURE_RX_CACHE == 1
+    zn->_subscription_cache = _z_subscription_cache_lru_cache_init(Z_RX_CACHE_SIZE);
+    zn->_subscription_cache_stats = (_z_subscription_cache_stats_t){0};
+#endif
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+    zn->_subscription_batches_pending = _z_subscription_rc_svec_null();
+    _z_atomic_size_init(&zn->_subscription_batches_pending_count, 0);
+#endif
+#if Z_FEATURE_RX_DISPATCH == 1
+    _z_rx_dispatch_null(&zn->_rx_dispatch);
+#endif
 #endif
 #if Z_FEATURE_QUERYABLE == 1
     _z_rid_to_count_hmap_init(&zn->_received_queries_id_to_count);
     zn->_local_queryable = NULL;
 #endif
 #if Z_FEATURE_QUERY == 1
-    zn->_pending_queries = NULL;
+    _z_pending_query_hmap_init(&zn->_pending_queries);
+    zn->_pending_query_deadlines = _z_pending_query_deadline_pqueue_new();
+    zn->_pending_query_deadlines_horizon = UINT64_MAX;
+    zn->_pending_query_epoch = z_clock_now();
+    zn->_pending_query_timer_ms = UINT64_MAX;
+    zn->_pending_query_timer_gen = 0;
+    zn->_pending_query_timer_rearm = false;
 #endif
 
 #if Z_FEATURE_LIVELINESS == 1
     _z_liveliness_init(zn);
 #endif
 
-#if Z_FEATURE_INTEREST == 1
-    zn->_write_filters = NULL;
-#endif
-
 #ifdef Z_FEATURE_UNSTABLE_API
 #if Z_FEATURE_ADMIN_SPACE == 1
     zn->_admin_space_queryable_id = 0;
@@ -136,14 +152,6 @@ z_result_t _z_session_init(_z_session_t *zn, const _z_id_t *zid) {
     zn->_callback_drop_sync_group = _z_sync_group_null();
     _Z_SET_IF_OK(ret, _z_sync_group_create(&zn->_callback_drop_sync_group));
     _Z_SET_IF_OK(ret, _z_runtime_init(&zn->_runtime));
-#if Z_FEATURE_QUERY
-    if (ret == _Z_RES_OK) {
-        _z_fut_t fut = _z_fut_null();
-        fut._fut_fn = _z_pending_query_process_timeout_task_fn;
-        fut._fut_arg = zn;
-        ret = _z_fut_handle_is_null(_z_runtime_spawn(&zn->_runtime, &fut)) ? _Z_ERR_FAILED_TO_SPAWN_TASK : _Z_RES_OK;
-    }
-#endif
     if (ret != _Z_RES_OK) {
 #if Z_FEATURE_MULTI_THREAD == 1
 #if Z_FEATURE_ADMIN_SPACE == 1
@@ -179,6 +187,10 @@ z_result_t _z_session_close(_z_session_t *zn) {
     // callbacks currently executing, like in the case of liveliness subscribers/ matching listeners / connectivity
     // events
     _Z_RETURN_IF_ERR(_z_runtime_stop(&zn->_runtime));
+#if Z_FEATURE_RX_DISPATCH == 1
+    // Same as for the read task, no received sample is delivered past this point
+    _Z_RETURN_IF_ERR(_z_rx_dispatch_stop(&zn->_rx_dispatch));
+#endif
     _z_flush_local_resources(zn);
 #if Z_FEATURE_SUBSCRIPTION == 1
     _z_flush_subscriptions(zn);
@@ -228,6 +240,9 @@ z_result_t _z_session_close(_z_session_t *zn) {
 void _z_session_clear(_z_session_t *zn) {
     _z_session_close(zn);
     _z_runtime_clear(&zn->_runtime);
+#if Z_FEATURE_RX_DISPATCH == 1
+    _z_rx_dispatch_clear(&zn->_rx_dispatch);
+#endif
     _z_config_clear(&zn->_config);
     _z_session_transport_mutex_lock(zn);
     _z_transport_clear(&zn->_tp);
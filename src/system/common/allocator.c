@@ -0,0 +1,264 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/system/common/allocator.h"
+
+#include <string.h>
+
+#include "zenoh-pico/system/common/platform.h"
+#include "zenoh-pico/utils/logging.h"
+
+#if Z_FEATURE_ALLOCATOR == 1
+
+#if Z_ALLOC_POOL_PAGE_SIZE % _Z_ALLOC_POOL_MIN_BLOCK_SIZE != 0
+#error "Z_ALLOC_POOL_PAGE_SIZE must be a multiple of 16"
+#endif
+
+/*------------------ Allocator ------------------*/
+// No functions means the platform ones
+static zp_allocator_t _z_allocator = {0};
+
+z_result_t zp_set_allocator(const zp_allocator_t *allocator) {
+    if (allocator == NULL) {
+        _z_allocator = (zp_allocator_t){0};
+        return _Z_RES_OK;
+    }
+    if (allocator->allocate == NULL || allocator->reallocate == NULL || allocator->deallocate == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    _z_allocator = *allocator;
+    return _Z_RES_OK;
+}
+
+void *z_malloc(size_t size) {
+    if (_z_allocator.allocate != NULL) {
+        return _z_allocator.allocate(size, _z_allocator.context);
+    }
+    return _z_platform_malloc(size);
+}
+
+void *z_realloc(void *ptr, size_t size) {
+    if (_z_allocator.reallocate != NULL) {
+        return _z_allocator.reallocate(ptr, size, _z_allocator.context);
+    }
+    return _z_platform_realloc(ptr, size);
+}
+
+void z_free(void *ptr) {
+    if (_z_allocator.deallocate != NULL) {
+        _z_allocator.deallocate(ptr, _z_allocator.context);
+        return;
+    }
+    _z_platform_free(ptr);
+}
+
+/*------------------ Pool ------------------*/
+// Free list heads hold a block index in their lower half and a change count in their upper half
+#define _Z_ALLOC_POOL_INDEX_BITS (sizeof(size_t) * 4)
+#define _Z_ALLOC_POOL_INDEX_MASK (((size_t)1 << _Z_ALLOC_POOL_INDEX_BITS) - 1)
+#define _Z_ALLOC_POOL_NO_CLASS UINT8_MAX
+
+// Blocks are indexed in units of the smallest class from the first page, plus one so that 0 ends a list
+static inline size_t _z_alloc_pool_index(const zp_alloc_pool_t *pool, const uint8_t *block) {
+    return (size_t)(block - pool->_start) / _Z_ALLOC_POOL_MIN_BLOCK_SIZE + 1;
+}
+
+static inline uint8_t *_z_alloc_pool_block(const zp_alloc_pool_t *pool, size_t index) {
+    return pool->_start + (index - 1) * _Z_ALLOC_POOL_MIN_BLOCK_SIZE;
+}
+
+// Free blocks link to the next one with their first word
+static inline _z_atomic_size_t *_z_alloc_pool_link(uint8_t *block) { return (_z_atomic_size_t *)(void *)block; }
+
+static inline size_t _z_alloc_pool_head(size_t head, size_t index) {
+    return ((((head >> _Z_ALLOC_POOL_INDEX_BITS) + 1) << _Z_ALLOC_POOL_INDEX_BITS)) | index;
+}
+
+static inline bool _z_alloc_pool_owns(const zp_alloc_pool_t *pool, const void *ptr) {
+    uintptr_t start = (uintptr_t)pool->_start;
+    return (uintptr_t)ptr >= start && (uintptr_t)ptr < start + pool->_max_pages * Z_ALLOC_POOL_PAGE_SIZE;
+}
+
+static inline size_t _z_alloc_pool_block_size(size_t cls) { return (size_t)_Z_ALLOC_POOL_MIN_BLOCK_SIZE << cls; }
+
+static size_t _z_alloc_pool_class(size_t size) {
+    size_t cls = 0;
+    while (_z_alloc_pool_block_size(cls) < size && cls < _Z_ALLOC_POOL_MAX_CLASSES) {
+        cls++;
+    }
+    return cls;
+}
+
+// Push the chain of blocks from first to last, already linked together
+static void _z_alloc_pool_push(zp_alloc_pool_t *pool, size_t cls, uint8_t *first, uint8_t *last) {
+    size_t index = _z_alloc_pool_index(pool, first);
+    size_t head = _z_atomic_size_load(&pool->_free[cls], _z_memory_order_relaxed);
+    do {
+        _z_atomic_size_store(_z_alloc_pool_link(last), head & _Z_ALLOC_POOL_INDEX_MASK, _z_memory_order_relaxed);
+    } while (!_z_atomic_size_compare_exchange_weak(&pool->_free[cls], &head, _z_alloc_pool_head(head, index),
+                                                   _z_memory_order_release, _z_memory_order_relaxed));
+}
+
+static uint8_t *_z_alloc_pool_pop(zp_alloc_pool_t *pool, size_t cls) {
+    size_t head = _z_atomic_size_load(&pool->_free[cls], _z_memory_order_acquire);
+    while ((head & _Z_ALLOC_POOL_INDEX_MASK) != 0) {
+        uint8_t *block = _z_alloc_pool_block(pool, head & _Z_ALLOC_POOL_INDEX_MASK);
+        // The block may be popped and written meanwhile, which the change count of the head then catches
+        size_t next = _z_atomic_size_load(_z_alloc_pool_link(block), _z_memory_order_relaxed);
+        if (_z_atomic_size_compare_exchange_weak(&pool->_free[cls], &head, _z_alloc_pool_head(head, next),
+                                                 _z_memory_order_acquire, _z_memory_order_acquire)) {
+            return block;
+        }
+    }
+    return NULL;
+}
+
+// Carve a new page into blocks of the class, the first one is returned and the others freed
+static uint8_t *_z_alloc_pool_carve(zp_alloc_pool_t *pool, size_t cls) {
+    size_t page = _z_atomic_size_load(&pool->_next_page, _z_memory_order_relaxed);
+    do {
+        if (page >= pool->_max_pages) {
+            return NULL;
+        }
+    } while (!_z_atomic_size_compare_exchange_weak(&pool->_next_page, &page, page + 1, _z_memory_order_relaxed,
+                                                   _z_memory_order_relaxed));
+    pool->_page_class[page] = (uint8_t)cls;
+    size_t block_size = _z_alloc_pool_block_size(cls);
+    size_t num = Z_ALLOC_POOL_PAGE_SIZE / block_size;
+    uint8_t *first = pool->_start + page * Z_ALLOC_POOL_PAGE_SIZE;
+    if (num > 1) {
+        for (size_t i = 1; i < num - 1; i++) {
+            _z_atomic_size_store(_z_alloc_pool_link(&first[i * block_size]),
+                                 _z_alloc_pool_index(pool, &first[(i + 1) * block_size]), _z_memory_order_relaxed);
+        }
+        _z_alloc_pool_push(pool, cls, &first[block_size], &first[(num - 1) * block_size]);
+    }
+    return first;
+}
+
+z_result_t zp_alloc_pool_init(zp_alloc_pool_t *pool, void *arena, size_t len) {
+    *pool = (zp_alloc_pool_t){0};
+    // One byte per page for its class, then the pages
+    size_t max_pages = len / (Z_ALLOC_POOL_PAGE_SIZE + 1);
+    size_t max_indexed = (_Z_ALLOC_POOL_INDEX_MASK - 1) / (Z_ALLOC_POOL_PAGE_SIZE / _Z_ALLOC_POOL_MIN_BLOCK_SIZE);
+    if (max_pages > max_indexed) {
+        max_pages = max_indexed;
+    }
+    uintptr_t end = (uintptr_t)arena + len;
+    uintptr_t start = ((uintptr_t)arena + max_pages + _Z_ALLOC_POOL_MIN_BLOCK_SIZE - 1) &
+                      ~(uintptr_t)(_Z_ALLOC_POOL_MIN_BLOCK_SIZE - 1);
+    if (max_pages > 0 && start + max_pages * Z_ALLOC_POOL_PAGE_SIZE > end) {
+        max_pages--;
+    }
+    size_t num_classes = 0;
+    while (num_classes < _Z_ALLOC_POOL_MAX_CLASSES &&
+           _z_alloc_pool_block_size(num_classes) <= Z_ALLOC_POOL_PAGE_SIZE / 4) {
+        num_classes++;
+    }
+    if (max_pages == 0 || num_classes == 0) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    pool->_page_class = (uint8_t *)arena;
+    memset(pool->_page_class, _Z_ALLOC_POOL_NO_CLASS, max_pages);
+    pool->_start = (uint8_t *)start;
+    pool->_max_pages = max_pages;
+    pool->_num_classes = num_classes;
+    _z_atomic_size_init(&pool->_next_page, 0);
+    for (size_t i = 0; i < _Z_ALLOC_POOL_MAX_CLASSES; i++) {
+        _z_atomic_size_init(&pool->_free[i], 0);
+    }
+    _z_atomic_size_init(&pool->_allocs, 0);
+    _z_atomic_size_init(&pool->_frees, 0);
+    _z_atomic_size_init(&pool->_fallbacks, 0);
+    return _Z_RES_OK;
+}
+
+void *zp_alloc_pool_malloc(zp_alloc_pool_t *pool, size_t size) {
+    size_t cls = _z_alloc_pool_class(size);
+    if (cls < pool->_num_classes) {
+        uint8_t *block = _z_alloc_pool_pop(pool, cls);
+        if (block == NULL) {
+            block = _z_alloc_pool_carve(pool, cls);
+        }
+        if (block != NULL) {
+            _z_atomic_size_fetch_add(&pool->_allocs, 1, _z_memory_order_relaxed);
+            return block;
+        }
+    }
+    _z_atomic_size_fetch_add(&pool->_fallbacks, 1, _z_memory_order_relaxed);
+    return _z_platform_malloc(size);
+}
+
+void zp_alloc_pool_free(zp_alloc_pool_t *pool, void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    if (!_z_alloc_pool_owns(pool, ptr)) {
+        _z_platform_free(ptr);
+        return;
+    }
+    uint8_t *block = (uint8_t *)ptr;
+    size_t cls = pool->_page_class[(size_t)(block - pool->_start) / Z_ALLOC_POOL_PAGE_SIZE];
+    _z_alloc_pool_push(pool, cls, block, block);
+    _z_atomic_size_fetch_add(&pool->_frees, 1, _z_memory_order_relaxed);
+}
+
+void *zp_alloc_pool_realloc(zp_alloc_pool_t *pool, void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return zp_alloc_pool_malloc(pool, size);
+    }
+    if (!_z_alloc_pool_owns(pool, ptr)) {
+        return _z_platform_realloc(ptr, size);
+    }
+    uint8_t *block = (uint8_t *)ptr;
+    size_t block_size =
+        _z_alloc_pool_block_size(pool->_page_class[(size_t)(block - pool->_start) / Z_ALLOC_POOL_PAGE_SIZE]);
+    if (size <= block_size) {
+        return ptr;
+    }
+    void *moved = zp_alloc_pool_malloc(pool, size);
+    if (moved == NULL) {
+        return NULL;
+    }
+    memcpy(moved, ptr, block_size);
+    zp_alloc_pool_free(pool, ptr);
+    return moved;
+}
+
+static void *_z_alloc_pool_allocate(size_t size, void *context) {
+    return zp_alloc_pool_malloc((zp_alloc_pool_t *)context, size);
+}
+
+static void *_z_alloc_pool_reallocate(void *ptr, size_t size, void *context) {
+    return zp_alloc_pool_realloc((zp_alloc_pool_t *)context, ptr, size);
+}
+
+static void _z_alloc_pool_deallocate(void *ptr, void *context) { zp_alloc_pool_free((zp_alloc_pool_t *)context, ptr); }
+
+void zp_alloc_pool_allocator(zp_alloc_pool_t *pool, zp_allocator_t *allocator) {
+    allocator->allocate = _z_alloc_pool_allocate;
+    allocator->reallocate = _z_alloc_pool_reallocate;
+    allocator->deallocate = _z_alloc_pool_deallocate;
+    allocator->context = pool;
+}
+
+void zp_alloc_pool_stats(zp_alloc_pool_t *pool, zp_alloc_pool_stats_t *stats) {
+    stats->allocs = _z_atomic_size_load(&pool->_allocs, _z_memory_order_relaxed);
+    stats->frees = _z_atomic_size_load(&pool->_frees, _z_memory_order_relaxed);
+    stats->fallbacks = _z_atomic_size_load(&pool->_fallbacks, _z_memory_order_relaxed);
+    stats->pages = _z_atomic_size_load(&pool->_next_page, _z_memory_order_relaxed);
+    stats->max_pages = pool->_max_pages;
+}
+
+#endif  // Z_FEATURE_ALLOCATOR == 1
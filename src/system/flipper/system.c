@@ -43,14 +43,14 @@ void z_random_fill(void* buf, size_t len) {
 }
 
 /*------------------ Memory ------------------*/
-void* z_malloc(size_t size) {
+void* _Z_PLATFORM_MALLOC(size_t size) {
     if (!size) {
         return NULL;
     }
     return malloc(size);
 }
 
-void* z_realloc(void* ptr, size_t size) {
+void* _Z_PLATFORM_REALLOC(void* ptr, size_t size) {
     if (!size) {
         free(ptr);
         return NULL;
@@ -58,7 +58,7 @@ void* z_realloc(void* ptr, size_t size) {
     return realloc(ptr, size);
 }
 
-void z_free(void* ptr) { return free(ptr); }
+void _Z_PLATFORM_FREE(void* ptr) { return free(ptr); }
 
 /*------------------ Task ------------------*/
 
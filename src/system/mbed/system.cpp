@@ -38,11 +38,11 @@ uint64_t z_random_u64(void) { return randLIB_get_64bit(); }
 void z_random_fill(void *buf, size_t len) { randLIB_get_n_bytes_random(buf, len); }
 
 /*------------------ Memory ------------------*/
-void *z_malloc(size_t size) { return malloc(size); }
+void *_Z_PLATFORM_MALLOC(size_t size) { return malloc(size); }
 
-void *z_realloc(void *ptr, size_t size) { return realloc(ptr, size); }
+void *_Z_PLATFORM_REALLOC(void *ptr, size_t size) { return realloc(ptr, size); }
 
-void z_free(void *ptr) { free(ptr); }
+void _Z_PLATFORM_FREE(void *ptr) { free(ptr); }
 
 #if Z_FEATURE_MULTI_THREAD == 1
 /*------------------ Task ------------------*/
@@ -42,14 +42,14 @@ void z_random_fill(void *buf, size_t len) {
 }
 
 /*------------------ Memory ------------------*/
-void *z_malloc(size_t size) {
+void *_Z_PLATFORM_MALLOC(size_t size) {
     if (size == 0) {
         return NULL;
     }
     return pvPortMalloc(size);
 }
 
-void *z_realloc(void *ptr, size_t size) {
+void *_Z_PLATFORM_REALLOC(void *ptr, size_t size) {
     _ZP_UNUSED(ptr);
     _ZP_UNUSED(size);
     // realloc not implemented in FreeRTOS
@@ -57,7 +57,7 @@ void *z_realloc(void *ptr, size_t size) {
     return NULL;
 }
 
-void z_free(void *ptr) { vPortFree(ptr); }
+void _Z_PLATFORM_FREE(void *ptr) { vPortFree(ptr); }
 
 #if Z_FEATURE_MULTI_THREAD == 1
 // In FreeRTOS, tasks created using xTaskCreate must end with vTaskDelete.
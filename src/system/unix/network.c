@@ -11,6 +11,11 @@
 // Contributors:
 //   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
 
+#if defined(ZENOH_LINUX) && !defined(_GNU_SOURCE)
+// Required for sendmmsg
+#define _GNU_SOURCE
+#endif
+
 #include <arpa/inet.h>
 #include <assert.h>
 #include <errno.h>
@@ -26,6 +31,10 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
+#if defined(ZENOH_LINUX)
+#include <sys/epoll.h>
+#endif
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -99,6 +108,263 @@ z_result_t _z_socket_wait_readable(_z_socket_wait_iter_t *iter, uint32_t timeout
     return has_data ? _Z_RES_OK : _Z_NO_DATA_PROCESSED;
 }
 
+#if Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_UDP_MULTICAST == 1 || Z_FEATURE_LINK_UDP_UNICAST == 1
+#define _Z_SOCKET_IOV_MAX 64
+#define _Z_SOCKET_MSG_MAX 32
+
+#if defined(ZENOH_LINUX)
+#define _Z_SOCKET_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define _Z_SOCKET_SEND_FLAGS 0
+#endif
+
+// Wait for room in the socket send buffer, non-blocking sockets return EAGAIN when it is full
+static z_result_t _z_socket_wait_writable(const _z_sys_net_socket_t *sock) {
+    if (errno == EINTR) {
+        return _Z_RES_OK;
+    }
+    if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+        _Z_DEBUG("Errno: %d\n", errno);
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+    }
+    struct pollfd pfd = {.fd = sock->_fd, .events = POLLOUT, .revents = 0};
+    if (poll(&pfd, 1, Z_CONFIG_SOCKET_TIMEOUT) <= 0) {
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+    }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_socket_write_vec(const _z_sys_net_socket_t *sock, const _z_socket_msg_t *msgs, size_t count) {
+    struct iovec iov[_Z_SOCKET_IOV_MAX];
+    // Position of the first byte not written yet
+    size_t msg_idx = 0;
+    size_t iov_idx = 0;
+    size_t offset = 0;
+    while (msg_idx < count) {
+        // Gather the pending buffers
+        size_t iov_cnt = 0;
+        size_t m = msg_idx;
+        size_t i = iov_idx;
+        size_t off = offset;
+        while ((m < count) && (iov_cnt < _Z_SOCKET_IOV_MAX)) {
+            if (i >= msgs[m]._iov_len) {
+                m++;
+                i = 0;
+                continue;
+            }
+            const _z_socket_iovec_t *buf = &msgs[m]._iov[i];
+            if (buf->_len > off) {
+                iov[iov_cnt].iov_base = (void *)_z_cptr_u8_offset(buf->_buf, (ptrdiff_t)off);
+                iov[iov_cnt].iov_len = buf->_len - off;
+                iov_cnt++;
+            }
+            i++;
+            off = 0;
+        }
+        if (iov_cnt == 0) {
+            break;
+        }
+        struct msghdr mh = {0};
+        mh.msg_iov = iov;
+        mh.msg_iovlen = iov_cnt;
+        ssize_t wb = sendmsg(sock->_fd, &mh, _Z_SOCKET_SEND_FLAGS);
+        if (wb < 0) {
+            z_result_t ret = _z_socket_wait_writable(sock);
+            if ((ret != _Z_RES_OK) && ((msg_idx > 0) || (iov_idx > 0) || (offset > 0))) {
+                // The peer holds part of the messages, nothing sent after them could be framed: close the stream
+                shutdown(sock->_fd, SHUT_RDWR);
+            }
+            _Z_RETURN_IF_ERR(ret);
+            continue;
+        }
+        // Move past the written bytes
+        size_t left = (size_t)wb;
+        while ((left > 0) && (msg_idx < count)) {
+            if (iov_idx >= msgs[msg_idx]._iov_len) {
+                msg_idx++;
+                iov_idx = 0;
+                continue;
+            }
+            size_t avail = msgs[msg_idx]._iov[iov_idx]._len - offset;
+            if (left < avail) {
+                offset += left;
+                left = 0;
+            } else {
+                left -= avail;
+                iov_idx++;
+                offset = 0;
+            }
+        }
+        while ((msg_idx < count) && (iov_idx >= msgs[msg_idx]._iov_len)) {
+            msg_idx++;
+            iov_idx = 0;
+        }
+    }
+    return _Z_RES_OK;
+}
+
+#if defined(ZENOH_LINUX)
+z_result_t _z_socket_send_msgs(const _z_sys_net_socket_t *sock, const _z_socket_msg_t *msgs, size_t count,
+                               const _z_sys_net_endpoint_t *rep) {
+    struct mmsghdr mmh[_Z_SOCKET_MSG_MAX];
+    struct iovec iov[_Z_SOCKET_IOV_MAX];
+    size_t sent = 0;
+    while (sent < count) {
+        // Gather as many datagrams as the iovec pool allows
+        size_t msg_cnt = 0;
+        size_t iov_cnt = 0;
+        while (((sent + msg_cnt) < count) && (msg_cnt < _Z_SOCKET_MSG_MAX)) {
+            const _z_socket_msg_t *msg = &msgs[sent + msg_cnt];
+            if (msg->_iov_len > _Z_SOCKET_IOV_MAX) {
+                _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+            }
+            if ((iov_cnt + msg->_iov_len) > _Z_SOCKET_IOV_MAX) {
+                break;
+            }
+            memset(&mmh[msg_cnt], 0, sizeof(mmh[msg_cnt]));
+            mmh[msg_cnt].msg_hdr.msg_iov = &iov[iov_cnt];
+            mmh[msg_cnt].msg_hdr.msg_iovlen = msg->_iov_len;
+            if (rep != NULL) {
+                mmh[msg_cnt].msg_hdr.msg_name = rep->_iptcp->ai_addr;
+                mmh[msg_cnt].msg_hdr.msg_namelen = rep->_iptcp->ai_addrlen;
+            }
+            for (size_t i = 0; i < msg->_iov_len; i++) {
+                iov[iov_cnt].iov_base = (void *)msg->_iov[i]._buf;
+                iov[iov_cnt].iov_len = msg->_iov[i]._len;
+                iov_cnt++;
+            }
+            msg_cnt++;
+        }
+        int res = sendmmsg(sock->_fd, mmh, (unsigned int)msg_cnt, _Z_SOCKET_SEND_FLAGS);
+        if (res < 0) {
+            _Z_RETURN_IF_ERR(_z_socket_wait_writable(sock));
+            continue;
+        }
+        sent += (size_t)res;
+    }
+    return _Z_RES_OK;
+}
+#else
+z_result_t _z_socket_send_msgs(const _z_sys_net_socket_t *sock, const _z_socket_msg_t *msgs, size_t count,
+                               const _z_sys_net_endpoint_t *rep) {
+    struct iovec iov[_Z_SOCKET_IOV_MAX];
+    size_t sent = 0;
+    while (sent < count) {
+        const _z_socket_msg_t *msg = &msgs[sent];
+        if (msg->_iov_len > _Z_SOCKET_IOV_MAX) {
+            _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+        }
+        for (size_t i = 0; i < msg->_iov_len; i++) {
+            iov[i].iov_base = (void *)msg->_iov[i]._buf;
+            iov[i].iov_len = msg->_iov[i]._len;
+        }
+        struct msghdr mh = {0};
+        mh.msg_iov = iov;
+        mh.msg_iovlen = (int)msg->_iov_len;
+        if (rep != NULL) {
+            mh.msg_name = rep->_iptcp->ai_addr;
+            mh.msg_namelen = rep->_iptcp->ai_addrlen;
+        }
+        if (sendmsg(sock->_fd, &mh, _Z_SOCKET_SEND_FLAGS) < 0) {
+            _Z_RETURN_IF_ERR(_z_socket_wait_writable(sock));
+            continue;
+        }
+        sent++;
+    }
+    return _Z_RES_OK;
+}
+#endif
+
+#if defined(ZP_PLATFORM_SOCKET_EPOLL)
+z_result_t _z_socket_wait_set_init(_z_socket_wait_set_t *set) {
+    memset(set, 0, sizeof(_z_socket_wait_set_t));
+    set->_epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (set->_epfd < 0) {
+        _Z_DEBUG("Errno: %d\n", errno);
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    return _Z_RES_OK;
+}
+
+void _z_socket_wait_set_clear(_z_socket_wait_set_t *set) {
+    if (set->_epfd >= 0) {
+        close(set->_epfd);
+        set->_epfd = -1;
+    }
+    z_free(set->_entries);
+    set->_entries = NULL;
+    set->_entries_len = 0;
+    set->_ready_len = 0;
+}
+
+z_result_t _z_socket_wait_set_add(_z_socket_wait_set_t *set, const _z_sys_net_socket_t *sock, void *entry) {
+    if (sock->_fd < 0) {
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    size_t fd = (size_t)sock->_fd;
+    if (fd >= set->_entries_len) {
+        size_t len = (set->_entries_len == 0) ? 16 : set->_entries_len;
+        while (len <= fd) {
+            len *= 2;
+        }
+        void **entries = (void **)z_realloc(set->_entries, len * sizeof(void *));
+        if (entries == NULL) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+        memset(&entries[set->_entries_len], 0, (len - set->_entries_len) * sizeof(void *));
+        set->_entries = entries;
+        set->_entries_len = len;
+    }
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    ev.data.fd = sock->_fd;
+    if (epoll_ctl(set->_epfd, EPOLL_CTL_ADD, sock->_fd, &ev) < 0) {
+        _Z_DEBUG("Errno: %d\n", errno);
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    set->_entries[fd] = entry;
+    return _Z_RES_OK;
+}
+
+void _z_socket_wait_set_remove(_z_socket_wait_set_t *set, const _z_sys_net_socket_t *sock) {
+    if ((sock->_fd < 0) || ((size_t)sock->_fd >= set->_entries_len) || (set->_entries[sock->_fd] == NULL)) {
+        return;
+    }
+    (void)epoll_ctl(set->_epfd, EPOLL_CTL_DEL, sock->_fd, NULL);
+    set->_entries[sock->_fd] = NULL;
+}
+
+z_result_t _z_socket_wait_set_wait(_z_socket_wait_set_t *set, uint32_t timeout_ms) {
+    struct epoll_event events[_Z_SOCKET_WAIT_SET_READY_MAX];
+    set->_ready_len = 0;
+    int res = epoll_wait(set->_epfd, events, _Z_SOCKET_WAIT_SET_READY_MAX,
+                         (timeout_ms > (uint32_t)INT32_MAX) ? -1 : (int)timeout_ms);
+    if (res < 0) {
+        if (errno == EINTR) {
+            return _Z_NO_DATA_PROCESSED;
+        }
+        _Z_DEBUG("Errno: %d\n", errno);
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    for (int i = 0; i < res; i++) {
+        set->_ready[set->_ready_len++] = events[i].data.fd;
+    }
+    return (set->_ready_len > 0) ? _Z_RES_OK : _Z_NO_DATA_PROCESSED;
+}
+
+void _z_socket_wait_set_mark_ready(_z_socket_wait_set_t *set, _z_socket_wait_iter_t *iter) {
+    for (size_t i = 0; i < set->_ready_len; i++) {
+        size_t fd = (size_t)set->_ready[i];
+        if ((fd < set->_entries_len) && (set->_entries[fd] != NULL)) {
+            iter->_current_entry = set->_entries[fd];
+            _z_socket_wait_iter_set_ready(iter, true);
+        }
+    }
+    set->_ready_len = 0;
+}
+#endif
+#endif
+
 #if Z_FEATURE_LINK_BLUETOOTH == 1
 #error "Bluetooth not supported yet on Unix port of Zenoh-Pico"
 #endif
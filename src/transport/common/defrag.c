@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/transport/common/defrag.h"
+
+#include <string.h>
+
+#include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
+
+#if Z_FEATURE_FRAGMENTATION == 1
+
+static inline void _z_defrag_pool_lock(_z_defrag_pool_t *pool) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_lock(&pool->_mutex);
+#else
+    _ZP_UNUSED(pool);
+#endif
+}
+
+static inline void _z_defrag_pool_unlock(_z_defrag_pool_t *pool) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&pool->_mutex);
+#else
+    _ZP_UNUSED(pool);
+#endif
+}
+
+static inline size_t _z_defrag_class_capacity(size_t cls) {
+    size_t cap = (size_t)Z_FRAG_SLAB_SIZE << cls;
+    return (cap < (size_t)Z_FRAG_MAX_SIZE) ? cap : (size_t)Z_FRAG_MAX_SIZE;
+}
+
+// Idle buffers store the next one of their class in their first bytes
+static inline uint8_t *_z_defrag_idle_next(const uint8_t *buf) {
+    uint8_t *next;
+    (void)memcpy(&next, buf, sizeof(next));
+    return next;
+}
+
+static inline void _z_defrag_idle_push(_z_defrag_pool_t *pool, uint8_t *buf, size_t cls) {
+    (void)memcpy(buf, &pool->_idle[cls], sizeof(pool->_idle[cls]));
+    pool->_idle[cls] = buf;
+}
+
+static inline uint8_t *_z_defrag_idle_pop(_z_defrag_pool_t *pool, size_t cls) {
+    uint8_t *buf = pool->_idle[cls];
+    if (buf != NULL) {
+        pool->_idle[cls] = _z_defrag_idle_next(buf);
+    }
+    return buf;
+}
+
+// Must be called with the pool locked
+static z_result_t _z_defrag_pool_take(_z_defrag_pool_t *pool, size_t cls, uint8_t **buf) {
+    *buf = _z_defrag_idle_pop(pool, cls);
+    if (*buf != NULL) {
+        return _Z_RES_OK;
+    }
+    size_t cap = _z_defrag_class_capacity(cls);
+    // Free idle buffers, largest first, until the new one fits in the budget
+    for (size_t i = pool->_class_num; (i > 0) && (pool->_held + cap > (size_t)Z_FRAG_BUDGET); i--) {
+        uint8_t *idle = _z_defrag_idle_pop(pool, i - 1);
+        while (idle != NULL) {
+            pool->_held -= _z_defrag_class_capacity(i - 1);
+            z_free(idle);
+            idle = (pool->_held + cap > (size_t)Z_FRAG_BUDGET) ? _z_defrag_idle_pop(pool, i - 1) : NULL;
+        }
+    }
+    if (pool->_held + cap > (size_t)Z_FRAG_BUDGET) {
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NO_SPACE);
+    }
+    *buf = (uint8_t *)z_malloc(cap);
+    if (*buf == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    pool->_held += cap;
+    return _Z_RES_OK;
+}
+
+z_result_t _z_defrag_pool_init(_z_defrag_pool_t *pool) {
+    memset(pool, 0, sizeof(_z_defrag_pool_t));
+    pool->_class_num = 1;
+    while ((pool->_class_num < _Z_DEFRAG_CLASS_MAX) &&
+           (_z_defrag_class_capacity(pool->_class_num - 1) < (size_t)Z_FRAG_MAX_SIZE)) {
+        pool->_class_num++;
+    }
+#if Z_FEATURE_MULTI_THREAD == 1
+    return _z_mutex_init(&pool->_mutex);
+#else
+    return _Z_RES_OK;
+#endif
+}
+
+void _z_defrag_pool_clear(_z_defrag_pool_t *pool) {
+    for (size_t i = 0; i < pool->_class_num; i++) {
+        uint8_t *idle = _z_defrag_idle_pop(pool, i);
+        while (idle != NULL) {
+            z_free(idle);
+            idle = _z_defrag_idle_pop(pool, i);
+        }
+    }
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_drop(&pool->_mutex);
+#endif
+    pool->_held = 0;
+}
+
+_z_defrag_stats_t _z_defrag_pool_get_stats(_z_defrag_pool_t *pool) {
+    _z_defrag_pool_lock(pool);
+    _z_defrag_stats_t stats = pool->_stats;
+    _z_defrag_pool_unlock(pool);
+    return stats;
+}
+
+void _z_defrag_pool_count_sn_gap(_z_defrag_pool_t *pool) {
+    _z_defrag_pool_lock(pool);
+    pool->_stats._sn_gap_drops++;
+    _z_defrag_pool_unlock(pool);
+}
+
+z_result_t _z_defrag_buf_write(_z_defrag_buf_t *dbuf, _z_defrag_pool_t *pool, const uint8_t *bs, size_t len) {
+    size_t needed = dbuf->_len + len;
+    if ((dbuf->_buf == NULL) || (needed > _z_defrag_class_capacity(dbuf->_class))) {
+        size_t cls = (dbuf->_buf == NULL) ? 0 : (size_t)dbuf->_class + 1;
+        while ((cls < pool->_class_num) && (_z_defrag_class_capacity(cls) < needed)) {
+            cls++;
+        }
+        if (cls == pool->_class_num) {
+            _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NO_SPACE);
+        }
+        uint8_t *buf = NULL;
+        _z_defrag_pool_lock(pool);
+        z_result_t ret = _z_defrag_pool_take(pool, cls, &buf);
+        if (ret == _Z_ERR_TRANSPORT_NO_SPACE) {
+            pool->_stats._budget_drops++;
+        }
+        _z_defrag_pool_unlock(pool);
+        _Z_RETURN_IF_ERR(ret);
+        if (dbuf->_buf != NULL) {
+            // Move to the larger buffer
+            (void)memcpy(buf, dbuf->_buf, dbuf->_len);
+            _z_defrag_pool_lock(pool);
+            _z_defrag_idle_push(pool, dbuf->_buf, dbuf->_class);
+            _z_defrag_pool_unlock(pool);
+        }
+        dbuf->_pool = pool;
+        dbuf->_buf = buf;
+        dbuf->_class = (uint8_t)cls;
+    }
+    (void)memcpy(_z_ptr_u8_offset(dbuf->_buf, (ptrdiff_t)dbuf->_len), bs, len);
+    dbuf->_len = needed;
+    return _Z_RES_OK;
+}
+
+void _z_defrag_buf_clear(_z_defrag_buf_t *dbuf) {
+    if (dbuf->_buf != NULL) {
+        _z_defrag_pool_lock(dbuf->_pool);
+        _z_defrag_idle_push(dbuf->_pool, dbuf->_buf, dbuf->_class);
+        _z_defrag_pool_unlock(dbuf->_pool);
+    }
+    *dbuf = _z_defrag_buf_null();
+}
+
+z_result_t _z_defrag_buf_copy(_z_defrag_buf_t *dst, const _z_defrag_buf_t *src) {
+    *dst = _z_defrag_buf_null();
+    if (src->_buf == NULL) {
+        return _Z_RES_OK;
+    }
+    return _z_defrag_buf_write(dst, src->_pool, src->_buf, src->_len);
+}
+
+#endif  // Z_FEATURE_FRAGMENTATION == 1
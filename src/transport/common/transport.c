@@ -17,18 +17,56 @@
 
 #include "zenoh-pico/link/link.h"
 #include "zenoh-pico/system/common/platform.h"
+#include "zenoh-pico/transport/multicast/repair.h"
 #include "zenoh-pico/transport/unicast/accept.h"
 #include "zenoh-pico/utils/result.h"
 
-void _z_transport_common_clear(_z_transport_common_t *ztc) {
 #if Z_FEATURE_MULTI_THREAD == 1
-    // Clean up the mutexes
+z_result_t _z_transport_common_mutex_init(_z_transport_common_t *ztc) {
+    _Z_RETURN_IF_ERR(_z_mutex_init(&ztc->_mutex_tx));
+    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_rec_init(&ztc->_mutex_peer), _z_mutex_drop(&ztc->_mutex_tx));
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_init(&ztc->_mutex_tx_queues), _z_mutex_drop(&ztc->_mutex_tx);
+                           _z_mutex_rec_drop(&ztc->_mutex_peer));
+#endif
+    return _Z_RES_OK;
+}
+
+void _z_transport_common_mutex_drop(_z_transport_common_t *ztc) {
     _z_mutex_drop(&ztc->_mutex_tx);
     _z_mutex_rec_drop(&ztc->_mutex_peer);
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+    _z_mutex_drop(&ztc->_mutex_tx_queues);
+#endif
+}
+#endif
+
+void _z_transport_common_clear(_z_transport_common_t *ztc) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    // Clean up the mutexes
+    _z_transport_common_mutex_drop(ztc);
 #endif
     // Clean up the buffers
     _z_wbuf_clear(&ztc->_wbuf);
     _z_zbuf_clear(&ztc->_zbuf);
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+    for (size_t i = 0; i < _Z_TX_QUEUE_NUM; i++) {
+        _z_wbuf_clear(&ztc->_tx_queues[i]._wbuf);
+    }
+#endif
+#if Z_FEATURE_PEER_ROUTING == 1
+    _z_peer_route_clear(&ztc->_tx_route);
+    _z_peer_route_clear(&ztc->_tx_next_route);
+#endif
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    _z_multicast_repair_clear(&ztc->_repair);
+#endif
+#if Z_FEATURE_FRAGMENTATION == 1
+    // Peers have given their buffers back by now
+    _z_defrag_pool_clear(&ztc->_defrag_pool);
+    _z_wbuf_clear(&ztc->_frag_buff);
+    _z_wbuf_clear(&ztc->_frag_hdr_buff);
+#endif
 
     _z_link_free(&ztc->_link);
     _z_session_weak_drop(&ztc->_session);
@@ -19,6 +19,7 @@
 #include "zenoh-pico/protocol/codec/network.h"
 #include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/protocol/definitions/transport.h"
+#include "zenoh-pico/transport/multicast/repair.h"
 #include "zenoh-pico/transport/raweth/tx.h"
 #include "zenoh-pico/transport/transport.h"
 #include "zenoh-pico/transport/utils.h"
@@ -35,20 +36,37 @@ void _z_transport_set_send_n_msg_override(_z_session_send_override_fn fn) { _z_s
 
 /*------------------ Transmission helper ------------------*/
 
-static inline bool _z_transport_tx_get_express_status(const _z_network_message_t *msg) {
+static inline _z_n_qos_t _z_transport_tx_get_qos(const _z_network_message_t *msg) {
     switch (msg->_tag) {
         case _Z_N_DECLARE:
-            return _Z_HAS_FLAG(msg->_body._declare._ext_qos._val, _Z_N_QOS_IS_EXPRESS_FLAG);
+            return msg->_body._declare._ext_qos;
         case _Z_N_PUSH:
-            return _Z_HAS_FLAG(msg->_body._push._qos._val, _Z_N_QOS_IS_EXPRESS_FLAG);
+            return msg->_body._push._qos;
         case _Z_N_REQUEST:
-            return _Z_HAS_FLAG(msg->_body._request._ext_qos._val, _Z_N_QOS_IS_EXPRESS_FLAG);
+            return msg->_body._request._ext_qos;
         case _Z_N_RESPONSE:
-            return _Z_HAS_FLAG(msg->_body._response._ext_qos._val, _Z_N_QOS_IS_EXPRESS_FLAG);
+            return msg->_body._response._ext_qos;
+        default:
+            return _Z_N_QOS_DEFAULT;
+    }
+}
+
+static inline bool _z_transport_tx_get_express_status(const _z_network_message_t *msg) {
+    return _z_n_qos_get_express(_z_transport_tx_get_qos(msg));
+}
+
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+static inline z_priority_t _z_transport_tx_get_priority(const _z_network_message_t *msg) {
+    switch (msg->_tag) {
+        // Declarations must reach the remote before any data referring to them
+        case _Z_N_DECLARE:
+        case _Z_N_INTEREST:
+            return _Z_PRIORITY_CONTROL;
         default:
-            return false;
+            return _z_n_qos_get_priority(_z_transport_tx_get_qos(msg));
     }
 }
+#endif
 static _z_zint_t _z_transport_tx_get_sn(_z_transport_common_t *ztc, z_reliability_t reliability) {
     _z_zint_t sn;
     if (reliability == Z_RELIABILITY_RELIABLE) {
@@ -61,7 +79,187 @@ static _z_zint_t _z_transport_tx_get_sn(_z_transport_common_t *ztc, z_reliabilit
     return sn;
 }
 
+// Whether a batch or a fragment goes to a peer of the list it is sent to
+static inline bool _z_transport_tx_peer_is_routed(_z_transport_common_t *ztc,
+                                                  const _z_transport_peer_unicast_t *peer) {
+#if Z_FEATURE_PEER_ROUTING == 1
+    if (!_z_peer_route_includes(&ztc->_tx_route, &peer->common)) {
+        ztc->_route_stats._peer_skips++;
+        return false;
+    }
+    ztc->_route_stats._peer_sends++;
+    return true;
+#else
+    _ZP_UNUSED(ztc);
+    _ZP_UNUSED(peer);
+    return true;
+#endif
+}
+
 #if Z_FEATURE_FRAGMENTATION == 1
+// Fragments sent with a single link call
+#define _Z_TX_FRAG_VEC_MAX 16
+// Stream length prefix, fragment header, largest sn and first fragment extension
+#define _Z_TX_FRAG_HDR_MAX_SIZE (_Z_MSG_LEN_ENC_SIZE + 1 + 10 + 1)
+#define _Z_TX_FRAG_IOV_MAX (_Z_TX_FRAG_VEC_MAX * 4)
+
+/**
+ * Serialize the header of the next fragment, with the stream length prefix if needed, and compute how many payload
+ * bytes follow it. Fragments are cut exactly as __unsafe_z_serialize_zenoh_fragment does.
+ */
+static z_result_t _z_transport_tx_encode_fragment_header(_z_wbuf_t *hdr_buff, uint8_t link_flow, size_t batch_size,
+                                                         size_t bytes_left, z_reliability_t reliability, _z_zint_t sn,
+                                                         bool first, size_t *chunk_len) {
+    size_t start = _z_wbuf_get_wpos(hdr_buff);
+    bool is_stream = link_flow == Z_LINK_CAP_FLOW_STREAM;
+    bool is_final = false;
+    do {
+        _z_wbuf_set_wpos(hdr_buff, start);
+        if (is_stream) {
+            for (uint8_t i = 0; i < _Z_MSG_LEN_ENC_SIZE; i++) {
+                _z_wbuf_put(hdr_buff, 0, start + i);
+            }
+            _z_wbuf_set_wpos(hdr_buff, start + _Z_MSG_LEN_ENC_SIZE);
+        }
+        _z_transport_message_t f_hdr = _z_t_msg_make_fragment_header(sn, reliability, is_final, first, false);
+        _Z_RETURN_IF_ERR(_z_transport_message_encode(hdr_buff, &f_hdr));
+        size_t space_left = batch_size - (_z_wbuf_get_wpos(hdr_buff) - start);
+        if ((is_final == false) && (bytes_left <= space_left)) {
+            is_final = true;  // It is really the final fragment, reserialize the header
+            continue;
+        }
+        *chunk_len = (bytes_left <= space_left) ? bytes_left : space_left;
+        break;
+    } while (1);
+    if (is_stream) {
+        size_t len = _z_wbuf_get_wpos(hdr_buff) - start - _Z_MSG_LEN_ENC_SIZE + *chunk_len;
+        _z_wbuf_put(hdr_buff, _z_get_u16_lsb((uint_fast16_t)len), start);
+        _z_wbuf_put(hdr_buff, _z_get_u16_msb((uint_fast16_t)len), start + 1);
+    }
+    return _Z_RES_OK;
+}
+
+static z_result_t _z_transport_tx_send_msgs(_z_transport_common_t *ztc, const _z_socket_msg_t *msgs, size_t count,
+                                            _z_transport_peer_unicast_slist_t *peers) {
+    if (peers == NULL) {
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+        _z_multicast_repair_store_msgs(ztc, msgs, count);
+#endif
+        return _z_link_send_msgs(ztc->_link, msgs, count, NULL);
+    }
+    z_result_t ret = _Z_RES_OK;
+    _z_transport_peer_unicast_slist_t *curr_list = peers;
+    while (curr_list != NULL) {
+        _z_transport_peer_unicast_t *curr_peer = _z_transport_peer_unicast_slist_value(curr_list);
+        if (_z_transport_tx_peer_is_routed(ztc, curr_peer)) {
+            // Send on peer socket, the other peers still get the fragments if one of them fails
+            z_result_t res = _z_link_send_msgs(ztc->_link, msgs, count, &curr_peer->_socket);
+            if (res != _Z_RES_OK) {
+                ret = res;
+            }
+        }
+        curr_list = _z_transport_peer_unicast_slist_next(curr_list);
+    }
+    return ret;
+}
+
+// Number of frag_buff slices holding the len bytes found from slice idx, offset off
+static size_t _z_transport_tx_frag_slices(const _z_wbuf_t *frag_buff, size_t idx, size_t off, size_t len) {
+    size_t cnt = 0;
+    while (len > 0) {
+        size_t avail = _z_iosli_readable(_z_wbuf_get_iosli(frag_buff, idx)) - off;
+        if (avail > 0) {
+            cnt++;
+        }
+        len -= (len < avail) ? len : avail;
+        idx++;
+        off = 0;
+    }
+    return cnt;
+}
+
+/**
+ * Send the message encoded in frag_buff as fragments, several fragments per link call. Only the fragment headers are
+ * serialized, the payload is sent from frag_buff where wrapped data is still referenced in place.
+ */
+static z_result_t _z_transport_tx_send_fragment_vec(_z_transport_common_t *ztc, const _z_wbuf_t *frag_buff,
+                                                    z_reliability_t reliability, _z_zint_t first_sn,
+                                                    _z_transport_peer_unicast_slist_t *peers) {
+    _z_wbuf_t *hdr_buff = &ztc->_frag_hdr_buff;
+    if (_z_wbuf_capacity(hdr_buff) == 0) {
+        _Z_RETURN_IF_ERR(_z_wbuf_init(hdr_buff, _Z_TX_FRAG_VEC_MAX * _Z_TX_FRAG_HDR_MAX_SIZE, false));
+    }
+    const uint8_t *hdr_base = _z_wbuf_get_iosli(hdr_buff, 0)->_buf;
+    size_t batch_size = _z_wbuf_capacity(&ztc->_wbuf);
+    size_t bytes_left = _z_wbuf_len(frag_buff);
+    // Read position in frag_buff
+    size_t idx = 0;
+    size_t off = 0;
+    _z_zint_t sn = first_sn;
+    bool is_first = true;
+    z_result_t ret = _Z_RES_OK;
+    while ((ret == _Z_RES_OK) && (bytes_left > 0)) {
+        _z_socket_msg_t msgs[_Z_TX_FRAG_VEC_MAX];
+        _z_socket_iovec_t iov[_Z_TX_FRAG_IOV_MAX];
+        size_t msg_cnt = 0;
+        size_t iov_cnt = 0;
+        _z_wbuf_reset(hdr_buff);
+        while ((bytes_left > 0) && (msg_cnt < _Z_TX_FRAG_VEC_MAX)) {
+            // The sn is only taken once the fragment is known to fit in this call
+            _z_zint_t frag_sn = sn;
+            if (!is_first) {
+                frag_sn = (reliability == Z_RELIABILITY_RELIABLE) ? ztc->_sn_tx_reliable : ztc->_sn_tx_best_effort;
+            }
+            size_t hdr_pos = _z_wbuf_get_wpos(hdr_buff);
+            size_t chunk_len = 0;
+            ret = _z_transport_tx_encode_fragment_header(hdr_buff, ztc->_link->_cap._flow, batch_size, bytes_left,
+                                                         reliability, frag_sn, is_first, &chunk_len);
+            if (ret != _Z_RES_OK) {
+                _Z_ERROR("Fragment serialization failed with err %d", ret);
+                break;
+            }
+            // A fragment takes its header and the frag_buff slices of its payload, a single one always fits
+            if ((iov_cnt + 1 + _z_transport_tx_frag_slices(frag_buff, idx, off, chunk_len)) > _Z_TX_FRAG_IOV_MAX) {
+                _z_wbuf_set_wpos(hdr_buff, hdr_pos);
+                break;
+            }
+            if (!is_first) {
+                sn = _z_transport_tx_get_sn(ztc, reliability);
+            }
+            msgs[msg_cnt]._iov = &iov[iov_cnt];
+            iov[iov_cnt]._buf = _z_cptr_u8_offset(hdr_base, (ptrdiff_t)hdr_pos);
+            iov[iov_cnt]._len = _z_wbuf_get_wpos(hdr_buff) - hdr_pos;
+            iov_cnt++;
+            size_t left = chunk_len;
+            while (left > 0) {
+                const _z_iosli_t *ios = _z_wbuf_get_iosli(frag_buff, idx);
+                size_t avail = _z_iosli_readable(ios) - off;
+                size_t len = (left < avail) ? left : avail;
+                if (len > 0) {
+                    iov[iov_cnt]._buf = _z_cptr_u8_offset(ios->_buf, (ptrdiff_t)(ios->_r_pos + off));
+                    iov[iov_cnt]._len = len;
+                    iov_cnt++;
+                }
+                left -= len;
+                off += len;
+                if (off == _z_iosli_readable(ios)) {
+                    idx++;
+                    off = 0;
+                }
+            }
+            msgs[msg_cnt]._iov_len = (size_t)(&iov[iov_cnt] - msgs[msg_cnt]._iov);
+            msg_cnt++;
+            bytes_left -= chunk_len;
+            is_first = false;
+        }
+        if (ret == _Z_RES_OK) {
+            ret = _z_transport_tx_send_msgs(ztc, msgs, msg_cnt, peers);
+            ztc->_transmitted = true;  // Tell session we transmitted data
+        }
+    }
+    return ret;
+}
+
 static z_result_t _z_transport_tx_send_fragment_inner(_z_transport_common_t *ztc, _z_wbuf_t *frag_buff,
                                                       const _z_network_message_t *n_msg, z_reliability_t reliability,
                                                       _z_zint_t first_sn, _z_transport_peer_unicast_slist_t *peers) {
@@ -69,6 +267,10 @@ static z_result_t _z_transport_tx_send_fragment_inner(_z_transport_common_t *ztc
     _z_zint_t sn = first_sn;
     // Encode message on temp buffer
     _Z_RETURN_IF_ERR(_z_network_message_encode(frag_buff, n_msg));
+    // With fewer slices than iovecs, a fragment always fits in a link call, the others are copied fragment by fragment
+    if (_z_link_has_write_vec(ztc->_link) && (_z_wbuf_len_iosli(frag_buff) < _Z_TX_FRAG_IOV_MAX)) {
+        return _z_transport_tx_send_fragment_vec(ztc, frag_buff, reliability, sn, peers);
+    }
     // Fragment message
     while (_z_wbuf_len(frag_buff) > 0) {
         // Get fragment sequence number
@@ -85,13 +287,18 @@ static z_result_t _z_transport_tx_send_fragment_inner(_z_transport_common_t *ztc
         // Send fragment
         __unsafe_z_finalize_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
         if (peers == NULL) {
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+            _z_multicast_repair_store_wbuf(ztc, &ztc->_wbuf);
+#endif
             _Z_RETURN_IF_ERR(_z_link_send_wbuf(ztc->_link, &ztc->_wbuf, NULL));
         } else {
             _z_transport_peer_unicast_slist_t *curr_list = peers;
             while (curr_list != NULL) {
                 _z_transport_peer_unicast_t *curr_peer = _z_transport_peer_unicast_slist_value(curr_list);
-                // Send on peer socket
-                _z_link_send_wbuf(ztc->_link, &ztc->_wbuf, &curr_peer->_socket);
+                if (_z_transport_tx_peer_is_routed(ztc, curr_peer)) {
+                    // Send on peer socket
+                    _z_link_send_wbuf(ztc->_link, &ztc->_wbuf, &curr_peer->_socket);
+                }
                 curr_list = _z_transport_peer_unicast_slist_next(curr_list);
             }
         }
@@ -104,13 +311,14 @@ static z_result_t _z_transport_tx_send_fragment_inner(_z_transport_common_t *ztc
 static z_result_t _z_transport_tx_send_fragment(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
                                                 z_reliability_t reliability, _z_zint_t first_sn,
                                                 _z_transport_peer_unicast_slist_t *peers) {
-    // Create an expandable wbuf for fragmentation
-    _z_wbuf_t frag_buff;
-    _Z_RETURN_IF_ERR(_z_wbuf_init(&frag_buff, _Z_FRAG_BUFF_BASE_SIZE, true));
+    // The expandable wbuf for fragmentation is allocated by the first fragmented message and kept for the next ones
+    if (_z_wbuf_capacity(&ztc->_frag_buff) == 0) {
+        _Z_RETURN_IF_ERR(_z_wbuf_init(&ztc->_frag_buff, _Z_FRAG_BUFF_BASE_SIZE, true));
+    }
     // Send message as fragments
-    z_result_t ret = _z_transport_tx_send_fragment_inner(ztc, &frag_buff, n_msg, reliability, first_sn, peers);
-    // Clear the buffer as it's no longer required
-    _z_wbuf_clear(&frag_buff);
+    z_result_t ret = _z_transport_tx_send_fragment_inner(ztc, &ztc->_frag_buff, n_msg, reliability, first_sn, peers);
+    // The wrapped payload is only referenced while it is sent
+    _z_wbuf_reset_initial(&ztc->_frag_buff);
     return ret;
 }
 
@@ -128,129 +336,432 @@ static z_result_t _z_transport_tx_send_fragment(_z_transport_common_t *ztc, cons
 }
 #endif
 
-static inline bool _z_transport_tx_batch_has_data(_z_transport_common_t *ztc) {
 #if Z_FEATURE_BATCHING == 1
-    return (ztc->_batch_state == _Z_BATCHING_ACTIVE) && (ztc->_batch_count > 0);
+// Whether network messages wait in a batch, started by the application or automatic
+static inline bool _z_transport_tx_is_batching(const _z_transport_common_t *ztc) {
+#if Z_FEATURE_AUTO_BATCHING == 1
+    if (_z_auto_batching_is_active(&ztc->_auto_batching)) {
+        return true;
+    }
+#endif
+    return ztc->_batch_state == _Z_BATCHING_ACTIVE;
+}
+#endif
+
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+// Senders queue messages under the queues mutex alone, the holder of the tx mutex sends them
+#if Z_FEATURE_MULTI_THREAD == 1
+static inline void _z_transport_tx_queues_lock(_z_transport_common_t *ztc) { _z_mutex_lock(&ztc->_mutex_tx_queues); }
+static inline void _z_transport_tx_queues_unlock(_z_transport_common_t *ztc) {
+    _z_mutex_unlock(&ztc->_mutex_tx_queues);
+}
+#else
+static inline void _z_transport_tx_queues_lock(_z_transport_common_t *ztc) { _ZP_UNUSED(ztc); }
+static inline void _z_transport_tx_queues_unlock(_z_transport_common_t *ztc) { _ZP_UNUSED(ztc); }
+#endif
+#endif
+
+static inline bool _z_transport_tx_batch_has_data(_z_transport_common_t *ztc) {
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+    _z_transport_tx_queues_lock(ztc);
+    bool has_data = ztc->_batch_count > 0;
+    _z_transport_tx_queues_unlock(ztc);
+    return has_data;
+#elif Z_FEATURE_BATCHING == 1
+    return _z_transport_tx_is_batching(ztc) && (ztc->_batch_count > 0);
 #else
     _ZP_UNUSED(ztc);
     return false;
 #endif
 }
 
+#if Z_FEATURE_AUTO_BATCHING == 1
+static size_t _z_transport_tx_batch_len(const _z_transport_common_t *ztc) {
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+    size_t len = 0;
+    for (size_t i = 0; i < _Z_TX_QUEUE_NUM; i++) {
+        if (ztc->_tx_queues[i]._count > 0) {
+            len += _z_wbuf_len(&ztc->_tx_queues[i]._wbuf);
+        }
+    }
+    return len;
+#else
+    return _z_wbuf_len(&ztc->_wbuf);
+#endif
+}
+
+// Batches started by the application, and the ones of a backpressured link, are only sent once full
+static bool _z_transport_tx_auto_batch_is_full(const _z_transport_common_t *ztc) {
+    const _z_auto_batching_t *ab = &ztc->_auto_batching;
+    if (!_z_auto_batching_is_active(ab) || (ab->_max_bytes == 0) || ab->_backpressured ||
+        (ztc->_batch_state == _Z_BATCHING_ACTIVE)) {
+        return false;
+    }
+    return _z_transport_tx_batch_len(ztc) >= ab->_max_bytes;
+}
+#endif
+
 static z_result_t _z_transport_tx_flush_buffer(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers) {
     __unsafe_z_finalize_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+#if Z_FEATURE_AUTO_BATCHING == 1
+    z_clock_t start = z_clock_now();
+#endif
     // Send network message
     if (peers == NULL) {
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+        // Kept before sending, a receiver reports it lost if the send fails
+        _z_multicast_repair_store_wbuf(ztc, &ztc->_wbuf);
+#endif
         _Z_RETURN_IF_ERR(_z_link_send_wbuf(ztc->_link, &ztc->_wbuf, NULL));
     } else {
         _z_transport_peer_unicast_slist_t *curr_list = peers;
         while (curr_list != NULL) {
             _z_transport_peer_unicast_t *curr_peer = _z_transport_peer_unicast_slist_value(curr_list);
-            // Send on peer socket
-            _z_link_send_wbuf(ztc->_link, &ztc->_wbuf, &curr_peer->_socket);
+            if (_z_transport_tx_peer_is_routed(ztc, curr_peer)) {
+                // Send on peer socket
+                _z_link_send_wbuf(ztc->_link, &ztc->_wbuf, &curr_peer->_socket);
+            }
             curr_list = _z_transport_peer_unicast_slist_next(curr_list);
         }
     }
     ztc->_transmitted = true;  // Tell session we transmitted data
-#if Z_FEATURE_BATCHING == 1
+#if Z_FEATURE_AUTO_BATCHING == 1
+    if (_z_auto_batching_is_active(&ztc->_auto_batching)) {
+        // A link slower than the delay gets full batches, for fewer and larger writes
+        ztc->_auto_batching._backpressured = z_clock_elapsed_us(&start) > ztc->_auto_batching._max_delay_us;
+    }
+#endif
+#if Z_FEATURE_BATCHING == 1 && Z_FEATURE_TX_PRIORITY_QUEUES == 0
     ztc->_batch_count = 0;
 #endif
     return _Z_RES_OK;
 }
 
-static z_result_t _z_transport_tx_flush_or_incr_batch(_z_transport_common_t *ztc,
-                                                      _z_transport_peer_unicast_slist_t *peers) {
-#if Z_FEATURE_BATCHING == 1
-    if (ztc->_batch_state == _Z_BATCHING_ACTIVE) {
-        // Increment batch count
-        ztc->_batch_count++;
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+// Room kept in the link buffer for the stream length prefix and a frame header with the largest sn
+#define _Z_TX_QUEUE_HEADER_RESERVE (_Z_MSG_LEN_ENC_SIZE + 1 + 10)
+#define _Z_TX_QUEUE_BIT(i) ((uint8_t)(1u << (i)))
+// The queues of the given priority and the more urgent ones
+#define _Z_TX_QUEUE_UP_TO(i) ((uint8_t)((1u << ((i) + 1)) - 1u))
+
+// Frames each queue may send in a round of the scheduler. Control and real time queues have none, they are always
+// sent first, the others share the link in proportion so that the least urgent ones still get a part of it.
+static const uint8_t _z_transport_tx_queue_weights[_Z_TX_QUEUE_NUM] = {0, 0, 32, 16, 8, 4, 2, 1};
+
+// Largest message a queue holds, larger ones are sent as fragments
+static inline size_t _z_transport_tx_queue_capacity(const _z_transport_common_t *ztc) {
+    size_t capacity = _z_wbuf_capacity(&ztc->_wbuf);
+    return (capacity > _Z_TX_QUEUE_HEADER_RESERVE) ? capacity - _Z_TX_QUEUE_HEADER_RESERVE : 0;
+}
+
+/**
+ * The queues to send now, among the given ones and the ones that are due: all of them when not batching or when the
+ * automatic batch is full, else the ones up to the least urgent express message.
+ *
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztc->_mutex_tx_queues
+ */
+static uint8_t _z_transport_tx_queue_ready(const _z_transport_common_t *ztc, uint8_t mask) {
+    uint8_t pending = 0;
+    uint8_t due = 0;
+    for (size_t i = 0; i < _Z_TX_QUEUE_NUM; i++) {
+        const _z_transport_tx_queue_t *queue = &ztc->_tx_queues[i];
+        if (queue->_count > 0) {
+            pending |= _Z_TX_QUEUE_BIT(i);
+            if (queue->_express) {
+                due = _Z_TX_QUEUE_UP_TO(i);
+            }
+        }
+    }
+    if (!_z_transport_tx_is_batching(ztc)) {
+        due = pending;
+    }
+#if Z_FEATURE_AUTO_BATCHING == 1
+    else if (_z_transport_tx_auto_batch_is_full(ztc)) {
+        due = pending;
+    }
+#endif
+    return (uint8_t)((mask | due) & pending);
+}
+
+// The next queue to send among the ready ones, _Z_TX_QUEUE_NUM when none is
+static size_t _z_transport_tx_queue_pick(_z_transport_common_t *ztc, uint8_t ready) {
+    if (ready == 0) {
+        return _Z_TX_QUEUE_NUM;
+    }
+    for (size_t i = 0; i < _Z_TX_QUEUE_NUM; i++) {
+        if (((ready & _Z_TX_QUEUE_BIT(i)) != 0) && (_z_transport_tx_queue_weights[i] == 0)) {
+            return i;
+        }
+    }
+    while (true) {
+        for (size_t i = 0; i < _Z_TX_QUEUE_NUM; i++) {
+            if (((ready & _Z_TX_QUEUE_BIT(i)) != 0) && (ztc->_tx_queues[i]._credits > 0)) {
+                ztc->_tx_queues[i]._credits--;
+                return i;
+            }
+        }
+        // The ready queues have used their credits, a new round starts
+        for (size_t i = 0; i < _Z_TX_QUEUE_NUM; i++) {
+            ztc->_tx_queues[i]._credits = _z_transport_tx_queue_weights[i];
+        }
+    }
+}
+
+/**
+ * Send the ready queues, one frame per queue in the order of the scheduler, until none is left. The frame sequence
+ * numbers are taken as the frames are sent, so that they follow the wire order.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztc->_mutex_tx
+ */
+static z_result_t _z_transport_tx_queue_drain(_z_transport_common_t *ztc, uint8_t mask,
+                                              _z_transport_peer_unicast_slist_t *peers) {
+    z_result_t ret = _Z_RES_OK;
+    while (ret == _Z_RES_OK) {
+        _z_transport_tx_queues_lock(ztc);
+        size_t i = _z_transport_tx_queue_pick(ztc, _z_transport_tx_queue_ready(ztc, mask));
+        if (i == _Z_TX_QUEUE_NUM) {
+            _z_transport_tx_queues_unlock(ztc);
+            break;
+        }
+        mask &= (uint8_t)~_Z_TX_QUEUE_BIT(i);
+        _z_transport_tx_queue_t *queue = &ztc->_tx_queues[i];
+        __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+        _z_zint_t sn = _z_transport_tx_get_sn(ztc, queue->_reliability);
+        _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, queue->_reliability);
+        ret = _z_transport_message_encode(&ztc->_wbuf, &t_msg);
+        if (ret == _Z_RES_OK) {
+            ret = _z_wbuf_siphon(&ztc->_wbuf, &queue->_wbuf, _z_wbuf_len(&queue->_wbuf));
+        }
+        ztc->_batch_count -= queue->_count;
+        queue->_count = 0;
+        queue->_responses = 0;
+        queue->_express = false;
+        _z_wbuf_reset(&queue->_wbuf);
+        _z_transport_tx_queues_unlock(ztc);
+        if (ret == _Z_RES_OK) {
+            ret = _z_transport_tx_flush_buffer(ztc, peers);
+        }
+    }
+    return ret;
+}
+
+/**
+ * Append a network message to the queue of its priority. The message isn't queued when it doesn't fit in the queue
+ * or has another reliability than its frame, nor when it is a response final and replies wait in other queues, for
+ * the querier to get them before it closes the query. The queues to send first are then given back.
+ *
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztc->_mutex_tx_queues
+ */
+static z_result_t _z_transport_tx_queue_add(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
+                                            size_t msg_len, z_reliability_t reliability, uint8_t *blocking) {
+    z_priority_t priority = _z_transport_tx_get_priority(n_msg);
+    _z_transport_tx_queue_t *queue = &ztc->_tx_queues[priority];
+    *blocking = 0;
+    if (n_msg->_tag == _Z_N_RESPONSE_FINAL) {
+        for (size_t i = 0; i < _Z_TX_QUEUE_NUM; i++) {
+            if ((i != (size_t)priority) && (ztc->_tx_queues[i]._responses > 0)) {
+                *blocking |= _Z_TX_QUEUE_BIT(i);
+            }
+        }
+    }
+    if ((queue->_count > 0) &&
+        ((queue->_reliability != reliability) || (msg_len > _z_wbuf_space_left(&queue->_wbuf)))) {
+        *blocking |= _Z_TX_QUEUE_BIT(priority);
+    }
+    if (*blocking != 0) {
         return _Z_RES_OK;
+    }
+    // Queue buffers are only allocated for the priorities in use
+    if (_z_wbuf_capacity(&queue->_wbuf) == 0) {
+        _Z_RETURN_IF_ERR(_z_wbuf_init(&queue->_wbuf, _z_transport_tx_queue_capacity(ztc), false));
+    }
+    size_t prev_wpos = _z_wbuf_get_wpos(&queue->_wbuf);
+    z_result_t ret = _z_network_message_encode(&queue->_wbuf, n_msg);
+    if (ret != _Z_RES_OK) {
+        // Remove partially encoded data
+        _z_wbuf_set_wpos(&queue->_wbuf, prev_wpos);
+        return ret;
+    }
+    queue->_reliability = reliability;
+    queue->_count++;
+    if (n_msg->_tag == _Z_N_RESPONSE) {
+        queue->_responses++;
+    }
+    if (_z_transport_tx_get_express_status(n_msg)) {
+        queue->_express = true;
+    }
+    ztc->_batch_count++;
+    return _Z_RES_OK;
+}
+
+/**
+ * Queue a network message by priority, then send the queues that are due. A message larger than a queue is sent as
+ * fragments after the more urgent queues, the tx mutex held for the whole train keeps their sequence numbers
+ * consecutive.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztc->_mutex_tx
+ */
+static z_result_t _z_transport_tx_queue_push(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
+                                             z_reliability_t reliability, _z_transport_peer_unicast_slist_t *peers) {
+    size_t msg_len = _z_network_message_encoded_len(n_msg);
+    if (msg_len > _z_transport_tx_queue_capacity(ztc)) {
+        z_priority_t priority = _z_transport_tx_get_priority(n_msg);
+        _Z_RETURN_IF_ERR(_z_transport_tx_queue_drain(ztc, _Z_TX_QUEUE_UP_TO(priority), peers));
+        __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+        _z_zint_t sn = _z_transport_tx_get_sn(ztc, reliability);
+        _Z_RETURN_IF_ERR(_z_transport_tx_send_fragment(ztc, n_msg, reliability, sn, peers));
     } else {
-        return _z_transport_tx_flush_buffer(ztc, peers);
+        uint8_t blocking = 0;
+        do {
+            _z_transport_tx_queues_lock(ztc);
+            z_result_t ret = _z_transport_tx_queue_add(ztc, n_msg, msg_len, reliability, &blocking);
+            _z_transport_tx_queues_unlock(ztc);
+            _Z_RETURN_IF_ERR(ret);
+            if (blocking != 0) {
+                _Z_RETURN_IF_ERR(_z_transport_tx_queue_drain(ztc, blocking, peers));
+            }
+        } while (blocking != 0);
     }
+    return _z_transport_tx_queue_drain(ztc, 0, peers);
+}
+#endif
+
+static z_result_t _z_transport_tx_flush_batch(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers) {
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+    return _z_transport_tx_queue_drain(ztc, _Z_TX_QUEUE_UP_TO(Z_PRIORITY_BACKGROUND), peers);
 #else
     return _z_transport_tx_flush_buffer(ztc, peers);
 #endif
 }
 
-static z_result_t _z_transport_tx_batch_overflow(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
-                                                 z_reliability_t reliability, _z_zint_t sn, size_t prev_wpos,
-                                                 _z_transport_peer_unicast_slist_t *peers) {
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 0
+static z_result_t _z_transport_tx_flush_or_incr_batch(_z_transport_common_t *ztc,
+                                                      _z_transport_peer_unicast_slist_t *peers) {
 #if Z_FEATURE_BATCHING == 1
-    // Remove partially encoded data
-    _z_wbuf_set_wpos(&ztc->_wbuf, prev_wpos);
-    // Send batch
-    _Z_RETURN_IF_ERR(_z_transport_tx_flush_buffer(ztc, peers));
-    // Init buffer
-    __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
-    sn = _z_transport_tx_get_sn(ztc, reliability);
-    _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, reliability);
-    _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &t_msg));
-    // Retry encode
-    z_result_t ret = _z_network_message_encode(&ztc->_wbuf, n_msg);
-    if (ret != _Z_RES_OK) {
-        // Message still doesn't fit in buffer, send as fragments
-        return _z_transport_tx_send_fragment(ztc, n_msg, reliability, sn, peers);
-    } else {
-        if (_z_transport_tx_get_express_status(n_msg)) {
-            // Send immediately
+    if (_z_transport_tx_is_batching(ztc)) {
+        // Increment batch count
+        ztc->_batch_count++;
+#if Z_FEATURE_AUTO_BATCHING == 1
+        if (_z_transport_tx_auto_batch_is_full(ztc)) {
             return _z_transport_tx_flush_buffer(ztc, peers);
-        } else {
-            // Increment batch
-            ztc->_batch_count++;
         }
+#endif
+        return _Z_RES_OK;
+    } else {
+        return _z_transport_tx_flush_buffer(ztc, peers);
     }
-    return _Z_RES_OK;
 #else
-    _ZP_UNUSED(ztc);
-    _ZP_UNUSED(n_msg);
-    _ZP_UNUSED(reliability);
-    _ZP_UNUSED(sn);
-    _ZP_UNUSED(prev_wpos);
-    _ZP_UNUSED(peers);
-    return _Z_RES_OK;
+    return _z_transport_tx_flush_buffer(ztc, peers);
 #endif
 }
-
-static inline size_t _z_transport_tx_save_wpos(_z_wbuf_t *wbuf) {
-#if Z_FEATURE_BATCHING == 1
-    return _z_wbuf_get_wpos(wbuf);
-#else
-    _ZP_UNUSED(wbuf);
-    return 0;
 #endif
-}
 
 static z_result_t _z_transport_tx_send_n_msg_inner(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
                                                    z_reliability_t reliability,
                                                    _z_transport_peer_unicast_slist_t *peers) {
-    // Init buffer
-    _z_zint_t sn = 0;
-    bool batch_has_data = _z_transport_tx_batch_has_data(ztc);
-    if (!batch_has_data) {
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+    return _z_transport_tx_queue_push(ztc, n_msg, reliability, peers);
+#else
+    // The message length decides whether to flush the batch or to fragment before anything is encoded
+    size_t msg_len = _z_network_message_encoded_len(n_msg);
+    if (_z_transport_tx_batch_has_data(ztc) && (msg_len > _z_wbuf_space_left(&ztc->_wbuf))) {
+        _Z_RETURN_IF_ERR(_z_transport_tx_flush_buffer(ztc, peers));
+    }
+    if (!_z_transport_tx_batch_has_data(ztc)) {
+        // Init buffer
         __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
-        sn = _z_transport_tx_get_sn(ztc, reliability);
+        _z_zint_t sn = _z_transport_tx_get_sn(ztc, reliability);
         _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, reliability);
         _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &t_msg));
+        if (msg_len > _z_wbuf_space_left(&ztc->_wbuf)) {
+            // Message doesn't fit in a batch, send as fragments
+            return _z_transport_tx_send_fragment(ztc, n_msg, reliability, sn, peers);
+        }
     }
-    // Try encoding the network message
-    size_t prev_wpos = _z_transport_tx_save_wpos(&ztc->_wbuf);
+    size_t prev_wpos = _z_wbuf_get_wpos(&ztc->_wbuf);
     z_result_t ret = _z_network_message_encode(&ztc->_wbuf, n_msg);
-    if (ret == _Z_RES_OK) {
-        if (_z_transport_tx_get_express_status(n_msg)) {
-            // Send immediately
-            return _z_transport_tx_flush_buffer(ztc, peers);
-        } else {
-            // Flush buffer or increase batch
-            return _z_transport_tx_flush_or_incr_batch(ztc, peers);
-        }
-    } else if (!batch_has_data) {
-        // Message doesn't fit in buffer, send as fragments
-        return _z_transport_tx_send_fragment(ztc, n_msg, reliability, sn, peers);
+    if (ret != _Z_RES_OK) {
+        // Remove partially encoded data
+        _z_wbuf_set_wpos(&ztc->_wbuf, prev_wpos);
+        return ret;
+    }
+    if (_z_transport_tx_get_express_status(n_msg)) {
+        // Send immediately
+        return _z_transport_tx_flush_buffer(ztc, peers);
     } else {
-        // Buffer is too full for message
-        return _z_transport_tx_batch_overflow(ztc, n_msg, reliability, sn, prev_wpos, peers);
+        // Flush buffer or increase batch
+        return _z_transport_tx_flush_or_incr_batch(ztc, peers);
     }
+#endif
+}
+
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1 && Z_FEATURE_MULTI_THREAD == 1
+// Release the tx mutex, after sending the messages that got due meanwhile: their senders may have left them to it
+static z_result_t _z_transport_tx_queue_release(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers) {
+    z_result_t ret = _Z_RES_OK;
+    bool due = false;
+    do {
+        ret = _z_transport_tx_queue_drain(ztc, 0, peers);
+        _z_transport_tx_mutex_unlock(ztc);
+        _z_transport_tx_queues_lock(ztc);
+        due = (_z_transport_tx_queue_ready(ztc, 0) != 0);
+        _z_transport_tx_queues_unlock(ztc);
+    } while ((ret == _Z_RES_OK) && due && (_z_transport_tx_mutex_lock(ztc, false) == _Z_RES_OK));
+    return ret;
+}
+
+/**
+ * Queue a network message without the tx mutex. It is only taken when the message is due, so that the senders of
+ * batched messages do not hold up the urgent ones while the link is written. A due message that finds the mutex taken
+ * is left to its holder when its congestion control drops, as the holder sends the due queues before releasing it.
+ */
+static z_result_t _z_transport_tx_queue_send(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
+                                             z_reliability_t reliability, z_congestion_control_t cong_ctrl) {
+    bool queued = false;
+    size_t msg_len = _z_network_message_encoded_len(n_msg);
+    if (msg_len <= _z_transport_tx_queue_capacity(ztc)) {
+        uint8_t blocking = 0;
+        _z_transport_tx_queues_lock(ztc);
+        z_result_t ret = _z_transport_tx_queue_add(ztc, n_msg, msg_len, reliability, &blocking);
+        bool due = (_z_transport_tx_queue_ready(ztc, 0) != 0);
+        _z_transport_tx_queues_unlock(ztc);
+        _Z_RETURN_IF_ERR(ret);
+        queued = (blocking == 0);
+        if (queued && !due) {
+            return _Z_RES_OK;
+        }
+    }
+    z_result_t ret = _z_transport_tx_mutex_lock(ztc, cong_ctrl == Z_CONGESTION_CONTROL_BLOCK);
+    if (ret != _Z_RES_OK) {
+        if (queued) {
+            return _Z_RES_OK;
+        }
+        _Z_INFO("Dropping zenoh message because of congestion control");
+        return ret;
+    }
+    if (!queued) {
+        ret = _z_transport_tx_queue_push(ztc, n_msg, reliability, NULL);
+    }
+    z_result_t release_ret = _z_transport_tx_queue_release(ztc, NULL);
+    return (ret != _Z_RES_OK) ? ret : release_ret;
+}
+#endif
+
+// Release the tx mutex taken to send a message
+static z_result_t _z_transport_tx_release(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers) {
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1 && Z_FEATURE_MULTI_THREAD == 1
+    return _z_transport_tx_queue_release(ztc, peers);
+#else
+    _ZP_UNUSED(peers);
+    _z_transport_tx_mutex_unlock(ztc);
+    return _Z_RES_OK;
+#endif
 }
 
 static z_result_t _z_transport_tx_send_t_msg_inner(_z_transport_common_t *ztc, const _z_transport_message_t *t_msg,
@@ -258,8 +769,12 @@ static z_result_t _z_transport_tx_send_t_msg_inner(_z_transport_common_t *ztc, c
     // Send batch if needed
     bool batch_has_data = _z_transport_tx_batch_has_data(ztc);
     if (batch_has_data) {
-        _Z_RETURN_IF_ERR(_z_transport_tx_flush_buffer(ztc, peers));
+        _Z_RETURN_IF_ERR(_z_transport_tx_flush_batch(ztc, peers));
     }
+#if Z_FEATURE_PEER_ROUTING == 1
+    // Transport messages go to all the peers given
+    _z_peer_route_reset(&ztc->_tx_route, false, false);
+#endif
     // Encode transport message
     __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
     _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, t_msg));
@@ -276,8 +791,8 @@ z_result_t _z_transport_tx_send_t_msg(_z_transport_common_t *ztc, const _z_trans
 
     ret = _z_transport_tx_send_t_msg_inner(ztc, t_msg, peers);
 
-    _z_transport_tx_mutex_unlock(ztc);
-    return ret;
+    z_result_t release_ret = _z_transport_tx_release(ztc, peers);
+    return (ret != _Z_RES_OK) ? ret : release_ret;
 }
 
 z_result_t _z_transport_tx_send_t_msg_wrapper(_z_transport_common_t *ztc, const _z_transport_message_t *t_msg) {
@@ -290,6 +805,12 @@ static z_result_t _z_transport_tx_send_n_msg(_z_transport_common_t *ztc, const _
     z_result_t ret = _Z_RES_OK;
     _Z_DEBUG("Send network message");
 
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1 && Z_FEATURE_MULTI_THREAD == 1
+    // With a peer list, senders are already serialized by the peer mutex
+    if ((peers == NULL) && !_z_transport_batch_hold_tx_mutex()) {
+        return _z_transport_tx_queue_send(ztc, n_msg, reliability, cong_ctrl);
+    }
+#endif
     // Acquire the lock and drop the message if needed
     if (!_z_transport_batch_hold_tx_mutex()) {
         ret = _z_transport_tx_mutex_lock(ztc, cong_ctrl == Z_CONGESTION_CONTROL_BLOCK);
@@ -301,7 +822,8 @@ static z_result_t _z_transport_tx_send_n_msg(_z_transport_common_t *ztc, const _
     // Process message
     ret = _z_transport_tx_send_n_msg_inner(ztc, n_msg, reliability, peers);
     if (!_z_transport_batch_hold_tx_mutex()) {
-        _z_transport_tx_mutex_unlock(ztc);
+        z_result_t release_ret = _z_transport_tx_release(ztc, peers);
+        ret = (ret != _Z_RES_OK) ? ret : release_ret;
     }
     return ret;
 }
@@ -322,9 +844,10 @@ static z_result_t _z_transport_tx_send_n_batch(_z_transport_common_t *ztc, z_con
         }
         // Send batch
         _Z_DEBUG("Send network batch");
-        ret = _z_transport_tx_flush_buffer(ztc, peers);
+        ret = _z_transport_tx_flush_batch(ztc, peers);
         if (!_z_transport_batch_hold_tx_mutex()) {
-            _z_transport_tx_mutex_unlock(ztc);
+            z_result_t release_ret = _z_transport_tx_release(ztc, peers);
+            ret = (ret != _Z_RES_OK) ? ret : release_ret;
         }
         return ret;
     }
@@ -337,6 +860,54 @@ static z_result_t _z_transport_tx_send_n_batch(_z_transport_common_t *ztc, z_con
 #endif
 }
 
+#if Z_FEATURE_PEER_ROUTING == 1
+/**
+ * Send a network message in peer mode, to a single peer or else to the peers it is routed to. A batch goes to a single
+ * route: the one of a pending batch is widened to the peers of the next message, so that messages of different routes
+ * still share batches, and the peers get at most the messages of the batches they are routed some of. A message sent
+ * to a single peer, such as a reply, never goes to the others, and the pending batch is sent before it instead.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztc->_mutex_peer
+ */
+static z_result_t _z_transport_tx_send_n_msg_routed(_z_session_t *zn, _z_transport_common_t *ztc,
+                                                    const _z_network_message_t *n_msg, z_reliability_t reliability,
+                                                    z_congestion_control_t cong_ctrl,
+                                                    const _z_transport_peer_common_t *peer,
+                                                    _z_transport_peer_unicast_slist_t *peers) {
+    _z_peer_route_t *route = &ztc->_tx_next_route;
+    if (peer != NULL) {
+        _z_peer_route_reset(route, true, false);
+        _Z_RETURN_IF_ERR(_z_peer_route_add(route, peer));
+    } else {
+        _z_peer_route_table_lookup(zn, n_msg, route);
+    }
+    if ((peer == NULL) && route->_selective) {
+        bool reached = (route->_len > 0);
+        for (_z_transport_peer_unicast_slist_t *xs = peers; !reached && (xs != NULL);
+             xs = _z_transport_peer_unicast_slist_next(xs)) {
+            reached = _z_peer_route_includes(route, &_z_transport_peer_unicast_slist_value(xs)->common);
+        }
+        if (!reached) {
+            ztc->_route_stats._unmatched++;
+            return _Z_RES_OK;
+        }
+        ztc->_route_stats._routed++;
+    }
+    if (!_z_peer_route_eq(route, &ztc->_tx_route)) {
+        if (!_z_transport_tx_batch_has_data(ztc) || !_z_peer_route_merge(&ztc->_tx_route, route)) {
+            _Z_RETURN_IF_ERR(_z_transport_tx_send_n_batch(ztc, cong_ctrl, peers));
+            // Swapped, for the storage of both to be reused
+            _z_peer_route_t prev = ztc->_tx_route;
+            ztc->_tx_route = ztc->_tx_next_route;
+            ztc->_tx_next_route = prev;
+        }
+    }
+    return _z_transport_tx_send_n_msg(ztc, n_msg, reliability, cong_ctrl, peers);
+}
+#endif
+
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
@@ -463,8 +1034,7 @@ z_result_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z
     do {
         size_t w_pos = _z_wbuf_get_wpos(dst);  // Mark the buffer for the writing operation
 
-        _z_transport_message_t f_hdr =
-            _z_t_msg_make_fragment_header(sn, reliability == Z_RELIABILITY_RELIABLE, is_final, first, false);
+        _z_transport_message_t f_hdr = _z_t_msg_make_fragment_header(sn, reliability, is_final, first, false);
         ret = _z_transport_message_encode(dst, &f_hdr);  // Encode the frame header
         if (ret == _Z_RES_OK) {
             size_t space_left = _z_wbuf_space_left(dst);
@@ -507,6 +1077,11 @@ z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *z_msg, z_
                 if (!_z_transport_batch_hold_peer_mutex()) {
                     _z_transport_peer_mutex_lock(ztc);
                 }
+#if Z_FEATURE_PEER_ROUTING == 1
+                ret = _z_transport_tx_send_n_msg_routed(zn, ztc, z_msg, reliability, cong_ctrl,
+                                                        (const _z_transport_peer_common_t *)peer,
+                                                        zn->_tp._transport._unicast._peers);
+#else
                 if (peer == NULL) {
                     ret = _z_transport_tx_send_n_msg(ztc, z_msg, reliability, cong_ctrl,
                                                      zn->_tp._transport._unicast._peers);
@@ -521,6 +1096,7 @@ z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *z_msg, z_
                         z_free(dst_list);
                     }
                 }
+#endif
                 if (!_z_transport_batch_hold_peer_mutex()) {
                     _z_transport_peer_mutex_unlock(ztc);
                 }
@@ -571,3 +1147,46 @@ z_result_t _z_send_n_batch(_z_session_t *zn, z_congestion_control_t cong_ctrl) {
     }
     return ret;
 }
+
+#if Z_FEATURE_AUTO_BATCHING == 1
+// A sender holding the transport is about to write to the link, the batch then waits for the next period
+static z_result_t _z_transport_tx_auto_batch_flush(_z_transport_common_t *ztc) {
+    _z_session_t *zn = _z_transport_common_get_session(ztc);
+    _z_transport_peer_unicast_slist_t *peers = NULL;
+    bool peer_mode = (zn->_tp._type == _Z_TRANSPORT_UNICAST_TYPE) && (zn->_mode == Z_WHATAMI_PEER);
+    if (peer_mode) {
+        if (_z_transport_peer_mutex_try_lock(ztc) != _Z_RES_OK) {
+            return _Z_RES_OK;
+        }
+        peers = zn->_tp._transport._unicast._peers;
+    }
+    z_result_t ret = _Z_RES_OK;
+    if ((!peer_mode || (peers != NULL)) && (_z_transport_tx_mutex_lock(ztc, false) == _Z_RES_OK)) {
+        // The batch is written under the tx mutex, a batch started by the user is left to them
+        if ((ztc->_batch_state != _Z_BATCHING_ACTIVE) && _z_transport_tx_batch_has_data(ztc)) {
+            ret = _z_transport_tx_flush_batch(ztc, peers);
+        }
+        z_result_t release_ret = _z_transport_tx_release(ztc, peers);
+        ret = (ret != _Z_RES_OK) ? ret : release_ret;
+    }
+    if (peer_mode) {
+        _z_transport_peer_mutex_unlock(ztc);
+    }
+    return ret;
+}
+
+_z_fut_fn_result_t _zp_auto_batching_task_fn(void *ztc_arg, _z_executor_t *executor) {
+    _ZP_UNUSED(executor);
+    _z_transport_common_t *ztc = (_z_transport_common_t *)ztc_arg;
+    if (ztc->_state == _Z_TRANSPORT_STATE_CLOSED) {
+        return _z_fut_fn_result_ready();
+    } else if (ztc->_state == _Z_TRANSPORT_STATE_RECONNECTING) {
+        return _z_fut_fn_result_suspend();
+    }
+    // What was batched since the previous period is sent now, which bounds the wait of a message to the delay
+    if (_z_transport_tx_auto_batch_flush(ztc) != _Z_RES_OK) {
+        _Z_INFO("Send automatic batch failed.");
+    }
+    return _z_fut_fn_result_wake_up_after(_z_auto_batching_period_ms(&ztc->_auto_batching));
+}
+#endif
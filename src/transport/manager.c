@@ -200,12 +200,21 @@ static z_result_t _z_new_transport_peer(_z_transport_t *zt, const _z_string_t *l
 z_result_t _z_new_transport(_z_transport_t *zt, const _z_id_t *bs, const _z_string_t *locator, z_whatami_t mode,
                             int peer_op, const _z_config_t *session_cfg, _z_runtime_t *runtime) {
     z_result_t ret;
+#if Z_FEATURE_AUTO_BATCHING == 1
+    _z_auto_batching_t auto_batching;
+    _Z_RETURN_IF_ERR(_z_auto_batching_from_config(&auto_batching, session_cfg));
+#endif
 
     if (mode == Z_WHATAMI_CLIENT) {
         ret = _z_new_transport_client(zt, locator, bs, session_cfg);
     } else {
         ret = _z_new_transport_peer(zt, locator, bs, peer_op, session_cfg, runtime);
     }
+#if Z_FEATURE_AUTO_BATCHING == 1
+    if ((ret == _Z_RES_OK) && (zt->_type != _Z_TRANSPORT_RAWETH_TYPE)) {
+        _z_transport_get_common(zt)->_auto_batching = auto_batching;
+    }
+#endif
 
     return ret;
 }
@@ -35,7 +35,20 @@ z_result_t _zp_multicast_send_join(_z_transport_multicast_t *ztm) {
     next_sn._val._plain._reliable = ztm->_common._sn_tx_reliable;
 
     _z_id_t zid = _z_transport_common_get_session(&ztm->_common)->_local_zid;
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    bool repair = _z_multicast_repair_is_active(&ztm->_common._repair);
+    if (repair) {
+        // The SN following the last reliable message sent, and not a batch still waiting, lets receivers spot the loss
+        next_sn._val._plain._reliable = ztm->_common._repair._next_sn;
+    }
+#endif
     _z_transport_message_t jsm = _z_t_msg_make_join(Z_WHATAMI_PEER, Z_TRANSPORT_LEASE, zid, next_sn);
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    if (repair) {
+        jsm._body._join._repair = true;
+        _Z_SET_FLAG(jsm._header, _Z_FLAG_T_Z);
+    }
+#endif
 
     return ztm->_send_f(&ztm->_common, &jsm);
 }
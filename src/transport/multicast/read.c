@@ -17,9 +17,11 @@
 #include <stddef.h>
 
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/net/session.h"
 #include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/protocol/iobuf.h"
 #include "zenoh-pico/runtime/runtime.h"
+#include "zenoh-pico/session/subscription.h"
 #include "zenoh-pico/transport/common/rx.h"
 #include "zenoh-pico/transport/multicast/lease.h"
 #include "zenoh-pico/transport/multicast/rx.h"
@@ -57,6 +59,8 @@ static z_result_t _zp_multicast_process_messages(_z_transport_multicast_t *ztm)
     }
     // Move the read position of the read buffer
     _z_zbuf_set_rpos(&ztm->_common._zbuf, _z_zbuf_get_rpos(&ztm->_common._zbuf) + to_read);
+    // Batched subscribers get the samples of the batch at once, before its buffer is reused
+    _z_flush_subscription_batches(_z_transport_common_get_session(&ztm->_common));
     return ret;
 }
 
@@ -78,6 +82,8 @@ _z_fut_fn_result_t _zp_multicast_read_task_fn(void *ztm_arg, _z_executor_t *exec
     } else if (ztm->_common._state == _Z_TRANSPORT_STATE_RECONNECTING) {
         return _z_fut_fn_result_suspend();
     }
+    // Samples queued by the other threads are delivered while idle
+    _z_flush_subscription_batches(_z_transport_common_get_session(&ztm->_common));
     z_result_t ret = _zp_multicast_process_messages(ztm);
     if (ret == _Z_NO_DATA_PROCESSED) {
 #if Z_RUNTIME_IDLE_READ_TASK_SLEEP > 0
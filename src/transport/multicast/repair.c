@@ -0,0 +1,393 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/transport/multicast/repair.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/protocol/codec/core.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/system/common/platform.h"
+#include "zenoh-pico/transport/utils.h"
+#include "zenoh-pico/utils/logging.h"
+
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+
+// Datagrams kept at most, the smallest reliable ones are a few tens of bytes
+#define _Z_MULTICAST_REPAIR_SLOTS ((Z_MULTICAST_REPAIR_BUF_SIZE / 128) + 1)
+// Header byte and largest SN of a frame or fragment
+#define _Z_MULTICAST_REPAIR_HEAD_SIZE (1 + 10)
+// Slices of a batch kept at once, as many as a link sends with a single scatter/gather write
+#define _Z_MULTICAST_REPAIR_IOV_MAX 16
+
+/*------------------ Sender ------------------*/
+z_result_t _z_multicast_repair_init(_z_multicast_repair_t *repair, _z_zint_t next_sn) {
+    *repair = _z_multicast_repair_null();
+    repair->_buf = (uint8_t *)z_malloc(Z_MULTICAST_REPAIR_BUF_SIZE);
+    repair->_records =
+        (_z_multicast_repair_record_t *)z_malloc(_Z_MULTICAST_REPAIR_SLOTS * sizeof(_z_multicast_repair_record_t));
+    if ((repair->_buf == NULL) || (repair->_records == NULL)) {
+        _z_multicast_repair_clear(repair);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    repair->_next_sn = next_sn;
+    return _Z_RES_OK;
+}
+
+void _z_multicast_repair_clear(_z_multicast_repair_t *repair) {
+    z_free(repair->_buf);
+    z_free(repair->_records);
+    *repair = _z_multicast_repair_null();
+}
+
+static inline _z_multicast_repair_record_t *_z_multicast_repair_record(_z_multicast_repair_t *repair, size_t i) {
+    return &repair->_records[(repair->_first + i) % _Z_MULTICAST_REPAIR_SLOTS];
+}
+
+static void _z_multicast_repair_drop_oldest(_z_multicast_repair_t *repair) {
+    repair->_first = (repair->_first + 1) % _Z_MULTICAST_REPAIR_SLOTS;
+    repair->_len--;
+}
+
+static void _z_multicast_repair_store(_z_transport_common_t *ztc, const _z_socket_iovec_t *iov, size_t iov_len) {
+    _z_multicast_repair_t *repair = &ztc->_repair;
+    uint8_t head[_Z_MULTICAST_REPAIR_HEAD_SIZE];
+    size_t head_len = 0;
+    size_t size = 0;
+    for (size_t i = 0; i < iov_len; i++) {
+        size_t n = _Z_MULTICAST_REPAIR_HEAD_SIZE - head_len;
+        n = (iov[i]._len < n) ? iov[i]._len : n;
+        memcpy(&head[head_len], iov[i]._buf, n);
+        head_len += n;
+        size += iov[i]._len;
+    }
+    // Only the reliable frames and fragments are retransmitted
+    if (head_len == 0) {
+        return;
+    }
+    uint8_t mid = _Z_MID(head[0]);
+    if (((mid != _Z_MID_T_FRAME) && (mid != _Z_MID_T_FRAGMENT)) || !_Z_HAS_FLAG(head[0], _Z_FLAG_T_FRAME_R)) {
+        return;
+    }
+    _z_slice_t sn_bytes = _z_slice_alias_buf(&head[1], head_len - 1);
+    _z_zbuf_t zbf = _z_slice_as_zbuf(&sn_bytes);
+    _z_zint_t sn = 0;
+    if (_z_zsize_decode(&sn, &zbf) != _Z_RES_OK) {
+        return;
+    }
+    repair->_next_sn = _z_sn_increment(ztc->_sn_res, sn);
+    if (size > Z_MULTICAST_REPAIR_BUF_SIZE) {
+        // Receivers missing it learn that the datagrams before are lost too
+        repair->_len = 0;
+        repair->_wpos = 0;
+        return;
+    }
+    // Datagrams are stored in one piece, the oldest ones make room
+    size_t offset = repair->_wpos;
+    bool wrapped = (offset + size) > Z_MULTICAST_REPAIR_BUF_SIZE;
+    if (wrapped) {
+        offset = 0;
+    }
+    while (repair->_len > 0) {
+        _z_multicast_repair_record_t *oldest = _z_multicast_repair_record(repair, 0);
+        bool overlaps = (oldest->_offset < (offset + size)) && (offset < (oldest->_offset + oldest->_len));
+        // The datagrams left at the end of the buffer are older than the ones overwritten at its start
+        bool left_behind = wrapped && (oldest->_offset >= repair->_wpos);
+        if (!overlaps && !left_behind && (repair->_len < _Z_MULTICAST_REPAIR_SLOTS)) {
+            break;
+        }
+        _z_multicast_repair_drop_oldest(repair);
+    }
+    size_t pos = offset;
+    for (size_t i = 0; i < iov_len; i++) {
+        memcpy(&repair->_buf[pos], iov[i]._buf, iov[i]._len);
+        pos += iov[i]._len;
+    }
+    _z_multicast_repair_record_t *record = _z_multicast_repair_record(repair, repair->_len);
+    *record = (_z_multicast_repair_record_t){._sn = sn, ._offset = offset, ._len = size, ._resent = false};
+    repair->_len++;
+    repair->_wpos = pos;
+}
+
+void _z_multicast_repair_store_wbuf(_z_transport_common_t *ztc, const _z_wbuf_t *wbf) {
+    if (!_z_multicast_repair_is_active(&ztc->_repair)) {
+        return;
+    }
+    _z_socket_iovec_t iov[_Z_MULTICAST_REPAIR_IOV_MAX];
+    size_t iosli_num = _z_wbuf_len_iosli(wbf);
+    if (iosli_num > _ZP_ARRAY_SIZE(iov)) {
+        _Z_INFO("Reliable datagram not kept for retransmission, it has too many slices");
+        return;
+    }
+    for (size_t i = 0; i < iosli_num; i++) {
+        _z_slice_t bs = _z_iosli_to_bytes(_z_wbuf_get_iosli(wbf, i));
+        iov[i] = (_z_socket_iovec_t){._buf = bs.start, ._len = bs.len};
+    }
+    _z_multicast_repair_store(ztc, iov, iosli_num);
+}
+
+void _z_multicast_repair_store_msgs(_z_transport_common_t *ztc, const _z_socket_msg_t *msgs, size_t count) {
+    if (!_z_multicast_repair_is_active(&ztc->_repair)) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        _z_multicast_repair_store(ztc, msgs[i]._iov, msgs[i]._iov_len);
+    }
+}
+
+// Send again the datagrams held from the given SN on, and tell the receivers which SNs can still be repaired
+static z_result_t _z_multicast_repair_handle_nack(_z_transport_multicast_t *ztm, const _z_t_msg_oam_nack_t *nack) {
+    _z_transport_common_t *ztc = &ztm->_common;
+    _z_multicast_repair_t *repair = &ztc->_repair;
+    if (!_z_multicast_repair_is_active(repair)) {
+        return _Z_RES_OK;
+    }
+    _Z_RETURN_IF_ERR(_z_transport_tx_mutex_lock(ztc, true));
+    repair->_stats._nacks++;
+    _z_zint_t first_sn = (repair->_len > 0) ? _z_multicast_repair_record(repair, 0)->_sn : repair->_next_sn;
+    if (_z_sn_precedes(ztc->_sn_res, nack->_sn, first_sn)) {
+        repair->_stats._unrecoverable += (size_t)((first_sn - nack->_sn) & ztc->_sn_res);
+    }
+    z_clock_t now = z_clock_now();
+    for (size_t i = 0; i < repair->_len; i++) {
+        _z_multicast_repair_record_t *record = _z_multicast_repair_record(repair, i);
+        if (_z_sn_precedes(ztc->_sn_res, record->_sn, nack->_sn)) {
+            continue;
+        }
+        // Another receiver asked for it just before
+        if (record->_resent && (zp_clock_elapsed_ms_since(&now, &record->_resent_at) < Z_MULTICAST_NACK_DELAY)) {
+            continue;
+        }
+        _z_socket_iovec_t iov = {._buf = &repair->_buf[record->_offset], ._len = record->_len};
+        _z_socket_msg_t msg = {._iov = &iov, ._iov_len = 1};
+        if (_z_link_send_msgs(ztc->_link, &msg, 1, NULL) != _Z_RES_OK) {
+            _Z_INFO("Failed to retransmit a reliable datagram");
+            break;
+        }
+        record->_resent = true;
+        record->_resent_at = now;
+        repair->_stats._retransmitted++;
+    }
+    _z_transport_message_t t_msg = _z_t_msg_make_acknack(first_sn, repair->_next_sn);
+    _z_transport_tx_mutex_unlock(ztc);
+    return ztm->_send_f(ztc, &t_msg);
+}
+
+/*------------------ Receiver ------------------*/
+// Next NACK after the given delay, plus up to the NACK delay so that the receivers of a lost message do not all send
+static void _z_multicast_repair_schedule(_z_multicast_peer_repair_t *repair, unsigned long delay_ms) {
+    repair->_nack_at = z_clock_now();
+    z_clock_advance_ms(&repair->_nack_at, delay_ms + (z_random_u32() % (Z_MULTICAST_NACK_DELAY + 1)));
+}
+
+static void _z_multicast_repair_open_gap(_z_transport_peer_multicast_t *entry, _z_zint_t gap_last) {
+    _z_multicast_peer_repair_t *repair = &entry->_repair;
+    if (!repair->_gap) {
+        repair->_gap = true;
+        repair->_gap_last = gap_last;
+        repair->_attempts = 0;
+        repair->_stats._gaps++;
+        _z_multicast_repair_schedule(repair, 0);
+    } else if (_z_sn_precedes(entry->_sn_res, repair->_gap_last, gap_last)) {
+        repair->_gap_last = gap_last;
+    }
+}
+
+// Give up on the reliable messages up to the given SN, and on the message they were part of
+static void _z_multicast_repair_skip(_z_transport_multicast_t *ztm, _z_transport_peer_multicast_t *entry,
+                                     _z_zint_t sn) {
+    _z_zint_t *last = &entry->_sn_rx_sns._val._plain._reliable;
+    if (!_z_sn_precedes(entry->_sn_res, *last, sn)) {
+        return;
+    }
+    entry->_repair._stats._lost += (size_t)((sn - *last) & entry->_sn_res);
+    *last = sn;
+    if (!_z_sn_precedes(entry->_sn_res, *last, entry->_repair._gap_last)) {
+        entry->_repair._gap = false;
+    }
+#if Z_FEATURE_FRAGMENTATION == 1
+    if (_z_defrag_buf_len(&entry->common._dbuf_reliable) > 0) {
+        _z_defrag_pool_count_sn_gap(&ztm->_common._defrag_pool);
+    }
+    _z_defrag_buf_clear(&entry->common._dbuf_reliable);
+    entry->common._state_reliable = _Z_DBUF_STATE_NULL;
+#else
+    _ZP_UNUSED(ztm);
+#endif
+}
+
+bool _z_multicast_repair_accept(_z_transport_peer_multicast_t *entry, _z_zint_t sn) {
+    _z_multicast_peer_repair_t *repair = &entry->_repair;
+    _z_zint_t *last = &entry->_sn_rx_sns._val._plain._reliable;
+    if (_z_sn_consecutive(entry->_sn_res, *last, sn)) {
+        *last = sn;
+        if (repair->_gap) {
+            repair->_stats._repaired++;
+            if (!_z_sn_precedes(entry->_sn_res, sn, repair->_gap_last)) {
+                repair->_gap = false;
+            } else {
+                // The retransmission is under way, NACK again only if it stops
+                repair->_attempts = 0;
+                _z_multicast_repair_schedule(repair, 2 * Z_MULTICAST_NACK_DELAY);
+            }
+        }
+        return true;
+    }
+    if (_z_sn_precedes(entry->_sn_res, *last, sn)) {
+        _z_multicast_repair_open_gap(entry, sn);
+        repair->_stats._out_of_order++;
+        _Z_DEBUG("Reliable message dropped until the previous ones are retransmitted");
+    }
+    return false;
+}
+
+void _z_multicast_repair_handle_join(_z_transport_peer_multicast_t *entry, const _z_t_msg_join_t *msg) {
+    _z_zint_t last = entry->_sn_rx_sns._val._plain._reliable;
+    _z_conduit_sn_list_copy(&entry->_sn_rx_sns, &msg->_next_sn);
+    _z_conduit_sn_list_decrement(entry->_sn_res, &entry->_sn_rx_sns);
+    // Peers not retransmitting, and restarted ones, start over from their JOIN
+    if (!msg->_repair || !_z_id_eq(&entry->common._remote_zid, &msg->_zid)) {
+        entry->_repair = _z_multicast_peer_repair_null();
+        entry->_repair._active = msg->_repair;
+        return;
+    }
+    entry->_repair._active = true;
+    // A JOIN sent before the last messages arrives after them, and one ahead tells that the last messages were lost
+    _z_zint_t join_last = entry->_sn_rx_sns._val._plain._reliable;
+    entry->_sn_rx_sns._val._plain._reliable = last;
+    if (_z_sn_precedes(entry->_sn_res, last, join_last)) {
+        _z_multicast_repair_open_gap(entry, join_last);
+    }
+}
+
+static _z_transport_peer_multicast_t *_z_multicast_repair_find_peer(_z_transport_multicast_t *ztm,
+                                                                    const _z_id_t *zid) {
+    for (_z_transport_peer_multicast_slist_t *it = ztm->_peers; it != NULL;
+         it = _z_transport_peer_multicast_slist_next(it)) {
+        _z_transport_peer_multicast_t *peer = _z_transport_peer_multicast_slist_value(it);
+        if (_z_id_eq(&peer->common._remote_zid, zid)) {
+            return peer;
+        }
+    }
+    return NULL;
+}
+
+// Put off a NACK, the peer is already retransmitting what it asks for
+static void _z_multicast_repair_suppress(_z_multicast_peer_repair_t *repair) {
+    repair->_stats._nacks_suppressed++;
+    _z_multicast_repair_schedule(repair, 2 * Z_MULTICAST_NACK_DELAY);
+}
+
+static void _z_multicast_repair_handle_acknack(_z_transport_multicast_t *ztm, const _z_t_msg_oam_acknack_t *acknack,
+                                               _z_transport_peer_multicast_t *entry) {
+    if ((entry == NULL) || !entry->_repair._active || !entry->_repair._gap) {
+        return;
+    }
+    _z_multicast_peer_repair_t *repair = &entry->_repair;
+    // The messages before the first one held by the peer are lost
+    _z_multicast_repair_skip(ztm, entry, _z_sn_decrement(entry->_sn_res, acknack->_first_sn));
+    // The ones after the last it sent, announced by a JOIN, are still on their way
+    _z_zint_t sent_last = _z_sn_decrement(entry->_sn_res, acknack->_next_sn);
+    if (_z_sn_precedes(entry->_sn_res, sent_last, repair->_gap_last)) {
+        repair->_gap_last = sent_last;
+    }
+    if (!_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, repair->_gap_last)) {
+        repair->_gap = false;
+    }
+    if (repair->_gap) {
+        _z_multicast_repair_suppress(repair);
+    }
+}
+
+z_result_t _z_multicast_repair_handle_oam(_z_transport_multicast_t *ztm, const _z_t_msg_oam_t *msg,
+                                          _z_transport_peer_multicast_t *entry) {
+    switch (msg->_id) {
+        case _Z_T_OAM_ID_NACK: {
+            const _z_t_msg_oam_nack_t *nack = &msg->_body._nack;
+            _z_id_t local_zid = _z_transport_common_get_session(&ztm->_common)->_local_zid;
+            if (_z_id_eq(&nack->_zid, &local_zid)) {
+                return _z_multicast_repair_handle_nack(ztm, nack);
+            }
+            // Another receiver asks for the messages this one is missing
+            _z_transport_peer_multicast_t *peer = _z_multicast_repair_find_peer(ztm, &nack->_zid);
+            if ((peer != NULL) && peer->_repair._active && peer->_repair._gap &&
+                !_z_sn_precedes(peer->_sn_res, _z_sn_increment(peer->_sn_res, peer->_sn_rx_sns._val._plain._reliable),
+                                nack->_sn)) {
+                _z_multicast_repair_suppress(&peer->_repair);
+            }
+            break;
+        }
+        case _Z_T_OAM_ID_ACKNACK:
+            _z_multicast_repair_handle_acknack(ztm, &msg->_body._acknack, entry);
+            break;
+        default:
+            break;
+    }
+    return _Z_RES_OK;
+}
+
+// Send the NACK of a peer when it is due, returns in how long the next one is
+static unsigned long _z_multicast_repair_nack_peer(_z_transport_multicast_t *ztm, _z_transport_peer_multicast_t *peer,
+                                                   z_clock_t *now) {
+    _z_multicast_peer_repair_t *repair = &peer->_repair;
+    unsigned long wait_ms = zp_clock_elapsed_ms_since(&repair->_nack_at, now);
+    if (wait_ms > 0) {
+        return wait_ms;
+    }
+    if (repair->_attempts >= Z_MULTICAST_NACK_RETRIES) {
+        _Z_INFO("Reliable messages skipped as the peer did not retransmit them");
+        _z_multicast_repair_skip(ztm, peer, repair->_gap_last);
+        return Z_MULTICAST_NACK_DELAY;
+    }
+    _z_zint_t sn = _z_sn_increment(peer->_sn_res, peer->_sn_rx_sns._val._plain._reliable);
+    _z_transport_message_t t_msg = _z_t_msg_make_nack(peer->common._remote_zid, sn);
+    if (ztm->_send_f(&ztm->_common, &t_msg) != _Z_RES_OK) {
+        _Z_INFO("Failed to send a NACK");
+    }
+    repair->_stats._nacks_sent++;
+    unsigned long backoff_ms = (2 * Z_MULTICAST_NACK_DELAY) << repair->_attempts;
+    repair->_attempts++;
+    _z_multicast_repair_schedule(repair, backoff_ms);
+    return backoff_ms;
+}
+
+_z_fut_fn_result_t _zp_multicast_repair_task_fn(void *ztm_arg, _z_executor_t *executor) {
+    _ZP_UNUSED(executor);
+    _z_transport_multicast_t *ztm = (_z_transport_multicast_t *)ztm_arg;
+
+    if (ztm->_common._state == _Z_TRANSPORT_STATE_CLOSED) {
+        return _z_fut_fn_result_ready();
+    } else if (ztm->_common._state == _Z_TRANSPORT_STATE_RECONNECTING) {
+        return _z_fut_fn_result_suspend();
+    }
+
+    unsigned long wake_up_ms = Z_MULTICAST_NACK_DELAY;
+    _z_transport_peer_mutex_lock(&ztm->_common);
+    z_clock_t now = z_clock_now();
+    for (_z_transport_peer_multicast_slist_t *it = ztm->_peers; it != NULL;
+         it = _z_transport_peer_multicast_slist_next(it)) {
+        _z_transport_peer_multicast_t *peer = _z_transport_peer_multicast_slist_value(it);
+        if (peer->_repair._active && peer->_repair._gap) {
+            unsigned long wait_ms = _z_multicast_repair_nack_peer(ztm, peer, &now);
+            wake_up_ms = (wait_ms < wake_up_ms) ? wait_ms : wake_up_ms;
+        }
+    }
+    _z_transport_peer_mutex_unlock(&ztm->_common);
+    return _z_fut_fn_result_wake_up_after(wake_up_ms);
+}
+
+#endif  // Z_FEATURE_MULTICAST_RELIABILITY == 1
@@ -27,8 +27,10 @@
 #include "zenoh-pico/protocol/definitions/network.h"
 #include "zenoh-pico/protocol/definitions/transport.h"
 #include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/session/subscription.h"
 #include "zenoh-pico/session/utils.h"
 #include "zenoh-pico/system/common/platform.h"
+#include "zenoh-pico/transport/multicast/repair.h"
 #include "zenoh-pico/transport/multicast/rx.h"
 #include "zenoh-pico/transport/multicast/transport.h"
 #include "zenoh-pico/transport/utils.h"
@@ -176,6 +178,27 @@ static _z_transport_peer_multicast_t *_z_find_peer_entry(_z_transport_peer_multi
     return ret;
 }
 
+/**
+ * Check the SN of a reliable message, and update the one of the peer if the message is delivered. The reliable messages
+ * of a peer that retransmits them are delivered in order, only monotonic SNs are ensured for the others.
+ */
+static bool _z_multicast_check_reliable_sn(_z_transport_peer_multicast_t *entry, _z_zint_t sn, bool *consecutive) {
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    if (entry->_repair._active) {
+        *consecutive = true;
+        return _z_multicast_repair_accept(entry, sn);
+    }
+#endif
+    if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, sn)) {
+        *consecutive = _z_sn_consecutive(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, sn);
+        entry->_sn_rx_sns._val._plain._reliable = sn;
+        return true;
+    }
+    // Retransmitted for another peer or duplicated, the message being defragmented is left alone
+    _Z_DEBUG("Reliable message dropped because it was already received");
+    return false;
+}
+
 static z_result_t _z_multicast_handle_frame(_z_transport_multicast_t *ztm, uint8_t header, _z_t_msg_frame_t *msg,
                                             _z_transport_peer_multicast_t *entry) {
     // Check peer
@@ -190,16 +213,8 @@ static z_result_t _z_multicast_handle_frame(_z_transport_multicast_t *ztm, uint8
     // Check if the SN is correct
     if (_Z_HAS_FLAG(header, _Z_FLAG_T_FRAME_R)) {
         tmsg_reliability = Z_RELIABILITY_RELIABLE;
-        // @TODO: amend once reliability is in place. For the time being only
-        //        monotonic SNs are ensured
-        if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, msg->_sn)) {
-            entry->_sn_rx_sns._val._plain._reliable = msg->_sn;
-        } else {
-#if Z_FEATURE_FRAGMENTATION == 1
-            entry->common._state_reliable = _Z_DBUF_STATE_NULL;
-            _z_wbuf_clear(&entry->common._dbuf_reliable);
-#endif
-            _Z_INFO("Reliable message dropped because it is out of order");
+        bool consecutive;
+        if (!_z_multicast_check_reliable_sn(entry, msg->_sn, &consecutive)) {
             return _Z_RES_OK;
         }
     } else {
@@ -209,7 +224,10 @@ static z_result_t _z_multicast_handle_frame(_z_transport_multicast_t *ztm, uint8
         } else {
 #if Z_FEATURE_FRAGMENTATION == 1
             entry->common._state_best_effort = _Z_DBUF_STATE_NULL;
-            _z_wbuf_clear(&entry->common._dbuf_best_effort);
+            if (_z_defrag_buf_len(&entry->common._dbuf_best_effort) > 0) {
+                _z_defrag_pool_count_sn_gap(&ztm->_common._defrag_pool);
+            }
+            _z_defrag_buf_clear(&entry->common._dbuf_best_effort);
 #endif
             _Z_INFO("Best effort message dropped because it is out of order");
             return _Z_RES_OK;
@@ -239,7 +257,7 @@ static z_result_t _z_multicast_handle_fragment_inner(_z_transport_multicast_t *z
     // Note that we receive data from the peer
     entry->common._received = true;
 
-    _z_wbuf_t *dbuf;
+    _z_defrag_buf_t *dbuf;
     uint8_t *dbuf_state;
     z_reliability_t tmsg_reliability;
     bool consecutive;
@@ -248,19 +266,11 @@ static z_result_t _z_multicast_handle_fragment_inner(_z_transport_multicast_t *z
     if (_Z_HAS_FLAG(header, _Z_FLAG_T_FRAME_R)) {
         tmsg_reliability = Z_RELIABILITY_RELIABLE;
         // Check SN
-        // @TODO: amend once reliability is in place. For the time being only
-        //        monotonic SNs are ensured
-        if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, msg->_sn)) {
-            consecutive = _z_sn_consecutive(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, msg->_sn);
-            entry->_sn_rx_sns._val._plain._reliable = msg->_sn;
-            dbuf = &entry->common._dbuf_reliable;
-            dbuf_state = &entry->common._state_reliable;
-        } else {
-            _z_wbuf_clear(&entry->common._dbuf_reliable);
-            entry->common._state_reliable = _Z_DBUF_STATE_NULL;
-            _Z_INFO("Reliable message dropped because it is out of order");
+        if (!_z_multicast_check_reliable_sn(entry, msg->_sn, &consecutive)) {
             return _Z_RES_OK;
         }
+        dbuf = &entry->common._dbuf_reliable;
+        dbuf_state = &entry->common._state_reliable;
     } else {
         tmsg_reliability = Z_RELIABILITY_BEST_EFFORT;
         // Check SN
@@ -270,14 +280,18 @@ static z_result_t _z_multicast_handle_fragment_inner(_z_transport_multicast_t *z
             dbuf = &entry->common._dbuf_best_effort;
             dbuf_state = &entry->common._state_best_effort;
         } else {
-            _z_wbuf_clear(&entry->common._dbuf_best_effort);
+            if (_z_defrag_buf_len(&entry->common._dbuf_best_effort) > 0) {
+                _z_defrag_pool_count_sn_gap(&ztm->_common._defrag_pool);
+            }
+            _z_defrag_buf_clear(&entry->common._dbuf_best_effort);
             entry->common._state_best_effort = _Z_DBUF_STATE_NULL;
             _Z_INFO("Best effort message dropped because it is out of order");
             return _Z_RES_OK;
         }
     }
-    if (!consecutive && (_z_wbuf_len(dbuf) > 0)) {
-        _z_wbuf_clear(dbuf);
+    if (!consecutive && (_z_defrag_buf_len(dbuf) > 0)) {
+        _z_defrag_pool_count_sn_gap(&ztm->_common._defrag_pool);
+        _z_defrag_buf_clear(dbuf);
         *dbuf_state = _Z_DBUF_STATE_NULL;
         _Z_INFO("Defragmentation buffer dropped because non-consecutive fragments received");
         return _Z_RES_OK;
@@ -285,33 +299,31 @@ static z_result_t _z_multicast_handle_fragment_inner(_z_transport_multicast_t *z
     // Handle fragment markers
     if (_Z_PATCH_HAS_FRAGMENT_MARKERS(entry->common._patch)) {
         if (msg->first) {
-            _z_wbuf_reset(dbuf);
-        } else if (_z_wbuf_len(dbuf) == 0) {
+            _z_defrag_buf_reset(dbuf);
+        } else if (_z_defrag_buf_len(dbuf) == 0) {
             _Z_INFO("First fragment received without the first marker");
             return _Z_RES_OK;
         }
         if (msg->drop) {
-            _z_wbuf_reset(dbuf);
+            _z_defrag_buf_reset(dbuf);
             return _Z_RES_OK;
         }
     }
-    // Allocate buffer if needed
+    // Start a new message, its buffer is taken from the pool on the first write
     if (*dbuf_state == _Z_DBUF_STATE_NULL) {
-        if (_z_wbuf_init(dbuf, Z_FRAG_MAX_SIZE, false) != _Z_RES_OK) {
-            _Z_ERROR("Not enough memory to allocate peer defragmentation buffer");
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
         *dbuf_state = _Z_DBUF_STATE_INIT;
     }
     // Process fragment data
     if (*dbuf_state == _Z_DBUF_STATE_INIT) {
         const _z_slice_t *payload = _z_slice_view_deref(&msg->_payload);
         // Check overflow
-        if ((_z_wbuf_len(dbuf) + payload->len) > Z_FRAG_MAX_SIZE) {
+        if ((_z_defrag_buf_len(dbuf) + payload->len) > Z_FRAG_MAX_SIZE) {
+            *dbuf_state = _Z_DBUF_STATE_OVERFLOW;
+        } else if (_z_defrag_buf_write(dbuf, &ztm->_common._defrag_pool, payload->start, payload->len) != _Z_RES_OK) {
+            // Release what was reassembled so far for the other messages
+            _Z_INFO("Fragment dropped because the defragmentation budget is exhausted");
+            _z_defrag_buf_clear(dbuf);
             *dbuf_state = _Z_DBUF_STATE_OVERFLOW;
-        } else {
-            // Fill buffer
-            _z_wbuf_write_bytes(dbuf, payload->start, 0, payload->len);
         }
     }
     // Process final fragment
@@ -319,18 +331,14 @@ static z_result_t _z_multicast_handle_fragment_inner(_z_transport_multicast_t *z
         // Drop message if it exceeds the fragmentation size
         if (*dbuf_state == _Z_DBUF_STATE_OVERFLOW) {
             _Z_INFO("Fragment dropped because defragmentation buffer has overflown");
-            _z_wbuf_clear(dbuf);
+            _z_defrag_buf_clear(dbuf);
             *dbuf_state = _Z_DBUF_STATE_NULL;
             return _Z_RES_OK;
         }
-        // Convert the defragmentation buffer into a decoding buffer
-        _z_zbuf_t zbf = _z_wbuf_moved_as_zbuf(dbuf);
-        if (_z_zbuf_capacity(&zbf) == 0) {
-            _Z_ERROR("Failed to convert defragmentation buffer into a decoding buffer!");
-            _z_wbuf_clear(dbuf);
-            *dbuf_state = _Z_DBUF_STATE_NULL;
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
+        // Take the message out of the peer, it is decoded in place
+        _z_defrag_buf_t msg_buf = *dbuf;
+        *dbuf = _z_defrag_buf_null();
+        _z_zbuf_t zbf = _z_defrag_buf_as_zbuf(&msg_buf);
         // Decode message
         _z_zenoh_message_t zm = {0};
         ret = _z_network_message_decode(&zm, &zbf);
@@ -343,8 +351,9 @@ static z_result_t _z_multicast_handle_fragment_inner(_z_transport_multicast_t *z
             _Z_ERROR_LOG(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
             ret = _Z_ERR_MESSAGE_DESERIALIZATION_FAILED;
         }
-        // Free the decoding buffer
-        _z_zbuf_clear(&zbf);
+        // Batched subscribers get the samples before the buffer they borrow from goes back to the pool
+        _z_flush_subscription_batches(_z_transport_common_get_session(&ztm->_common));
+        _z_defrag_buf_clear(&msg_buf);
         *dbuf_state = _Z_DBUF_STATE_NULL;
     }
 #else
@@ -398,12 +407,16 @@ static z_result_t _z_multicast_handle_join_inner(_z_transport_multicast_t *ztm,
             (void)_z_multicast_remote_addr_to_endpoint(ztm, addr, &entry->common._link_dst);
         }
 #endif
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+        entry->_repair = _z_multicast_peer_repair_null();
+        entry->_repair._active = msg->_repair;
+#endif
 #if Z_FEATURE_FRAGMENTATION == 1
         entry->common._patch = msg->_patch < _Z_CURRENT_PATCH ? msg->_patch : _Z_CURRENT_PATCH;
         entry->common._state_reliable = _Z_DBUF_STATE_NULL;
         entry->common._state_best_effort = _Z_DBUF_STATE_NULL;
-        entry->common._dbuf_reliable = _z_wbuf_null();
-        entry->common._dbuf_best_effort = _z_wbuf_null();
+        entry->common._dbuf_reliable = _z_defrag_buf_null();
+        entry->common._dbuf_best_effort = _z_defrag_buf_null();
 #endif
 #if Z_FEATURE_CONNECTIVITY == 1
         _z_connectivity_peer_event_data_t connected_peer = {0};
@@ -445,8 +458,12 @@ static z_result_t _z_multicast_handle_join_inner(_z_transport_multicast_t *ztm,
             return _Z_RES_OK;
         }
         // Update SNs
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+        _z_multicast_repair_handle_join(entry, msg);
+#else
         _z_conduit_sn_list_copy(&entry->_sn_rx_sns, &msg->_next_sn);
         _z_conduit_sn_list_decrement(entry->_sn_res, &entry->_sn_rx_sns);
+#endif
         // Update lease time (set as ms during)
         entry->_lease = msg->_lease;
     }
@@ -485,6 +502,14 @@ z_result_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm,
             break;
         }
 
+        case _Z_MID_T_OAM: {
+            _Z_DEBUG("Received _Z_OAM message");
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+            ret = _z_multicast_repair_handle_oam(ztm, &t_msg->_body._oam, entry);
+#endif
+            break;
+        }
+
         case _Z_MID_T_INIT: {
             // Do nothing, multicast transports are not expected to handle INIT messages
             break;
@@ -21,6 +21,7 @@
 
 #include "zenoh-pico/link/link.h"
 #include "zenoh-pico/transport/common/tx.h"
+#include "zenoh-pico/transport/multicast/repair.h"
 #include "zenoh-pico/transport/multicast/transport.h"
 #include "zenoh-pico/transport/raweth/tx.h"
 #include "zenoh-pico/transport/utils.h"
@@ -57,19 +58,20 @@ z_result_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
     ztm->_common._batch_state = _Z_BATCHING_IDLE;
     ztm->_common._batch_count = 0;
 #endif
+#if Z_FEATURE_AUTO_BATCHING == 1
+    ztm->_common._auto_batching = _z_auto_batching_null();
+#endif
 
 #if Z_FEATURE_MULTI_THREAD == 1
     // Initialize the mutexes
-    _Z_RETURN_IF_ERR(_z_mutex_init(&ztm->_common._mutex_tx));
-    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_rec_init(&ztm->_common._mutex_peer), _z_mutex_drop(&ztm->_common._mutex_tx));
+    _Z_RETURN_IF_ERR(_z_transport_common_mutex_init(&ztm->_common));
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
     uint16_t mtu = (zl->_mtu < Z_BATCH_MULTICAST_SIZE) ? zl->_mtu : Z_BATCH_MULTICAST_SIZE;
     if ((_z_wbuf_init(&ztm->_common._wbuf, mtu, false) != _Z_RES_OK) ||
         (_z_zbuf_init(&ztm->_common._zbuf, Z_BATCH_MULTICAST_SIZE) != _Z_RES_OK)) {
 #if Z_FEATURE_MULTI_THREAD == 1
-        _z_mutex_drop(&ztm->_common._mutex_tx);
-        _z_mutex_rec_drop(&ztm->_common._mutex_peer);
+        _z_transport_common_mutex_drop(&ztm->_common);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
         _z_wbuf_clear(&ztm->_common._wbuf);
@@ -77,6 +79,18 @@ z_result_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
         _Z_ERROR("Not enough memory to allocate transport buffers!");
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
+#if Z_FEATURE_FRAGMENTATION == 1
+    if (_z_defrag_pool_init(&ztm->_common._defrag_pool) != _Z_RES_OK) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        _z_transport_common_mutex_drop(&ztm->_common);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+        _z_wbuf_clear(&ztm->_common._wbuf);
+        _z_zbuf_clear(&ztm->_common._zbuf);
+        _Z_ERROR("Failed to initialize the defragmentation pool!");
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+#endif
 
     // Set default SN resolution
     ztm->_common._sn_res = _z_sn_max(param->_seq_num_res);
@@ -85,6 +99,14 @@ z_result_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
     ztm->_common._sn_tx_reliable = param->_initial_sn_tx._val._plain._reliable;
     ztm->_common._sn_tx_best_effort = param->_initial_sn_tx._val._plain._best_effort;
 
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    // Raweth has no NACK path, its reliable messages are not kept
+    if ((zt->_type == _Z_TRANSPORT_MULTICAST_TYPE) && (zl->_cap._flow == Z_LINK_CAP_FLOW_DATAGRAM) &&
+        (_z_multicast_repair_init(&ztm->_common._repair, ztm->_common._sn_tx_reliable) != _Z_RES_OK)) {
+        _Z_ERROR("Not enough memory to keep reliable messages, they will not be retransmitted!");
+    }
+#endif
+
     // Initialize peer list
     ztm->_peers = _z_transport_peer_multicast_slist_new();
 
@@ -113,6 +135,7 @@ z_result_t _z_multicast_open_peer(_z_transport_multicast_establish_param_t *para
 
     _z_id_t zid = *local_zid;
     _z_transport_message_t jsm = _z_t_msg_make_join(Z_WHATAMI_PEER, Z_TRANSPORT_LEASE, zid, next_sn);
+    // Whether reliable messages are retransmitted is advertised by the JOINs of the transport, once it keeps them
 
     // Encode and send the message
     _Z_DEBUG("Sending Z_JOIN message");
@@ -12,6 +12,8 @@
 //   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
 //
 
+#include <string.h>
+
 #include "zenoh-pico/link/transport/socket.h"
 #if Z_FEATURE_LINK_TLS == 1
 #include "zenoh-pico/link/transport/tls_stream.h"
@@ -19,6 +21,7 @@
 #include "zenoh-pico/link/endpoint.h"
 #include "zenoh-pico/net/session.h"
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/session/resource.h"
 #include "zenoh-pico/session/session.h"
 #include "zenoh-pico/transport/transport.h"
 #include "zenoh-pico/transport/utils.h"
@@ -55,11 +58,11 @@ void _z_transport_peer_common_clear(_z_transport_peer_common_t *src) {
     _z_string_clear(&src->_link_dst);
 #endif
 #if Z_FEATURE_FRAGMENTATION == 1
-    _z_wbuf_clear(&src->_dbuf_reliable);
-    _z_wbuf_clear(&src->_dbuf_best_effort);
+    _z_defrag_buf_clear(&src->_dbuf_reliable);
+    _z_defrag_buf_clear(&src->_dbuf_best_effort);
 #endif
     src->_remote_zid = _z_id_empty();
-    _z_resource_slist_free(&src->_remote_resources);
+    _z_resource_table_free(&src->_remote_resources);
 }
 void _z_transport_peer_common_copy(_z_transport_peer_common_t *dst, const _z_transport_peer_common_t *src) {
 #if Z_FEATURE_CONNECTIVITY == 1
@@ -73,8 +76,13 @@ void _z_transport_peer_common_copy(_z_transport_peer_common_t *dst, const _z_tra
 #if Z_FEATURE_FRAGMENTATION == 1
     dst->_state_reliable = src->_state_reliable;
     dst->_state_best_effort = src->_state_best_effort;
-    _z_wbuf_copy(&dst->_dbuf_reliable, &src->_dbuf_reliable);
-    _z_wbuf_copy(&dst->_dbuf_best_effort, &src->_dbuf_best_effort);
+    // A message that can't be copied is dropped, as if its buffer had overflown
+    if (_z_defrag_buf_copy(&dst->_dbuf_reliable, &src->_dbuf_reliable) != _Z_RES_OK) {
+        dst->_state_reliable = _Z_DBUF_STATE_OVERFLOW;
+    }
+    if (_z_defrag_buf_copy(&dst->_dbuf_best_effort, &src->_dbuf_best_effort) != _Z_RES_OK) {
+        dst->_state_best_effort = _Z_DBUF_STATE_OVERFLOW;
+    }
     dst->_patch = src->_patch;
 #endif
     dst->_remote_resources = NULL;
@@ -135,6 +143,9 @@ void _z_transport_peer_multicast_copy(_z_transport_peer_multicast_t *dst, const
     dst->_sn_res = src->_sn_res;
     _z_conduit_sn_list_copy(&dst->_sn_rx_sns, &src->_sn_rx_sns);
     dst->_lease = src->_lease;
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    dst->_repair = src->_repair;
+#endif
     _z_slice_copy(&dst->_remote_addr, &src->_remote_addr);
     _z_transport_peer_common_copy(&dst->common, &src->common);
 }
@@ -181,6 +192,108 @@ bool _z_transport_peer_unicast_eq(const _z_transport_peer_unicast_t *left, const
     return _z_transport_peer_common_eq(&left->common, &right->common);
 }
 
+#if Z_FEATURE_PEER_ROUTING == 1
+void _z_peer_route_clear(_z_peer_route_t *route) {
+    z_free((void *)route->_peers);
+    *route = _z_peer_route_null();
+}
+
+static z_result_t _z_peer_route_reserve(_z_peer_route_t *route, size_t capacity) {
+    if (capacity <= route->_capacity) {
+        return _Z_RES_OK;
+    }
+    size_t new_capacity = (route->_capacity == 0) ? 4 : route->_capacity * 2;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+    const _z_transport_peer_common_t **peers = (const _z_transport_peer_common_t **)z_realloc(
+        (void *)route->_peers, new_capacity * sizeof(_z_transport_peer_common_t *));
+    if (peers == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    route->_peers = peers;
+    route->_capacity = new_capacity;
+    return _Z_RES_OK;
+}
+
+// Index of the first listed peer whose address isn't lower than the one of peer
+static size_t _z_peer_route_lower_bound(const _z_peer_route_t *route, const _z_transport_peer_common_t *peer) {
+    size_t lo = 0;
+    size_t hi = route->_len;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((uintptr_t)route->_peers[mid] < (uintptr_t)peer) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+z_result_t _z_peer_route_add(_z_peer_route_t *route, const _z_transport_peer_common_t *peer) {
+    size_t idx = _z_peer_route_lower_bound(route, peer);
+    if ((idx < route->_len) && (route->_peers[idx] == peer)) {
+        return _Z_RES_OK;
+    }
+    _Z_RETURN_IF_ERR(_z_peer_route_reserve(route, route->_len + 1));
+    memmove((void *)&route->_peers[idx + 1], (const void *)&route->_peers[idx],
+            (route->_len - idx) * sizeof(_z_transport_peer_common_t *));
+    route->_peers[idx] = peer;
+    route->_len++;
+    return _Z_RES_OK;
+}
+
+z_result_t _z_peer_route_copy(_z_peer_route_t *dst, const _z_peer_route_t *src) {
+    _Z_RETURN_IF_ERR(_z_peer_route_reserve(dst, src->_len));
+    if (src->_len > 0) {
+        memcpy((void *)dst->_peers, (const void *)src->_peers, src->_len * sizeof(_z_transport_peer_common_t *));
+    }
+    dst->_len = src->_len;
+    dst->_selective = src->_selective;
+    dst->_routers = src->_routers;
+    return _Z_RES_OK;
+}
+
+bool _z_peer_route_merge(_z_peer_route_t *dst, const _z_peer_route_t *src) {
+    // Routes that list the peers only address them, and can't go to more of them
+    if ((dst->_selective && !dst->_routers) || (src->_selective && !src->_routers)) {
+        return false;
+    }
+    if (!src->_selective) {
+        dst->_selective = false;
+        return true;
+    }
+    for (size_t i = 0; dst->_selective && (i < src->_len); i++) {
+        if (_z_peer_route_add(dst, src->_peers[i]) != _Z_RES_OK) {
+            // Out of memory, all the peers get the batch
+            dst->_selective = false;
+        }
+    }
+    return true;
+}
+
+bool _z_peer_route_eq(const _z_peer_route_t *left, const _z_peer_route_t *right) {
+    if (!left->_selective || !right->_selective) {
+        return left->_selective == right->_selective;
+    }
+    if ((left->_routers != right->_routers) || (left->_len != right->_len)) {
+        return false;
+    }
+    return (left->_len == 0) ||
+           (memcmp((const void *)left->_peers, (const void *)right->_peers,
+                   left->_len * sizeof(_z_transport_peer_common_t *)) == 0);
+}
+
+bool _z_peer_route_includes(const _z_peer_route_t *route, const _z_transport_peer_common_t *peer) {
+    if (!route->_selective || (route->_routers && (peer->_remote_whatami == Z_WHATAMI_ROUTER))) {
+        return true;
+    }
+    size_t idx = _z_peer_route_lower_bound(route, peer);
+    return (idx < route->_len) && (route->_peers[idx] == peer);
+}
+#endif
+
 z_result_t _z_transport_peer_unicast_add(_z_transport_unicast_t *ztu, _z_transport_unicast_establish_param_t *param,
                                          _z_sys_net_socket_t socket, bool owns_socket,
                                          _z_transport_peer_unicast_t **output_peer) {
@@ -225,8 +338,18 @@ z_result_t _z_transport_peer_unicast_add(_z_transport_unicast_t *ztu, _z_transpo
     peer->common._patch = param->_patch < _Z_CURRENT_PATCH ? param->_patch : _Z_CURRENT_PATCH;
     peer->common._state_reliable = _Z_DBUF_STATE_NULL;
     peer->common._state_best_effort = _Z_DBUF_STATE_NULL;
-    peer->common._dbuf_reliable = _z_wbuf_null();
-    peer->common._dbuf_best_effort = _z_wbuf_null();
+    peer->common._dbuf_reliable = _z_defrag_buf_null();
+    peer->common._dbuf_best_effort = _z_defrag_buf_null();
+#endif
+#if Z_FEATURE_UNICAST_PEER == 1 && defined(_Z_SOCKET_WAIT_SET_ENABLED)
+    if (_z_socket_wait_set_add(&ztu->_wait_set, &peer->_socket, ztu->_peers) != _Z_RES_OK) {
+        // The socket stays with the caller
+        peer->_owns_socket = false;
+        ztu->_peers = _z_transport_peer_unicast_slist_pop(ztu->_peers);
+        _z_transport_peer_mutex_unlock(&ztu->_common);
+        _Z_ERROR("Failed to register peer socket");
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
 #endif
 #if Z_FEATURE_CONNECTIVITY == 1
     if (ztu->_common._link != NULL) {
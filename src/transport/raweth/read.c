@@ -17,9 +17,11 @@
 #include <stddef.h>
 
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/net/session.h"
 #include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/protocol/iobuf.h"
 #include "zenoh-pico/runtime/runtime.h"
+#include "zenoh-pico/session/subscription.h"
 #include "zenoh-pico/transport/multicast/rx.h"
 #include "zenoh-pico/transport/raweth/rx.h"
 #include "zenoh-pico/transport/unicast/rx.h"
@@ -53,6 +55,8 @@ _z_fut_fn_result_t _zp_raweth_read_task_fn(void *ztm_arg, _z_executor_t *executo
     } else if (ztm->_common._state == _Z_TRANSPORT_STATE_RECONNECTING) {
         return _z_fut_fn_result_suspend();
     }
+    // Samples queued by the other threads are delivered while idle
+    _z_flush_subscription_batches(_z_transport_common_get_session(&ztm->_common));
 
     _z_transport_message_t t_msg;
     _z_slice_t addr = _z_slice_null();
@@ -79,6 +83,8 @@ _z_fut_fn_result_t _zp_raweth_read_task_fn(void *ztm_arg, _z_executor_t *executo
     }
     // Process message
     ret = _z_multicast_handle_transport_message(ztm, &t_msg, &addr);
+    // A frame is a batch, the samples it held are delivered before it is released
+    _z_flush_subscription_batches(_z_transport_common_get_session(&ztm->_common));
     if (ret != _Z_RES_OK) {
         _Z_ERROR("Connection closed due to message processing error: %d", ret);
         _z_slice_clear(&addr);
@@ -263,8 +263,9 @@ z_result_t _z_raweth_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_
     // Encode the frame header
     _Z_CLEAN_RETURN_IF_ERR(_z_transport_message_encode(&ztm->_common._wbuf, &t_msg),
                            _z_transport_tx_mutex_unlock(&ztm->_common));
-    // Encode the network message
-    if (_z_network_message_encode(&ztm->_common._wbuf, n_msg) == _Z_RES_OK) {
+    // Encode the network message if it fits in the buffer
+    if ((_z_network_message_encoded_len(n_msg) <= _z_wbuf_space_left(&ztm->_common._wbuf)) &&
+        (_z_network_message_encode(&ztm->_common._wbuf, n_msg) == _Z_RES_OK)) {
         // Write the eth header
         _Z_CLEAN_RETURN_IF_ERR(__unsafe_z_raweth_write_header(ztm->_common._link, &ztm->_common._wbuf),
                                _z_transport_tx_mutex_unlock(&ztm->_common));
@@ -58,6 +58,16 @@ _z_transport_common_t *_z_transport_get_common(_z_transport_t *zt) {
     }
 }
 
+#if Z_FEATURE_FRAGMENTATION == 1
+_z_defrag_stats_t _z_transport_get_defrag_stats(_z_transport_t *zt) {
+    _z_transport_common_t *ztc = _z_transport_get_common(zt);
+    if (ztc == NULL) {
+        return (_z_defrag_stats_t){0};
+    }
+    return _z_defrag_pool_get_stats(&ztc->_defrag_pool);
+}
+#endif
+
 z_result_t _z_send_close(_z_transport_t *zt, uint8_t reason, bool link_only) {
     z_result_t ret = _Z_RES_OK;
     // Call transport function
@@ -115,7 +125,9 @@ z_result_t _z_transport_start_batching(_z_transport_t *zt) {
     if (ztc->_batch_state == _Z_BATCHING_ACTIVE) {
         return _Z_ERR_GENERIC;
     }
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 0
     ztc->_batch_count = 0;
+#endif
     ztc->_batch_state = _Z_BATCHING_ACTIVE;
 
 #if Z_FEATURE_BATCH_TX_MUTEX == 1
@@ -142,6 +154,25 @@ z_result_t _z_transport_stop_batching(_z_transport_t *zt) {
     ztc->_batch_state = _Z_BATCHING_IDLE;
     return _Z_RES_OK;
 }
+
+#if Z_FEATURE_AUTO_BATCHING == 1
+z_result_t _z_auto_batching_from_config(_z_auto_batching_t *ab, const _z_config_t *config) {
+    *ab = _z_auto_batching_null();
+    int32_t max_delay_us = 0;
+    int32_t max_bytes = 0;
+    _Z_RETURN_IF_ERR(_z_config_get_i32_default(config, Z_CONFIG_AUTO_BATCHING_MAX_DELAY_KEY,
+                                               Z_CONFIG_AUTO_BATCHING_MAX_DELAY_DEFAULT, &max_delay_us));
+    _Z_RETURN_IF_ERR(_z_config_get_i32_default(config, Z_CONFIG_AUTO_BATCHING_MAX_BYTES_KEY,
+                                               Z_CONFIG_AUTO_BATCHING_MAX_BYTES_DEFAULT, &max_bytes));
+    if ((max_delay_us < 0) || (max_bytes < 0)) {
+        _Z_ERROR("Invalid automatic batching bounds: %d us, %d bytes", (int)max_delay_us, (int)max_bytes);
+        _Z_ERROR_RETURN(_Z_ERR_CONFIG_INVALID_VALUE);
+    }
+    ab->_max_delay_us = (uint32_t)max_delay_us;
+    ab->_max_bytes = (size_t)max_bytes;
+    return _Z_RES_OK;
+}
+#endif
 #endif
 
 _z_pending_peers_t _z_pending_peers_null(void) {
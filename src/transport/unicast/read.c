@@ -24,6 +24,7 @@
 #include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/runtime/runtime.h"
 #include "zenoh-pico/session/interest.h"
+#include "zenoh-pico/session/subscription.h"
 #include "zenoh-pico/transport/common/rx.h"
 #include "zenoh-pico/transport/transport.h"
 #include "zenoh-pico/transport/unicast/lease.h"
@@ -34,6 +35,7 @@
 #define _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA -1
 #define _Z_UNICAST_PEER_READ_STATUS_SOCKET_CLOSED -2
 #define _Z_UNICAST_PEER_READ_STATUS_CRITICAL_ERROR -3
+#define _Z_UNICAST_PEER_READ_STATUS_WOULD_BLOCK -4
 
 #if Z_FEATURE_UNICAST_TRANSPORT == 1
 
@@ -55,6 +57,7 @@ static z_result_t _z_unicast_process_messages(_z_transport_unicast_t *ztu, _z_tr
 
         if (ret != _Z_RES_OK) {
             _Z_INFO("Connection compromised due to malformed message: %d", ret);
+            _z_flush_subscription_batches(_z_transport_common_get_session(&ztu->_common));
             return ret;
         }
         ret = _z_unicast_handle_transport_message(ztu, &t_msg, peer);
@@ -62,6 +65,7 @@ static z_result_t _z_unicast_process_messages(_z_transport_unicast_t *ztu, _z_tr
             if (ret != _Z_ERR_CONNECTION_CLOSED) {
                 _Z_WARN("Connection compromised due to message processing error: %d", ret);
             }
+            _z_flush_subscription_batches(_z_transport_common_get_session(&ztu->_common));
             return ret;
         }
     }
@@ -71,6 +75,8 @@ static z_result_t _z_unicast_process_messages(_z_transport_unicast_t *ztu, _z_tr
     } else {
         _z_zbuf_set_rpos(&ztu->_common._zbuf, _z_zbuf_get_rpos(&ztu->_common._zbuf) + to_read);
     }
+    // Batched subscribers get the samples of the batch at once, before its buffer is reused
+    _z_flush_subscription_batches(_z_transport_common_get_session(&ztu->_common));
     return _Z_RES_OK;
 }
 
@@ -170,7 +176,21 @@ static z_result_t _z_unicast_wait_peer_event(_z_transport_unicast_t *ztu) {
         ._get_socket = _z_unicast_wait_iter_get_socket,
         ._set_ready = _z_unicast_wait_iter_set_ready,
     };
+#if defined(_Z_SOCKET_WAIT_SET_ENABLED)
+    // Peers that still have data to read won't signal again, don't block on them
+    uint32_t timeout_ms = ztu->_peers_pending ? 0 : Z_CONFIG_SOCKET_TIMEOUT;
+    z_result_t ret = _z_socket_wait_set_wait(&ztu->_wait_set, timeout_ms);
+    if ((ret != _Z_RES_OK) && (ret != _Z_NO_DATA_PROCESSED)) {
+        return ret;
+    }
+    // Ready entries are only valid while the peer list is locked
+    _z_transport_peer_mutex_lock(&ztu->_common);
+    _z_socket_wait_set_mark_ready(&ztu->_wait_set, &iter);
+    _z_transport_peer_mutex_unlock(&ztu->_common);
+    return ((ret == _Z_RES_OK) || ztu->_peers_pending) ? _Z_RES_OK : _Z_NO_DATA_PROCESSED;
+#else
     return _z_socket_wait_readable(&iter, Z_CONFIG_SOCKET_TIMEOUT);
+#endif
 }
 
 static z_result_t _z_unicast_handle_remaining_data(_z_transport_unicast_t *ztu, _z_transport_peer_unicast_t *peer,
@@ -214,7 +234,7 @@ static int _z_unicast_peer_read(_z_transport_unicast_t *ztu, _z_transport_peer_u
                         _Z_DEBUG("Socket closed");
                         return _Z_UNICAST_PEER_READ_STATUS_SOCKET_CLOSED;
                     } else if (read_size == SIZE_MAX) {
-                        return _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA;
+                        return _Z_UNICAST_PEER_READ_STATUS_WOULD_BLOCK;
                     }
                     if (_z_zbuf_readable_len(&ztu->_common._zbuf) < _Z_MSG_LEN_ENC_SIZE) {
                         peer->flow_state = _Z_FLOW_STATE_PENDING_SIZE;
@@ -242,7 +262,7 @@ static int _z_unicast_peer_read(_z_transport_unicast_t *ztu, _z_transport_peer_u
                         _Z_DEBUG("Socket closed");
                         return _Z_UNICAST_PEER_READ_STATUS_SOCKET_CLOSED;
                     } else if (read_size == SIZE_MAX) {
-                        return _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA;
+                        return _Z_UNICAST_PEER_READ_STATUS_WOULD_BLOCK;
                     }
                     peer->flow_curr_size += (uint16_t)(_z_zbuf_read(&ztu->_common._zbuf) << 8);
                     *to_read = peer->flow_curr_size;
@@ -262,7 +282,7 @@ static int _z_unicast_peer_read(_z_transport_unicast_t *ztu, _z_transport_peer_u
                         _Z_DEBUG("Socket closed");
                         return _Z_UNICAST_PEER_READ_STATUS_SOCKET_CLOSED;
                     } else if (read_size == SIZE_MAX) {
-                        return _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA;
+                        return _Z_UNICAST_PEER_READ_STATUS_WOULD_BLOCK;
                     }
                     *to_read = peer->flow_curr_size;
                     if (_z_zbuf_readable_len(&peer->flow_buff) < *to_read) {
@@ -277,7 +297,7 @@ static int _z_unicast_peer_read(_z_transport_unicast_t *ztu, _z_transport_peer_u
         case Z_LINK_CAP_FLOW_DATAGRAM:
             *to_read = _z_link_socket_recv_zbuf(ztu->_common._link, &ztu->_common._zbuf, peer->_socket);
             if (*to_read == SIZE_MAX) {
-                return _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA;
+                return _Z_UNICAST_PEER_READ_STATUS_WOULD_BLOCK;
             }
             break;
         default:
@@ -292,6 +312,9 @@ static z_result_t _zp_unicast_process_peer_event(_z_transport_unicast_t *ztu) {
     _z_transport_peer_unicast_slist_t *prev = NULL;
     _z_transport_peer_unicast_slist_t *prev_drop = NULL;
     size_t to_read = 0;
+#if defined(_Z_SOCKET_WAIT_SET_ENABLED)
+    ztu->_peers_pending = false;
+#endif
     while (curr_list != NULL) {
         bool drop_peer = false;
         _z_transport_peer_unicast_t *curr_peer = _z_transport_peer_unicast_slist_value(curr_list);
@@ -299,6 +322,13 @@ static z_result_t _zp_unicast_process_peer_event(_z_transport_unicast_t *ztu) {
             curr_peer->_pending = false;
             // Read data from socket
             int res = _z_unicast_peer_read(ztu, curr_peer, &to_read);
+#if defined(_Z_SOCKET_WAIT_SET_ENABLED)
+            // Edge-triggered: keep reading the socket on the next rounds until it would block
+            if ((res == _Z_UNICAST_PEER_READ_STATUS_OK) || (res == _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA)) {
+                curr_peer->_pending = true;
+                ztu->_peers_pending = true;
+            }
+#endif
             if (res == _Z_UNICAST_PEER_READ_STATUS_OK) {  // Messages to process
                 bool message_to_process = false;
                 do {
@@ -345,6 +375,9 @@ static z_result_t _zp_unicast_process_peer_event(_z_transport_unicast_t *ztu) {
             _z_connectivity_peer_event_data_copy_from_common(&disconnected_peer, &curr_peer->common);
 #endif
             _z_interest_peer_disconnected(zs, &curr_peer->common);
+#if defined(_Z_SOCKET_WAIT_SET_ENABLED)
+            _z_socket_wait_set_remove(&ztu->_wait_set, &curr_peer->_socket);
+#endif
             ztu->_peers = _z_transport_peer_unicast_slist_drop_element(ztu->_peers, prev_drop);
 #if Z_FEATURE_CONNECTIVITY == 1
             _z_transport_peer_mutex_unlock(&ztu->_common);
@@ -372,6 +405,8 @@ _z_fut_fn_result_t _zp_unicast_read_task_fn(void *ztu_arg, _z_executor_t *execut
     } else if (ztu->_common._state == _Z_TRANSPORT_STATE_RECONNECTING) {
         return _z_fut_fn_result_suspend();
     }
+    // Samples queued by the other threads are delivered while idle
+    _z_flush_subscription_batches(_z_transport_common_get_session(&ztu->_common));
 
     z_whatami_t mode = _z_transport_common_get_session(&ztu->_common)->_mode;
     if (mode == Z_WHATAMI_CLIENT) {
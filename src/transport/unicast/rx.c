@@ -21,6 +21,7 @@
 #include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/session/subscription.h"
 #include "zenoh-pico/session/utils.h"
 #include "zenoh-pico/transport/unicast/rx.h"
 #include "zenoh-pico/transport/unicast/transport.h"
@@ -109,7 +110,10 @@ static z_result_t _z_unicast_handle_frame(_z_transport_unicast_t *ztu, uint8_t h
             peer->_sn_rx_reliable = msg->_sn;
         } else {
 #if Z_FEATURE_FRAGMENTATION == 1
-            _z_wbuf_clear(&peer->common._dbuf_reliable);
+            if (_z_defrag_buf_len(&peer->common._dbuf_reliable) > 0) {
+                _z_defrag_pool_count_sn_gap(&ztu->_common._defrag_pool);
+            }
+            _z_defrag_buf_clear(&peer->common._dbuf_reliable);
             peer->common._state_reliable = _Z_DBUF_STATE_NULL;
 #endif
             _Z_INFO("Reliable message dropped because it is out of order");
@@ -121,7 +125,10 @@ static z_result_t _z_unicast_handle_frame(_z_transport_unicast_t *ztu, uint8_t h
             peer->_sn_rx_best_effort = msg->_sn;
         } else {
 #if Z_FEATURE_FRAGMENTATION == 1
-            _z_wbuf_clear(&peer->common._dbuf_best_effort);
+            if (_z_defrag_buf_len(&peer->common._dbuf_best_effort) > 0) {
+                _z_defrag_pool_count_sn_gap(&ztu->_common._defrag_pool);
+            }
+            _z_defrag_buf_clear(&peer->common._dbuf_best_effort);
             peer->common._state_best_effort = _Z_DBUF_STATE_NULL;
 #endif
             _Z_INFO("Best effort message dropped because it is out of order");
@@ -144,7 +151,7 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
                                                    _z_t_msg_fragment_t *msg, _z_transport_peer_unicast_t *peer) {
     z_result_t ret = _Z_RES_OK;
 #if Z_FEATURE_FRAGMENTATION == 1
-    _z_wbuf_t *dbuf;
+    _z_defrag_buf_t *dbuf;
     uint8_t *dbuf_state;
     z_reliability_t tmsg_reliability;
     bool consecutive;
@@ -161,7 +168,10 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
             dbuf = &peer->common._dbuf_reliable;
             dbuf_state = &peer->common._state_reliable;
         } else {
-            _z_wbuf_clear(&peer->common._dbuf_reliable);
+            if (_z_defrag_buf_len(&peer->common._dbuf_reliable) > 0) {
+                _z_defrag_pool_count_sn_gap(&ztu->_common._defrag_pool);
+            }
+            _z_defrag_buf_clear(&peer->common._dbuf_reliable);
             peer->common._state_reliable = _Z_DBUF_STATE_NULL;
             _Z_INFO("Reliable message dropped because it is out of order");
             return _Z_RES_OK;
@@ -175,15 +185,19 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
             dbuf = &peer->common._dbuf_best_effort;
             dbuf_state = &peer->common._state_best_effort;
         } else {
-            _z_wbuf_clear(&peer->common._dbuf_best_effort);
+            if (_z_defrag_buf_len(&peer->common._dbuf_best_effort) > 0) {
+                _z_defrag_pool_count_sn_gap(&ztu->_common._defrag_pool);
+            }
+            _z_defrag_buf_clear(&peer->common._dbuf_best_effort);
             peer->common._state_best_effort = _Z_DBUF_STATE_NULL;
             _Z_INFO("Best effort message dropped because it is out of order");
             return _Z_RES_OK;
         }
     }
     // Check consecutive SN
-    if (!consecutive && _z_wbuf_len(dbuf) > 0) {
-        _z_wbuf_clear(dbuf);
+    if (!consecutive && (_z_defrag_buf_len(dbuf) > 0)) {
+        _z_defrag_pool_count_sn_gap(&ztu->_common._defrag_pool);
+        _z_defrag_buf_clear(dbuf);
         *dbuf_state = _Z_DBUF_STATE_NULL;
         _Z_INFO("Defragmentation buffer dropped because non-consecutive fragments received");
         return _Z_RES_OK;
@@ -191,33 +205,31 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
     // Handle fragment markers
     if (_Z_PATCH_HAS_FRAGMENT_MARKERS(peer->common._patch)) {
         if (msg->first) {
-            _z_wbuf_reset(dbuf);
-        } else if (_z_wbuf_len(dbuf) == 0) {
+            _z_defrag_buf_reset(dbuf);
+        } else if (_z_defrag_buf_len(dbuf) == 0) {
             _Z_INFO("First fragment received without the start marker");
             return _Z_RES_OK;
         }
         if (msg->drop) {
-            _z_wbuf_reset(dbuf);
+            _z_defrag_buf_reset(dbuf);
             return _Z_RES_OK;
         }
     }
-    // Allocate buffer if needed
+    // Start a new message, its buffer is taken from the pool on the first write
     if (*dbuf_state == _Z_DBUF_STATE_NULL) {
-        if (_z_wbuf_init(dbuf, Z_FRAG_MAX_SIZE, false) != _Z_RES_OK) {
-            _Z_ERROR("Not enough memory to allocate transport defragmentation buffer");
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
         *dbuf_state = _Z_DBUF_STATE_INIT;
     }
     // Process fragment data
     if (*dbuf_state == _Z_DBUF_STATE_INIT) {
         // Check overflow
         const _z_slice_t *payload_slice = _z_slice_view_deref(&msg->_payload);
-        if ((_z_wbuf_len(dbuf) + payload_slice->len) > Z_FRAG_MAX_SIZE) {
+        if ((_z_defrag_buf_len(dbuf) + payload_slice->len) > Z_FRAG_MAX_SIZE) {
+            *dbuf_state = _Z_DBUF_STATE_OVERFLOW;
+        } else if (_z_defrag_buf_write(dbuf, &ztu->_common._defrag_pool, payload_slice->start, payload_slice->len) != _Z_RES_OK) {
+            // Release what was reassembled so far for the other messages
+            _Z_INFO("Fragment dropped because the defragmentation budget is exhausted");
+            _z_defrag_buf_clear(dbuf);
             *dbuf_state = _Z_DBUF_STATE_OVERFLOW;
-        } else {
-            // Fill buffer
-            _z_wbuf_write_bytes(dbuf, payload_slice->start, 0, payload_slice->len);
         }
     }
     // Process final fragment
@@ -225,18 +237,14 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
         // Drop message if it exceeds the fragmentation size
         if (*dbuf_state == _Z_DBUF_STATE_OVERFLOW) {
             _Z_INFO("Fragment dropped because defragmentation buffer has overflown");
-            _z_wbuf_clear(dbuf);
+            _z_defrag_buf_clear(dbuf);
             *dbuf_state = _Z_DBUF_STATE_NULL;
             return _Z_RES_OK;
         }
-        // Convert the defragmentation buffer into a decoding buffer
-        _z_zbuf_t zbf = _z_wbuf_moved_as_zbuf(dbuf);
-        if (_z_zbuf_capacity(&zbf) == 0) {
-            _Z_ERROR("Failed to convert defragmentation buffer into a decoding buffer!");
-            _z_wbuf_clear(dbuf);
-            *dbuf_state = _Z_DBUF_STATE_NULL;
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
+        // Take the message out of the peer, it is decoded in place
+        _z_defrag_buf_t msg_buf = *dbuf;
+        *dbuf = _z_defrag_buf_null();
+        _z_zbuf_t zbf = _z_defrag_buf_as_zbuf(&msg_buf);
         // Decode message
         _z_zenoh_message_t zm = {0};
         ret = _z_network_message_decode(&zm, &zbf);
@@ -249,8 +257,9 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
             _Z_ERROR_LOG(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
             ret = _Z_ERR_MESSAGE_DESERIALIZATION_FAILED;
         }
-        // Free the decoding buffer
-        _z_zbuf_clear(&zbf);
+        // Batched subscribers get the samples before the buffer they borrow from goes back to the pool
+        _z_flush_subscription_batches(_z_transport_common_get_session(&ztu->_common));
+        _z_defrag_buf_clear(&msg_buf);
         *dbuf_state = _Z_DBUF_STATE_NULL;
     }
 #else
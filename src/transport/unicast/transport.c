@@ -39,27 +39,59 @@ z_result_t _z_unicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
     ztu->_common._batch_state = _Z_BATCHING_IDLE;
     ztu->_common._batch_count = 0;
 #endif
+#if Z_FEATURE_AUTO_BATCHING == 1
+    ztu->_common._auto_batching = _z_auto_batching_null();
+#endif
 
 #if Z_FEATURE_MULTI_THREAD == 1
     // Initialize the mutexes
-    _Z_RETURN_IF_ERR(_z_mutex_init(&ztu->_common._mutex_tx));
-    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_rec_init(&ztu->_common._mutex_peer), _z_mutex_drop(&ztu->_common._mutex_tx));
+    _Z_RETURN_IF_ERR(_z_transport_common_mutex_init(&ztu->_common));
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
     // Initialize the read and write buffers
     uint16_t mtu = (zl->_mtu < param->_batch_size) ? zl->_mtu : param->_batch_size;
     // Initialize tx rx buffers
-    if (_z_wbuf_init(&ztu->_common._wbuf, mtu, false) != _Z_RES_OK ||
-        _z_zbuf_init(&ztu->_common._zbuf, param->_batch_size) != _Z_RES_OK) {
+#if Z_FEATURE_RX_ZERO_COPY == 1
+    // Retained payloads keep a reference on the rx buffer instead of a copy
+    z_result_t zbuf_ret = _z_zbuf_init_shared(&ztu->_common._zbuf, param->_batch_size);
+#else
+    z_result_t zbuf_ret = _z_zbuf_init(&ztu->_common._zbuf, param->_batch_size);
+#endif
+    if (_z_wbuf_init(&ztu->_common._wbuf, mtu, false) != _Z_RES_OK || zbuf_ret != _Z_RES_OK) {
 #if Z_FEATURE_MULTI_THREAD == 1
-        _z_mutex_drop(&ztu->_common._mutex_tx);
-        _z_mutex_rec_drop(&ztu->_common._mutex_peer);
+        _z_transport_common_mutex_drop(&ztu->_common);
 #endif
         _z_wbuf_clear(&ztu->_common._wbuf);
         _z_zbuf_clear(&ztu->_common._zbuf);
         _Z_ERROR("Not enough memory to allocate transport buffers!");
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
+#if Z_FEATURE_UNICAST_PEER == 1 && defined(_Z_SOCKET_WAIT_SET_ENABLED)
+    if (_z_socket_wait_set_init(&ztu->_wait_set) != _Z_RES_OK) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        _z_transport_common_mutex_drop(&ztu->_common);
+#endif
+        _z_wbuf_clear(&ztu->_common._wbuf);
+        _z_zbuf_clear(&ztu->_common._zbuf);
+        _Z_ERROR("Failed to create the peer socket wait set!");
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    ztu->_peers_pending = false;
+#endif
+#if Z_FEATURE_FRAGMENTATION == 1
+    if (_z_defrag_pool_init(&ztu->_common._defrag_pool) != _Z_RES_OK) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        _z_transport_common_mutex_drop(&ztu->_common);
+#endif
+#if Z_FEATURE_UNICAST_PEER == 1 && defined(_Z_SOCKET_WAIT_SET_ENABLED)
+        _z_socket_wait_set_clear(&ztu->_wait_set);
+#endif
+        _z_wbuf_clear(&ztu->_common._wbuf);
+        _z_zbuf_clear(&ztu->_common._zbuf);
+        _Z_ERROR("Failed to initialize the defragmentation pool!");
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+#endif
     // Set default SN resolution
     ztu->_common._sn_res = _z_sn_max(param->_seq_num_res);
     // The initial SN at TX side
@@ -310,6 +342,9 @@ z_result_t _z_unicast_transport_close(_z_transport_unicast_t *ztu, uint8_t reaso
 void _z_unicast_transport_clear(_z_transport_unicast_t *ztu) {
     _z_transport_peer_unicast_slist_free(&ztu->_peers);
     _z_pending_peers_clear(&ztu->_pending_peers);
+#if Z_FEATURE_UNICAST_PEER == 1 && defined(_Z_SOCKET_WAIT_SET_ENABLED)
+    _z_socket_wait_set_clear(&ztu->_wait_set);
+#endif
     _z_transport_common_clear(
         &ztu->_common);  // free common in the very end, as peers might access the link data in common while being freed
 }
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// A session without transport, handed directly what its peers would send. Included once by a test.
+
+#ifndef ZP_SESSION_FIXTURE_H
+#define ZP_SESSION_FIXTURE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/session/interest.h"
+#include "zenoh-pico/session/utils.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+static _z_session_t *session;
+static _z_session_rc_t session_rc;
+// Declarations are received from them, only their address matters
+static _z_transport_peer_common_t peer_a;
+static _z_transport_peer_common_t peer_b;
+
+static inline void setup_session(void) {
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    session = (_z_session_t *)z_malloc(sizeof(_z_session_t));
+    assert(session != NULL);
+    memset(session, 0, sizeof(_z_session_t));
+    assert(_z_session_init(session, &zid) == _Z_RES_OK);
+    session_rc = _z_session_rc_new(session);
+    assert(!_Z_RC_IS_NULL(&session_rc));
+    memset(&peer_a, 0, sizeof(peer_a));
+    memset(&peer_b, 0, sizeof(peer_b));
+}
+
+static inline void cleanup_session(void) { _z_session_rc_drop(&session_rc); }
+
+// Refers to the key, which must outlive it
+static inline _z_wireexpr_t wireexpr_of(const char *key) {
+    _z_wireexpr_t expr = _z_wireexpr_null();
+    expr._suffix = _z_string_view_make(key, strlen(key));
+    return expr;
+}
+
+#if Z_FEATURE_INTEREST == 1
+static inline void declare(_z_declaration_t decl, _z_transport_peer_common_t *peer, _z_optional_id_t interest_id) {
+    _z_n_msg_declare_t msg = {._decl = decl, ._interest_id = interest_id};
+    assert(_z_interest_process_declares(session, &msg, peer) == _Z_RES_OK);
+}
+
+static inline void declare_subscriber(const char *key, uint32_t id, _z_transport_peer_common_t *peer) {
+    _z_wireexpr_t expr = wireexpr_of(key);
+    declare(_z_make_decl_subscriber(&expr, id), peer, _z_optional_id_make_none());
+}
+
+static inline void declare_queryable(const char *key, uint32_t id, bool complete, _z_transport_peer_common_t *peer) {
+    _z_wireexpr_t expr = wireexpr_of(key);
+    declare(_z_make_decl_queryable(&expr, id, complete, 0), peer, _z_optional_id_make_none());
+}
+
+static inline z_result_t undeclare_subscriber(uint32_t id, _z_transport_peer_common_t *peer) {
+    _z_declaration_t decl = _z_make_undecl_subscriber(id, NULL);
+    return _z_interest_process_undeclares(session, &decl, peer);
+}
+#endif
+
+#endif  // ZP_SESSION_FIXTURE_H
@@ -0,0 +1,172 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "zenoh-pico/collections/advanced_cache.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_ADVANCED_PUBLICATION == 1
+
+#define CAPACITY 64
+#define UNBOUNDED -1
+#define NOW ((_z_ntp64_t)1000 << 32)
+
+static const _ze_advanced_cache_range_t ALL = {.start = UNBOUNDED, .end = UNBOUNDED};
+static const _z_time_range_t ALWAYS = {.start = {.bound = _Z_TIME_BOUND_UNBOUNDED},
+                                       .end = {.bound = _Z_TIME_BOUND_UNBOUNDED}};
+
+// Sample of the given sequence number, published the given number of seconds ago
+static void push(_ze_advanced_cache_store_t *store, uint32_t sn, uint32_t secs_ago) {
+    _z_sample_owned_t owned = _z_sample_owned_null();
+    owned.source_info._source_id.eid = 1;
+    owned.source_info._source_sn = sn;
+    owned.timestamp.valid = true;
+    owned.timestamp.time = NOW - ((_z_ntp64_t)secs_ago << 32);
+    assert(_z_bytes_copy_from_buf(&owned.payload, (const uint8_t *)&sn, sizeof(sn)) == _Z_RES_OK);
+    _z_sample_t sample = _z_sample_from_owned(&owned);
+    _z_sample_t dropped;
+    assert(_ze_advanced_cache_store_push(store, &sample, &dropped) == _Z_RES_OK);
+    assert(!_z_sample_check(&sample));
+    _z_sample_clear(&dropped);
+}
+
+static uint32_t sn_of(const _ze_advanced_cache_entry_t *e) {
+    return _z_sample_get_ref(&e->_sample)->source_info._source_sn;
+}
+
+// Select and check the sequence numbers, newest first
+static void expect_select(_ze_advanced_cache_store_t *store, int64_t start, int64_t end, const _z_time_range_t *time,
+                          size_t max, uint32_t newest, size_t num) {
+    _ze_advanced_cache_range_t range = {.start = start, .end = end};
+    _ze_advanced_cache_entry_t *entries[CAPACITY];
+    size_t len = _ze_advanced_cache_store_select(store, &range, time, NOW, max, entries);
+    assert(len == num);
+    for (size_t i = 0; i < len; i++) {
+        assert(sn_of(entries[i]) == newest - i);
+    }
+    _ze_advanced_cache_store_release(store, entries, len);
+}
+
+void test_sn_range(void) {
+    printf("Test: samples are selected by sequence number\n");
+    _ze_advanced_cache_store_t store;
+    assert(_ze_advanced_cache_store_init(&store, CAPACITY) == _Z_RES_OK);
+    // Twice the capacity, the first half was dropped
+    for (uint32_t sn = 0; sn < 2 * CAPACITY; sn++) {
+        push(&store, sn, 0);
+    }
+    assert(_ze_advanced_cache_store_len(&store) == CAPACITY);
+    expect_select(&store, UNBOUNDED, UNBOUNDED, &ALWAYS, SIZE_MAX, 2 * CAPACITY - 1, CAPACITY);
+    expect_select(&store, CAPACITY + 10, CAPACITY + 19, &ALWAYS, SIZE_MAX, CAPACITY + 19, 10);
+    expect_select(&store, CAPACITY + 10, UNBOUNDED, &ALWAYS, 3, 2 * CAPACITY - 1, 3);
+    expect_select(&store, 0, CAPACITY + 4, &ALWAYS, SIZE_MAX, CAPACITY + 4, 5);
+    expect_select(&store, 0, 10, &ALWAYS, SIZE_MAX, 0, 0);
+    expect_select(&store, 3 * CAPACITY, UNBOUNDED, &ALWAYS, SIZE_MAX, 0, 0);
+
+    // Gaps in the sequence numbers are searched for
+    _ze_advanced_cache_store_clear(&store);
+    assert(_ze_advanced_cache_store_init(&store, CAPACITY) == _Z_RES_OK);
+    for (uint32_t sn = 0; sn < CAPACITY; sn++) {
+        push(&store, 3 * sn, 0);
+    }
+    _ze_advanced_cache_range_t range = {.start = 31, .end = 44};
+    _ze_advanced_cache_entry_t *entries[CAPACITY];
+    size_t len = _ze_advanced_cache_store_select(&store, &range, &ALWAYS, NOW, SIZE_MAX, entries);
+    assert(len == 4 && sn_of(entries[0]) == 42 && sn_of(entries[3]) == 33);
+    _ze_advanced_cache_store_release(&store, entries, len);
+
+    // Out of order, every sample is checked
+    push(&store, 1, 0);
+    range = (_ze_advanced_cache_range_t){.start = 0, .end = 3};
+    len = _ze_advanced_cache_store_select(&store, &range, &ALWAYS, NOW, SIZE_MAX, entries);
+    assert(len == 2 && sn_of(entries[0]) == 1 && sn_of(entries[1]) == 3);
+    _ze_advanced_cache_store_release(&store, entries, len);
+    _ze_advanced_cache_store_clear(&store);
+}
+
+void test_time_range(void) {
+    printf("Test: samples are selected by timestamp\n");
+    _ze_advanced_cache_store_t store;
+    assert(_ze_advanced_cache_store_init(&store, CAPACITY) == _Z_RES_OK);
+    // One sample per second, the newest one now
+    for (uint32_t sn = 0; sn < CAPACITY; sn++) {
+        push(&store, sn, CAPACITY - 1 - sn);
+    }
+    // The last 10 seconds
+    _z_time_range_t time = {.start = {.bound = _Z_TIME_BOUND_INCLUSIVE, .now_offset = -10.0},
+                            .end = {.bound = _Z_TIME_BOUND_UNBOUNDED}};
+    expect_select(&store, UNBOUNDED, UNBOUNDED, &time, SIZE_MAX, CAPACITY - 1, 11);
+    time.start.bound = _Z_TIME_BOUND_EXCLUSIVE;
+    expect_select(&store, UNBOUNDED, UNBOUNDED, &time, SIZE_MAX, CAPACITY - 1, 10);
+    // From 20 to 10 seconds ago
+    time.start.bound = _Z_TIME_BOUND_INCLUSIVE;
+    time.start.now_offset = -20.0;
+    time.end.bound = _Z_TIME_BOUND_EXCLUSIVE;
+    time.end.now_offset = -10.0;
+    expect_select(&store, UNBOUNDED, UNBOUNDED, &time, SIZE_MAX, CAPACITY - 12, 10);
+    // Along with a sequence number range
+    expect_select(&store, CAPACITY - 15, CAPACITY - 5, &time, SIZE_MAX, CAPACITY - 12, 4);
+    // Before the history
+    time.end.now_offset = -1000.0;
+    time.start.now_offset = -2000.0;
+    expect_select(&store, UNBOUNDED, UNBOUNDED, &time, SIZE_MAX, 0, 0);
+    _ze_advanced_cache_store_clear(&store);
+}
+
+void test_held_entries(void) {
+    printf("Test: selected samples outlive the history\n");
+    _ze_advanced_cache_store_t store;
+    assert(_ze_advanced_cache_store_init(&store, CAPACITY) == _Z_RES_OK);
+    for (uint32_t sn = 0; sn < CAPACITY; sn++) {
+        push(&store, sn, 0);
+    }
+    _ze_advanced_cache_entry_t *entries[CAPACITY];
+    size_t len = _ze_advanced_cache_store_select(&store, &ALL, &ALWAYS, NOW, SIZE_MAX, entries);
+    assert(len == CAPACITY);
+    // The whole history is replaced while being held
+    for (uint32_t sn = CAPACITY; sn < 2 * CAPACITY; sn++) {
+        push(&store, sn, 0);
+    }
+    for (size_t i = 0; i < len; i++) {
+        const _z_sample_owned_t *ref = _z_sample_get_ref(&entries[i]->_sample);
+        assert(ref->source_info._source_sn == CAPACITY - 1 - i);
+        assert(_z_bytes_len(&ref->payload) == sizeof(uint32_t));
+    }
+    _ze_advanced_cache_store_release(&store, entries, len);
+    // Their entries are reused
+    for (uint32_t sn = 2 * CAPACITY; sn < 4 * CAPACITY; sn++) {
+        push(&store, sn, 0);
+    }
+    expect_select(&store, UNBOUNDED, UNBOUNDED, &ALWAYS, SIZE_MAX, 4 * CAPACITY - 1, CAPACITY);
+    _ze_advanced_cache_store_clear(&store);
+}
+
+int main(void) {
+    test_sn_range();
+    test_time_range();
+    test_held_entries();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_ADVANCED_PUBLICATION\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Once warmed up, publishing and delivering a sample must not allocate. The messages published on a session go
+// through the codec as the transport would, and are then handled as received by the same session.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/session_fixture.h"
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/loopback.h"
+#include "zenoh-pico/session/session.h"
+#include "zenoh-pico/session/subscription.h"
+#include "zenoh-pico/transport/transport.h"
+
+#if Z_FEATURE_ALLOCATOR == 1 && Z_FEATURE_PUBLICATION == 1 && Z_FEATURE_SUBSCRIPTION == 1 && defined(Z_TEST_HOOKS)
+
+#define KEYEXPR "zenoh-pico/tests/steady"
+#define WARMUP 16
+#define MESSAGES 1000
+
+static size_t mallocs;
+
+static void *counting_allocate(size_t size, void *context) {
+    _ZP_UNUSED(context);
+    mallocs++;
+    return _z_platform_malloc(size);
+}
+
+static void *counting_reallocate(void *ptr, size_t size, void *context) {
+    _ZP_UNUSED(context);
+    mallocs++;
+    return _z_platform_realloc(ptr, size);
+}
+
+static void counting_deallocate(void *ptr, void *context) {
+    _ZP_UNUSED(context);
+    _z_platform_free(ptr);
+}
+
+static _z_transport_common_t transport;
+static _z_link_t fake_link;
+static _z_wbuf_t wire;
+static size_t sent;
+static size_t received;
+static size_t rx_mallocs;
+
+// The peer sending the messages handled by the session, so that they are delivered as remote ones
+static _z_transport_peer_common_t *remote_peer(void) {
+    return &_z_transport_peer_unicast_slist_value(session->_tp._transport._unicast._peers)->common;
+}
+
+// Received by the peer
+static z_result_t on_send(_z_session_t *zn, const _z_network_message_t *n_msg, z_reliability_t reliability,
+                          z_congestion_control_t cong_ctrl, void *peer, bool *handled) {
+    _ZP_UNUSED(zn);
+    _ZP_UNUSED(reliability);
+    _ZP_UNUSED(cong_ctrl);
+    _ZP_UNUSED(peer);
+    *handled = true;
+    _z_wbuf_reset(&wire);
+    _Z_RETURN_IF_ERR(_z_network_message_encode(&wire, n_msg));
+    // The peer learns the key expressions declared by the publisher, which its samples refer to
+    bool is_kexpr = (n_msg->_tag == _Z_N_DECLARE) && (n_msg->_body._declare._decl._tag == _Z_DECL_KEXPR);
+    if ((n_msg->_tag != _Z_N_PUSH) && !is_kexpr) {
+        return _Z_RES_OK;
+    }
+    if (!is_kexpr) {
+        sent++;
+    }
+    // Received back, as from the transport
+    size_t before = mallocs;
+    // Read in place, as from the receive buffer of the transport
+    _z_slice_t bytes = _z_slice_alias_buf(_z_wbuf_get_iosli(&wire, 0)->_buf, _z_wbuf_len(&wire));
+    _z_zbuf_t zbf = _z_slice_as_zbuf(&bytes);
+    _z_network_message_t msg;
+    z_result_t ret = _z_network_message_decode(&msg, &zbf);
+    if (ret == _Z_RES_OK) {
+        ret = _z_handle_network_message(&transport, &msg, remote_peer());
+    }
+    rx_mallocs += mallocs - before;
+    return ret;
+}
+
+static void on_sample(z_loaned_sample_t *sample, void *arg) {
+    _ZP_UNUSED(arg);
+    assert(z_bytes_len(z_sample_payload(sample)) == sizeof(uint64_t));
+    received++;
+}
+
+static void setup(void) {
+    setup_session();
+    session->_weak = _z_session_rc_clone_as_weak(&session_rc);
+    transport = (_z_transport_common_t){0};
+    transport._session = _z_session_rc_clone_as_weak(&session_rc);
+    transport._link = &fake_link;
+    // A peer to send to
+    session->_tp._type = _Z_TRANSPORT_UNICAST_TYPE;
+    session->_tp._transport._unicast._peers =
+        _z_transport_peer_unicast_slist_push_empty(session->_tp._transport._unicast._peers);
+    *_z_transport_peer_unicast_slist_value(session->_tp._transport._unicast._peers) = (_z_transport_peer_unicast_t){0};
+    session->_tp._transport._unicast._common._link = &fake_link;
+    assert(_z_wbuf_init(&wire, Z_BATCH_UNICAST_SIZE, false) == _Z_RES_OK);
+    _z_transport_set_send_n_msg_override(on_send);
+}
+
+static void cleanup(void) {
+    _z_transport_set_send_n_msg_override(NULL);
+    _z_wbuf_clear(&wire);
+    _z_transport_peer_unicast_slist_free(&session->_tp._transport._unicast._peers);
+    session->_tp._transport._unicast._common._link = NULL;
+    session->_tp._type = _Z_TRANSPORT_NONE;
+    _z_session_weak_drop(&transport._session);
+    cleanup_session();
+}
+
+void test_publish_and_deliver(void) {
+    printf("Test: publishing and delivering samples doesn't allocate\n");
+    setup();
+    zp_allocator_t allocator = {.allocate = counting_allocate,
+                                .reallocate = counting_reallocate,
+                                .deallocate = counting_deallocate};
+    assert(zp_set_allocator(&allocator) == _Z_RES_OK);
+
+    z_view_keyexpr_t ke;
+    assert(z_view_keyexpr_from_str(&ke, KEYEXPR) == Z_OK);
+    z_owned_closure_sample_t callback;
+    z_closure(&callback, on_sample, NULL, NULL);
+    z_subscriber_options_t sub_opts;
+    z_subscriber_options_default(&sub_opts);
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+    sub_opts.allowed_origin = Z_LOCALITY_REMOTE;
+#endif
+    z_owned_subscriber_t sub;
+    assert(z_declare_subscriber(&session_rc, &sub, z_loan(ke), z_move(callback), &sub_opts) == Z_OK);
+    z_owned_publisher_t pub;
+    assert(z_declare_publisher(&session_rc, &pub, z_loan(ke), NULL) == Z_OK);
+    // The peer subscribes, so that the publisher writes to it
+    _z_wireexpr_t wireexpr = wireexpr_of(KEYEXPR);
+    _z_network_message_t declare;
+    _z_n_msg_make_declare(&declare, _z_make_decl_subscriber(&wireexpr, 1), _z_optional_id_make_none());
+    assert(_z_handle_network_message(&transport, &declare, remote_peer()) == _Z_RES_OK);
+
+    uint64_t value = 0;
+    size_t put_mallocs = 0;
+    for (size_t i = 0; i < WARMUP + MESSAGES; i++) {
+        if (i == WARMUP) {
+            put_mallocs = 0;
+            rx_mallocs = 0;
+            sent = 0;
+            received = 0;
+        }
+        value = i;
+        z_owned_bytes_t payload;
+        assert(z_bytes_from_static_buf(&payload, (const uint8_t *)&value, sizeof(value)) == Z_OK);
+        size_t before = mallocs;
+        assert(z_publisher_put(z_loan(pub), z_move(payload), NULL) == Z_OK);
+        put_mallocs += mallocs - before;
+    }
+    printf("  allocations per message: publication %zu, delivery %zu\n", (put_mallocs - rx_mallocs) / MESSAGES,
+           rx_mallocs / MESSAGES);
+    assert(sent == MESSAGES && received == MESSAGES);
+    assert(put_mallocs == rx_mallocs);
+    assert(rx_mallocs == 0);
+
+    z_drop(z_move(pub));
+    z_drop(z_move(sub));
+    assert(zp_set_allocator(NULL) == _Z_RES_OK);
+    cleanup();
+}
+
+int main(void) {
+    test_publish_and_deliver();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf(
+        "Missing config token to build this test. This test requires: Z_FEATURE_ALLOCATOR, Z_FEATURE_PUBLICATION and "
+        "Z_FEATURE_SUBSCRIPTION\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,350 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/subscription.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/system/platform.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_ALLOCATOR == 1
+
+#define ARENA_SIZE (64 * 1024)
+#define KEYEXPR "zenoh-pico/tests/allocator"
+#define MESSAGES 100
+
+static uint8_t arena[ARENA_SIZE];
+
+/*------------------ Counting allocator ------------------*/
+typedef struct {
+    size_t mallocs;
+    size_t reallocs;
+    size_t frees;
+} counters_t;
+
+static void *counting_allocate(size_t size, void *context) {
+    ((counters_t *)context)->mallocs++;
+    return _z_platform_malloc(size);
+}
+
+static void *counting_reallocate(void *ptr, size_t size, void *context) {
+    ((counters_t *)context)->reallocs++;
+    return _z_platform_realloc(ptr, size);
+}
+
+static void counting_deallocate(void *ptr, void *context) {
+    if (ptr != NULL) {
+        ((counters_t *)context)->frees++;
+    }
+    _z_platform_free(ptr);
+}
+
+static counters_t counters;
+
+static void count_allocations(void) {
+    counters = (counters_t){0};
+    zp_allocator_t allocator = {.allocate = counting_allocate,
+                                .reallocate = counting_reallocate,
+                                .deallocate = counting_deallocate,
+                                .context = &counters};
+    assert(zp_set_allocator(&allocator) == _Z_RES_OK);
+}
+
+/*------------------ Pool ------------------*/
+static bool in_arena(const void *ptr) {
+    return (uintptr_t)ptr >= (uintptr_t)arena && (uintptr_t)ptr < (uintptr_t)arena + sizeof(arena);
+}
+
+void test_pool_classes(void) {
+    printf("Test: the pool hands out aligned blocks of each class\n");
+    zp_alloc_pool_t pool;
+    assert(zp_alloc_pool_init(&pool, arena, sizeof(arena)) == _Z_RES_OK);
+    size_t sizes[] = {0, 1, 16, 17, 100, 128, Z_ALLOC_POOL_PAGE_SIZE / 4};
+    void *blocks[sizeof(sizes) / sizeof(sizes[0])];
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        blocks[i] = zp_alloc_pool_malloc(&pool, sizes[i]);
+        assert(blocks[i] != NULL && in_arena(blocks[i]));
+        assert((uintptr_t)blocks[i] % 16 == 0);
+        memset(blocks[i], (int)i, sizes[i]);
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for (size_t j = 0; j < sizes[i]; j++) {
+            assert(((uint8_t *)blocks[i])[j] == (uint8_t)i);
+        }
+    }
+    // Freed blocks are reused first
+    zp_alloc_pool_free(&pool, blocks[4]);
+    assert(zp_alloc_pool_malloc(&pool, 120) == blocks[4]);
+
+    // Larger ones go to the platform
+    void *large = zp_alloc_pool_malloc(&pool, Z_ALLOC_POOL_PAGE_SIZE);
+    assert(large != NULL && !in_arena(large));
+    zp_alloc_pool_free(&pool, large);
+
+    zp_alloc_pool_stats_t stats;
+    zp_alloc_pool_stats(&pool, &stats);
+    assert(stats.allocs == 8 && stats.frees == 1 && stats.fallbacks == 1);
+    // 0, 1, 16 share a page, as do 100 and 128
+    assert(stats.pages == 4 && stats.max_pages > 0);
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        zp_alloc_pool_free(&pool, blocks[i]);
+    }
+}
+
+void test_pool_realloc(void) {
+    printf("Test: reallocated blocks keep their contents\n");
+    zp_alloc_pool_t pool;
+    assert(zp_alloc_pool_init(&pool, arena, sizeof(arena)) == _Z_RES_OK);
+    uint8_t *ptr = (uint8_t *)zp_alloc_pool_realloc(&pool, NULL, 10);
+    assert(ptr != NULL);
+    for (uint8_t i = 0; i < 10; i++) {
+        ptr[i] = i;
+    }
+    // Within the block, it stays in place
+    assert(zp_alloc_pool_realloc(&pool, ptr, 16) == ptr);
+    ptr = (uint8_t *)zp_alloc_pool_realloc(&pool, ptr, 300);
+    assert(ptr != NULL && in_arena(ptr));
+    ptr = (uint8_t *)zp_alloc_pool_realloc(&pool, ptr, 4 * Z_ALLOC_POOL_PAGE_SIZE);
+    assert(ptr != NULL && !in_arena(ptr));
+    for (uint8_t i = 0; i < 10; i++) {
+        assert(ptr[i] == i);
+    }
+    zp_alloc_pool_free(&pool, ptr);
+}
+
+void test_pool_exhaustion(void) {
+    printf("Test: the pool falls back on the platform once its arena is used up\n");
+    zp_alloc_pool_t pool;
+    size_t len = 3 * (Z_ALLOC_POOL_PAGE_SIZE + 1) + 16;
+    assert(zp_alloc_pool_init(&pool, arena, len) == _Z_RES_OK);
+    size_t per_page = Z_ALLOC_POOL_PAGE_SIZE / 64;
+    void *blocks[4 * Z_ALLOC_POOL_PAGE_SIZE / 64];
+    size_t num = sizeof(blocks) / sizeof(blocks[0]);
+    for (size_t i = 0; i < num; i++) {
+        blocks[i] = zp_alloc_pool_malloc(&pool, 64);
+        assert(blocks[i] != NULL && in_arena(blocks[i]) == (i < 3 * per_page));
+    }
+    zp_alloc_pool_stats_t stats;
+    zp_alloc_pool_stats(&pool, &stats);
+    assert(stats.pages == 3 && stats.max_pages == 3 && stats.fallbacks == num - 3 * per_page);
+    for (size_t i = 0; i < num; i++) {
+        zp_alloc_pool_free(&pool, blocks[i]);
+    }
+    zp_alloc_pool_stats(&pool, &stats);
+    assert(stats.frees == 3 * per_page);
+    // The pages stay with their class
+    void *small = zp_alloc_pool_malloc(&pool, 16);
+    assert(small != NULL && !in_arena(small));
+    zp_alloc_pool_free(&pool, small);
+    assert(zp_alloc_pool_init(&pool, arena, Z_ALLOC_POOL_PAGE_SIZE) != _Z_RES_OK);
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+#define THREADS 4
+#define ROUNDS 20000
+#define HELD 16
+
+static zp_alloc_pool_t shared_pool;
+
+static void *churn(void *arg) {
+    uint8_t id = (uint8_t)(uintptr_t)arg;
+    uint8_t *held[HELD] = {0};
+    size_t held_len[HELD] = {0};
+    uint32_t seed = id + 1u;
+    for (size_t i = 0; i < ROUNDS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        size_t slot = (seed >> 8) % HELD;
+        if (held[slot] != NULL) {
+            for (size_t j = 0; j < held_len[slot]; j++) {
+                assert(held[slot][j] == id);
+            }
+            zp_alloc_pool_free(&shared_pool, held[slot]);
+        }
+        held_len[slot] = 1 + (seed >> 16) % (Z_ALLOC_POOL_PAGE_SIZE / 4);
+        held[slot] = (uint8_t *)zp_alloc_pool_malloc(&shared_pool, held_len[slot]);
+        assert(held[slot] != NULL);
+        memset(held[slot], id, held_len[slot]);
+    }
+    for (size_t slot = 0; slot < HELD; slot++) {
+        zp_alloc_pool_free(&shared_pool, held[slot]);
+    }
+    return NULL;
+}
+
+void test_pool_threads(void) {
+    printf("Test: threads share the pool\n");
+    assert(zp_alloc_pool_init(&shared_pool, arena, sizeof(arena)) == _Z_RES_OK);
+    _z_task_t tasks[THREADS];
+    for (size_t i = 0; i < THREADS; i++) {
+        assert(_z_task_init(&tasks[i], NULL, churn, (void *)(uintptr_t)(i + 1)) == _Z_RES_OK);
+    }
+    for (size_t i = 0; i < THREADS; i++) {
+        assert(_z_task_join(&tasks[i]) == _Z_RES_OK);
+    }
+    zp_alloc_pool_stats_t stats;
+    zp_alloc_pool_stats(&shared_pool, &stats);
+    assert(stats.allocs + stats.fallbacks == THREADS * ROUNDS && stats.allocs == stats.frees);
+}
+#endif
+
+/*------------------ Allocator ------------------*/
+void test_allocator(void) {
+    printf("Test: z_malloc, z_realloc and z_free go through the allocator\n");
+    count_allocations();
+    void *ptr = z_malloc(10);
+    ptr = z_realloc(ptr, 20);
+    z_free(ptr);
+    assert(counters.mallocs == 1 && counters.reallocs == 1 && counters.frees == 1);
+
+    zp_allocator_t incomplete = {.allocate = counting_allocate, .context = &counters};
+    assert(zp_set_allocator(&incomplete) != _Z_RES_OK);
+    assert(zp_set_allocator(NULL) == _Z_RES_OK);
+    z_free(z_malloc(10));
+    assert(counters.mallocs == 1 && counters.frees == 1);
+}
+
+#if Z_FEATURE_SUBSCRIPTION == 1
+static size_t received;
+
+static void on_sample(_z_sample_t *sample, void *arg) {
+    _ZP_UNUSED(sample);
+    _ZP_UNUSED(arg);
+    received++;
+}
+
+// Allocations per message on the way out and in, from encoding a push to the subscription callback
+static void run_messages(bool report) {
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    _z_session_t session;
+    assert(_z_session_init(&session, &zid) == _Z_RES_OK);
+    _z_declared_keyexpr_t keyexpr;
+    _z_string_t str = _z_string_alias_str(KEYEXPR);
+    assert(_z_declared_keyexpr_from_string(&keyexpr, &str) == _Z_RES_OK);
+    _z_subscription_t sub = {0};
+    sub._id = _z_get_entity_id(&session);
+    assert(_z_declared_keyexpr_copy(&sub._key, &keyexpr) == _Z_RES_OK);
+    sub._allowed_origin = Z_LOCALITY_ANY;
+    sub._callback = on_sample;
+    _z_subscription_rc_t rc = _z_register_subscription(&session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    assert(!_Z_RC_IS_NULL(&rc));
+
+    _z_wireexpr_t key = _z_wireexpr_null();
+    key._suffix = _z_string_view_make(KEYEXPR, sizeof(KEYEXPR) - 1);
+    uint8_t value[64] = {0};
+    _z_bytes_t payload;
+    assert(_z_bytes_copy_from_buf(&payload, value, sizeof(value)) == _Z_RES_OK);
+    _z_n_qos_t qos = _z_n_qos_make(false, true, Z_PRIORITY_DATA);
+    _z_network_message_t msg;
+    _z_n_msg_make_push_put(&msg, &key, &payload, NULL, qos, NULL, NULL, Z_RELIABILITY_RELIABLE, NULL);
+    _z_wbuf_t wbf;
+    assert(_z_wbuf_init(&wbf, Z_BATCH_UNICAST_SIZE, false) == _Z_RES_OK);
+
+    size_t encode = 0;
+    size_t decode = 0;
+    size_t deliver = 0;
+    received = 0;
+    for (size_t i = 0; i < MESSAGES; i++) {
+        if (i == 1) {
+            // The first message fills the caches of the session
+            encode = 0;
+            decode = 0;
+            deliver = 0;
+        }
+        _z_wbuf_reset(&wbf);
+        size_t before = counters.mallocs;
+        assert(_z_network_message_encode(&wbf, &msg) == _Z_RES_OK);
+        encode += counters.mallocs - before;
+
+        before = counters.mallocs;
+        // Read in place, as from the receive buffer of the transport
+        _z_slice_t bytes = _z_slice_alias_buf(_z_wbuf_get_iosli(&wbf, 0)->_buf, _z_wbuf_len(&wbf));
+        _z_zbuf_t zbf = _z_slice_as_zbuf(&bytes);
+        _z_network_message_t decoded = {0};
+        assert(_z_network_message_decode(&decoded, &zbf) == _Z_RES_OK);
+        decode += counters.mallocs - before;
+
+        before = counters.mallocs;
+        const _z_bytes_t *received_payload = _z_bytes_view_deref(&decoded._body._push._body._body._put._payload);
+        assert(_z_trigger_subscriptions_impl(&session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &keyexpr._inner,
+                                             received_payload, NULL, Z_SAMPLE_KIND_PUT, NULL, qos, NULL,
+                                             Z_RELIABILITY_RELIABLE, NULL, NULL) == _Z_RES_OK);
+        deliver += counters.mallocs - before;
+    }
+    assert(received == MESSAGES);
+    if (report) {
+        printf("  allocations per message: encode %zu, decode %zu, delivery %zu\n", encode / MESSAGES,
+               decode / MESSAGES, deliver / MESSAGES);
+        assert(encode == 0 && decode == 0 && deliver == 0);
+    }
+
+    _z_wbuf_clear(&wbf);
+    _z_bytes_clear(&payload);
+    _z_unregister_subscription(&session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &rc);
+    _z_session_clear(&session);
+    _z_declared_keyexpr_clear(&keyexpr);
+}
+
+void test_message_allocations(void) {
+    printf("Test: allocations of the message path are counted\n");
+    count_allocations();
+    run_messages(true);
+    assert(counters.mallocs == counters.frees);
+    assert(zp_set_allocator(NULL) == _Z_RES_OK);
+}
+
+void test_session_on_pool(void) {
+    printf("Test: a session runs on the pool\n");
+    zp_alloc_pool_t pool;
+    assert(zp_alloc_pool_init(&pool, arena, sizeof(arena)) == _Z_RES_OK);
+    zp_allocator_t allocator;
+    zp_alloc_pool_allocator(&pool, &allocator);
+    assert(zp_set_allocator(&allocator) == _Z_RES_OK);
+    run_messages(false);
+    assert(zp_set_allocator(NULL) == _Z_RES_OK);
+    zp_alloc_pool_stats_t stats;
+    zp_alloc_pool_stats(&pool, &stats);
+    assert(stats.allocs > 0 && stats.allocs == stats.frees);
+}
+#endif
+
+int main(void) {
+    test_pool_classes();
+    test_pool_realloc();
+    test_pool_exhaustion();
+#if Z_FEATURE_MULTI_THREAD == 1
+    test_pool_threads();
+#endif
+    test_allocator();
+#if Z_FEATURE_SUBSCRIPTION == 1
+    test_message_allocations();
+    test_session_on_pool();
+#endif
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_ALLOCATOR\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,202 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/collections/atomic_ring.h"
+#include "zenoh-pico/system/platform.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_MULTI_THREAD == 1
+
+#define PRODUCERS 4
+#define PER_PRODUCER 20000
+#define CAPACITY 7
+
+// Elements are encoded in the pointer: producer id in the high bits, counter in the low ones
+#define ELEM(p, i) ((void *)(uintptr_t)((((uintptr_t)(p) + 1) << 24) | (uintptr_t)(i)))
+#define ELEM_PRODUCER(e) ((size_t)(((uintptr_t)(e) >> 24) - 1))
+#define ELEM_INDEX(e) ((size_t)((uintptr_t)(e) & 0xffffff))
+
+static size_t freed = 0;
+static void count_free(void **e) {
+    freed++;
+    *e = NULL;
+}
+
+typedef struct {
+    _z_atomic_ring_t *ring;
+    size_t id;
+} producer_arg_t;
+
+static void *producer_task(void *arg) {
+    producer_arg_t *p = (producer_arg_t *)arg;
+    for (size_t i = 0; i < PER_PRODUCER; i++) {
+        assert(_z_atomic_ring_push(p->ring, ELEM(p->id, i)) == _Z_RES_OK);
+    }
+    return NULL;
+}
+
+void test_capacity(void) {
+    printf("Test: capacity is exact\n");
+    _z_atomic_ring_t ring;
+    assert(_z_atomic_ring_init(&ring, 0, false) != _Z_RES_OK);
+    assert(_z_atomic_ring_init(&ring, CAPACITY, false) == _Z_RES_OK);
+    for (size_t i = 0; i < CAPACITY; i++) {
+        assert(_z_atomic_ring_try_push(&ring, ELEM(0, i)));
+    }
+    assert(!_z_atomic_ring_try_push(&ring, ELEM(0, CAPACITY)));
+    assert(_z_atomic_ring_len(&ring) == CAPACITY);
+    assert(_z_atomic_ring_try_pull(&ring) == ELEM(0, 0));
+    assert(_z_atomic_ring_try_push(&ring, ELEM(0, CAPACITY)));
+
+    // Batches keep the order
+    void *elems[16];
+    assert(_z_atomic_ring_try_pull_many(&ring, elems, 3) == 3);
+    for (size_t i = 0; i < 3; i++) {
+        assert(elems[i] == ELEM(0, i + 1));
+    }
+    assert(_z_atomic_ring_try_pull_many(&ring, elems, 16) == CAPACITY - 3);
+    assert(elems[CAPACITY - 4] == ELEM(0, CAPACITY));
+    assert(_z_atomic_ring_try_pull(&ring) == NULL);
+    assert(_z_atomic_ring_try_pull_many(&ring, elems, 16) == 0);
+    _z_atomic_ring_clear(&ring, count_free);
+}
+
+void test_force_drop(void) {
+    printf("Test: forced pushes drop the oldest elements\n");
+    _z_atomic_ring_t ring;
+    assert(_z_atomic_ring_init(&ring, 3, false) == _Z_RES_OK);
+    freed = 0;
+    for (size_t i = 0; i < 5; i++) {
+        assert(_z_atomic_ring_push_force_drop(&ring, ELEM(0, i), count_free) == _Z_RES_OK);
+    }
+    assert(freed == 2);
+    for (size_t i = 2; i < 5; i++) {
+        assert(_z_atomic_ring_try_pull(&ring) == ELEM(0, i));
+    }
+    // Remaining elements are freed with the ring
+    assert(_z_atomic_ring_try_push(&ring, ELEM(0, 0)));
+    _z_atomic_ring_clear(&ring, count_free);
+    assert(freed == 3);
+
+    assert(_z_atomic_ring_init(&ring, 3, true) == _Z_RES_OK);
+    assert(_z_atomic_ring_push_force_drop(&ring, ELEM(0, 0), count_free) != _Z_RES_OK);
+    _z_atomic_ring_clear(&ring, count_free);
+}
+
+static void run_producers(bool spsc, size_t producer_num, bool batch) {
+    _z_atomic_ring_t ring;
+    assert(_z_atomic_ring_init(&ring, CAPACITY, spsc) == _Z_RES_OK);
+    producer_arg_t args[PRODUCERS];
+    _z_task_t tasks[PRODUCERS];
+    for (size_t p = 0; p < producer_num; p++) {
+        args[p] = (producer_arg_t){.ring = &ring, .id = p};
+        assert(_z_task_init(&tasks[p], NULL, producer_task, &args[p]) == _Z_RES_OK);
+    }
+    // Each producer's elements come out in order
+    size_t next[PRODUCERS] = {0};
+    size_t total = producer_num * PER_PRODUCER;
+    size_t received = 0;
+    while (received < total) {
+        void *elems[4];
+        size_t num;
+        if (batch) {
+            num = _z_atomic_ring_try_pull_many(&ring, elems, 4);
+            if (num == 0) {
+                assert(_z_atomic_ring_pull(&ring, &elems[0]) == _Z_RES_OK);
+                num = 1;
+            }
+        } else {
+            assert(_z_atomic_ring_pull(&ring, &elems[0]) == _Z_RES_OK);
+            num = 1;
+        }
+        for (size_t i = 0; i < num; i++) {
+            size_t p = ELEM_PRODUCER(elems[i]);
+            assert(p < producer_num);
+            assert(ELEM_INDEX(elems[i]) == next[p]);
+            next[p]++;
+        }
+        received += num;
+    }
+    for (size_t p = 0; p < producer_num; p++) {
+        _z_task_join(&tasks[p]);
+        assert(next[p] == PER_PRODUCER);
+    }
+    assert(_z_atomic_ring_try_pull(&ring) == NULL);
+    _z_atomic_ring_clear(&ring, count_free);
+}
+
+void test_spsc(void) {
+    printf("Test: SPSC ring delivers every element in order\n");
+    run_producers(true, 1, false);
+    run_producers(true, 1, true);
+}
+
+void test_mpsc(void) {
+    printf("Test: multi producer ring delivers every element in order\n");
+    run_producers(false, PRODUCERS, false);
+    run_producers(false, PRODUCERS, true);
+}
+
+static void *close_task(void *arg) {
+    z_sleep_ms(50);
+    assert(_z_atomic_ring_close((_z_atomic_ring_t *)arg) == _Z_RES_OK);
+    return NULL;
+}
+
+void test_close(void) {
+    printf("Test: closing wakes up the parked threads\n");
+    _z_atomic_ring_t ring;
+    assert(_z_atomic_ring_init(&ring, 1, false) == _Z_RES_OK);
+    _z_task_t task;
+    assert(_z_task_init(&task, NULL, close_task, &ring) == _Z_RES_OK);
+    void *elem;
+    assert(_z_atomic_ring_pull(&ring, &elem) == _Z_RES_CHANNEL_CLOSED);
+    _z_task_join(&task);
+    _z_atomic_ring_clear(&ring, count_free);
+
+    // Pushes done before the close are still pulled
+    assert(_z_atomic_ring_init(&ring, 1, false) == _Z_RES_OK);
+    assert(_z_atomic_ring_push(&ring, ELEM(0, 1)) == _Z_RES_OK);
+    assert(_z_task_init(&task, NULL, close_task, &ring) == _Z_RES_OK);
+    // Full, parks until the close
+    assert(_z_atomic_ring_push(&ring, ELEM(0, 2)) == _Z_RES_CHANNEL_CLOSED);
+    _z_task_join(&task);
+    assert(_z_atomic_ring_pull(&ring, &elem) == _Z_RES_OK);
+    assert(elem == ELEM(0, 1));
+    assert(_z_atomic_ring_pull(&ring, &elem) == _Z_RES_CHANNEL_CLOSED);
+    _z_atomic_ring_clear(&ring, count_free);
+}
+
+int main(void) {
+    test_capacity();
+    test_force_drop();
+    test_spsc();
+    test_mpsc();
+    test_close();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_MULTI_THREAD\n");
+    return 0;
+}
+#endif
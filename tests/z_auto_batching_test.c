@@ -0,0 +1,259 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/assert_helpers.h"
+#include "zenoh-pico.h"
+#include "zenoh-pico/transport/transport.h"
+
+#if Z_FEATURE_AUTO_BATCHING == 1 && Z_FEATURE_MULTI_THREAD == 1 && Z_FEATURE_PUBLICATION == 1 && \
+    Z_FEATURE_SUBSCRIPTION == 1 && Z_FEATURE_MATCHING == 1 && Z_FEATURE_UNICAST_PEER == 1 &&       \
+    Z_FEATURE_LINK_TCP == 1
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#define KEYEXPR "zenoh-pico/tests/auto_batching"
+// The batching timer first runs when the session opens, then once per delay
+#define DELAY_US "2000000"
+#define DELAY_MS 2000
+// Never elapsed within a test, only the length and express bounds send a batch
+#define NEVER_US "60000000"
+#define TIMEOUT_S 10
+
+static z_owned_mutex_t mutex;
+static z_owned_condvar_t cond;
+static size_t received;
+static z_clock_t opened;
+static unsigned long first_received_ms;
+
+static void on_sample(z_loaned_sample_t *sample, void *arg) {
+    _ZP_UNUSED(sample);
+    _ZP_UNUSED(arg);
+    z_mutex_lock(z_loan_mut(mutex));
+    if (received++ == 0) {
+        first_received_ms = z_clock_elapsed_ms(&opened);
+    }
+    z_condvar_signal(z_loan_mut(cond));
+    z_mutex_unlock(z_loan_mut(mutex));
+}
+
+static size_t received_count(void) {
+    z_mutex_lock(z_loan_mut(mutex));
+    size_t count = received;
+    z_mutex_unlock(z_loan_mut(mutex));
+    return count;
+}
+
+static bool wait_for(size_t count) {
+    z_clock_t deadline = z_clock_now();
+    z_clock_advance_s(&deadline, TIMEOUT_S);
+    z_mutex_lock(z_loan_mut(mutex));
+    while (received < count) {
+        if (z_condvar_wait_until(z_loan_mut(cond), z_loan_mut(mutex), &deadline) == Z_ETIMEDOUT) {
+            break;
+        }
+    }
+    bool done = received >= count;
+    z_mutex_unlock(z_loan_mut(mutex));
+    return done;
+}
+
+// A TCP port on the loopback that nobody listens on, for the publishing session to listen on
+static uint16_t free_port(void) {
+#if defined(_WIN32)
+    WSADATA wsa;
+    ASSERT_TRUE(WSAStartup(MAKEWORD(2, 2), &wsa) == 0);
+    SOCKET fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_TRUE(fd != INVALID_SOCKET);
+    int len = sizeof(struct sockaddr_in);
+#else
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_TRUE(fd >= 0);
+    socklen_t len = sizeof(struct sockaddr_in);
+#endif
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    ASSERT_TRUE(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+    ASSERT_TRUE(getsockname(fd, (struct sockaddr *)&addr, &len) == 0);
+#if defined(_WIN32)
+    closesocket(fd);
+    WSACleanup();
+#else
+    close(fd);
+#endif
+    return ntohs(addr.sin_port);
+}
+
+typedef struct {
+    z_owned_session_t pub;
+    z_owned_session_t sub;
+    z_owned_publisher_t publisher;
+    z_owned_subscriber_t subscriber;
+} pair_t;
+
+// The publishing session batches automatically and listens, the subscribing one connects to it. Once the publisher
+// matches the subscriber, what it puts is sent to it.
+static void open_pair(pair_t *pair, const char *max_delay, const char *max_bytes) {
+    received = 0;
+    first_received_ms = 0;
+    char locator[32];
+    snprintf(locator, sizeof(locator), "tcp/127.0.0.1:%u", (unsigned)free_port());
+    z_owned_config_t c1, c2;
+    z_config_default(&c1);
+    z_config_default(&c2);
+    zp_config_insert(z_loan_mut(c1), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(c1), Z_CONFIG_LISTEN_KEY, locator);
+    zp_config_insert(z_loan_mut(c1), Z_CONFIG_AUTO_BATCHING_MAX_DELAY_KEY, max_delay);
+    zp_config_insert(z_loan_mut(c1), Z_CONFIG_AUTO_BATCHING_MAX_BYTES_KEY, max_bytes);
+    zp_config_insert(z_loan_mut(c2), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(c2), Z_CONFIG_CONNECT_KEY, locator);
+    opened = z_clock_now();
+    ASSERT_OK(z_open(&pair->pub, z_move(c1), NULL));
+    ASSERT_OK(z_open(&pair->sub, z_move(c2), NULL));
+
+    z_owned_closure_sample_t callback;
+    z_closure(&callback, on_sample, NULL, NULL);
+    z_view_keyexpr_t ke;
+    z_view_keyexpr_from_str(&ke, KEYEXPR);
+    ASSERT_OK(z_declare_subscriber(z_loan(pair->sub), &pair->subscriber, z_loan(ke), z_move(callback), NULL));
+    ASSERT_OK(z_declare_publisher(z_loan(pair->pub), &pair->publisher, z_loan(ke), NULL));
+    z_matching_status_t status = {.matching = false};
+    z_clock_t start = z_clock_now();
+    while (!status.matching) {
+        ASSERT_TRUE(z_clock_elapsed_s(&start) < TIMEOUT_S);
+        z_sleep_ms(5);
+        ASSERT_OK(z_publisher_get_matching_status(z_loan(pair->publisher), &status));
+    }
+}
+
+static void close_pair(pair_t *pair) {
+    z_drop(z_move(pair->publisher));
+    z_drop(z_move(pair->subscriber));
+    z_drop(z_move(pair->sub));
+    z_drop(z_move(pair->pub));
+}
+
+static void put(pair_t *pair, size_t len, bool is_express) {
+    uint8_t payload[256] = {0};
+    z_owned_bytes_t bytes;
+    ASSERT_OK(z_bytes_copy_from_buf(&bytes, payload, len));
+    if (!is_express) {
+        ASSERT_OK(z_publisher_put(z_loan(pair->publisher), z_move(bytes), NULL));
+        return;
+    }
+    z_view_keyexpr_t ke;
+    z_view_keyexpr_from_str(&ke, KEYEXPR);
+    z_put_options_t opts;
+    z_put_options_default(&opts);
+    opts.is_express = true;
+    ASSERT_OK(z_put(z_loan(pair->pub), z_loan(ke), z_move(bytes), &opts));
+}
+
+// Messages written to the batch of the publishing session, and not sent yet
+static size_t batched_count(pair_t *pair) {
+    _z_transport_common_t *ztc = _z_transport_get_common(&_Z_RC_IN_VAL(z_loan(pair->pub))->_tp);
+    _z_transport_tx_mutex_lock(ztc, true);
+    size_t count = ztc->_batch_count;
+    _z_transport_tx_mutex_unlock(ztc);
+    return count;
+}
+
+void test_delay_bound(void) {
+    printf("Test: a batched message is sent once the delay elapsed\n");
+    pair_t pair;
+    open_pair(&pair, DELAY_US, "0");
+    put(&pair, 8, false);
+    put(&pair, 8, false);
+    ASSERT_TRUE(wait_for(2));
+    // Sent by the timer, which doesn't run before a delay since the session opened
+    ASSERT_TRUE(first_received_ms >= DELAY_MS);
+    close_pair(&pair);
+}
+
+void test_length_bound(void) {
+    printf("Test: a batch is sent once it holds the maximum length\n");
+    pair_t pair;
+    open_pair(&pair, NEVER_US, "256");
+    // Three of them fill a batch
+    for (size_t i = 0; i < 7; i++) {
+        put(&pair, 100, false);
+    }
+    ASSERT_TRUE(wait_for(6));
+    // The last one waits in the batch, until an express message sends it
+    ASSERT_TRUE(batched_count(&pair) == 1);
+    ASSERT_TRUE(received_count() == 6);
+    put(&pair, 8, true);
+    ASSERT_TRUE(wait_for(8));
+    close_pair(&pair);
+}
+
+void test_express(void) {
+    printf("Test: an express message is sent right away with the batch\n");
+    pair_t pair;
+    open_pair(&pair, NEVER_US, "0");
+    put(&pair, 8, false);
+    ASSERT_TRUE(batched_count(&pair) == 1);
+    put(&pair, 8, true);
+    ASSERT_TRUE(wait_for(2));
+    close_pair(&pair);
+}
+
+void test_invalid_config(void) {
+    printf("Test: negative bounds are rejected\n");
+    char locator[32];
+    snprintf(locator, sizeof(locator), "tcp/127.0.0.1:%u", (unsigned)free_port());
+    z_owned_session_t s;
+    z_owned_config_t c;
+    z_config_default(&c);
+    zp_config_insert(z_loan_mut(c), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(c), Z_CONFIG_LISTEN_KEY, locator);
+    zp_config_insert(z_loan_mut(c), Z_CONFIG_AUTO_BATCHING_MAX_DELAY_KEY, "-1");
+    ASSERT_NOT_OK(z_open(&s, z_move(c), NULL));
+}
+
+int main(void) {
+    z_mutex_init(&mutex);
+    z_condvar_init(&cond);
+    test_delay_bound();
+    test_length_bound();
+    test_express();
+    test_invalid_config();
+    z_condvar_drop(z_move(cond));
+    z_mutex_drop(z_move(mutex));
+    return 0;
+}
+
+#else
+int main(void) {
+    printf(
+        "Missing config token to build this test. This test requires: Z_FEATURE_AUTO_BATCHING, "
+        "Z_FEATURE_MULTI_THREAD, Z_FEATURE_PUBLICATION, Z_FEATURE_SUBSCRIPTION, Z_FEATURE_MATCHING, "
+        "Z_FEATURE_UNICAST_PEER and Z_FEATURE_LINK_TCP\n");
+    return 0;
+}
+#endif
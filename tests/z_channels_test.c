@@ -180,6 +180,41 @@ void sample_ring_channel_test_over_size(void) {
     z_drop(z_move(handler));
 }
 
+void sample_channel_test_try_recv_many(void) {
+    z_owned_closure_sample_t closure;
+    z_owned_fifo_handler_sample_t handler;
+    z_fifo_channel_sample_new(&closure, &handler, 10);
+
+    z_owned_sample_t samples[8];
+    size_t received = 1;
+    assert(z_try_recv_many(z_loan(handler), samples, 8, &received) == Z_CHANNEL_NODATA);
+    assert(received == 0);
+
+    SEND(closure, "v1")
+    SEND(closure, "v22")
+    SEND(closure, "v333")
+    assert(z_try_recv_many(z_loan(handler), samples, 2, &received) == Z_OK);
+    assert(received == 2);
+    assert(z_try_recv_many(z_loan(handler), &samples[2], 6, &received) == Z_OK);
+    assert(received == 1);
+    const char *expected[] = {"v1", "v22", "v333"};
+    for (size_t i = 0; i < 3; i++) {
+        z_owned_slice_t value;
+        z_bytes_to_slice(z_sample_payload(z_loan(samples[i])), &value);
+        assert(z_slice_len(z_loan(value)) == strlen(expected[i]));
+        assert(strncmp((const char *)z_slice_data(z_loan(value)), expected[i], strlen(expected[i])) == 0);
+        z_drop(z_move(value));
+        z_drop(z_move(samples[i]));
+    }
+    // Entries past the received ones are left empty
+    assert(!z_internal_check(samples[3]));
+
+    z_drop(z_move(closure));
+    assert(z_try_recv_many(z_loan(handler), samples, 8, &received) == Z_CHANNEL_DISCONNECTED);
+    assert(received == 0);
+    z_drop(z_move(handler));
+}
+
 void zero_size_test(void) {
     z_owned_closure_sample_t closure;
 
@@ -201,5 +236,6 @@ int main(void) {
     sample_fifo_channel_test_try_recv();
     sample_ring_channel_test_in_size();
     sample_ring_channel_test_over_size();
+    sample_channel_test_try_recv_many();
     zero_size_test();
 }
@@ -21,6 +21,7 @@
 #include "zenoh-pico/collections/ring.h"
 #include "zenoh-pico/collections/sortedmap.h"
 #include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/collections/vec.h"
 
 #undef NDEBUG
 #include <assert.h>
@@ -769,6 +770,71 @@ void sorted_map_stress_test(void) {
     _z_str__z_str_sortedmap_clear(&map);
 }
 
+void sorted_map_skip_list_test(void) {
+    // Enough entries to spread over several levels, inserted in scattered order
+    _z_str__z_str_sortedmap_t map = _z_str__z_str_sortedmap_make();
+    char key[16];
+    for (int i = 0; i < 5000; i++) {
+        snprintf(key, sizeof(key), "%05d", (i * 7919) % 5000);
+        _z_str__z_str_sortedmap_insert(&map, _z_str_clone(key), _z_str_clone(key));
+    }
+    assert(_z_str__z_str_sortedmap_len(&map) == 5000);
+    for (int i = 0; i < 5000; i += 2) {
+        snprintf(key, sizeof(key), "%05d", i);
+        _z_str__z_str_sortedmap_remove(&map, key);
+    }
+    assert(_z_str__z_str_sortedmap_len(&map) == 2500);
+    for (int i = 0; i < 5000; i++) {
+        snprintf(key, sizeof(key), "%05d", i);
+        char *val = _z_str__z_str_sortedmap_get(&map, key);
+        assert((i % 2 == 0) ? (val == NULL) : (strcmp(val, key) == 0));
+    }
+    assert(strcmp(_z_str__z_str_sortedmap_first_key(&map), "00001") == 0);
+
+    _z_str__z_str_sortedmap_t clone = _z_str__z_str_sortedmap_clone(&map);
+    _z_str__z_str_sortedmap_clear(&map);
+    assert(_z_str__z_str_sortedmap_first_key(&map) == NULL);
+    int expected = 1;
+    _z_str__z_str_sortedmap_entry_t *entry = _z_str__z_str_sortedmap_pop_first(&clone);
+    while (entry != NULL) {
+        snprintf(key, sizeof(key), "%05d", expected);
+        assert(strcmp(_z_str__z_str_sortedmap_entry_key(entry), key) == 0);
+        _z_str__z_str_sortedmap_entry_free(&entry);
+        expected += 2;
+        entry = _z_str__z_str_sortedmap_pop_first(&clone);
+    }
+    assert(expected == 5001);
+    assert(_z_str__z_str_sortedmap_is_empty(&clone));
+    _z_str__z_str_sortedmap_clear(&clone);
+}
+
+void svec_alias_storage_test(void) {
+    int storage[2];
+    _z_svec_t vec = _z_svec_alias_storage(storage, 2);
+    assert(_z_svec_is_empty(&vec));
+    for (int i = 0; i < 2; i++) {
+        assert(_z_svec_append(&vec, &i, NULL, sizeof(int), false) == _Z_RES_OK);
+    }
+    // Still in the storage
+    assert(vec._val == storage && _z_svec_len(&vec) == 2);
+    // Moved out of the storage once full, which is left as is
+    int i = 2;
+    assert(_z_svec_append(&vec, &i, NULL, sizeof(int), false) == _Z_RES_OK);
+    assert(vec._val != storage && !vec._aliased && _z_svec_len(&vec) == 3);
+    for (i = 0; i < 3; i++) {
+        assert(*(int *)_z_svec_get(&vec, (size_t)i, sizeof(int)) == i);
+    }
+    assert(storage[0] == 0 && storage[1] == 1);
+    _z_svec_clear(&vec, NULL, sizeof(int));
+    assert(vec._val == NULL);
+
+    // Cleared without being freed while in the storage
+    vec = _z_svec_alias_storage(storage, 2);
+    assert(_z_svec_append(&vec, &i, NULL, sizeof(int), false) == _Z_RES_OK);
+    _z_svec_clear(&vec, NULL, sizeof(int));
+    assert(_z_svec_is_empty(&vec));
+}
+
 int main(void) {
     ring_test();
     ring_test_init_free();
@@ -783,6 +849,7 @@ int main(void) {
     ring_iterator_test();
 
     slist_test();
+    svec_alias_storage_test();
 
     sorted_map_iterator_test();
     sorted_map_iterator_deletion_test();
@@ -793,4 +860,5 @@ int main(void) {
     sorted_map_copy_move_test();
     sorted_map_free_test();
     sorted_map_stress_test();
+    sorted_map_skip_list_test();
 }
@@ -0,0 +1,258 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/common/defrag.h"
+#include "zenoh-pico/transport/common/tx.h"
+#include "zenoh-pico/transport/unicast/transport.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_FRAGMENTATION == 1
+
+static uint8_t data[Z_FRAG_MAX_SIZE];
+
+static void fill(_z_defrag_buf_t *dbuf, _z_defrag_pool_t *pool, size_t len) {
+    // Written in chunks, as fragments would be
+    size_t chunk = Z_FRAG_SLAB_SIZE / 3 + 1;
+    for (size_t off = 0; off < len; off += chunk) {
+        size_t n = (len - off < chunk) ? len - off : chunk;
+        assert(_z_defrag_buf_write(dbuf, pool, &data[off], n) == _Z_RES_OK);
+    }
+}
+
+static void check(const _z_defrag_buf_t *dbuf, size_t len) {
+    _z_zbuf_t zbf = _z_defrag_buf_as_zbuf(dbuf);
+    assert(_z_zbuf_readable_len(&zbf) == len);
+    assert(memcmp(_z_zbuf_get_rptr(&zbf), data, len) == 0);
+}
+
+void test_buffer_reuse(void) {
+    printf("Test: buffers are reused across messages\n");
+    _z_defrag_pool_t pool;
+    assert(_z_defrag_pool_init(&pool) == _Z_RES_OK);
+    _z_defrag_buf_t dbuf = _z_defrag_buf_null();
+    fill(&dbuf, &pool, Z_FRAG_SLAB_SIZE / 2);
+    check(&dbuf, Z_FRAG_SLAB_SIZE / 2);
+    uint8_t *buf = dbuf._buf;
+    size_t held = pool._held;
+    for (int i = 0; i < 16; i++) {
+        _z_defrag_buf_clear(&dbuf);
+        assert(_z_defrag_buf_len(&dbuf) == 0);
+        fill(&dbuf, &pool, Z_FRAG_SLAB_SIZE / 2);
+        assert(dbuf._buf == buf);
+        assert(pool._held == held);
+    }
+    // A reset keeps the buffer for the next message
+    _z_defrag_buf_reset(&dbuf);
+    fill(&dbuf, &pool, 8);
+    assert(dbuf._buf == buf);
+    check(&dbuf, 8);
+    _z_defrag_buf_clear(&dbuf);
+    _z_defrag_pool_clear(&pool);
+}
+
+void test_growth(void) {
+    printf("Test: large messages move to larger size classes\n");
+    _z_defrag_pool_t pool;
+    assert(_z_defrag_pool_init(&pool) == _Z_RES_OK);
+    _z_defrag_buf_t dbuf = _z_defrag_buf_null();
+    fill(&dbuf, &pool, Z_FRAG_MAX_SIZE);
+    check(&dbuf, Z_FRAG_MAX_SIZE);
+    assert(dbuf._class == pool._class_num - 1);
+    // Nothing fits past the largest class
+    assert(_z_defrag_buf_write(&dbuf, &pool, data, 1) == _Z_ERR_TRANSPORT_NO_SPACE);
+
+    // The smaller buffers were left idle and serve the next small message
+    _z_defrag_buf_t small = _z_defrag_buf_null();
+    size_t held = pool._held;
+    fill(&small, &pool, 16);
+    assert(small._class == 0);
+    assert(pool._held == held);
+    _z_defrag_buf_clear(&small);
+    _z_defrag_buf_clear(&dbuf);
+    _z_defrag_pool_clear(&pool);
+}
+
+void test_budget(void) {
+    printf("Test: messages past the budget are dropped and counted\n");
+    _z_defrag_pool_t pool;
+    assert(_z_defrag_pool_init(&pool) == _Z_RES_OK);
+    size_t num = (size_t)Z_FRAG_BUDGET / (size_t)Z_FRAG_MAX_SIZE;
+    _z_defrag_buf_t dbufs[16];
+    assert(num < sizeof(dbufs) / sizeof(dbufs[0]));
+    for (size_t i = 0; i < num; i++) {
+        dbufs[i] = _z_defrag_buf_null();
+        // Straight to the largest class
+        assert(_z_defrag_buf_write(&dbufs[i], &pool, data, Z_FRAG_MAX_SIZE) == _Z_RES_OK);
+    }
+    assert(pool._held <= (size_t)Z_FRAG_BUDGET);
+    _z_defrag_buf_t extra = _z_defrag_buf_null();
+    assert(_z_defrag_buf_write(&extra, &pool, data, Z_FRAG_MAX_SIZE) == _Z_ERR_TRANSPORT_NO_SPACE);
+    assert(extra._buf == NULL);
+    assert(_z_defrag_pool_get_stats(&pool)._budget_drops == 1);
+
+    // Once a message is released, its buffer serves the next one
+    uint8_t *released = dbufs[0]._buf;
+    _z_defrag_buf_clear(&dbufs[0]);
+    assert(_z_defrag_buf_write(&extra, &pool, data, Z_FRAG_MAX_SIZE) == _Z_RES_OK);
+    assert(extra._buf == released);
+    _z_defrag_buf_clear(&extra);
+
+    // Idle buffers of other classes are freed to make room
+    _z_defrag_buf_t small = _z_defrag_buf_null();
+    assert(_z_defrag_buf_write(&small, &pool, data, 1) == _Z_RES_OK);
+    _z_defrag_buf_clear(&small);
+    assert(_z_defrag_buf_write(&dbufs[0], &pool, data, Z_FRAG_MAX_SIZE) == _Z_RES_OK);
+    assert(pool._held <= (size_t)Z_FRAG_BUDGET);
+
+    _z_defrag_pool_count_sn_gap(&pool);
+    assert(_z_defrag_pool_get_stats(&pool)._sn_gap_drops == 1);
+    for (size_t i = 0; i < num; i++) {
+        _z_defrag_buf_clear(&dbufs[i]);
+    }
+    _z_defrag_pool_clear(&pool);
+    assert(pool._held == 0);
+}
+
+void test_copy(void) {
+    printf("Test: copies take their own buffer\n");
+    _z_defrag_pool_t pool;
+    assert(_z_defrag_pool_init(&pool) == _Z_RES_OK);
+    _z_defrag_buf_t src = _z_defrag_buf_null();
+    _z_defrag_buf_t dst;
+    assert(_z_defrag_buf_copy(&dst, &src) == _Z_RES_OK);
+    assert(dst._buf == NULL);
+    fill(&src, &pool, 100);
+    assert(_z_defrag_buf_copy(&dst, &src) == _Z_RES_OK);
+    assert(dst._buf != src._buf);
+    check(&dst, 100);
+    _z_defrag_buf_clear(&src);
+    _z_defrag_buf_clear(&dst);
+    _z_defrag_pool_clear(&pool);
+}
+
+#if Z_FEATURE_ALLOCATOR == 1
+#define SENDER_BATCH_SIZE 512
+#define SENDER_MESSAGES 64
+
+static size_t mallocs;
+
+static void *counting_allocate(size_t size, void *context) {
+    _ZP_UNUSED(context);
+    mallocs++;
+    return _z_platform_malloc(size);
+}
+
+static void *counting_reallocate(void *ptr, size_t size, void *context) {
+    _ZP_UNUSED(context);
+    mallocs++;
+    return _z_platform_realloc(ptr, size);
+}
+
+static void counting_deallocate(void *ptr, void *context) {
+    _ZP_UNUSED(context);
+    _z_platform_free(ptr);
+}
+
+static size_t discard_write(const _z_link_t *self, const uint8_t *ptr, size_t len, _z_sys_net_socket_t *socket) {
+    _ZP_UNUSED(self);
+    _ZP_UNUSED(ptr);
+    _ZP_UNUSED(socket);
+    return len;
+}
+
+static z_result_t discard_write_vec(const _z_link_t *self, const _z_socket_msg_t *msgs, size_t count,
+                                    _z_sys_net_socket_t *socket) {
+    _ZP_UNUSED(self);
+    _ZP_UNUSED(msgs);
+    _ZP_UNUSED(count);
+    _ZP_UNUSED(socket);
+    return _Z_RES_OK;
+}
+
+void test_sender_no_alloc(bool with_vec) {
+    printf("Test: sending fragments doesn't allocate, write vec %d\n", with_vec);
+    _z_session_t zn;
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    assert(_z_session_init(&zn, &zid) == _Z_RES_OK);
+    zn._mode = Z_WHATAMI_CLIENT;
+    _z_link_t *zl = (_z_link_t *)z_malloc(sizeof(_z_link_t));
+    assert(zl != NULL);
+    memset(zl, 0, sizeof(_z_link_t));
+    zl->_write_f = discard_write;
+    zl->_write_vec_f = with_vec ? discard_write_vec : NULL;
+    zl->_mtu = SENDER_BATCH_SIZE;
+    zl->_cap._flow = Z_LINK_CAP_FLOW_STREAM;
+    _z_transport_unicast_establish_param_t param = {0};
+    param._batch_size = SENDER_BATCH_SIZE;
+    param._seq_num_res = Z_SN_RESOLUTION;
+    param._lease = Z_TRANSPORT_LEASE;
+    assert(_z_unicast_transport_create(&zn._tp, zl, &param) == _Z_RES_OK);
+
+    _z_wireexpr_t key = {._id = 1, ._mapping = _Z_KEYEXPR_MAPPING_LOCAL, ._suffix = _z_string_view_null()};
+    _z_slice_t s = _z_slice_alias_buf(data, sizeof(data));
+    _z_bytes_t payload = _z_bytes_null();
+    assert(_z_bytes_from_slice(&payload, &s) == _Z_RES_OK);
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_put(&n_msg, &key, &payload, NULL, _z_n_qos_make(false, true, Z_PRIORITY_DATA), NULL, NULL,
+                           Z_RELIABILITY_RELIABLE, NULL);
+
+    zp_allocator_t allocator = {.allocate = counting_allocate,
+                                .reallocate = counting_reallocate,
+                                .deallocate = counting_deallocate};
+    assert(zp_set_allocator(&allocator) == _Z_RES_OK);
+    // The first message allocates the buffers of the transport
+    assert(_z_send_n_msg(&zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) == _Z_RES_OK);
+    mallocs = 0;
+    for (size_t i = 0; i < SENDER_MESSAGES; i++) {
+        assert(_z_send_n_msg(&zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) == _Z_RES_OK);
+    }
+    assert(mallocs == 0);
+    assert(zp_set_allocator(NULL) == _Z_RES_OK);
+    _z_bytes_clear(&payload);
+    _z_session_clear(&zn);
+}
+#endif
+
+int main(void) {
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 31 + 7);
+    }
+    test_buffer_reuse();
+    test_growth();
+    test_budget();
+    test_copy();
+#if Z_FEATURE_ALLOCATOR == 1
+    test_sender_no_alloc(false);
+    test_sender_no_alloc(true);
+#endif
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_FRAGMENTATION\n");
+    return 0;
+}
+#endif
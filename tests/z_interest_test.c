@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/session_fixture.h"
+
+#if Z_FEATURE_INTEREST == 1
+
+#define MANY 1000
+
+// Messages received by each interest, indexed by interest
+typedef struct {
+    size_t count[8];
+    uint32_t last_id;
+    bool last_complete;
+    _z_transport_peer_common_t *last_peer;
+} received_t;
+
+static received_t received[4];
+
+static void on_interest(const _z_interest_msg_t *msg, _z_transport_peer_common_t *peer, void *arg) {
+    received_t *r = *(received_t **)arg;
+    r->count[msg->type]++;
+    r->last_id = msg->id;
+    r->last_complete = msg->is_complete;
+    r->last_peer = peer;
+}
+
+// The records outlive the interests, only the box pointing to them is freed with the argument
+static void keep(void *arg) { _ZP_UNUSED(arg); }
+
+static void setup(void) {
+    setup_session();
+    memset(received, 0, sizeof(received));
+}
+
+static _z_session_interest_t interest_of(size_t i, const char *key, uint8_t flags) {
+    _z_session_interest_t intr = {0};
+    _z_string_t str = _z_string_alias_str(key);
+    assert(_z_keyexpr_copy_from_string(&intr._key, &str) == _Z_RES_OK);
+    intr._id = (uint32_t)(i + 1);
+    intr._callback = on_interest;
+    received_t **box = (received_t **)z_malloc(sizeof(received_t *));
+    assert(box != NULL);
+    *box = &received[i];
+    intr._arg = _z_void_rc_rc_new(box, keep);
+    assert(!_Z_RC_IS_NULL(&intr._arg));
+    intr._flags = flags;
+    return intr;
+}
+
+// Interests are given their index plus one as id, and record their messages at their index
+static _z_session_interest_rc_t *add_interest(size_t i, const char *key, uint8_t flags) {
+    _z_session_interest_t intr = interest_of(i, key, flags);
+    _z_session_interest_rc_t *rc = _z_register_interest(session, &intr);
+    assert(rc != NULL);
+    return rc;
+}
+
+void test_matching_interests(void) {
+    printf("Test: declarations reach the interests matching their key and kind\n");
+    setup();
+    add_interest(0, "a/**", _Z_INTEREST_FLAG_SUBSCRIBERS);
+    add_interest(1, "a/b", _Z_INTEREST_FLAG_SUBSCRIBERS | _Z_INTEREST_FLAG_AGGREGATE);
+    add_interest(2, "a/*", _Z_INTEREST_FLAG_SUBSCRIBERS | _Z_INTEREST_FLAG_AGGREGATE);
+    add_interest(3, "a/**", _Z_INTEREST_FLAG_QUERYABLES);
+
+    declare_subscriber("a/b", 1, &peer_a);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 1);
+    assert(received[0].last_id == 1 && received[0].last_peer == &peer_a);
+    // Aggregated interests only match their own key
+    assert(received[1].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 1);
+    assert(received[2].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 0);
+    assert(received[3].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 0);
+
+    // A wildcard declaration reaches the interests it intersects
+    declare_subscriber("*/c", 2, &peer_a);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 2);
+    assert(received[1].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 1);
+    declare_subscriber("d/e", 3, &peer_a);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 2);
+
+    _z_wireexpr_t expr = wireexpr_of("a/q");
+    declare(_z_make_decl_queryable(&expr, 1, true, 0), &peer_a, _z_optional_id_make_none());
+    assert(received[3].count[_Z_INTEREST_MSG_TYPE_DECL_QUERYABLE] == 1 && received[3].last_complete);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_DECL_QUERYABLE] == 0);
+
+    // The response to an interest only goes to that interest
+    declare_subscriber("a/f", 4, &peer_a);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 3);
+    declare(_z_make_decl_subscriber(&expr, 5), &peer_a, _z_optional_id_make_some(2));
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 3);
+
+    // Undeclared interests are no longer reached
+    _z_unregister_interest(session, _z_get_interest_by_id(session, 1));
+    declare_subscriber("a/g", 6, &peer_a);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 3);
+    cleanup_session();
+}
+
+void test_remote_declares(void) {
+    printf("Test: remote declarations are identified by their peer, kind and id\n");
+    setup();
+    add_interest(0, "**", _Z_INTEREST_FLAG_SUBSCRIBERS | _Z_INTEREST_FLAG_QUERYABLES);
+
+    // Entity ids are only unique per peer and kind
+    declare_subscriber("a/b", 1, &peer_a);
+    declare_subscriber("a/c", 1, &peer_b);
+    _z_wireexpr_t expr = wireexpr_of("a/d");
+    declare(_z_make_decl_queryable(&expr, 1, false, 0), &peer_a, _z_optional_id_make_none());
+    // A redeclaration updates the completeness of the queryable
+    declare(_z_make_decl_queryable(&expr, 1, true, 0), &peer_a, _z_optional_id_make_none());
+
+    assert(undeclare_subscriber(1, &peer_a) == _Z_RES_OK);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_UNDECL_SUBSCRIBER] == 1 && received[0].last_peer == &peer_a);
+    assert(undeclare_subscriber(1, &peer_a) == _Z_ERR_MESSAGE_ZENOH_DECLARATION_UNKNOWN);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_UNDECL_SUBSCRIBER] == 1);
+
+    // Replayed declarations carry their last state
+    memset(received, 0, sizeof(received));
+    _z_session_interest_t intr = interest_of(1, "a/d", _Z_INTEREST_FLAG_QUERYABLES);
+    _z_interest_replay_declare(session, &intr);
+    assert(received[1].count[_Z_INTEREST_MSG_TYPE_DECL_QUERYABLE] == 1 && received[1].last_complete);
+    assert(received[1].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 0);
+    _z_session_interest_clear(&intr);
+
+    assert(undeclare_subscriber(1, &peer_b) == _Z_RES_OK);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_UNDECL_SUBSCRIBER] == 1 && received[0].last_peer == &peer_b);
+    cleanup_session();
+}
+
+void test_many_declares(void) {
+    printf("Test: declarations of a disconnected peer are forgotten\n");
+    setup();
+    char key[32];
+    for (uint32_t i = 0; i < MANY; i++) {
+        snprintf(key, sizeof(key), "a/%u", (unsigned)i);
+        declare_subscriber(key, i, &peer_a);
+        declare_subscriber(key, i, &peer_b);
+    }
+    _z_session_interest_t intr = interest_of(0, "a/**", _Z_INTEREST_FLAG_SUBSCRIBERS);
+    _z_interest_replay_declare(session, &intr);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == 2 * MANY);
+
+    for (uint32_t i = 0; i < MANY; i += 2) {
+        assert(undeclare_subscriber(i, &peer_a) == _Z_RES_OK);
+    }
+    _z_interest_peer_disconnected(session, &peer_b);
+    memset(received, 0, sizeof(received));
+    _z_interest_replay_declare(session, &intr);
+    assert(received[0].count[_Z_INTEREST_MSG_TYPE_DECL_SUBSCRIBER] == MANY / 2);
+    assert(received[0].last_peer == &peer_a && (received[0].last_id % 2) == 1);
+    _z_session_interest_clear(&intr);
+    cleanup_session();
+}
+
+int main(void) {
+    test_matching_interests();
+    test_remote_declares();
+    test_many_declares();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_INTEREST\n");
+    return 0;
+}
+#endif
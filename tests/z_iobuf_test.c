@@ -610,6 +610,43 @@ void test_wbuf_wrap_bytes(void) {
     printf("Ok\n");
 }
 
+void test_wbuf_reset_initial(void) {
+    printf("Testing wbuf_reset_initial... ");
+    uint8_t val[VAL_SIZE];
+    memset(val, 0xaa, sizeof(val));
+    uint8_t payload[PAYLOAD_SIZE];
+    memset(payload, 0x55, sizeof(payload));
+    _z_wbuf_t wbf;
+    assert(_z_wbuf_init(&wbf, PAYLOAD_SIZE, true) == _Z_RES_OK);
+    for (size_t run = 0; run < 3; run++) {
+        // Wrapped data, then more than the room left in the first slice
+        assert(_z_wbuf_write_bytes(&wbf, val, 0, sizeof(val)) == _Z_RES_OK);
+        assert(_z_wbuf_wrap_bytes(&wbf, payload, 0, sizeof(payload)) == _Z_RES_OK);
+        for (size_t i = 0; i < 2 * PAYLOAD_SIZE; i++) {
+            assert(_z_wbuf_write(&wbf, (uint8_t)i) == _Z_RES_OK);
+        }
+        assert(_z_wbuf_len(&wbf) == sizeof(val) + sizeof(payload) + 2 * PAYLOAD_SIZE);
+        _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+        for (size_t i = 0; i < sizeof(val); i++) {
+            assert(_z_zbuf_read(&zbf) == 0xaa);
+        }
+        for (size_t i = 0; i < sizeof(payload); i++) {
+            assert(_z_zbuf_read(&zbf) == 0x55);
+        }
+        for (size_t i = 0; i < 2 * PAYLOAD_SIZE; i++) {
+            assert(_z_zbuf_read(&zbf) == (uint8_t)i);
+        }
+        _z_zbuf_clear(&zbf);
+        // Back to the first slice, with the room it lent to the wrapped data
+        _z_wbuf_reset_initial(&wbf);
+        assert(_z_iosli_svec_len(&wbf._ioss) == 1);
+        assert(_z_wbuf_capacity(&wbf) == PAYLOAD_SIZE);
+        assert(_z_wbuf_len(&wbf) == 0);
+    }
+    _z_wbuf_clear(&wbf);
+    printf("Ok\n");
+}
+
 /*=============================*/
 /*            Main             */
 /*=============================*/
@@ -635,4 +672,5 @@ int main(void) {
         wbuf_reusable_write_zbuf_read();
     }
     test_wbuf_wrap_bytes();
+    test_wbuf_reset_initial();
 }
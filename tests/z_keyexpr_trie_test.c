@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/keyexpr_trie.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof(array[0]))
+
+static const char *keys[] = {
+    "a",       "a/b",     "a/b/c",   "a/c",     "b/c",      "a/*",     "a/*/c",    "*/b",       "*",
+    "**",      "a/**",    "**/c",    "a/**/c",  "a/b/**",   "**/b/**", "a/b*",     "a/$*b",     "a/x$*",
+    "a/*/**",  "b/**/c",  "a/b/c/d", "x/y/z",   "x/**/z",   "**/z",    "a/ab/c",   "a/bb",      "$*",
+    "a/$*/c",  "c/**/**", "a/b/*/d", "*/*/*",   "**/a/**",  "x/$*z",   "a/b/c/**", "a/**/b/**", "@a/b",
+    "@a/**",   "a/@b",    "a/@b/**", "**/@b/c", "a/b/c/d/e"};
+
+typedef struct {
+    const void *seen[ARRAY_SIZE(keys) * 2];
+    size_t len;
+} collect_t;
+
+static z_result_t collect_cb(void *value, void *arg) {
+    collect_t *c = (collect_t *)arg;
+    for (size_t i = 0; i < c->len; i++) {
+        // A value is reported at most once per match
+        assert(c->seen[i] != value);
+    }
+    assert(c->len < ARRAY_SIZE(c->seen));
+    c->seen[c->len++] = value;
+    return _Z_RES_OK;
+}
+
+static z_result_t abort_cb(void *value, void *arg) {
+    (void)value;
+    size_t *count = (size_t *)arg;
+    (*count)++;
+    return _Z_ERR_GENERIC;
+}
+
+static _z_keyexpr_t ke(const char *s) {
+    _z_keyexpr_t k = {._keyexpr = _z_string_alias_str(s)};
+    return k;
+}
+
+static bool seen(const collect_t *c, const void *value) {
+    for (size_t i = 0; i < c->len; i++) {
+        if (c->seen[i] == value) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Check that the trie reports every value whose key intersects the queried one
+static void check_against_linear(_z_keyexpr_trie_t *trie, const bool *present) {
+    for (size_t q = 0; q < ARRAY_SIZE(keys); q++) {
+        _z_keyexpr_t query = ke(keys[q]);
+        collect_t c = {0};
+        assert(_z_keyexpr_trie_match(trie, &query, collect_cb, &c) == _Z_RES_OK);
+        for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+            _z_keyexpr_t k = ke(keys[i]);
+            bool expected = present[i] && _z_keyexpr_intersects(&k, &query);
+            if (expected && !seen(&c, keys[i])) {
+                printf("Missing %s for query %s\n", keys[i], keys[q]);
+                assert(false);
+            }
+            if (!present[i]) {
+                assert(!seen(&c, keys[i]));
+            }
+        }
+    }
+}
+
+void test_match(void) {
+    _z_keyexpr_trie_t trie;
+    _z_keyexpr_trie_init(&trie);
+    bool present[ARRAY_SIZE(keys)];
+    for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+        _z_keyexpr_t k = ke(keys[i]);
+        assert(_z_keyexpr_trie_insert(&trie, &k, (void *)keys[i]) == _Z_RES_OK);
+        present[i] = true;
+    }
+    assert(_z_keyexpr_trie_len(&trie) == ARRAY_SIZE(keys));
+    check_against_linear(&trie, present);
+
+    // Remove every other key and check again
+    for (size_t i = 0; i < ARRAY_SIZE(keys); i += 2) {
+        _z_keyexpr_t k = ke(keys[i]);
+        assert(_z_keyexpr_trie_remove(&trie, &k, keys[i]));
+        assert(!_z_keyexpr_trie_remove(&trie, &k, keys[i]));
+        present[i] = false;
+    }
+    check_against_linear(&trie, present);
+
+    _z_keyexpr_trie_clear(&trie);
+    assert(_z_keyexpr_trie_len(&trie) == 0);
+}
+
+void test_same_key(void) {
+    _z_keyexpr_trie_t trie;
+    _z_keyexpr_trie_init(&trie);
+    int values[3] = {0};
+    _z_keyexpr_t k = ke("a/*/c");
+    for (size_t i = 0; i < ARRAY_SIZE(values); i++) {
+        assert(_z_keyexpr_trie_insert(&trie, &k, &values[i]) == _Z_RES_OK);
+    }
+    _z_keyexpr_t query = ke("a/b/c");
+    collect_t c = {0};
+    assert(_z_keyexpr_trie_match(&trie, &query, collect_cb, &c) == _Z_RES_OK);
+    assert(c.len == 3);
+
+    assert(_z_keyexpr_trie_remove(&trie, &k, &values[1]));
+    c.len = 0;
+    assert(_z_keyexpr_trie_match(&trie, &query, collect_cb, &c) == _Z_RES_OK);
+    assert(c.len == 2);
+    assert(seen(&c, &values[0]) && seen(&c, &values[2]) && !seen(&c, &values[1]));
+
+    // Errors returned by the callback stop the traversal
+    size_t count = 0;
+    assert(_z_keyexpr_trie_match(&trie, &query, abort_cb, &count) == _Z_ERR_GENERIC);
+    assert(count == 1);
+
+    _z_keyexpr_trie_clear(&trie);
+}
+
+void test_prune(void) {
+    _z_keyexpr_trie_t trie;
+    _z_keyexpr_trie_init(&trie);
+    int value = 0;
+    _z_keyexpr_t k1 = ke("a/b/c/d");
+    _z_keyexpr_t k2 = ke("a/**/*/d");
+    assert(_z_keyexpr_trie_insert(&trie, &k1, &value) == _Z_RES_OK);
+    assert(_z_keyexpr_trie_insert(&trie, &k2, &value) == _Z_RES_OK);
+    assert(_z_keyexpr_trie_remove(&trie, &k1, &value));
+    assert(_z_keyexpr_trie_remove(&trie, &k2, &value));
+    assert(_z_keyexpr_trie_len(&trie) == 0);
+    // Every branch should have been freed
+    assert(_z_keyexpr_trie_children_hmap_is_empty(&trie._root._children));
+    assert(trie._root._star == NULL);
+    assert(trie._root._double_star == NULL);
+
+    _z_keyexpr_t unknown = ke("a/b");
+    assert(!_z_keyexpr_trie_remove(&trie, &unknown, &value));
+    _z_keyexpr_trie_clear(&trie);
+}
+
+int main(void) {
+    test_match();
+    test_same_key();
+    test_prune();
+    return 0;
+}
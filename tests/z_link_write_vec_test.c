@@ -0,0 +1,405 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/link/transport/tcp.h"
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/protocol/codec/transport.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/common/tx.h"
+#include "zenoh-pico/transport/unicast/transport.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if defined(ZP_PLATFORM_SOCKET_POSIX) && Z_FEATURE_LINK_TCP == 1 && Z_FEATURE_LINK_UDP_UNICAST == 1
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define BATCH_SIZE 256
+#define CAPTURE_SIZE 16384
+#define MAX_DATAGRAMS 128
+
+typedef struct {
+    uint8_t data[CAPTURE_SIZE];
+    size_t len;
+    size_t dgram_len[MAX_DATAGRAMS];
+    size_t dgram_count;
+    size_t calls;
+} capture_t;
+
+static capture_t capture;
+
+static void capture_append(const uint8_t *ptr, size_t len) {
+    assert(capture.len + len <= CAPTURE_SIZE);
+    memcpy(&capture.data[capture.len], ptr, len);
+    capture.len += len;
+}
+
+static size_t fake_write(const _z_link_t *self, const uint8_t *ptr, size_t len, _z_sys_net_socket_t *socket) {
+    (void)socket;
+    capture_append(ptr, len);
+    if (self->_cap._flow == Z_LINK_CAP_FLOW_DATAGRAM) {
+        assert(capture.dgram_count < MAX_DATAGRAMS);
+        capture.dgram_len[capture.dgram_count++] = len;
+    }
+    capture.calls++;
+    return len;
+}
+
+static z_result_t fake_write_vec(const _z_link_t *self, const _z_socket_msg_t *msgs, size_t count,
+                                 _z_sys_net_socket_t *socket) {
+    (void)socket;
+    for (size_t i = 0; i < count; i++) {
+        size_t len = 0;
+        for (size_t j = 0; j < msgs[i]._iov_len; j++) {
+            capture_append(msgs[i]._iov[j]._buf, msgs[i]._iov[j]._len);
+            len += msgs[i]._iov[j]._len;
+        }
+        if (self->_cap._flow == Z_LINK_CAP_FLOW_DATAGRAM) {
+            assert(len <= BATCH_SIZE);
+            assert(capture.dgram_count < MAX_DATAGRAMS);
+            capture.dgram_len[capture.dgram_count++] = len;
+        }
+    }
+    capture.calls++;
+    return _Z_RES_OK;
+}
+
+static void setup(_z_session_t *zn, bool is_stream, bool with_vec) {
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    assert(_z_session_init(zn, &zid) == _Z_RES_OK);
+    zn->_mode = Z_WHATAMI_CLIENT;
+
+    _z_link_t *zl = (_z_link_t *)z_malloc(sizeof(_z_link_t));
+    assert(zl != NULL);
+    memset(zl, 0, sizeof(_z_link_t));
+    zl->_write_f = fake_write;
+    zl->_write_vec_f = with_vec ? fake_write_vec : NULL;
+    zl->_mtu = BATCH_SIZE;
+    zl->_cap._flow = is_stream ? Z_LINK_CAP_FLOW_STREAM : Z_LINK_CAP_FLOW_DATAGRAM;
+
+    _z_transport_unicast_establish_param_t param = {0};
+    param._batch_size = BATCH_SIZE;
+    param._seq_num_res = Z_SN_RESOLUTION;
+    param._lease = Z_TRANSPORT_LEASE;
+    assert(_z_unicast_transport_create(&zn->_tp, zl, &param) == _Z_RES_OK);
+    memset(&capture, 0, sizeof(capture));
+}
+
+static void send_large_push(_z_session_t *zn, size_t payload_len, z_reliability_t reliability) {
+    uint8_t *buf = (uint8_t *)z_malloc(payload_len);
+    assert(buf != NULL);
+    for (size_t i = 0; i < payload_len; i++) {
+        buf[i] = (uint8_t)(i * 7);
+    }
+    _z_wireexpr_t key = {._id = 1, ._mapping = _Z_KEYEXPR_MAPPING_LOCAL, ._suffix = _z_string_view_null()};
+    _z_slice_t s = _z_slice_alias_buf(buf, payload_len);
+    _z_bytes_t payload = _z_bytes_null();
+    assert(_z_bytes_from_slice(&payload, &s) == _Z_RES_OK);
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_put(&n_msg, &key, &payload, NULL, _Z_N_QOS_DEFAULT, NULL, NULL, reliability, NULL);
+    assert(_z_send_n_msg(zn, &n_msg, reliability, Z_CONGESTION_CONTROL_BLOCK, NULL) == _Z_RES_OK);
+    _z_bytes_clear(&payload);
+    z_free(buf);
+}
+
+// Payload of many slices, each one wrapped in place as a slice of the fragmentation buffer
+static void send_sliced_push(_z_session_t *zn, size_t slice_num, size_t slice_len) {
+    uint8_t *buf = (uint8_t *)z_malloc(slice_num * slice_len);
+    assert(buf != NULL);
+    _z_bytes_t payload = _z_bytes_null();
+    for (size_t i = 0; i < slice_num * slice_len; i++) {
+        buf[i] = (uint8_t)(i * 7);
+    }
+    for (size_t i = 0; i < slice_num; i++) {
+        _z_slice_t s = _z_slice_alias_buf(&buf[i * slice_len], slice_len);
+        assert(_z_bytes_append_slice(&payload, &s) == _Z_RES_OK);
+    }
+    _z_wireexpr_t key = {._id = 1, ._mapping = _Z_KEYEXPR_MAPPING_LOCAL, ._suffix = _z_string_view_null()};
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_put(&n_msg, &key, &payload, NULL, _Z_N_QOS_DEFAULT, NULL, NULL, Z_RELIABILITY_RELIABLE, NULL);
+    assert(_z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) == _Z_RES_OK);
+    _z_bytes_clear(&payload);
+    z_free(buf);
+}
+
+static void send_small_push(_z_session_t *zn) {
+    _z_wireexpr_t key = {._id = 1, ._mapping = _Z_KEYEXPR_MAPPING_LOCAL, ._suffix = _z_string_view_null()};
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_del(&n_msg, &key, _Z_N_QOS_DEFAULT, NULL, Z_RELIABILITY_RELIABLE, NULL);
+    assert(_z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) == _Z_RES_OK);
+}
+
+static capture_t run_fragments(bool is_stream, bool with_vec) {
+    _z_session_t zn;
+    setup(&zn, is_stream, with_vec);
+    send_large_push(&zn, 5000, Z_RELIABILITY_RELIABLE);
+    capture_t ret = capture;
+    _z_session_clear(&zn);
+    return ret;
+}
+
+void test_fragment_train(bool is_stream) {
+    printf("Test: fragment train, %s link\n", is_stream ? "stream" : "datagram");
+    capture_t plain = run_fragments(is_stream, false);
+    capture_t vec = run_fragments(is_stream, true);
+    // Same bytes on the wire, in a fraction of the calls
+    assert(plain.len == vec.len);
+    assert(memcmp(plain.data, vec.data, plain.len) == 0);
+    assert(plain.dgram_count == vec.dgram_count);
+    for (size_t i = 0; i < plain.dgram_count; i++) {
+        assert(plain.dgram_len[i] == vec.dgram_len[i]);
+    }
+    assert(plain.calls > 16);
+    assert(vec.calls < plain.calls / 4);
+}
+
+void test_fragment_reliability(bool with_vec) {
+    printf("Test: reliability flag of fragments, %s\n", with_vec ? "vectored" : "copied");
+    const z_reliability_t reliabilities[] = {Z_RELIABILITY_RELIABLE, Z_RELIABILITY_BEST_EFFORT};
+    for (size_t r = 0; r < _ZP_ARRAY_SIZE(reliabilities); r++) {
+        _z_session_t zn;
+        setup(&zn, false, with_vec);
+        send_large_push(&zn, 1000, reliabilities[r]);
+        // Every fragment of the train is flagged reliable only for a reliable message
+        assert(capture.dgram_count > 1);
+        size_t pos = 0;
+        for (size_t i = 0; i < capture.dgram_count; i++) {
+            uint8_t header = capture.data[pos];
+            assert(_Z_MID(header) == _Z_MID_T_FRAGMENT);
+            assert(_Z_HAS_FLAG(header, _Z_FLAG_T_FRAGMENT_R) == (reliabilities[r] == Z_RELIABILITY_RELIABLE));
+            pos += capture.dgram_len[i];
+        }
+        _z_session_clear(&zn);
+    }
+}
+
+static capture_t run_sliced_fragments(bool with_vec, size_t slice_num) {
+    _z_session_t zn;
+    setup(&zn, false, with_vec);
+    send_sliced_push(&zn, slice_num, 40);
+    capture_t ret = capture;
+    _z_session_clear(&zn);
+    return ret;
+}
+
+void test_sliced_fragment_train(size_t slice_num) {
+    printf("Test: fragment train of a payload of %zu slices\n", slice_num);
+    capture_t plain = run_sliced_fragments(false, slice_num);
+    capture_t vec = run_sliced_fragments(true, slice_num);
+    assert(plain.len == vec.len);
+    assert(memcmp(plain.data, vec.data, plain.len) == 0);
+    assert(plain.dgram_count == vec.dgram_count);
+    for (size_t i = 0; i < plain.dgram_count; i++) {
+        assert(plain.dgram_len[i] == vec.dgram_len[i]);
+    }
+    assert(vec.calls <= plain.calls);
+}
+
+#if Z_FEATURE_BATCHING == 1
+static capture_t run_batch_then_fragments(bool batching) {
+    _z_session_t zn;
+    setup(&zn, false, true);
+    if (batching) {
+        assert(_z_transport_start_batching(&zn._tp) == _Z_RES_OK);
+    }
+    send_small_push(&zn);
+    // Payload filling a batch, then one that just fits in a batch of its own
+    send_large_push(&zn, BATCH_SIZE, Z_RELIABILITY_RELIABLE);
+    send_large_push(&zn, BATCH_SIZE - 32, Z_RELIABILITY_RELIABLE);
+    if (batching) {
+        assert(_z_transport_stop_batching(&zn._tp) == _Z_RES_OK);
+        assert(_z_send_n_batch(&zn, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    }
+    capture_t ret = capture;
+    _z_session_clear(&zn);
+    return ret;
+}
+
+void test_batch_then_fragments(void) {
+    printf("Test: pending batch is sent before the fragments of a large message\n");
+    capture_t plain = run_batch_then_fragments(false);
+    capture_t batched = run_batch_then_fragments(true);
+    assert(plain.len == batched.len);
+    assert(memcmp(plain.data, batched.data, plain.len) == 0);
+    assert(plain.dgram_count == batched.dgram_count);
+    // The small message, the fragments of the first large one, then the second one alone
+    assert(plain.dgram_count == 4);
+    assert(plain.dgram_len[1] == BATCH_SIZE && plain.dgram_len[3] <= BATCH_SIZE);
+}
+#endif
+
+static void fill_iov(uint8_t *data, size_t len, uint8_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (uint8_t)(seed + i);
+    }
+}
+
+void test_socket_write_vec(void) {
+    printf("Test: socket write vec\n");
+    int fds[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    _z_sys_net_socket_t sock = {._fd = fds[0]};
+
+    // More buffers than a single system call takes
+    enum { MSG_NUM = 40, IOV_PER_MSG = 3, BUF_LEN = 50 };
+    static uint8_t data[MSG_NUM * IOV_PER_MSG][BUF_LEN];
+    _z_socket_iovec_t iov[MSG_NUM * IOV_PER_MSG];
+    _z_socket_msg_t msgs[MSG_NUM];
+    for (size_t i = 0; i < MSG_NUM * IOV_PER_MSG; i++) {
+        fill_iov(data[i], BUF_LEN, (uint8_t)i);
+        iov[i] = (_z_socket_iovec_t){._buf = data[i], ._len = (i % 5 == 0) ? 0 : BUF_LEN};
+    }
+    for (size_t i = 0; i < MSG_NUM; i++) {
+        msgs[i] = (_z_socket_msg_t){._iov = &iov[i * IOV_PER_MSG], ._iov_len = IOV_PER_MSG};
+    }
+    assert(_z_socket_write_vec(&sock, msgs, MSG_NUM) == _Z_RES_OK);
+
+    static uint8_t expected[MSG_NUM * IOV_PER_MSG * BUF_LEN];
+    size_t expected_len = 0;
+    for (size_t i = 0; i < MSG_NUM * IOV_PER_MSG; i++) {
+        memcpy(&expected[expected_len], iov[i]._buf, iov[i]._len);
+        expected_len += iov[i]._len;
+    }
+    static uint8_t received[MSG_NUM * IOV_PER_MSG * BUF_LEN];
+    size_t received_len = 0;
+    while (received_len < expected_len) {
+        ssize_t rb = read(fds[1], &received[received_len], expected_len - received_len);
+        assert(rb > 0);
+        received_len += (size_t)rb;
+    }
+    assert(memcmp(expected, received, expected_len) == 0);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_socket_send_msgs(void) {
+    printf("Test: socket send msgs\n");
+    int fds[2];
+    assert(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) == 0);
+    _z_sys_net_socket_t sock = {._fd = fds[0]};
+
+    enum { MSG_NUM = 40, IOV_PER_MSG = 3, BUF_LEN = 20 };
+    static uint8_t data[MSG_NUM * IOV_PER_MSG][BUF_LEN];
+    _z_socket_iovec_t iov[MSG_NUM * IOV_PER_MSG];
+    _z_socket_msg_t msgs[MSG_NUM];
+    for (size_t i = 0; i < MSG_NUM * IOV_PER_MSG; i++) {
+        fill_iov(data[i], BUF_LEN, (uint8_t)i);
+        iov[i] = (_z_socket_iovec_t){._buf = data[i], ._len = BUF_LEN};
+    }
+    for (size_t i = 0; i < MSG_NUM; i++) {
+        msgs[i] = (_z_socket_msg_t){._iov = &iov[i * IOV_PER_MSG], ._iov_len = IOV_PER_MSG};
+    }
+    assert(_z_socket_send_msgs(&sock, msgs, MSG_NUM, NULL) == _Z_RES_OK);
+
+    // One datagram per message, its buffers back to back
+    for (size_t i = 0; i < MSG_NUM; i++) {
+        uint8_t dgram[IOV_PER_MSG * BUF_LEN + 1];
+        ssize_t rb = recv(fds[1], dgram, sizeof(dgram), 0);
+        assert(rb == IOV_PER_MSG * BUF_LEN);
+        for (size_t j = 0; j < IOV_PER_MSG; j++) {
+            assert(memcmp(&dgram[j * BUF_LEN], data[i * IOV_PER_MSG + j], BUF_LEN) == 0);
+        }
+    }
+    close(fds[0]);
+    close(fds[1]);
+}
+
+// Larger than what the socket buffers of a pair take while nothing reads it
+#define UNREAD_LEN (4 * 1024 * 1024)
+
+static void open_unread_pair(int fds[2]) {
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    for (size_t i = 0; i < 2; i++) {
+        assert(fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK) == 0);
+    }
+}
+
+// Read what was sent, the stream must then have been shut down
+static size_t drain_closed(int fd) {
+    uint8_t buf[4096];
+    size_t received = 0;
+    ssize_t rb;
+    while ((rb = read(fd, buf, sizeof(buf))) > 0) {
+        received += (size_t)rb;
+    }
+    assert(rb == 0);
+    return received;
+}
+
+void test_tcp_write_partial(void) {
+    printf("Test: tcp write timing out in the middle of a message\n");
+    int fds[2];
+    open_unread_pair(fds);
+    _z_sys_net_socket_t sock = {._fd = fds[0]};
+    static uint8_t data[UNREAD_LEN];
+    assert(_z_tcp_write(sock, data, sizeof(data)) == SIZE_MAX);
+    size_t received = drain_closed(fds[1]);
+    assert((received > 0) && (received < sizeof(data)));
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_socket_write_vec_partial(void) {
+    printf("Test: socket write vec timing out in the middle of the messages\n");
+    int fds[2];
+    open_unread_pair(fds);
+    _z_sys_net_socket_t sock = {._fd = fds[0]};
+    static uint8_t data[UNREAD_LEN];
+    _z_socket_iovec_t iov[2] = {{._buf = data, ._len = sizeof(data) / 2},
+                                {._buf = &data[sizeof(data) / 2], ._len = sizeof(data) / 2}};
+    _z_socket_msg_t msg = {._iov = iov, ._iov_len = 2};
+    assert(_z_socket_write_vec(&sock, &msg, 1) == _Z_ERR_TRANSPORT_TX_FAILED);
+    size_t received = drain_closed(fds[1]);
+    assert((received > 0) && (received < sizeof(data)));
+    close(fds[0]);
+    close(fds[1]);
+}
+
+int main(void) {
+    test_socket_write_vec();
+    test_tcp_write_partial();
+    test_socket_write_vec_partial();
+    test_socket_send_msgs();
+#if Z_FEATURE_FRAGMENTATION == 1
+    test_fragment_reliability(false);
+    test_fragment_reliability(true);
+    test_fragment_train(true);
+    test_fragment_train(false);
+    // Several fragments per link call, then more slices than a link call takes
+    test_sliced_fragment_train(40);
+    test_sliced_fragment_train(150);
+#if Z_FEATURE_BATCHING == 1
+    test_batch_then_fragments();
+#endif
+#endif
+    return 0;
+}
+
+#else
+int main(void) {
+    printf(
+        "Missing config token to build this test. This test requires: a posix socket platform, Z_FEATURE_LINK_TCP "
+        "and Z_FEATURE_LINK_UDP_UNICAST\n");
+    return 0;
+}
+#endif
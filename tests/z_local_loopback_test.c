@@ -73,6 +73,12 @@ static z_result_t z_send_override(_z_session_t *zn, const _z_network_message_t *
     return _Z_RES_OK;
 }
 
+static _z_pending_query_t *first_pending_query(void) {
+    _z_pending_query_hmap_iter_t it = _z_pending_query_hmap_begin(&g_session._pending_queries);
+    assert(it != _z_pending_query_hmap_end(&g_session._pending_queries));
+    return _z_pending_query_hmap_at(&g_session._pending_queries, it)->val;
+}
+
 static void local_sample_callback(_z_sample_t *sample, void *arg) {
     _ZP_UNUSED(sample);
     atomic_fetch_add_explicit((atomic_uint *)arg, 1, memory_order_relaxed);
@@ -349,7 +355,7 @@ static void test_query_local_only_single(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, &queryable_rc);
     cleanup_local_resource(&keyexpr);
@@ -398,7 +404,7 @@ static void test_query_local_only_with_attachment(void) {
     assert(atomic_load_explicit(&g_query_attachment_ok_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, &queryable_rc);
     cleanup_local_resource(&keyexpr);
@@ -511,7 +517,7 @@ static void test_query_local_only_multiple(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, &queryable_secondary);
     _z_unregister_session_queryable(&g_session, &queryable_primary);
@@ -546,7 +552,7 @@ static void test_query_local_and_remote(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     atomic_store_explicit(&g_local_query_delivery_count, 0, memory_order_relaxed);
     atomic_store_explicit(&g_query_reply_callback_count, 0, memory_order_relaxed);
@@ -564,10 +570,10 @@ static void test_query_local_and_remote(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries != NULL);
+    assert(!_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     // Simulate REPLY from remote queryable
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     _z_zint_t request_id = pq->_id;
 
     const char remote_data[] = "remote-response";
@@ -590,7 +596,7 @@ static void test_query_local_and_remote(void) {
     // will be delivered on RESPONSE_FINAL
     assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries != NULL);
+    assert(!_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     // Receiving RESPONSE_FINAL from remote queryable
     _z_network_message_t final_msg;
@@ -601,7 +607,7 @@ static void test_query_local_and_remote(void) {
     // Remote reply delivered, query finalized
     assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, &queryable_primary);
     cleanup_local_resource(&keyexpr);
@@ -650,7 +656,7 @@ static void test_query_local_and_remote_via_api(void) {
                 z_move(r_closure), &gopt);
     assert(res == Z_OK);
 
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     assert(pq != NULL);
     _z_zint_t request_id = pq->_id;
 
@@ -678,7 +684,7 @@ static void test_query_local_and_remote_via_api(void) {
 
     assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     z_moved_queryable_t *mq = z_queryable_move(&queryable);
     z_queryable_drop(mq);
@@ -768,13 +774,13 @@ static void test_query_remote_only_destination(void) {
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
 
     // Clean pending query by simulating RESPONSE_FINAL
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     assert(pq != NULL);
     _z_network_message_t final_msg;
     _z_n_msg_make_response_final(&final_msg, pq->_id);
     res = _z_handle_network_message(&g_fake_transport, &final_msg, NULL);
     assert(res == _Z_RES_OK);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, &queryable_rc);
     cleanup_local_resource(&keyexpr);
@@ -802,7 +808,7 @@ static void test_queryable_remote_only_origin(void) {
     assert(atomic_load_explicit(&g_local_query_delivery_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
 
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     assert(pq != NULL);
     _z_network_message_t final_msg2;
     _z_n_msg_make_response_final(&final_msg2, pq->_id);
@@ -815,6 +821,56 @@ static void test_queryable_remote_only_origin(void) {
     cleanup_session();
 }
 
+#if Z_FEATURE_RX_CACHE == 1
+static void put_local(const _z_declared_keyexpr_t *keyexpr) {
+    const char payload_data[] = "payload";
+    _z_bytes_t payload;
+    assert(_z_bytes_copy_from_buf(&payload, (const uint8_t *)payload_data, sizeof(payload_data) - 1) == _Z_RES_OK);
+    _z_n_qos_t qos = _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT);
+    assert(_z_session_deliver_push_locally(&g_session, &keyexpr->_inner, &payload, NULL, Z_SAMPLE_KIND_PUT, qos, NULL,
+                                           NULL, Z_RELIABILITY_RELIABLE, NULL) == _Z_RES_OK);
+    _z_bytes_clear(&payload);
+}
+
+static void test_put_local_rx_cache(void) {
+    setup_session();
+    _z_declared_keyexpr_t keyexpr = create_local_resource("zenoh-pico/tests/local/put/cache");
+    _z_subscription_rc_t sub1 = register_local_subscription(&keyexpr, &g_local_put_delivery_count, Z_LOCALITY_ANY);
+    atomic_store_explicit(&g_local_put_delivery_count, 0, memory_order_relaxed);
+
+    // First sample populates the cache, the following ones hit it
+    put_local(&keyexpr);
+    put_local(&keyexpr);
+    put_local(&keyexpr);
+    assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 3);
+    _z_subscription_cache_stats_t stats = _z_get_subscription_cache_stats(&g_session);
+    assert(stats._misses == 1);
+    assert(stats._hits == 2);
+
+    // A new subscription invalidates the cache
+    _z_subscription_rc_t sub2 = register_local_subscription(&keyexpr, &g_local_put_delivery_count, Z_LOCALITY_ANY);
+    atomic_store_explicit(&g_local_put_delivery_count, 0, memory_order_relaxed);
+    put_local(&keyexpr);
+    put_local(&keyexpr);
+    assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 4);
+    stats = _z_get_subscription_cache_stats(&g_session);
+    assert(stats._misses == 2);
+    assert(stats._hits == 3);
+
+    // So does removing one
+    _z_unregister_subscription(&g_session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub1);
+    atomic_store_explicit(&g_local_put_delivery_count, 0, memory_order_relaxed);
+    put_local(&keyexpr);
+    assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 1);
+    stats = _z_get_subscription_cache_stats(&g_session);
+    assert(stats._misses == 3);
+
+    _z_unregister_subscription(&g_session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub2);
+    cleanup_local_resource(&keyexpr);
+    cleanup_session();
+}
+#endif
+
 int main(void) {
     test_put_local_only_single();
     test_put_local_only_via_api();
@@ -830,6 +886,9 @@ int main(void) {
     test_subscriber_remote_only_origin();
     test_query_remote_only_destination();
     test_queryable_remote_only_origin();
+#if Z_FEATURE_RX_CACHE == 1
+    test_put_local_rx_cache();
+#endif
     return 0;
 }
 
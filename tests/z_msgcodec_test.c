@@ -149,6 +149,9 @@ void print_transport_message_type(uint8_t header) {
         case _Z_MID_T_KEEP_ALIVE:
             printf("KeepAlive message");
             break;
+        case _Z_MID_T_OAM:
+            printf("OAM message");
+            break;
         case _Z_MID_T_FRAME:
             printf("Frame message");
             break;
@@ -1537,6 +1540,31 @@ void push_message(void) {
     _z_wbuf_clear(&wbf);
 }
 
+void push_prefix_message(void) {
+    printf("\n>> Push message with an encoded prefix\n");
+    _z_n_msg_push_t msg = gen_push();
+    msg._timestamp = _z_timestamp_null();
+    _z_wbuf_t expected = gen_wbuf(UINT16_MAX);
+    assert(_z_push_encode(&expected, &msg) == _Z_RES_OK);
+    _z_slice_t prefix = _z_slice_null();
+    assert(_z_push_prefix_encode(&prefix, &msg._key, msg._qos) == _Z_RES_OK);
+    msg._prefix = &prefix;
+    _z_wbuf_t wbf = gen_wbuf(UINT16_MAX);
+    assert(_z_push_encode(&wbf, &msg) == _Z_RES_OK);
+    assert(_z_push_encoded_len(&msg) == _z_wbuf_len(&expected));
+    assert(_z_wbuf_len(&wbf) == _z_wbuf_len(&expected));
+    _z_zbuf_t left = _z_wbuf_to_zbuf(&expected);
+    _z_zbuf_t right = _z_wbuf_to_zbuf(&wbf);
+    for (size_t i = 0; i < _z_wbuf_len(&expected); i++) {
+        assert(_z_zbuf_read(&left) == _z_zbuf_read(&right));
+    }
+    _z_zbuf_clear(&left);
+    _z_zbuf_clear(&right);
+    _z_slice_clear(&prefix);
+    _z_wbuf_clear(&wbf);
+    _z_wbuf_clear(&expected);
+}
+
 _z_n_msg_request_t gen_request(void) {
     _z_qos_t qos_default = {._val = 5};
     _z_n_msg_request_t request = {
@@ -1773,7 +1801,15 @@ _z_transport_message_t gen_join(void) {
         conduit._val._plain._best_effort = gen_zint();
         conduit._val._plain._reliable = gen_zint();
     }
-    return _z_t_msg_make_join(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zint(), gen_zid(), conduit);
+    _z_transport_message_t t_msg =
+        _z_t_msg_make_join(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zint(), gen_zid(), conduit);
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    t_msg._body._join._repair = gen_bool();
+    if (t_msg._body._join._repair) {
+        _Z_SET_FLAG(t_msg._header, _Z_FLAG_T_Z);
+    }
+#endif
+    return t_msg;
 }
 void assert_eq_join(const _z_t_msg_join_t *left, const _z_t_msg_join_t *right) {
     assert(memcmp(left->_zid.id, right->_zid.id, 16) == 0);
@@ -1793,6 +1829,9 @@ void assert_eq_join(const _z_t_msg_join_t *left, const _z_t_msg_join_t *right) {
         assert(left->_next_sn._val._plain._best_effort == right->_next_sn._val._plain._best_effort);
         assert(left->_next_sn._val._plain._reliable == right->_next_sn._val._plain._reliable);
     }
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1
+    assert(left->_repair == right->_repair);
+#endif
 }
 void join_message(void) {
     printf("\n>> Join message\n");
@@ -1903,6 +1942,42 @@ void keep_alive_message(void) {
     _z_zbuf_clear(&zbf);
     _z_wbuf_clear(&wbf);
 }
+_z_transport_message_t gen_t_oam(void) {
+    if (gen_bool()) {
+        return _z_t_msg_make_nack(gen_zid(), gen_zint());
+    } else {
+        return _z_t_msg_make_acknack(gen_zint(), gen_zint());
+    }
+}
+void assert_eq_t_oam(const _z_t_msg_oam_t *left, const _z_t_msg_oam_t *right) {
+    assert(left->_id == right->_id);
+    switch (left->_id) {
+        case _Z_T_OAM_ID_NACK:
+            assert(memcmp(left->_body._nack._zid.id, right->_body._nack._zid.id, 16) == 0);
+            assert(left->_body._nack._sn == right->_body._nack._sn);
+            break;
+        case _Z_T_OAM_ID_ACKNACK:
+            assert(left->_body._acknack._first_sn == right->_body._acknack._first_sn);
+            assert(left->_body._acknack._next_sn == right->_body._acknack._next_sn);
+            break;
+        default:
+            assert(false);
+    }
+}
+void t_oam_message(void) {
+    printf("\n>> transport OAM message\n");
+    _z_wbuf_t wbf = gen_wbuf(UINT16_MAX);
+    _z_transport_message_t expected = gen_t_oam();
+    assert(_z_t_oam_encode(&wbf, expected._header, &expected._body._oam) == _Z_RES_OK);
+    _z_t_msg_oam_t decoded = {0};
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+    z_result_t ret = _z_t_oam_decode(&decoded, &zbf, expected._header);
+    assert(_Z_RES_OK == ret);
+    assert_eq_t_oam(&expected._body._oam, &decoded);
+    _z_zbuf_clear(&zbf);
+    _z_wbuf_clear(&wbf);
+}
+
 _z_network_message_t gen_net_msg(void) {
     switch (gen_uint8() % 6) {
         default:
@@ -1964,6 +2039,22 @@ _z_network_message_vec_t gen_net_msgs(size_t n) {
     return ret;
 }
 
+void network_message_encoded_len(void) {
+    printf("\n>> Network message encoded length\n");
+    for (size_t i = 0; i < 64; i++) {
+        _z_network_message_t msg;
+        if (i % 8 == 0) {
+            msg = (_z_network_message_t){._tag = _Z_N_OAM, ._body._oam = gen_oam()};
+        } else {
+            msg = gen_net_msg();
+        }
+        _z_wbuf_t wbf = gen_wbuf(UINT16_MAX);
+        assert(_z_network_message_encode(&wbf, &msg) == _Z_RES_OK);
+        assert(_z_network_message_encoded_len(&msg) == _z_wbuf_len(&wbf));
+        _z_wbuf_clear(&wbf);
+    }
+}
+
 _z_transport_message_t gen_frame(_z_wbuf_t *wbf, _z_zbuf_t *zbf, const _z_network_message_vec_t *nmsgs) {
     // Generate payload
     const _z_network_message_t *msg = NULL;
@@ -2028,7 +2119,7 @@ void fragment_message(void) {
 }
 
 _z_transport_message_t gen_transport(void) {
-    switch (gen_uint8() % 5) {
+    switch (gen_uint8() % 6) {
         case 0: {
             return gen_join();
         };
@@ -2041,10 +2132,13 @@ _z_transport_message_t gen_transport(void) {
         case 3: {
             return gen_close();
         };
-        default:
         case 4: {
             return gen_keep_alive();
         };
+        default:
+        case 5: {
+            return gen_t_oam();
+        };
     }
 }
 void assert_eq_transport(const _z_transport_message_t *left, const _z_transport_message_t *right) {
@@ -2065,6 +2159,9 @@ void assert_eq_transport(const _z_transport_message_t *left, const _z_transport_
         case _Z_MID_T_KEEP_ALIVE: {
             assert_eq_keep_alive(&left->_body._keep_alive, &right->_body._keep_alive);
         } break;
+        case _Z_MID_T_OAM: {
+            assert_eq_t_oam(&left->_body._oam, &right->_body._oam);
+        } break;
         default:
             assert(false);
     }
@@ -2317,10 +2414,12 @@ int main(void) {
 
         // Network messages
         push_message();
+        push_prefix_message();
         request_message();
         response_message();
         response_final_message();
         oam_message();
+        network_message_encoded_len();
 
         // Transport messages
         join_message();
@@ -2328,6 +2427,7 @@ int main(void) {
         open_message();
         close_message();
         keep_alive_message();
+        t_oam_message();
         frame_message();
         fragment_message();
         transport_message();
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/link/link.h"
+#include "zenoh-pico/protocol/definitions/transport.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_MULTICAST_RELIABILITY == 1 && Z_FEATURE_SUBSCRIPTION == 1 && Z_FEATURE_PUBLICATION == 1 && \
+    Z_FEATURE_FRAGMENTATION == 1 && Z_FEATURE_MULTI_THREAD == 1 && defined(Z_TEST_HOOKS)
+
+#define KEYEXPR "test/multicast/reliability"
+#define SMALL_NUM 200
+#define LARGE_NUM 5
+#define LARGE_SIZE 3000
+#define TIMEOUT_MS 20000
+// Datagrams dropped at most, the peer goes back to the first lost one for each of them
+#define DROP_MAX 40
+
+// Reliable datagrams received, and the ones dropped out of them
+static volatile size_t reliable_datagrams = 0;
+static volatile size_t dropped = 0;
+static volatile bool lossy = false;
+
+static volatile uint32_t received = 0;
+static volatile bool out_of_order = false;
+
+// Drops every 7th reliable frame or fragment, retransmissions included, until DROP_MAX are dropped
+static bool drop_datagram(const _z_link_t *link, const uint8_t *buf, size_t len) {
+    (void)link;
+    if (!lossy || (len == 0) || (dropped >= DROP_MAX)) {
+        return false;
+    }
+    uint8_t mid = _Z_MID(buf[0]);
+    if (((mid != _Z_MID_T_FRAME) && (mid != _Z_MID_T_FRAGMENT)) || !_Z_HAS_FLAG(buf[0], _Z_FLAG_T_FRAME_R)) {
+        return false;
+    }
+    if ((reliable_datagrams++ % 7) != 3) {
+        return false;
+    }
+    dropped++;
+    return true;
+}
+
+static size_t sample_size(uint32_t idx) { return (idx < SMALL_NUM) ? sizeof(uint32_t) : LARGE_SIZE; }
+
+static void fill(uint8_t *buf, uint32_t idx) {
+    memcpy(buf, &idx, sizeof(idx));
+    for (size_t i = sizeof(idx); i < sample_size(idx); i++) {
+        buf[i] = (uint8_t)(idx + i);
+    }
+}
+
+static void on_sample(z_loaned_sample_t *sample, void *arg) {
+    (void)arg;
+    static uint8_t expected[LARGE_SIZE];
+    static uint8_t data[LARGE_SIZE];
+    uint32_t idx = received;
+    const z_loaned_bytes_t *payload = z_sample_payload(sample);
+    size_t len = z_bytes_len(payload);
+    z_bytes_reader_t reader = z_bytes_get_reader(payload);
+    fill(expected, idx);
+    if ((len != sample_size(idx)) || (z_bytes_reader_read(&reader, data, len) != len) ||
+        (memcmp(data, expected, len) != 0)) {
+        printf("Sample %u received out of order\n", (unsigned)idx);
+        out_of_order = true;
+    }
+    received++;
+}
+
+static void publish(const z_loaned_publisher_t *pub, uint32_t idx) {
+    static uint8_t buf[LARGE_SIZE];
+    fill(buf, idx);
+    z_owned_bytes_t payload;
+    assert(z_bytes_copy_from_buf(&payload, buf, sample_size(idx)) == _Z_RES_OK);
+    assert(z_publisher_put(pub, z_move(payload), NULL) == _Z_RES_OK);
+}
+
+static void open_peer(z_owned_session_t *s) {
+    z_owned_config_t c;
+    z_config_default(&c);
+    zp_config_insert(z_loan_mut(c), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(c), Z_CONFIG_LISTEN_KEY, "udp/224.0.0.224:7449#iface=lo");
+    assert(z_open(s, z_move(c), NULL) == _Z_RES_OK);
+}
+
+void test_lossy_link(void) {
+    printf("Test: reliable samples lost on a multicast link are retransmitted and delivered in order\n");
+    _z_link_set_recv_drop_override(drop_datagram);
+    z_owned_session_t s1;
+    z_owned_session_t s2;
+    open_peer(&s1);
+    open_peer(&s2);
+
+    z_view_keyexpr_t ke;
+    assert(z_view_keyexpr_from_str(&ke, KEYEXPR) == _Z_RES_OK);
+    z_owned_closure_sample_t callback;
+    z_closure(&callback, on_sample, NULL, NULL);
+    z_owned_subscriber_t sub;
+    assert(z_declare_subscriber(z_loan(s1), &sub, z_loan(ke), z_move(callback), NULL) == _Z_RES_OK);
+    // Samples are not dropped at the publisher while it retransmits
+    z_publisher_options_t opts;
+    z_publisher_options_default(&opts);
+    opts.congestion_control = Z_CONGESTION_CONTROL_BLOCK;
+    z_owned_publisher_t pub;
+    assert(z_declare_publisher(z_loan(s2), &pub, z_loan(ke), &opts) == _Z_RES_OK);
+    // Both peers know each other from their JOIN
+    z_sleep_s(3);
+
+    lossy = true;
+    for (uint32_t i = 0; i < SMALL_NUM + LARGE_NUM; i++) {
+        publish(z_loan(pub), i);
+        if ((i % 20) == 0) {
+            z_sleep_ms(1);
+        }
+    }
+    z_clock_t start = z_clock_now();
+    while ((received < SMALL_NUM + LARGE_NUM) && !out_of_order && (z_clock_elapsed_ms(&start) < TIMEOUT_MS)) {
+        z_sleep_ms(10);
+    }
+    lossy = false;
+    printf("Received %u samples, %zu reliable datagrams dropped\n", (unsigned)received, (size_t)dropped);
+    assert(!out_of_order);
+    assert(received == SMALL_NUM + LARGE_NUM);
+    assert(dropped > 0);
+
+    zp_multicast_repair_stats_t tx_stats;
+    assert(zp_multicast_repair_stats(z_loan(s2), &tx_stats) == _Z_RES_OK);
+    printf("Publisher: %zu NACKs, %zu datagrams retransmitted\n", tx_stats.nacks, tx_stats.retransmitted);
+    assert(tx_stats.nacks > 0 && tx_stats.retransmitted > 0 && tx_stats.unrecoverable == 0);
+
+    z_id_t pub_zid = z_info_zid(z_loan(s2));
+    zp_multicast_peer_repair_stats_t rx_stats;
+    assert(zp_multicast_peer_repair_stats(z_loan(s1), &pub_zid, &rx_stats) == _Z_RES_OK);
+    printf("Subscriber: %zu gaps, %zu repaired, %zu lost, %zu NACKs sent, %zu suppressed\n", rx_stats.gaps,
+           rx_stats.repaired, rx_stats.lost, rx_stats.nacks_sent, rx_stats.nacks_suppressed);
+    assert(rx_stats.active);
+    assert(rx_stats.gaps > 0 && rx_stats.repaired > 0 && rx_stats.nacks_sent > 0);
+    assert(rx_stats.lost == 0);
+
+    z_id_t unknown_zid = {0};
+    assert(zp_multicast_peer_repair_stats(z_loan(s1), &unknown_zid, &rx_stats) != _Z_RES_OK);
+
+    _z_link_set_recv_drop_override(NULL);
+    z_drop(z_move(pub));
+    z_drop(z_move(sub));
+    z_drop(z_move(s2));
+    z_drop(z_move(s1));
+}
+
+int main(void) {
+    test_lossy_link();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf(
+        "Missing config token to build this test. This test requires: Z_FEATURE_MULTICAST_RELIABILITY, "
+        "Z_FEATURE_SUBSCRIPTION, Z_FEATURE_PUBLICATION, Z_FEATURE_FRAGMENTATION, Z_FEATURE_MULTI_THREAD and "
+        "Z_TEST_HOOKS\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,253 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/session_fixture.h"
+#include "zenoh-pico/session/peer_routing.h"
+#include "zenoh-pico/transport/common/tx.h"
+#include "zenoh-pico/transport/unicast/transport.h"
+
+#if Z_FEATURE_PEER_ROUTING == 1
+
+// Declarations are also received from it, its kind matters
+static _z_transport_peer_common_t router;
+
+static void lookup_push(const char *key, _z_peer_route_t *route) {
+    _z_network_message_t msg = {0};
+    msg._tag = _Z_N_PUSH;
+    msg._body._push._key = wireexpr_of(key);
+    _z_peer_route_table_lookup(session, &msg, route);
+}
+
+static void lookup_query(const char *key, _z_peer_route_t *route) {
+    _z_network_message_t msg = {0};
+    msg._tag = _Z_N_REQUEST;
+    msg._body._request._tag = _Z_REQUEST_QUERY;
+    msg._body._request._key = wireexpr_of(key);
+    _z_peer_route_table_lookup(session, &msg, route);
+}
+
+void test_route(void) {
+    printf("Test: a route lists each of its peers once\n");
+    _z_peer_route_t route = _z_peer_route_null();
+    _z_peer_route_t copy = _z_peer_route_null();
+    assert(_z_peer_route_includes(&route, &peer_a));
+
+    _z_peer_route_reset(&route, true, false);
+    assert(!_z_peer_route_includes(&route, &peer_a) && !_z_peer_route_includes(&route, &router));
+    assert(_z_peer_route_add(&route, &peer_b) == _Z_RES_OK);
+    assert(_z_peer_route_add(&route, &peer_a) == _Z_RES_OK);
+    assert(_z_peer_route_add(&route, &peer_b) == _Z_RES_OK);
+    assert(route._len == 2);
+    assert(_z_peer_route_includes(&route, &peer_a) && _z_peer_route_includes(&route, &peer_b));
+    assert(!_z_peer_route_includes(&route, &router));
+
+    assert(_z_peer_route_copy(&copy, &route) == _Z_RES_OK);
+    assert(_z_peer_route_eq(&copy, &route));
+    copy._routers = true;
+    assert(!_z_peer_route_eq(&copy, &route));
+    assert(_z_peer_route_includes(&copy, &router));
+    _z_peer_route_reset(&copy, true, false);
+    assert(_z_peer_route_add(&copy, &peer_a) == _Z_RES_OK);
+    assert(!_z_peer_route_eq(&copy, &route));
+    _z_peer_route_reset(&copy, false, true);
+    _z_peer_route_reset(&route, false, false);
+    assert(_z_peer_route_eq(&copy, &route));
+
+    _z_peer_route_clear(&copy);
+    _z_peer_route_clear(&route);
+}
+
+void test_matching_peers(void) {
+    printf("Test: publications and queries are routed to the peers with a matching declaration\n");
+    setup_session();
+    _z_peer_route_t route = _z_peer_route_null();
+    lookup_push("a/b", &route);
+    assert(route._selective && route._routers && route._len == 0);
+    assert(_z_peer_route_includes(&route, &router) && !_z_peer_route_includes(&route, &peer_a));
+
+    declare_subscriber("a/**", 1, &peer_a);
+    declare_subscriber("c/d", 2, &peer_b);
+    lookup_push("a/b", &route);
+    assert(route._len == 1 && _z_peer_route_includes(&route, &peer_a) && !_z_peer_route_includes(&route, &peer_b));
+    lookup_push("c/*", &route);
+    assert(route._len == 1 && _z_peer_route_includes(&route, &peer_b));
+    lookup_push("e/f", &route);
+    assert(route._len == 0);
+
+    // Queries follow the queryables only
+    lookup_query("a/b", &route);
+    assert(route._selective && route._len == 0);
+    declare_queryable("a/b", 1, true, &peer_b);
+    lookup_query("a/b", &route);
+    assert(route._len == 1 && _z_peer_route_includes(&route, &peer_b));
+
+    // Other messages go to all the peers
+    _z_network_message_t msg = {0};
+    _z_n_msg_make_declare(&msg, _z_make_decl_final(), _z_optional_id_make_none());
+    _z_peer_route_table_lookup(session, &msg, &route);
+    assert(!route._selective && _z_peer_route_includes(&route, &peer_a));
+
+    _z_peer_route_clear(&route);
+    cleanup_session();
+}
+
+void test_table(void) {
+    printf("Test: routes are looked up again once the remote declarations change\n");
+    setup_session();
+    _z_peer_route_t route = _z_peer_route_null();
+    declare_subscriber("a/**", 1, &peer_a);
+    lookup_push("a/b", &route);
+    lookup_push("a/b", &route);
+    assert(session->_peer_routes._misses == 1 && session->_peer_routes._hits == 1);
+    assert(route._len == 1);
+
+    // Entity ids are only unique per peer
+    declare_subscriber("a/b", 1, &peer_b);
+    lookup_push("a/b", &route);
+    assert(session->_peer_routes._misses == 2);
+    assert(route._len == 2 && _z_peer_route_includes(&route, &peer_a) && _z_peer_route_includes(&route, &peer_b));
+
+    assert(undeclare_subscriber(1, &peer_a) == _Z_RES_OK);
+    lookup_push("a/b", &route);
+    assert(session->_peer_routes._misses == 3);
+    assert(route._len == 1 && _z_peer_route_includes(&route, &peer_b));
+
+    _z_interest_peer_disconnected(session, &peer_b);
+    lookup_push("a/b", &route);
+    assert(session->_peer_routes._misses == 4);
+    assert(route._selective && route._len == 0);
+
+    _z_peer_route_clear(&route);
+    cleanup_session();
+}
+
+#if Z_FEATURE_BATCHING == 1
+// Sockets written to by the transport, of the peers it sends to
+static _z_sys_net_socket_t *writes[16];
+static size_t write_count;
+
+static size_t fake_write(const _z_link_t *self, const uint8_t *ptr, size_t len, _z_sys_net_socket_t *socket) {
+    _ZP_UNUSED(self);
+    _ZP_UNUSED(ptr);
+    assert(write_count < sizeof(writes) / sizeof(writes[0]));
+    writes[write_count++] = socket;
+    return len;
+}
+
+static size_t writes_to(_z_transport_peer_unicast_t *peer) {
+    size_t count = 0;
+    for (size_t i = 0; i < write_count; i++) {
+        count += (writes[i] == &peer->_socket) ? 1 : 0;
+    }
+    return count;
+}
+
+static _z_transport_peer_unicast_t *add_peer(z_whatami_t whatami) {
+    _z_transport_unicast_t *ztu = &session->_tp._transport._unicast;
+    ztu->_peers = _z_transport_peer_unicast_slist_push_empty(ztu->_peers);
+    assert(ztu->_peers != NULL);
+    _z_transport_peer_unicast_t *peer = _z_transport_peer_unicast_slist_value(ztu->_peers);
+    *peer = (_z_transport_peer_unicast_t){0};
+    peer->common._remote_whatami = whatami;
+    return peer;
+}
+
+static void push(const char *key) {
+    _z_wireexpr_t expr = wireexpr_of(key);
+    _z_bytes_t payload = _z_bytes_null();
+    _z_network_message_t msg;
+    _z_n_msg_make_push_put(&msg, &expr, &payload, NULL, _Z_N_QOS_DEFAULT, NULL, NULL, Z_RELIABILITY_RELIABLE, NULL);
+    assert(_z_send_n_msg(session, &msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) == _Z_RES_OK);
+}
+
+void test_send(void) {
+    printf("Test: batches are written to the peers they are routed to\n");
+    setup_session();
+    session->_mode = Z_WHATAMI_PEER;
+    _z_link_t *zl = (_z_link_t *)z_malloc(sizeof(_z_link_t));
+    assert(zl != NULL);
+    memset(zl, 0, sizeof(_z_link_t));
+    zl->_write_f = fake_write;
+    zl->_mtu = Z_BATCH_UNICAST_SIZE;
+    zl->_cap._flow = Z_LINK_CAP_FLOW_DATAGRAM;
+    _z_transport_unicast_establish_param_t param = {0};
+    param._batch_size = Z_BATCH_UNICAST_SIZE;
+    param._seq_num_res = Z_SN_RESOLUTION;
+    param._lease = Z_TRANSPORT_LEASE;
+    assert(_z_unicast_transport_create(&session->_tp, zl, &param) == _Z_RES_OK);
+    _z_transport_common_t *ztc = &session->_tp._transport._unicast._common;
+    _z_transport_peer_unicast_t *pa = add_peer(Z_WHATAMI_PEER);
+    _z_transport_peer_unicast_t *pb = add_peer(Z_WHATAMI_PEER);
+    _z_transport_peer_unicast_t *pc = add_peer(Z_WHATAMI_PEER);
+    declare_subscriber("a/**", 1, &pa->common);
+    declare_subscriber("b/**", 1, &pb->common);
+
+    // Peers without a matching subscriber are skipped
+    push("a/x");
+    assert(write_count == 1 && writes_to(pa) == 1);
+    assert(ztc->_route_stats._routed == 1 && ztc->_route_stats._peer_sends == 1);
+    assert(ztc->_route_stats._peer_skips == 2);
+
+    // Nobody gets a publication no peer subscribed to
+    write_count = 0;
+    push("c/x");
+    assert(write_count == 0);
+    assert(ztc->_route_stats._unmatched == 1 && ztc->_route_stats._routed == 1);
+
+    // Publications of different routes share a batch, sent to the peers of all of them
+    write_count = 0;
+    assert(_z_transport_start_batching(&session->_tp) == _Z_RES_OK);
+    for (size_t i = 0; i < 4; i++) {
+        push((i % 2 == 0) ? "a/x" : "b/x");
+    }
+    assert(write_count == 0);
+    // A message to a single peer only goes to it, after the batch
+    _z_network_message_t final;
+    _z_n_msg_make_response_final(&final, 1);
+    assert(_z_send_n_msg(session, &final, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, &pc->common) ==
+           _Z_RES_OK);
+    assert(write_count == 2 && writes_to(pa) == 1 && writes_to(pb) == 1);
+    assert(_z_send_n_batch(session, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    assert(write_count == 3 && writes_to(pc) == 1);
+    assert(_z_transport_stop_batching(&session->_tp) == _Z_RES_OK);
+    assert(ztc->_route_stats._routed == 5 && ztc->_route_stats._unmatched == 1);
+
+    cleanup_session();
+}
+#endif
+
+int main(void) {
+    peer_a._remote_whatami = Z_WHATAMI_PEER;
+    peer_b._remote_whatami = Z_WHATAMI_PEER;
+    router._remote_whatami = Z_WHATAMI_ROUTER;
+    test_route();
+    test_matching_peers();
+    test_table();
+#if Z_FEATURE_BATCHING == 1
+    test_send();
+#endif
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_PEER_ROUTING\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Throughput of the channel collections with 1 and 4 producer threads and one consumer.
+// Compares a mutex and condition variable fifo, as the channels used to be, with the lock-free ring in its multi
+// producer and SPSC modes, pulling one element at a time or in batches.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/collections/atomic_ring.h"
+#include "zenoh-pico/collections/fifo.h"
+
+#if Z_FEATURE_MULTI_THREAD == 1
+#define ELEMS 1000000
+#define CAPACITY 256
+#define MAX_PRODUCERS 4
+#define BATCH 32
+
+/*-------- Mutex fifo --------*/
+typedef struct {
+    _z_fifo_t fifo;
+    _z_mutex_t mutex;
+    _z_condvar_t cv_not_full;
+    _z_condvar_t cv_not_empty;
+} mutex_fifo_t;
+
+static void mutex_fifo_push(mutex_fifo_t *f, void *elem) {
+    _z_mutex_lock(&f->mutex);
+    while (_z_fifo_push(&f->fifo, elem) != NULL) {
+        _z_condvar_wait(&f->cv_not_full, &f->mutex);
+    }
+    _z_condvar_signal(&f->cv_not_empty);
+    _z_mutex_unlock(&f->mutex);
+}
+
+static void *mutex_fifo_pull(mutex_fifo_t *f) {
+    _z_mutex_lock(&f->mutex);
+    void *elem = _z_fifo_pull(&f->fifo);
+    while (elem == NULL) {
+        _z_condvar_wait(&f->cv_not_empty, &f->mutex);
+        elem = _z_fifo_pull(&f->fifo);
+    }
+    _z_condvar_signal(&f->cv_not_full);
+    _z_mutex_unlock(&f->mutex);
+    return elem;
+}
+
+/*-------- Benchmark --------*/
+typedef enum { KIND_MUTEX, KIND_RING, KIND_RING_BATCH, KIND_SPSC } kind_t;
+
+static const char *kind_names[] = {"mutex", "ring", "ring batch", "spsc"};
+
+typedef struct {
+    kind_t kind;
+    mutex_fifo_t mutex_fifo;
+    _z_atomic_ring_t ring;
+    size_t per_producer;
+} bench_t;
+
+static void *producer_task(void *arg) {
+    bench_t *b = (bench_t *)arg;
+    for (size_t i = 1; i <= b->per_producer; i++) {
+        if (b->kind == KIND_MUTEX) {
+            mutex_fifo_push(&b->mutex_fifo, (void *)(uintptr_t)i);
+        } else {
+            _z_atomic_ring_push(&b->ring, (void *)(uintptr_t)i);
+        }
+    }
+    return NULL;
+}
+
+static void run(kind_t kind, size_t producers) {
+    bench_t b = {.kind = kind, .per_producer = ELEMS / producers};
+    if (kind == KIND_MUTEX) {
+        _z_fifo_init(&b.mutex_fifo.fifo, CAPACITY);
+        _z_mutex_init(&b.mutex_fifo.mutex);
+        _z_condvar_init(&b.mutex_fifo.cv_not_full);
+        _z_condvar_init(&b.mutex_fifo.cv_not_empty);
+    } else if (_z_atomic_ring_init(&b.ring, CAPACITY, kind == KIND_SPSC) != _Z_RES_OK) {
+        printf("Unable to create the ring\n");
+        exit(-1);
+    }
+
+    z_clock_t start = z_clock_now();
+    _z_task_t tasks[MAX_PRODUCERS];
+    for (size_t p = 0; p < producers; p++) {
+        _z_task_init(&tasks[p], NULL, producer_task, &b);
+    }
+    size_t total = b.per_producer * producers;
+    size_t received = 0;
+    uintptr_t sum = 0;
+    while (received < total) {
+        void *elems[BATCH];
+        size_t num = 0;
+        if (kind == KIND_MUTEX) {
+            elems[0] = mutex_fifo_pull(&b.mutex_fifo);
+            num = 1;
+        } else {
+            if (kind != KIND_RING) {
+                num = _z_atomic_ring_try_pull_many(&b.ring, elems, BATCH);
+            }
+            if (num == 0) {
+                _z_atomic_ring_pull(&b.ring, &elems[0]);
+                num = 1;
+            }
+        }
+        for (size_t i = 0; i < num; i++) {
+            sum += (uintptr_t)elems[i];
+        }
+        received += num;
+    }
+    for (size_t p = 0; p < producers; p++) {
+        _z_task_join(&tasks[p]);
+    }
+    unsigned long elapsed = z_clock_elapsed_us(&start);
+
+    uintptr_t expected = (uintptr_t)producers * b.per_producer * (b.per_producer + 1) / 2;
+    printf("%zu producer(s), %-10s: %.2f Melems/s%s\n", producers, kind_names[kind],
+           (double)total / (double)(elapsed > 0 ? elapsed : 1), sum == expected ? "" : " (MISMATCH)");
+
+    if (kind == KIND_MUTEX) {
+        _z_fifo_clear(&b.mutex_fifo.fifo, NULL);
+        _z_mutex_drop(&b.mutex_fifo.mutex);
+        _z_condvar_drop(&b.mutex_fifo.cv_not_full);
+        _z_condvar_drop(&b.mutex_fifo.cv_not_empty);
+    } else {
+        _z_atomic_ring_clear(&b.ring, NULL);
+    }
+}
+
+int main(void) {
+    run(KIND_MUTEX, 1);
+    run(KIND_RING, 1);
+    run(KIND_RING_BATCH, 1);
+    run(KIND_SPSC, 1);
+    run(KIND_MUTEX, MAX_PRODUCERS);
+    run(KIND_RING, MAX_PRODUCERS);
+    run(KIND_RING_BATCH, MAX_PRODUCERS);
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: This benchmark requires Z_FEATURE_MULTI_THREAD.\n");
+    return -2;
+}
+#endif
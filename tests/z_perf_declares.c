@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Cost of the declarations a router replays to a session when it connects, for a growing number of them. Each
+// declaration is looked up among the known ones and matched against the local interests, as the ones of matching
+// listeners and liveliness subscribers. Replaying the known declarations to a new interest and undeclaring them all
+// are measured too.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/session/interest.h"
+#include "zenoh-pico/session/utils.h"
+
+#if Z_FEATURE_INTEREST == 1
+#define INTERESTS 32
+
+static _z_transport_peer_common_t router;
+static size_t matched;
+
+static void fail(const char *what) {
+    printf("Failed to %s\n", what);
+    exit(-1);
+}
+
+static void report(const char *name, size_t num, unsigned long elapsed_us) {
+    printf("%-9s %6zu decls: %9.1f ms %8.2f us/decl\n", name, num, (double)elapsed_us / 1000.0,
+           (double)elapsed_us / (double)num);
+}
+
+static void on_interest(const _z_interest_msg_t *msg, _z_transport_peer_common_t *peer, void *arg) {
+    _ZP_UNUSED(msg);
+    _ZP_UNUSED(peer);
+    _ZP_UNUSED(arg);
+    matched++;
+}
+
+static _z_session_interest_t interest_of(uint32_t id, const char *key, uint8_t flags) {
+    _z_session_interest_t intr = {0};
+    _z_string_t str = _z_string_alias_str(key);
+    if (_z_keyexpr_copy_from_string(&intr._key, &str) != _Z_RES_OK) {
+        fail("allocate an interest");
+    }
+    intr._id = id;
+    intr._callback = on_interest;
+    intr._arg = _z_void_rc_null();
+    intr._flags = flags;
+    return intr;
+}
+
+static void bench(size_t num) {
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    _z_session_t *zn = (_z_session_t *)z_malloc(sizeof(_z_session_t));
+    if (zn == NULL) {
+        fail("allocate the session");
+    }
+    memset(zn, 0, sizeof(_z_session_t));
+    if (_z_session_init(zn, &zid) != _Z_RES_OK) {
+        fail("init the session");
+    }
+    _z_session_rc_t rc = _z_session_rc_new(zn);
+
+    // Half of them on a key of their own, the others on a key with a wildcard
+    char key[64];
+    for (uint32_t i = 0; i < INTERESTS; i++) {
+        snprintf(key, sizeof(key), (i % 2 == 0) ? "bench/%u/status" : "bench/%u/**", (unsigned)i);
+        _z_session_interest_t intr = interest_of(i + 1, key, _Z_INTEREST_FLAG_SUBSCRIBERS | _Z_INTEREST_FLAG_TOKENS);
+        if (_z_register_interest(zn, &intr) == NULL) {
+            fail("register an interest");
+        }
+    }
+
+    matched = 0;
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < num; i++) {
+        snprintf(key, sizeof(key), "bench/%zu/status", i);
+        _z_wireexpr_t expr = _z_wireexpr_null();
+        expr._suffix = _z_string_view_make(key, strlen(key));
+        _z_n_msg_declare_t msg = {._decl = _z_make_decl_subscriber(&expr, (uint32_t)i),
+                                  ._interest_id = _z_optional_id_make_none()};
+        if (_z_interest_process_declares(zn, &msg, &router) != _Z_RES_OK) {
+            fail("process a declaration");
+        }
+    }
+    report("declare", num, z_clock_elapsed_us(&start));
+    if (matched != INTERESTS) {
+        fail("match the interests");
+    }
+
+    _z_session_interest_t intr = interest_of(INTERESTS + 1, "bench/**", _Z_INTEREST_FLAG_SUBSCRIBERS);
+    matched = 0;
+    start = z_clock_now();
+    _z_interest_replay_declare(zn, &intr);
+    report("replay", num, z_clock_elapsed_us(&start));
+    if (matched != num) {
+        fail("replay the declarations");
+    }
+    _z_session_interest_clear(&intr);
+
+    start = z_clock_now();
+    for (size_t i = 0; i < num; i++) {
+        _z_declaration_t decl = _z_make_undecl_subscriber((uint32_t)i, NULL);
+        if (_z_interest_process_undeclares(zn, &decl, &router) != _Z_RES_OK) {
+            fail("process an undeclaration");
+        }
+    }
+    report("undeclare", num, z_clock_elapsed_us(&start));
+    _z_session_rc_drop(&rc);
+}
+
+int main(void) {
+    size_t nums[] = {1000, 10000, 50000};
+    for (size_t i = 0; i < sizeof(nums) / sizeof(nums[0]); i++) {
+        bench(nums[i]);
+    }
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: This benchmark requires Z_FEATURE_INTEREST.\n");
+    return -2;
+}
+#endif
@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Cost of matching a sample against the subscribers of a session, by scanning them all or by walking the key
+// expression trie that indexes them. One subscriber in ten uses a wildcard.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/keyexpr_trie.h"
+#include "zenoh-pico/system/common/platform.h"
+
+#define MATCHES 10000
+#define MAX_SUBS 10000
+#define KEY_LEN 64
+
+static void fail(const char *what) {
+    printf("Failed to %s\n", what);
+    exit(-1);
+}
+
+static _z_keyexpr_t ke(const char *s) {
+    _z_keyexpr_t k = {._keyexpr = _z_string_alias_str(s)};
+    return k;
+}
+
+static z_result_t count_match(void *value, void *arg) {
+    _ZP_UNUSED(value);
+    (*(size_t *)arg)++;
+    return _Z_RES_OK;
+}
+
+// The sample published on the key of a subscriber
+static _z_keyexpr_t query_of(char *buf, size_t m, size_t num) {
+    size_t idx = (m * 7919) % num;
+    snprintf(buf, KEY_LEN, "bench/%zu/%zu", idx / 100, idx);
+    return ke(buf);
+}
+
+static void bench(const _z_keyexpr_t *subs, size_t num) {
+    _z_keyexpr_trie_t trie;
+    _z_keyexpr_trie_init(&trie);
+    for (size_t i = 0; i < num; i++) {
+        if (_z_keyexpr_trie_insert(&trie, &subs[i], (void *)&subs[i]) != _Z_RES_OK) {
+            fail("index a subscriber");
+        }
+    }
+    char query_name[KEY_LEN];
+    size_t linear_hits = 0;
+    z_clock_t start = z_clock_now();
+    for (size_t m = 0; m < MATCHES; m++) {
+        _z_keyexpr_t query = query_of(query_name, m, num);
+        for (size_t i = 0; i < num; i++) {
+            if (_z_keyexpr_intersects(&subs[i], &query)) {
+                linear_hits++;
+            }
+        }
+    }
+    unsigned long linear_us = z_clock_elapsed_us(&start);
+
+    size_t trie_hits = 0;
+    start = z_clock_now();
+    for (size_t m = 0; m < MATCHES; m++) {
+        _z_keyexpr_t query = query_of(query_name, m, num);
+        if (_z_keyexpr_trie_match(&trie, &query, count_match, &trie_hits) != _Z_RES_OK) {
+            fail("match a sample");
+        }
+    }
+    unsigned long trie_us = z_clock_elapsed_us(&start);
+    if (linear_hits != trie_hits) {
+        fail("find the same subscribers");
+    }
+    printf("%5zu subs: linear %9.1f ms, trie %7.1f ms (%zu matches)\n", num, (double)linear_us / 1000.0,
+           (double)trie_us / 1000.0, trie_hits);
+    _z_keyexpr_trie_clear(&trie);
+}
+
+int main(void) {
+    char(*names)[KEY_LEN] = (char(*)[KEY_LEN])malloc(MAX_SUBS * sizeof(*names));
+    _z_keyexpr_t *subs = (_z_keyexpr_t *)malloc(MAX_SUBS * sizeof(_z_keyexpr_t));
+    if (names == NULL || subs == NULL) {
+        fail("allocate the subscribers");
+    }
+    for (size_t i = 0; i < MAX_SUBS; i++) {
+        if (i % 10 == 0) {
+            snprintf(names[i], KEY_LEN, "bench/%zu/*", i / 100);
+        } else {
+            snprintf(names[i], KEY_LEN, "bench/%zu/%zu", i / 100, i);
+        }
+        subs[i] = ke(names[i]);
+    }
+    size_t nums[] = {10, 100, 1000, MAX_SUBS};
+    for (size_t i = 0; i < sizeof(nums) / sizeof(nums[0]); i++) {
+        bench(subs, nums[i]);
+    }
+    free(subs);
+    free(names);
+    return 0;
+}
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Cost of a read loop wakeup with 8, 64 and 256 connected peers, one of them sending at a time.
+// Compares walking the peers with _z_socket_wait_readable and the persistent wait set.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/link/transport/socket.h"
+
+#if defined(_Z_SOCKET_WAIT_SET_ENABLED)
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define ROUNDS 20000
+#define MAX_PEERS 256
+
+typedef struct {
+    _z_sys_net_socket_t sock;
+    int remote_fd;
+    bool pending;
+} peer_t;
+
+typedef struct {
+    peer_t *peers;
+    size_t len;
+} peers_t;
+
+static peer_t peers[MAX_PEERS];
+
+static void iter_reset(_z_socket_wait_iter_t *iter) { iter->_current_entry = NULL; }
+
+static bool iter_next(_z_socket_wait_iter_t *iter) {
+    peers_t *ctx = (peers_t *)iter->_ctx;
+    peer_t *curr = (peer_t *)iter->_current_entry;
+    curr = (curr == NULL) ? ctx->peers : curr + 1;
+    iter->_current_entry = (curr < ctx->peers + ctx->len) ? curr : NULL;
+    return iter->_current_entry != NULL;
+}
+
+static const _z_sys_net_socket_t *iter_get_socket(const _z_socket_wait_iter_t *iter) {
+    return &((peer_t *)iter->_current_entry)->sock;
+}
+
+static void iter_set_ready(_z_socket_wait_iter_t *iter, bool ready) {
+    ((peer_t *)iter->_current_entry)->pending = ready;
+}
+
+// Read the pending peers until their socket would block
+static size_t drain(size_t len) {
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (!peers[i].pending) {
+            continue;
+        }
+        uint8_t buf[64];
+        while (recv(peers[i].sock._fd, buf, sizeof(buf), 0) > 0) {
+            n++;
+        }
+        peers[i].pending = false;
+    }
+    return n;
+}
+
+static void run(size_t len, bool use_set) {
+    peers_t ctx = {.peers = peers, .len = len};
+    _z_socket_wait_iter_t iter = {
+        ._ctx = &ctx,
+        ._current_entry = NULL,
+        ._reset = iter_reset,
+        ._next = iter_next,
+        ._get_socket = iter_get_socket,
+        ._set_ready = iter_set_ready,
+    };
+    _z_socket_wait_set_t set;
+    if (use_set) {
+        _z_socket_wait_set_init(&set);
+        for (size_t i = 0; i < len; i++) {
+            _z_socket_wait_set_add(&set, &peers[i].sock, &peers[i]);
+        }
+    }
+
+    uint8_t msg[16] = {0};
+    size_t received = 0;
+    z_clock_t start = z_clock_now();
+    for (size_t r = 0; r < ROUNDS; r++) {
+        // Spread the senders over the whole list
+        size_t sender = (r * 7919) % len;
+        if (send(peers[sender].remote_fd, msg, sizeof(msg), 0) < 0) {
+            printf("Send failed\n");
+            exit(-1);
+        }
+        if (use_set) {
+            _z_socket_wait_set_wait(&set, 1000);
+            _z_socket_wait_set_mark_ready(&set, &iter);
+        } else {
+            _z_socket_wait_readable(&iter, 1000);
+        }
+        received += drain(len);
+    }
+    unsigned long elapsed = z_clock_elapsed_us(&start);
+    printf("%3zu peers, %-6s: %zu/%d messages, %.2fus per wakeup\n", len, use_set ? "epoll" : "select", received,
+           ROUNDS, (double)elapsed / ROUNDS);
+    if (use_set) {
+        _z_socket_wait_set_clear(&set);
+    }
+}
+
+int main(void) {
+    for (size_t i = 0; i < MAX_PEERS; i++) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            printf("Unable to create socket pair\n");
+            return -1;
+        }
+        peers[i].sock._fd = fds[0];
+        peers[i].remote_fd = fds[1];
+        _z_socket_set_blocking(&peers[i].sock, false);
+    }
+    const size_t counts[] = {8, 64, 256};
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        run(counts[i], false);
+        run(counts[i], true);
+    }
+    for (size_t i = 0; i < MAX_PEERS; i++) {
+        close(peers[i].sock._fd);
+        close(peers[i].remote_fd);
+    }
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: This benchmark requires the epoll socket wait set (Linux, TCP or UDP links).\n");
+    return -2;
+}
+#endif
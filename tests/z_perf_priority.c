@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Latency of REAL_TIME samples while DATA_LOW publishers send bursts on the same transport.
+// Build with and without Z_FEATURE_TX_PRIORITY_QUEUES to compare. The bursts are paced below the link capacity: a
+// flood fills the socket buffers, which no sender side scheduling gets ahead of. The publishing session is a client
+// of the subscribing peer, senders in peer mode are serialized by the peer mutex instead of queueing by priority.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+
+#define RT_SAMPLES 2000
+#define RT_PERIOD_US 1000
+#define BULK_SIZE 4000
+#define BULK_TASKS 4
+#define BULK_BURST 16
+#define BULK_PERIOD_US 1000
+
+#if Z_FEATURE_PUBLICATION == 1 && Z_FEATURE_SUBSCRIPTION == 1 && Z_FEATURE_MULTI_THREAD == 1
+typedef struct {
+    z_clock_t sent;
+} rt_msg_t;
+
+static unsigned long latencies[RT_SAMPLES];
+static volatile size_t received = 0;
+static volatile size_t bulk_received = 0;
+static volatile bool flooding = false;
+static uint8_t bulk[BULK_SIZE];
+
+static void on_rt_sample(z_loaned_sample_t *sample, void *ctx) {
+    (void)ctx;
+    rt_msg_t msg;
+    z_bytes_reader_t reader = z_bytes_get_reader(z_sample_payload(sample));
+    if (z_bytes_reader_read(&reader, (uint8_t *)&msg, sizeof(msg)) != sizeof(msg)) {
+        return;
+    }
+    if (received < RT_SAMPLES) {
+        latencies[received] = z_clock_elapsed_us(&msg.sent);
+        received++;
+    }
+}
+
+static void on_bulk_sample(z_loaned_sample_t *sample, void *ctx) {
+    (void)sample;
+    (void)ctx;
+    bulk_received++;
+}
+
+static void *flood_task(void *arg) {
+    const z_loaned_publisher_t *pub = (const z_loaned_publisher_t *)arg;
+    while (flooding) {
+        for (size_t i = 0; i < BULK_BURST; i++) {
+            z_owned_bytes_t payload;
+            z_bytes_from_static_buf(&payload, bulk, BULK_SIZE);
+            z_publisher_put(pub, z_move(payload), NULL);
+        }
+        z_sleep_us(BULK_PERIOD_US);
+    }
+    return NULL;
+}
+
+static int cmp_ulong(const void *a, const void *b) {
+    unsigned long l = *(const unsigned long *)a;
+    unsigned long r = *(const unsigned long *)b;
+    return (l > r) - (l < r);
+}
+
+static void run(const char *name, const z_loaned_publisher_t *rt_pub, const z_loaned_publisher_t *bulk_pub) {
+    received = 0;
+    bulk_received = 0;
+    z_owned_task_t tasks[BULK_TASKS];
+    if (bulk_pub != NULL) {
+        flooding = true;
+        for (size_t i = 0; i < BULK_TASKS; i++) {
+            z_task_init(&tasks[i], NULL, flood_task, (void *)bulk_pub);
+        }
+        z_sleep_ms(100);
+    }
+    for (size_t i = 0; i < RT_SAMPLES; i++) {
+        rt_msg_t msg = {.sent = z_clock_now()};
+        z_owned_bytes_t payload;
+        z_bytes_copy_from_buf(&payload, (const uint8_t *)&msg, sizeof(msg));
+        z_publisher_put(rt_pub, z_move(payload), NULL);
+        z_sleep_us(RT_PERIOD_US);
+    }
+    if (bulk_pub != NULL) {
+        flooding = false;
+        for (size_t i = 0; i < BULK_TASKS; i++) {
+            z_task_join(z_move(tasks[i]));
+        }
+    }
+    // Let the samples still in flight come in
+    for (size_t i = 0; (i < 50) && (received < RT_SAMPLES); i++) {
+        z_sleep_ms(100);
+    }
+    size_t n = received;
+    if (n == 0) {
+        printf("%s: no sample received, %zu bulk samples\n", name, bulk_received);
+        return;
+    }
+    qsort(latencies, n, sizeof(latencies[0]), cmp_ulong);
+    printf("%s: %zu/%d samples, p50 %luus, p99 %luus, max %luus, %zu bulk samples\n", name, n, RT_SAMPLES,
+           latencies[n / 2], latencies[(n * 99) / 100], latencies[n - 1], bulk_received);
+}
+
+int main(int argc, char **argv) {
+    const char *locator = "tcp/127.0.0.1:7447";
+    if (argc > 1) {
+        locator = argv[1];
+    }
+    memset(bulk, 1, sizeof(bulk));
+
+    z_owned_config_t c1, c2;
+    z_config_default(&c1);
+    z_config_default(&c2);
+    zp_config_insert(z_loan_mut(c1), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(c2), Z_CONFIG_MODE_KEY, "client");
+    zp_config_insert(z_loan_mut(c1), Z_CONFIG_LISTEN_KEY, locator);
+    zp_config_insert(z_loan_mut(c2), Z_CONFIG_CONNECT_KEY, locator);
+    z_owned_session_t s1, s2;
+    if ((z_open(&s1, z_move(c1), NULL) < 0) || (z_open(&s2, z_move(c2), NULL) < 0)) {
+        printf("Unable to open session!\n");
+        return -1;
+    }
+
+    z_view_keyexpr_t rt_ke, bulk_ke;
+    z_view_keyexpr_from_str(&rt_ke, "test/priority/rt");
+    z_view_keyexpr_from_str(&bulk_ke, "test/priority/bulk");
+    z_owned_closure_sample_t callback;
+    z_closure(&callback, on_rt_sample, NULL, NULL);
+    z_owned_closure_sample_t bulk_callback;
+    z_closure(&bulk_callback, on_bulk_sample, NULL, NULL);
+    z_owned_subscriber_t sub, bulk_sub;
+    if ((z_declare_subscriber(z_loan(s1), &sub, z_loan(rt_ke), z_move(callback), NULL) < 0) ||
+        (z_declare_subscriber(z_loan(s1), &bulk_sub, z_loan(bulk_ke), z_move(bulk_callback), NULL) < 0)) {
+        printf("Unable to declare subscribers!\n");
+        return -1;
+    }
+
+    z_publisher_options_t rt_opts;
+    z_publisher_options_default(&rt_opts);
+    rt_opts.priority = Z_PRIORITY_REAL_TIME;
+    rt_opts.is_express = true;
+    // Dropped samples would not show up in the latency figures
+    rt_opts.congestion_control = Z_CONGESTION_CONTROL_BLOCK;
+    z_publisher_options_t bulk_opts;
+    z_publisher_options_default(&bulk_opts);
+    bulk_opts.priority = Z_PRIORITY_DATA_LOW;
+    bulk_opts.congestion_control = Z_CONGESTION_CONTROL_BLOCK;
+    z_owned_publisher_t rt_pub, bulk_pub;
+    if ((z_declare_publisher(z_loan(s2), &rt_pub, z_loan(rt_ke), &rt_opts) < 0) ||
+        (z_declare_publisher(z_loan(s2), &bulk_pub, z_loan(bulk_ke), &bulk_opts) < 0)) {
+        printf("Unable to declare publishers!\n");
+        return -1;
+    }
+    // Wait for the declarations to be exchanged
+    z_sleep_s(1);
+
+    run("idle", z_loan(rt_pub), NULL);
+    run("low priority bursts", z_loan(rt_pub), z_loan(bulk_pub));
+
+    z_drop(z_move(rt_pub));
+    z_drop(z_move(bulk_pub));
+    z_drop(z_move(sub));
+    z_drop(z_move(bulk_sub));
+    z_drop(z_move(s1));
+    z_drop(z_move(s2));
+    return 0;
+}
+#else
+int main(void) {
+    printf(
+        "ERROR: Zenoh pico was compiled without Z_FEATURE_PUBLICATION, Z_FEATURE_SUBSCRIPTION or "
+        "Z_FEATURE_MULTI_THREAD but this test requires them.\n");
+    return -2;
+}
+#endif
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Cost per sample of small puts, through a publisher whose message header is encoded once and through z_put on a
+// declared key expression, which encodes it each time. Puts are batched on a multicast session over the loopback
+// interface so that the sends don't hide the cost of the put itself.
+// The encoding alone of a push message is measured too, with and without the encoded header.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/protocol/codec/network.h"
+
+#if Z_FEATURE_PUBLICATION == 1 && Z_FEATURE_BATCHING == 1
+#define PUTS 200000
+#define ENCODES 2000000
+#define KEYEXPR "test/perf/publisher"
+
+static void fail(const char *what) {
+    printf("Failed to %s\n", what);
+    exit(-1);
+}
+
+static void report(const char *name, size_t payload_len, size_t num, unsigned long elapsed_us) {
+    printf("%-8s %4zu bytes: %8.0f msgs/s %7.1f ns/msg\n", name, payload_len, (double)num * 1e6 / (double)elapsed_us,
+           1000.0 * (double)elapsed_us / (double)num);
+}
+
+static void bench_put(const z_loaned_session_t *s, const z_loaned_keyexpr_t *ke, const uint8_t *value, size_t len) {
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < PUTS; i++) {
+        z_owned_bytes_t payload;
+        z_bytes_copy_from_buf(&payload, value, len);
+        if (z_put(s, ke, z_move(payload), NULL) != Z_OK) {
+            fail("put");
+        }
+    }
+    report("put", len, PUTS, z_clock_elapsed_us(&start));
+}
+
+static void bench_publisher(const z_loaned_publisher_t *pub, const uint8_t *value, size_t len) {
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < PUTS; i++) {
+        z_owned_bytes_t payload;
+        z_bytes_copy_from_buf(&payload, value, len);
+        if (z_publisher_put(pub, z_move(payload), NULL) != Z_OK) {
+            fail("publish");
+        }
+    }
+    report("pub", len, PUTS, z_clock_elapsed_us(&start));
+}
+
+static void bench_encode(const _z_wireexpr_t *key, const uint8_t *value, size_t len, bool prefixed) {
+    _z_bytes_t payload;
+    if (_z_bytes_copy_from_buf(&payload, value, len) != _Z_RES_OK) {
+        fail("allocate the payload");
+    }
+    _z_n_qos_t qos = _z_n_qos_make(false, true, Z_PRIORITY_DATA);
+    _z_network_message_t msg;
+    _z_n_msg_make_push_put(&msg, key, &payload, NULL, qos, NULL, NULL, Z_RELIABILITY_RELIABLE, NULL);
+    _z_slice_t prefix = _z_slice_null();
+    if (prefixed) {
+        if (_z_push_prefix_encode(&prefix, key, qos) != _Z_RES_OK) {
+            fail("encode the prefix");
+        }
+        msg._body._push._prefix = &prefix;
+    }
+    _z_wbuf_t wbf;
+    if (_z_wbuf_init(&wbf, Z_BATCH_UNICAST_SIZE, false) != _Z_RES_OK) {
+        fail("allocate the buffer");
+    }
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < ENCODES; i++) {
+        // As the transport does, the length decides where the message goes
+        if (_z_network_message_encoded_len(&msg) > _z_wbuf_space_left(&wbf)) {
+            _z_wbuf_reset(&wbf);
+        }
+        if (_z_network_message_encode(&wbf, &msg) != _Z_RES_OK) {
+            fail("encode");
+        }
+    }
+    report(prefixed ? "enc pre" : "enc", len, ENCODES, z_clock_elapsed_us(&start));
+    _z_wbuf_clear(&wbf);
+    _z_slice_clear(&prefix);
+    _z_bytes_clear(&payload);
+}
+
+int main(void) {
+    uint8_t value[256];
+    for (size_t i = 0; i < sizeof(value); i++) {
+        value[i] = (uint8_t)i;
+    }
+    size_t lens[] = {8, 64, 256};
+
+    // The key expression is sent as a string, as for a key that isn't declared
+    _z_wireexpr_t key = _z_wireexpr_null();
+    key._suffix = _z_string_view_make(KEYEXPR, sizeof(KEYEXPR) - 1);
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        bench_encode(&key, value, lens[i], false);
+        bench_encode(&key, value, lens[i], true);
+    }
+
+    z_owned_config_t config;
+    z_config_default(&config);
+    zp_config_insert(z_loan_mut(config), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(config), Z_CONFIG_LISTEN_KEY, "udp/224.0.0.224:7448#iface=lo");
+    z_owned_session_t s;
+    if (z_open(&s, z_move(config), NULL) != Z_OK) {
+        fail("open the session");
+    }
+    z_view_keyexpr_t view;
+    z_view_keyexpr_from_str(&view, KEYEXPR);
+    z_owned_keyexpr_t ke;
+    if (z_declare_keyexpr(z_loan(s), &ke, z_loan(view)) != Z_OK) {
+        fail("declare the key expression");
+    }
+    z_owned_publisher_t pub;
+    if (z_declare_publisher(z_loan(s), &pub, z_loan(view), NULL) != Z_OK) {
+        fail("declare the publisher");
+    }
+    zp_batch_start(z_loan(s));
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        bench_put(z_loan(s), z_loan(ke), value, lens[i]);
+        bench_publisher(z_loan(pub), value, lens[i]);
+    }
+    zp_batch_stop(z_loan(s));
+
+    z_drop(z_move(pub));
+    z_undeclare_keyexpr(z_loan(s), z_move(ke));
+    z_drop(z_move(s));
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: This benchmark requires Z_FEATURE_PUBLICATION and Z_FEATURE_BATCHING.\n");
+    return -2;
+}
+#endif
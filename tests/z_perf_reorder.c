@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Cost per sample of an advanced subscriber recovery storm, as after a link flap: the live samples of a source keep
+// coming while the missed ones are retransmitted, so thousands of samples wait for reordering.
+// Sequenced samples go through the reorder window, timestamped ones through the sorted map.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/api/advanced_subscriber.h"
+
+#if Z_FEATURE_ADVANCED_SUBSCRIPTION == 1
+#define ROUNDS 10
+
+static _z_sample_t *new_sample(void) {
+    _z_sample_t *sample = z_malloc(sizeof(_z_sample_t));
+    if (sample == NULL) {
+        printf("Out of memory\n");
+        exit(-1);
+    }
+    *sample = _z_sample_null();
+    return sample;
+}
+
+static size_t delivered = 0;
+
+static void deliver(_z_sample_t *sample) {
+    delivered++;
+    _z_sample_elem_free((void **)&sample);
+}
+
+// Pop the samples that follow the last delivered one, as the subscriber does
+static void flush(_ze_advanced_subscriber_reorder_window_t *w, uint32_t *next_sn) {
+    uint32_t sn;
+    while (_ze_advanced_subscriber_reorder_window_first(w, &sn) && sn == *next_sn) {
+        deliver(_ze_advanced_subscriber_reorder_window_pop_first(w, &sn));
+        (*next_sn)++;
+    }
+}
+
+// The gap is retransmitted in order after the live samples that followed it
+static void storm_sequenced(size_t gap, bool shuffled) {
+    uint32_t *order = z_malloc(gap * sizeof(uint32_t));
+    for (size_t i = 0; i < gap; i++) {
+        order[i] = (uint32_t)i;
+    }
+    if (shuffled) {
+        for (size_t i = gap - 1; i > 0; i--) {
+            size_t j = (size_t)z_random_u32() % (i + 1);
+            uint32_t tmp = order[i];
+            order[i] = order[j];
+            order[j] = tmp;
+        }
+    }
+    delivered = 0;
+    z_clock_t start = z_clock_now();
+    for (size_t r = 0; r < ROUNDS; r++) {
+        _ze_advanced_subscriber_reorder_window_t w;
+        _ze_advanced_subscriber_reorder_window_init(&w);
+        uint32_t next_sn = 0;
+        for (size_t i = 0; i < gap; i++) {
+            _ze_advanced_subscriber_reorder_window_insert(&w, (uint32_t)(gap + i), new_sample());
+        }
+        for (size_t i = 0; i < gap; i++) {
+            uint32_t sn = order[i];
+            if (sn == next_sn) {
+                deliver(new_sample());
+                next_sn++;
+                flush(&w, &next_sn);
+            } else {
+                _ze_advanced_subscriber_reorder_window_insert(&w, sn, new_sample());
+            }
+        }
+        _ze_advanced_subscriber_reorder_window_clear(&w);
+    }
+    unsigned long elapsed = z_clock_elapsed_us(&start);
+    printf("sequenced %-9s gap %6zu: %8.1f ns/sample%s\n", shuffled ? "shuffled" : "in order", gap,
+           1000.0 * (double)elapsed / (double)(ROUNDS * 2 * gap), delivered == ROUNDS * 2 * gap ? "" : " (MISMATCH)");
+    z_free(order);
+}
+
+static void storm_timestamped(size_t num) {
+    _z_id_t id = {0};
+    z_clock_t start = z_clock_now();
+    for (size_t r = 0; r < ROUNDS; r++) {
+        _z_timestamp__z_sample_sortedmap_t map = _z_timestamp__z_sample_sortedmap_make();
+        for (size_t i = 0; i < num; i++) {
+            _z_timestamp_t *ts = z_malloc(sizeof(_z_timestamp_t));
+            // Replies of several queryables interleave
+            *ts = _z_timestamp_null();
+            ts->id = id;
+            ts->time = (uint64_t)((i % 4) * num + i / 4);
+            _z_timestamp__z_sample_sortedmap_insert(&map, ts, new_sample());
+        }
+        _z_timestamp__z_sample_sortedmap_clear(&map);
+    }
+    unsigned long elapsed = z_clock_elapsed_us(&start);
+    printf("timestamped        %10zu: %8.1f ns/sample\n", num, 1000.0 * (double)elapsed / (double)(ROUNDS * num));
+}
+
+int main(void) {
+    size_t gaps[] = {100, 1000, 10000};
+    for (size_t i = 0; i < sizeof(gaps) / sizeof(gaps[0]); i++) {
+        storm_sequenced(gaps[i], false);
+        storm_sequenced(gaps[i], true);
+    }
+    for (size_t i = 0; i < sizeof(gaps) / sizeof(gaps[0]); i++) {
+        storm_timestamped(gaps[i]);
+    }
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: This benchmark requires Z_FEATURE_ADVANCED_SUBSCRIPTION.\n");
+    return -2;
+}
+#endif
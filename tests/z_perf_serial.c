@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Throughput and latency of the serial link over a pseudo-terminal, which has no baudrate: what is measured is the
+// cost of the framing, the checksum and the reads and writes on the tty.
+
+// For the pseudo-terminal functions
+#if !defined(_XOPEN_SOURCE)
+#define _XOPEN_SOURCE 600
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "zenoh-pico.h"
+
+#if Z_FEATURE_LINK_SERIAL == 1 && (defined(ZENOH_LINUX) || defined(ZENOH_MACOS) || defined(ZENOH_BSD))
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "zenoh-pico/link/endpoint.h"
+#include "zenoh-pico/link/transport/serial_protocol.h"
+#include "zenoh-pico/protocol/codec/serial.h"
+#include "zenoh-pico/utils/checksum.h"
+
+#define FRAMES 20000
+// Frames in flight at once, within what the pseudo-terminal buffers
+#define BATCH 2
+
+static int master_fd = -1;
+static _z_serial_socket_t sock;
+
+static void fail(const char *what) {
+    printf("Failed to %s\n", what);
+    exit(-1);
+}
+
+static void open_pty(void) {
+    master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master_fd < 0 || grantpt(master_fd) != 0 || unlockpt(master_fd) != 0) {
+        fail("open a pseudo-terminal");
+    }
+    char locator[128];
+    snprintf(locator, sizeof(locator), "serial/%s#baudrate=115200", ptsname(master_fd));
+    _z_string_t str = _z_string_alias_str(locator);
+    _z_endpoint_t ep;
+    if (_z_endpoint_from_string(&ep, &str) != _Z_RES_OK || _z_serial_protocol_listen(&sock, &ep) != _Z_RES_OK) {
+        fail("open the serial socket");
+    }
+    _z_endpoint_clear(&ep);
+}
+
+static void write_master(const uint8_t *raw, size_t len) {
+    size_t written = 0;
+    while (written < len) {
+        ssize_t wb = write(master_fd, &raw[written], len - written);
+        if (wb <= 0) {
+            fail("write to the pseudo-terminal");
+        }
+        written += (size_t)wb;
+    }
+}
+
+static void read_master(uint8_t *raw, size_t len) {
+    size_t rb = 0;
+    while (rb < len) {
+        ssize_t n = read(master_fd, &raw[rb], len - rb);
+        if (n <= 0) {
+            fail("read from the pseudo-terminal");
+        }
+        rb += (size_t)n;
+    }
+}
+
+static void report(const char *name, size_t payload_len, unsigned long elapsed_us) {
+    double secs = (double)elapsed_us / 1e6;
+    printf("%-4s %5zu bytes: %8.0f frames/s %9.1f Mbit/s %7.2f us/frame\n", name, payload_len, FRAMES / secs,
+           (double)FRAMES * (double)payload_len * 8.0 / secs / 1e6, (double)elapsed_us / FRAMES);
+}
+
+// Frames written on the other side are read by the link, a batch at a time. One frame at a time, this is the latency.
+static void bench_rx(const char *name, size_t payload_len, size_t batch) {
+    uint8_t payload[_Z_SERIAL_MTU_SIZE];
+    for (size_t i = 0; i < payload_len; i++) {
+        payload[i] = (uint8_t)i;
+    }
+    uint8_t raw[BATCH * _Z_SERIAL_MAX_COBS_BUF_SIZE];
+    uint8_t tmp[_Z_SERIAL_MFS_SIZE];
+    size_t raw_len = 0;
+    for (size_t i = 0; i < batch; i++) {
+        raw_len += _z_serial_msg_serialize(&raw[raw_len], _Z_SERIAL_MAX_COBS_BUF_SIZE, payload, payload_len, 0, tmp,
+                                           sizeof(tmp));
+    }
+
+    uint8_t buf[_Z_SERIAL_MTU_SIZE];
+    z_clock_t start = z_clock_now();
+    for (size_t n = 0; n < FRAMES; n += batch) {
+        write_master(raw, raw_len);
+        for (size_t i = 0; i < batch; i++) {
+            if (_z_read_serial(&sock, buf, sizeof(buf)) != payload_len) {
+                fail("read a frame");
+            }
+        }
+    }
+    report(name, payload_len, z_clock_elapsed_us(&start));
+}
+
+// Frames sent by the link are read on the other side
+static void bench_tx(size_t payload_len) {
+    uint8_t payload[_Z_SERIAL_MTU_SIZE];
+    for (size_t i = 0; i < payload_len; i++) {
+        payload[i] = (uint8_t)i;
+    }
+    uint8_t raw[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+    uint8_t tmp[_Z_SERIAL_MFS_SIZE];
+    size_t raw_len =
+        _z_serial_msg_serialize(raw, _Z_SERIAL_MAX_COBS_BUF_SIZE, payload, payload_len, 0, tmp, sizeof(tmp));
+
+    z_clock_t start = z_clock_now();
+    for (size_t n = 0; n < FRAMES; n++) {
+        if (_z_send_serial(&sock, payload, payload_len) != payload_len) {
+            fail("send a frame");
+        }
+        read_master(raw, raw_len);
+    }
+    report("tx", payload_len, z_clock_elapsed_us(&start));
+}
+
+static void bench_crc(size_t len) {
+    uint8_t *buf = (uint8_t *)z_malloc(len);
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)i;
+    }
+    volatile uint32_t crc = 0;
+    size_t rounds = (64 * 1024 * 1024) / len;
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < rounds; i++) {
+        crc ^= _z_crc32(buf, len);
+    }
+    unsigned long elapsed = z_clock_elapsed_us(&start);
+    printf("crc  %5zu bytes: %9.1f MB/s\n", len, (double)(rounds * len) / (double)elapsed);
+    z_free(buf);
+}
+
+int main(void) {
+    open_pty();
+    size_t lens[] = {8, 64, 512, _Z_SERIAL_MTU_SIZE};
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        bench_rx("rx", lens[i], BATCH);
+    }
+    bench_rx("lat", 8, 1);
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        bench_tx(lens[i]);
+    }
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        bench_crc(lens[i]);
+    }
+    _z_serial_protocol_close(&sock);
+    close(master_fd);
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: This benchmark requires Z_FEATURE_LINK_SERIAL on a POSIX platform.\n");
+    return -2;
+}
+#endif
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Cost of a connect storm for a session holding many publishers: a peer connects and declares as many subscribers,
+// then undeclares them, declares them again and disconnects. The subscribers either match a publisher each, or all
+// of them match every publisher.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/net/filtering.h"
+#include "zenoh-pico/session/interest.h"
+#include "zenoh-pico/session/utils.h"
+
+#if Z_FEATURE_INTEREST == 1 && Z_FEATURE_MATCHING == 1
+static _z_transport_peer_common_t peer;
+static size_t notified;
+
+static void fail(const char *what) {
+    printf("Failed to %s\n", what);
+    exit(-1);
+}
+
+static void report(const char *name, size_t pubs, size_t subs, unsigned long elapsed_us) {
+    printf("%-10s %5zu pubs %5zu subs: %9.1f ms %8zu notifications\n", name, pubs, subs, (double)elapsed_us / 1000.0,
+           notified);
+    notified = 0;
+}
+
+static void on_matching(const _z_matching_status_t *status, void *arg) {
+    _ZP_UNUSED(status);
+    _ZP_UNUSED(arg);
+    notified++;
+}
+
+static void declare_all(_z_session_t *zn, size_t num, bool overlapping) {
+    char key[64];
+    for (size_t i = 0; i < num; i++) {
+        snprintf(key, sizeof(key), overlapping ? "storm/*/val" : "storm/%zu/val", i);
+        _z_wireexpr_t expr = _z_wireexpr_null();
+        expr._suffix = _z_string_view_make(key, strlen(key));
+        _z_n_msg_declare_t msg = {._decl = _z_make_decl_subscriber(&expr, (uint32_t)i),
+                                  ._interest_id = _z_optional_id_make_none()};
+        if (_z_interest_process_declares(zn, &msg, &peer) != _Z_RES_OK) {
+            fail("process a declaration");
+        }
+    }
+}
+
+static void bench(size_t num, bool overlapping) {
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    _z_session_t *zn = (_z_session_t *)z_malloc(sizeof(_z_session_t));
+    if (zn == NULL) {
+        fail("allocate the session");
+    }
+    memset(zn, 0, sizeof(_z_session_t));
+    if (_z_session_init(zn, &zid) != _Z_RES_OK) {
+        fail("init the session");
+    }
+    zn->_mode = Z_WHATAMI_PEER;
+    _z_session_rc_t rc = _z_session_rc_new(zn);
+
+    _z_write_filter_t *filters = (_z_write_filter_t *)z_malloc(num * sizeof(_z_write_filter_t));
+    if (filters == NULL) {
+        fail("allocate the publishers");
+    }
+    char key[64];
+    for (size_t i = 0; i < num; i++) {
+        snprintf(key, sizeof(key), "storm/%zu/val", i);
+        _z_string_t str = _z_string_alias_str(key);
+        _z_declared_keyexpr_t ke;
+        if (_z_declared_keyexpr_from_string(&ke, &str) != _Z_RES_OK ||
+            _z_write_filter_create(&rc, &filters[i], &ke, _Z_INTEREST_FLAG_SUBSCRIBERS, false, Z_LOCALITY_ANY) !=
+                _Z_RES_OK) {
+            fail("create a publisher");
+        }
+        _z_declared_keyexpr_clear(&ke);
+        _z_closure_matching_status_t callback = {.context = NULL, .call = on_matching, .drop = NULL};
+        if (_z_write_filter_ctx_add_callback(_Z_RC_IN_VAL(&filters[i].ctx), i, &callback) != _Z_RES_OK) {
+            fail("add a matching listener");
+        }
+    }
+    const char *name = overlapping ? "overlap" : "distinct";
+    printf("%s subscribers\n", name);
+
+    z_clock_t start = z_clock_now();
+    declare_all(zn, num, overlapping);
+    report("declare", num, num, z_clock_elapsed_us(&start));
+
+    start = z_clock_now();
+    for (size_t i = 0; i < num; i++) {
+        _z_declaration_t decl = _z_make_undecl_subscriber((uint32_t)i, NULL);
+        if (_z_interest_process_undeclares(zn, &decl, &peer) != _Z_RES_OK) {
+            fail("process an undeclaration");
+        }
+    }
+    report("undeclare", num, num, z_clock_elapsed_us(&start));
+
+    declare_all(zn, num, overlapping);
+    notified = 0;
+    start = z_clock_now();
+    _z_interest_peer_disconnected(zn, &peer);
+    report("disconnect", num, num, z_clock_elapsed_us(&start));
+
+    for (size_t i = 0; i < num; i++) {
+        _z_write_filter_clear(&filters[i]);
+    }
+    z_free(filters);
+    _z_session_rc_drop(&rc);
+}
+
+int main(void) {
+    peer._remote_whatami = Z_WHATAMI_PEER;
+    size_t nums[] = {500, 1000, 2000};
+    for (size_t i = 0; i < sizeof(nums) / sizeof(nums[0]); i++) {
+        bench(nums[i], false);
+        bench(nums[i], true);
+    }
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: This benchmark requires Z_FEATURE_INTEREST and Z_FEATURE_MATCHING.\n");
+    return -2;
+}
+#endif
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "zenoh-pico/runtime/runtime.h"
+#include "zenoh-pico/session/query.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/system/platform.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_QUERY == 1
+
+#define QUERY_NUM (3 * Z_QUERY_DEADLINE_QUEUE_SIZE)
+
+static _z_session_t zn;
+
+// Ids of the dropped queries, in drop order
+static _z_zint_t dropped[QUERY_NUM + 1];
+static volatile size_t dropped_num = 0;
+
+static void query_dropper(void *arg) {
+    assert(dropped_num < QUERY_NUM + 1);
+    dropped[dropped_num++] = (_z_zint_t)(uintptr_t)arg;
+}
+
+static _z_zint_t register_query(uint64_t timeout_ms) {
+    _z_session_mutex_lock(&zn);
+    _z_pending_query_t *pq = _z_unsafe_register_pending_query(&zn, timeout_ms);
+    assert(pq != NULL);
+    pq->_dropper = query_dropper;
+    pq->_arg = (void *)(uintptr_t)pq->_id;
+    _z_zint_t id = pq->_id;
+    _z_session_mutex_unlock(&zn);
+    return id;
+}
+
+static void setup(void) {
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    assert(_z_session_init(&zn, &zid) == _Z_RES_OK);
+    dropped_num = 0;
+}
+
+static uint64_t now_ms(void) { return (uint64_t)z_clock_elapsed_ms(&zn._pending_query_epoch); }
+
+void test_lookup(void) {
+    printf("Test: pending queries are found by id\n");
+    setup();
+    _z_zint_t ids[QUERY_NUM];
+    for (size_t i = 0; i < QUERY_NUM; i++) {
+        ids[i] = register_query(10000);
+    }
+    for (size_t i = 0; i < QUERY_NUM; i++) {
+        _z_pending_query_t *pq = _z_unsafe_get_pending_query_by_id(&zn, ids[i]);
+        assert(pq != NULL && pq->_id == ids[i]);
+    }
+    _z_unregister_pending_query(&zn, ids[0]);
+    assert(_z_unsafe_get_pending_query_by_id(&zn, ids[0]) == NULL);
+    assert(dropped_num == 1 && dropped[0] == ids[0]);
+    _z_session_clear(&zn);
+    assert(dropped_num == QUERY_NUM);
+}
+
+void test_deadline_order(void) {
+    printf("Test: queries time out in deadline order\n");
+    setup();
+    _z_zint_t late = register_query(300);
+    _z_zint_t soon = register_query(100);
+    _z_zint_t done = register_query(50);
+    _z_zint_t mid = register_query(200);
+    // Done before its deadline, its entry is skipped
+    _z_unregister_pending_query(&zn, done);
+    dropped_num = 0;
+
+    _z_session_mutex_lock(&zn);
+    uint64_t next_ms = _z_unsafe_pending_query_expire(&zn);
+    _z_session_mutex_unlock(&zn);
+    assert(dropped_num == 0);
+    assert(next_ms == _z_unsafe_get_pending_query_by_id(&zn, soon)->_deadline_ms);
+
+    z_sleep_ms(250);
+    _z_session_mutex_lock(&zn);
+    next_ms = _z_unsafe_pending_query_expire(&zn);
+    _z_session_mutex_unlock(&zn);
+    assert(dropped_num == 2 && dropped[0] == soon && dropped[1] == mid);
+    assert(next_ms == _z_unsafe_get_pending_query_by_id(&zn, late)->_deadline_ms);
+    _z_session_clear(&zn);
+}
+
+void test_queue_overflow(void) {
+    printf("Test: deadlines past the queue size are found again\n");
+    setup();
+    // Registered latest first, so that the soonest ones arrive once the queue is full
+    _z_zint_t ids[QUERY_NUM];
+    for (size_t i = 0; i < QUERY_NUM; i++) {
+        ids[i] = register_query(1000 + 10 * (QUERY_NUM - i));
+    }
+    assert(_z_pending_query_deadline_pqueue_size(&zn._pending_query_deadlines) <= Z_QUERY_DEADLINE_QUEUE_SIZE);
+    // Half of them are done
+    for (size_t i = 0; i < QUERY_NUM; i += 2) {
+        _z_unregister_pending_query(&zn, ids[i]);
+    }
+    dropped_num = 0;
+
+    // Every remaining query times out, the soonest first
+    size_t expected = QUERY_NUM - 1;
+    while (dropped_num < QUERY_NUM / 2) {
+        _z_session_mutex_lock(&zn);
+        size_t before = dropped_num;
+        uint64_t next_ms = _z_unsafe_pending_query_expire(&zn);
+        _z_session_mutex_unlock(&zn);
+        for (size_t i = before; i < dropped_num; i++) {
+            assert(dropped[i] == ids[expected]);
+            expected -= 2;
+        }
+        if (dropped_num < QUERY_NUM / 2) {
+            assert(next_ms == _z_unsafe_get_pending_query_by_id(&zn, ids[expected])->_deadline_ms);
+            uint64_t now = now_ms();
+            z_sleep_ms((unsigned long)((next_ms > now) ? next_ms - now : 0) + 1);
+        } else {
+            assert(next_ms == UINT64_MAX);
+        }
+    }
+    _z_session_clear(&zn);
+}
+
+void test_timer(void) {
+    printf("Test: the timer wakes up at the deadlines\n");
+    setup();
+#if Z_FEATURE_MULTI_THREAD == 1
+    assert(_z_runtime_start(&zn._runtime, NULL) == _Z_RES_OK);
+#endif
+    _z_zint_t late = register_query(400);
+    _z_pending_query_arm_timer(&zn);
+    // An earlier deadline spawns a timer of its own
+    _z_zint_t soon = register_query(100);
+    _z_pending_query_arm_timer(&zn);
+
+    z_clock_t start = z_clock_now();
+    unsigned long soon_elapsed_ms = 0;
+    while (dropped_num < 2 && z_clock_elapsed_ms(&start) < 2000) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        z_sleep_ms(1);
+#else
+        _z_runtime_spin_once(&zn._runtime);
+#endif
+        if (dropped_num == 1 && soon_elapsed_ms == 0) {
+            soon_elapsed_ms = z_clock_elapsed_ms(&start);
+        }
+    }
+    assert(dropped[0] == soon);
+    // Well before the timer used to wake up
+    assert(soon_elapsed_ms > 0 && soon_elapsed_ms < 400);
+    assert(dropped_num == 2 && dropped[1] == late);
+    assert(z_clock_elapsed_ms(&start) < 700);
+    _z_session_clear(&zn);
+}
+
+int main(void) {
+    test_lookup();
+    test_deadline_order();
+    test_queue_overflow();
+    test_timer();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_QUERY\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "zenoh-pico/api/advanced_subscriber.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_ADVANCED_SUBSCRIPTION == 1
+
+#define WINDOW Z_ADVANCED_SUBSCRIBER_REORDER_WINDOW_SIZE
+
+static void insert(_ze_advanced_subscriber_reorder_window_t *w, uint32_t sn) {
+    _z_sample_t *sample = z_malloc(sizeof(_z_sample_t));
+    assert(sample != NULL);
+    *sample = _z_sample_null();
+    assert(_ze_advanced_subscriber_reorder_window_insert(w, sn, sample) == _Z_RES_OK);
+}
+
+static void expect_pop(_ze_advanced_subscriber_reorder_window_t *w, uint32_t expected) {
+    uint32_t first = 0;
+    assert(_ze_advanced_subscriber_reorder_window_first(w, &first));
+    assert(first == expected);
+    uint32_t sn = 0;
+    _z_sample_t *sample = _ze_advanced_subscriber_reorder_window_pop_first(w, &sn);
+    assert(sample != NULL && sn == expected);
+    _z_sample_elem_free((void **)&sample);
+}
+
+static void expect_empty(_ze_advanced_subscriber_reorder_window_t *w) {
+    uint32_t sn;
+    assert(_ze_advanced_subscriber_reorder_window_len(w) == 0);
+    assert(!_ze_advanced_subscriber_reorder_window_first(w, &sn));
+    assert(_ze_advanced_subscriber_reorder_window_pop_first(w, &sn) == NULL);
+}
+
+void test_holes(void) {
+    printf("Test: samples come out in order across missing ones\n");
+    _ze_advanced_subscriber_reorder_window_t w;
+    _ze_advanced_subscriber_reorder_window_init(&w);
+    expect_empty(&w);
+    insert(&w, 10);
+    insert(&w, 14);
+    insert(&w, 12);
+    // Replaces the first one
+    insert(&w, 12);
+    assert(_ze_advanced_subscriber_reorder_window_len(&w) == 3);
+    expect_pop(&w, 10);
+    expect_pop(&w, 12);
+    insert(&w, 13);
+    expect_pop(&w, 13);
+    expect_pop(&w, 14);
+    expect_empty(&w);
+    _ze_advanced_subscriber_reorder_window_clear(&w);
+}
+
+void test_overflow(void) {
+    printf("Test: samples past the window wait for it\n");
+    _ze_advanced_subscriber_reorder_window_t w;
+    _ze_advanced_subscriber_reorder_window_init(&w);
+    // Every third sequence number over three windows, the furthest ones first
+    size_t num = 0;
+    for (uint32_t sn = 3 * WINDOW; sn >= 3; sn -= 3) {
+        insert(&w, 1000 + sn);
+        num++;
+    }
+    assert(_ze_advanced_subscriber_reorder_window_len(&w) == num);
+    // The window gets back to the ones moved out when inserting lower ones
+    insert(&w, 1000 + 4);
+    num++;
+    expect_pop(&w, 1000 + 3);
+    expect_pop(&w, 1000 + 4);
+    for (uint32_t sn = 6; sn <= 3 * WINDOW; sn += 3) {
+        expect_pop(&w, 1000 + sn);
+    }
+    expect_empty(&w);
+
+    // Some left waiting are freed with the window
+    for (uint32_t sn = 0; sn < 2 * WINDOW; sn += 2) {
+        insert(&w, sn);
+    }
+    _ze_advanced_subscriber_reorder_window_clear(&w);
+    expect_empty(&w);
+}
+
+void test_wraparound(void) {
+    printf("Test: sequence numbers wrap around in the window\n");
+    _ze_advanced_subscriber_reorder_window_t w;
+    _ze_advanced_subscriber_reorder_window_init(&w);
+    insert(&w, 1);
+    insert(&w, UINT32_MAX - 1);
+    insert(&w, 0);
+    expect_pop(&w, UINT32_MAX - 1);
+    expect_pop(&w, 0);
+    expect_pop(&w, 1);
+    expect_empty(&w);
+    _ze_advanced_subscriber_reorder_window_clear(&w);
+}
+
+int main(void) {
+    test_holes();
+    test_overflow();
+    test_wraparound();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_ADVANCED_SUBSCRIPTION\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/session/utils.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+static _z_wireexpr_t make_wireexpr(uint16_t id, _z_keyexpr_mapping_t mapping, const char *suffix) {
+    _z_wireexpr_t expr;
+    expr._id = id;
+    expr._mapping = mapping;
+    expr._suffix = suffix == NULL ? _z_string_view_null() : _z_string_view_make(suffix, strlen(suffix));
+    return expr;
+}
+
+static void assert_resolves(_z_session_t *zn, _z_wireexpr_t expr, _z_transport_peer_common_t *peer,
+                            const char *expected) {
+    _z_keyexpr_view_t view;
+    char buf[Z_MAX_KEYEXPR_LENGTH];
+    assert(_z_get_keyexpr_view_from_wireexpr(zn, &view, &expr, peer, buf, sizeof(buf)) == _Z_RES_OK);
+    const _z_string_t *ke = &_z_keyexpr_view_deref(&view)->_keyexpr;
+    assert(_z_string_len(ke) == strlen(expected));
+    assert(strncmp(_z_string_data(ke), expected, strlen(expected)) == 0);
+}
+
+void test_local_resources(_z_session_t *zn) {
+    uint16_t id_a, id_b, id_c;
+    _z_wireexpr_t expr_a = make_wireexpr(Z_RESOURCE_ID_NONE, _Z_KEYEXPR_MAPPING_LOCAL, "test/a");
+    _z_wireexpr_t expr_b = make_wireexpr(Z_RESOURCE_ID_NONE, _Z_KEYEXPR_MAPPING_LOCAL, "test/b");
+    assert(_z_register_resource(zn, &expr_a, Z_RESOURCE_ID_NONE, NULL, &id_a) == _Z_RES_OK);
+    assert(_z_register_resource(zn, &expr_b, Z_RESOURCE_ID_NONE, NULL, &id_b) == _Z_RES_OK);
+    assert(id_a != id_b);
+    // Declaring the same key again reuses the existing resource
+    assert(_z_register_resource(zn, &expr_a, Z_RESOURCE_ID_NONE, NULL, &id_c) == _Z_RES_OK);
+    assert(id_c == id_a);
+
+    // Resource with a prefix
+    _z_wireexpr_t expr_c = make_wireexpr(id_a, _Z_KEYEXPR_MAPPING_LOCAL, "/c");
+    assert(_z_register_resource(zn, &expr_c, Z_RESOURCE_ID_NONE, NULL, &id_c) == _Z_RES_OK);
+    assert(id_c != id_a && id_c != id_b);
+
+    _z_wireexpr_t by_id = make_wireexpr(id_a, _Z_KEYEXPR_MAPPING_LOCAL, NULL);
+    assert_resolves(zn, by_id, NULL, "test/a");
+    by_id = make_wireexpr(id_c, _Z_KEYEXPR_MAPPING_LOCAL, "/d");
+    assert_resolves(zn, by_id, NULL, "test/a/c/d");
+
+    // Two declarations of test/a, the first undeclare only decrements the count
+    assert(_z_unregister_resource(zn, id_a, NULL) == _Z_RESOURCE_POSITIVE_REF_COUNT);
+    assert_resolves(zn, make_wireexpr(id_a, _Z_KEYEXPR_MAPPING_LOCAL, NULL), NULL, "test/a");
+    assert(_z_unregister_resource(zn, id_a, NULL) == _Z_RES_OK);
+    assert(_z_unregister_resource(zn, id_a, NULL) == _Z_ERR_KEYEXPR_UNKNOWN);
+    _z_keyexpr_view_t view;
+    char buf[Z_MAX_KEYEXPR_LENGTH];
+    by_id = make_wireexpr(id_a, _Z_KEYEXPR_MAPPING_LOCAL, NULL);
+    assert(_z_get_keyexpr_view_from_wireexpr(zn, &view, &by_id, NULL, buf, sizeof(buf)) == _Z_ERR_KEYEXPR_UNKNOWN);
+
+    // The key is no longer indexed either, a new declaration gets a new id
+    uint16_t id_a2;
+    assert(_z_register_resource(zn, &expr_a, Z_RESOURCE_ID_NONE, NULL, &id_a2) == _Z_RES_OK);
+    assert(id_a2 != id_a);
+    assert_resolves(zn, make_wireexpr(id_b, _Z_KEYEXPR_MAPPING_LOCAL, NULL), NULL, "test/b");
+}
+
+void test_remote_resources(_z_session_t *zn) {
+    _z_transport_peer_common_t peer = {0};
+    uint16_t out_id;
+    // Many remote declarations to force the tables to grow
+    char key[32];
+    for (uint16_t id = 1; id <= 500; id++) {
+        snprintf(key, sizeof(key), "remote/%u", id);
+        _z_wireexpr_t expr = make_wireexpr(Z_RESOURCE_ID_NONE, _Z_KEYEXPR_MAPPING_REMOTE, key);
+        assert(_z_register_resource(zn, &expr, id, &peer, &out_id) == _Z_RES_OK);
+        assert(out_id == id);
+    }
+    for (uint16_t id = 1; id <= 500; id++) {
+        snprintf(key, sizeof(key), "remote/%u", id);
+        assert_resolves(zn, make_wireexpr(id, _Z_KEYEXPR_MAPPING_REMOTE, NULL), &peer, key);
+    }
+    // Remote ids don't resolve against the local table
+    _z_keyexpr_view_t view;
+    char buf[Z_MAX_KEYEXPR_LENGTH];
+    _z_wireexpr_t local = make_wireexpr(400, _Z_KEYEXPR_MAPPING_LOCAL, NULL);
+    assert(_z_get_keyexpr_view_from_wireexpr(zn, &view, &local, &peer, buf, sizeof(buf)) == _Z_ERR_KEYEXPR_UNKNOWN);
+
+    // Prefixed remote declaration
+    _z_wireexpr_t prefixed = make_wireexpr(7, _Z_KEYEXPR_MAPPING_REMOTE, "/x");
+    assert(_z_register_resource(zn, &prefixed, 1000, &peer, &out_id) == _Z_RES_OK);
+    assert_resolves(zn, make_wireexpr(1000, _Z_KEYEXPR_MAPPING_REMOTE, "/y"), &peer, "remote/7/x/y");
+
+    // Redeclaring an id replaces the previous resource
+    _z_wireexpr_t redecl = make_wireexpr(Z_RESOURCE_ID_NONE, _Z_KEYEXPR_MAPPING_REMOTE, "remote/other");
+    assert(_z_register_resource(zn, &redecl, 7, &peer, &out_id) == _Z_RES_OK);
+    assert_resolves(zn, make_wireexpr(7, _Z_KEYEXPR_MAPPING_REMOTE, NULL), &peer, "remote/other");
+
+    for (uint16_t id = 1; id <= 500; id += 2) {
+        assert(_z_unregister_resource(zn, id, &peer) == _Z_RES_OK);
+    }
+    for (uint16_t id = 2; id <= 500; id += 2) {
+        snprintf(key, sizeof(key), "remote/%u", id);
+        assert_resolves(zn, make_wireexpr(id, _Z_KEYEXPR_MAPPING_REMOTE, NULL), &peer, key);
+    }
+    _z_resource_table_free(&peer._remote_resources);
+    assert(peer._remote_resources == NULL);
+}
+
+void test_duplicate_keys(_z_session_t *zn) {
+    _z_transport_peer_common_t peer = {0};
+    uint16_t out_id;
+    // A peer may declare a key under several ids, the key is found as long as one of them remains
+    _z_wireexpr_t expr = make_wireexpr(Z_RESOURCE_ID_NONE, _Z_KEYEXPR_MAPPING_REMOTE, "remote/dup");
+    assert(_z_register_resource(zn, &expr, 1, &peer, &out_id) == _Z_RES_OK);
+    assert(_z_register_resource(zn, &expr, 2, &peer, &out_id) == _Z_RES_OK);
+    assert(_z_register_resource(zn, &expr, Z_RESOURCE_ID_NONE, &peer, &out_id) == _Z_RES_OK);
+    assert(out_id == 2);
+    assert(_z_unregister_resource(zn, 2, &peer) == _Z_RESOURCE_POSITIVE_REF_COUNT);
+    assert(_z_unregister_resource(zn, 2, &peer) == _Z_RES_OK);
+    assert(_z_register_resource(zn, &expr, Z_RESOURCE_ID_NONE, &peer, &out_id) == _Z_RES_OK);
+    assert(out_id == 1);
+
+    // The older declaration is removed first, the key remains found with the newer one
+    expr = make_wireexpr(Z_RESOURCE_ID_NONE, _Z_KEYEXPR_MAPPING_REMOTE, "remote/dup/older");
+    assert(_z_register_resource(zn, &expr, 3, &peer, &out_id) == _Z_RES_OK);
+    assert(_z_register_resource(zn, &expr, 4, &peer, &out_id) == _Z_RES_OK);
+    assert(_z_unregister_resource(zn, 3, &peer) == _Z_RES_OK);
+    assert(_z_register_resource(zn, &expr, Z_RESOURCE_ID_NONE, &peer, &out_id) == _Z_RES_OK);
+    assert(out_id == 4);
+    assert_resolves(zn, make_wireexpr(4, _Z_KEYEXPR_MAPPING_REMOTE, NULL), &peer, "remote/dup/older");
+    _z_resource_table_free(&peer._remote_resources);
+}
+
+int main(void) {
+    _z_session_t zn;
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    assert(_z_session_init(&zn, &zid) == _Z_RES_OK);
+    test_local_resources(&zn);
+    test_remote_resources(&zn);
+    test_duplicate_keys(&zn);
+    _z_session_clear(&zn);
+    return 0;
+}
@@ -0,0 +1,274 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/session_fixture.h"
+#include "zenoh-pico/net/sample.h"
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/rx_dispatch.h"
+#include "zenoh-pico/session/subscription.h"
+
+#if Z_FEATURE_RX_DISPATCH == 1
+
+#define KEYEXPR_PREFIX "zenoh-pico/tests/rx/"
+#define WORKERS 2
+#define KEYS 4
+#define SAMPLES 400
+#define TIMEOUT_MS 5000
+
+static const char *keys[KEYS] = {KEYEXPR_PREFIX "0", KEYEXPR_PREFIX "1", KEYEXPR_PREFIX "2", KEYEXPR_PREFIX "3"};
+static uint32_t sub_ids[KEYS];
+static uint32_t wildcard_id;
+
+// Per key, written by the worker of the key only
+static uint32_t next_value[KEYS];
+static uint32_t wildcard_next_value[KEYS];
+static _z_atomic_size_t received;
+static _z_atomic_size_t wildcard_received;
+static _z_atomic_size_t wildcard_running;
+static _z_atomic_size_t in_callback;
+static _z_atomic_bool_t blocked;
+
+static size_t worker_of(size_t k) { return sub_ids[k] % WORKERS; }
+
+static size_t key_index(const _z_sample_t *sample) {
+    const _z_string_t *key = &_z_sample_get_ref(sample)->keyexpr._inner._keyexpr;
+    for (size_t i = 0; i < KEYS; i++) {
+        if (_z_string_len(key) == strlen(keys[i]) && strncmp(_z_string_data(key), keys[i], strlen(keys[i])) == 0) {
+            return i;
+        }
+    }
+    assert(false);
+    return KEYS;
+}
+
+static uint32_t value_of(const _z_sample_t *sample) {
+    uint32_t value;
+    assert(_z_bytes_to_buf(&_z_sample_get_ref(sample)->payload, (uint8_t *)&value, sizeof(value)) == sizeof(value));
+    return value;
+}
+
+static void on_sample(_z_sample_t *sample, void *arg) {
+    _ZP_UNUSED(arg);
+    _z_atomic_size_fetch_add(&in_callback, 1, _z_memory_order_acq_rel);
+    size_t k = key_index(sample);
+    // Key 0 waits to be released
+    while (k == 0 && _z_atomic_bool_load(&blocked, _z_memory_order_acquire)) {
+        z_sleep_ms(1);
+    }
+    assert(value_of(sample) == next_value[k]);
+    next_value[k]++;
+    _z_atomic_size_fetch_add(&received, 1, _z_memory_order_acq_rel);
+}
+
+static void on_any_sample(_z_sample_t *sample, void *arg) {
+    _ZP_UNUSED(arg);
+    // Never runs twice at once, although its samples match the subscriptions of both workers
+    assert(_z_atomic_size_fetch_add(&wildcard_running, 1, _z_memory_order_acq_rel) == 0);
+    size_t k = key_index(sample);
+    assert(value_of(sample) == wildcard_next_value[k]);
+    wildcard_next_value[k]++;
+    z_sleep_us(10);
+    _z_atomic_size_fetch_sub(&wildcard_running, 1, _z_memory_order_acq_rel);
+    _z_atomic_size_fetch_add(&wildcard_received, 1, _z_memory_order_acq_rel);
+}
+
+static uint32_t subscribe(const char *key, _z_closure_sample_callback_t callback) {
+    _z_subscription_t sub = {0};
+    sub._id = _z_get_entity_id(session);
+    _z_string_t str = _z_string_alias_str(key);
+    assert(_z_declared_keyexpr_from_string(&sub._key, &str) == _Z_RES_OK);
+    sub._allowed_origin = Z_LOCALITY_ANY;
+    sub._callback = callback;
+    _z_subscription_rc_t rc = _z_register_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    assert(!_Z_RC_IS_NULL(&rc));
+    _z_subscription_rc_drop(&rc);
+    return sub._id;
+}
+
+static void setup(bool wildcard) {
+    setup_session();
+    assert(_z_rx_dispatch_start(&session->_rx_dispatch, session, WORKERS) == _Z_RES_OK);
+    for (size_t i = 0; i < KEYS; i++) {
+        next_value[i] = 0;
+        wildcard_next_value[i] = 0;
+    }
+    _z_atomic_size_init(&received, 0);
+    _z_atomic_size_init(&wildcard_received, 0);
+    _z_atomic_size_init(&wildcard_running, 0);
+    _z_atomic_size_init(&in_callback, 0);
+    _z_atomic_bool_init(&blocked, false);
+
+    // Subscriptions are spread over the workers by id: keys 0 and 1 are handled by one worker, keys 2 and 3 by the
+    // other
+    sub_ids[0] = subscribe(keys[0], on_sample);
+    sub_ids[2] = subscribe(keys[2], on_sample);
+    sub_ids[1] = subscribe(keys[1], on_sample);
+    sub_ids[3] = subscribe(keys[3], on_sample);
+    assert(worker_of(0) == worker_of(1) && worker_of(2) == worker_of(3) && worker_of(0) != worker_of(2));
+    if (wildcard) {
+        wildcard_id = subscribe(KEYEXPR_PREFIX "**", on_any_sample);
+    }
+}
+
+static void put(size_t k, uint32_t value) {
+    _z_keyexpr_t keyexpr;
+    _z_string_t str = _z_string_alias_str(keys[k]);
+    _z_keyexpr_from_string(&keyexpr, &str);
+    _z_bytes_t payload;
+    assert(_z_bytes_copy_from_buf(&payload, (const uint8_t *)&value, sizeof(value)) == _Z_RES_OK);
+    assert(_z_trigger_subscriptions_impl(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &keyexpr, &payload, NULL,
+                                         Z_SAMPLE_KIND_PUT, NULL, _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT),
+                                         NULL, Z_RELIABILITY_RELIABLE, NULL, &peer_a) == _Z_RES_OK);
+    _z_bytes_clear(&payload);
+    _z_keyexpr_clear(&keyexpr);
+}
+
+static bool wait_for(_z_atomic_size_t *counter, size_t value) {
+    z_clock_t start = z_clock_now();
+    while (_z_atomic_size_load(counter, _z_memory_order_acquire) < value) {
+        if (z_clock_elapsed_ms(&start) > TIMEOUT_MS) {
+            return false;
+        }
+        z_sleep_ms(1);
+    }
+    return true;
+}
+
+static zp_rx_dispatch_worker_stats_t stats_of(size_t k) {
+    zp_rx_dispatch_worker_stats_t stats;
+    assert(zp_rx_dispatch_workers(&session_rc) == WORKERS);
+    assert(zp_rx_dispatch_worker_stats(&session_rc, WORKERS, &stats) != _Z_RES_OK);
+    assert(zp_rx_dispatch_worker_stats(&session_rc, worker_of(k), &stats) == _Z_RES_OK);
+    return stats;
+}
+
+void test_key_order(void) {
+    printf("Test: samples of a subscription are delivered in order, on one worker at a time\n");
+    setup(true);
+    uint32_t sent[KEYS] = {0};
+    for (size_t i = 0; i < SAMPLES; i++) {
+        size_t k = (i * 7) % KEYS;
+        put(k, sent[k]++);
+    }
+    assert(wait_for(&received, SAMPLES));
+    assert(wait_for(&wildcard_received, SAMPLES));
+    for (size_t k = 0; k < KEYS; k++) {
+        assert(next_value[k] == sent[k] && wildcard_next_value[k] == sent[k]);
+    }
+    zp_rx_dispatch_worker_stats_t first = stats_of(0);
+    zp_rx_dispatch_worker_stats_t second = stats_of(2);
+    size_t wildcard_first = (wildcard_id % WORKERS == worker_of(0)) ? SAMPLES : 0;
+    assert(first.dispatched + second.dispatched == 2 * SAMPLES);
+    assert(first.dispatched == sent[0] + sent[1] + wildcard_first);
+    assert(first.capacity == Z_RX_DISPATCH_QUEUE_SIZE && first.depth == 0);
+    assert(first.max_depth <= Z_RX_DISPATCH_QUEUE_SIZE);
+    cleanup_session();
+}
+
+void test_slow_callback(void) {
+    printf("Test: a slow callback only holds back the subscriptions of its worker\n");
+    setup(false);
+    _z_atomic_bool_store(&blocked, true, _z_memory_order_release);
+    put(0, 0);
+    assert(wait_for(&in_callback, 1));
+    // Queued behind the blocked callback
+    put(0, 1);
+    put(1, 0);
+    put(1, 1);
+    // Handled by the other worker
+    put(2, 0);
+    put(3, 0);
+    assert(wait_for(&received, 2));
+    assert(next_value[2] == 1 && next_value[3] == 1 && next_value[0] == 0 && next_value[1] == 0);
+    zp_rx_dispatch_worker_stats_t stats = stats_of(0);
+    assert(stats.depth == 3 && stats.max_depth >= 3 && stats.stalls == 0);
+
+    _z_atomic_bool_store(&blocked, false, _z_memory_order_release);
+    assert(wait_for(&received, 6));
+    assert(next_value[0] == 2 && next_value[1] == 2);
+    stats = stats_of(0);
+    assert(stats.depth == 0 && stats.dispatched == 4);
+    cleanup_session();
+}
+
+static void *release_later(void *arg) {
+    _ZP_UNUSED(arg);
+    z_sleep_ms(200);
+    _z_atomic_bool_store(&blocked, false, _z_memory_order_release);
+    return NULL;
+}
+
+void test_backpressure(void) {
+    printf("Test: a full queue holds the read task back\n");
+    setup(false);
+    _z_atomic_bool_store(&blocked, true, _z_memory_order_release);
+    put(0, 0);
+    assert(wait_for(&in_callback, 1));
+    // The sample in the callback holds a slot
+    for (uint32_t i = 1; i < Z_RX_DISPATCH_QUEUE_SIZE; i++) {
+        put(0, i);
+    }
+    zp_rx_dispatch_worker_stats_t stats = stats_of(0);
+    assert(stats.depth == Z_RX_DISPATCH_QUEUE_SIZE - 1 && stats.stalls == 0);
+    _z_task_t task;
+    assert(_z_task_init(&task, NULL, release_later, NULL) == _Z_RES_OK);
+    // Waits for the blocked callback to return and a sample to leave the queue
+    put(0, Z_RX_DISPATCH_QUEUE_SIZE);
+    assert(_z_atomic_size_load(&received, _z_memory_order_acquire) >= 1);
+    assert(_z_task_join(&task) == _Z_RES_OK);
+    assert(wait_for(&received, Z_RX_DISPATCH_QUEUE_SIZE + 1));
+    stats = stats_of(0);
+    assert(stats.stalls == 1 && stats.max_depth == Z_RX_DISPATCH_QUEUE_SIZE - 1);
+    assert(stats.dispatched == Z_RX_DISPATCH_QUEUE_SIZE + 1);
+    cleanup_session();
+}
+
+void test_close(void) {
+    printf("Test: closing the session waits for the running callbacks and drops the queued samples\n");
+    setup(false);
+    _z_atomic_bool_store(&blocked, true, _z_memory_order_release);
+    put(0, 0);
+    assert(wait_for(&in_callback, 1));
+    for (uint32_t i = 1; i <= 5; i++) {
+        put(0, i);
+    }
+    _z_task_t task;
+    assert(_z_task_init(&task, NULL, release_later, NULL) == _Z_RES_OK);
+    assert(_z_session_close(session) == _Z_RES_OK);
+    assert(_z_atomic_size_load(&received, _z_memory_order_acquire) == 1);
+    assert(_z_task_join(&task) == _Z_RES_OK);
+    zp_rx_dispatch_worker_stats_t stats = stats_of(0);
+    assert(stats.dispatched == 1);
+    cleanup_session();
+}
+
+int main(void) {
+    test_key_order();
+    test_slow_callback();
+    test_backpressure();
+    test_close();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_RX_DISPATCH\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/collections/bytes.h"
+#include "zenoh-pico/protocol/codec/core.h"
+#include "zenoh-pico/protocol/iobuf.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_RX_ZERO_COPY == 1
+
+#define BUF_SIZE 64
+#define PAYLOAD_LEN 16
+
+// Append a length prefixed payload to the zbuf, as the link would
+static void recv_payload(_z_zbuf_t *zbf, uint8_t seed) {
+    uint8_t *w = _z_zbuf_get_wptr(zbf);
+    w[0] = PAYLOAD_LEN;
+    for (size_t i = 0; i < PAYLOAD_LEN; i++) {
+        w[1 + i] = (uint8_t)(seed + i);
+    }
+    _z_zbuf_set_wpos(zbf, _z_zbuf_get_wpos(zbf) + 1 + PAYLOAD_LEN);
+}
+
+static void check_payload(const _z_bytes_t *bs, uint8_t seed) {
+    assert(_z_bytes_num_slices(bs) == 1);
+    const _z_slice_t *s = _z_bytes_get_slice(bs, 0);
+    assert(s->len == PAYLOAD_LEN);
+    for (size_t i = 0; i < PAYLOAD_LEN; i++) {
+        assert(s->start[i] == (uint8_t)(seed + i));
+    }
+}
+
+// Decode a payload the way the rx path does, from a view on the transport buffer
+static _z_bytes_view_t decode_payload(_z_zbuf_t *zbf) {
+    _z_zbuf_t view = _z_zbuf_view(zbf, _z_zbuf_readable_len(zbf));
+    _z_bytes_view_t bs;
+    assert(_z_bytes_decode(&bs, &view) == _Z_RES_OK);
+    _z_zbuf_set_rpos(zbf, _z_zbuf_get_rpos(zbf) + _z_zbuf_get_rpos(&view));
+    return bs;
+}
+
+void test_retain_shares_buffer(void) {
+    printf("Test: retained payload shares the rx buffer\n");
+    _z_zbuf_t zbf;
+    assert(_z_zbuf_init_shared(&zbf, BUF_SIZE) == _Z_RES_OK);
+    recv_payload(&zbf, 0x10);
+    _z_bytes_view_t view = decode_payload(&zbf);
+
+    _z_bytes_t retained;
+    assert(_z_bytes_copy(&retained, _z_bytes_view_deref(&view)) == _Z_RES_OK);
+    // Same bytes, no copy
+    assert(_z_bytes_get_slice(&retained, 0)->start == _z_bytes_get_slice(_z_bytes_view_deref(&view), 0)->start);
+    assert(!_z_shared_buf_is_unique(zbf._shared));
+
+    // Next receive goes to a fresh buffer, the retained payload is left untouched
+    uint8_t *old_buf = zbf._ios._buf;
+    _z_zbuf_reset(&zbf);
+    assert(zbf._ios._buf != old_buf);
+    recv_payload(&zbf, 0x80);
+    _z_bytes_view_t next = decode_payload(&zbf);
+    check_payload(_z_bytes_view_deref(&next), 0x80);
+    check_payload(&retained, 0x10);
+
+    // Retained copies hold their own reference
+    _z_bytes_t copy;
+    assert(_z_bytes_copy(&copy, &retained) == _Z_RES_OK);
+    assert(_z_bytes_get_slice(&copy, 0)->start == _z_bytes_get_slice(&retained, 0)->start);
+    _z_bytes_clear(&retained);
+    check_payload(&copy, 0x10);
+
+    // The buffer outlives the zbuf
+    _z_zbuf_clear(&zbf);
+    check_payload(&copy, 0x10);
+    _z_bytes_clear(&copy);
+}
+
+void test_unretained_buffer_is_reused(void) {
+    printf("Test: unretained rx buffer is reused\n");
+    _z_zbuf_t zbf;
+    assert(_z_zbuf_init_shared(&zbf, BUF_SIZE) == _Z_RES_OK);
+    uint8_t *buf = zbf._ios._buf;
+    for (uint8_t i = 0; i < 8; i++) {
+        _z_zbuf_reset(&zbf);
+        recv_payload(&zbf, i);
+        _z_bytes_view_t view = decode_payload(&zbf);
+        check_payload(_z_bytes_view_deref(&view), i);
+        assert(zbf._ios._buf == buf);
+    }
+    _z_zbuf_clear(&zbf);
+}
+
+void test_compact_keeps_unread_bytes(void) {
+    printf("Test: compact moves unread bytes to a fresh buffer\n");
+    _z_zbuf_t zbf;
+    assert(_z_zbuf_init_shared(&zbf, BUF_SIZE) == _Z_RES_OK);
+    recv_payload(&zbf, 0x20);
+    recv_payload(&zbf, 0x40);
+    _z_bytes_view_t view = decode_payload(&zbf);
+    _z_bytes_t retained;
+    assert(_z_bytes_copy(&retained, _z_bytes_view_deref(&view)) == _Z_RES_OK);
+
+    uint8_t *old_buf = zbf._ios._buf;
+    _z_zbuf_compact(&zbf);
+    assert(zbf._ios._buf != old_buf);
+    assert(_z_zbuf_get_rpos(&zbf) == 0);
+    assert(_z_zbuf_readable_len(&zbf) == 1 + PAYLOAD_LEN);
+    check_payload(&retained, 0x20);
+    _z_bytes_view_t next = decode_payload(&zbf);
+    check_payload(_z_bytes_view_deref(&next), 0x40);
+
+    _z_zbuf_clear(&zbf);
+    check_payload(&retained, 0x20);
+    _z_bytes_clear(&retained);
+}
+
+void test_plain_buffer_is_copied(void) {
+    printf("Test: payloads of plain buffers are copied\n");
+    _z_zbuf_t zbf;
+    assert(_z_zbuf_init(&zbf, BUF_SIZE) == _Z_RES_OK);
+    recv_payload(&zbf, 0x30);
+    _z_bytes_view_t view = decode_payload(&zbf);
+    _z_bytes_t retained;
+    assert(_z_bytes_copy(&retained, _z_bytes_view_deref(&view)) == _Z_RES_OK);
+    assert(_z_bytes_get_slice(&retained, 0)->start != _z_bytes_get_slice(_z_bytes_view_deref(&view), 0)->start);
+    _z_zbuf_clear(&zbf);
+    check_payload(&retained, 0x30);
+    _z_bytes_clear(&retained);
+
+    // A user context without deleter is not taken for a shared buffer
+    uint8_t data[PAYLOAD_LEN] = {0};
+    _z_slice_t s = _z_slice_from_buf_custom_deleter(data, sizeof(data), _z_delete_context_create(NULL, &zbf));
+    assert(_z_slice_get_shared_buf(&s) == NULL);
+}
+
+int main(void) {
+    test_retain_shares_buffer();
+    test_unretained_buffer_is_reused();
+    test_compact_keeps_unread_bytes();
+    test_plain_buffer_is_copied();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_RX_ZERO_COPY\n");
+    return 0;
+}
+#endif
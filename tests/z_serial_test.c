@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// For the pseudo-terminal functions
+#if !defined(_XOPEN_SOURCE)
+#define _XOPEN_SOURCE 600
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/utils/checksum.h"
+
+#if Z_FEATURE_LINK_SERIAL == 1 && (defined(ZENOH_LINUX) || defined(ZENOH_MACOS) || defined(ZENOH_BSD))
+#define SERIAL_PTY_TEST
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "zenoh-pico/link/endpoint.h"
+#include "zenoh-pico/link/transport/serial_protocol.h"
+#include "zenoh-pico/protocol/codec/serial.h"
+#endif
+
+#undef NDEBUG
+#include <assert.h>
+
+// The checksum as computed bit by bit
+static uint32_t crc32_reference(const uint8_t *message, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc = crc ^ (uint32_t)message[i];
+        for (uint8_t j = 0; j < (uint8_t)8; j++) {
+            crc = (crc >> 1) ^ ((uint32_t)0x04C11DB7 & (uint32_t)(-(int32_t)(crc & (uint32_t)1)));
+        }
+    }
+    return ~crc;
+}
+
+void test_crc32(void) {
+    printf("Test: CRC32 matches the bitwise computation\n");
+    assert(_z_crc32((const uint8_t *)"123456789", 9) == 0xFC4F2BE9);
+    assert(_z_crc32(NULL, 0) == 0);
+
+    uint8_t buf[256];
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)rand();
+    }
+    // Every length at every alignment
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t len = 0; offset + len <= sizeof(buf); len++) {
+            assert(_z_crc32(&buf[offset], len) == crc32_reference(&buf[offset], len));
+        }
+    }
+}
+
+#ifdef SERIAL_PTY_TEST
+static int master_fd = -1;
+
+static void open_pty(_z_serial_socket_t *sock) {
+    master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    assert(master_fd >= 0);
+    assert(grantpt(master_fd) == 0 && unlockpt(master_fd) == 0);
+    char locator[128];
+    snprintf(locator, sizeof(locator), "serial/%s#baudrate=115200", ptsname(master_fd));
+    _z_string_t str = _z_string_alias_str(locator);
+    _z_endpoint_t ep;
+    assert(_z_endpoint_from_string(&ep, &str) == _Z_RES_OK);
+    // Listening skips the connection handshake
+    assert(_z_serial_protocol_listen(sock, &ep) == _Z_RES_OK);
+    _z_endpoint_clear(&ep);
+}
+
+static void close_pty(_z_serial_socket_t *sock) {
+    _z_serial_protocol_close(sock);
+    close(master_fd);
+}
+
+// Append the frame of the payload to raw
+static size_t append_frame(uint8_t *raw, size_t raw_len, const uint8_t *payload, size_t len) {
+    uint8_t tmp[_Z_SERIAL_MFS_SIZE];
+    size_t n = _z_serial_msg_serialize(&raw[raw_len], _Z_SERIAL_MAX_COBS_BUF_SIZE, payload, len, 0, tmp, sizeof(tmp));
+    assert(n != SIZE_MAX);
+    return raw_len + n;
+}
+
+static void write_master(const uint8_t *raw, size_t len) {
+    size_t written = 0;
+    while (written < len) {
+        ssize_t wb = write(master_fd, &raw[written], len - written);
+        assert(wb > 0);
+        written += (size_t)wb;
+    }
+}
+
+static void expect_read(_z_serial_socket_t *sock, const uint8_t *payload, size_t len) {
+    uint8_t buf[_Z_SERIAL_MTU_SIZE];
+    assert(_z_read_serial(sock, buf, sizeof(buf)) == len);
+    assert(memcmp(buf, payload, len) == 0);
+}
+
+void test_rx_frames(void) {
+    printf("Test: frames received at once are read one by one\n");
+    _z_serial_socket_t sock;
+    open_pty(&sock);
+    uint8_t payloads[3][_Z_SERIAL_MTU_SIZE];
+    size_t lens[3] = {1, 700, _Z_SERIAL_MTU_SIZE};
+    uint8_t raw[3 * _Z_SERIAL_MAX_COBS_BUF_SIZE];
+    size_t raw_len = 0;
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < lens[i]; j++) {
+            payloads[i][j] = (uint8_t)(i + j);
+        }
+        raw_len = append_frame(raw, raw_len, payloads[i], lens[i]);
+    }
+    write_master(raw, raw_len);
+    for (size_t i = 0; i < 3; i++) {
+        expect_read(&sock, payloads[i], lens[i]);
+    }
+
+    // Split across writes
+    raw_len = append_frame(raw, 0, payloads[1], lens[1]);
+    write_master(raw, 10);
+    write_master(&raw[10], raw_len - 10);
+    expect_read(&sock, payloads[1], lens[1]);
+    close_pty(&sock);
+}
+
+void test_rx_resync(void) {
+    printf("Test: the reader resynchronizes after a frame too long\n");
+    _z_serial_socket_t sock;
+    open_pty(&sock);
+    uint8_t raw[3 * _Z_SERIAL_MAX_COBS_BUF_SIZE];
+    memset(raw, 0x55, 2 * _Z_SERIAL_MAX_COBS_BUF_SIZE);
+    raw[2 * _Z_SERIAL_MAX_COBS_BUF_SIZE - 1] = 0x00;
+    const uint8_t payload[] = {1, 2, 3, 0, 5};
+    size_t raw_len = append_frame(raw, 2 * _Z_SERIAL_MAX_COBS_BUF_SIZE, payload, sizeof(payload));
+    write_master(raw, raw_len);
+    // Dropped frames read as errors
+    uint8_t buf[_Z_SERIAL_MTU_SIZE];
+    size_t errors = 0;
+    size_t rb;
+    while ((rb = _z_read_serial(&sock, buf, sizeof(buf))) == SIZE_MAX) {
+        errors++;
+        assert(errors < 4);
+    }
+    assert(errors > 0 && rb == sizeof(payload) && memcmp(buf, payload, sizeof(payload)) == 0);
+    close_pty(&sock);
+}
+
+void test_tx_frames(void) {
+    printf("Test: sent frames are decoded on the other side\n");
+    _z_serial_socket_t sock;
+    open_pty(&sock);
+    uint8_t payload[_Z_SERIAL_MTU_SIZE];
+    for (size_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i * 7);
+    }
+    for (size_t round = 0; round < 3; round++) {
+        assert(_z_send_serial(&sock, payload, sizeof(payload)) == sizeof(payload));
+        uint8_t raw[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+        size_t raw_len = 0;
+        do {
+            ssize_t rb = read(master_fd, &raw[raw_len], 1);
+            assert(rb == 1);
+            raw_len++;
+        } while (raw[raw_len - 1] != 0x00);
+        uint8_t buf[_Z_SERIAL_MTU_SIZE];
+        uint8_t tmp[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+        uint8_t header = 0xFF;
+        assert(_z_serial_msg_deserialize(raw, raw_len, buf, sizeof(buf), &header, tmp, sizeof(tmp)) ==
+               sizeof(payload));
+        assert(header == 0 && memcmp(buf, payload, sizeof(payload)) == 0);
+    }
+    close_pty(&sock);
+}
+#endif
+
+int main(void) {
+    test_crc32();
+#ifdef SERIAL_PTY_TEST
+    test_rx_frames();
+    test_rx_resync();
+    test_tx_frames();
+#else
+    printf("Missing config token to run the serial link tests. They require: Z_FEATURE_LINK_SERIAL on POSIX\n");
+#endif
+    return 0;
+}
@@ -240,6 +240,34 @@ static void test_mixed_push_pop(void) {
     intdeque_destroy(&d);
 }
 
+static void test_get(void) {
+    printf("Test: get indexes from the front across wrap-around\n");
+    intdeque_t d = intdeque_new();
+    assert(intdeque_get(&d, 0) == NULL);
+    int v;
+    for (int i = 0; i < 6; i++) {
+        v = i;
+        assert(intdeque_push_back(&d, &v));
+    }
+    for (int i = 0; i < 4; i++) {
+        assert(intdeque_pop_front(&d, NULL));
+    }
+    // [4, 5, 10, 11, 12, 13], stored across the end of the buffer
+    for (int i = 0; i < 4; i++) {
+        v = 10 + i;
+        assert(intdeque_push_back(&d, &v));
+    }
+    assert(*intdeque_get(&d, 0) == 4);
+    assert(*intdeque_get(&d, 1) == 5);
+    for (size_t i = 2; i < 6; i++) {
+        assert(*intdeque_get(&d, i) == 10 + (int)i - 2);
+    }
+    assert(intdeque_get(&d, 6) == NULL);
+    *intdeque_get(&d, 3) = 42;
+    assert(*intdeque_get(&d, 3) == 42);
+    intdeque_destroy(&d);
+}
+
 static void test_destroy_non_empty(void) {
     printf("Test: destroy on non-empty deque does not crash\n");
     intdeque_t d = intdeque_new();
@@ -266,6 +294,7 @@ int main(void) {
     test_wrap_around_back();
     test_wrap_around_front();
     test_mixed_push_pop();
+    test_get();
     test_destroy_non_empty();
     printf("All deque tests passed.\n");
     return 0;
@@ -0,0 +1,385 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "utils/session_fixture.h"
+#include "zenoh-pico/net/sample.h"
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/subscription.h"
+
+#if Z_FEATURE_SUBSCRIBER_BATCHING == 1
+
+#define KEYEXPR "zenoh-pico/tests/batch"
+#define MAX_SAMPLES 128
+
+typedef struct {
+    // Payloads received, in order
+    uint32_t values[MAX_SAMPLES];
+    // Where the payloads were read from
+    const uint8_t *payloads[MAX_SAMPLES];
+    size_t len;
+    size_t calls;
+    // Length of the last batch
+    size_t last_len;
+    bool dropped;
+} received_t;
+
+static _z_declared_keyexpr_t keyexpr;
+// The received batch the payloads are borrowed from
+static uint32_t wire[MAX_SAMPLES];
+
+static void on_batch(_z_sample_t *samples, size_t len, void *arg) {
+    received_t *r = (received_t *)arg;
+    assert(!r->dropped && len > 0);
+    for (size_t i = 0; i < len; i++) {
+        const _z_sample_owned_t *sample = _z_sample_get_ref(&samples[i]);
+        assert(sample != NULL && _z_declared_keyexpr_equals(&sample->keyexpr, &keyexpr));
+        assert(_z_bytes_to_buf(&sample->payload, (uint8_t *)&r->values[r->len], sizeof(uint32_t)) == sizeof(uint32_t));
+        r->payloads[r->len] = _z_bytes_get_slice(&sample->payload, 0)->start;
+        r->len++;
+    }
+    r->calls++;
+    r->last_len = len;
+}
+
+static void on_sample(_z_sample_t *sample, void *arg) { on_batch(sample, 1, arg); }
+
+static void on_drop(void *arg) { ((received_t *)arg)->dropped = true; }
+
+static void setup(void) {
+    setup_session();
+    _z_string_t str = _z_string_alias_str(KEYEXPR);
+    assert(_z_declared_keyexpr_from_string(&keyexpr, &str) == _Z_RES_OK);
+}
+
+static void cleanup(void) {
+    cleanup_session();
+    _z_declared_keyexpr_clear(&keyexpr);
+}
+
+static _z_subscription_rc_t subscribe_batch(received_t *r, _z_closure_sample_batch_callback_t callback,
+                                            size_t max_samples) {
+    *r = (received_t){0};
+    _z_subscription_t sub = {0};
+    sub._id = _z_get_entity_id(session);
+    assert(_z_declared_keyexpr_copy(&sub._key, &keyexpr) == _Z_RES_OK);
+    sub._allowed_origin = Z_LOCALITY_ANY;
+    sub._dropper = on_drop;
+    sub._arg = r;
+    if (max_samples == 0) {
+        sub._callback = on_sample;
+    } else {
+        sub._batch = _z_subscription_batch_new(callback, max_samples);
+        assert(sub._batch != NULL);
+    }
+    _z_subscription_rc_t rc = _z_register_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    assert(!_Z_RC_IS_NULL(&rc));
+    return rc;
+}
+
+static _z_subscription_rc_t subscribe(received_t *r, size_t max_samples) {
+    return subscribe_batch(r, on_batch, max_samples);
+}
+
+// Published by the session, the payload only lives during the call
+static void put(uint32_t value) {
+    _z_bytes_t payload;
+    assert(_z_bytes_copy_from_buf(&payload, (const uint8_t *)&value, sizeof(value)) == _Z_RES_OK);
+    assert(_z_trigger_subscriptions_impl(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &keyexpr._inner, &payload, NULL,
+                                         Z_SAMPLE_KIND_PUT, NULL, _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT),
+                                         NULL, Z_RELIABILITY_RELIABLE, NULL, NULL) == _Z_RES_OK);
+    _z_bytes_clear(&payload);
+}
+
+// Received from a peer, the payload lives in the received batch and the key expression on the stack of the call
+static void receive(uint32_t value) {
+    wire[value] = value;
+    _z_slice_t slice = _z_slice_alias_buf((const uint8_t *)&wire[value], sizeof(uint32_t));
+    _z_bytes_t payload;
+    assert(_z_bytes_from_slice(&payload, &slice) == _Z_RES_OK);
+    char key[sizeof(KEYEXPR)];
+    memcpy(key, KEYEXPR, sizeof(KEYEXPR));
+    _z_keyexpr_t ke = {._keyexpr = _z_string_alias_substr(key, sizeof(KEYEXPR) - 1)};
+    assert(_z_trigger_subscriptions_impl(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &ke, &payload, NULL,
+                                         Z_SAMPLE_KIND_PUT, NULL, _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT),
+                                         NULL, Z_RELIABILITY_RELIABLE, NULL, &peer_a) == _Z_RES_OK);
+    _z_bytes_clear(&payload);
+    memset(key, 0, sizeof(key));
+}
+
+static void expect_values(const received_t *r, size_t len) {
+    assert(r->len == len);
+    for (size_t i = 0; i < len; i++) {
+        assert(r->values[i] == i);
+    }
+}
+
+static void expect_borrowed(const received_t *r, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        assert(r->payloads[i] == (const uint8_t *)&wire[i]);
+    }
+}
+
+void test_flush(void) {
+    printf("Test: batched samples are delivered at the flush, without copying their payload\n");
+    setup();
+    received_t r;
+    _z_subscription_rc_t sub = subscribe(&r, 16);
+    for (uint32_t i = 0; i < 5; i++) {
+        receive(i);
+    }
+    assert(r.calls == 0);
+    _z_flush_subscription_batches(session);
+    assert(r.calls == 1 && r.last_len == 5);
+    expect_values(&r, 5);
+    expect_borrowed(&r, 5);
+    // Nothing left
+    _z_flush_subscription_batches(session);
+    assert(r.calls == 1);
+    _z_unregister_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    assert(r.dropped);
+    cleanup();
+}
+
+void test_full(void) {
+    printf("Test: full batches are delivered without a flush\n");
+    setup();
+    received_t r;
+    _z_subscription_rc_t sub = subscribe(&r, 4);
+    for (uint32_t i = 0; i < 10; i++) {
+        receive(i);
+    }
+    assert(r.calls == 2 && r.last_len == 4);
+    _z_flush_subscription_batches(session);
+    assert(r.calls == 3 && r.last_len == 2);
+    expect_values(&r, 10);
+    expect_borrowed(&r, 10);
+    _z_unregister_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    cleanup();
+}
+
+void test_local(void) {
+    printf("Test: samples published by the session are delivered before the publication returns\n");
+    setup();
+    received_t r;
+    _z_subscription_rc_t sub = subscribe(&r, 16);
+    put(0);
+    assert(r.calls == 1 && r.last_len == 1);
+    // Along with the received ones waiting before them
+    receive(1);
+    receive(2);
+    put(3);
+    assert(r.calls == 2 && r.last_len == 3);
+    expect_values(&r, 4);
+    _z_flush_subscription_batches(session);
+    assert(r.calls == 2);
+    _z_unregister_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    cleanup();
+}
+
+void test_owned(void) {
+    printf("Test: owned samples are moved into the batch\n");
+    setup();
+    received_t r;
+    _z_subscription_rc_t sub = subscribe(&r, 16);
+    _z_bytes_t payload;
+    uint32_t value = 0;
+    assert(_z_bytes_copy_from_buf(&payload, (const uint8_t *)&value, sizeof(value)) == _Z_RES_OK);
+    _z_sample_t view;
+    _z_sample_create_view_from_data(&view, &keyexpr._inner, &payload, NULL, NULL, Z_SAMPLE_KIND_PUT,
+                                    _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT), NULL, NULL,
+                                    Z_RELIABILITY_RELIABLE);
+    // As the dispatch workers hand them
+    _z_sample_t owned;
+    assert(_z_sample_copy(&owned, &view) == _Z_RES_OK);
+    const uint8_t *start = _z_bytes_get_slice(&_z_sample_get_ref(&owned)->payload, 0)->start;
+    _z_bytes_clear(&payload);
+    _z_subscription_deliver(session, &sub, &owned);
+    _z_sample_clear(&owned);
+    assert(r.calls == 0);
+    _z_flush_subscription_batches(session);
+    assert(r.calls == 1 && r.payloads[0] == start);
+    expect_values(&r, 1);
+    _z_unregister_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    cleanup();
+}
+
+void test_undeclare(void) {
+    printf("Test: waiting samples are delivered before the subscription is dropped\n");
+    setup();
+    received_t r;
+    _z_subscription_rc_t sub = subscribe(&r, 16);
+    receive(0);
+    receive(1);
+    _z_unregister_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    assert(r.calls == 1 && r.dropped);
+    expect_values(&r, 2);
+    // The session no longer lists it
+    _z_flush_subscription_batches(session);
+    assert(r.calls == 1);
+    cleanup();
+
+    // Same when the session is closed
+    setup();
+    sub = subscribe(&r, 16);
+    receive(0);
+    _z_subscription_rc_drop(&sub);
+    cleanup();
+    assert(r.calls == 1 && r.dropped);
+    expect_values(&r, 1);
+}
+
+void test_mixed(void) {
+    printf("Test: subscriptions without a batch are called per sample\n");
+    setup();
+    received_t batched;
+    received_t single;
+    _z_subscription_rc_t sub_batched = subscribe(&batched, 16);
+    _z_subscription_rc_t sub_single = subscribe(&single, 0);
+    for (uint32_t i = 0; i < 3; i++) {
+        receive(i);
+        assert(single.calls == i + 1);
+    }
+    assert(batched.calls == 0);
+    _z_flush_subscription_batches(session);
+    assert(batched.calls == 1);
+    expect_values(&batched, 3);
+    expect_values(&single, 3);
+    _z_unregister_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub_batched);
+    _z_unregister_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub_single);
+    cleanup();
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+static _z_atomic_bool_t held;
+static _z_atomic_size_t in_callback;
+static _z_atomic_bool_t pushed;
+
+static void on_held_batch(_z_sample_t *samples, size_t len, void *arg) {
+    _z_atomic_size_fetch_add(&in_callback, 1, _z_memory_order_acq_rel);
+    while (_z_atomic_bool_load(&held, _z_memory_order_acquire)) {
+        z_sleep_ms(1);
+    }
+    on_batch(samples, len, arg);
+}
+
+static void *receive_first_batch(void *arg) {
+    _ZP_UNUSED(arg);
+    receive(0);
+    receive(1);
+    return NULL;
+}
+
+static void *receive_last(void *arg) {
+    _ZP_UNUSED(arg);
+    receive(4);
+    _z_atomic_bool_store(&pushed, true, _z_memory_order_release);
+    return NULL;
+}
+
+void test_backpressure(void) {
+    printf("Test: samples wait for the callback when both batches are full\n");
+    setup();
+    _z_atomic_bool_init(&held, true);
+    _z_atomic_size_init(&in_callback, 0);
+    _z_atomic_bool_init(&pushed, false);
+    received_t r;
+    _z_subscription_rc_t sub = subscribe_batch(&r, on_held_batch, 2);
+
+    // The first batch is with the callback, the second one fills up
+    _z_task_t first;
+    assert(_z_task_init(&first, NULL, receive_first_batch, NULL) == _Z_RES_OK);
+    while (_z_atomic_size_load(&in_callback, _z_memory_order_acquire) == 0) {
+        z_sleep_ms(1);
+    }
+    receive(2);
+    receive(3);
+    _z_task_t last;
+    assert(_z_task_init(&last, NULL, receive_last, NULL) == _Z_RES_OK);
+    z_sleep_ms(50);
+    assert(!_z_atomic_bool_load(&pushed, _z_memory_order_acquire));
+    assert(_z_atomic_size_load(&in_callback, _z_memory_order_acquire) == 1);
+
+    _z_atomic_bool_store(&held, false, _z_memory_order_release);
+    assert(_z_task_join(&first) == _Z_RES_OK);
+    assert(_z_task_join(&last) == _Z_RES_OK);
+    _z_flush_subscription_batches(session);
+    expect_values(&r, 5);
+    assert(r.calls == 3);
+    _z_unregister_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    cleanup();
+}
+
+static void *flush_batches(void *arg) {
+    _ZP_UNUSED(arg);
+    _z_flush_subscription_batches(session);
+    _z_atomic_bool_store(&pushed, true, _z_memory_order_release);
+    return NULL;
+}
+
+void test_flush_waits(void) {
+    printf("Test: the flush waits for the samples delivered by another thread\n");
+    setup();
+    _z_atomic_bool_init(&held, true);
+    _z_atomic_size_init(&in_callback, 0);
+    _z_atomic_bool_init(&pushed, false);
+    received_t r;
+    _z_subscription_rc_t sub = subscribe_batch(&r, on_held_batch, 2);
+
+    // The callback holds the first batch on another thread while the next one waits
+    _z_task_t first;
+    assert(_z_task_init(&first, NULL, receive_first_batch, NULL) == _Z_RES_OK);
+    while (_z_atomic_size_load(&in_callback, _z_memory_order_acquire) == 0) {
+        z_sleep_ms(1);
+    }
+    receive(2);
+    // The samples it borrows stay valid until the callback returns from them
+    _z_task_t flush;
+    assert(_z_task_init(&flush, NULL, flush_batches, NULL) == _Z_RES_OK);
+    z_sleep_ms(50);
+    assert(!_z_atomic_bool_load(&pushed, _z_memory_order_acquire));
+
+    _z_atomic_bool_store(&held, false, _z_memory_order_release);
+    assert(_z_task_join(&first) == _Z_RES_OK);
+    assert(_z_task_join(&flush) == _Z_RES_OK);
+    expect_values(&r, 3);
+    expect_borrowed(&r, 3);
+    _z_unregister_subscription(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    cleanup();
+}
+#endif
+
+int main(void) {
+    test_flush();
+    test_full();
+    test_local();
+    test_owned();
+    test_undeclare();
+    test_mixed();
+#if Z_FEATURE_MULTI_THREAD == 1
+    test_backpressure();
+    test_flush_waits();
+#endif
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_SUBSCRIBER_BATCHING\n");
+    return 0;
+}
+#endif
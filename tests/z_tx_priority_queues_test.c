@@ -0,0 +1,404 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/protocol/codec/transport.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/common/tx.h"
+#include "zenoh-pico/transport/unicast/transport.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_TX_PRIORITY_QUEUES == 1
+
+#define BATCH_SIZE 256
+#define MAX_FRAMES 64
+
+typedef struct {
+    uint8_t data[BATCH_SIZE];
+    size_t len;
+} frame_t;
+
+static frame_t frames[MAX_FRAMES];
+static size_t frame_count = 0;
+// Writes wait while the link is held, as on a busy link
+static volatile bool link_held = false;
+static volatile bool link_writing = false;
+// Called after each write, to queue messages while the queues are sent
+static void (*write_hook)(void) = NULL;
+
+// Each write on a datagram link is a full batch
+static size_t fake_write(const _z_link_t *self, const uint8_t *ptr, size_t len, _z_sys_net_socket_t *socket) {
+    (void)self;
+    (void)socket;
+    link_writing = true;
+    while (link_held) {
+        z_sleep_ms(1);
+    }
+    assert(frame_count < MAX_FRAMES);
+    assert(len <= BATCH_SIZE);
+    memcpy(frames[frame_count].data, ptr, len);
+    frames[frame_count].len = len;
+    frame_count++;
+    if (write_hook != NULL) {
+        write_hook();
+    }
+    return len;
+}
+
+typedef struct {
+    uint8_t mid;
+    _z_zint_t sn;
+    size_t count;
+    uint16_t ids[16];
+    z_priority_t priorities[16];
+    // Index of the response final in the frame, if any
+    size_t final_idx;
+    bool has_final;
+} decoded_frame_t;
+
+static decoded_frame_t decode_frame(size_t idx) {
+    decoded_frame_t ret = {0};
+    _z_slice_t s = _z_slice_alias_buf(frames[idx].data, frames[idx].len);
+    _z_zbuf_t zbf = _z_slice_as_zbuf(&s);
+    _z_transport_message_t t_msg;
+    assert(_z_transport_message_decode(&t_msg, &zbf) == _Z_RES_OK);
+    ret.mid = _Z_MID(t_msg._header);
+    if (ret.mid == _Z_MID_T_FRAGMENT) {
+        ret.sn = t_msg._body._fragment._sn;
+        return ret;
+    }
+    assert(ret.mid == _Z_MID_T_FRAME);
+    ret.sn = t_msg._body._frame._sn;
+    _z_zbuf_t payload = _z_slice_as_zbuf(_z_slice_view_deref(&t_msg._body._frame._payload));
+    while (_z_zbuf_readable_len(&payload) > 0) {
+        _z_network_message_t n_msg = {0};
+        assert(_z_network_message_decode(&n_msg, &payload) == _Z_RES_OK);
+        assert(ret.count < 16);
+        if (n_msg._tag == _Z_N_RESPONSE_FINAL) {
+            ret.has_final = true;
+            ret.final_idx = ret.count++;
+            continue;
+        }
+        if (n_msg._tag == _Z_N_RESPONSE) {
+            ret.ids[ret.count] = n_msg._body._response._key._id;
+            ret.priorities[ret.count] = _z_n_qos_get_priority(n_msg._body._response._ext_qos);
+            ret.count++;
+            continue;
+        }
+        assert(n_msg._tag == _Z_N_PUSH);
+        ret.ids[ret.count] = n_msg._body._push._key._id;
+        ret.priorities[ret.count] = _z_n_qos_get_priority(n_msg._body._push._qos);
+        ret.count++;
+    }
+    return ret;
+}
+
+static z_result_t send_push_cc(_z_session_t *zn, uint16_t id, z_priority_t priority, bool express,
+                               z_reliability_t reliability, size_t payload_len, z_congestion_control_t cong_ctrl) {
+    static uint8_t payload_buf[4 * BATCH_SIZE];
+    _z_wireexpr_t key = {._id = id, ._mapping = _Z_KEYEXPR_MAPPING_LOCAL, ._suffix = _z_string_view_null()};
+    _z_bytes_t payload = _z_bytes_null();
+    if (payload_len > 0) {
+        _z_slice_t s = _z_slice_alias_buf(payload_buf, payload_len);
+        assert(_z_bytes_from_slice(&payload, &s) == _Z_RES_OK);
+    }
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_put(&n_msg, &key, &payload, NULL, _z_n_qos_make(express, true, priority), NULL, NULL,
+                           reliability, NULL);
+    z_result_t ret = _z_send_n_msg(zn, &n_msg, reliability, cong_ctrl, NULL);
+    _z_bytes_clear(&payload);
+    return ret;
+}
+
+static z_result_t send_push(_z_session_t *zn, uint16_t id, z_priority_t priority, bool express,
+                            z_reliability_t reliability, size_t payload_len) {
+    return send_push_cc(zn, id, priority, express, reliability, payload_len, Z_CONGESTION_CONTROL_BLOCK);
+}
+
+static z_result_t send_reply(_z_session_t *zn, uint16_t id, z_priority_t priority) {
+    _z_wireexpr_t key = {._id = id, ._mapping = _Z_KEYEXPR_MAPPING_LOCAL, ._suffix = _z_string_view_null()};
+    _z_network_message_t n_msg;
+    _z_n_msg_make_reply_ok_del(&n_msg, &zn->_local_zid, 42, &key, Z_RELIABILITY_RELIABLE, Z_CONSOLIDATION_MODE_NONE,
+                               _z_n_qos_make(false, true, priority), NULL, NULL, NULL);
+    return _z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL);
+}
+
+static void setup(_z_session_t *zn) {
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    assert(_z_session_init(zn, &zid) == _Z_RES_OK);
+    zn->_mode = Z_WHATAMI_CLIENT;
+
+    _z_link_t *zl = (_z_link_t *)z_malloc(sizeof(_z_link_t));
+    assert(zl != NULL);
+    memset(zl, 0, sizeof(_z_link_t));
+    zl->_write_f = fake_write;
+    zl->_mtu = BATCH_SIZE;
+    zl->_cap._flow = Z_LINK_CAP_FLOW_DATAGRAM;
+
+    _z_transport_unicast_establish_param_t param = {0};
+    param._batch_size = BATCH_SIZE;
+    param._seq_num_res = Z_SN_RESOLUTION;
+    param._lease = Z_TRANSPORT_LEASE;
+    assert(_z_unicast_transport_create(&zn->_tp, zl, &param) == _Z_RES_OK);
+    frame_count = 0;
+}
+
+void test_strict_priority(void) {
+    printf("Test: strict priority\n");
+    _z_session_t zn;
+    setup(&zn);
+    assert(_z_transport_start_batching(&zn._tp) == _Z_RES_OK);
+    assert(send_push(&zn, 1, Z_PRIORITY_DATA_LOW, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(send_push(&zn, 2, Z_PRIORITY_DATA, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(send_push(&zn, 3, Z_PRIORITY_DATA_LOW, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(send_push(&zn, 4, Z_PRIORITY_REAL_TIME, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(frame_count == 0);
+    assert(_z_send_n_batch(&zn, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    assert(_z_transport_stop_batching(&zn._tp) == _Z_RES_OK);
+
+    // One frame per priority, most urgent first, sequence numbers in wire order
+    assert(frame_count == 3);
+    decoded_frame_t f0 = decode_frame(0);
+    decoded_frame_t f1 = decode_frame(1);
+    decoded_frame_t f2 = decode_frame(2);
+    assert(f0.count == 1 && f0.ids[0] == 4 && f0.priorities[0] == Z_PRIORITY_REAL_TIME);
+    assert(f1.count == 1 && f1.ids[0] == 2 && f1.priorities[0] == Z_PRIORITY_DATA);
+    assert(f2.count == 2 && f2.ids[0] == 1 && f2.ids[1] == 3);
+    assert(f1.sn == f0.sn + 1 && f2.sn == f1.sn + 1);
+    _z_session_clear(&zn);
+}
+
+void test_express(void) {
+    printf("Test: express\n");
+    _z_session_t zn;
+    setup(&zn);
+    assert(_z_transport_start_batching(&zn._tp) == _Z_RES_OK);
+    assert(send_push(&zn, 1, Z_PRIORITY_DATA_LOW, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(send_push(&zn, 2, Z_PRIORITY_INTERACTIVE_HIGH, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    // Express sends its queue and the more urgent ones, less urgent messages stay queued
+    assert(send_push(&zn, 3, Z_PRIORITY_DATA, true, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(frame_count == 2);
+    assert(decode_frame(0).ids[0] == 2);
+    assert(decode_frame(1).ids[0] == 3);
+    assert(_z_send_n_batch(&zn, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    assert(frame_count == 3);
+    assert(decode_frame(2).ids[0] == 1);
+    assert(_z_transport_stop_batching(&zn._tp) == _Z_RES_OK);
+    _z_session_clear(&zn);
+}
+
+void test_reliability_and_overflow(void) {
+    printf("Test: reliability change and overflow\n");
+    _z_session_t zn;
+    setup(&zn);
+    assert(_z_transport_start_batching(&zn._tp) == _Z_RES_OK);
+    // A frame carries a single reliability
+    assert(send_push(&zn, 1, Z_PRIORITY_DATA, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(send_push(&zn, 2, Z_PRIORITY_DATA, false, Z_RELIABILITY_BEST_EFFORT, 0) == _Z_RES_OK);
+    assert(frame_count == 1);
+    assert(decode_frame(0).ids[0] == 1);
+    // Filling the queue sends it
+    size_t sent = 1;
+    while (frame_count == 1) {
+        assert(send_push(&zn, 10, Z_PRIORITY_DATA, false, Z_RELIABILITY_BEST_EFFORT, 32) == _Z_RES_OK);
+        sent++;
+    }
+    assert(decode_frame(1).count == sent - 1);
+    assert(_z_send_n_batch(&zn, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    assert(decode_frame(2).count == 1);
+    assert(_z_transport_stop_batching(&zn._tp) == _Z_RES_OK);
+    _z_session_clear(&zn);
+}
+
+void test_response_final(void) {
+    printf("Test: response final\n");
+    _z_session_t zn;
+    setup(&zn);
+    assert(_z_transport_start_batching(&zn._tp) == _Z_RES_OK);
+    // Replies queued at lower priorities than the final are sent when it is queued, pushes stay in their queue
+    assert(send_reply(&zn, 1, Z_PRIORITY_DATA_LOW) == _Z_RES_OK);
+    assert(send_reply(&zn, 2, Z_PRIORITY_BACKGROUND) == _Z_RES_OK);
+    assert(send_push(&zn, 3, Z_PRIORITY_DATA_LOW, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(send_push(&zn, 4, Z_PRIORITY_DATA_LOW, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    _z_network_message_t final;
+    _z_n_msg_make_response_final(&final, 42);
+    assert(_z_send_n_msg(&zn, &final, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) == _Z_RES_OK);
+    assert(frame_count == 2);
+    decoded_frame_t f0 = decode_frame(0);
+    decoded_frame_t f1 = decode_frame(1);
+    assert(f0.count == 3 && f0.ids[0] == 1 && f0.ids[1] == 3 && f0.ids[2] == 4 && !f0.has_final);
+    assert(f1.count == 1 && f1.ids[0] == 2 && !f1.has_final);
+    // The final keeps its priority against the replies queued after it
+    assert(send_reply(&zn, 5, Z_PRIORITY_BACKGROUND) == _Z_RES_OK);
+    assert(_z_send_n_batch(&zn, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    assert(_z_transport_stop_batching(&zn._tp) == _Z_RES_OK);
+    assert(frame_count == 4);
+    decoded_frame_t f2 = decode_frame(2);
+    decoded_frame_t f3 = decode_frame(3);
+    assert(f2.count == 1 && f2.has_final);
+    assert(f3.count == 1 && f3.ids[0] == 5);
+    assert(f1.sn == f0.sn + 1 && f2.sn == f1.sn + 1 && f3.sn == f2.sn + 1);
+    _z_session_clear(&zn);
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+static _z_session_t *hook_zn = NULL;
+static size_t hook_left = 0;
+
+static void refill_data(void) {
+    if (hook_left > 0) {
+        hook_left--;
+        // The tx mutex is held by this thread, the message is left to it
+        assert(send_push_cc(hook_zn, 20, Z_PRIORITY_DATA, false, Z_RELIABILITY_RELIABLE, 0,
+                            Z_CONGESTION_CONTROL_DROP) == _Z_RES_OK);
+    }
+}
+
+void test_weighted_share(void) {
+    printf("Test: weighted share\n");
+    _z_session_t zn;
+    setup(&zn);
+    assert(_z_transport_start_batching(&zn._tp) == _Z_RES_OK);
+    assert(send_push(&zn, 1, Z_PRIORITY_BACKGROUND, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(send_push(&zn, 2, Z_PRIORITY_DATA, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(_z_transport_stop_batching(&zn._tp) == _Z_RES_OK);
+    assert(frame_count == 0);
+    // Data keeps coming while the queues are sent, background still gets its share of the link
+    hook_zn = &zn;
+    hook_left = 8;
+    write_hook = refill_data;
+    assert(send_push(&zn, 3, Z_PRIORITY_DATA, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    write_hook = NULL;
+    // Data sends its 4 credits, then background its one, the data queued meanwhile goes in a single frame
+    assert(frame_count == 9);
+    size_t data_count = 0;
+    for (size_t i = 0; i < frame_count; i++) {
+        decoded_frame_t f = decode_frame(i);
+        assert(f.priorities[0] == ((i == 4) ? Z_PRIORITY_BACKGROUND : Z_PRIORITY_DATA));
+        assert((i == 0) || (f.sn == decode_frame(i - 1).sn + 1));
+        data_count += (i == 4) ? 0 : f.count;
+    }
+    assert(data_count == 2 + 8);
+    _z_session_clear(&zn);
+}
+
+static _z_session_t *preempt_zn = NULL;
+
+static void *send_data_low(void *arg) {
+    uint16_t id = (uint16_t)(uintptr_t)arg;
+    assert(send_push(preempt_zn, id, Z_PRIORITY_DATA_LOW, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    return NULL;
+}
+
+static size_t queued_count(_z_session_t *zn) {
+    _z_transport_common_t *ztc = &zn->_tp._transport._unicast._common;
+    _z_mutex_lock(&ztc->_mutex_tx_queues);
+    size_t count = ztc->_batch_count;
+    _z_mutex_unlock(&ztc->_mutex_tx_queues);
+    return count;
+}
+
+void test_preemption(void) {
+    printf("Test: preemption\n");
+    _z_session_t zn;
+    setup(&zn);
+    preempt_zn = &zn;
+    link_held = true;
+    link_writing = false;
+    _z_task_t writer;
+    assert(_z_task_init(&writer, NULL, send_data_low, (void *)(uintptr_t)1) == _Z_RES_OK);
+    while (!link_writing) {
+        z_sleep_ms(1);
+    }
+    // The link is busy, a bulk sender then a real time one come in
+    _z_task_t waiter;
+    assert(_z_task_init(&waiter, NULL, send_data_low, (void *)(uintptr_t)2) == _Z_RES_OK);
+    while (queued_count(&zn) == 0) {
+        z_sleep_ms(1);
+    }
+    assert(send_push_cc(&zn, 3, Z_PRIORITY_REAL_TIME, false, Z_RELIABILITY_RELIABLE, 0, Z_CONGESTION_CONTROL_DROP) ==
+           _Z_RES_OK);
+    assert(queued_count(&zn) == 2);
+    link_held = false;
+    assert(_z_task_join(&writer) == _Z_RES_OK);
+    assert(_z_task_join(&waiter) == _Z_RES_OK);
+    // The real time message goes out right after the write in progress, ahead of the bulk one queued before it
+    assert(frame_count == 3);
+    decoded_frame_t f0 = decode_frame(0);
+    decoded_frame_t f1 = decode_frame(1);
+    decoded_frame_t f2 = decode_frame(2);
+    assert(f0.ids[0] == 1 && f1.ids[0] == 3 && f2.ids[0] == 2);
+    assert(f1.sn == f0.sn + 1 && f2.sn == f1.sn + 1);
+    _z_session_clear(&zn);
+}
+#endif
+
+#if Z_FEATURE_FRAGMENTATION == 1
+void test_fragments(void) {
+    printf("Test: fragments\n");
+    _z_session_t zn;
+    setup(&zn);
+    assert(_z_transport_start_batching(&zn._tp) == _Z_RES_OK);
+    assert(send_push(&zn, 1, Z_PRIORITY_DATA_LOW, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    assert(send_push(&zn, 2, Z_PRIORITY_REAL_TIME, false, Z_RELIABILITY_RELIABLE, 0) == _Z_RES_OK);
+    // Large message goes out as fragments right after the more urgent queue
+    assert(send_push(&zn, 3, Z_PRIORITY_DATA, false, Z_RELIABILITY_RELIABLE, 3 * BATCH_SIZE) == _Z_RES_OK);
+    assert(frame_count > 2);
+    decoded_frame_t first = decode_frame(0);
+    assert(first.mid == _Z_MID_T_FRAME && first.ids[0] == 2);
+    for (size_t i = 1; i < frame_count; i++) {
+        decoded_frame_t f = decode_frame(i);
+        assert(f.mid == _Z_MID_T_FRAGMENT);
+        assert(f.sn == first.sn + i);
+    }
+    size_t fragments = frame_count - 1;
+    assert(_z_send_n_batch(&zn, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    decoded_frame_t last = decode_frame(frame_count - 1);
+    assert(last.mid == _Z_MID_T_FRAME && last.ids[0] == 1 && last.sn == first.sn + fragments + 1);
+    assert(_z_transport_stop_batching(&zn._tp) == _Z_RES_OK);
+    _z_session_clear(&zn);
+}
+#endif
+
+int main(void) {
+    test_strict_priority();
+    test_express();
+    test_reliability_and_overflow();
+    test_response_final();
+#if Z_FEATURE_MULTI_THREAD == 1
+    test_weighted_share();
+    test_preemption();
+#endif
+#if Z_FEATURE_FRAGMENTATION == 1
+    test_fragments();
+#endif
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_TX_PRIORITY_QUEUES=1\n");
+    return 0;
+}
+#endif
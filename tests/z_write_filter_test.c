@@ -0,0 +1,244 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/session_fixture.h"
+#include "zenoh-pico/net/filtering.h"
+
+#if Z_FEATURE_INTEREST == 1 && Z_FEATURE_MATCHING == 1
+
+// Matching status changes notified to a write filter
+typedef struct {
+    size_t matching;
+    size_t not_matching;
+} notified_t;
+
+static void on_matching(const _z_matching_status_t *status, void *arg) {
+    notified_t *n = (notified_t *)arg;
+    if (status->matching) {
+        n->matching++;
+    } else {
+        n->not_matching++;
+    }
+}
+
+static void setup(void) {
+    setup_session();
+    session->_mode = Z_WHATAMI_PEER;
+}
+
+static void create_filter(_z_write_filter_t *filter, const char *key, uint8_t flag, bool complete,
+                          z_locality_t locality, notified_t *notified) {
+    _z_declared_keyexpr_t ke;
+    _z_string_t str = _z_string_alias_str(key);
+    assert(_z_declared_keyexpr_from_string(&ke, &str) == _Z_RES_OK);
+    assert(_z_write_filter_create(&session_rc, filter, &ke, flag, complete, locality) == _Z_RES_OK);
+    _z_declared_keyexpr_clear(&ke);
+    memset(notified, 0, sizeof(*notified));
+    _z_closure_matching_status_t callback = {.context = notified, .call = on_matching, .drop = NULL};
+    assert(_z_write_filter_ctx_add_callback(_Z_RC_IN_VAL(&filter->ctx), 1, &callback) == _Z_RES_OK);
+}
+
+void test_remote_subscribers(void) {
+    printf("Test: a publisher matches the remote subscribers intersecting its key\n");
+    setup();
+    _z_write_filter_t filter;
+    notified_t notified;
+    create_filter(&filter, "a/b", _Z_INTEREST_FLAG_SUBSCRIBERS, false, Z_LOCALITY_ANY, &notified);
+    assert(_z_write_filter_active(&filter));
+
+    declare_subscriber("c/d", 1, &peer_a);
+    // Queryables are not subscribers
+    declare_queryable("a/b", 2, true, &peer_a);
+    assert(_z_write_filter_active(&filter) && notified.matching == 0);
+
+    declare_subscriber("a/*", 3, &peer_a);
+    declare_subscriber("a/**", 4, &peer_a);
+    // Entity ids are only unique per peer
+    declare_subscriber("a/b", 3, &peer_b);
+    assert(!_z_write_filter_active(&filter));
+    assert(notified.matching == 1 && notified.not_matching == 0);
+
+    assert(undeclare_subscriber(3, &peer_a) == _Z_RES_OK);
+    assert(undeclare_subscriber(4, &peer_a) == _Z_RES_OK);
+    assert(!_z_write_filter_active(&filter));
+    assert(undeclare_subscriber(3, &peer_b) == _Z_RES_OK);
+    assert(_z_write_filter_active(&filter));
+    assert(notified.matching == 1 && notified.not_matching == 1);
+
+    _z_write_filter_clear(&filter);
+    cleanup_session();
+}
+
+void test_complete_queryables(void) {
+    printf("Test: a querier of complete answers matches the complete queryables including its key\n");
+    setup();
+    _z_write_filter_t filter;
+    notified_t notified;
+    create_filter(&filter, "a/b", _Z_INTEREST_FLAG_QUERYABLES, true, Z_LOCALITY_ANY, &notified);
+
+    declare_queryable("a/*", 1, false, &peer_a);
+    declare_queryable("a/b/c", 2, true, &peer_a);
+    declare_subscriber("a/b", 3, &peer_a);
+    assert(_z_write_filter_active(&filter));
+
+    // A redeclaration updates the completeness of the queryable
+    declare_queryable("a/*", 1, true, &peer_a);
+    assert(!_z_write_filter_active(&filter) && notified.matching == 1);
+    declare_queryable("a/*", 1, false, &peer_a);
+    assert(_z_write_filter_active(&filter) && notified.not_matching == 1);
+
+    _z_write_filter_clear(&filter);
+    cleanup_session();
+}
+
+void test_known_declarations(void) {
+    printf("Test: a new write filter matches the known declarations\n");
+    setup();
+    _z_write_filter_t first;
+    _z_write_filter_t second;
+    notified_t first_notified;
+    notified_t second_notified;
+    create_filter(&first, "a/**", _Z_INTEREST_FLAG_SUBSCRIBERS, false, Z_LOCALITY_ANY, &first_notified);
+
+    // Declarations answering an interest are matched by the others as well
+    _z_wireexpr_t expr = wireexpr_of("a/b");
+    declare(_z_make_decl_subscriber(&expr, 1), &peer_a, _z_optional_id_make_some(first._interest_id));
+    assert(!_z_write_filter_active(&first));
+    create_filter(&second, "a/b", _Z_INTEREST_FLAG_SUBSCRIBERS, false, Z_LOCALITY_ANY, &second_notified);
+    assert(!_z_write_filter_active(&second));
+    // Once, when declared again to answer the interest of the new filter
+    declare(_z_make_decl_subscriber(&expr, 1), &peer_a, _z_optional_id_make_some(second._interest_id));
+    assert(undeclare_subscriber(1, &peer_a) == _Z_RES_OK);
+    assert(_z_write_filter_active(&second) && _z_write_filter_active(&first));
+    assert(second_notified.matching == 1 && second_notified.not_matching == 1);
+    _z_write_filter_clear(&second);
+
+    declare_subscriber("a/c", 2, &peer_a);
+    create_filter(&second, "a/c", _Z_INTEREST_FLAG_SUBSCRIBERS, false, Z_LOCALITY_ANY, &second_notified);
+    assert(!_z_write_filter_active(&second));
+    // The listener learns about the current status when added
+    assert(second_notified.matching == 1);
+    assert(undeclare_subscriber(2, &peer_a) == _Z_RES_OK);
+    assert(_z_write_filter_active(&second) && second_notified.not_matching == 1);
+    assert(_z_write_filter_active(&first));
+
+    _z_write_filter_clear(&second);
+    _z_write_filter_clear(&first);
+    cleanup_session();
+}
+
+void test_disconnected_peers(void) {
+    printf("Test: the declarations of a disconnected peer no longer match\n");
+    setup();
+    _z_write_filter_t filter;
+    notified_t notified;
+    create_filter(&filter, "a/b", _Z_INTEREST_FLAG_SUBSCRIBERS, false, Z_LOCALITY_ANY, &notified);
+    declare_subscriber("a/b", 1, &peer_a);
+    declare_subscriber("a/b", 2, &peer_a);
+    declare_subscriber("a/*", 1, &peer_b);
+
+    _z_interest_peer_disconnected(session, &peer_a);
+    assert(!_z_write_filter_active(&filter));
+    _z_interest_peer_disconnected(session, &peer_b);
+    assert(_z_write_filter_active(&filter));
+    assert(notified.matching == 1 && notified.not_matching == 1);
+
+    _z_write_filter_clear(&filter);
+    cleanup_session();
+}
+
+void test_locality(void) {
+    printf("Test: write filters only match the entities of their locality\n");
+    setup();
+    _z_write_filter_t local;
+    _z_write_filter_t remote;
+    notified_t local_notified;
+    notified_t remote_notified;
+    create_filter(&local, "a/b", _Z_INTEREST_FLAG_SUBSCRIBERS, false, Z_LOCALITY_SESSION_LOCAL, &local_notified);
+    create_filter(&remote, "a/b", _Z_INTEREST_FLAG_SUBSCRIBERS, false, Z_LOCALITY_REMOTE, &remote_notified);
+
+    declare_subscriber("a/b", 1, &peer_a);
+    assert(_z_write_filter_active(&local) && !_z_write_filter_active(&remote));
+
+    _z_keyexpr_t key;
+    _z_string_t str = _z_string_alias_str("a/*");
+    assert(_z_keyexpr_copy_from_string(&key, &str) == _Z_RES_OK);
+    _z_write_filter_notify_subscriber(session, &key, Z_LOCALITY_ANY, true);
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+    assert(!_z_write_filter_active(&local) && local_notified.matching == 1);
+    _z_write_filter_notify_subscriber(session, &key, Z_LOCALITY_ANY, false);
+    assert(_z_write_filter_active(&local) && local_notified.not_matching == 1);
+#else
+    assert(_z_write_filter_active(&local));
+#endif
+    assert(remote_notified.matching == 1 && remote_notified.not_matching == 0);
+    _z_keyexpr_clear(&key);
+
+    _z_write_filter_clear(&remote);
+    _z_write_filter_clear(&local);
+    cleanup_session();
+}
+
+void test_storm(void) {
+    printf("Test: a storm of declarations is notified once per write filter\n");
+    setup();
+    _z_write_filter_t filters[8];
+    notified_t notified[8];
+    char key[32];
+    for (size_t i = 0; i < 8; i++) {
+        snprintf(key, sizeof(key), "a/%zu", i);
+        create_filter(&filters[i], key, _Z_INTEREST_FLAG_SUBSCRIBERS, false, Z_LOCALITY_ANY, &notified[i]);
+    }
+    for (uint32_t i = 0; i < 100; i++) {
+        declare_subscriber("a/*", i, &peer_a);
+    }
+    for (size_t i = 0; i < 8; i++) {
+        assert(!_z_write_filter_active(&filters[i]));
+        assert(notified[i].matching == 1 && notified[i].not_matching == 0);
+    }
+    // Write filters can go before the declarations matching them
+    for (size_t i = 0; i < 4; i++) {
+        _z_write_filter_clear(&filters[i]);
+    }
+    for (uint32_t i = 0; i < 100; i++) {
+        assert(undeclare_subscriber(i, &peer_a) == _Z_RES_OK);
+    }
+    for (size_t i = 4; i < 8; i++) {
+        assert(_z_write_filter_active(&filters[i]) && notified[i].not_matching == 1);
+        _z_write_filter_clear(&filters[i]);
+    }
+    cleanup_session();
+}
+
+int main(void) {
+    test_remote_subscribers();
+    test_complete_queryables();
+    test_known_declarations();
+    test_disconnected_peers();
+    test_locality();
+    test_storm();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_INTEREST and Z_FEATURE_MATCHING\n");
+    return 0;
+}
+#endif